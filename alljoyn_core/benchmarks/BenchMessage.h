@@ -0,0 +1,102 @@
+/**
+ * @file
+ * Message helper shared by the benchmarks.
+ */
+
+/******************************************************************************
+ *
+ *
+ *    Copyright (c) Open Connectivity Foundation (OCF), AllJoyn Open Source
+ *    Project (AJOSP) Contributors and others.
+ *
+ *    SPDX-License-Identifier: Apache-2.0
+ *
+ *    All rights reserved. This program and the accompanying materials are
+ *    made available under the terms of the Apache License, Version 2.0
+ *    which accompanies this distribution, and is available at
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Copyright (c) Open Connectivity Foundation and Contributors to AllSeen
+ *    Alliance. All rights reserved.
+ *
+ *    Permission to use, copy, modify, and/or distribute this software for
+ *    any purpose with or without fee is hereby granted, provided that the
+ *    above copyright notice and this permission notice appear in all
+ *    copies.
+ *
+ *    THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+ *    WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+ *    WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ *    AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ *    DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ *    PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+ *    TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ *    PERFORMANCE OF THIS SOFTWARE.
+ ******************************************************************************/
+#ifndef _ALLJOYN_BENCHMESSAGE_H
+#define _ALLJOYN_BENCHMESSAGE_H
+
+#include <qcc/platform.h>
+
+#include <qcc/String.h>
+
+#include <alljoyn/BusAttachment.h>
+#include <alljoyn/Message.h>
+#include <alljoyn/MsgArg.h>
+
+#include "RemoteEndpoint.h"
+
+namespace ajn {
+namespace benchmark {
+
+/**
+ * Exposes the protected marshal and unmarshal entry points of _Message.
+ */
+class _BenchMessage : public _Message {
+  public:
+    _BenchMessage(BusAttachment& bus) : _Message(bus) { }
+
+    /**
+     * Marshal a method call with the given arguments.
+     */
+    QStatus MethodCall(const MsgArg* args, size_t numArgs)
+    {
+        return CallMsg(MsgArg::Signature(args, numArgs), "org.alljoyn.bench", 0, "/org/alljoyn/bench", "org.alljoyn.bench", "Method", args, numArgs, 0);
+    }
+
+    /**
+     * Marshal a signal from the given sender with the given arguments. The signal is broadcast
+     * if the destination is NULL.
+     */
+    QStatus Signal(const qcc::String& sender, const MsgArg* args, size_t numArgs, const char* destination = NULL)
+    {
+        return SignalMsg(MsgArg::Signature(args, numArgs), sender, destination, 0, "/org/alljoyn/bench", "org.alljoyn.bench", "Signal", args, numArgs, 0, 0);
+    }
+
+    /**
+     * Write the marshaled message to an endpoint.
+     */
+    QStatus Deliver(RemoteEndpoint& ep) { return _Message::Deliver(ep); }
+
+    /**
+     * Read a message from an endpoint and unmarshal the header and body.
+     */
+    QStatus Receive(RemoteEndpoint& ep)
+    {
+        QStatus status = _Message::Read(ep, false);
+        if (status == ER_OK) {
+            status = _Message::Unmarshal(ep, false);
+        }
+        if (status == ER_OK) {
+            status = UnmarshalArgs("*");
+        }
+        return status;
+    }
+};
+
+typedef qcc::ManagedObj<_BenchMessage> BenchMessage;
+
+}
+}
+
+#endif
@@ -0,0 +1,332 @@
+/**
+ * @file
+ * Minimal micro-benchmark harness modelled on Google Benchmark.
+ */
+
+/******************************************************************************
+ *
+ *
+ *    Copyright (c) Open Connectivity Foundation (OCF), AllJoyn Open Source
+ *    Project (AJOSP) Contributors and others.
+ *
+ *    SPDX-License-Identifier: Apache-2.0
+ *
+ *    All rights reserved. This program and the accompanying materials are
+ *    made available under the terms of the Apache License, Version 2.0
+ *    which accompanies this distribution, and is available at
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Copyright (c) Open Connectivity Foundation and Contributors to AllSeen
+ *    Alliance. All rights reserved.
+ *
+ *    Permission to use, copy, modify, and/or distribute this software for
+ *    any purpose with or without fee is hereby granted, provided that the
+ *    above copyright notice and this permission notice appear in all
+ *    copies.
+ *
+ *    THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+ *    WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+ *    WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ *    AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ *    DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ *    PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+ *    TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ *    PERFORMANCE OF THIS SOFTWARE.
+ ******************************************************************************/
+
+#include <qcc/platform.h>
+
+#include <algorithm>
+#include <chrono>
+#include <math.h>
+
+#include <qcc/StringUtil.h>
+#include <qcc/time.h>
+
+#include <alljoyn/version.h>
+
+#include "Benchmark.h"
+
+using namespace std;
+using namespace qcc;
+
+namespace ajn {
+namespace benchmark {
+
+/* Upper bound on the number of iterations in a single run */
+static const uint64_t MAX_ITERATIONS = 1000000000;
+
+static vector<Benchmark*>& Registry()
+{
+    static vector<Benchmark*> registry;
+    return registry;
+}
+
+uint64_t Now()
+{
+    return chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+State::State(uint64_t iterations, int64_t arg) :
+    maxIterations(iterations),
+    count(0),
+    arg(arg),
+    running(false),
+    start(0),
+    elapsed(0),
+    itemsProcessed(0),
+    bytesProcessed(0),
+    error(false)
+{
+}
+
+void State::PauseTiming()
+{
+    elapsed += Now() - start;
+    running = false;
+}
+
+void State::ResumeTiming()
+{
+    running = true;
+    start = Now();
+}
+
+void State::SkipWithError(const char* msg)
+{
+    error = true;
+    errorMsg = msg;
+    /* Make KeepRunning() return false */
+    count = maxIterations;
+}
+
+Benchmark::Benchmark(const char* name, Function fn) : name(name), fn(fn)
+{
+    Registry().push_back(this);
+}
+
+Benchmark* Benchmark::Arg(int64_t arg)
+{
+    args.push_back(arg);
+    return this;
+}
+
+struct Runner::Result {
+    String name;
+    uint64_t iterations;
+    double median;   /* ns per iteration */
+    double mean;
+    double min;
+    double stddev;
+    double itemsPerSecond;
+    double bytesPerSecond;
+    String error;
+};
+
+Runner::Runner() : minTime(500), repetitions(5)
+{
+}
+
+uint64_t Runner::RunIterations(const Benchmark& bm, int64_t arg, uint64_t iterations, State& state)
+{
+    state = State(iterations, arg);
+    bm.fn(state);
+    if (state.running) {
+        /* The benchmark returned without finishing the KeepRunning() loop */
+        state.PauseTiming();
+    }
+    return state.elapsed;
+}
+
+Runner::Result Runner::RunOne(const Benchmark& bm, int64_t arg)
+{
+    Result result;
+    result.name = bm.name;
+    if (!bm.args.empty()) {
+        result.name += "/" + I64ToString(arg);
+    }
+    result.iterations = 0;
+    result.median = result.mean = result.min = result.stddev = 0.0;
+    result.itemsPerSecond = result.bytesPerSecond = 0.0;
+
+    /* Find an iteration count that takes at least minTime */
+    const uint64_t minNs = (uint64_t)minTime * 1000000;
+    uint64_t iterations = 1;
+    State state(0, arg);
+    for (;;) {
+        uint64_t ns = RunIterations(bm, arg, iterations, state);
+        if (state.error) {
+            result.error = state.errorMsg;
+            return result;
+        }
+        if ((ns >= minNs) || (iterations >= MAX_ITERATIONS)) {
+            break;
+        }
+        /* Aim 40% past the target so the next run is very likely long enough */
+        uint64_t next = (ns > minNs / 100) ? (uint64_t)((double)iterations * 1.4 * minNs / ns) : iterations * 10;
+        iterations = min(MAX_ITERATIONS, max(next, iterations + 1));
+    }
+
+    vector<double> times;
+    uint64_t items = 0;
+    uint64_t bytes = 0;
+    double total = 0.0;
+    for (uint32_t rep = 0; rep < repetitions; ++rep) {
+        uint64_t ns = RunIterations(bm, arg, iterations, state);
+        if (state.error) {
+            result.error = state.errorMsg;
+            return result;
+        }
+        times.push_back((double)ns / iterations);
+        items += state.itemsProcessed;
+        bytes += state.bytesProcessed;
+        total += (double)ns;
+    }
+    sort(times.begin(), times.end());
+    size_t n = times.size();
+    result.iterations = iterations;
+    result.median = (n & 1) ? times[n / 2] : (times[n / 2 - 1] + times[n / 2]) / 2;
+    result.min = times[0];
+    double sum = 0.0;
+    for (size_t i = 0; i < n; ++i) {
+        sum += times[i];
+    }
+    result.mean = sum / n;
+    double var = 0.0;
+    for (size_t i = 0; i < n; ++i) {
+        var += (times[i] - result.mean) * (times[i] - result.mean);
+    }
+    result.stddev = (n > 1) ? sqrt(var / (n - 1)) : 0.0;
+    if (total > 0.0) {
+        result.itemsPerSecond = items * 1e9 / total;
+        result.bytesPerSecond = bytes * 1e9 / total;
+    }
+    return result;
+}
+
+void Runner::List(FILE* out)
+{
+    vector<Benchmark*>& registry = Registry();
+    for (size_t i = 0; i < registry.size(); ++i) {
+        const Benchmark& bm = *registry[i];
+        if (bm.args.empty()) {
+            fprintf(out, "%s\n", bm.name.c_str());
+        }
+        for (size_t a = 0; a < bm.args.size(); ++a) {
+            fprintf(out, "%s/%s\n", bm.name.c_str(), I64ToString(bm.args[a]).c_str());
+        }
+    }
+}
+
+/*
+ * Escape a string for inclusion in JSON output.
+ */
+static String JsonString(const String& str)
+{
+    String out("\"");
+    for (size_t i = 0; i < str.size(); ++i) {
+        char c = str[i];
+        if ((c == '"') || (c == '\\')) {
+            out += '\\';
+            out += c;
+        } else if ((uint8_t)c < 0x20) {
+            out += ' ';
+        } else {
+            out += c;
+        }
+    }
+    out += '"';
+    return out;
+}
+
+size_t Runner::Run(FILE* out, Format format)
+{
+    size_t errors = 0;
+    size_t count = 0;
+    vector<Benchmark*>& registry = Registry();
+
+    if (format == FORMAT_JSON) {
+        fprintf(out, "{\n  \"context\": {\n");
+        fprintf(out, "    \"date\": %s,\n", JsonString(UTCTime()).c_str());
+        fprintf(out, "    \"library_version\": %s,\n", JsonString(GetVersion()).c_str());
+        fprintf(out, "    \"library_build_info\": %s,\n", JsonString(GetBuildInfo()).c_str());
+        fprintf(out, "    \"min_time_ms\": %u,\n", minTime);
+        fprintf(out, "    \"repetitions\": %u\n", repetitions);
+        fprintf(out, "  },\n  \"benchmarks\": [");
+    } else if (format == FORMAT_CSV) {
+        fprintf(out, "name,iterations,real_time,real_time_min,real_time_mean,real_time_stddev,time_unit,items_per_second,bytes_per_second,error_message\n");
+    } else {
+        fprintf(out, "%-48s %14s %14s %8s %12s\n", "Benchmark", "Time (ns)", "Min (ns)", "CV %", "Iterations");
+        fprintf(out, "%s\n", String(100, '-').c_str());
+    }
+    fflush(out);
+
+    for (size_t i = 0; i < registry.size(); ++i) {
+        const Benchmark& bm = *registry[i];
+        vector<int64_t> args = bm.args;
+        if (args.empty()) {
+            args.push_back(0);
+        }
+        for (size_t a = 0; a < args.size(); ++a) {
+            String name = bm.name;
+            if (!bm.args.empty()) {
+                name += "/" + I64ToString(args[a]);
+            }
+            if (!filter.empty() && (name.find(filter) == String::npos)) {
+                continue;
+            }
+            Result r = RunOne(bm, args[a]);
+            if (!r.error.empty()) {
+                ++errors;
+            }
+            if (format == FORMAT_JSON) {
+                fprintf(out, "%s\n    {\n      \"name\": %s,\n", count ? "," : "", JsonString(r.name).c_str());
+                if (!r.error.empty()) {
+                    fprintf(out, "      \"error_occurred\": true,\n      \"error_message\": %s\n    }", JsonString(r.error).c_str());
+                } else {
+                    fprintf(out, "      \"iterations\": %llu,\n", (unsigned long long)r.iterations);
+                    fprintf(out, "      \"real_time\": %.3f,\n", r.median);
+                    fprintf(out, "      \"real_time_min\": %.3f,\n", r.min);
+                    fprintf(out, "      \"real_time_mean\": %.3f,\n", r.mean);
+                    fprintf(out, "      \"real_time_stddev\": %.3f,\n", r.stddev);
+                    if (r.itemsPerSecond > 0.0) {
+                        fprintf(out, "      \"items_per_second\": %.3f,\n", r.itemsPerSecond);
+                    }
+                    if (r.bytesPerSecond > 0.0) {
+                        fprintf(out, "      \"bytes_per_second\": %.3f,\n", r.bytesPerSecond);
+                    }
+                    fprintf(out, "      \"time_unit\": \"ns\"\n    }");
+                }
+            } else if (format == FORMAT_CSV) {
+                if (!r.error.empty()) {
+                    fprintf(out, "%s,,,,,,,,,%s\n", r.name.c_str(), JsonString(r.error).c_str());
+                } else {
+                    fprintf(out, "%s,%llu,%.3f,%.3f,%.3f,%.3f,ns,%.3f,%.3f,\n", r.name.c_str(), (unsigned long long)r.iterations,
+                            r.median, r.min, r.mean, r.stddev, r.itemsPerSecond, r.bytesPerSecond);
+                }
+            } else {
+                if (!r.error.empty()) {
+                    fprintf(out, "%-48s ERROR: %s\n", r.name.c_str(), r.error.c_str());
+                } else {
+                    double cv = (r.mean > 0.0) ? 100.0 * r.stddev / r.mean : 0.0;
+                    fprintf(out, "%-48s %14.1f %14.1f %8.2f %12llu", r.name.c_str(), r.median, r.min, cv, (unsigned long long)r.iterations);
+                    if (r.bytesPerSecond > 0.0) {
+                        fprintf(out, "  %.1f MB/s", r.bytesPerSecond / 1e6);
+                    } else if (r.itemsPerSecond > 0.0) {
+                        fprintf(out, "  %.0f items/s", r.itemsPerSecond);
+                    }
+                    fprintf(out, "\n");
+                }
+            }
+            fflush(out);
+            ++count;
+        }
+    }
+    if (format == FORMAT_JSON) {
+        fprintf(out, "\n  ]\n}\n");
+    }
+    return errors;
+}
+
+}
+}
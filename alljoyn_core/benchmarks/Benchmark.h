@@ -0,0 +1,254 @@
+/**
+ * @file
+ * Minimal micro-benchmark harness modelled on Google Benchmark.
+ */
+
+/******************************************************************************
+ *
+ *
+ *    Copyright (c) Open Connectivity Foundation (OCF), AllJoyn Open Source
+ *    Project (AJOSP) Contributors and others.
+ *
+ *    SPDX-License-Identifier: Apache-2.0
+ *
+ *    All rights reserved. This program and the accompanying materials are
+ *    made available under the terms of the Apache License, Version 2.0
+ *    which accompanies this distribution, and is available at
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Copyright (c) Open Connectivity Foundation and Contributors to AllSeen
+ *    Alliance. All rights reserved.
+ *
+ *    Permission to use, copy, modify, and/or distribute this software for
+ *    any purpose with or without fee is hereby granted, provided that the
+ *    above copyright notice and this permission notice appear in all
+ *    copies.
+ *
+ *    THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+ *    WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+ *    WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ *    AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ *    DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ *    PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+ *    TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ *    PERFORMANCE OF THIS SOFTWARE.
+ ******************************************************************************/
+#ifndef _ALLJOYN_BENCHMARK_H
+#define _ALLJOYN_BENCHMARK_H
+
+#include <qcc/platform.h>
+
+#include <stdio.h>
+#include <vector>
+
+#include <qcc/String.h>
+
+namespace ajn {
+namespace benchmark {
+
+/**
+ * Per-run state passed to a benchmark function. The function performs any setup, then runs the
+ * code being measured inside a `while (state.KeepRunning())` loop. Only the time spent in the loop
+ * (excluding paused sections) is measured.
+ */
+class State {
+  public:
+
+    /**
+     * Construct the state for a single run.
+     *
+     * @param iterations  Number of times KeepRunning() returns true.
+     * @param arg         The argument the benchmark was registered with.
+     */
+    State(uint64_t iterations, int64_t arg);
+
+    /**
+     * @return true while there are iterations left to run.
+     */
+    bool KeepRunning()
+    {
+        if (count < maxIterations) {
+            if (count++ == 0) {
+                ResumeTiming();
+            }
+            return true;
+        }
+        if (running) {
+            PauseTiming();
+        }
+        return false;
+    }
+
+    /**
+     * Stop the timer, e.g. to exclude per-iteration setup from the measurement.
+     */
+    void PauseTiming();
+
+    /**
+     * Restart the timer after a call to PauseTiming().
+     */
+    void ResumeTiming();
+
+    /**
+     * Abort the benchmark. The error is reported in place of the results.
+     *
+     * @param msg  Reason the benchmark could not be run.
+     */
+    void SkipWithError(const char* msg);
+
+    /**
+     * Report the number of items processed so items per second can be reported.
+     */
+    void SetItemsProcessed(uint64_t items) { itemsProcessed = items; }
+
+    /**
+     * Report the number of bytes processed so bytes per second can be reported.
+     */
+    void SetBytesProcessed(uint64_t bytes) { bytesProcessed = bytes; }
+
+    /**
+     * @return The argument the benchmark was registered with.
+     */
+    int64_t range() const { return arg; }
+
+    /**
+     * @return The number of iterations in this run.
+     */
+    uint64_t iterations() const { return maxIterations; }
+
+  private:
+    friend class Runner;
+
+    uint64_t maxIterations;
+    uint64_t count;
+    int64_t arg;
+    bool running;
+    uint64_t start;
+    uint64_t elapsed;
+    uint64_t itemsProcessed;
+    uint64_t bytesProcessed;
+    bool error;
+    qcc::String errorMsg;
+};
+
+/**
+ * Benchmark function signature.
+ */
+typedef void (*Function)(State& state);
+
+/**
+ * A registered benchmark. Instances are created with the AJ_BENCHMARK macro.
+ */
+class Benchmark {
+  public:
+
+    /**
+     * Register a benchmark.
+     *
+     * @param name  Name of the benchmark.
+     * @param fn    The benchmark function.
+     */
+    Benchmark(const char* name, Function fn);
+
+    /**
+     * Run the benchmark once for each argument value. Without any arguments the benchmark is run
+     * once with an argument of 0.
+     *
+     * @param arg  The argument value, available to the benchmark as State::range().
+     *
+     * @return This benchmark so calls can be chained.
+     */
+    Benchmark* Arg(int64_t arg);
+
+  private:
+    friend class Runner;
+
+    qcc::String name;
+    Function fn;
+    std::vector<int64_t> args;
+};
+
+/**
+ * Output formats supported by the runner.
+ */
+enum Format {
+    FORMAT_CONSOLE,  ///< Human readable table
+    FORMAT_JSON,     ///< JSON in the same layout as Google Benchmark's --benchmark_format=json
+    FORMAT_CSV       ///< One line per benchmark with a header line
+};
+
+/**
+ * Runs the registered benchmarks and reports the results.
+ */
+class Runner {
+  public:
+
+    Runner();
+
+    /**
+     * Only run benchmarks whose name contains this string.
+     */
+    void SetFilter(const qcc::String& filter) { this->filter = filter; }
+
+    /**
+     * Minimum time in milliseconds for a single repetition. The iteration count is increased
+     * until a run takes at least this long.
+     */
+    void SetMinTime(uint32_t ms) { minTime = ms; }
+
+    /**
+     * Number of times each benchmark is repeated once the iteration count has been established.
+     * The median of the repetitions is reported.
+     */
+    void SetRepetitions(uint32_t reps) { repetitions = reps ? reps : 1; }
+
+    /**
+     * Print the names of the registered benchmarks instead of running them.
+     */
+    void List(FILE* out);
+
+    /**
+     * Run all of the registered benchmarks that match the filter.
+     *
+     * @param out     Where the results are written.
+     * @param format  The output format.
+     *
+     * @return The number of benchmarks that reported an error.
+     */
+    size_t Run(FILE* out, Format format);
+
+  private:
+    struct Result;
+
+    Result RunOne(const Benchmark& bm, int64_t arg);
+    static uint64_t RunIterations(const Benchmark& bm, int64_t arg, uint64_t iterations, State& state);
+
+    qcc::String filter;
+    uint32_t minTime;
+    uint32_t repetitions;
+};
+
+/**
+ * @return The current value of a monotonic clock in nanoseconds.
+ */
+uint64_t Now();
+
+}
+}
+
+#if defined(__GNUC__)
+#define AJ_BENCHMARK_UNUSED __attribute__((unused))
+#else
+#define AJ_BENCHMARK_UNUSED
+#endif
+
+#define AJ_BENCHMARK_CONCAT2(a, b) a ## b
+#define AJ_BENCHMARK_CONCAT(a, b) AJ_BENCHMARK_CONCAT2(a, b)
+
+/**
+ * Register a benchmark function, e.g. AJ_BENCHMARK(BM_Foo)->Arg(16)->Arg(256);
+ */
+#define AJ_BENCHMARK(fn) \
+    static ajn::benchmark::Benchmark* AJ_BENCHMARK_CONCAT(_benchmark_, __LINE__) AJ_BENCHMARK_UNUSED = (new ajn::benchmark::Benchmark(#fn, fn))
+
+#endif
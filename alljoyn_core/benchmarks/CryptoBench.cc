@@ -0,0 +1,153 @@
+/**
+ * @file
+ * Crypto micro-benchmarks: AES-CCM and ECDSA.
+ */
+
+/******************************************************************************
+ *
+ *
+ *    Copyright (c) Open Connectivity Foundation (OCF), AllJoyn Open Source
+ *    Project (AJOSP) Contributors and others.
+ *
+ *    SPDX-License-Identifier: Apache-2.0
+ *
+ *    All rights reserved. This program and the accompanying materials are
+ *    made available under the terms of the Apache License, Version 2.0
+ *    which accompanies this distribution, and is available at
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Copyright (c) Open Connectivity Foundation and Contributors to AllSeen
+ *    Alliance. All rights reserved.
+ *
+ *    Permission to use, copy, modify, and/or distribute this software for
+ *    any purpose with or without fee is hereby granted, provided that the
+ *    above copyright notice and this permission notice appear in all
+ *    copies.
+ *
+ *    THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+ *    WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+ *    WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ *    AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ *    DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ *    PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+ *    TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ *    PERFORMANCE OF THIS SOFTWARE.
+ ******************************************************************************/
+
+#include <qcc/platform.h>
+
+#include <vector>
+
+#include <qcc/Crypto.h>
+#include <qcc/CryptoECC.h>
+#include <qcc/KeyBlob.h>
+
+#include "Benchmark.h"
+
+using namespace std;
+using namespace qcc;
+using namespace ajn::benchmark;
+
+static const uint8_t KEY[16] = { 0xC0, 0xC1, 0xC2, 0xC3, 0xC4, 0xC5, 0xC6, 0xC7, 0xC8, 0xC9, 0xCA, 0xCB, 0xCC, 0xCD, 0xCE, 0xCF };
+static const uint8_t NONCE[13] = { 0x00, 0x00, 0x00, 0x03, 0x02, 0x01, 0x00, 0xA0, 0xA1, 0xA2, 0xA3, 0xA4, 0xA5 };
+
+/*
+ * The header length is typical of a method call with a short object path and interface.
+ */
+static const size_t HDR_LEN = 96;
+
+static void BM_AES_CCM_Encrypt(State& state)
+{
+    size_t len = (size_t)state.range();
+    KeyBlob key(KEY, sizeof(KEY), KeyBlob::AES);
+    KeyBlob nonce(NONCE, sizeof(NONCE), KeyBlob::GENERIC);
+    Crypto_AES aes(key, Crypto_AES::CCM);
+    vector<uint8_t> hdr(HDR_LEN, 0x5A);
+    vector<uint8_t> in(len, 0xA5);
+    vector<uint8_t> out(len + 16);
+    while (state.KeepRunning()) {
+        size_t outLen = len;
+        if (aes.Encrypt_CCM(&in[0], &out[0], outLen, nonce, &hdr[0], hdr.size(), 8) != ER_OK) {
+            state.SkipWithError("Encrypt_CCM failed");
+            break;
+        }
+    }
+    state.SetBytesProcessed(state.iterations() * len);
+}
+AJ_BENCHMARK(BM_AES_CCM_Encrypt)->Arg(64)->Arg(1024)->Arg(16384);
+
+static void BM_AES_CCM_Decrypt(State& state)
+{
+    size_t len = (size_t)state.range();
+    KeyBlob key(KEY, sizeof(KEY), KeyBlob::AES);
+    KeyBlob nonce(NONCE, sizeof(NONCE), KeyBlob::GENERIC);
+    Crypto_AES aes(key, Crypto_AES::CCM);
+    vector<uint8_t> hdr(HDR_LEN, 0x5A);
+    vector<uint8_t> plain(len, 0xA5);
+    vector<uint8_t> cipher(len + 16);
+    vector<uint8_t> out(len + 16);
+    size_t cipherLen = len;
+    if (aes.Encrypt_CCM(&plain[0], &cipher[0], cipherLen, nonce, &hdr[0], hdr.size(), 8) != ER_OK) {
+        state.SkipWithError("Encrypt_CCM failed");
+        return;
+    }
+    while (state.KeepRunning()) {
+        size_t outLen = cipherLen;
+        if (aes.Decrypt_CCM(&cipher[0], &out[0], outLen, nonce, &hdr[0], hdr.size(), 8) != ER_OK) {
+            state.SkipWithError("Decrypt_CCM failed");
+            break;
+        }
+    }
+    state.SetBytesProcessed(state.iterations() * len);
+}
+AJ_BENCHMARK(BM_AES_CCM_Decrypt)->Arg(64)->Arg(1024)->Arg(16384);
+
+static void BM_ECC_Sign(State& state)
+{
+    Crypto_ECC ecc;
+    ecc.GenerateDSAKeyPair();
+    uint8_t digest[Crypto_SHA256::DIGEST_SIZE] = { 0x11 };
+    ECCSignature sig;
+    while (state.KeepRunning()) {
+        if (ecc.DSASignDigest(digest, sizeof(digest), &sig) != ER_OK) {
+            state.SkipWithError("DSASignDigest failed");
+            break;
+        }
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+AJ_BENCHMARK(BM_ECC_Sign);
+
+static void BM_ECC_Verify(State& state)
+{
+    Crypto_ECC ecc;
+    ecc.GenerateDSAKeyPair();
+    uint8_t digest[Crypto_SHA256::DIGEST_SIZE] = { 0x11 };
+    ECCSignature sig;
+    ecc.DSASignDigest(digest, sizeof(digest), &sig);
+    while (state.KeepRunning()) {
+        if (ecc.DSAVerifyDigest(digest, sizeof(digest), &sig) != ER_OK) {
+            state.SkipWithError("DSAVerifyDigest failed");
+            break;
+        }
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+AJ_BENCHMARK(BM_ECC_Verify);
+
+static void BM_ECC_GenerateSharedSecret(State& state)
+{
+    Crypto_ECC local;
+    Crypto_ECC peer;
+    local.GenerateDHKeyPair();
+    peer.GenerateDHKeyPair();
+    ECCSecret secret;
+    while (state.KeepRunning()) {
+        if (local.GenerateSharedSecret(peer.GetDHPublicKey(), &secret) != ER_OK) {
+            state.SkipWithError("GenerateSharedSecret failed");
+            break;
+        }
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+AJ_BENCHMARK(BM_ECC_GenerateSharedSecret);
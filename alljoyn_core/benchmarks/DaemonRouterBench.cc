@@ -0,0 +1,234 @@
+/**
+ * @file
+ * DaemonRouter::PushMessage micro-benchmarks against synthetic endpoints.
+ */
+
+/******************************************************************************
+ *
+ *
+ *    Copyright (c) Open Connectivity Foundation (OCF), AllJoyn Open Source
+ *    Project (AJOSP) Contributors and others.
+ *
+ *    SPDX-License-Identifier: Apache-2.0
+ *
+ *    All rights reserved. This program and the accompanying materials are
+ *    made available under the terms of the Apache License, Version 2.0
+ *    which accompanies this distribution, and is available at
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Copyright (c) Open Connectivity Foundation and Contributors to AllSeen
+ *    Alliance. All rights reserved.
+ *
+ *    Permission to use, copy, modify, and/or distribute this software for
+ *    any purpose with or without fee is hereby granted, provided that the
+ *    above copyright notice and this permission notice appear in all
+ *    copies.
+ *
+ *    THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+ *    WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+ *    WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ *    AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ *    DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ *    PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+ *    TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ *    PERFORMANCE OF THIS SOFTWARE.
+ ******************************************************************************/
+
+#include <qcc/platform.h>
+
+#include <vector>
+
+#include <qcc/String.h>
+#include <qcc/StringUtil.h>
+
+#include <alljoyn/BusAttachment.h>
+#include <alljoyn/Message.h>
+#include <alljoyn/MsgArg.h>
+
+#include "AllJoynObj.h"
+#include "Bus.h"
+#include "ConfigDB.h"
+#include "DaemonRouter.h"
+#include "LocalTransport.h"
+#include "RemoteEndpoint.h"
+#include "Rule.h"
+#include "SessionlessObj.h"
+
+#include "Benchmark.h"
+#include "BenchMessage.h"
+
+using namespace std;
+using namespace qcc;
+using namespace ajn;
+using namespace ajn::benchmark;
+
+namespace {
+
+static const char* CONFIG_STR =
+    "<busconfig>"
+    "  <policy context=\"default\">"
+    "    <allow send_type=\"signal\"/>"
+    "    <allow receive_type=\"signal\"/>"
+    "  </policy>"
+    "</busconfig>";
+
+/*
+ * Number of messages delivered to the synthetic endpoints.
+ */
+static uint64_t deliveries = 0;
+
+class _BenchLocalEndpoint : public _LocalEndpoint {
+  public:
+    _BenchLocalEndpoint(BusAttachment& bus, const String& uniqueName) : _LocalEndpoint(bus, 1), name(uniqueName)
+    {
+        _BusEndpoint::endpointType = ENDPOINT_TYPE_LOCAL;
+        _BusEndpoint::isValid = true;
+    }
+    QStatus PushMessage(Message& msg) { QCC_UNUSED(msg); ++deliveries; return ER_OK; }
+    const String& GetUniqueName() const { return name; }
+  private:
+    String name;
+};
+typedef ManagedObj<_BenchLocalEndpoint> BenchLocalEndpoint;
+
+/*
+ * A directly connected client that discards everything pushed to it.
+ */
+class _BenchRemoteEndpoint : public _RemoteEndpoint {
+  public:
+    _BenchRemoteEndpoint(const String& uniqueName) : name(uniqueName)
+    {
+        _BusEndpoint::endpointType = ENDPOINT_TYPE_REMOTE;
+        _BusEndpoint::isValid = true;
+    }
+    QStatus PushMessage(Message& msg) { QCC_UNUSED(msg); ++deliveries; return ER_OK; }
+    const String& GetUniqueName() const { return name; }
+    bool AllowRemoteMessages() { return true; }
+  private:
+    String name;
+};
+typedef ManagedObj<_BenchRemoteEndpoint> BenchRemoteEndpoint;
+
+class TestAllJoynObj : public AllJoynObj {
+  public:
+    TestAllJoynObj(Bus& bus, DaemonRouter& router) : AllJoynObj(bus, NULL, router) { }
+    virtual QStatus AddBusToBusEndpoint(RemoteEndpoint& endpoint) { QCC_UNUSED(endpoint); return ER_OK; }
+    virtual void RemoveBusToBusEndpoint(RemoteEndpoint& endpoint) { QCC_UNUSED(endpoint); }
+};
+
+class TestSessionlessObj : public SessionlessObj {
+  public:
+    TestSessionlessObj(Bus& bus, DaemonRouter& router) : SessionlessObj(bus, NULL, router) { }
+    virtual void AddRule(const qcc::String& epName, Rule& rule) { QCC_UNUSED(epName); QCC_UNUSED(rule); }
+    virtual void RemoveRule(const qcc::String& epName, Rule& rule) { QCC_UNUSED(epName); QCC_UNUSED(rule); }
+    virtual QStatus PushMessage(Message& msg, const set<String>& skippedEndpoints)
+    {
+        QCC_UNUSED(msg);
+        QCC_UNUSED(skippedEndpoints);
+        return ER_OK;
+    }
+    virtual void RouteSessionlessMessage(uint32_t sid, Message& msg, const set<String>& skippedEndpoints)
+    {
+        QCC_UNUSED(sid);
+        QCC_UNUSED(msg);
+        QCC_UNUSED(skippedEndpoints);
+    }
+};
+
+/*
+ * A router with a local endpoint and numEps directly connected clients, each of which has
+ * added a match rule for all signals.
+ */
+class RouterFixture {
+  public:
+    RouterFixture(size_t numEps) : configDb(CONFIG_STR), bus("DaemonRouterBench")
+    {
+        configDb.LoadConfig();
+        bus.Start();
+        router = new DaemonRouter();
+        alljoynObj = new TestAllJoynObj(*reinterpret_cast<Bus*>(&bus), *router);
+        sessionlessObj = new TestSessionlessObj(*reinterpret_cast<Bus*>(&bus), *router);
+        router->SetAllJoynObj(alljoynObj);
+        router->SetSessionlessObj(sessionlessObj);
+
+        String name = ":bench.1";
+        BenchLocalEndpoint lep(bus, name);
+        BusEndpoint bep = BusEndpoint::cast(lep);
+        router->RegisterEndpoint(bep);
+        eps.push_back(bep);
+
+        Rule rule("type='signal'");
+        for (size_t i = 0; i < numEps; ++i) {
+            String name = ":bench." + U32ToString((uint32_t)(i + 2));
+            BenchRemoteEndpoint rep(name);
+            bep = BusEndpoint::cast(rep);
+            router->RegisterEndpoint(bep);
+            router->GetRuleTable().AddRule(bep, rule);
+            eps.push_back(bep);
+        }
+    }
+
+    ~RouterFixture()
+    {
+        /* Unregister in reverse order so the local endpoint goes last */
+        for (vector<BusEndpoint>::reverse_iterator it = eps.rbegin(); it != eps.rend(); ++it) {
+            router->UnregisterEndpoint((*it)->GetUniqueName(), (*it)->GetEndpointType());
+        }
+        eps.clear();
+        delete sessionlessObj;
+        delete alljoynObj;
+        delete router;
+        bus.Stop();
+        bus.Join();
+    }
+
+    ConfigDB configDb;
+    BusAttachment bus;
+    DaemonRouter* router;
+    TestAllJoynObj* alljoynObj;
+    TestSessionlessObj* sessionlessObj;
+    vector<BusEndpoint> eps;
+};
+
+}
+
+static void Push(State& state, bool broadcast)
+{
+    size_t numEps = (size_t)state.range();
+    RouterFixture fixture(numEps);
+    BusEndpoint& sender = fixture.eps[1];
+
+    MsgArg arg("u", 42);
+    BenchMessage bmsg(fixture.bus);
+    String dest = fixture.eps.back()->GetUniqueName();
+    bmsg->Signal(sender->GetUniqueName(), &arg, 1, broadcast ? NULL : dest.c_str());
+    Message msg = Message::cast(bmsg);
+
+    deliveries = 0;
+    while (state.KeepRunning()) {
+        QStatus status = fixture.router->PushMessage(msg, sender);
+        if (status != ER_OK) {
+            state.SkipWithError(QCC_StatusText(status));
+            break;
+        }
+    }
+    state.SetItemsProcessed(deliveries);
+}
+
+/*
+ * Broadcast signal fanned out to all of the endpoints.
+ */
+static void BM_DaemonRouter_PushMessage_Broadcast(State& state)
+{
+    Push(state, true);
+}
+AJ_BENCHMARK(BM_DaemonRouter_PushMessage_Broadcast)->Arg(8)->Arg(64)->Arg(512);
+
+/*
+ * Unicast signal to one of the endpoints.
+ */
+static void BM_DaemonRouter_PushMessage_Unicast(State& state)
+{
+    Push(state, false);
+}
+AJ_BENCHMARK(BM_DaemonRouter_PushMessage_Unicast)->Arg(8)->Arg(64)->Arg(512);
@@ -0,0 +1,150 @@
+/**
+ * @file
+ * IODispatch read dispatch micro-benchmark.
+ */
+
+/******************************************************************************
+ *
+ *
+ *    Copyright (c) Open Connectivity Foundation (OCF), AllJoyn Open Source
+ *    Project (AJOSP) Contributors and others.
+ *
+ *    SPDX-License-Identifier: Apache-2.0
+ *
+ *    All rights reserved. This program and the accompanying materials are
+ *    made available under the terms of the Apache License, Version 2.0
+ *    which accompanies this distribution, and is available at
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Copyright (c) Open Connectivity Foundation and Contributors to AllSeen
+ *    Alliance. All rights reserved.
+ *
+ *    Permission to use, copy, modify, and/or distribute this software for
+ *    any purpose with or without fee is hereby granted, provided that the
+ *    above copyright notice and this permission notice appear in all
+ *    copies.
+ *
+ *    THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+ *    WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+ *    WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ *    AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ *    DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ *    PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+ *    TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ *    PERFORMANCE OF THIS SOFTWARE.
+ ******************************************************************************/
+
+#include <qcc/platform.h>
+
+#include <qcc/Condition.h>
+#include <qcc/IODispatch.h>
+#include <qcc/Mutex.h>
+#include <qcc/Socket.h>
+#include <qcc/SocketStream.h>
+
+#include "Benchmark.h"
+
+using namespace qcc;
+using namespace ajn::benchmark;
+
+namespace {
+
+/*
+ * Reads one byte per callback, re-enables the read callback like RemoteEndpoint does and wakes
+ * the benchmark thread.
+ */
+class Listener : public IOReadListener, public IOWriteListener, public IOExitListener {
+  public:
+    Listener(IODispatch& io) : io(io), received(0), exited(false) { }
+
+    QStatus ReadCallback(Source& source, bool isTimedOut)
+    {
+        QCC_UNUSED(isTimedOut);
+        uint8_t buf[64];
+        size_t actual = 0;
+        QStatus status = source.PullBytes(buf, sizeof(buf), actual, 0);
+        if (status == ER_OK) {
+            mutex.Lock();
+            received += actual;
+            condition.Signal();
+            mutex.Unlock();
+        }
+        io.EnableReadCallback(&source);
+        return ER_OK;
+    }
+
+    QStatus WriteCallback(Sink& sink, bool isTimedOut) { QCC_UNUSED(sink); QCC_UNUSED(isTimedOut); return ER_OK; }
+
+    void ExitCallback()
+    {
+        mutex.Lock();
+        exited = true;
+        condition.Signal();
+        mutex.Unlock();
+    }
+
+    void WaitFor(uint64_t count)
+    {
+        mutex.Lock();
+        while (received < count) {
+            condition.Wait(mutex);
+        }
+        mutex.Unlock();
+    }
+
+    void WaitForExit()
+    {
+        mutex.Lock();
+        while (!exited) {
+            condition.Wait(mutex);
+        }
+        mutex.Unlock();
+    }
+
+  private:
+    IODispatch& io;
+    Mutex mutex;
+    Condition condition;
+    uint64_t received;
+    bool exited;
+};
+
+}
+
+/*
+ * Round trip of one byte through a socket pair: the time from the write to the read callback
+ * having run on an IODispatch thread.
+ */
+static void BM_IODispatch_ReadDispatch(State& state)
+{
+    SocketFd fds[2];
+    if (SocketPair(fds) != ER_OK) {
+        state.SkipWithError("SocketPair failed");
+        return;
+    }
+    SocketStream reader(fds[0]);
+    SocketStream writer(fds[1]);
+
+    IODispatch io("IODispatchBench", 4);
+    Listener listener(io);
+    io.Start();
+    io.StartStream(&reader, &listener, &listener, &listener, true, false);
+
+    uint64_t sent = 0;
+    uint8_t byte = 0xA5;
+    while (state.KeepRunning()) {
+        size_t actual;
+        if (writer.PushBytes(&byte, 1, actual) != ER_OK) {
+            state.SkipWithError("PushBytes failed");
+            break;
+        }
+        listener.WaitFor(++sent);
+    }
+    state.SetItemsProcessed(state.iterations());
+
+    io.StopStream(&reader);
+    listener.WaitForExit();
+    io.Stop();
+    io.Join();
+}
+AJ_BENCHMARK(BM_IODispatch_ReadDispatch);
@@ -0,0 +1,224 @@
+/**
+ * @file
+ * Message marshal and unmarshal micro-benchmarks for a range of body signatures.
+ */
+
+/******************************************************************************
+ *
+ *
+ *    Copyright (c) Open Connectivity Foundation (OCF), AllJoyn Open Source
+ *    Project (AJOSP) Contributors and others.
+ *
+ *    SPDX-License-Identifier: Apache-2.0
+ *
+ *    All rights reserved. This program and the accompanying materials are
+ *    made available under the terms of the Apache License, Version 2.0
+ *    which accompanies this distribution, and is available at
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Copyright (c) Open Connectivity Foundation and Contributors to AllSeen
+ *    Alliance. All rights reserved.
+ *
+ *    Permission to use, copy, modify, and/or distribute this software for
+ *    any purpose with or without fee is hereby granted, provided that the
+ *    above copyright notice and this permission notice appear in all
+ *    copies.
+ *
+ *    THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+ *    WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+ *    WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ *    AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ *    DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ *    PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+ *    TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ *    PERFORMANCE OF THIS SOFTWARE.
+ ******************************************************************************/
+
+#include <qcc/platform.h>
+
+#include <vector>
+
+#include <qcc/Pipe.h>
+#include <qcc/String.h>
+#include <qcc/StringUtil.h>
+
+#include <alljoyn/BusAttachment.h>
+#include <alljoyn/MsgArg.h>
+
+#include "RemoteEndpoint.h"
+
+#include "Benchmark.h"
+#include "BenchMessage.h"
+
+using namespace std;
+using namespace qcc;
+using namespace ajn;
+using namespace ajn::benchmark;
+
+namespace {
+
+static const bool falsiness = false;
+
+/*
+ * A bus and an unconnected remote endpoint that reads and writes an in-memory pipe.
+ */
+class MarshalFixture {
+  public:
+    MarshalFixture() : bus("MessageBench"), stream(&pipe), ep(bus, falsiness, stream)
+    {
+        bus.Start();
+    }
+
+    /*
+     * Size of a message on the wire, used to report bytes per second.
+     */
+    size_t WireSize(BenchMessage& msg)
+    {
+        size_t size = 0;
+        if (msg->Deliver(ep) == ER_OK) {
+            size = pipe.AvailBytes();
+        }
+        BenchMessage drain(bus);
+        drain->Receive(ep);
+        return size;
+    }
+
+    ~MarshalFixture()
+    {
+        bus.Stop();
+        bus.Join();
+    }
+
+    BusAttachment bus;
+    Pipe pipe;
+    Pipe* stream;
+    RemoteEndpoint ep;
+};
+
+/*
+ * The argument lists for each signature shape. The range() argument is the element count for the
+ * array shapes and is ignored otherwise.
+ */
+class Args {
+  public:
+    enum Shape {
+        EMPTY,
+        UINT32,
+        STRING,
+        BYTE_ARRAY,
+        DICTIONARY,
+        STRUCT
+    };
+
+    Args(Shape shape, size_t n) : bytes(n, 0xA5), keys(n), entries(n), numArgs(1)
+    {
+        switch (shape) {
+        case EMPTY:
+            numArgs = 0;
+            break;
+
+        case UINT32:
+            args[0].Set("u", 0x12345678);
+            break;
+
+        case STRING:
+            args[0].Set("s", "org.alljoyn.Benchmark.StringValue");
+            break;
+
+        case BYTE_ARRAY:
+            args[0].Set("ay", bytes.size(), bytes.empty() ? NULL : &bytes[0]);
+            break;
+
+        case DICTIONARY:
+            for (size_t i = 0; i < n; ++i) {
+                keys[i] = "key" + U32ToString((uint32_t)i);
+                entries[i].Set("{sv}", keys[i].c_str(), new MsgArg("u", (uint32_t)i));
+                entries[i].SetOwnershipFlags(MsgArg::OwnsArgs);
+            }
+            args[0].Set("a{sv}", n, entries.empty() ? NULL : &entries[0]);
+            break;
+
+        case STRUCT:
+            args[0].Set("(ssuay)", "name", "description", 42, bytes.size(), bytes.empty() ? NULL : &bytes[0]);
+            break;
+        }
+    }
+
+    vector<uint8_t> bytes;
+    vector<String> keys;
+    vector<MsgArg> entries;
+    MsgArg args[1];
+    size_t numArgs;
+};
+
+}
+
+static void Marshal(State& state, Args::Shape shape)
+{
+    MarshalFixture fixture;
+    Args args(shape, (size_t)state.range());
+    BenchMessage msg(fixture.bus);
+    while (state.KeepRunning()) {
+        if (msg->MethodCall(args.args, args.numArgs) != ER_OK) {
+            state.SkipWithError("CallMsg failed");
+            break;
+        }
+    }
+    state.SetItemsProcessed(state.iterations());
+    state.SetBytesProcessed(state.iterations() * fixture.WireSize(msg));
+}
+
+/*
+ * The message is marshaled and written to the pipe with the timer paused so only reading,
+ * header parsing and body unmarshaling is measured.
+ */
+static void Unmarshal(State& state, Args::Shape shape)
+{
+    MarshalFixture fixture;
+    Args args(shape, (size_t)state.range());
+    BenchMessage out(fixture.bus);
+    BenchMessage in(fixture.bus);
+    uint64_t bytes = 0;
+    while (state.KeepRunning()) {
+        state.PauseTiming();
+        QStatus status = out->MethodCall(args.args, args.numArgs);
+        if (status == ER_OK) {
+            status = out->Deliver(fixture.ep);
+            bytes += fixture.pipe.AvailBytes();
+        }
+        state.ResumeTiming();
+        if (status == ER_OK) {
+            status = in->Receive(fixture.ep);
+        }
+        if (status != ER_OK) {
+            state.SkipWithError(QCC_StatusText(status));
+            break;
+        }
+    }
+    state.SetItemsProcessed(state.iterations());
+    state.SetBytesProcessed(bytes);
+}
+
+#define MESSAGE_BENCHMARKS(name, shape) \
+    static void BM_Message_Marshal_ ## name(State & state) { Marshal(state, Args::shape); } \
+    static void BM_Message_Unmarshal_ ## name(State & state) { Unmarshal(state, Args::shape); }
+
+MESSAGE_BENCHMARKS(Empty, EMPTY)
+MESSAGE_BENCHMARKS(Uint32, UINT32)
+MESSAGE_BENCHMARKS(String, STRING)
+MESSAGE_BENCHMARKS(ByteArray, BYTE_ARRAY)
+MESSAGE_BENCHMARKS(Dictionary, DICTIONARY)
+MESSAGE_BENCHMARKS(Struct, STRUCT)
+
+AJ_BENCHMARK(BM_Message_Marshal_Empty);
+AJ_BENCHMARK(BM_Message_Unmarshal_Empty);
+AJ_BENCHMARK(BM_Message_Marshal_Uint32);
+AJ_BENCHMARK(BM_Message_Unmarshal_Uint32);
+AJ_BENCHMARK(BM_Message_Marshal_String);
+AJ_BENCHMARK(BM_Message_Unmarshal_String);
+AJ_BENCHMARK(BM_Message_Marshal_ByteArray)->Arg(64)->Arg(4096)->Arg(65536);
+AJ_BENCHMARK(BM_Message_Unmarshal_ByteArray)->Arg(64)->Arg(4096)->Arg(65536);
+AJ_BENCHMARK(BM_Message_Marshal_Dictionary)->Arg(4)->Arg(64);
+AJ_BENCHMARK(BM_Message_Unmarshal_Dictionary)->Arg(4)->Arg(64);
+AJ_BENCHMARK(BM_Message_Marshal_Struct)->Arg(64);
+AJ_BENCHMARK(BM_Message_Unmarshal_Struct)->Arg(64);
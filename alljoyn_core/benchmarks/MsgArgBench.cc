@@ -0,0 +1,181 @@
+/**
+ * @file
+ * MsgArg set/get micro-benchmarks.
+ */
+
+/******************************************************************************
+ *
+ *
+ *    Copyright (c) Open Connectivity Foundation (OCF), AllJoyn Open Source
+ *    Project (AJOSP) Contributors and others.
+ *
+ *    SPDX-License-Identifier: Apache-2.0
+ *
+ *    All rights reserved. This program and the accompanying materials are
+ *    made available under the terms of the Apache License, Version 2.0
+ *    which accompanies this distribution, and is available at
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Copyright (c) Open Connectivity Foundation and Contributors to AllSeen
+ *    Alliance. All rights reserved.
+ *
+ *    Permission to use, copy, modify, and/or distribute this software for
+ *    any purpose with or without fee is hereby granted, provided that the
+ *    above copyright notice and this permission notice appear in all
+ *    copies.
+ *
+ *    THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+ *    WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+ *    WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ *    AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ *    DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ *    PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+ *    TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ *    PERFORMANCE OF THIS SOFTWARE.
+ ******************************************************************************/
+
+#include <qcc/platform.h>
+
+#include <vector>
+
+#include <qcc/String.h>
+#include <qcc/StringUtil.h>
+
+#include <alljoyn/MsgArg.h>
+
+#include "Benchmark.h"
+
+using namespace std;
+using namespace qcc;
+using namespace ajn;
+using namespace ajn::benchmark;
+
+static const char* STRING_VALUE = "org.alljoyn.Benchmark.StringValue";
+
+static void BM_MsgArg_SetUint32(State& state)
+{
+    MsgArg arg;
+    uint32_t v = 0;
+    while (state.KeepRunning()) {
+        arg.Set("u", v++);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+AJ_BENCHMARK(BM_MsgArg_SetUint32);
+
+static void BM_MsgArg_GetUint32(State& state)
+{
+    MsgArg arg("u", 42);
+    uint32_t v = 0;
+    while (state.KeepRunning()) {
+        arg.Get("u", &v);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+AJ_BENCHMARK(BM_MsgArg_GetUint32);
+
+static void BM_MsgArg_SetString(State& state)
+{
+    MsgArg arg;
+    while (state.KeepRunning()) {
+        arg.Set("s", STRING_VALUE);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+AJ_BENCHMARK(BM_MsgArg_SetString);
+
+static void BM_MsgArg_GetString(State& state)
+{
+    MsgArg arg("s", STRING_VALUE);
+    char* str = NULL;
+    while (state.KeepRunning()) {
+        arg.Get("s", &str);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+AJ_BENCHMARK(BM_MsgArg_GetString);
+
+static void BM_MsgArg_SetStruct(State& state)
+{
+    uint8_t bytes[16] = { 0 };
+    MsgArg arg;
+    while (state.KeepRunning()) {
+        arg.Set("(isay)", 7, STRING_VALUE, sizeof(bytes), bytes);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+AJ_BENCHMARK(BM_MsgArg_SetStruct);
+
+static void BM_MsgArg_GetStruct(State& state)
+{
+    uint8_t bytes[16] = { 0 };
+    MsgArg arg("(isay)", 7, STRING_VALUE, sizeof(bytes), bytes);
+    int32_t i;
+    char* str;
+    size_t len;
+    uint8_t* ay;
+    while (state.KeepRunning()) {
+        arg.Get("(isay)", &i, &str, &len, &ay);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+AJ_BENCHMARK(BM_MsgArg_GetStruct);
+
+/*
+ * Set an a{sv} dictionary with range() entries from pre-built entries.
+ */
+static void BM_MsgArg_SetDictionary(State& state)
+{
+    size_t n = (size_t)state.range();
+    vector<String> keys(n);
+    vector<MsgArg> entries(n);
+    for (size_t i = 0; i < n; ++i) {
+        keys[i] = "key" + U32ToString((uint32_t)i);
+    }
+    MsgArg arg;
+    while (state.KeepRunning()) {
+        for (size_t i = 0; i < n; ++i) {
+            entries[i].Set("{sv}", keys[i].c_str(), new MsgArg("u", (uint32_t)i));
+            entries[i].SetOwnershipFlags(MsgArg::OwnsArgs);
+        }
+        arg.Set("a{sv}", n, &entries[0]);
+    }
+    state.SetItemsProcessed(state.iterations() * n);
+}
+AJ_BENCHMARK(BM_MsgArg_SetDictionary)->Arg(4)->Arg(64);
+
+static void BM_MsgArg_GetDictionaryElement(State& state)
+{
+    size_t n = (size_t)state.range();
+    vector<String> keys(n);
+    vector<MsgArg> entries(n);
+    for (size_t i = 0; i < n; ++i) {
+        keys[i] = "key" + U32ToString((uint32_t)i);
+        entries[i].Set("{sv}", keys[i].c_str(), new MsgArg("u", (uint32_t)i));
+        entries[i].SetOwnershipFlags(MsgArg::OwnsArgs);
+    }
+    MsgArg arg("a{sv}", n, &entries[0]);
+    /* Look up the last key, the worst case for the linear search */
+    const char* key = keys[n - 1].c_str();
+    uint32_t v;
+    while (state.KeepRunning()) {
+        arg.GetElement("{su}", key, &v);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+AJ_BENCHMARK(BM_MsgArg_GetDictionaryElement)->Arg(4)->Arg(64);
+
+/*
+ * Deep copy of an array of strings, e.g. what Stabilize() does for a message argument.
+ */
+static void BM_MsgArg_CopyStringArray(State& state)
+{
+    size_t n = (size_t)state.range();
+    vector<const char*> strs(n, STRING_VALUE);
+    MsgArg arg("as", n, &strs[0]);
+    while (state.KeepRunning()) {
+        MsgArg copy(arg);
+    }
+    state.SetItemsProcessed(state.iterations() * n);
+}
+AJ_BENCHMARK(BM_MsgArg_CopyStringArray)->Arg(16)->Arg(256);
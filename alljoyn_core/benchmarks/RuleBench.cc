@@ -0,0 +1,107 @@
+/**
+ * @file
+ * Rule::IsMatch micro-benchmarks.
+ */
+
+/******************************************************************************
+ *
+ *
+ *    Copyright (c) Open Connectivity Foundation (OCF), AllJoyn Open Source
+ *    Project (AJOSP) Contributors and others.
+ *
+ *    SPDX-License-Identifier: Apache-2.0
+ *
+ *    All rights reserved. This program and the accompanying materials are
+ *    made available under the terms of the Apache License, Version 2.0
+ *    which accompanies this distribution, and is available at
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Copyright (c) Open Connectivity Foundation and Contributors to AllSeen
+ *    Alliance. All rights reserved.
+ *
+ *    Permission to use, copy, modify, and/or distribute this software for
+ *    any purpose with or without fee is hereby granted, provided that the
+ *    above copyright notice and this permission notice appear in all
+ *    copies.
+ *
+ *    THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+ *    WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+ *    WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ *    AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ *    DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ *    PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+ *    TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ *    PERFORMANCE OF THIS SOFTWARE.
+ ******************************************************************************/
+
+#include <qcc/platform.h>
+
+#include <alljoyn/BusAttachment.h>
+#include <alljoyn/Message.h>
+#include <alljoyn/MsgArg.h>
+
+#include "Rule.h"
+
+#include "Benchmark.h"
+#include "BenchMessage.h"
+
+using namespace qcc;
+using namespace ajn;
+using namespace ajn::benchmark;
+
+static void MatchRule(State& state, const char* ruleStr, bool expected)
+{
+    QStatus status;
+    Rule rule(ruleStr, &status);
+    if (status != ER_OK) {
+        state.SkipWithError("Bad match rule");
+        return;
+    }
+
+    BusAttachment bus("RuleBench");
+    bus.Start();
+    MsgArg args[2];
+    args[0].Set("s", "org.alljoyn.bench.arg0");
+    args[1].Set("u", 42);
+    BenchMessage bmsg(bus);
+    bmsg->Signal(":sender.1", args, ArraySize(args));
+    Message msg = Message::cast(bmsg);
+
+    while (state.KeepRunning()) {
+        if (rule.IsMatch(msg) != expected) {
+            state.SkipWithError("Unexpected match result");
+            break;
+        }
+    }
+    state.SetItemsProcessed(state.iterations());
+
+    bus.Stop();
+    bus.Join();
+}
+
+static void BM_Rule_IsMatch_Type(State& state)
+{
+    MatchRule(state, "type='signal'", true);
+}
+AJ_BENCHMARK(BM_Rule_IsMatch_Type);
+
+static void BM_Rule_IsMatch_AllFields(State& state)
+{
+    MatchRule(state, "type='signal',sender=':sender.1',interface='org.alljoyn.bench',member='Signal',path='/org/alljoyn/bench'", true);
+}
+AJ_BENCHMARK(BM_Rule_IsMatch_AllFields);
+
+static void BM_Rule_IsMatch_Mismatch(State& state)
+{
+    MatchRule(state, "type='signal',interface='org.alljoyn.other'", false);
+}
+AJ_BENCHMARK(BM_Rule_IsMatch_Mismatch);
+
+/*
+ * Matching on arguments requires the message body to be unmarshaled.
+ */
+static void BM_Rule_IsMatch_Arg0(State& state)
+{
+    MatchRule(state, "type='signal',interface='org.alljoyn.bench',arg0='org.alljoyn.bench.arg0'", true);
+}
+AJ_BENCHMARK(BM_Rule_IsMatch_Arg0);
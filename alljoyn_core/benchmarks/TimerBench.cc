@@ -0,0 +1,92 @@
+/**
+ * @file
+ * qcc::Timer alarm add/remove micro-benchmarks.
+ */
+
+/******************************************************************************
+ *
+ *
+ *    Copyright (c) Open Connectivity Foundation (OCF), AllJoyn Open Source
+ *    Project (AJOSP) Contributors and others.
+ *
+ *    SPDX-License-Identifier: Apache-2.0
+ *
+ *    All rights reserved. This program and the accompanying materials are
+ *    made available under the terms of the Apache License, Version 2.0
+ *    which accompanies this distribution, and is available at
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Copyright (c) Open Connectivity Foundation and Contributors to AllSeen
+ *    Alliance. All rights reserved.
+ *
+ *    Permission to use, copy, modify, and/or distribute this software for
+ *    any purpose with or without fee is hereby granted, provided that the
+ *    above copyright notice and this permission notice appear in all
+ *    copies.
+ *
+ *    THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+ *    WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+ *    WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ *    AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ *    DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ *    PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+ *    TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ *    PERFORMANCE OF THIS SOFTWARE.
+ ******************************************************************************/
+
+#include <qcc/platform.h>
+
+#include <vector>
+
+#include <qcc/Timer.h>
+
+#include "Benchmark.h"
+
+using namespace std;
+using namespace qcc;
+using namespace ajn::benchmark;
+
+namespace {
+
+class NullListener : public AlarmListener {
+  public:
+    void AlarmTriggered(const Alarm& alarm, QStatus reason) { QCC_UNUSED(alarm); QCC_UNUSED(reason); }
+};
+
+}
+
+/*
+ * Alarms are set far enough in the future that they never fire during the benchmark. The
+ * range() argument is the number of alarms already outstanding on the timer.
+ */
+static const uint32_t FAR_FUTURE = 3600 * 1000;
+
+static void BM_Timer_AddRemoveAlarm(State& state)
+{
+    NullListener listener;
+    AlarmListener* al = &listener;
+    Timer timer("TimerBench");
+    timer.Start();
+
+    vector<Alarm> background;
+    for (int64_t i = 0; i < state.range(); ++i) {
+        uint32_t when = FAR_FUTURE + (uint32_t)i;
+        background.push_back(Alarm(when, al));
+        timer.AddAlarm(background.back());
+    }
+
+    while (state.KeepRunning()) {
+        uint32_t when = FAR_FUTURE / 2;
+        Alarm alarm(when, al);
+        timer.AddAlarm(alarm);
+        if (!timer.RemoveAlarm(alarm, false)) {
+            state.SkipWithError("RemoveAlarm failed");
+            break;
+        }
+    }
+    state.SetItemsProcessed(state.iterations());
+
+    timer.Stop();
+    timer.Join();
+}
+AJ_BENCHMARK(BM_Timer_AddRemoveAlarm)->Arg(0)->Arg(64)->Arg(1024);
@@ -0,0 +1,146 @@
+/**
+ * @file
+ * Runs the AllJoyn micro-benchmarks.
+ */
+
+/******************************************************************************
+ *
+ *
+ *    Copyright (c) Open Connectivity Foundation (OCF), AllJoyn Open Source
+ *    Project (AJOSP) Contributors and others.
+ *
+ *    SPDX-License-Identifier: Apache-2.0
+ *
+ *    All rights reserved. This program and the accompanying materials are
+ *    made available under the terms of the Apache License, Version 2.0
+ *    which accompanies this distribution, and is available at
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Copyright (c) Open Connectivity Foundation and Contributors to AllSeen
+ *    Alliance. All rights reserved.
+ *
+ *    Permission to use, copy, modify, and/or distribute this software for
+ *    any purpose with or without fee is hereby granted, provided that the
+ *    above copyright notice and this permission notice appear in all
+ *    copies.
+ *
+ *    THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+ *    WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+ *    WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ *    AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ *    DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ *    PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+ *    TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ *    PERFORMANCE OF THIS SOFTWARE.
+ ******************************************************************************/
+
+#include <qcc/platform.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <qcc/Debug.h>
+#include <qcc/String.h>
+
+#include <alljoyn/Init.h>
+#include <alljoyn/version.h>
+
+#include "Benchmark.h"
+
+using namespace qcc;
+using namespace ajn::benchmark;
+
+static void Usage()
+{
+    printf("Usage: ajbench [-h] [-l] [-f <filter>] [-o <file>] [--format=console|json|csv] [-t <ms>] [-r <reps>]\n\n");
+    printf("Options:\n");
+    printf("   -h                    = Print this help message\n");
+    printf("   -l                    = List the benchmarks and exit\n");
+    printf("   -f <filter>           = Only run benchmarks whose name contains <filter>\n");
+    printf("   -o <file>             = Write the results to <file> instead of stdout\n");
+    printf("   --format=<format>     = Output format: console (default), json or csv\n");
+    printf("   -t <ms>               = Minimum time for each repetition in milliseconds (default 500)\n");
+    printf("   -r <reps>             = Number of repetitions, the median is reported (default 5)\n");
+}
+
+/*
+ * The benchmarks exercise error paths, keep the log output from skewing the results.
+ */
+static void DebugOut(DbgMsgType type, const char* module, const char* msg, void* context)
+{
+    QCC_UNUSED(type);
+    QCC_UNUSED(module);
+    QCC_UNUSED(msg);
+    QCC_UNUSED(context);
+}
+
+int CDECL_CALL main(int argc, char** argv)
+{
+    Runner runner;
+    Format format = FORMAT_CONSOLE;
+    const char* outFile = NULL;
+    bool list = false;
+
+    for (int i = 1; i < argc; ++i) {
+        if (0 == strcmp("-h", argv[i])) {
+            Usage();
+            return 0;
+        } else if (0 == strcmp("-l", argv[i])) {
+            list = true;
+        } else if ((0 == strcmp("-f", argv[i])) && (i + 1 < argc)) {
+            runner.SetFilter(argv[++i]);
+        } else if ((0 == strcmp("-o", argv[i])) && (i + 1 < argc)) {
+            outFile = argv[++i];
+        } else if ((0 == strcmp("-t", argv[i])) && (i + 1 < argc)) {
+            runner.SetMinTime(strtoul(argv[++i], NULL, 10));
+        } else if ((0 == strcmp("-r", argv[i])) && (i + 1 < argc)) {
+            runner.SetRepetitions(strtoul(argv[++i], NULL, 10));
+        } else if (0 == strcmp("--format=console", argv[i])) {
+            format = FORMAT_CONSOLE;
+        } else if (0 == strcmp("--format=json", argv[i])) {
+            format = FORMAT_JSON;
+        } else if (0 == strcmp("--format=csv", argv[i])) {
+            format = FORMAT_CSV;
+        } else {
+            Usage();
+            return 1;
+        }
+    }
+
+    if (list) {
+        runner.List(stdout);
+        return 0;
+    }
+
+    FILE* out = stdout;
+    if (outFile) {
+        out = fopen(outFile, "w");
+        if (!out) {
+            fprintf(stderr, "Unable to open %s\n", outFile);
+            return 1;
+        }
+    }
+
+    if (AllJoynInit() != ER_OK) {
+        return 1;
+    }
+    if (AllJoynRouterInit() != ER_OK) {
+        AllJoynShutdown();
+        return 1;
+    }
+    QCC_RegisterOutputCallback(DebugOut, NULL);
+
+    if (format == FORMAT_CONSOLE) {
+        fprintf(out, "AllJoyn Library version: %s\n", ajn::GetVersion());
+        fprintf(out, "AllJoyn Library build info: %s\n\n", ajn::GetBuildInfo());
+    }
+    size_t errors = runner.Run(out, format);
+
+    if (out != stdout) {
+        fclose(out);
+    }
+    AllJoynRouterShutdown();
+    AllJoynShutdown();
+    return errors ? 1 : 0;
+}
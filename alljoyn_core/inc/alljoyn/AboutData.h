@@ -788,6 +788,35 @@ class AboutData : public AboutDataListener, public AboutKeys {
      */
     QStatus GetAnnouncedAboutData(MsgArg* msgArg);
 
+    /**
+     * Allow AboutObj to reuse the dictionaries returned by GetAboutData for as
+     * long as GetAboutDataVersion does not change. The default is false.
+     *
+     * Only set this if GetAboutData returns the stored fields, a derived class
+     * that overrides GetAboutData to build different values on every call must
+     * leave it unset. The setting belongs to this instance and is not copied
+     * by the assignment operator.
+     *
+     * @param[in] cacheable true to allow the about data to be cached
+     */
+    void SetCacheable(bool cacheable);
+
+    /**
+     * Return a number that changes every time a field of this AboutData is set,
+     * or its translator or field details change.
+     *
+     * AboutObj reuses the dictionaries returned by GetAboutData for as long as
+     * this number does not change. Changes made through the MsgArg returned by
+     * GetField or directly to the Translator returned by GetTranslator are not
+     * tracked, they are picked up by the next AboutObj::Announce call. The
+     * version is always 0 unless SetCacheable(true) was called, or if a
+     * Translator other than the built-in one has been set since the
+     * translations can change at any time.
+     *
+     * @return the version of the AboutData or 0 if it must not be cached.
+     */
+    uint32_t GetAboutDataVersion();
+
     /**
      * Is the given field name required to make an About announcement
      *
@@ -39,6 +39,9 @@
 #include <alljoyn/BusObject.h>
 
 namespace ajn {
+
+class AboutData;
+
 /**
  * An AllJoyn BusObject that implements the org.alljoyn.About interface.
  *
@@ -107,6 +110,28 @@ class AboutObj : public BusObject {
      */
     QStatus Announce(SessionPort sessionPort, AboutDataListener& aboutData);
 
+    /**
+     * This is used to send the Announce signal with the fields of an AboutData.
+     *
+     * Unlike other AboutDataListeners an AboutData reports when its fields
+     * change. If it was made cacheable with AboutData::SetCacheable the
+     * dictionaries it returns for the GetAboutData method are reused until a
+     * field is set again or the next Announce call. Changes made through the
+     * MsgArg returned by AboutData::GetField are only picked up by the next
+     * Announce call. Otherwise it is handled like any other AboutDataListener
+     * and is never cached.
+     *
+     * @see Announce(SessionPort, AboutDataListener&)
+     *
+     * @param sessionPort the session port the interfaces can be connected with
+     * @param aboutData   the AboutData for this announce signal.
+     *
+     * @return
+     *  - ER_OK on success
+     *  - ER_ABOUT_SESSIONPORT_NOT_BOUND if the SessionPort given is not bound
+     */
+    QStatus Announce(SessionPort sessionPort, AboutData& aboutData);
+
     /**
      * Cancel the last announce signal sent. If no signals have been sent this
      * method call will return.
@@ -117,6 +142,17 @@ class AboutObj : public BusObject {
      */
     QStatus Unannounce();
   private:
+    /**
+     * Send the Announce signal.
+     *
+     * @param sessionPort the session port the interfaces can be connected with
+     * @param aboutData   the AboutDataListener for this announce signal.
+     * @param versioned   aboutData if it is an AboutData, NULL otherwise.
+     *
+     * @return status of the announcement, see Announce
+     */
+    QStatus AnnounceAboutData(SessionPort sessionPort, AboutDataListener& aboutData, AboutData* versioned);
+
     /**
      * Handles  GetAboutData method
      * @param[in]  member interface member
@@ -824,6 +824,46 @@ class _Message {
                     size_t numArgs,
                     uint8_t flags);
 
+    /**
+     * @internal
+     * Compose a header template for repeated calls to the same method. The template holds the
+     * marshalled header fields but has no serial number or body and is never sent itself.
+     *
+     * @param signature   The signature of the method arguments
+     * @param destination The destination for calls made with this template
+     * @param sessionId   The sessionId to use for these method calls or 0 for any
+     * @param objPath     The object the method calls are being sent to
+     * @param iface       The interface for the method (can be NULL)
+     * @param methodName  The name of the method to call
+     * @return
+     *      - #ER_OK if successful
+     *      - An error status otherwise
+     */
+    QStatus CallTemplate(const qcc::String& signature,
+                         const qcc::String& destination,
+                         SessionId sessionId,
+                         const qcc::String& objPath,
+                         const qcc::String& iface,
+                         const qcc::String& methodName);
+
+    /**
+     * @internal
+     * Compose a method call message from a header template built by CallTemplate(). The header
+     * fields are copied from the template, only the serial number, flags and body are new.
+     *
+     * @param callTemplate The header template
+     * @param args         The method call argument list (can be NULL)
+     * @param numArgs      The number of arguments
+     * @param flags        A logical OR of the AllJoyn flags
+     * @return
+     *      - #ER_OK if successful
+     *      - An error status otherwise
+     */
+    QStatus CallMsg(const _Message& callTemplate,
+                    const MsgArg* args,
+                    size_t numArgs,
+                    uint8_t flags);
+
     /**
      * @internal
      * Compose a signal message
@@ -1173,7 +1213,7 @@ class _Message {
     bool endianSwap;             ///< true if endianness will be swapped.
 
     MessageHeader msgHeader;     ///< Current message header.
-    uint8_t* _msgBuf;            ///< Pointer to the current msg buffer.
+    uint8_t* _msgBuf;            ///< Pointer to the current msg buffer (shared with copies of this message).
     uint64_t* msgBuf;            ///< Pointer to the current msg buffer (8 byte aligned pointer into _msgBuf).
     MsgArg* msgArgs;             ///< Pointer to the unmarshaled arguments.
     uint8_t numMsgArgs;          ///< Number of message args (signature cannot be longer than 255 chars).
@@ -1373,6 +1413,9 @@ class _Message {
      *
      * If authentication has not been done this will request authentications
      *
+     * @param inProcess  If true the message is only delivered in-process so the key and
+     *                   authorization checks are performed but the body is not encrypted.
+     *
      * @return
      *    - #ER_OK if the header fields are valid
      *    - #ER_BUS_NOT_AUTHORIZED not authorized to send encrypted messages
@@ -1381,7 +1424,34 @@ class _Message {
      *    - An error status otherwise
      *
      */
-    QStatus EncryptMessage();
+    QStatus EncryptMessage(bool inProcess = false);
+
+    /**
+     * Flag bit marking an LZ4 compressed body. This reuses the retired header compression flag
+     * and is only ever sent on bus-to-bus connections that negotiated body compression.
+     */
+    static const uint8_t BODY_COMPRESSED_FLAG = 0x40;
+
+    /**
+     * Replace the body with an LZ4 compressed copy ahead of writing the message to a bus-to-bus
+     * connection. The compressed body is preceded by the uncompressed length as a UINT32. Bodies
+     * that are encrypted, carry handles, are shorter than the threshold or do not shrink are left
+     * as they are. The message gets its own buffer so copies sharing the marshalled bytes are not
+     * affected.
+     *
+     * @param threshold  Smallest body length to compress.
+     */
+    void CompressBody(size_t threshold);
+
+    /**
+     * Expand a body that was compressed by CompressBody() on the other side of a bus-to-bus
+     * connection. Must be called on a message that has been read but not yet unmarshalled.
+     *
+     * @return
+     *    - #ER_OK if the body was expanded
+     *    - #ER_BUS_BAD_BODY_LEN if the body is malformed or expands past the maximum packet length
+     */
+    QStatus ExpandBody();
 
     /**
      * Marshal (serialize) the Message so it is in the wire format
@@ -1422,6 +1492,50 @@ class _Message {
      *    - An error status otherwise
      */
     QStatus MarshalArgs(const MsgArg* arg, size_t numArgs);
+    /**
+     * Marshal the message body after the header fields and keep the copies of the args needed
+     * for access checks and in-process delivery. msgHeader.bodyLen must already be set.
+     *
+     * @param[in] args pointer to an array of MsgArgs to be marshaled
+     * @param[in] numArgs the number of MsgArgs in args
+     * @param[in] deferBody if true the destination is in-process so the args are carried with
+     *                      the message and marshalling the body is deferred
+     *
+     * @return
+     *    - #ER_OK if successful
+     *    - An error status otherwise
+     */
+    QStatus MarshalBody(const MsgArg* args, uint8_t numArgs, bool deferBody = false);
+    /**
+     * Check if the body of a message being marshalled can be deferred because the message is for
+     * another bus attachment linked in-process to the bundled router.
+     *
+     * @param destination  destination of the message
+     * @param signature    signature of the message body
+     * @param flags        the message flags
+     *
+     * @return true if the body can be deferred
+     */
+    bool IsInProcessBody(const qcc::String& destination, const char* signature, uint8_t flags);
+    /**
+     * Marshal a body that was deferred for in-process delivery from the carried args, or from
+     * the adopted args once the receiver took them. Must be called before anything reads the
+     * body from the message buffer.
+     *
+     * @return
+     *    - #ER_OK if successful or the body was not deferred
+     *    - An error status otherwise
+     */
+    QStatus MarshalDeferredBody();
+    /**
+     * Set up encryption for a message being marshalled with the given flags
+     *
+     * @param destination  destination of the message
+     * @param flags        the message flags
+     *
+     * @return  The extra space needed in the buffer for the encryption values
+     */
+    size_t PrepareEncryption(const qcc::String& destination, uint8_t flags);
     /**
      * Marshal the header fields
      *
@@ -1436,6 +1550,80 @@ class _Message {
      * @return the space required for the header fields
      */
     size_t ComputeHeaderLen();
+    /**
+     * Allocate a new reference counted message buffer and set _msgBuf and msgBuf to point to it.
+     * The caller is responsible for releasing any previous buffer.
+     *
+     * @param size  Number of bytes required after the 8 byte aligned start of the buffer
+     */
+    void AllocMsgBuf(size_t size);
+    /**
+     * Release a reference to a message buffer, freeing it when it is no longer shared.
+     *
+     * @param buf  The buffer to release (may be NULL)
+     */
+    static void ReleaseMsgBuf(uint8_t* buf);
+    /**
+     * Give this message a private copy of its buffer if the buffer is shared with other copies of
+     * the message. Must be called before modifying the marshalled bytes in place.
+     */
+    void UnshareMsgBuf();
+    /**
+     * Copy the in-process state kept with a message buffer to the current buffer.
+     *
+     * @param buf  The buffer the current one was made from
+     */
+    void CopyMsgBufState(const uint8_t* buf);
+    /**
+     * Check if the body in the message buffer has not been marshalled yet because the message is
+     * for an in-process destination. MarshalDeferredBody() fills it in from the carried args.
+     *
+     * @return true if the body was deferred
+     */
+    bool IsBodyDeferred() const;
+    /**
+     * Set or clear the deferred body state of the message buffer.
+     *
+     * @param deferred  true if the body has not been marshalled yet
+     */
+    void SetBodyDeferred(bool deferred);
+    /**
+     * Check if the message was routed in-process through the bundled router and the body was
+     * left in plain text even though ALLJOYN_FLAG_ENCRYPTED is set. Such a message must never
+     * be delivered to a remote endpoint.
+     *
+     * @return true if encryption was skipped
+     */
+    bool IsEncryptionSkipped() const;
+    /**
+     * Record that the body in the message buffer was left in plain text for in-process delivery.
+     */
+    void SetEncryptionSkipped();
+    /**
+     * Carry a copy of the args with the message buffer for an in-process destination. Copies of
+     * the message share the carried args.
+     *
+     * @param args     The args the body is marshalled from
+     * @param numArgs  The number of args
+     */
+    void CarryArgs(const MsgArg* args, uint8_t numArgs);
+    /**
+     * Get the args carried with the message buffer.
+     *
+     * @param[out] numArgs  Returns the number of carried args
+     *
+     * @return The carried args or NULL if the message does not carry any
+     */
+    const MsgArg* GetCarriedArgs(uint8_t& numArgs) const;
+    /**
+     * Take the args carried with the message buffer. The args are moved if this message holds
+     * the only reference to them, otherwise they are copied.
+     *
+     * @param[out] numArgs  Returns the number of args
+     *
+     * @return The args, the caller owns the array
+     */
+    MsgArg* AdoptCarriedArgs(uint8_t& numArgs);
     /// @}
     // end internal_methods_message_marshal defgroup
 
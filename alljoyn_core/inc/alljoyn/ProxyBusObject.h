@@ -71,7 +71,6 @@ class ProxyBusObject : public MessageReceiver {
     friend class XmlHelper;
     friend class AllJoynObj;
     friend class AllJoynPeerObj;
-    friend class KeyExchangerCB;
     friend class MatchRuleTracker;
     friend class LegacyIntrospectionHandler;
 
@@ -1009,6 +1008,23 @@ class ProxyBusObject : public MessageReceiver {
         return MethodCallAsync(method, NULL, NULL, args, numArgs, NULL, 0, flags |= ALLJOYN_FLAG_NO_REPLY_EXPECTED);
     }
 
+    /**
+     * Prepare this object for repeated calls to a method. The header fields that are the same for
+     * every call (destination, object path, interface, member, signature and session) are marshaled
+     * once and kept with the object, later calls to MethodCall() or MethodCallAsync() for this
+     * method only stamp a new serial number and marshal the arguments.
+     *
+     * Calling this method again for the same member rebuilds the prepared header.
+     *
+     * @param method       Method that will be invoked repeatedly.
+     *
+     * @return
+     *      - #ER_OK if the method call was prepared
+     *      - #ER_BUS_OBJECT_NO_SUCH_INTERFACE if this object does not implement the method's interface
+     *      - An error status otherwise
+     */
+    QStatus PrepareMethodCall(const InterfaceDescription::Member& method) const;
+
     /**
      * Make an asynchronous method call from this object
      *
@@ -1228,6 +1244,55 @@ class ProxyBusObject : public MessageReceiver {
      */
     void SyncReplyHandler(Message& msg, void* context);
 
+    /**
+     * @internal
+     * Build a method call message, using the header prepared by PrepareMethodCall() if there is one.
+     *
+     * @param method       Method being invoked.
+     * @param msg          Message to build the method call in.
+     * @param args         The arguments for the method call (can be NULL)
+     * @param numArgs      The number of arguments
+     * @param flags        Logical OR of the message flags for this method call.
+     *
+     * @return
+     *      - ER_OK if successful
+     *      - An error status otherwise
+     */
+    QStatus BuildMethodCall(const InterfaceDescription::Member& method,
+                            Message& msg,
+                            const MsgArg* args,
+                            size_t numArgs,
+                            uint8_t flags) const;
+
+    /**
+     * @internal
+     * Make an asynchronous method call and keep a copy of the method call message that was sent.
+     * Used by AllJoynPeerObj which hashes the messages of an authentication conversation.
+     *
+     * @param method       Method being invoked.
+     * @param receiver     The object to be called when the asych method call completes.
+     * @param replyFunc    The function that is called to deliver the reply
+     * @param args         The arguments for the method call (can be NULL)
+     * @param numArgs      The number of arguments
+     * @param context      User-defined context that will be returned to the reply handler
+     * @param timeout      Timeout specified in milliseconds to wait for a reply
+     * @param flags        Logical OR of the message flags for this method call.
+     * @param callMsg      Returns a copy of the method call message that was sent.
+     *
+     * @return
+     *      - ER_OK if successful
+     *      - An error status otherwise
+     */
+    QStatus MethodCallAsync(const InterfaceDescription::Member& method,
+                            MessageReceiver* receiver,
+                            MessageReceiver::ReplyHandler replyFunc,
+                            const MsgArg* args,
+                            size_t numArgs,
+                            void* context,
+                            uint32_t timeout,
+                            uint8_t flags,
+                            Message* callMsg) const;
+
     /**
      * @internal
      * Helper function to make an asynchronous request to get a property from an interface on the remote object.
@@ -41,6 +41,7 @@
 
 #include <map>
 
+#include <qcc/LockProfiler.h>
 #include <qcc/Log.h>
 #include <qcc/String.h>
 
@@ -81,6 +82,8 @@ QStatus AllJoynDebugObj::Init()
         const MethodEntry methodEntries[] = {
             { alljoynDbgIntf->GetMember("SetDebugLevel"),
               static_cast<MessageReceiver::MethodHandler>(&AllJoynDebugObj::SetDebugLevel) },
+            { alljoynDbgIntf->GetMember("GetLockProfile"),
+              static_cast<MessageReceiver::MethodHandler>(&AllJoynDebugObj::GetLockProfile) },
         };
 
         status = AddMethodHandlers(methodEntries, ArraySize(methodEntries));
@@ -184,6 +187,35 @@ void AllJoynDebugObj::GetProp(const InterfaceDescription::Member* member, Messag
     } // else someone off-device is trying to set our debug output, punish them by not responding.
 }
 
+/**
+ * Handles the GetLockProfile method call.
+ *
+ * @param member    Member
+ * @param msg       The incoming message
+ */
+void AllJoynDebugObj::GetLockProfile(const InterfaceDescription::Member* member, Message& msg)
+{
+    QCC_UNUSED(member);
+
+    const qcc::String guid(busController->GetBus().GetInternal().GetGlobalGUID().ToShortString());
+    qcc::String sender(msg->GetSender());
+    // Lock sites reveal details of the router internals so only local connections may read them
+    if (sender.substr(1, guid.size()) == guid) {
+        bool reset;
+        QStatus status = msg->GetArgs("b", &reset);
+        if (status == ER_OK) {
+            qcc::String profile = qcc::LockProfiler::Dump();
+            if (reset) {
+                qcc::LockProfiler::Reset();
+            }
+            MsgArg replyArg("s", profile.c_str());
+            MethodReply(msg, &replyArg, 1);
+        } else {
+            MethodReply(msg, "org.alljoyn.Debug.InternalError", QCC_StatusText(status));
+        }
+    }
+}
+
 
 AllJoynDebugObj::AllJoynDebugObj(BusController* busController) :
     BusObject(org::alljoyn::Daemon::Debug::ObjectPath),
@@ -179,6 +179,14 @@ class AllJoynDebugObj : public BusObject {
      */
     void SetDebugLevel(const InterfaceDescription::Member* member, Message& msg);
 
+    /**
+     * Handles the GetLockProfile method call.
+     *
+     * @param member    Member
+     * @param msg       The incoming message
+     */
+    void GetLockProfile(const InterfaceDescription::Member* member, Message& msg);
+
     void GenericMethodHandler(const InterfaceDescription::Member* member, Message& msg);
 
     BusController* busController;
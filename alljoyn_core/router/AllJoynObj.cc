@@ -1727,7 +1727,7 @@ bool AllJoynObj::NamesHandler(Message msg, MsgArg arg)
 
     /* Create a virtual endpoint for each unique name in args */
     AcquireLocks();
-    map<std::string, RemoteEndpoint>::iterator bit = b2bEndpoints.find(msg->GetRcvEndpointName());
+    B2BEndpointMap::iterator bit = b2bEndpoints.find(StringMapKey::Borrow(msg->GetRcvEndpointName()));
 
     if (bit == b2bEndpoints.end()) {
         QCC_LogError(ER_BUS_NO_ENDPOINT, ("Cannot find b2b endpoint %s", msg->GetRcvEndpointName()));
@@ -1741,10 +1741,10 @@ bool AllJoynObj::NamesHandler(Message msg, MsgArg arg)
     QCC_DbgTrace(("AllJoynObj::NamesHandler processing %d unique names", numItems));
 
     const String& shortOtherGuidStr = senderGuid.ToShortString();
-    std::string key = bit->first;
+    StringMapKey key = bit->first;
     for (size_t i = 0; i < numItems; ++i) {
         if (bit == b2bEndpoints.end()) {
-            QCC_DbgPrintf(("b2bEp %s disappeared during NamesHandler", key.c_str()));
+            QCC_DbgPrintf(("b2bEp %s disappeared during NamesHandler", key.ToString().c_str()));
             break;
         }
 
@@ -1777,7 +1777,7 @@ bool AllJoynObj::NamesHandler(Message msg, MsgArg arg)
         VirtualEndpoint vep = VirtualEndpoint::cast(tempEp);
         bit = b2bEndpoints.find(key);
         if (bit == b2bEndpoints.end()) {
-            QCC_DbgPrintf(("b2bEp %s disappeared during NamesHandler", key.c_str()));
+            QCC_DbgPrintf(("b2bEp %s disappeared during NamesHandler", key.ToString().c_str()));
             break;
         }
 
@@ -1792,7 +1792,7 @@ bool AllJoynObj::NamesHandler(Message msg, MsgArg arg)
                 AcquireLocks();
                 bit = b2bEndpoints.find(key);
                 if (bit == b2bEndpoints.end()) {
-                    QCC_DbgPrintf(("b2bEp %s disappeared during NamesSignalHandler", key.c_str()));
+                    QCC_DbgPrintf(("b2bEp %s disappeared during NamesSignalHandler", key.ToString().c_str()));
                     break;
                 }
                 if (madeChange) {
@@ -1833,7 +1833,7 @@ bool AllJoynObj::NamesHandler(Message msg, MsgArg arg)
                                    0);
         }
 
-        map<std::string, RemoteEndpoint>::iterator it = b2bEndpoints.begin();
+        B2BEndpointMap::iterator it = b2bEndpoints.begin();
         while (it != b2bEndpoints.end()) {
             if ((it->second->GetFeatures().nameTransfer == SessionOpts::ALL_NAMES) && (senderGuid != it->second->GetRemoteGUID())) {
                 QCC_DbgPrintf(("Sending ExchangeName signal to %s", it->second->GetUniqueName().c_str()));
@@ -2693,7 +2693,7 @@ void AllJoynObj::RemoveSessionRefs(const String& vepName, const String& b2bEpNam
             /* Let directly connected daemons that are in the same session know that this session endpoint is gone.
              * Note: This must be done only for non-router endpoints
              */
-            map<std::string, RemoteEndpoint>::iterator it2 = b2bEndpoints.begin();
+            B2BEndpointMap::iterator it2 = b2bEndpoints.begin();
             const qcc::GUID128& otherSideGuid = b2bEp->GetRemoteGUID();
             /* Send a DetachSession message over bus-to-bus endpoints in an MP session
              * if the session Id of the endpoint which is leaving matches this session id.
@@ -2715,7 +2715,7 @@ void AllJoynObj::RemoveSessionRefs(const String& vepName, const String& b2bEpNam
                                                        0,
                                                        0);
                     if (ER_OK == status) {
-                        std::string key2 = it2->first;
+                        StringMapKey key2 = it2->first;
                         RemoteEndpoint ep = it2->second;
                         ReleaseLocks();
                         status = ep->PushMessage(sigMsg);
@@ -4086,7 +4086,7 @@ void AllJoynObj::RemoveBusToBusEndpoint(RemoteEndpoint& endpoint)
      * that another thread does not try to re-add the B2B endpoint to a
      * virtual endpoint while this function is in progress.
      */
-    b2bEndpoints.erase(endpoint->GetUniqueName());
+    b2bEndpoints.erase(StringMapKey::Borrow(endpoint->GetUniqueName()));
 
     /* Remove any virtual endpoints associated with a removed bus-to-bus endpoint */
     map<qcc::String, VirtualEndpoint>::iterator it = virtualEndpoints.begin();
@@ -4125,7 +4125,7 @@ void AllJoynObj::RemoveBusToBusEndpoint(RemoteEndpoint& endpoint)
                 String exitingEpName = it->second->GetUniqueName();
 
                 /* Let directly connected daemons that are interested know that this virtual endpoint is gone. */
-                map<std::string, RemoteEndpoint>::iterator it2 = b2bEndpoints.begin();
+                B2BEndpointMap::iterator it2 = b2bEndpoints.begin();
                 const qcc::GUID128& otherSideGuid = endpoint->GetRemoteGUID();
                 guidToBeChecked = otherSideGuid.ToString();
                 /* Forward the message over bus-to-bus endpoints with name transfer ALL_NAMES or over an MP session
@@ -4153,7 +4153,7 @@ void AllJoynObj::RemoveBusToBusEndpoint(RemoteEndpoint& endpoint)
                                                            0);
                         if (ER_OK == status) {
                             std::string key = it->first;
-                            std::string key2 = it2->first;
+                            StringMapKey key2 = it2->first;
                             RemoteEndpoint ep = it2->second;
                             ReleaseLocks();
                             status = ep->PushMessage(sigMsg);
@@ -4419,7 +4419,7 @@ void AllJoynObj::NameChangedSignalHandler(const InterfaceDescription::Member* me
 
     /* Ignore a NameChange for non-local names from routers that predate the DAEMON_NAMES(now SLS_NAMES) flag */
     AcquireLocks();
-    map<std::string, RemoteEndpoint>::iterator bit = b2bEndpoints.find(msg->GetRcvEndpointName());
+    B2BEndpointMap::iterator bit = b2bEndpoints.find(StringMapKey::Borrow(msg->GetRcvEndpointName()));
     if (bit != b2bEndpoints.end() && (bit->second->GetFeatures().nameTransfer == SessionOpts::SLS_NAMES)) {
         qcc::GUID128 otherGuid = bit->second->GetRemoteGUID();
         const String& shortOtherGuidStr = otherGuid.ToShortString();
@@ -4434,7 +4434,7 @@ void AllJoynObj::NameChangedSignalHandler(const InterfaceDescription::Member* me
 
     if (alias[0] == ':') {
         AcquireLocks();
-        bit = b2bEndpoints.find(msg->GetRcvEndpointName());
+        bit = b2bEndpoints.find(StringMapKey::Borrow(msg->GetRcvEndpointName()));
         if (bit != b2bEndpoints.end()) {
             /* Change affects a remote unique name (i.e. a VirtualEndpoint) */
             if (newOwner.empty()) {
@@ -4497,8 +4497,8 @@ void AllJoynObj::NameChangedSignalHandler(const InterfaceDescription::Member* me
     if (madeChanges) {
         /* Forward message to directly connected controllers that are interested except the one that sent us this NameChanged */
         AcquireLocks();
-        map<std::string, RemoteEndpoint>::const_iterator cBit = b2bEndpoints.find(msg->GetRcvEndpointName());
-        map<std::string, RemoteEndpoint>::iterator it = b2bEndpoints.begin();
+        B2BEndpointMap::const_iterator cBit = b2bEndpoints.find(StringMapKey::Borrow(msg->GetRcvEndpointName()));
+        B2BEndpointMap::iterator it = b2bEndpoints.begin();
         while (it != b2bEndpoints.end()) {
 
             /* Forward the message over bus-to-bus endpoints with name transfer ALL_NAMES or over an MP session
@@ -4509,7 +4509,7 @@ void AllJoynObj::NameChangedSignalHandler(const InterfaceDescription::Member* me
 
 
             if (sendInfo && ((cBit == b2bEndpoints.end()) || (cBit->second->GetRemoteGUID() != it->second->GetRemoteGUID()))) {
-                String key = it->first.c_str();
+                StringMapKey key = it->first;
                 RemoteEndpoint ep = it->second;
                 ReleaseLocks();
                 QStatus status = ep->PushMessage(msg);
@@ -4517,7 +4517,7 @@ void AllJoynObj::NameChangedSignalHandler(const InterfaceDescription::Member* me
                     QCC_DbgHLPrintf(("Failed to forward NameChanged to %s: %s", ep->GetUniqueName().c_str(), QCC_StatusText(status)));
                 }
                 AcquireLocks();
-                cBit = b2bEndpoints.find(msg->GetRcvEndpointName());
+                cBit = b2bEndpoints.find(StringMapKey::Borrow(msg->GetRcvEndpointName()));
                 it = b2bEndpoints.upper_bound(key);
             } else {
                 ++it;
@@ -4781,7 +4781,7 @@ void AllJoynObj::NameOwnerChanged(const qcc::String& alias,
 
         /* Send NameChanged to all directly connected controllers */
         AcquireLocks();
-        map<std::string, RemoteEndpoint>::iterator it = b2bEndpoints.begin();
+        B2BEndpointMap::iterator it = b2bEndpoints.begin();
         while (it != b2bEndpoints.end()) {
 
             bool sendInfo = false;
@@ -4892,7 +4892,7 @@ void AllJoynObj::NameOwnerChanged(const qcc::String& alias,
                                            0);
 
                 if (ER_OK == status) {
-                    std::string key = it->first;
+                    StringMapKey key = it->first;
                     RemoteEndpoint ep = it->second;
                     ReleaseLocks();
 
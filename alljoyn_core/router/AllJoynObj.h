@@ -40,6 +40,7 @@
 #include <map>
 
 #include <qcc/String.h>
+#include <qcc/StringMapKey.h>
 #include <qcc/StringUtil.h>
 #include <qcc/Thread.h>
 #include <qcc/time.h>
@@ -949,7 +950,8 @@ class AllJoynObj : public BusObject, public NameListener, public TransportListen
 
     std::map<qcc::String, VirtualEndpoint> virtualEndpoints;   /**< Map of endpoints that reside behind a connected AllJoyn daemon */
 
-    std::map<std::string, RemoteEndpoint> b2bEndpoints;  /**< Map of bus-to-bus endpoints that are connected to external daemons */
+    typedef std::map<qcc::StringMapKey, RemoteEndpoint> B2BEndpointMap;
+    B2BEndpointMap b2bEndpoints;  /**< Map of bus-to-bus endpoints that are connected to external daemons */
 
     struct AdvAliasEntry {
         qcc::String name;
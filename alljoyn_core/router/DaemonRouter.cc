@@ -50,6 +50,7 @@
 #include "ConfigDB.h"
 #include "DaemonRouter.h"
 #include "EndpointHelper.h"
+#include "MessageTrace.h"
 #include "AllJoynObj.h"
 #include "SessionlessObj.h"
 #ifdef ENABLE_POLICYDB
@@ -221,6 +222,8 @@ QStatus DaemonRouter::PushMessage(Message& msg, BusEndpoint& src)
                   msg->IsSessionless() ? "sessionless " : "",
                   msg->Description().c_str(), msg->GetCallSerial(), src->GetUniqueName().c_str()));
 
+    MessageTrace::Stamp(MessageTrace::ROUTE, *msg);
+
     QCC_ASSERT(src->GetEndpointType() != ENDPOINT_TYPE_VIRTUAL);
     /*
      * Since asserts are compiled out in release code, we return an error here.
@@ -322,8 +325,8 @@ QStatus DaemonRouter::PushMessage(Message& msg, BusEndpoint& src)
      * sender in a form that is more efficient to test and easier to read.
      */
 
-    const String destination =        msg->GetDestination();
-    const bool isUnicast =            !destination.empty();
+    const char* destination =         msg->GetDestination();
+    const bool isUnicast =            (destination[0] != '\0');
     const bool isNulSession =         (sessionId == 0);
     const bool isBroadcast =          (!isUnicast && isNulSession);
     const bool isSessioncast =        (!isUnicast && !isNulSession);
@@ -399,7 +402,7 @@ QStatus DaemonRouter::PushMessage(Message& msg, BusEndpoint& src)
      */
     for (vector<BusEndpoint>::const_iterator it = allEps.begin(); it != allEps.end(); ++it) {
         BusEndpoint dest = *it;
-        const bool destIsDirect =     (isUnicast && nameTable.IsAlias(dest->GetUniqueName(), destination));
+        const bool destIsDirect =     (isUnicast && nameTable.IsAlias(dest->GetUniqueName().c_str(), destination));
         // Is dest directly connected to this router?
         const bool destIsOurEp =      ((dest->GetEndpointType() == ENDPOINT_TYPE_LOCAL) ||
                                        (dest->GetEndpointType() == ENDPOINT_TYPE_NULL) ||
@@ -475,7 +478,7 @@ QStatus DaemonRouter::PushMessage(Message& msg, BusEndpoint& src)
         add = add && (!isUnicast || destIsDirect);
         if (isUnicast) {
             QCC_DbgPrintf(("    unicast dest->GetUniqueName() => %s   destination = %s   add = %d",
-                           dest->GetUniqueName().c_str(), destination.c_str(), add));
+                           dest->GetUniqueName().c_str(), destination, add));
         }
 
         /*
@@ -627,7 +630,7 @@ void DaemonRouter::GetBusNames(vector<qcc::String>& names) const
     nameTable.GetBusNames(names);
 }
 
-BusEndpoint DaemonRouter::FindEndpoint(const qcc::String& busName)
+BusEndpoint DaemonRouter::FindEndpoint(const char* busName)
 {
     BusEndpoint ep = nameTable.FindEndpoint(busName);
     if (!ep->IsValid()) {
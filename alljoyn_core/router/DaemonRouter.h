@@ -194,7 +194,15 @@ class DaemonRouter : public Router {
      * @param busname    Unique or well-known bus name
      * @return Returns either the bus endpoint or an invalid bus endpoint with
      */
-    BusEndpoint FindEndpoint(const qcc::String& busname);
+    BusEndpoint FindEndpoint(const qcc::String& busname) { return FindEndpoint(busname.c_str()); }
+
+    /**
+     * Find the endpoint that owns the given unique or well-known name without copying the name.
+     *
+     * @param busname    Unique or well-known bus name
+     * @return Returns either the bus endpoint or an invalid bus endpoint with
+     */
+    BusEndpoint FindEndpoint(const char* busname);
 
     /**
      * Find the remote or bus-to-bus endpoint that owns the given unique or well-known name.
@@ -114,6 +114,21 @@ class DaemonTransport : public Transport, public _RemoteEndpoint::EndpointListen
      */
     TransportMask GetTransportMask() const { return TRANSPORT_LOCAL; }
 
+    /**
+     * Indicates whether this transport can carry sessions with the given options. Local clients
+     * are connected over a reliable stream so, like the LocalTransport, any reliable traffic is
+     * supported. Without this a router that only listens on local sockets cannot bind session ports.
+     *
+     * @param opts  Proposed session options.
+     * @return
+     *      - true if the SessionOpts specifies a supported option set.
+     *      - false otherwise.
+     */
+    bool SupportsOptions(const SessionOpts& opts) const
+    {
+        return (opts.traffic == SessionOpts::TRAFFIC_MESSAGES) || (opts.traffic == SessionOpts::TRAFFIC_RAW_RELIABLE);
+    }
+
     /**
      * @internal
      * @brief Normalize a transport specification.
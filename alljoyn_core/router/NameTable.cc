@@ -121,7 +121,7 @@ void NameTable::RemoveUniqueName(const qcc::String& uniqueName)
 
     /* Erase the unique bus name and any well-known names that use the same endpoint */
     lock.Lock(MUTEX_CONTEXT);
-    UniqueNameMap::iterator it = uniqueNames.find(uniqueName);
+    UniqueNameMap::iterator it = uniqueNames.find(StringMapKey::Borrow(uniqueName));
     if (it != uniqueNames.end()) {
         BusEndpoint endpoint = it->second.endpoint;
         SessionOpts::NameTransferType nameTransfer = it->second.nameTransfer;
@@ -135,14 +135,14 @@ void NameTable::RemoveUniqueName(const qcc::String& uniqueName)
                 if (lit->endpointName == endpoint->GetUniqueName()) {
                     if (lit == ait->second.begin()) {
                         uint32_t disposition;
-                        String alias = ait->first;
+                        String alias = ait->first.ToString();
                         String epName = endpoint->GetUniqueName();
                         /* Must unlock before calling RemoveAlias because it can call out (and cannot be locked at the time) */
                         lock.Unlock(MUTEX_CONTEXT);
                         RemoveAlias(alias, epName, disposition, NULL, NULL);
                         lock.Lock(MUTEX_CONTEXT);
                         /* Make sure iterator is still valid */
-                        it = uniqueNames.find(uniqueName);
+                        it = uniqueNames.find(StringMapKey::Borrow(uniqueName));
                         if (it == uniqueNames.end()) {
                             break;
                         }
@@ -194,9 +194,9 @@ QStatus NameTable::AddAlias(const qcc::String& aliasName,
     QCC_DbgTrace(("NameTable: AddAlias(%s, %s)", aliasName.c_str(), uniqueName.c_str()));
 
     lock.Lock(MUTEX_CONTEXT);
-    UniqueNameMap::const_iterator it = uniqueNames.find(uniqueName);
+    UniqueNameMap::const_iterator it = uniqueNames.find(StringMapKey::Borrow(uniqueName));
     if (it != uniqueNames.end()) {
-        AliasMap::iterator wasIt = aliasNames.find(aliasName);
+        AliasMap::iterator wasIt = aliasNames.find(StringMapKey::Borrow(aliasName));
         NameQueueEntry entry = { uniqueName, flags };
         /*
          * The value of origOwner comes from data that may be freed after the lock is released, so we can't
@@ -235,7 +235,7 @@ QStatus NameTable::AddAlias(const qcc::String& aliasName,
             newOwner = &uniqueName;
 
             /* Check to see if we are overriding a virtual (remote) name */
-            map<std::string, VirtualAliasEntry>::const_iterator vit = virtualAliasNames.find(aliasName);
+            VirtualAliasMap::const_iterator vit = virtualAliasNames.find(StringMapKey::Borrow(aliasName));
             if (vit != virtualAliasNames.end()) {
                 origOwner = vit->second.endpoint->GetUniqueName();
                 origOwnerNameTransfer = vit->second.nameTransfer;
@@ -275,7 +275,7 @@ void NameTable::RemoveAlias(const qcc::String& aliasName,
     lock.Lock(MUTEX_CONTEXT);
 
     /* Find endpoint for aliasName */
-    AliasMap::iterator it = aliasNames.find(aliasName);
+    AliasMap::iterator it = aliasNames.find(StringMapKey::Borrow(aliasName));
     if (it != aliasNames.end()) {
         deque<NameQueueEntry>& queue = it->second;
 
@@ -291,7 +291,7 @@ void NameTable::RemoveAlias(const qcc::String& aliasName,
             }
             if (newOwner.empty()) {
                 /* Check to see if there is a (now unmasked) remote owner for the alias */
-                map<std::string, VirtualAliasEntry>::const_iterator vit = virtualAliasNames.find(aliasName);
+                VirtualAliasMap::const_iterator vit = virtualAliasNames.find(StringMapKey::Borrow(aliasName));
                 if (vit != virtualAliasNames.end()) {
                     newOwner = vit->second.endpoint->GetUniqueName();
                     newOwnerNameTransfer = vit->second.nameTransfer;
@@ -342,25 +342,28 @@ bool NameTable::IsValidLocalUniqueName(const qcc::String& uniqueName) const
     return ret;
 }
 
-BusEndpoint NameTable::FindEndpoint(const qcc::String& busName) const
+BusEndpoint NameTable::FindEndpoint(const char* busName) const
 {
     BusEndpoint ep;
 
+    if (!busName) {
+        return ep;
+    }
     lock.Lock(MUTEX_CONTEXT);
     if (busName[0] == ':') {
-        UniqueNameMap::const_iterator it = uniqueNames.find(busName);
+        UniqueNameMap::const_iterator it = uniqueNames.find(StringMapKey::Borrow(busName));
         if (it != uniqueNames.end()) {
             ep = it->second.endpoint;
         }
     } else {
-        unordered_map<string, deque<NameQueueEntry> >::const_iterator it = aliasNames.find(busName);
+        AliasMap::const_iterator it = aliasNames.find(StringMapKey::Borrow(busName));
         if (it != aliasNames.end()) {
             QCC_ASSERT(!it->second.empty());
             ep = FindEndpoint(it->second[0].endpointName);
         }
         /* Fallback to virtual (remote) aliases if a suitable local one cannot be found */
         if (!ep->IsValid()) {
-            map<std::string, VirtualAliasEntry>::const_iterator vit = virtualAliasNames.find(busName);
+            VirtualAliasMap::const_iterator vit = virtualAliasNames.find(StringMapKey::Borrow(busName));
             if (vit != virtualAliasNames.end()) {
                 VirtualEndpoint vep = vit->second.endpoint;
                 ep = BusEndpoint::cast(vep);
@@ -377,12 +380,12 @@ void NameTable::GetBusNames(vector<qcc::String>& names) const
 
     AliasMap::const_iterator it = aliasNames.begin();
     while (it != aliasNames.end()) {
-        names.push_back(it->first);
+        names.push_back(it->first.ToString());
         ++it;
     }
     UniqueNameMap::const_iterator uit = uniqueNames.begin();
     while (uit != uniqueNames.end()) {
-        names.push_back(uit->first);
+        names.push_back(uit->first.ToString());
         ++uit;
     }
     lock.Unlock(MUTEX_CONTEXT);
@@ -396,7 +399,7 @@ void NameTable::GetUniqueNamesAndAliases(vector<pair<qcc::String, vector<qcc::St
     lock.Lock(MUTEX_CONTEXT);
     UniqueNameMap::const_iterator uit = uniqueNames.begin();
     while (uit != uniqueNames.end()) {
-        epMap.insert(pair<const BusEndpoint, qcc::String>(uit->second.endpoint, uit->first));
+        epMap.insert(pair<const BusEndpoint, qcc::String>(uit->second.endpoint, uit->first.ToString()));
         ++uit;
     }
     AliasMap::const_iterator ait = aliasNames.begin();
@@ -404,15 +407,15 @@ void NameTable::GetUniqueNamesAndAliases(vector<pair<qcc::String, vector<qcc::St
         if (!ait->second.empty()) {
             BusEndpoint ep = FindEndpoint(ait->second.front().endpointName);
             if (ep->IsValid()) {
-                epMap.insert(pair<BusEndpoint, qcc::String>(ep, ait->first));
+                epMap.insert(pair<BusEndpoint, qcc::String>(ep, ait->first.ToString()));
             }
         }
         ++ait;
     }
-    map<std::string, VirtualAliasEntry>::const_iterator vit = virtualAliasNames.begin();
+    VirtualAliasMap::const_iterator vit = virtualAliasNames.begin();
     while (vit != virtualAliasNames.end()) {
         VirtualEndpoint vep = vit->second.endpoint;
-        epMap.insert(pair<BusEndpoint, qcc::String>(BusEndpoint::cast(vep), vit->first.c_str()));
+        epMap.insert(pair<BusEndpoint, qcc::String>(BusEndpoint::cast(vep), vit->first.ToString()));
         ++vit;
     }
     lock.Unlock(MUTEX_CONTEXT);
@@ -463,59 +466,58 @@ String NameTable::GetNameOwner(const String& name) const
 {
     String un;
     lock.Lock(MUTEX_CONTEXT);
-    AliasMap::const_iterator aliasit = aliasNames.find(name);
+    const char* owner = GetNameOwnerLocked(name.c_str());
+    if (owner) {
+        un = owner;
+    }
+    lock.Unlock(MUTEX_CONTEXT);
+    return un;
+}
+
+const char* NameTable::GetNameOwnerLocked(const char* name) const
+{
+    AliasMap::const_iterator aliasit = aliasNames.find(StringMapKey::Borrow(name));
     if (aliasit != aliasNames.end()) {
         if (aliasit->second.begin() != aliasit->second.end()) {
             // current owner is at the front of the deque
-            un = aliasit->second.begin()->endpointName;
+            return aliasit->second.begin()->endpointName.c_str();
         }
     } else {
         // virtual alias maybe??
-        map<std::string, VirtualAliasEntry>::const_iterator valiasit = virtualAliasNames.find(name);
+        VirtualAliasMap::const_iterator valiasit = virtualAliasNames.find(StringMapKey::Borrow(name));
         if (valiasit != virtualAliasNames.end()) {
-            un = valiasit->second.endpoint->GetUniqueName();
+            return valiasit->second.endpoint->GetUniqueName().c_str();
         }
     }
-    lock.Unlock(MUTEX_CONTEXT);
-    return un;
+    return NULL;
 }
 
 
-bool NameTable::IsAlias(const String name1, const String name2) const
+bool NameTable::IsAlias(const char* name1, const char* name2) const
 {
-    QCC_DbgTrace(("NameTable::IsAlias(name1 = '%s', name2 = '%s')", name1.c_str(), name2.c_str()));
+    QCC_DbgTrace(("NameTable::IsAlias(name1 = '%s', name2 = '%s')", name1, name2));
 
-    String un1;
-    String un2;
-    if (name1[0] == ':') {
-        // name1 is already a unique name
-        un1 = name1;
-    } else {
-        un1 = GetNameOwner(name1);
-        if (un1.empty()) {
-            // No owner found.  Use value guaranteed to no match.
-            un1 = "1";
-        }
+    if (!name1 || !name2) {
+        return false;
     }
 
-    if (name2[0] == ':') {
-        // name2 is already a unique name
-        un2 = name2;
-    } else {
-        un2 = GetNameOwner(name2);
-        if (un2.empty()) {
-            // No owner found.  Use value guaranteed to no match.
-            un2 = "2";
-        }
-    }
+    /*
+     * Compare the owners while holding the lock so the owner names can be used in place. A name
+     * without an owner never matches anything.
+     */
+    lock.Lock(MUTEX_CONTEXT);
+    const char* un1 = (name1[0] == ':') ? name1 : GetNameOwnerLocked(name1);
+    const char* un2 = (name2[0] == ':') ? name2 : GetNameOwnerLocked(name2);
+    bool isAlias = un1 && un2 && (strcmp(un1, un2) == 0);
+    QCC_DbgTrace(("     '%s' == '%s' => %u", un1 ? un1 : "", un2 ? un2 : "", isAlias));
+    lock.Unlock(MUTEX_CONTEXT);
 
-    QCC_DbgTrace(("     '%s' == '%s' => %u", un1.c_str(), un2.c_str(), un1 == un2));
-    return un1 == un2;
+    return isAlias;
 }
 
 void NameTable::GetQueuedNames(const qcc::String& busName, std::vector<qcc::String>& names)
 {
-    AliasMap::iterator ait = aliasNames.find(busName.c_str());
+    AliasMap::iterator ait = aliasNames.find(StringMapKey::Borrow(busName));
     if (ait != aliasNames.end()) {
 
         names.reserve(ait->second.size()); //prevent dynamic resizing in loop
@@ -536,7 +538,7 @@ void NameTable::UpdateVirtualAliases(const qcc::String& epName)
     QCC_DbgTrace(("NameTable::UpdateVirtualAliases(%s)", ep->IsValid() ? ep->GetUniqueName().c_str() : "<none>"));
 
     if (ep->IsValid()) {
-        UniqueNameMap::iterator it = uniqueNames.find(epName);
+        UniqueNameMap::iterator it = uniqueNames.find(StringMapKey::Borrow(epName));
         if (it != uniqueNames.end() && it->second.endpoint == ep) {
             bool madeChange = false;
             SessionOpts::NameTransferType oldNameTransfer = it->second.nameTransfer;
@@ -552,7 +554,7 @@ void NameTable::UpdateVirtualAliases(const qcc::String& epName)
                 lock.Lock(MUTEX_CONTEXT);
             }
         }
-        map<std::string, VirtualAliasEntry>::iterator vit = virtualAliasNames.begin();
+        VirtualAliasMap::iterator vit = virtualAliasNames.begin();
         while (vit != virtualAliasNames.end()) {
             SessionOpts::NameTransferType oldNameTransfer = SessionOpts::ALL_NAMES;
             SessionOpts::NameTransferType newNameTransfer = SessionOpts::ALL_NAMES;
@@ -563,14 +565,14 @@ void NameTable::UpdateVirtualAliases(const qcc::String& epName)
                 madeChange = (oldNameTransfer != newNameTransfer);
                 vit->second.nameTransfer = newNameTransfer;
             }
-            String alias = vit->first.c_str();
-            if (madeChange && (aliasNames.find(alias) == aliasNames.end())) {
+            String alias = vit->first.ToString();
+            if (madeChange && (aliasNames.find(StringMapKey::Borrow(alias)) == aliasNames.end())) {
                 lock.Unlock(MUTEX_CONTEXT);
                 CallListeners(alias,
                               &epName, oldNameTransfer,
                               &epName, newNameTransfer);
                 lock.Lock(MUTEX_CONTEXT);
-                vit = virtualAliasNames.upper_bound(alias);
+                vit = virtualAliasNames.upper_bound(StringMapKey::Borrow(alias));
             } else {
                 ++vit;
             }
@@ -588,19 +590,19 @@ void NameTable::RemoveVirtualAliases(const qcc::String& epName)
     QCC_DbgTrace(("NameTable::RemoveVirtualAliases(%s)", ep->IsValid() ? ep->GetUniqueName().c_str() : "<none>"));
 
     if (ep->IsValid()) {
-        map<std::string, VirtualAliasEntry>::iterator vit = virtualAliasNames.begin();
+        VirtualAliasMap::iterator vit = virtualAliasNames.begin();
         while (vit != virtualAliasNames.end()) {
             if (vit->second.endpoint == ep) {
-                String alias = vit->first.c_str();
+                String alias = vit->first.ToString();
                 SessionOpts::NameTransferType nameTransfer = vit->second.nameTransfer;
                 virtualAliasNames.erase(vit++);
-                if (aliasNames.find(alias) == aliasNames.end()) {
+                if (aliasNames.find(StringMapKey::Borrow(alias)) == aliasNames.end()) {
                     lock.Unlock(MUTEX_CONTEXT);
                     CallListeners(alias,
                                   &epName, nameTransfer,
                                   NULL, SessionOpts::ALL_NAMES);
                     lock.Lock(MUTEX_CONTEXT);
-                    vit = virtualAliasNames.upper_bound(alias);
+                    vit = virtualAliasNames.upper_bound(StringMapKey::Borrow(alias));
                 }
             } else {
                 ++vit;
@@ -624,7 +626,7 @@ bool NameTable::SetVirtualAlias(const qcc::String& alias,
     VirtualEndpoint oldOwner;
     String oldName;
     SessionOpts::NameTransferType oldOwnerNameTransfer = SessionOpts::ALL_NAMES;
-    map<std::string, VirtualAliasEntry>::iterator vit = virtualAliasNames.find(alias);
+    VirtualAliasMap::iterator vit = virtualAliasNames.find(StringMapKey::Borrow(alias));
     if (vit != virtualAliasNames.end()) {
         oldOwner = vit->second.endpoint;
     }
@@ -646,7 +648,7 @@ bool NameTable::SetVirtualAlias(const qcc::String& alias,
         }
     }
 
-    bool maskingLocalName = (aliasNames.find(alias) != aliasNames.end());
+    bool maskingLocalName = (aliasNames.find(StringMapKey::Borrow(alias)) != aliasNames.end());
 
     String newName;
     SessionOpts::NameTransferType newOwnerNameTransfer = SessionOpts::ALL_NAMES;
@@ -657,7 +659,7 @@ bool NameTable::SetVirtualAlias(const qcc::String& alias,
         virtualAliasNames[alias] = entry;
         madeChange = !newOwner->iden(oldOwner) || (oldOwnerNameTransfer != newOwnerNameTransfer);
     } else {
-        virtualAliasNames.erase(std::string(alias));
+        virtualAliasNames.erase(StringMapKey::Borrow(alias));
         madeChange = true;
     }
     if (newOwner && (*newOwner)->IsValid()) {
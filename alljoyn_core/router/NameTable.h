@@ -38,12 +38,14 @@
 #include <qcc/platform.h>
 
 #include <deque>
+#include <map>
 #include <vector>
 #include <set>
 
 #include <qcc/Mutex.h>
 #include <qcc/Environ.h>
 #include <qcc/String.h>
+#include <qcc/StringMapKey.h>
 #include <qcc/LockLevel.h>
 
 #include <alljoyn/Status.h>
@@ -196,7 +198,15 @@ class NameTable {
      * @param busName   Name of bus.
      * @return  Returns the endpoint if it was found or an invalid endpoint if not found
      */
-    BusEndpoint FindEndpoint(const qcc::String& busName) const;
+    BusEndpoint FindEndpoint(const qcc::String& busName) const { return FindEndpoint(busName.c_str()); }
+
+    /**
+     * Find an endpoint for a given unique or alias bus name. The lookup does not copy the name.
+     *
+     * @param busName   Name of bus.
+     * @return  Returns the endpoint if it was found or an invalid endpoint if not found
+     */
+    BusEndpoint FindEndpoint(const char* busName) const;
 
     /**
      * Return whether this is a unique name of a locally connected endpoint.
@@ -235,7 +245,7 @@ class NameTable {
      *
      * @return  true if name1 and name2 are aliases of each other, false otherwise
      */
-    bool IsAlias(const qcc::String name1, const qcc::String name2) const;
+    bool IsAlias(const char* name1, const char* name2) const;
 
     /**
      * Get all the unique names that are in queue for the same alias (well-known) name
@@ -271,8 +281,9 @@ class NameTable {
         SessionOpts::NameTransferType nameTransfer;
     }  VirtualAliasEntry;
 
-    typedef std::unordered_map<std::string, std::deque<NameQueueEntry> > AliasMap;
-    typedef std::unordered_map<std::string, UniqueNameEntry> UniqueNameMap;
+    typedef std::unordered_map<qcc::StringMapKey, std::deque<NameQueueEntry>, qcc::StringMapKey::Hash> AliasMap;
+    typedef std::unordered_map<qcc::StringMapKey, UniqueNameEntry, qcc::StringMapKey::Hash> UniqueNameMap;
+    typedef std::map<qcc::StringMapKey, VirtualAliasEntry> VirtualAliasMap;
 
     mutable qcc::Mutex lock;                                             /**< Lock protecting name tables */
     UniqueNameMap uniqueNames;   /**< Unique name table */
@@ -282,7 +293,7 @@ class NameTable {
 
     typedef qcc::ManagedObj<NameListener*> ProtectedNameListener;
     std::set<ProtectedNameListener> listeners;                         /**< Listeners regsitered with name table */
-    std::map<std::string, VirtualAliasEntry> virtualAliasNames;    /**< map of virtual aliases to virtual endpts */
+    VirtualAliasMap virtualAliasNames;    /**< map of virtual aliases to virtual endpts */
 
     /**
      * Returns the minimum name transfer value for sessions with the endpoint.
@@ -314,6 +325,15 @@ class NameTable {
                        const qcc::String* newOwner, SessionOpts::NameTransferType newOwnerNameTransfer);
 
     qcc::String GetNameOwner(const qcc::String& name) const;
+
+    /**
+     * Get the unique name of the owner of a name without copying it. Must be called with the lock held.
+     *
+     * @param name  Unique or alias bus name.
+     *
+     * @return  The unique name of the owner (valid while the lock is held) or NULL if the name has no owner.
+     */
+    const char* GetNameOwnerLocked(const char* name) const;
 };
 
 /**
@@ -887,7 +887,7 @@ TCPTransport::TCPTransport(BusAttachment& bus)
     m_isNsEnabled(false), m_reload(STATE_RELOADING),
     m_nsReleaseCount(0),
     m_wildcardIfaceProcessed(false), m_wildcardAddressProcessed(false),
-    m_maxRemoteClientsTcp(0), m_numUntrustedClients(0), m_dynamicScoreUpdater(*this)
+    m_maxRemoteClientsTcp(0), m_numUntrustedClients(0), m_coalesceSignals(false), m_compressThreshold(0), m_dynamicScoreUpdater(*this)
 {
     QCC_DbgTrace(("TCPTransport::TCPTransport()"));
     /*
@@ -944,6 +944,13 @@ void TCPTransport::Authenticated(TCPEndpoint& conn)
 
     conn->SetEpStarting();
 
+    if (m_coalesceSignals) {
+        /* Corking takes care of batching, so don't let Nagle delay the flushes */
+        conn->m_stream.SetNagle(false);
+        conn->SetTxCoalescing(true);
+    }
+    conn->SetCompressThreshold(m_compressThreshold);
+
     QStatus status = conn->Start(m_defaultHbeatIdleTimeout, m_defaultHbeatProbeTimeout, m_numHbeatProbes, m_maxHbeatProbeTimeout);
     if (status != ER_OK) {
         QCC_LogError(status, ("TCPTransport::Authenticated(): Failed to start TCP endpoint"));
@@ -1742,6 +1749,8 @@ void* TCPTransport::Run(void* arg)
     m_defaultHbeatIdleTimeout = config->GetLimit("tcp_default_idle_timeout", DEFAULT_HEARTBEAT_IDLE_TIMEOUT_DEFAULT);
 
     m_numHbeatProbes = HEARTBEAT_NUM_PROBES;
+    m_coalesceSignals = (config->GetLimit("tcp_coalesce_signals", COALESCE_SIGNALS_DEFAULT) != 0);
+    m_compressThreshold = config->GetLimit("tcp_compress_threshold", COMPRESS_THRESHOLD_DEFAULT);
     m_maxHbeatProbeTimeout = config->GetLimit("tcp_max_probe_timeout", MAX_HEARTBEAT_PROBE_TIMEOUT_DEFAULT);
     m_defaultHbeatProbeTimeout = config->GetLimit("tcp_default_probe_timeout", DEFAULT_HEARTBEAT_PROBE_TIMEOUT_DEFAULT);
 
@@ -3207,7 +3216,10 @@ QStatus TCPTransport::Connect(const char* connectSpec, const SessionOpts& opts,
         return status;
     }
     m_endpointListLock.Unlock();
-    status = tcpEp->m_stream.SetNagle(false);
+    if (m_coalesceSignals) {
+        /* Corking takes care of batching, so don't let Nagle delay the flushes */
+        status = tcpEp->m_stream.SetNagle(false);
+    }
 
     if (status == ER_OK) {
         /*
@@ -3243,6 +3255,8 @@ QStatus TCPTransport::Connect(const char* connectSpec, const SessionOpts& opts,
         if (status == ER_OK) {
             tcpEp->SetListener(this);
             tcpEp->SetEpStarting();
+            tcpEp->SetTxCoalescing(m_coalesceSignals);
+            tcpEp->SetCompressThreshold(m_compressThreshold);
             status = tcpEp->Start(m_defaultHbeatIdleTimeout, m_defaultHbeatProbeTimeout, m_numHbeatProbes, m_maxHbeatProbeTimeout);
             if (status == ER_OK) {
                 tcpEp->SetEpStarted();
@@ -654,6 +654,23 @@ class TCPTransport : public Transport, public _RemoteEndpoint::EndpointListener,
      */
     static const uint32_t HEARTBEAT_NUM_PROBES = 1;
 
+    /**
+     * @brief Whether bursts of signals are corked and sent in full segments.
+     *
+     * This corresponds to the configuration item "tcp_coalesce_signals".
+     * Method calls and replies are always sent immediately.
+     */
+    static const uint32_t COALESCE_SIGNALS_DEFAULT = 1;
+
+    /**
+     * @brief The smallest message body, in bytes, that is compressed on bus-to-bus links.
+     *
+     * This corresponds to the configuration item "tcp_compress_threshold".
+     * Bodies are only compressed if the routing node at the other end supports it,
+     * 0 turns compression off.
+     */
+    static const uint32_t COMPRESS_THRESHOLD_DEFAULT = 1024;
+
     /*
      * The Android Compatibility Test Suite (CTS) is used by Google to enforce a
      * common idea of what it means to be Android.  One of their tests is to
@@ -831,6 +848,10 @@ class TCPTransport : public Transport, public _RemoteEndpoint::EndpointListener,
     uint32_t m_numHbeatProbes;             /**< Number of probes Routing node should wait for Heartbeat response to be
                                               recieved from the Leaf node before declaring it dead - Transport specific */
 
+    bool m_coalesceSignals;                /**< Cork TCP endpoints during bursts of signals - configurable in router config */
+
+    uint32_t m_compressThreshold;          /**< Smallest message body compressed on bus-to-bus links - configurable in router config */
+
     DynamicScoreUpdater m_dynamicScoreUpdater;
 };
 
@@ -1158,7 +1158,8 @@ class _UDPEndpoint : public _RemoteEndpoint {
          * message to MESSAGE_COMPLETE when we've pushed all of the bits.  That
          * would cause any subsequent PushMessage calls to complete before
          * actually writing any bits since they would think they are done.  This
-         * means we have to do a deep copy of every message before we send it.
+         * means we have to copy every message before we send it.  The copy
+         * has its own write state but shares the marshalled bytes.
          */
         Message msgCopy = Message(msg, true);
 
@@ -48,6 +48,12 @@
 
 #define QCC_MODULE "ALLJOYN_OBJ"
 
+/*
+ * Number of senders pinned to a session 0 route per virtual endpoint at which the pins
+ * to idle routes are dropped. Pins to busy routes are kept, so this is a soft limit.
+ */
+#define MAX_PINNED_SENDERS 256
+
 using namespace std;
 using namespace qcc;
 
@@ -68,6 +74,9 @@ _VirtualEndpoint::_VirtualEndpoint(const String& uniqueName, RemoteEndpoint& b2b
     SetGroupId(b2bEp->GetGroupId());
 
     m_b2bEndpoints.insert(pair<SessionId, RemoteEndpoint>(0, b2bEp));
+    if (IsDirectlyConnected(b2bEp)) {
+        m_directB2bEndpoints.push_back(b2bEp);
+    }
 }
 
 QStatus _VirtualEndpoint::PushMessage(Message& msg)
@@ -79,51 +88,130 @@ QStatus _VirtualEndpoint::PushMessage(Message& msg, SessionId id)
 {
     QCC_DbgTrace(("_VirtualEndpoint::PushMessage(this=%s [%x], SessionId=%u)", GetUniqueName().c_str(), this, id));
 
-    QStatus status = ER_BUS_NO_ROUTE;
-    vector<RemoteEndpoint> tryEndpoints;
+    m_b2bEndpointsLock.Lock(MUTEX_CONTEXT);
+    RemoteEndpoint route = SelectRoute(id, msg->GetSender());
+    m_b2bEndpointsLock.Unlock(MUTEX_CONTEXT);
+
+    if (!route->IsValid()) {
+        return ER_BUS_NO_ROUTE;
+    }
+    QStatus status = route->PushMessage(msg);
+
     /*
-     * There may be multiple routes from this virtual endpoint so we are going to try all of
-     * them until we either succeed or run out of options.
+     * There may be multiple routes from this virtual endpoint so if the preferred one
+     * failed we are going to try the others until we either succeed or run out of options.
      */
-    m_b2bEndpointsLock.Lock(MUTEX_CONTEXT);
-    if (id != 0) {
-        for (multimap<SessionId, RemoteEndpoint>::iterator it = m_b2bEndpoints.lower_bound(id); (it != m_b2bEndpoints.end()) && (id == it->first); ++it) {
-            RemoteEndpoint ep = it->second;
-            tryEndpoints.push_back(ep);
+    if (status != ER_OK) {
+        vector<RemoteEndpoint> tryEndpoints;
+        m_b2bEndpointsLock.Lock(MUTEX_CONTEXT);
+        GetFallbackRoutes(id, route, tryEndpoints);
+        m_b2bEndpointsLock.Unlock(MUTEX_CONTEXT);
+
+        for (vector<RemoteEndpoint>::iterator iter = tryEndpoints.begin(); (status != ER_OK) && (iter != tryEndpoints.end()); ++iter) {
+            status = (*iter)->PushMessage(msg);
         }
-    } else {
-        /*
-         * When the session ID is 0, any b2bEp is a valid choice.  Prefer the
-         * ones that are directly connected, which we can tell by comparing the
-         * GUIDs.
-         */
-        String thisShortGuid = GetRemoteGUIDShortString();
-        for (multimap<SessionId, RemoteEndpoint>::iterator it = m_b2bEndpoints.begin(); (it != m_b2bEndpoints.end()) && (id == it->first); ++it) {
-            RemoteEndpoint ep = it->second;
-            String epShortGuid = ep->GetRemoteName().substr(1, ep->GetRemoteName().find_last_of_std('.') - 1);
-            if (thisShortGuid == epShortGuid) {
-                tryEndpoints.push_back(ep);
-            }
+    }
+    return status;
+}
+
+bool _VirtualEndpoint::IsDirectlyConnected(const RemoteEndpoint& b2bEp)
+{
+    return b2bEp->GetRemoteGUID().ToShortString() == GetRemoteGUIDShortString();
+}
+
+bool _VirtualEndpoint::IsDirectRoute(const RemoteEndpoint& b2bEp) const
+{
+    for (vector<RemoteEndpoint>::const_iterator it = m_directB2bEndpoints.begin(); it != m_directB2bEndpoints.end(); ++it) {
+        if (*it == b2bEp) {
+            return true;
         }
-        for (multimap<SessionId, RemoteEndpoint>::iterator it = m_b2bEndpoints.begin(); (it != m_b2bEndpoints.end()) && (id == it->first); ++it) {
-            RemoteEndpoint ep = it->second;
-            String epShortGuid = ep->GetRemoteName().substr(1, ep->GetRemoteName().find_last_of_std('.') - 1);
-            if (thisShortGuid != epShortGuid) {
-                tryEndpoints.push_back(ep);
-            }
+    }
+    return false;
+}
+
+RemoteEndpoint _VirtualEndpoint::SelectRoute(SessionId id, const char* sender)
+{
+    RemoteEndpoint best;
+    /* A session is bound to the route it was set up on, queue depth only matters for session 0 */
+    if (id != 0) {
+        multimap<SessionId, RemoteEndpoint>::const_iterator it = m_b2bEndpoints.lower_bound(id);
+        if ((it != m_b2bEndpoints.end()) && (it->first == id)) {
+            best = it->second;
         }
+        return best;
+    }
+
+    multimap<SessionId, RemoteEndpoint>::const_iterator first = m_b2bEndpoints.begin();
+    if ((first == m_b2bEndpoints.end()) || (first->first != 0)) {
+        return best;
+    }
+    multimap<SessionId, RemoteEndpoint>::const_iterator next = first;
+    if ((++next == m_b2bEndpoints.end()) || (next->first != 0)) {
+        /* With a single route there is nothing to choose or pin */
+        return first->second;
+    }
+
+    String senderName(sender);
+    map<String, RemoteEndpoint>::const_iterator pit = m_senderRoutes.find(senderName);
+    if (pit != m_senderRoutes.end()) {
+        return pit->second;
     }
-    m_b2bEndpointsLock.Unlock(MUTEX_CONTEXT);
 
     /*
-     * We got the candidates so now try them all.
+     * When the session ID is 0, any b2bEp is a valid choice but the directly connected
+     * ones are preferred. A sender seen for the first time goes to the one with the least
+     * queued traffic, so a link added for a new session picks up new senders.
      */
-    for (vector<RemoteEndpoint>::iterator iter = tryEndpoints.begin(); iter != tryEndpoints.end(); ++iter) {
-        if (status != ER_OK) {
-            status = (*iter)->PushMessage(msg);
+    bool bestIsDirect = false;
+    size_t bestDepth = 0;
+    for (multimap<SessionId, RemoteEndpoint>::const_iterator it = first; (it != m_b2bEndpoints.end()) && (it->first == 0); ++it) {
+        bool isDirect = IsDirectRoute(it->second);
+        size_t depth = it->second->GetTxQueueDepth();
+        if (!best->IsValid() || (isDirect && !bestIsDirect) || ((isDirect == bestIsDirect) && (depth < bestDepth))) {
+            best = it->second;
+            bestIsDirect = isDirect;
+            bestDepth = depth;
+        }
+    }
+
+    if (m_senderRoutes.size() >= MAX_PINNED_SENDERS) {
+        EvictIdleSenders();
+    }
+    m_senderRoutes[senderName] = best;
+    return best;
+}
+
+void _VirtualEndpoint::EvictIdleSenders()
+{
+    /*
+     * Senders that left the bus are not tracked, so the pins go once in a while. A sender
+     * may only move once nothing is queued on its route, otherwise its next message could
+     * overtake the queued ones. Pins to busy routes stay until a later round.
+     */
+    for (map<String, RemoteEndpoint>::iterator it = m_senderRoutes.begin(); it != m_senderRoutes.end();) {
+        if (it->second->GetTxQueueDepth() == 0) {
+            m_senderRoutes.erase(it++);
+        } else {
+            ++it;
+        }
+    }
+}
+
+void _VirtualEndpoint::GetFallbackRoutes(SessionId id, const RemoteEndpoint& exclude, vector<RemoteEndpoint>& routes) const
+{
+    /* For session 0 the direct routes go first */
+    for (multimap<SessionId, RemoteEndpoint>::const_iterator it = m_b2bEndpoints.lower_bound(id); (it != m_b2bEndpoints.end()) && (id == it->first); ++it) {
+        if ((it->second != exclude) && ((id != 0) || IsDirectRoute(it->second))) {
+            routes.push_back(it->second);
+        }
+    }
+    if (id == 0) {
+        for (multimap<SessionId, RemoteEndpoint>::const_iterator it = m_b2bEndpoints.lower_bound(id); (it != m_b2bEndpoints.end()) && (id == it->first); ++it) {
+            if ((it->second != exclude) && !IsDirectRoute(it->second)) {
+                routes.push_back(it->second);
+            }
         }
     }
-    return status;
 }
 
 RemoteEndpoint _VirtualEndpoint::GetBusToBusEndpoint(SessionId sessionId, int* b2bCount) const
@@ -174,6 +262,9 @@ bool _VirtualEndpoint::AddBusToBusEndpoint(RemoteEndpoint& endpoint)
     }
     if (!found) {
         m_b2bEndpoints.insert(pair<SessionId, RemoteEndpoint>(0, endpoint));
+        if (IsDirectlyConnected(endpoint)) {
+            m_directB2bEndpoints.push_back(endpoint);
+        }
     }
     m_b2bEndpointsLock.Unlock(MUTEX_CONTEXT);
     return !found;
@@ -221,6 +312,20 @@ bool _VirtualEndpoint::RemoveBusToBusEndpoint(RemoteEndpoint& endpoint)
             ++it;
         }
     }
+    for (vector<RemoteEndpoint>::iterator dit = m_directB2bEndpoints.begin(); dit != m_directB2bEndpoints.end(); ++dit) {
+        if (*dit == endpoint) {
+            m_directB2bEndpoints.erase(dit);
+            break;
+        }
+    }
+    /* Senders pinned to the removed route move to the best remaining one on their next message */
+    for (map<String, RemoteEndpoint>::iterator sit = m_senderRoutes.begin(); sit != m_senderRoutes.end();) {
+        if (sit->second == endpoint) {
+            m_senderRoutes.erase(sit++);
+        } else {
+            ++sit;
+        }
+    }
 
     /*
      * This Virtual endpoint reports itself as empty (of b2b endpoints) when any of the following are true:
@@ -241,17 +346,10 @@ bool _VirtualEndpoint::RemoveBusToBusEndpoint(RemoteEndpoint& endpoint)
      */
     bool isEmpty = (m_b2bEndpoints.lower_bound(1) == m_b2bEndpoints.end());
     if (isEmpty) {
-        it = m_b2bEndpoints.begin();
-        while (it != m_b2bEndpoints.end()) {
-            /* If the Remote guid of a endpoint in the m_b2bEndpoints map is the same as the VirtualEndpoint GUID:
-             * then this Virtual endpoint is still valid.
-             */
-            if (it->second->GetRemoteGUID().ToShortString() == GetRemoteGUIDShortString()) {
-                isEmpty = false;
-                break;
-            }
-            ++it;
-        }
+        /* If any remaining b2b endpoint connects directly to the remote daemon of this Virtual endpoint:
+         * then this Virtual endpoint is still valid.
+         */
+        isEmpty = m_directB2bEndpoints.empty();
     }
     if (isEmpty) {
         /* The last b2b endpoint has been removed from this virtual endpoint. Set the state to STOPPING. */
@@ -263,6 +361,10 @@ bool _VirtualEndpoint::RemoveBusToBusEndpoint(RemoteEndpoint& endpoint)
 
 String _VirtualEndpoint::GetRemoteGUIDShortString()
 {
+    /* The constructor classifies its first route with this, so an empty name must not throw */
+    if (GetUniqueName().empty()) {
+        return String();
+    }
     size_t pos = GetUniqueName().find_first_of(".");
     return GetUniqueName().substr(1, pos - 1);
 }
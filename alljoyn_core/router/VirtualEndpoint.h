@@ -39,6 +39,9 @@
 #include <qcc/ManagedObj.h>
 #include <qcc/String.h>
 
+#include <map>
+#include <vector>
+
 #include "BusEndpoint.h"
 #include "RemoteEndpoint.h"
 
@@ -222,8 +225,52 @@ class _VirtualEndpoint : public _BusEndpoint {
     /* Private assigment operator - does nothing */
     _VirtualEndpoint operator=(const _VirtualEndpoint&);
 
+    /**
+     * Return true iff the given bus-to-bus endpoint is connected to the routing node
+     * that this virtual endpoint lives on, rather than to an intermediate one.
+     */
+    bool IsDirectlyConnected(const RemoteEndpoint& b2bEp);
+
+    /**
+     * Return true iff the given bus-to-bus endpoint is in m_directB2bEndpoints.
+     * Must be called with m_b2bEndpointsLock held.
+     */
+    bool IsDirectRoute(const RemoteEndpoint& b2bEp) const;
+
+    /**
+     * Pick the route for a message. Messages of a session stay on the first route of the
+     * session. Session 0 messages prefer direct routes and each sender is pinned to one
+     * route, chosen by transmit queue depth the first time the sender is seen, so that
+     * the messages of a sender are never reordered. The routes are the links the router
+     * already has, one per session joined; no links are opened or closed here for load.
+     * Must be called with m_b2bEndpointsLock held.
+     *
+     * @param id       The session id.
+     * @param sender   Unique name of the sender of the message.
+     * @return The chosen bus-to-bus endpoint, or an invalid endpoint if there is no route.
+     */
+    RemoteEndpoint SelectRoute(SessionId id, const char* sender);
+
+    /**
+     * Drop the pins of the senders whose route has nothing queued, so that they can be
+     * moved without reordering their messages. Must be called with m_b2bEndpointsLock held.
+     */
+    void EvictIdleSenders();
+
+    /**
+     * Get the remaining routes for a session in order of preference.
+     * Must be called with m_b2bEndpointsLock held.
+     *
+     * @param id        The session id.
+     * @param exclude   Route that has already been tried.
+     * @param routes    [OUT] The other routes for the session.
+     */
+    void GetFallbackRoutes(SessionId id, const RemoteEndpoint& exclude, std::vector<RemoteEndpoint>& routes) const;
+
     const qcc::String m_uniqueName;                             /**< The unique name for this endpoint */
     std::multimap<SessionId, RemoteEndpoint> m_b2bEndpoints;    /**< Set of b2bs that can route for this virtual ep */
+    std::vector<RemoteEndpoint> m_directB2bEndpoints;           /**< The session 0 b2bs that are directly connected to this virtual ep's router */
+    std::map<qcc::String, RemoteEndpoint> m_senderRoutes;       /**< The session 0 b2b that each sender is pinned to */
 
     mutable qcc::Mutex m_b2bEndpointsLock;      /**< Lock that protects m_b2bEndpoints */
     bool m_hasRefs;
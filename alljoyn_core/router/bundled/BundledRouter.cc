@@ -56,6 +56,9 @@
 #include "Transport.h"
 #include "TCPTransport.h"
 #include "UDPTransport.h"
+#if defined(QCC_OS_GROUP_POSIX)
+#include "DaemonTransport.h"
+#endif
 
 #define QCC_MODULE "ALLJOYN_ROUTER"
 
@@ -282,6 +285,13 @@ QStatus BundledRouter::Start(NullTransport* nullTransport)
         if (!transportsInitialized) {
             Add(new TransportFactory<TCPTransport>(TCPTransport::TransportName, false));
             Add(new TransportFactory<UDPTransport>(UDPTransport::TransportName, false));
+#if defined(QCC_OS_GROUP_POSIX)
+            /*
+             * Only instantiated if the config has a unix: listen spec, this lets
+             * local applications connect to the bundled router over a socket.
+             */
+            Add(new TransportFactory<DaemonTransport>(DaemonTransport::TransportName, false));
+#endif
             transportsInitialized = true;
         }
         QCC_DbgPrintf(("Starting bundled router bus attachment"));
@@ -807,6 +807,77 @@ QStatus IpNameServiceImpl::CloseInterface(TransportMask transportMask, const qcc
     return ER_OK;
 }
 
+void IpNameServiceImpl::CloseLiveInterface(LiveInterface& live)
+{
+    if (live.m_multicastMDNSsockFd != qcc::INVALID_SOCKET_FD || live.m_multicastsockFd != qcc::INVALID_SOCKET_FD) {
+
+        QCC_DbgPrintf(("IpNameServiceImpl::CloseLiveInterface(): close interface %s", live.m_interfaceName.c_str()));
+
+        //
+        // If the multicast bit is set, we have done an IGMP join.  In this
+        // case, we must arrange an IGMP drop via the appropriate socket option
+        // (via the qcc absraction layer). Android doesn't bother to compile its
+        // kernel with CONFIG_IP_MULTICAST set.  This doesn't mean that there is
+        // no multicast code in the Android kernel, it means there is no IGMP
+        // code in the kernel.  What this means to us is that even through we
+        // are doing an IP_DROP_MEMBERSHIP request, which is ultimately an IGMP
+        // operation, the request will filter through the IP code before being
+        // ignored and will do useful things in the kernel even though
+        // CONFIG_IP_MULTICAST was not set for the Android build -- i.e., we
+        // have to do it anyway.
+        //
+        if (live.m_flags & qcc::IfConfigEntry::MULTICAST ||
+            live.m_flags & qcc::IfConfigEntry::LOOPBACK) {
+            if (live.m_address.IsIPv4()) {
+                /*
+                 * NOTE:
+                 * In case socket address has changed, LeaveMulticastGroup() will fail internally
+                 * due to following unsuccessful ioctl call: ioctl(sockFd, SIOCGIFADDR, &ifr);
+                 */
+                if (live.m_multicastMDNSsockFd != qcc::INVALID_SOCKET_FD) {
+                    qcc::LeaveMulticastGroup(live.m_multicastMDNSsockFd, qcc::QCC_AF_INET, IPV4_MDNS_MULTICAST_GROUP,
+                                             live.m_interfaceName);
+                }
+                if (live.m_multicastsockFd != qcc::INVALID_SOCKET_FD) {
+                    qcc::LeaveMulticastGroup(live.m_multicastsockFd, qcc::QCC_AF_INET, IPV4_ALLJOYN_MULTICAST_GROUP,
+                                             live.m_interfaceName);
+                }
+            } else if (live.m_address.IsIPv6()) {
+                if (live.m_multicastMDNSsockFd != qcc::INVALID_SOCKET_FD) {
+                    qcc::LeaveMulticastGroup(live.m_multicastMDNSsockFd, qcc::QCC_AF_INET6, IPV6_MDNS_MULTICAST_GROUP,
+                                             live.m_interfaceName);
+                }
+                if (live.m_multicastsockFd != qcc::INVALID_SOCKET_FD) {
+                    qcc::LeaveMulticastGroup(live.m_multicastsockFd, qcc::QCC_AF_INET6, IPV6_ALLJOYN_MULTICAST_GROUP,
+                                             live.m_interfaceName);
+                }
+
+            }
+        }
+
+        //
+        // Always delete the event before closing the socket because the event
+        // is monitoring the socket state and therefore has a reference to the
+        // socket.  One the socket is closed the FD can be reused and our event
+        // can end up monitoring the wrong socket and interfere with the correct
+        // operation of other unrelated event/socket pairs.
+        //
+        if (live.m_multicastMDNSsockFd != qcc::INVALID_SOCKET_FD) {
+            delete live.m_multicastMDNSevent;
+            live.m_multicastMDNSevent = NULL;
+            qcc::Close(live.m_multicastMDNSsockFd);
+            live.m_multicastMDNSsockFd = qcc::INVALID_SOCKET_FD;
+        }
+
+        if (live.m_multicastsockFd != qcc::INVALID_SOCKET_FD) {
+            delete live.m_multicastevent;
+            live.m_multicastevent = NULL;
+            qcc::Close(live.m_multicastsockFd);
+            live.m_multicastsockFd = qcc::INVALID_SOCKET_FD;
+        }
+    }
+}
+
 void IpNameServiceImpl::ClearLiveInterfaces(void)
 {
     QCC_DbgPrintf(("IpNameServiceImpl::ClearLiveInterfaces()"));
@@ -818,73 +889,7 @@ void IpNameServiceImpl::ClearLiveInterfaces(void)
     m_mutex.Lock(MUTEX_CONTEXT);
 
     for (uint32_t i = 0; i < m_liveInterfaces.size(); ++i) {
-        if (m_liveInterfaces[i].m_multicastMDNSsockFd != qcc::INVALID_SOCKET_FD || m_liveInterfaces[i].m_multicastsockFd != qcc::INVALID_SOCKET_FD) {
-
-            QCC_DbgPrintf(("IpNameServiceImpl::ClearLiveInterfaces(): clear interface %d", i));
-
-            //
-            // If the multicast bit is set, we have done an IGMP join.  In this
-            // case, we must arrange an IGMP drop via the appropriate socket option
-            // (via the qcc absraction layer). Android doesn't bother to compile its
-            // kernel with CONFIG_IP_MULTICAST set.  This doesn't mean that there is
-            // no multicast code in the Android kernel, it means there is no IGMP
-            // code in the kernel.  What this means to us is that even through we
-            // are doing an IP_DROP_MEMBERSHIP request, which is ultimately an IGMP
-            // operation, the request will filter through the IP code before being
-            // ignored and will do useful things in the kernel even though
-            // CONFIG_IP_MULTICAST was not set for the Android build -- i.e., we
-            // have to do it anyway.
-            //
-            if (m_liveInterfaces[i].m_flags & qcc::IfConfigEntry::MULTICAST ||
-                m_liveInterfaces[i].m_flags & qcc::IfConfigEntry::LOOPBACK) {
-                if (m_liveInterfaces[i].m_address.IsIPv4()) {
-                    /*
-                     * NOTE:
-                     * In case socket address has changed, LeaveMulticastGroup() will fail internally
-                     * due to following unsuccessful ioctl call: ioctl(sockFd, SIOCGIFADDR, &ifr);
-                     */
-                    if (m_liveInterfaces[i].m_multicastMDNSsockFd != qcc::INVALID_SOCKET_FD) {
-                        qcc::LeaveMulticastGroup(m_liveInterfaces[i].m_multicastMDNSsockFd, qcc::QCC_AF_INET, IPV4_MDNS_MULTICAST_GROUP,
-                                                 m_liveInterfaces[i].m_interfaceName);
-                    }
-                    if (m_liveInterfaces[i].m_multicastsockFd != qcc::INVALID_SOCKET_FD) {
-                        qcc::LeaveMulticastGroup(m_liveInterfaces[i].m_multicastsockFd, qcc::QCC_AF_INET, IPV4_ALLJOYN_MULTICAST_GROUP,
-                                                 m_liveInterfaces[i].m_interfaceName);
-                    }
-                } else if (m_liveInterfaces[i].m_address.IsIPv6()) {
-                    if (m_liveInterfaces[i].m_multicastMDNSsockFd != qcc::INVALID_SOCKET_FD) {
-                        qcc::LeaveMulticastGroup(m_liveInterfaces[i].m_multicastMDNSsockFd, qcc::QCC_AF_INET6, IPV6_MDNS_MULTICAST_GROUP,
-                                                 m_liveInterfaces[i].m_interfaceName);
-                    }
-                    if (m_liveInterfaces[i].m_multicastsockFd != qcc::INVALID_SOCKET_FD) {
-                        qcc::LeaveMulticastGroup(m_liveInterfaces[i].m_multicastsockFd, qcc::QCC_AF_INET6, IPV6_ALLJOYN_MULTICAST_GROUP,
-                                                 m_liveInterfaces[i].m_interfaceName);
-                    }
-
-                }
-            }
-
-            //
-            // Always delete the event before closing the socket because the event
-            // is monitoring the socket state and therefore has a reference to the
-            // socket.  One the socket is closed the FD can be reused and our event
-            // can end up monitoring the wrong socket and interfere with the correct
-            // operation of other unrelated event/socket pairs.
-            //
-            if (m_liveInterfaces[i].m_multicastMDNSsockFd != qcc::INVALID_SOCKET_FD) {
-                delete m_liveInterfaces[i].m_multicastMDNSevent;
-                m_liveInterfaces[i].m_multicastMDNSevent = NULL;
-                qcc::Close(m_liveInterfaces[i].m_multicastMDNSsockFd);
-                m_liveInterfaces[i].m_multicastMDNSsockFd = qcc::INVALID_SOCKET_FD;
-            }
-
-            if (m_liveInterfaces[i].m_multicastsockFd != qcc::INVALID_SOCKET_FD) {
-                delete m_liveInterfaces[i].m_multicastevent;
-                m_liveInterfaces[i].m_multicastevent = NULL;
-                qcc::Close(m_liveInterfaces[i].m_multicastsockFd);
-                m_liveInterfaces[i].m_multicastsockFd = qcc::INVALID_SOCKET_FD;
-            }
-        }
+        CloseLiveInterface(m_liveInterfaces[i]);
     }
 
     QCC_DbgPrintf(("IpNameServiceImpl::ClearLiveInterfaces(): Clear interfaces"));
@@ -1161,7 +1166,14 @@ void IpNameServiceImpl::LazyUpdateInterfaces(const qcc::NetworkEventSet& network
     // take the conservative approach and tear down all of our sockets and
     // restart them every time through.
     //
-    ClearLiveInterfaces();
+    // Where the interfaces are tracked from netlink notifications we know
+    // exactly which interfaces went down, came up or had an address change
+    // since the last time through.  There we only tear down the sockets on
+    // those interfaces; a live interface on any other interface keeps its
+    // sockets (and its IGMP/MLD joins) if we still want to use it below.  On
+    // a host where containers come and go this keeps every other interface
+    // from seeing a drop and join each time a virtual interface changes.
+    //
 
 #if defined(QCC_OS_LINUX)
     std::vector<qcc::String> closedInterfaces;
@@ -1184,12 +1196,14 @@ void IpNameServiceImpl::LazyUpdateInterfaces(const qcc::NetworkEventSet& network
 
     if (m_enabled == false && processAnyTransport == false) {
         QCC_DbgPrintf(("IpNameServiceImpl::LazyUpdateInterfaces(): Communication with the outside world is forbidden"));
+        ClearLiveInterfaces();
         ClearUnicastSocketAndEvent();
         return;
     }
 
     if (m_isProcSuspending) {
         QCC_DbgPrintf(("IpNameServiceImpl::LazyUpdateInterfaces(): The process is suspending. Stop communicating with the outside world"));
+        ClearLiveInterfaces();
         ClearUnicastSocketAndEvent();
         return;
     }
@@ -1197,17 +1211,50 @@ void IpNameServiceImpl::LazyUpdateInterfaces(const qcc::NetworkEventSet& network
     // Call IfConfig to get the list of interfaces currently configured in the
     // system.  This also pulls out interface flags, addresses and MTU.  If we
     // can't get the system interfaces, we give up for now and hope the error
-    // is transient.
+    // is transient.  If the interface table is tracking the system, it already
+    // has the list and we don't have to ask again.
     //
-    QCC_DbgPrintf(("IpNameServiceImpl::LazyUpdateInterfaces(): IfConfig()"));
     std::vector<qcc::IfConfigEntry> entries;
-    QStatus status = qcc::IfConfig(entries);
+    QStatus status = ER_OK;
+#if defined(QCC_OS_LINUX) || defined(QCC_OS_ANDROID)
+    if (m_ifConfigTable.IsOpen()) {
+        QCC_DbgPrintf(("IpNameServiceImpl::LazyUpdateInterfaces(): GetEntries()"));
+        m_ifConfigTable.GetEntries(entries);
+    } else {
+        QCC_DbgPrintf(("IpNameServiceImpl::LazyUpdateInterfaces(): IfConfig()"));
+        status = qcc::IfConfig(entries);
+    }
+#else
+    QCC_DbgPrintf(("IpNameServiceImpl::LazyUpdateInterfaces(): IfConfig()"));
+    status = qcc::IfConfig(entries);
+#endif
     if (status != ER_OK) {
         QCC_LogError(status, ("IpNameServiceImpl::LazyUpdateInterfaces(): IfConfig() failed"));
+        ClearLiveInterfaces();
         ClearUnicastSocketAndEvent();
         return;
     }
 
+    //
+    // Set aside the live interfaces on interfaces that did not change so that
+    // their sockets can be reused, and tear down all of the others.
+    //
+    std::vector<LiveInterface> unchangedInterfaces;
+#if defined(QCC_OS_LINUX) || defined(QCC_OS_ANDROID)
+    if (m_ifConfigTable.IsOpen()) {
+        for (std::vector<LiveInterface>::iterator it = m_liveInterfaces.begin(); it != m_liveInterfaces.end();) {
+            if (m_changedInterfaces.find(it->m_index) == m_changedInterfaces.end()) {
+                unchangedInterfaces.push_back(*it);
+                it = m_liveInterfaces.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+    m_changedInterfaces.clear();
+#endif
+    ClearLiveInterfaces();
+
     // add the virtual network interfaces if any
     if (m_virtualInterfaces.size() > 0) {
         entries.insert(entries.end(), m_virtualInterfaces.begin(), m_virtualInterfaces.end());
@@ -1418,19 +1465,38 @@ void IpNameServiceImpl::LazyUpdateInterfaces(const qcc::NetworkEventSet& network
         qcc::SocketFd multicastMDNSsockFd = qcc::INVALID_SOCKET_FD;
         qcc::SocketFd multicastsockFd = qcc::INVALID_SOCKET_FD;
 
-        status = CreateMulticastSocket(entries[i], IPV4_MDNS_MULTICAST_GROUP, IPV6_MDNS_MULTICAST_GROUP, MULTICAST_MDNS_PORT,
-                                       m_broadcast, multicastMDNSsockFd);
-        if (status != ER_OK) {
-            QCC_DbgPrintf(("IpNameServiceImpl::LazyUpdateInterfaces(): Failed to create multicast socket for MDNS packets."));
-            continue;
+        std::vector<LiveInterface>::iterator unchanged = unchangedInterfaces.begin();
+        for (; unchanged != unchangedInterfaces.end(); ++unchanged) {
+            if (unchanged->m_interfaceName == entries[i].m_name && unchanged->m_address == qcc::IPAddress(entries[i].m_addr) &&
+                unchanged->m_index == entries[i].m_index && unchanged->m_flags == entries[i].m_flags &&
+                unchanged->m_prefixlen == entries[i].m_prefixlen && unchanged->m_mtu == entries[i].m_mtu) {
+                break;
+            }
         }
 
-        status = CreateMulticastSocket(entries[i], IPV4_ALLJOYN_MULTICAST_GROUP, IPV6_ALLJOYN_MULTICAST_GROUP, MULTICAST_PORT,
-                                       m_broadcast, multicastsockFd);
-        if (status != ER_OK) {
-            QCC_DbgPrintf(("IpNameServiceImpl::LazyUpdateInterfaces(): Failed to create multicast socket for NS packets."));
-            qcc::Close(multicastMDNSsockFd);
-            continue;
+        if (unchanged != unchangedInterfaces.end()) {
+            QCC_DbgPrintf(("IpNameServiceImpl::LazyUpdateInterfaces(): Keeping sockets of interface %s addr %s",
+                           entries[i].m_name.c_str(), entries[i].m_addr.c_str()));
+            multicastMDNSsockFd = unchanged->m_multicastMDNSsockFd;
+            multicastsockFd = unchanged->m_multicastsockFd;
+            delete unchanged->m_multicastMDNSevent;
+            delete unchanged->m_multicastevent;
+            unchangedInterfaces.erase(unchanged);
+        } else {
+            status = CreateMulticastSocket(entries[i], IPV4_MDNS_MULTICAST_GROUP, IPV6_MDNS_MULTICAST_GROUP, MULTICAST_MDNS_PORT,
+                                           m_broadcast, multicastMDNSsockFd);
+            if (status != ER_OK) {
+                QCC_DbgPrintf(("IpNameServiceImpl::LazyUpdateInterfaces(): Failed to create multicast socket for MDNS packets."));
+                continue;
+            }
+
+            status = CreateMulticastSocket(entries[i], IPV4_ALLJOYN_MULTICAST_GROUP, IPV6_ALLJOYN_MULTICAST_GROUP, MULTICAST_PORT,
+                                           m_broadcast, multicastsockFd);
+            if (status != ER_OK) {
+                QCC_DbgPrintf(("IpNameServiceImpl::LazyUpdateInterfaces(): Failed to create multicast socket for NS packets."));
+                qcc::Close(multicastMDNSsockFd);
+                continue;
+            }
         }
         //
         // Now take the interface "live."
@@ -1512,6 +1578,14 @@ void IpNameServiceImpl::LazyUpdateInterfaces(const qcc::NetworkEventSet& network
         //
         m_liveInterfaces.push_back(live);
     }
+
+    //
+    // Whatever was set aside and is no longer wanted goes away now.
+    //
+    for (std::vector<LiveInterface>::iterator it = unchangedInterfaces.begin(); it != unchangedInterfaces.end(); ++it) {
+        CloseLiveInterface(*it);
+    }
+
     if (!hasIPv4Interface) {
         if (m_unicastEvent) {
             delete m_unicastEvent;
@@ -5136,7 +5210,20 @@ void* IpNameServiceImpl::Run(void* arg)
 
     qcc::SocketFd networkEventFd = qcc::INVALID_SOCKET_FD;
 #ifndef QCC_OS_GROUP_WINDOWS
+#if defined(QCC_OS_LINUX) || defined(QCC_OS_ANDROID)
+    //
+    // The interface table keeps its netlink socket open for as long as we run
+    // and tells us exactly which interfaces changed when it becomes readable.
+    // If it can't be opened we fall back to IfConfig() on every lazy update.
+    //
+    m_mutex.Lock(MUTEX_CONTEXT);
+    if (m_ifConfigTable.Open() == ER_OK) {
+        networkEventFd = m_ifConfigTable.GetSocketFd();
+    }
+    m_mutex.Unlock(MUTEX_CONTEXT);
+#else
     networkEventFd = qcc::NetworkEventSocket();
+#endif
     qcc::Event* networkEvent = new Event(networkEventFd, qcc::Event::IO_READ);
 #else
     qcc::Event* networkEvent = new Event(true);
@@ -5350,7 +5437,24 @@ void* IpNameServiceImpl::Run(void* arg)
                 m_wakeEvent.ResetEvent();
             } else if (*i == networkEvent) {
                 QCC_DbgPrintf(("IpNameServiceImpl::Run(): Network event fired"));
-#ifndef QCC_OS_GROUP_WINDOWS
+#if defined(QCC_OS_LINUX) || defined(QCC_OS_ANDROID)
+                std::vector<qcc::IfConfigEntry> added, removed;
+                m_ifConfigTable.Update(networkEvents, added, removed);
+                for (std::vector<qcc::IfConfigEntry>::const_iterator it = added.begin(); it != added.end(); ++it) {
+                    m_changedInterfaces.insert(it->m_index);
+                }
+                for (std::vector<qcc::IfConfigEntry>::const_iterator it = removed.begin(); it != removed.end(); ++it) {
+                    m_changedInterfaces.insert(it->m_index);
+                }
+                if (!removed.empty()) {
+                    m_forceLazyUpdate = true;
+                    m_interfaceDownDetected = true;
+                }
+                if (!added.empty()) {
+                    m_forceLazyUpdate = true;
+                    m_refreshAdvertisements = true;
+                }
+#elif !defined(QCC_OS_GROUP_WINDOWS)
                 NetworkEventType eventType = qcc::NetworkEventReceive(networkEventFd, networkEvents);
                 if (eventType == QCC_RTM_DELADDR) {
                     m_forceLazyUpdate = true;
@@ -5497,9 +5601,15 @@ void* IpNameServiceImpl::Run(void* arg)
     ClearLiveInterfaces();
 
     delete networkEvent;
+#if defined(QCC_OS_LINUX) || defined(QCC_OS_ANDROID)
+    m_mutex.Lock(MUTEX_CONTEXT);
+    m_ifConfigTable.Close();
+    m_mutex.Unlock(MUTEX_CONTEXT);
+#else
     if (networkEventFd != qcc::INVALID_SOCKET_FD) {
         qcc::Close(networkEventFd);
     }
+#endif
 
     delete [] buffer;
     return 0;
@@ -1066,6 +1066,23 @@ class IpNameServiceImpl : public qcc::Thread {
      */
     std::vector<LiveInterface> m_liveInterfaces;
 
+#if defined(QCC_OS_LINUX) || defined(QCC_OS_ANDROID)
+    /**
+     * @internal
+     * @brief The interfaces on the host, kept up to date from netlink
+     * notifications so that a network event does not need a full IfConfig().
+     */
+    qcc::IfConfigTable m_ifConfigTable;
+
+    /**
+     * @internal
+     * @brief Indices of the interfaces that gained or lost an entry since the
+     * last lazy update.  Live interfaces on any other interface keep their
+     * sockets across the update.
+     */
+    std::set<uint32_t> m_changedInterfaces;
+#endif
+
     /**
      * @internal
      * @brief Mutex object used to protect various lists that may be accessed
@@ -1493,6 +1510,13 @@ class IpNameServiceImpl : public qcc::Thread {
      */
     void ClearLiveInterfaces(void);
 
+    /**
+     * @internal
+     * @brief Leave the multicast groups of a live interface and close its
+     * sockets.
+     */
+    void CloseLiveInterface(LiveInterface& live);
+
     /**
      * @internal
      * @brief Make sure that we have socket open to talk and listen to as many
@@ -133,12 +133,12 @@ StringID _PolicyDB::UpdateDictionary(const String& key)
         id = NIL_MATCH;
     } else {
         lock.WRLock();
-        StringIDMap::const_iterator it = dictionary.find(key);
+        StringIDMap::const_iterator it = dictionary.find(StringMapKey::Borrow(key));
 
         if (it == dictionary.end()) {
             /* New string found; assign it an ID. */
             id = dictionary.size();
-            pair<std::string, StringID> p(key, id);
+            pair<StringMapKey, StringID> p(key, id);
             dictionary.insert(p);
         } else {
             /* The string already has an ID. */
@@ -156,7 +156,7 @@ StringID _PolicyDB::LookupStringID(const char* key) const
 
     if (key && (key[0] != '\0')) {
         lock.RDLock();
-        StringIDMap::const_iterator it = dictionary.find(key);
+        StringIDMap::const_iterator it = dictionary.find(StringMapKey::Borrow(key));
 
         if (it != dictionary.end()) {
             id = it->second;
@@ -172,22 +172,18 @@ const _PolicyDB::IDSet _PolicyDB::LookupStringIDPrefix(const char* idStr, char s
     QCC_ASSERT(idStr);
     QCC_ASSERT(sep != '\0');
     IDSet ret;
-    char* prefix = strdup(idStr); // duplicate idStr since we are modifying it
 
     /*
-     * If prefix is NULL, then the program is out of memory.  While it may be
-     * considered reasonable to rework the design of this function to return
-     * an error, in this case an out-of-memory condition, we do not for the
-     * following reasons.  One, it should never happen in real-life, and two,
-     * it is more likely just a small symptom of a much bigger problem that
-     * will quickly manifest itself in other ways.  To keep this function
-     * simple and its usage simple, an empty IDSet will be returned in such an
-     * unlikely condition.
+     * Each prefix is looked up in place by borrowing the leading characters
+     * of idStr rather than copying and truncating the string.
      */
-    if (prefix) {
-        while (*prefix) {
-            StringID id = LookupStringID(prefix);
-            if ((id != ID_NOT_FOUND) && (id != WILDCARD)) {
+    size_t len = strlen(idStr);
+    lock.RDLock();
+    while (len > 0) {
+        StringIDMap::const_iterator it = dictionary.find(StringMapKey::Borrow(idStr, len));
+        if (it != dictionary.end()) {
+            StringID id = it->second;
+            if (id != WILDCARD) {
                 /*
                  * We only add ID's that are found in the string ID table.  By
                  * not keeping prefixes that are known to not be specifed by
@@ -197,16 +193,13 @@ const _PolicyDB::IDSet _PolicyDB::LookupStringIDPrefix(const char* idStr, char s
                  */
                 ret->insert(id);
             }
-            char* p = strrchr(prefix, sep);
-            if (p) {
-                *p = '\0';      // Shorten the string to the next separator.
-            } else {
-                *prefix = '\0'; // All done.
-            }
         }
-
-        free(prefix);
+        /* Shorten the string to the next separator. */
+        do {
+            --len;
+        } while ((len > 0) && (idStr[len] != sep));
     }
+    lock.Unlock();
 
     return ret;
 }
@@ -218,7 +211,7 @@ const _PolicyDB::IDSet _PolicyDB::LookupBusNameID(const char* busName) const
 
     if (busName && (busName[0] != '\0')) {
         lock.RDLock();
-        BusNameIDMap::const_iterator it = busNameIDMap.find(busName);
+        BusNameIDMap::const_iterator it = busNameIDMap.find(StringMapKey::Borrow(busName));
         if (it != busNameIDMap.end()) {
             /*
              * We need to make a local copy of the set of aliases for the
@@ -473,14 +466,14 @@ void _PolicyDB::AddAlias(const String& alias, const String& name)
      * Since the write lock trumps read locks, we'll just lookup the string ID
      * directly.
      */
-    StringIDMap::const_iterator sit = dictionary.find(alias);
+    StringIDMap::const_iterator sit = dictionary.find(StringMapKey::Borrow(alias));
 
     if (sit != dictionary.end()) {
         nameID = sit->second;
     }
 
     IDSet bnids;
-    BusNameIDMap::iterator it = busNameIDMap.find(name);
+    BusNameIDMap::iterator it = busNameIDMap.find(StringMapKey::Borrow(name));
     if (it != busNameIDMap.end()) {
         bnids = it->second;
     }
@@ -488,7 +481,7 @@ void _PolicyDB::AddAlias(const String& alias, const String& name)
         QCC_DbgPrintf(("Add %s{%d} to table for %s", alias.c_str(), nameID, name.c_str()));
         bnids->insert(nameID);
     }
-    pair<std::string, IDSet> p(alias, bnids);
+    pair<StringMapKey, IDSet> p(alias, bnids);
     busNameIDMap.insert(p);
 }
 
@@ -550,11 +543,11 @@ void _PolicyDB::Finalize(Bus* bus)
 #ifndef NDEBUG
     QCC_DbgPrintf(("Dictionary:"));
     for (StringIDMap::const_iterator it = dictionary.begin(); it != dictionary.end(); ++it) {
-        QCC_DbgPrintf(("    \"%s\" = %u", it->first.c_str(), it->second));
+        QCC_DbgPrintf(("    \"%s\" = %u", it->first.ToString().c_str(), it->second));
     }
     QCC_DbgPrintf(("Name Table:"));
-    for (unordered_map<std::string, IDSet>::const_iterator it = busNameIDMap.begin(); it != busNameIDMap.end(); ++it) {
-        QCC_DbgPrintf(("    \"%s\" = {%s}", it->first.c_str(), IDSet2String(it->second).c_str()));
+    for (BusNameIDMap::const_iterator it = busNameIDMap.begin(); it != busNameIDMap.end(); ++it) {
+        QCC_DbgPrintf(("    \"%s\" = {%s}", it->first.ToString().c_str(), IDSet2String(it->second).c_str()));
     }
 #endif
 #if defined(QCC_OS_GROUP_WINDOWS)
@@ -614,7 +607,7 @@ void _PolicyDB::NameOwnerChanged(const String& alias,
     lock.WRLock();
 
     if (oldOwner) {
-        BusNameIDMap::iterator it = busNameIDMap.find(alias);
+        BusNameIDMap::iterator it = busNameIDMap.find(StringMapKey::Borrow(alias));
         if (it != busNameIDMap.end()) {
             QCC_DbgPrintf(("Remove %s{%d} from table for %s", alias.c_str(), aliasID, oldOwner->c_str()));
             it->second->erase(aliasID);
@@ -626,7 +619,7 @@ void _PolicyDB::NameOwnerChanged(const String& alias,
 
     if (newOwner) {
         IDSet bnids;
-        BusNameIDMap::iterator it = busNameIDMap.find(*newOwner);
+        BusNameIDMap::iterator it = busNameIDMap.find(StringMapKey::Borrow(*newOwner));
         if (it != busNameIDMap.end()) {
             QCC_ASSERT(alias != *newOwner);
             bnids = it->second;
@@ -635,7 +628,7 @@ void _PolicyDB::NameOwnerChanged(const String& alias,
             QCC_DbgPrintf(("Add %s{%d} to table for %s", alias.c_str(), aliasID, newOwner->c_str()));
             bnids->insert(aliasID);
         }
-        pair<std::string, IDSet> p(alias, bnids);
+        pair<StringMapKey, IDSet> p(alias, bnids);
         busNameIDMap.insert(p);
     }
 
@@ -39,6 +39,7 @@
 #include <qcc/ManagedObj.h>
 #include <qcc/RWLock.h>
 #include <qcc/String.h>
+#include <qcc/StringMapKey.h>
 #include <qcc/STLContainer.h>
 
 #include <alljoyn/Message.h>
@@ -400,10 +401,10 @@ class _PolicyDB {
     };
 
     /** typedef for mapping a string to a numerical value for normalization */
-    typedef std::unordered_map<std::string, StringID> StringIDMap;
+    typedef std::unordered_map<qcc::StringMapKey, StringID, qcc::StringMapKey::Hash> StringIDMap;
 
     /** typedef for mapping a string to a numerical value for normalization */
-    typedef std::unordered_map<std::string, IDSet> BusNameIDMap;
+    typedef std::unordered_map<qcc::StringMapKey, IDSet, qcc::StringMapKey::Hash> BusNameIDMap;
 
     /**
      * Adds rules to specific rule sets.  Called by public AddRule to add
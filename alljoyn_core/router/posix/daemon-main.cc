@@ -52,6 +52,7 @@
 #include <qcc/StringUtil.h>
 #include <qcc/Environ.h>
 #include <qcc/FileStream.h>
+#include <qcc/LockProfiler.h>
 #include <qcc/Log.h>
 #include <qcc/Logger.h>
 #include <qcc/Util.h>
@@ -108,6 +109,9 @@ using namespace std;
 
 static volatile sig_atomic_t reload;
 static volatile sig_atomic_t quit;
+#ifdef QCC_LOCK_PROFILER
+static volatile sig_atomic_t dumpLockProfile;
+#endif
 
 /*
  * Simple config to provide some non-default limits for the daemon tcp/udp transport.
@@ -193,8 +197,30 @@ void SignalHandler(int sig) {
     case SIGTERM:
         quit = 1;
         break;
+
+#ifdef QCC_LOCK_PROFILER
+    case SIGUSR2:
+        dumpLockProfile = 1;
+        break;
+#endif
+    }
+}
+
+#ifdef QCC_LOCK_PROFILER
+static void LogLockProfile()
+{
+    qcc::String profile = LockProfiler::Dump(32);
+    size_t pos = 0;
+    while (pos < profile.size()) {
+        size_t eol = profile.find_first_of('\n', pos);
+        if (eol == qcc::String::npos) {
+            eol = profile.size();
+        }
+        Log(LOG_INFO, "%s\n", profile.substr(pos, eol - pos).c_str());
+        pos = eol + 1;
     }
 }
+#endif
 
 class OptParse {
   public:
@@ -567,6 +593,9 @@ int daemon(OptParse& opts) {
     sigaction(SIGHUP, &act, &oldact);
     sigaction(SIGINT, &act, &oldact);
     sigaction(SIGTERM, &act, &oldact);
+#ifdef QCC_LOCK_PROFILER
+    sigaction(SIGUSR2, &act, &oldact);
+#endif
 
     /*
      * Extract the listen specs
@@ -674,11 +703,21 @@ int daemon(OptParse& opts) {
     sigdelset(&waitmask, SIGHUP);
     sigdelset(&waitmask, SIGINT);
     sigdelset(&waitmask, SIGTERM);
+#ifdef QCC_LOCK_PROFILER
+    sigdelset(&waitmask, SIGUSR2);
+#endif
 
     quit = 0;
     while (!quit) {
         reload = 0;
         sigsuspend(&waitmask);
+#ifdef QCC_LOCK_PROFILER
+        /* kill -USR2 logs the busiest lock sites, see ER_LOCK_PROFILE to enable recording */
+        if (dumpLockProfile) {
+            dumpLockProfile = 0;
+            LogLockProfile();
+        }
+#endif
         if (reload && !opts.GetInternalConfig()) {
             if (!config->LoadConfig(&ajBus)) {
                 Log(LOG_ERR, "Failed to load the configuration - problem with %s.\n", opts.GetConfigFile().c_str());
@@ -30,6 +30,7 @@
 #include <alljoyn/AboutData.h>
 #include <alljoyn/version.h>
 
+#include <qcc/atomic.h>
 #include <qcc/XmlElement.h>
 #include <qcc/String.h>
 #include <qcc/StringUtil.h>
@@ -44,6 +45,16 @@ using ajn::AboutKeys;
 
 namespace ajn {
 
+/* Source of AboutData versions, shared by all instances */
+static volatile int32_t aboutDataVersionCounter = 0;
+
+void AboutData::Internal::Changed()
+{
+    do {
+        version = static_cast<uint32_t>(qcc::IncrementAndFetch(&aboutDataVersionCounter));
+    } while (version == 0);
+}
+
 AboutData::AboutData() {
     InitializeFieldDetails();
 
@@ -149,6 +160,7 @@ QStatus AboutData::CreateFromXml(const qcc::String& aboutDataXml)
     }
     const qcc::XmlElement* root = pc.GetRoot();
     QStatus returnStatus = ER_OK;
+    aboutDataInternal->Changed();
     /*
      * This will iterate through the list of known fields in the about data.  If
      * the field is not localized set that field. We grab the non-localized values
@@ -298,6 +310,7 @@ QStatus AboutData::CreatefromMsgArg(const MsgArg& arg, const char* language)
     if (status != ER_OK) {
         return status;
     }
+    aboutDataInternal->Changed();
     if (language == NULL) {
         MsgArg* argDefaultLang;
         status = arg.GetElement("{sv}", DEFAULT_LANGUAGE, &argDefaultLang);
@@ -403,6 +416,7 @@ QStatus AboutData::SetAppId(const char* appId) {
                 return status;
             }
             aboutDataInternal->propertyStore[APP_ID].Stabilize();
+            aboutDataInternal->Changed();
         } else if (strSize / 2 == 18) {
             // since the sting is 36 characters long we assume its a UUID as per
             // section 3 of RFC 4122  (i.e. 4a354637-5649-4518-8a48-323c158bc02d)
@@ -592,6 +606,7 @@ QStatus AboutData::SetSupportedLanguage(const char* language)
     //     tags conform to this RFC
     bool added;
     QStatus status = aboutDataInternal->translator->AddTargetLanguage(language, &added);
+    aboutDataInternal->Changed();
 
     if (status == ER_OK) {
         size_t supportedLangsNum = aboutDataInternal->translator->NumTargetLanguages();
@@ -790,6 +805,7 @@ QStatus AboutData::GetSupportUrl(char** supportUrl)
 
 QStatus AboutData::SetField(const char* name, ajn::MsgArg value, const char* language) {
     QStatus status = ER_OK;
+    aboutDataInternal->Changed();
     // The user is adding an OEM-specific field.
     // At this time OEM-specific fields are added as
     //    not required
@@ -953,6 +969,19 @@ QStatus AboutData::GetAboutData(MsgArg* msgArg, const char* language)
     return status;
 }
 
+void AboutData::SetCacheable(bool cacheable)
+{
+    aboutDataInternal->cacheable = cacheable;
+}
+
+uint32_t AboutData::GetAboutDataVersion()
+{
+    if (!aboutDataInternal->cacheable || (aboutDataInternal->translator != &aboutDataInternal->defaultTranslator)) {
+        return 0;
+    }
+    return aboutDataInternal->version;
+}
+
 QStatus AboutData::GetAnnouncedAboutData(MsgArg* msgArg)
 {
     QStatus status;
@@ -1061,6 +1090,7 @@ QStatus AboutData::SetNewFieldDetails(const char* fieldName, AboutFieldMask fiel
 {
     if (aboutDataInternal->aboutFields.find(fieldName) == aboutDataInternal->aboutFields.end()) {
         aboutDataInternal->aboutFields[fieldName] = FieldDetails(fieldMask, signature);
+        aboutDataInternal->Changed();
     } else {
         return ER_ABOUT_FIELD_ALREADY_SPECIFIED;
     }
@@ -1070,6 +1100,7 @@ QStatus AboutData::SetNewFieldDetails(const char* fieldName, AboutFieldMask fiel
 void AboutData::SetTranslator(Translator* translator)
 {
     aboutDataInternal->translator = translator;
+    aboutDataInternal->Changed();
 }
 
 Translator* AboutData::GetTranslator() const
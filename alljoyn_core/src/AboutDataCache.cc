@@ -0,0 +1,121 @@
+/**
+ * @file
+ * Cache of the About dictionaries built by an AboutDataListener.
+ */
+
+/******************************************************************************
+ *    Copyright (c) Open Connectivity Foundation (OCF), AllJoyn Open Source
+ *    Project (AJOSP) Contributors and others.
+ *
+ *    SPDX-License-Identifier: Apache-2.0
+ *
+ *    All rights reserved. This program and the accompanying materials are
+ *    made available under the terms of the Apache License, Version 2.0
+ *    which accompanies this distribution, and is available at
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Copyright (c) Open Connectivity Foundation and Contributors to AllSeen
+ *    Alliance. All rights reserved.
+ *
+ *    Permission to use, copy, modify, and/or distribute this software for
+ *    any purpose with or without fee is hereby granted, provided that the
+ *    above copyright notice and this permission notice appear in all
+ *    copies.
+ *
+ *    THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+ *    WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+ *    WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ *    AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ *    DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ *    PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+ *    TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ *    PERFORMANCE OF THIS SOFTWARE.
+ ******************************************************************************/
+
+#include <qcc/platform.h>
+#include <qcc/Debug.h>
+#include <qcc/LockLevel.h>
+
+#include <alljoyn/AboutData.h>
+
+#include "AboutDataCache.h"
+
+#define QCC_MODULE "ALLJOYN_ABOUT"
+
+using namespace std;
+using namespace qcc;
+
+namespace ajn {
+
+AboutDataCache::AboutDataCache() :
+    lock(LOCK_LEVEL_ABOUTDATACACHE_LOCK)
+{
+}
+
+void AboutDataCache::Reset(const AboutDataListener* listener, AboutData* aboutData)
+{
+    lock.Lock(MUTEX_CONTEXT);
+    Entry& entry = entries[listener];
+    entry.source = aboutData;
+    entry.version = 0;
+    entry.aboutData.clear();
+    lock.Unlock(MUTEX_CONTEXT);
+}
+
+void AboutDataCache::Remove(const AboutDataListener* listener)
+{
+    lock.Lock(MUTEX_CONTEXT);
+    entries.erase(listener);
+    lock.Unlock(MUTEX_CONTEXT);
+}
+
+uint32_t AboutDataCache::GetVersion(const AboutDataListener* listener)
+{
+    uint32_t version = 0;
+    lock.Lock(MUTEX_CONTEXT);
+    map<const AboutDataListener*, Entry>::const_iterator it = entries.find(listener);
+    if ((it != entries.end()) && it->second.source) {
+        version = it->second.source->GetAboutDataVersion();
+    }
+    lock.Unlock(MUTEX_CONTEXT);
+    return version;
+}
+
+shared_ptr<const MsgArg> AboutDataCache::GetAboutData(const AboutDataListener* listener, uint32_t version, const qcc::String& language)
+{
+    shared_ptr<const MsgArg> arg;
+    if (version == 0) {
+        return arg;
+    }
+    lock.Lock(MUTEX_CONTEXT);
+    map<const AboutDataListener*, Entry>::const_iterator it = entries.find(listener);
+    if ((it != entries.end()) && (it->second.version == version)) {
+        map<qcc::String, shared_ptr<const MsgArg> >::const_iterator ait = it->second.aboutData.find(language);
+        if (ait != it->second.aboutData.end()) {
+            arg = ait->second;
+        }
+    }
+    lock.Unlock(MUTEX_CONTEXT);
+    return arg;
+}
+
+void AboutDataCache::AddAboutData(const AboutDataListener* listener, uint32_t version, const qcc::String& language, shared_ptr<const MsgArg> aboutData)
+{
+    if (version == 0) {
+        return;
+    }
+    lock.Lock(MUTEX_CONTEXT);
+    map<const AboutDataListener*, Entry>::iterator it = entries.find(listener);
+    if ((it != entries.end()) && it->second.source) {
+        Entry& entry = it->second;
+        if ((entry.version != version) || (entry.aboutData.size() >= MAX_LANGUAGES)) {
+            QCC_DbgPrintf(("AboutDataCache dropping %u languages", (unsigned int) entry.aboutData.size()));
+            entry.aboutData.clear();
+            entry.version = version;
+        }
+        entry.aboutData[language] = aboutData;
+    }
+    lock.Unlock(MUTEX_CONTEXT);
+}
+
+}
@@ -0,0 +1,163 @@
+/**
+ * @file
+ * Cache of the About dictionaries built by an AboutDataListener.
+ */
+
+/******************************************************************************
+ *    Copyright (c) Open Connectivity Foundation (OCF), AllJoyn Open Source
+ *    Project (AJOSP) Contributors and others.
+ *
+ *    SPDX-License-Identifier: Apache-2.0
+ *
+ *    All rights reserved. This program and the accompanying materials are
+ *    made available under the terms of the Apache License, Version 2.0
+ *    which accompanies this distribution, and is available at
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Copyright (c) Open Connectivity Foundation and Contributors to AllSeen
+ *    Alliance. All rights reserved.
+ *
+ *    Permission to use, copy, modify, and/or distribute this software for
+ *    any purpose with or without fee is hereby granted, provided that the
+ *    above copyright notice and this permission notice appear in all
+ *    copies.
+ *
+ *    THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+ *    WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+ *    WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ *    AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ *    DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ *    PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+ *    TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ *    PERFORMANCE OF THIS SOFTWARE.
+ ******************************************************************************/
+
+#ifndef _ALLJOYN_ABOUTDATACACHE_H
+#define _ALLJOYN_ABOUTDATACACHE_H
+
+#ifndef __cplusplus
+#error Only include AboutDataCache.h in C++ code.
+#endif
+
+#include <qcc/platform.h>
+
+#include <map>
+#include <memory>
+
+#include <qcc/Mutex.h>
+#include <qcc/String.h>
+
+#include <alljoyn/AboutDataListener.h>
+#include <alljoyn/MsgArg.h>
+
+namespace ajn {
+
+class AboutData;
+
+/**
+ * Keeps the dictionaries an AboutDataListener returned for GetAboutData so AboutObj
+ * can answer org.alljoyn.About.GetAboutData calls without asking the listener to
+ * rebuild them. There is one cache per BusAttachment, with entries per listener.
+ *
+ * Only AboutData instances that opted in with AboutData::SetCacheable are
+ * cached, other listeners may return different values on every call. Their
+ * entries are stamped with the version the AboutData reported (see
+ * AboutData::GetAboutDataVersion) and are dropped as soon as it changes.
+ * Changes made through the MsgArg returned by AboutData::GetField are not
+ * versioned, so AboutObj resets the entries of a listener every time it is
+ * announced.
+ *
+ * The cached MsgArgs are stable and never modified once added, so they can be
+ * marshalled by several threads at once.
+ */
+class AboutDataCache {
+  public:
+
+    /**
+     * Maximum number of languages kept per listener. Requested language tags
+     * come from remote peers, so the entries are emptied when they fill up rather
+     * than growing without bound.
+     */
+    static const size_t MAX_LANGUAGES = 16;
+
+    /**
+     * Constructor
+     */
+    AboutDataCache();
+
+    /**
+     * Drop the dictionaries of a listener and start over.
+     *
+     * @param listener   The listener that provides the about data.
+     * @param aboutData  The listener itself if it is an AboutData, NULL for any
+     *                   other listener, whose dictionaries are never cached.
+     */
+    void Reset(const AboutDataListener* listener, AboutData* aboutData);
+
+    /**
+     * Forget a listener, for instance because its AboutObj is going away.
+     *
+     * @param listener  The listener that provided the about data.
+     */
+    void Remove(const AboutDataListener* listener);
+
+    /**
+     * Get the current version of the about data of a listener.
+     *
+     * @param listener  The listener that provides the about data.
+     *
+     * @return The version or 0 if the dictionaries of the listener must not be cached.
+     */
+    uint32_t GetVersion(const AboutDataListener* listener);
+
+    /**
+     * Get the about data dictionary for a language.
+     *
+     * @param listener  The listener that provides the about data.
+     * @param version   The version returned by GetVersion before the listener was asked for the data.
+     * @param language  The requested language tag.
+     *
+     * @return The cached dictionary or an empty pointer if there is none.
+     */
+    std::shared_ptr<const MsgArg> GetAboutData(const AboutDataListener* listener, uint32_t version, const qcc::String& language);
+
+    /**
+     * Add the about data dictionary for a language.
+     *
+     * @param listener   The listener that provided the about data.
+     * @param version    The version returned by GetVersion before the listener was asked for the data.
+     * @param language   The requested language tag.
+     * @param aboutData  The stabilized dictionary.
+     */
+    void AddAboutData(const AboutDataListener* listener, uint32_t version, const qcc::String& language, std::shared_ptr<const MsgArg> aboutData);
+
+  private:
+
+    /**
+     * Assignment not allowed
+     */
+    AboutDataCache& operator=(const AboutDataCache& other);
+
+    /**
+     * Copy constructor not allowed
+     */
+    AboutDataCache(const AboutDataCache& other);
+
+    /**
+     * Dictionaries built by one listener
+     */
+    struct Entry {
+        AboutData* source;                                               /**< The listener as an AboutData, reports the version */
+        uint32_t version;                                                /**< Version of the dictionaries */
+        std::map<qcc::String, std::shared_ptr<const MsgArg> > aboutData; /**< GetAboutData dictionaries by language */
+
+        Entry() : source(NULL), version(0) { }
+    };
+
+    std::map<const AboutDataListener*, Entry> entries;  /**< Entries by listener */
+    qcc::Mutex lock;                                     /**< Protects the cache */
+};
+
+}
+
+#endif
@@ -121,15 +121,27 @@ class MsgArgTableTranslator : public LookupTableTranslator {
 class AboutData::Internal {
     friend class AboutData;
   public:
+    Internal() : translator(NULL), version(0), cacheable(false) {
+        Changed();
+    }
+
     AboutData::Internal& operator=(const AboutData::Internal& other) {
         aboutFields = other.aboutFields;
         propertyStore = other.propertyStore;
         defaultTranslator = other.defaultTranslator;
         translator = other.translator;
         keyLanguage = other.keyLanguage;
+        Changed();
         return *this;
     }
 
+    /**
+     * Give the about data a new version. Versions are unique across all
+     * AboutData instances so a new instance never repeats the version of
+     * one it replaced.
+     */
+    void Changed();
+
   private:
     /**
      * A std::map that maps the field name to its FieldDetails.
@@ -170,6 +182,16 @@ class AboutData::Internal {
      */
     qcc::String keyLanguage;
 
+    /**
+     * Version of the about data, see AboutData::GetAboutDataVersion.
+     */
+    uint32_t version;
+
+    /**
+     * True if AboutObj may cache the dictionaries built from this AboutData
+     */
+    bool cacheable;
+
     /**
      * mutex lock to protect the property store.
      */
@@ -31,6 +31,9 @@
  *    PERFORMANCE OF THIS SOFTWARE.
  ******************************************************************************/
 
+#include <memory>
+
+#include <alljoyn/AboutData.h>
 #include <alljoyn/AboutObj.h>
 #include <alljoyn/AllJoynStd.h>
 #include <alljoyn/MsgArg.h>
@@ -75,9 +78,22 @@ AboutObj::~AboutObj()
 {
     Unannounce();
     m_busAttachment->UnregisterBusObject(*this);
+    if (m_aboutDataListener) {
+        m_busAttachment->GetInternal().GetAboutDataCache().Remove(m_aboutDataListener);
+    }
 }
 
 QStatus AboutObj::Announce(SessionPort sessionPort, ajn::AboutDataListener& aboutData)
+{
+    return AnnounceAboutData(sessionPort, aboutData, NULL);
+}
+
+QStatus AboutObj::Announce(SessionPort sessionPort, ajn::AboutData& aboutData)
+{
+    return AnnounceAboutData(sessionPort, aboutData, &aboutData);
+}
+
+QStatus AboutObj::AnnounceAboutData(SessionPort sessionPort, ajn::AboutDataListener& aboutData, ajn::AboutData* versioned)
 {
     QCC_DbgTrace(("AboutService::%s", __FUNCTION__));
 
@@ -86,10 +102,19 @@ QStatus AboutObj::Announce(SessionPort sessionPort, ajn::AboutDataListener& abou
         return ER_ABOUT_SESSIONPORT_NOT_BOUND;
     }
 
+    AboutDataCache& cache = m_busAttachment->GetInternal().GetAboutDataCache();
+    if (m_aboutDataListener && (m_aboutDataListener != &aboutData)) {
+        cache.Remove(m_aboutDataListener);
+    }
     m_aboutDataListener = &aboutData;
 
-    MsgArg aboutDataArg;
-    status = m_aboutDataListener->GetAboutData(&aboutDataArg, "");
+    // Every announcement fetches the about data again, fields changed through
+    // AboutData::GetField do not change the version of the about data.
+    cache.Reset(m_aboutDataListener, versioned);
+    uint32_t version = cache.GetVersion(m_aboutDataListener);
+
+    std::shared_ptr<MsgArg> aboutDataArg = std::make_shared<MsgArg>();
+    status = m_aboutDataListener->GetAboutData(aboutDataArg.get(), "");
     if (ER_OK != status) {
         return status;
     }
@@ -100,7 +125,7 @@ QStatus AboutObj::Announce(SessionPort sessionPort, ajn::AboutDataListener& abou
         return status;
     }
 
-    if (!HasAllRequiredFields(aboutDataArg)) {
+    if (!HasAllRequiredFields(*aboutDataArg)) {
         return ER_ABOUT_ABOUTDATA_MISSING_REQUIRED_FIELD;
     }
 
@@ -108,7 +133,7 @@ QStatus AboutObj::Announce(SessionPort sessionPort, ajn::AboutDataListener& abou
         return ER_ABOUT_ABOUTDATA_MISSING_REQUIRED_FIELD;
     }
 
-    if (!AnnouncedDataAgreesWithAboutData(aboutDataArg, announcedDataArg)) {
+    if (!AnnouncedDataAgreesWithAboutData(*aboutDataArg, announcedDataArg)) {
         return ER_ABOUT_INVALID_ABOUTDATA_LISTENER;
     }
 
@@ -116,10 +141,12 @@ QStatus AboutObj::Announce(SessionPort sessionPort, ajn::AboutDataListener& abou
     // We want to return an error if the AppId is is not 128-bits since the
     // announced signal will not pass compliance and certification but we still
     // send out the signal.
-    QStatus validate_status = ValidateAboutDataFields(aboutDataArg);
+    QStatus validate_status = ValidateAboutDataFields(*aboutDataArg);
     if (ER_OK != validate_status && ER_ABOUT_INVALID_ABOUTDATA_FIELD_APPID_SIZE != validate_status) {
         return validate_status;
     }
+    aboutDataArg->Stabilize();
+    cache.AddAboutData(m_aboutDataListener, version, "", aboutDataArg);
     m_busAttachment->GetInternal().GetAnnouncedObjectDescription(m_objectDescription);
 
     const InterfaceDescription* aboutIntf = m_busAttachment->GetInterface(org::alljoyn::About::InterfaceName);
@@ -180,22 +207,30 @@ void AboutObj::GetAboutData(const ajn::InterfaceDescription::Member* member, ajn
     size_t numArgs = 0;
     msg->GetArgs(numArgs, args);
     if (numArgs == 1) {
-        ajn::MsgArg retargs[1];
-        //status = m_PropertyStore->ReadAll(args[0].v_string.str, PropertyStore::READ, retargs[0]);
         QCC_DbgPrintf(("GetAboutData for GetMsgArg for lang=%s", args[0].v_string.str));
-        status = m_aboutDataListener->GetAboutData(retargs, args[0].v_string.str);
-        //QCC_DbgPrintf(("m_pPropertyStore->ReadAll(%s,PropertyStore::READ)  =%s", args[0].v_string.str, QCC_StatusText(status)));
-        if (status != ER_OK) {
-            QCC_DbgPrintf(("AboutService::%s : Call to GetMsgArg failed with %s", __FUNCTION__, QCC_StatusText(status)));
-            if (status == ER_LANGUAGE_NOT_SUPPORTED) {
-                MethodReply(msg, "org.alljoyn.Error.LanguageNotSupported", "The language specified is not supported");
+        // Reply with the dictionary built for an earlier request for the
+        // same language unless the about data changed since.
+        AboutDataCache& cache = m_busAttachment->GetInternal().GetAboutDataCache();
+        uint32_t version = cache.GetVersion(m_aboutDataListener);
+        qcc::String language(args[0].v_string.str);
+        std::shared_ptr<const MsgArg> aboutData = cache.GetAboutData(m_aboutDataListener, version, language);
+        if (!aboutData) {
+            std::shared_ptr<MsgArg> retarg = std::make_shared<MsgArg>();
+            status = m_aboutDataListener->GetAboutData(retarg.get(), language.c_str());
+            if (status != ER_OK) {
+                QCC_DbgPrintf(("AboutService::%s : Call to GetMsgArg failed with %s", __FUNCTION__, QCC_StatusText(status)));
+                if (status == ER_LANGUAGE_NOT_SUPPORTED) {
+                    MethodReply(msg, "org.alljoyn.Error.LanguageNotSupported", "The language specified is not supported");
+                    return;
+                }
+                MethodReply(msg, status);
                 return;
             }
-            MethodReply(msg, status);
-            return;
-        } else {
-            MethodReply(msg, retargs, 1);
+            retarg->Stabilize();
+            cache.AddAboutData(m_aboutDataListener, version, language, retarg);
+            aboutData = retarg;
         }
+        MethodReply(msg, aboutData.get(), 1);
     } else {
         MethodReply(msg, ER_INVALID_DATA);
     }
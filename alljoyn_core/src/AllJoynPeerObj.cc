@@ -218,8 +218,9 @@ bool AllJoynPeerObj::NeedToYieldToPeer(bool initiatorFlag, PeerState& peerState)
 AllJoynPeerObj::AllJoynPeerObj(BusAttachment& bus) :
     BusObject(org::alljoyn::Bus::Peer::ObjectPath, false),
     AlarmListener(),
+    nextConversationId(0),
     lock(LOCK_LEVEL_ALLJOYNPEEROBJ_LOCK),
-    dispatcher("PeerObjDispatcher", true, 3), supportedAuthSuitesCount(0), supportedAuthSuites(NULL), securityApplicationObj(bus)
+    dispatcher("PeerObjDispatcher", true, 3), conversationDispatcher("PeerObjConversations", true, 3), supportedAuthSuitesCount(0), supportedAuthSuites(NULL), securityApplicationObj(bus)
 {
     /* Add org.alljoyn.Bus.Peer.Authentication interface */
     {
@@ -257,6 +258,7 @@ QStatus AllJoynPeerObj::Start()
     QCC_ASSERT(bus);
     bus->RegisterBusListener(*this);
     dispatcher.Start();
+    conversationDispatcher.Start();
     return ER_OK;
 }
 
@@ -264,6 +266,8 @@ QStatus AllJoynPeerObj::Stop()
 {
     QCC_ASSERT(bus);
     dispatcher.Stop();
+    conversationDispatcher.Stop();
+    ecdheKeyPool.Stop();
     bus->UnregisterBusListener(*this);
     return ER_OK;
 }
@@ -281,6 +285,19 @@ QStatus AllJoynPeerObj::Join()
     lock.Unlock(MUTEX_CONTEXT);
 
     dispatcher.Join();
+    conversationDispatcher.Join();
+    ecdheKeyPool.Join();
+
+    /*
+     * Conversations still waiting on a reply will not be resumed.
+     */
+    lock.Lock(MUTEX_CONTEXT);
+    std::map<uint32_t, shared_ptr<AuthConversation> > pending = authConversations;
+    lock.Unlock(MUTEX_CONTEXT);
+    std::map<uint32_t, shared_ptr<AuthConversation> >::iterator it;
+    for (it = pending.begin(); it != pending.end(); ++it) {
+        FinishConversation(it->second, ER_BUS_STOPPING);
+    }
     return ER_OK;
 }
 
@@ -1063,13 +1080,103 @@ void AllJoynPeerObj::ForceAuthentication(const qcc::String& busName)
 #define AUTH_TIMEOUT      120000
 #define DEFAULT_TIMEOUT   10000
 
+/*
+ * State of an authentication conversation started by this peer. Each method call of the
+ * conversation is made asynchronously and the reply resumes the conversation on the conversation
+ * dispatcher, so a conversation only holds a thread while it is doing work.
+ */
+struct AllJoynPeerObj::AuthConversation {
+    AuthConversation(BusAttachment& bus, uint32_t id, AllJoynMessageType msgType, const qcc::String& busName, const Message& msg, RequestType reqType, bool synchronous, bool wait, const InterfaceDescription* ifc) :
+        id(id), msgType(msgType), busName(busName), msg(msg), reqType(reqType), synchronous(synchronous), wait(wait), ifc(ifc),
+        remotePeerObj(bus, busName.c_str(), org::alljoyn::Bus::Peer::ObjectPath, 0), step(AUTH_STEP_EXCHANGE_GUIDS), callMsg(bus),
+        remotePeerGuid(0), authVersion(0), useKeyExchanger(false), needGenGroupKey(false), authTried(false), firstPass(true),
+        hashInitialized(false), sendKeyBlob(false), currentSuite(0), remoteAuthMask(0), saslState(SASLEngine::ALLJOYN_SEND_AUTH_REQ),
+        membershipsSent(0), finished(false), status(ER_OK)
+    {
+        remotePeerObj.AddInterface(*ifc);
+    }
+
+    ~AuthConversation()
+    {
+        _PeerState::ClearGuildArgs(membershipArgs);
+    }
+
+    /**
+     * Free the initiator conversation hash if this conversation initialized it.
+     */
+    void FreeConversationHash()
+    {
+        if (hashInitialized) {
+            peerState->AcquireConversationHashLock(true);
+            peerState->FreeConversationHash(true);
+            peerState->ReleaseConversationHashLock(true);
+            hashInitialized = false;
+        }
+    }
+
+    const uint32_t id;                   /**< Identifies the conversation in reply contexts */
+    const AllJoynMessageType msgType;    /**< Message type we're trying to send */
+    const qcc::String busName;           /**< Bus name of the remote peer we are securing */
+    Message msg;                         /**< Message that triggered the authentication, may be invalid */
+    const RequestType reqType;           /**< Request that started an asynchronous conversation */
+    const bool synchronous;              /**< True if a caller is waiting on done */
+    const bool wait;                     /**< A synchronous caller waits for other authentications of the peer */
+    const InterfaceDescription* ifc;     /**< The peer authentication interface */
+    ProxyBusObject remotePeerObj;        /**< The remote peer object */
+    PeerState peerState;                 /**< State of the remote peer */
+    AuthStep step;                       /**< The method call the conversation is waiting on */
+    Message callMsg;                     /**< Copy of that method call, for the conversation hash */
+    qcc::String sender;                  /**< Unique name of the remote peer */
+    qcc::String localGuidStr;            /**< Local authentication GUID */
+    qcc::GUID128 remotePeerGuid;         /**< Remote authentication GUID */
+    uint32_t authVersion;                /**< Negotiated authentication version */
+    bool useKeyExchanger;                /**< Authenticate with the key exchanger rather than SASL */
+    bool needGenGroupKey;                /**< A session key was generated, group keys must be exchanged */
+    bool authTried;                      /**< An authentication was attempted */
+    bool firstPass;                      /**< No authentication has been attempted yet */
+    bool hashInitialized;                /**< The initiator conversation hash belongs to this conversation */
+    bool sendKeyBlob;                    /**< ExchangeGroupKeys exchanges key blobs rather than keys */
+    qcc::String nonce;                   /**< Local half of the GenSessionKey seed */
+    qcc::String mech;                    /**< Name of the authentication mechanism used */
+    std::vector<uint32_t> authSuites;    /**< Auth suites that are left to try */
+    std::shared_ptr<KeyExchanger> keyExchanger;  /**< The key exchanger being tried */
+    uint32_t currentSuite;               /**< Auth suite of the key exchanger being tried */
+    uint32_t remoteAuthMask;             /**< Auth suite the remote peer answered with */
+    std::shared_ptr<SASLEngine> sasl;    /**< The SASL engine if authenticating with SASL */
+    qcc::String saslResponse;            /**< Response for the next AuthChallenge call */
+    SASLEngine::AuthState saslState;     /**< State of the SASL engine */
+    std::vector<Manifest> manifestsSent; /**< Manifests sent by the SendManifests call */
+    std::vector<std::vector<MsgArg*> > membershipArgs;  /**< Membership certificate chains to send */
+    uint8_t membershipsSent;             /**< Number of membership certificate chains sent */
+    qcc::Event authEvent;                /**< Other authentications of the peer wait on this event */
+    std::vector<std::shared_ptr<AuthConversation> > followers;  /**< Conversations that complete with this one */
+    bool finished;                       /**< FinishConversation has been called */
+    QStatus status;                      /**< Result of the conversation once done is set */
+    qcc::Event done;                     /**< Set when the conversation has finished */
+
+  private:
+    AuthConversation(const AuthConversation& other);
+    AuthConversation& operator=(const AuthConversation& other);
+};
+
 QStatus AllJoynPeerObj::AuthenticatePeer(AllJoynMessageType msgType, const qcc::String& busName, bool wait, Message* msg)
 {
     QCC_ASSERT(bus);
-    QStatus status;
+    shared_ptr<AuthConversation> conv;
+    QStatus status = StartConversation(msgType, busName, msg ? *msg : Message(*bus), SECURE_CONNECTION, true, wait, conv);
+    if (status == ER_BUS_AUTHENTICATION_PENDING) {
+        status = Event::Wait(conv->done);
+        if (status == ER_OK) {
+            status = conv->status;
+        }
+    }
+    return status;
+}
+
+QStatus AllJoynPeerObj::StartConversation(AllJoynMessageType msgType, const qcc::String& busName, const Message& msg, RequestType reqType, bool synchronous, bool wait, shared_ptr<AuthConversation>& conv)
+{
     PeerStateTable* peerStateTable = bus->GetInternal().GetPeerStateTable();
     PeerState peerState = peerStateTable->GetPeerState(busName);
-    qcc::String mech;
     const InterfaceDescription* ifc = bus->GetInterface(org::alljoyn::Bus::Peer::Authentication::InterfaceName);
     if (ifc == NULL) {
         return ER_BUS_NO_SUCH_INTERFACE;
@@ -1088,63 +1195,175 @@ QStatus AllJoynPeerObj::AuthenticatePeer(AllJoynMessageType msgType, const qcc::
     }
     /*
      * Check if this peer is already being authenticated. This check won't catch authentications
-     * that use different names for the same peer, but we catch those below when we using the
-     * unique name. Worst case we end up making a redundant ExchangeGuids method call.
+     * that use different names for the same peer, but we catch those when the ExchangeGuids reply
+     * gives us the unique name. Worst case we end up making a redundant ExchangeGuids method call.
      */
-    if (msgType == MESSAGE_METHOD_CALL) {
-        lock.Lock(MUTEX_CONTEXT);
-        if (peerState->GetAuthEvent()) {
+    lock.Lock(MUTEX_CONTEXT);
+    if ((msgType == MESSAGE_METHOD_CALL) && peerState->GetAuthEvent()) {
+        if (synchronous) {
             if (wait) {
                 Event::Wait(*peerState->GetAuthEvent(), lock);
                 return peerState->IsSecure() ? ER_OK : ER_AUTH_FAIL;
-            } else {
-                lock.Unlock(MUTEX_CONTEXT);
-                return ER_WOULDBLOCK;
+            }
+            lock.Unlock(MUTEX_CONTEXT);
+            return ER_WOULDBLOCK;
+        }
+        QStatus status = ER_WOULDBLOCK;
+        /*
+         * A secure connection request needs its own result, it completes with the conversation
+         * that is already authenticating the peer.
+         */
+        if (reqType == SECURE_CONNECTION) {
+            conv = make_shared<AuthConversation>(*bus, nextConversationId++, msgType, busName, msg, reqType, synchronous, wait, ifc);
+            conv->peerState = peerState;
+            if (FollowConversation(conv, peerState)) {
+                status = ER_BUS_AUTHENTICATION_PENDING;
             }
         }
         lock.Unlock(MUTEX_CONTEXT);
+        return status;
     }
-
-    ProxyBusObject remotePeerObj(*bus, busName.c_str(), org::alljoyn::Bus::Peer::ObjectPath, 0);
-    remotePeerObj.AddInterface(*ifc);
+    conv = make_shared<AuthConversation>(*bus, nextConversationId++, msgType, busName, msg, reqType, synchronous, wait, ifc);
+    conv->peerState = peerState;
+    authConversations[conv->id] = conv;
+    lock.Unlock(MUTEX_CONTEXT);
 
     /*
      * Exchange GUIDs with the peer, this will get us the GUID of the remote peer and also the
      * unique bus name from which we can determine if we have already have a session key, a
      * master secret or if we have to start an authentication conversation.
      */
-    qcc::String localGuidStr = bus->GetInternal().GetKeyStore().GetGuid();
+    conv->localGuidStr = bus->GetInternal().GetKeyStore().GetGuid();
     MsgArg args[2];
-    args[0].Set("s", localGuidStr.c_str());
+    args[0].Set("s", conv->localGuidStr.c_str());
     args[1].Set("u", PREFERRED_AUTH_VERSION);
-    Message callMsg(*bus);
-    Message replyMsg(*bus);
-    const InterfaceDescription::Member* exchangeGuidsMember = ifc->GetMember("ExchangeGuids");
-    QCC_ASSERT(exchangeGuidsMember);
-    status = remotePeerObj.MethodCall(*exchangeGuidsMember, args, ArraySize(args), replyMsg, DEFAULT_TIMEOUT, 0, &callMsg);
+    QStatus status = SendConversationCall(conv, AUTH_STEP_EXCHANGE_GUIDS, "ExchangeGuids", args, ArraySize(args), DEFAULT_TIMEOUT);
+    if (status != ER_BUS_AUTHENTICATION_PENDING) {
+        QCC_LogError(status, ("ExchangeGuids failed"));
+        FinishConversation(conv, status);
+    }
+    return ER_BUS_AUTHENTICATION_PENDING;
+}
+
+bool AllJoynPeerObj::FollowConversation(shared_ptr<AuthConversation> conv, PeerState& peerState)
+{
+    std::map<uint32_t, shared_ptr<AuthConversation> >::iterator it;
+    for (it = authConversations.begin(); it != authConversations.end(); ++it) {
+        if (&it->second->authEvent == peerState->GetAuthEvent()) {
+            it->second->followers.push_back(conv);
+            return true;
+        }
+    }
+    return false;
+}
+
+QStatus AllJoynPeerObj::SendConversationCall(shared_ptr<AuthConversation> conv, AuthStep step, const char* member, const MsgArg* args, size_t numArgs, uint32_t timeout, uint8_t flags)
+{
+    const InterfaceDescription::Member* callMember = conv->ifc->GetMember(member);
+    QCC_ASSERT(callMember);
+    conv->step = step;
+    /*
+     * The reply may resume the conversation before MethodCallAsync returns so use a copy of the
+     * proxy object, the continuation is allowed to replace it.
+     */
+    ProxyBusObject remotePeerObj(conv->remotePeerObj);
+    void* context = reinterpret_cast<void*>(static_cast<uintptr_t>(conv->id));
+    QStatus status = remotePeerObj.MethodCallAsync(*callMember, this, static_cast<MessageReceiver::ReplyHandler>(&AllJoynPeerObj::ConversationReply),
+                                                   args, numArgs, context, timeout, flags, &conv->callMsg);
+    return (status == ER_OK) ? ER_BUS_AUTHENTICATION_PENDING : status;
+}
+
+void AllJoynPeerObj::ConversationReply(Message& reply, void* context)
+{
+    uint32_t id = static_cast<uint32_t>(reinterpret_cast<uintptr_t>(context));
+    QStatus status = DispatchRequest(reply, AUTH_CONVERSATION, "", id);
+    if (status != ER_OK) {
+        ResumeConversation(id, reply, status);
+    }
+}
+
+void AllJoynPeerObj::ResumeConversation(uint32_t id, Message& reply, QStatus reason)
+{
+    shared_ptr<AuthConversation> conv;
+    lock.Lock(MUTEX_CONTEXT);
+    std::map<uint32_t, shared_ptr<AuthConversation> >::iterator it = authConversations.find(id);
+    if ((it != authConversations.end()) && !it->second->finished) {
+        conv = it->second;
+    }
+    lock.Unlock(MUTEX_CONTEXT);
+    if (!conv) {
+        return;
+    }
+    if (reason != ER_OK) {
+        QCC_LogError(reason, ("Authentication conversation with %s abandoned", conv->busName.c_str()));
+        FinishConversation(conv, ER_BUS_STOPPING);
+        return;
+    }
+    QStatus status = (reply->GetType() == MESSAGE_ERROR) ? ER_BUS_REPLY_IS_ERROR_MESSAGE : ER_OK;
+    switch (conv->step) {
+    case AUTH_STEP_EXCHANGE_GUIDS:
+        status = ExchangeGuidsReply(conv, reply, status);
+        break;
+
+    case AUTH_STEP_GEN_SESSION_KEY:
+        status = GenSessionKeyReply(conv, reply, status);
+        break;
+
+    case AUTH_STEP_EXCHANGE_SUITES:
+        status = ExchangeSuitesReply(conv, reply, status);
+        break;
+
+    case AUTH_STEP_KEY_EXCHANGE:
+        status = KeyExchangeReply(conv, reply, status);
+        break;
+
+    case AUTH_STEP_KEY_AUTHENTICATION:
+        status = KeyAuthenticationReply(conv, reply, status);
+        break;
+
+    case AUTH_STEP_AUTH_CHALLENGE:
+        status = AuthChallengeReply(conv, reply, status);
+        break;
+
+    case AUTH_STEP_EXCHANGE_GROUP_KEYS:
+        status = ExchangeGroupKeysReply(conv, reply, status);
+        break;
+
+    case AUTH_STEP_SEND_MANIFESTS:
+        status = SendManifestsReply(conv, reply, status);
+        break;
+
+    case AUTH_STEP_SEND_MEMBERSHIPS:
+        status = SendMembershipsReply(conv, reply, status);
+        break;
+    }
+    if (status != ER_BUS_AUTHENTICATION_PENDING) {
+        FinishConversation(conv, status);
+    }
+}
+
+QStatus AllJoynPeerObj::ExchangeGuidsReply(shared_ptr<AuthConversation> conv, Message& reply, QStatus status)
+{
     if (status != ER_OK) {
         /*
          * ER_BUS_REPLY_IS_ERROR_MESSAGE has a specific meaning in the public API and should not be
          * propogated to the caller from this context.
          */
-        if (status == ER_BUS_REPLY_IS_ERROR_MESSAGE) {
-            if (replyMsg->GetErrorName() != NULL && strcmp(replyMsg->GetErrorName(), "org.freedesktop.DBus.Error.ServiceUnknown") == 0) {
-                status = ER_BUS_NO_SUCH_OBJECT;
-            } else {
-                status = ER_AUTH_FAIL;
-            }
+        if (reply->GetErrorName() != NULL && strcmp(reply->GetErrorName(), "org.freedesktop.DBus.Error.ServiceUnknown") == 0) {
+            status = ER_BUS_NO_SUCH_OBJECT;
+        } else {
+            status = ER_AUTH_FAIL;
         }
         QCC_LogError(status, ("ExchangeGuids failed"));
         return status;
     }
-    const qcc::String sender = replyMsg->GetSender();
+    conv->sender = reply->GetSender();
     /*
      * Extract the remote guid from the message
      */
-    qcc::GUID128 remotePeerGuid(replyMsg->GetArg(0)->v_string.str);
-    KeyStore::Key remotePeerKey(KeyStore::Key::REMOTE, remotePeerGuid);
-    uint32_t authVersion = replyMsg->GetArg(1)->v_uint32;
-    qcc::String remoteGuidStr = remotePeerGuid.ToString();
+    conv->remotePeerGuid = qcc::GUID128(reply->GetArg(0)->v_string.str);
+    uint32_t authVersion = reply->GetArg(1)->v_uint32;
+    qcc::String remoteGuidStr = conv->remotePeerGuid.ToString();
     /*
      * Check that we can support the version the remote peer proposed.
      */
@@ -1155,15 +1374,24 @@ QStatus AllJoynPeerObj::AuthenticatePeer(AllJoynMessageType msgType, const qcc::
     } else {
         authVersion = GetLowerVersion(authVersion, PREFERRED_AUTH_VERSION);
     }
-    QCC_DbgHLPrintf(("ExchangeGuids Local %s", localGuidStr.c_str()));
+    conv->authVersion = authVersion;
+    QCC_DbgHLPrintf(("ExchangeGuids Local %s", conv->localGuidStr.c_str()));
     QCC_DbgHLPrintf(("ExchangeGuids Remote %s", remoteGuidStr.c_str()));
     QCC_DbgHLPrintf(("ExchangeGuids AuthVersion %d", authVersion));
+    /*
+     * The rest of the conversation talks to the unique name so the manifests we send are addressed
+     * to the peer we authenticated.
+     */
+    conv->remotePeerObj = ProxyBusObject(*bus, conv->busName.c_str(), conv->sender.c_str(), org::alljoyn::Bus::Peer::ObjectPath, 0);
+    conv->remotePeerObj.AddInterface(*conv->ifc);
     /*
      * Now we have the unique bus name in the reply try again to find out if we have a session key
      * for this peer.
      */
-    peerState = peerStateTable->GetPeerState(sender, busName);
-    peerState->SetGuidAndAuthVersion(remotePeerGuid, authVersion);
+    PeerStateTable* peerStateTable = bus->GetInternal().GetPeerStateTable();
+    PeerState peerState = peerStateTable->GetPeerState(conv->sender, conv->busName);
+    conv->peerState = peerState;
+    peerState->SetGuidAndAuthVersion(conv->remotePeerGuid, authVersion);
     /*
      * We can now return if the peer is authenticated.
      */
@@ -1171,26 +1399,27 @@ QStatus AllJoynPeerObj::AuthenticatePeer(AllJoynMessageType msgType, const qcc::
         return ER_OK;
     }
     /*
-     * Check again if the peer is being authenticated on another thread. We need to do this because
-     * the check above may have used a well-known-namme and now we know the unique name.
+     * Check again if the peer is being authenticated by another conversation. We need to do this
+     * because the check at the start may have used a well-known-namme and now we know the unique
+     * name.
      */
     lock.Lock(MUTEX_CONTEXT);
     if (peerState->GetAuthEvent()) {
-        if (wait) {
-            Event::Wait(*peerState->GetAuthEvent(), lock);
-            return peerState->IsSecure() ? ER_OK : ER_AUTH_FAIL;
-        } else {
+        bool follow = conv->synchronous ? conv->wait : (conv->reqType == SECURE_CONNECTION);
+        if (follow && FollowConversation(conv, peerState)) {
             lock.Unlock(MUTEX_CONTEXT);
-            return ER_WOULDBLOCK;
+            return ER_BUS_AUTHENTICATION_PENDING;
         }
+        lock.Unlock(MUTEX_CONTEXT);
+        return ER_WOULDBLOCK;
     }
     /*
      * The bus allows a peer to send signals and make method calls to itself. If we are securing the
      * local peer we obviously don't need to authenticate but we must initialize a peer state object
      * with a session key and group key.
      */
-    if (bus->GetUniqueName() == sender) {
-        QCC_ASSERT(remoteGuidStr == localGuidStr);
+    if (bus->GetUniqueName() == conv->sender) {
+        QCC_ASSERT(remoteGuidStr == conv->localGuidStr);
         QCC_DbgHLPrintf(("Securing local peer to itself"));
         KeyBlob key;
         /* Use the local peer's GROUP key */
@@ -1215,28 +1444,24 @@ QStatus AllJoynPeerObj::AuthenticatePeer(AllJoynMessageType msgType, const qcc::
      * authenticated we return an error status which will cause a security
      * violation notification back to the application.
      */
-    if ((msgType != MESSAGE_METHOD_CALL) && (msgType != MESSAGE_ERROR)) {
+    if ((conv->msgType != MESSAGE_METHOD_CALL) && (conv->msgType != MESSAGE_ERROR)) {
         /* We are still holding the lock */
         lock.Unlock(MUTEX_CONTEXT);
         return ER_BUS_DESTINATION_NOT_AUTHENTICATED;
     }
     /*
-     * Other threads authenticating the same peer will block on this event until the authentication completes.
+     * Other authentications of the same peer will wait on this event until this conversation completes.
      */
-    qcc::Event authEvent;
-    peerState->SetAuthEvent(&authEvent);
+    peerState->SetAuthEvent(&conv->authEvent);
     lock.Unlock(MUTEX_CONTEXT);
 
-    KeyStore& keyStore = bus->GetInternal().GetKeyStore();
-    bool needGenGroupKey = false;
-    bool authTried = false;
-    bool firstPass = true;
-    bool useKeyExchanger = UseKeyExchanger(authVersion, supportedAuthSuites, supportedAuthSuitesCount);
+    conv->useKeyExchanger = UseKeyExchanger(authVersion, supportedAuthSuites, supportedAuthSuitesCount);
     bool initiatorFlag = true;
     peerState->AcquireConversationHashLock(initiatorFlag);
     peerState->InitializeConversationHash(initiatorFlag);
     this->HashGUIDs(initiatorFlag, peerState, true);
     peerState->ReleaseConversationHashLock(initiatorFlag);
+    conv->hashInitialized = true;
 
     /*
      * The two peers can initiate a key exchange against each other.  Each key
@@ -1245,360 +1470,458 @@ QStatus AllJoynPeerObj::AuthenticatePeer(AllJoynMessageType msgType, const qcc::
      * one master secret between the two peers.
      * However, most of the time, there only one initiator in the key exchange.
      */
-    do {
+    return SendGenSessionKey(conv);
+}
+
+QStatus AllJoynPeerObj::SendGenSessionKey(shared_ptr<AuthConversation> conv)
+{
+    /*
+     * Try to load the master secret for the remote peer. It is possible that the master secret
+     * has expired or been deleted either locally or remotely so if we fail to establish a
+     * session key on the first pass we start an authentication conversation to establish a new
+     * master secret.
+     */
+    KeyStore::Key remotePeerKey(KeyStore::Key::REMOTE, conv->remotePeerGuid);
+    if (!bus->GetInternal().GetKeyStore().HasKey(remotePeerKey)) {
+        return SessionKeyFailed(conv, ER_AUTH_FAIL);
+    }
+    /*
+     * Generate a random string - this is the local half of the seed string.
+     */
+    conv->nonce = RandHexString(NONCE_LEN);
+    /*
+     * Send GenSessionKey message to remote peer.
+     */
+    qcc::String remoteGuidStr = conv->remotePeerGuid.ToString();
+    MsgArg msgArgs[3];
+    msgArgs[0].Set("s", conv->localGuidStr.c_str());
+    msgArgs[1].Set("s", remoteGuidStr.c_str());
+    msgArgs[2].Set("s", conv->nonce.c_str());
+    QStatus status = SendConversationCall(conv, AUTH_STEP_GEN_SESSION_KEY, "GenSessionKey", msgArgs, ArraySize(msgArgs), DEFAULT_TIMEOUT);
+    if (status != ER_BUS_AUTHENTICATION_PENDING) {
+        return SessionKeyFailed(conv, status);
+    }
+    return status;
+}
+
+QStatus AllJoynPeerObj::GenSessionKeyReply(shared_ptr<AuthConversation> conv, Message& reply, QStatus status)
+{
+    bool initiatorFlag = true;
+    PeerState& peerState = conv->peerState;
+    peerState->AcquireConversationHashLock(initiatorFlag);
+    peerState->UpdateHash(initiatorFlag, CONVERSATION_V4, conv->callMsg);
+    peerState->UpdateHash(initiatorFlag, CONVERSATION_V4, reply);
+    peerState->ReleaseConversationHashLock(initiatorFlag);
+    if (status == ER_OK) {
+        qcc::String verifier;
         /*
-         * Try to load the master secret for the remote peer. It is possible that the master secret
-         * has expired or been deleted either locally or remotely so if we fail to establish a
-         * session key on the first pass we start an authentication conversation to establish a new
-         * master secret.
+         * The response completes the seed string so we can generate the session key.
          */
-
-        if (!keyStore.HasKey(remotePeerKey)) {
+        auto str = reinterpret_cast<const uint8_t*>(reply->GetArg(0)->v_string.str);
+        auto len = reply->GetArg(0)->v_string.len;
+        vector<uint8_t, SecureAllocator<uint8_t> > seed;
+        seed.reserve(len + conv->nonce.size());
+        AppendStringToSecureVector(conv->nonce, seed);
+        seed.insert(seed.end(), str, str + len);
+        status = KeyGen(peerState, seed, verifier, KeyBlob::INITIATOR);
+        QCC_DbgHLPrintf(("Initiator KeyGen after receiving response from sender %s status %x", conv->busName.c_str(), status));
+        if ((status == ER_OK) && (verifier != reply->GetArg(1)->v_string.str)) {
             status = ER_AUTH_FAIL;
         }
         if (status == ER_OK) {
-            /*
-             * Generate a random string - this is the local half of the seed string.
-             */
-            qcc::String nonce = RandHexString(NONCE_LEN);
-            /*
-             * Send GenSessionKey message to remote peer.
-             */
-            MsgArg msgArgs[3];
-            msgArgs[0].Set("s", localGuidStr.c_str());
-            msgArgs[1].Set("s", remoteGuidStr.c_str());
-            msgArgs[2].Set("s", nonce.c_str());
-
-            const InterfaceDescription::Member* genSessionKeyMember = ifc->GetMember("GenSessionKey");
-            QCC_ASSERT(genSessionKeyMember);
-            peerState->AcquireConversationHashLock(initiatorFlag);
-            status = remotePeerObj.MethodCall(*genSessionKeyMember, msgArgs, ArraySize(msgArgs), replyMsg, DEFAULT_TIMEOUT, 0, &callMsg);
-            peerState->UpdateHash(initiatorFlag, CONVERSATION_V4, callMsg);
-            peerState->UpdateHash(initiatorFlag, CONVERSATION_V4, replyMsg);
-            peerState->ReleaseConversationHashLock(initiatorFlag);
-            if (status == ER_OK) {
-                qcc::String verifier;
-                /*
-                 * The response completes the seed string so we can generate the session key.
-                 */
-                auto str = reinterpret_cast<const uint8_t*>(replyMsg->GetArg(0)->v_string.str);
-                auto len = replyMsg->GetArg(0)->v_string.len;
-                vector<uint8_t, SecureAllocator<uint8_t> > seed;
-                seed.reserve(len + nonce.size());
-                AppendStringToSecureVector(nonce, seed);
-                seed.insert(seed.end(), str, str + len);
-                status = KeyGen(peerState, seed, verifier, KeyBlob::INITIATOR);
-                QCC_DbgHLPrintf(("Initiator KeyGen after receiving response from sender %s status %x", busName.c_str(), status));
-                if ((status == ER_OK) && (verifier != replyMsg->GetArg(1)->v_string.str)) {
-                    status = ER_AUTH_FAIL;
-                }
-                if (status == ER_OK) {
-                    needGenGroupKey = true;
-                }
-            }
-        }
-        if ((status == ER_OK) || !firstPass) {
-            break;
-        }
-        if (useKeyExchanger) {
-            uint32_t*remoteAuthSuites = NULL;
-            size_t remoteAuthSuitesCount = 0;
-            status = AskForAuthSuites(authVersion, remotePeerObj, ifc, &remoteAuthSuites, &remoteAuthSuitesCount, peerState);
-            if (status == ER_OK) {
-                status = AuthenticatePeerUsingKeyExchange(remoteAuthSuites, remoteAuthSuitesCount, busName, peerState, localGuidStr, remotePeerObj, ifc, mech);
-                if (remoteAuthSuites) {
-                    delete [] remoteAuthSuites;
-                }
-            }
-        } else {
-            status = AuthenticatePeerUsingSASL(busName, peerState, localGuidStr, remotePeerObj, ifc, remotePeerKey, mech);
-        }
-        authTried = true;
-        firstPass = false;
-        if (peerState->IsSecure()) {
-            status = ER_OK;
-            break;  /* there is a concurrent key exchange that completes */
+            conv->needGenGroupKey = true;
+            return SendExchangeGroupKeys(conv, status);
         }
-    } while (status == ER_OK);
-    /*
-     * At this point, the authentication conversation is over and we no longer need
-     * to keep the conversation hash.
-     */
-    peerState->AcquireConversationHashLock(initiatorFlag);
-    peerState->FreeConversationHash(initiatorFlag);
-    peerState->ReleaseConversationHashLock(initiatorFlag);
+    }
+    return SessionKeyFailed(conv, status);
+}
+
+QStatus AllJoynPeerObj::SessionKeyFailed(shared_ptr<AuthConversation> conv, QStatus status)
+{
+    if (!conv->firstPass) {
+        return SendExchangeGroupKeys(conv, status);
+    }
+    conv->authTried = true;
+    conv->firstPass = false;
+    if (conv->useKeyExchanger) {
+        return SendExchangeSuites(conv);
+    }
+    return StartSASL(conv);
+}
 
+QStatus AllJoynPeerObj::SendExchangeSuites(shared_ptr<AuthConversation> conv)
+{
+    if (supportedAuthSuitesCount == 0) {
+        return AuthAttemptDone(conv, ER_AUTH_FAIL);
+    }
     /*
-     * Exchange group keys with the remote peer. This method call is encrypted using the session key
-     * that we just established.
+     * Peers with an older authentication version do not support ECDHE_ECDSA with X.509 certificates
      */
-    if ((status == ER_OK) && needGenGroupKey) {
-        uint8_t keyGenVersion = authVersion & 0xFF;
-        uint16_t authV = authVersion >> 16;
-        uint8_t sendKeyBlob = (authV <= 1) && (keyGenVersion == 0);
-        Message keyExchangeReplyMsg(*bus);
-        KeyBlob key;
-        peerStateTable->GetGroupKey(key);
-        StringSink snk;
-        MsgArg arg;
-        /*
-         * KeyGen version 0 exchanges key blobs, version 1 just exchanges the key
-         */
-        QCC_DbgHLPrintf(("ExchangeGroupKeys using key gen version %d", keyGenVersion));
-        if (sendKeyBlob) {
-            key.Store(snk);
-            arg.Set("ay", snk.GetString().size(), snk.GetString().data());
-        } else {
-            arg.Set("ay", key.GetSize(), key.GetData());
+    bool excludeECDHE_ECDSA = ((conv->authVersion >> 16) <= NON_ECDSA_X509_VERSION);
+    std::vector<uint32_t> authSuites;
+    for (size_t cnt = 0; cnt < supportedAuthSuitesCount; cnt++) {
+        if (!excludeECDHE_ECDSA || (supportedAuthSuites[cnt] != AUTH_SUITE_ECDHE_ECDSA)) {
+            authSuites.push_back(supportedAuthSuites[cnt]);
         }
-        const InterfaceDescription::Member* exchangeGroupKeysMember = ifc->GetMember("ExchangeGroupKeys");
-        QCC_ASSERT(exchangeGroupKeysMember);
-        status = remotePeerObj.MethodCall(*exchangeGroupKeysMember, &arg, 1, keyExchangeReplyMsg, DEFAULT_TIMEOUT, ALLJOYN_FLAG_ENCRYPTED);
+    }
+    MsgArg arg;
+    arg.Set("au", authSuites.size(), authSuites.empty() ? NULL : &authSuites[0]);
+    QStatus status = SendConversationCall(conv, AUTH_STEP_EXCHANGE_SUITES, "ExchangeSuites", &arg, 1, DEFAULT_TIMEOUT);
+    if (status != ER_BUS_AUTHENTICATION_PENDING) {
+        return AuthAttemptDone(conv, status);
+    }
+    return status;
+}
+
+QStatus AllJoynPeerObj::ExchangeSuitesReply(shared_ptr<AuthConversation> conv, Message& reply, QStatus status)
+{
+    if (status != ER_OK) {
+        return AuthAttemptDone(conv, status);
+    }
+    bool initiatorFlag = true;
+    conv->peerState->AcquireConversationHashLock(initiatorFlag);
+    conv->peerState->UpdateHash(initiatorFlag, CONVERSATION_V4, conv->callMsg);
+    conv->peerState->UpdateHash(initiatorFlag, CONVERSATION_V4, reply);
+    conv->peerState->ReleaseConversationHashLock(initiatorFlag);
+    uint32_t* remoteSuites;
+    size_t remoteSuitesLen;
+    status = reply->GetArg(0)->Get("au", &remoteSuitesLen, &remoteSuites);
+    if (status != ER_OK) {
+        return AuthAttemptDone(conv, status);
+    }
+    conv->authSuites.assign(remoteSuites, remoteSuites + remoteSuitesLen);
+    return SendKeyExchange(conv);
+}
+
+QStatus AllJoynPeerObj::SendKeyExchange(shared_ptr<AuthConversation> conv)
+{
+    QCC_DbgHLPrintf(("AuthenticatePeerUsingKeyExchange"));
+    conv->remoteAuthMask = 0;
+    conv->keyExchanger = GetKeyExchangerInstance(conv->peerState, true, conv->authSuites.empty() ? NULL : &conv->authSuites[0], conv->authSuites.size());  /* initiator */
+    if (!conv->keyExchanger) {
+        return AuthAttemptDone(conv, ER_AUTH_FAIL);
+    }
+    conv->currentSuite = conv->keyExchanger->GetSuite();
+    conv->mech = conv->keyExchanger->GetSuiteName();
+    MsgArg args[2];
+    QStatus status = conv->keyExchanger->KeyExchangeGenArgs(conv->currentSuite, args);
+    if (status == ER_OK) {
+        status = SendConversationCall(conv, AUTH_STEP_KEY_EXCHANGE, "KeyExchange", args, ArraySize(args), AUTH_TIMEOUT);
+    }
+    if (status != ER_BUS_AUTHENTICATION_PENDING) {
+        return KeyExchangeFailed(conv, status);
+    }
+    return status;
+}
+
+QStatus AllJoynPeerObj::KeyExchangeReply(shared_ptr<AuthConversation> conv, Message& reply, QStatus status)
+{
+    uint32_t remoteAuthMask = 0;
+    status = conv->keyExchanger->KeyExchangeReadReply(status, conv->callMsg, reply, &remoteAuthMask);
+    conv->remoteAuthMask = remoteAuthMask;
+    if ((status == ER_OK) && (remoteAuthMask != conv->currentSuite)) {
+        status = ER_AUTH_FAIL; /* remote auth mask is 0 */
+    }
+    if (status == ER_OK) {
+        MsgArg verifier;
+        status = conv->keyExchanger->KeyAuthenticationGenArg(conv->busName.c_str(), verifier);
         if (status == ER_OK) {
-            if (sendKeyBlob) {
-                StringSource src(keyExchangeReplyMsg->GetArg(0)->v_scalarArray.v_byte, keyExchangeReplyMsg->GetArg(0)->v_scalarArray.numElements);
-                status = key.Load(src);
-            } else {
-                status = key.Set(keyExchangeReplyMsg->GetArg(0)->v_scalarArray.v_byte, keyExchangeReplyMsg->GetArg(0)->v_scalarArray.numElements, KeyBlob::AES);
-            }
-            if (status == ER_OK) {
-                /*
-                 * Tag the group key with the auth mechanism used by ExchangeGroupKeys. Group keys
-                 * are inherently directional - only initiator encrypts with the group key. We set
-                 * the role to NO_ROLE otherwise senders can't decrypt their own broadcast messages.
-                 */
-                key.SetTag(keyExchangeReplyMsg->GetAuthMechanism(), KeyBlob::NO_ROLE);
-                peerState->SetKey(key, PEER_GROUP_KEY);
-            }
-            if (status == ER_OK) {
-                /* exchange membership guilds */
-                if (useKeyExchanger && IsMembershipCertCapable(peerState->GetAuthVersion())) {
-                    bool sendManifests = false;
-                    if (mech == "ALLJOYN_ECDHE_ECDSA") {
-                        sendManifests = true;
-                    } else if (mech.empty()) {
-                        /* key exchange step was skipped.
-                           Send manifest if the local peer already cached the
-                           remote peer's public key */
-                        ECCPublicKey pubKey;
-                        QStatus aStatus = securityApplicationObj.GetConnectedPeerPublicKey(peerState->GetGuid(), &pubKey);
-                        sendManifests = (ER_OK == aStatus);
-                    }
-                    if (sendManifests) {
-                        status = securityApplicationObj.SendManifests(&remotePeerObj, msg);
-                        if (status == ER_OK) {
-                            status = SendMembershipData(remotePeerObj, ifc, remotePeerGuid);
-                        }
-                    }
-                }
-            }
+            status = SendConversationCall(conv, AUTH_STEP_KEY_AUTHENTICATION, "KeyAuthentication", &verifier, 1, AUTH_TIMEOUT);
         }
     }
+    if (status != ER_BUS_AUTHENTICATION_PENDING) {
+        return KeyExchangeFailed(conv, status);
+    }
+    return status;
+}
+
+QStatus AllJoynPeerObj::KeyAuthenticationReply(shared_ptr<AuthConversation> conv, Message& reply, QStatus status)
+{
+    uint8_t authorized = false;
+    status = conv->keyExchanger->KeyAuthenticationReadReply(status, conv->callMsg, reply, conv->busName.c_str(), &authorized);
+    if (authorized) {
+        if (!conv->peerState->IsSecure()) {
+            SetRights(conv->peerState, true, false /*responder*/);
+            status = RecordMasterSecret(conv->busName, conv->keyExchanger, conv->peerState);
+            QCC_DbgHLPrintf(("AuthenticatePeerUsingKeyExchange records master secret for peer %s", conv->peerState->GetGuid().ToString().c_str()));
+        } else {
+            QCC_DbgHLPrintf(("AuthenticatePeerUsingKeyExchange does not record master secret for peer %s", conv->peerState->GetGuid().ToString().c_str()));
+        }
+    } else {
+        status = ER_AUTH_FAIL;
+    }
+    if (status == ER_OK) {
+        QCC_ASSERT(conv->currentSuite != 0);
+        return AuthAttemptDone(conv, status);
+    }
+    return KeyExchangeFailed(conv, status);
+}
+
+QStatus AllJoynPeerObj::KeyExchangeFailed(shared_ptr<AuthConversation> conv, QStatus status)
+{
+    QCC_UNUSED(status); /* avoid unused parameter warning in release build */
+    QCC_DbgHLPrintf(("Key exchange %s with %s failed: %s", conv->mech.c_str(), conv->busName.c_str(), QCC_StatusText(status)));
+    if (!conv->remoteAuthMask) {
+        return AuthAttemptDone(conv, ER_AUTH_FAIL); /* done */
+    }
+    if (conv->authSuites.size() <= 1) {
+        return AuthAttemptDone(conv, ER_AUTH_FAIL); /* done.  There is no more to try. */
+    }
     /*
-     * If an authentication was tried report the authentication completion to allow application to clear UI etc.
+     * Try again without the suite that failed
      */
-    if (authTried) {
-        peerAuthListener.AuthenticationComplete(mech.c_str(), sender.c_str(), status == ER_OK);
+    std::vector<uint32_t> smallerSuites;
+    for (size_t cnt = 0; cnt < conv->authSuites.size(); cnt++) {
+        if ((conv->authSuites[cnt] & conv->currentSuite) != conv->currentSuite) {
+            smallerSuites.push_back(conv->authSuites[cnt]);
+        }
+    }
+    if (smallerSuites.size() == conv->authSuites.size()) {
+        return AuthAttemptDone(conv, ER_AUTH_FAIL);
     }
+    conv->authSuites.swap(smallerSuites);
+    if ((conv->peerState->GetAuthVersion() >> 16) < CONVERSATION_V4) {
+        /* any peer with auth version smaller than 4 need to start the hash at
+         * the KeyExchange call */
+        bool initiatorFlag = true;
+        conv->peerState->AcquireConversationHashLock(initiatorFlag);
+        conv->peerState->InitializeConversationHash(initiatorFlag);
+        conv->peerState->ReleaseConversationHashLock(initiatorFlag);
+    }
+    return SendKeyExchange(conv);
+}
+
+QStatus AllJoynPeerObj::StartSASL(shared_ptr<AuthConversation> conv)
+{
     /*
-     * ER_BUS_REPLY_IS_ERROR_MESSAGE has a specific meaning in the public API an should not be
-     * propogated to the caller from this context.
+     * Initiaize the SASL engine as responder (i.e. client) this terminology seems backwards but
+     * is the terminology used by the DBus specification.
      */
-    if (status == ER_BUS_REPLY_IS_ERROR_MESSAGE) {
-        status = ER_AUTH_FAIL;
+    conv->sasl = make_shared<SASLEngine>(*bus, ajn::AuthMechanism::RESPONDER, peerAuthMechanisms, conv->busName.c_str(), peerAuthListener);
+    conv->sasl->SetLocalId(conv->localGuidStr);
+    conv->peerState->AddKeyExchangeModeMask(_PeerState::KEY_EXCHANGE_INITIATOR);
+    qcc::String inStr;
+    QStatus status = conv->sasl->Advance(inStr, conv->saslResponse, conv->saslState);
+    if (status != ER_OK) {
+        return AuthAttemptDone(conv, status);
     }
+    return SendAuthChallenge(conv);
+}
+
+QStatus AllJoynPeerObj::SendAuthChallenge(shared_ptr<AuthConversation> conv)
+{
     /*
-     * Release any other threads waiting on the result of this authentication.
+     * SASL authentication takes an unknown number of challenges, each is a step of the conversation.
      */
-    lock.Lock(MUTEX_CONTEXT);
-    peerState->NotifyAuthEvent();
-    peerState->SetAuthEvent(NULL);
-    lock.Unlock(MUTEX_CONTEXT);
+    MsgArg arg("s", conv->saslResponse.c_str());
+    QStatus status = SendConversationCall(conv, AUTH_STEP_AUTH_CHALLENGE, "AuthChallenge", &arg, 1, AUTH_TIMEOUT);
+    if (status != ER_BUS_AUTHENTICATION_PENDING) {
+        return AuthAttemptDone(conv, ER_AUTH_FAIL);
+    }
     return status;
 }
 
-QStatus AllJoynPeerObj::AuthenticatePeerUsingSASL(const qcc::String& busName, PeerState peerState, qcc::String& localGuidStr, ProxyBusObject& remotePeerObj, const InterfaceDescription* ifc, KeyStore::Key& remotePeerKey, qcc::String& mech)
+QStatus AllJoynPeerObj::AuthChallengeReply(shared_ptr<AuthConversation> conv, Message& reply, QStatus status)
 {
-    QStatus status;
-    ajn::SASLEngine::AuthState authState;
+    if (status != ER_OK) {
+        return AuthAttemptDone(conv, ER_AUTH_FAIL);
+    }
+    if (conv->saslState == SASLEngine::ALLJOYN_AUTH_SUCCESS) {
+        SetRights(conv->peerState, conv->sasl->AuthenticationIsMutual(), false /*responder*/);
+        return AuthAttemptDone(conv, ER_OK);
+    }
+    qcc::String inStr(reply->GetArg(0)->v_string.str);
+    status = conv->sasl->Advance(inStr, conv->saslResponse, conv->saslState);
+    conv->mech = conv->sasl->GetMechanism();
+    if ((status == ER_OK) && (conv->saslState == SASLEngine::ALLJOYN_AUTH_SUCCESS) && !conv->peerState->IsSecure()) {
+        KeyBlob masterSecret;
+        status = conv->sasl->GetMasterSecret(masterSecret);
+        if (status == ER_OK) {
+            SetRights(conv->peerState, conv->sasl->AuthenticationIsMutual(), false /*responder*/);
+            /* Tag the master secret with the auth mechanism used to generate it */
+            masterSecret.SetTag(conv->mech, KeyBlob::INITIATOR);
+            KeyStore::Key remotePeerKey(KeyStore::Key::REMOTE, conv->remotePeerGuid);
+            status = bus->GetInternal().GetKeyStore().AddKey(remotePeerKey, masterSecret, conv->peerState->authorizations);
+        }
+    }
+    if (status != ER_OK) {
+        return AuthAttemptDone(conv, status);
+    }
+    return SendAuthChallenge(conv);
+}
 
+QStatus AllJoynPeerObj::AuthAttemptDone(shared_ptr<AuthConversation> conv, QStatus status)
+{
+    if (conv->peerState->IsSecure()) {
+        return SendExchangeGroupKeys(conv, ER_OK);  /* there is a concurrent key exchange that completes */
+    }
+    if (status != ER_OK) {
+        return SendExchangeGroupKeys(conv, status);
+    }
     /*
-     * Initiaize the SASL engine as responder (i.e. client) this terminology seems backwards but
-     * is the terminology used by the DBus specification.
+     * The authentication established a master secret, generate the session key from it.
      */
-    SASLEngine sasl(*bus, ajn::AuthMechanism::RESPONDER, peerAuthMechanisms, busName.c_str(), peerAuthListener);
-    sasl.SetLocalId(localGuidStr);
-    peerState->AddKeyExchangeModeMask(_PeerState::KEY_EXCHANGE_INITIATOR);
+    return SendGenSessionKey(conv);
+}
+
+QStatus AllJoynPeerObj::SendExchangeGroupKeys(shared_ptr<AuthConversation> conv, QStatus status)
+{
     /*
-     * This will let us know if we need to make an AuthenticationComplete callback below.
+     * At this point, the authentication conversation is over and we no longer need
+     * to keep the conversation hash.
      */
-    qcc::String inStr;
-    qcc::String outStr;
-    status = sasl.Advance(inStr, outStr, authState);
-    while (status == ER_OK) {
-        Message replyMsg(*bus);
-        MsgArg arg("s", outStr.c_str());
-        const InterfaceDescription::Member* authChallengeMember = ifc->GetMember("AuthChallenge");
-        QCC_ASSERT(authChallengeMember);
-        status = remotePeerObj.MethodCall(*authChallengeMember, &arg, 1, replyMsg, AUTH_TIMEOUT);
-        if (status == ER_OK) {
-            /*
-             * This will let us know if we need to make an AuthenticationComplete callback below.
-             */
-            if (authState == SASLEngine::ALLJOYN_AUTH_SUCCESS) {
-                SetRights(peerState, sasl.AuthenticationIsMutual(), false /*responder*/);
-                break;
-            }
-            inStr = qcc::String(replyMsg->GetArg(0)->v_string.str);
-            status = sasl.Advance(inStr, outStr, authState);
+    conv->FreeConversationHash();
 
-            mech = sasl.GetMechanism();
-            if ((authState == SASLEngine::ALLJOYN_AUTH_SUCCESS) && (!peerState->IsSecure())) {
-                KeyBlob masterSecret;
-                status = sasl.GetMasterSecret(masterSecret);
-                if (status == ER_OK) {
-                    SetRights(peerState, sasl.AuthenticationIsMutual(), false /*responder*/);
-                    /* Tag the master secret with the auth mechanism used to generate it */
-                    masterSecret.SetTag(mech, KeyBlob::INITIATOR);
-                    status = bus->GetInternal().GetKeyStore().AddKey(remotePeerKey, masterSecret, peerState->authorizations);
-                }
-            }
-        } else {
-            status = ER_AUTH_FAIL;
-        }
+    if ((status != ER_OK) || !conv->needGenGroupKey) {
+        return status;
     }
-    return status;
+    /*
+     * Exchange group keys with the remote peer. This method call is encrypted using the session key
+     * that we just established.
+     */
+    uint8_t keyGenVersion = conv->authVersion & 0xFF;
+    uint16_t authV = conv->authVersion >> 16;
+    conv->sendKeyBlob = (authV <= 1) && (keyGenVersion == 0);
+    KeyBlob key;
+    bus->GetInternal().GetPeerStateTable()->GetGroupKey(key);
+    StringSink snk;
+    MsgArg arg;
+    /*
+     * KeyGen version 0 exchanges key blobs, version 1 just exchanges the key
+     */
+    QCC_DbgHLPrintf(("ExchangeGroupKeys using key gen version %d", keyGenVersion));
+    if (conv->sendKeyBlob) {
+        key.Store(snk);
+        arg.Set("ay", snk.GetString().size(), snk.GetString().data());
+    } else {
+        arg.Set("ay", key.GetSize(), key.GetData());
+    }
+    return SendConversationCall(conv, AUTH_STEP_EXCHANGE_GROUP_KEYS, "ExchangeGroupKeys", &arg, 1, DEFAULT_TIMEOUT, ALLJOYN_FLAG_ENCRYPTED);
 }
 
-QStatus AllJoynPeerObj::AskForAuthSuites(uint32_t peerAuthVersion, ProxyBusObject& remotePeerObj, const InterfaceDescription* ifc, uint32_t** remoteAuthSuites, size_t* remoteAuthCount, PeerState peerState)
+QStatus AllJoynPeerObj::ExchangeGroupKeysReply(shared_ptr<AuthConversation> conv, Message& reply, QStatus status)
 {
-    if (supportedAuthSuitesCount == 0) {
-        return ER_AUTH_FAIL;
+    if (status != ER_OK) {
+        return status;
     }
-    MsgArg arg;
-    bool excludeECDHE_ECDSA = false;
-    if ((peerAuthVersion >> 16) <= NON_ECDSA_X509_VERSION) {
-        for (size_t cnt = 0; cnt < supportedAuthSuitesCount; cnt++) {
-            if (supportedAuthSuites[cnt] == AUTH_SUITE_ECDHE_ECDSA) {
-                excludeECDHE_ECDSA = true;
-                break;
-            }
-        }
+    KeyBlob key;
+    if (conv->sendKeyBlob) {
+        StringSource src(reply->GetArg(0)->v_scalarArray.v_byte, reply->GetArg(0)->v_scalarArray.numElements);
+        status = key.Load(src);
+    } else {
+        status = key.Set(reply->GetArg(0)->v_scalarArray.v_byte, reply->GetArg(0)->v_scalarArray.numElements, KeyBlob::AES);
     }
-    uint32_t* authSuites = supportedAuthSuites;
-    size_t authSuitesCount = supportedAuthSuitesCount;
-    if (excludeECDHE_ECDSA) {
-        authSuites = new uint32_t[supportedAuthSuitesCount];
-        size_t netCnt = 0;
-        for (size_t cnt = 0; cnt < supportedAuthSuitesCount; cnt++) {
-            if (supportedAuthSuites[cnt] != AUTH_SUITE_ECDHE_ECDSA) {
-                authSuites[netCnt++] = supportedAuthSuites[cnt];
-            }
+    if (status != ER_OK) {
+        return status;
+    }
+    /*
+     * Tag the group key with the auth mechanism used by ExchangeGroupKeys. Group keys
+     * are inherently directional - only initiator encrypts with the group key. We set
+     * the role to NO_ROLE otherwise senders can't decrypt their own broadcast messages.
+     */
+    key.SetTag(reply->GetAuthMechanism(), KeyBlob::NO_ROLE);
+    conv->peerState->SetKey(key, PEER_GROUP_KEY);
+    /* exchange membership guilds */
+    if (conv->useKeyExchanger && IsMembershipCertCapable(conv->peerState->GetAuthVersion())) {
+        bool sendManifests = false;
+        if (conv->mech == "ALLJOYN_ECDHE_ECDSA") {
+            sendManifests = true;
+        } else if (conv->mech.empty()) {
+            /* key exchange step was skipped.
+               Send manifest if the local peer already cached the
+               remote peer's public key */
+            ECCPublicKey pubKey;
+            QStatus aStatus = securityApplicationObj.GetConnectedPeerPublicKey(conv->peerState->GetGuid(), &pubKey);
+            sendManifests = (ER_OK == aStatus);
+        }
+        if (sendManifests) {
+            return SendManifests(conv);
         }
-        authSuitesCount = netCnt;
     }
+    return status;
+}
 
-    arg.Set("au", authSuitesCount, authSuites);
-    Message callMsg(*bus);
-    Message replyMsg(*bus);
-    const InterfaceDescription::Member* exchangeSuites = ifc->GetMember("ExchangeSuites");
-    QCC_ASSERT(exchangeSuites);
-
-    QStatus status = remotePeerObj.MethodCall(*exchangeSuites, &arg, 1, replyMsg, DEFAULT_TIMEOUT, 0, &callMsg);
-    if (excludeECDHE_ECDSA) {
-        delete [] authSuites;
+QStatus AllJoynPeerObj::SendManifests(shared_ptr<AuthConversation> conv)
+{
+    bool sendManifests = false;
+    QStatus status = securityApplicationObj.SelectManifestsToSend(conv->peerState, (conv->msg->GetType() != MESSAGE_INVALID) ? &conv->msg : nullptr, conv->manifestsSent, sendManifests);
+    if (status != ER_OK) {
+        return status;
     }
+    if (!sendManifests) {
+        return SendMembershipData(conv);
+    }
+    MsgArg arg;
+    status = _Manifest::GetArrayMsgArg(conv->manifestsSent, arg);
     if (status != ER_OK) {
         return status;
     }
-    bool initiatorFlag = true;
-    peerState->AcquireConversationHashLock(initiatorFlag);
-    peerState->UpdateHash(initiatorFlag, CONVERSATION_V4, callMsg);
-    peerState->UpdateHash(initiatorFlag, CONVERSATION_V4, replyMsg);
-    peerState->ReleaseConversationHashLock(initiatorFlag);
-    uint32_t* remoteSuites;
-    size_t remoteSuitesLen;
+    return SendConversationCall(conv, AUTH_STEP_SEND_MANIFESTS, "SendManifests", &arg, 1, DEFAULT_TIMEOUT);
+}
 
-    status = replyMsg->GetArg(0)->Get("au", &remoteSuitesLen, &remoteSuites);
+QStatus AllJoynPeerObj::SendManifestsReply(shared_ptr<AuthConversation> conv, Message& reply, QStatus status)
+{
     if (status != ER_OK) {
         return status;
     }
-    *remoteAuthCount = remoteSuitesLen;
-    uint32_t* effectiveAuthSuites = new uint32_t[remoteSuitesLen];
-    for (size_t cnt = 0; cnt < remoteSuitesLen; cnt++) {
-        effectiveAuthSuites[cnt] = remoteSuites[cnt];
+    status = securityApplicationObj.SendManifestsReply(reply, conv->peerState, conv->manifestsSent);
+    if (status != ER_OK) {
+        return status;
     }
-    *remoteAuthSuites = effectiveAuthSuites;
-    return ER_OK;
+    return SendMembershipData(conv);
 }
 
-QStatus AllJoynPeerObj::AuthenticatePeerUsingKeyExchange(const uint32_t* requestingAuthList, size_t requestingAuthCount, const qcc::String& busName, PeerState peerState, qcc::String& localGuidStr, ProxyBusObject& remotePeerObj, const InterfaceDescription* ifc, qcc::String& mech)
+void AllJoynPeerObj::FinishConversation(shared_ptr<AuthConversation> conv, QStatus status)
 {
-    QStatus status;
-
-    QCC_DbgHLPrintf(("AuthenticatePeerUsingKeyExchange"));
-    bool initiatorFlag = true;
-    shared_ptr<KeyExchanger> keyExchanger = GetKeyExchangerInstance(peerState, initiatorFlag, requestingAuthList, requestingAuthCount);  /* initiator */
-    if (!keyExchanger) {
-        return ER_AUTH_FAIL;
-    }
-    uint32_t remoteAuthMask = 0;
-    uint32_t currentSuite = keyExchanger->GetSuite();
-    mech = keyExchanger->GetSuiteName();
-    KeyExchangerCB kxCB(remotePeerObj, ifc, AUTH_TIMEOUT);
-    status = keyExchanger->ExecKeyExchange(currentSuite, kxCB, &remoteAuthMask);
-
-    if ((status == ER_OK) && (remoteAuthMask == currentSuite)) {
-        uint8_t authorized = false;
-        status = keyExchanger->KeyAuthentication(kxCB, busName.c_str(), &authorized);
-        if (authorized) {
-            if (!peerState->IsSecure()) {
-                SetRights(peerState, true, false /*responder*/);
-                status = RecordMasterSecret(busName, keyExchanger, peerState);
-                QCC_DbgHLPrintf(("AuthenticatePeerUsingKeyExchange records master secret for peer %s", peerState->GetGuid().ToString().c_str()));
-            } else {
-                QCC_DbgHLPrintf(("AuthenticatePeerUsingKeyExchange does not record master secret for peer %s", peerState->GetGuid().ToString().c_str()));
-            }
-        } else {
-            status = ER_AUTH_FAIL;
-        }
-    } else if (status == ER_OK) {
-        status = ER_AUTH_FAIL; /* remote auth mask is 0 */
+    lock.Lock(MUTEX_CONTEXT);
+    if (conv->finished) {
+        lock.Unlock(MUTEX_CONTEXT);
+        return;
     }
+    conv->finished = true;
+    lock.Unlock(MUTEX_CONTEXT);
 
-    if (status == ER_OK) {
-        QCC_ASSERT(currentSuite != 0);
-        return status;
+    conv->FreeConversationHash();
+    /*
+     * If an authentication was tried report the authentication completion to allow application to clear UI etc.
+     */
+    if (conv->authTried) {
+        peerAuthListener.AuthenticationComplete(conv->mech.c_str(), conv->sender.c_str(), status == ER_OK);
     }
-    if (!remoteAuthMask) {
-        return ER_AUTH_FAIL; /* done */
+    /*
+     * ER_BUS_REPLY_IS_ERROR_MESSAGE has a specific meaning in the public API an should not be
+     * propogated to the caller from this context.
+     */
+    if (status == ER_BUS_REPLY_IS_ERROR_MESSAGE) {
+        status = ER_AUTH_FAIL;
     }
-    if (requestingAuthCount == 1) {
-        return ER_AUTH_FAIL; /* done.  There is no more to try. */
+    /*
+     * Release any other threads waiting on the result of this authentication.
+     */
+    std::vector<shared_ptr<AuthConversation> > followers;
+    lock.Lock(MUTEX_CONTEXT);
+    if (conv->peerState->GetAuthEvent() == &conv->authEvent) {
+        conv->peerState->NotifyAuthEvent();
+        conv->peerState->SetAuthEvent(NULL);
     }
-    size_t smallerCount = requestingAuthCount - 1;
-    uint32_t* smallerSuites = new uint32_t[smallerCount];
-    size_t idx = 0;
-    for (size_t cnt = 0; cnt < requestingAuthCount; cnt++) {
-        if ((requestingAuthList[cnt] & currentSuite) != currentSuite) {
-            QCC_ASSERT(idx < smallerCount);
-            if (idx >= smallerCount) {
-                delete [] smallerSuites;
-                return ER_AUTH_FAIL;
+    authConversations.erase(conv->id);
+    followers.swap(conv->followers);
+    conv->status = status;
+    lock.Unlock(MUTEX_CONTEXT);
+    conv->done.SetEvent();
+
+    if (!conv->synchronous) {
+        if (conv->reqType == AUTHENTICATE_PEER) {
+            if (status != ER_WOULDBLOCK) {
+                DeliverMessagesPendingAuth(conv->msg, status);
             }
-            smallerSuites[idx++] = requestingAuthList[cnt];
+        } else if ((status != ER_OK) && (status != ER_WOULDBLOCK)) {
+            peerAuthListener.SecurityViolation(status, conv->msg);
         }
     }
-    if ((peerState->GetAuthVersion() >> 16) < CONVERSATION_V4) {
-        /* any peer with auth version smaller than 4 need to start the hash at
-         * the KeyExchange call */
-        peerState->AcquireConversationHashLock(initiatorFlag);
-        peerState->InitializeConversationHash(initiatorFlag);
-        peerState->ReleaseConversationHashLock(initiatorFlag);
+    for (size_t i = 0; i < followers.size(); ++i) {
+        FinishConversation(followers[i], conv->peerState->IsSecure() ? ER_OK : ER_AUTH_FAIL);
     }
-    status = AuthenticatePeerUsingKeyExchange(smallerSuites, smallerCount, busName, peerState, localGuidStr, remotePeerObj, ifc, mech);
-    delete [] smallerSuites;
-    return status;
 }
 
 QStatus AllJoynPeerObj::AuthenticatePeerAsync(const qcc::String& busName)
@@ -1608,15 +1931,20 @@ QStatus AllJoynPeerObj::AuthenticatePeerAsync(const qcc::String& busName)
     return DispatchRequest(invalidMsg, SECURE_CONNECTION, busName);
 }
 
-QStatus AllJoynPeerObj::DispatchRequest(Message& msg, RequestType reqType, const qcc::String data)
+QStatus AllJoynPeerObj::DispatchRequest(Message& msg, RequestType reqType, const qcc::String data, uint32_t conversationId)
 {
     QStatus status;
     QCC_DbgHLPrintf(("DispatchRequest %s", msg->Description().c_str()));
+    /*
+     * Replies to our own authentication conversations are dispatched separately so they can't be
+     * stuck behind requests that are waiting for those conversations to complete.
+     */
+    qcc::Timer& timer = (reqType == AUTH_CONVERSATION) ? conversationDispatcher : dispatcher;
     lock.Lock(MUTEX_CONTEXT);
-    if (dispatcher.IsRunning()) {
-        Request* req = new Request(msg, reqType, data);
+    if (timer.IsRunning()) {
+        Request* req = new Request(msg, reqType, data, conversationId);
         qcc::AlarmListener* alljoynPeerListener = this;
-        status = dispatcher.AddAlarm(Alarm(alljoynPeerListener, req));
+        status = timer.AddAlarm(Alarm(alljoynPeerListener, req));
         if (status != ER_OK) {
             delete req;
         }
@@ -1627,11 +1955,59 @@ QStatus AllJoynPeerObj::DispatchRequest(Message& msg, RequestType reqType, const
     return status;
 }
 
-void AllJoynPeerObj::AlarmTriggered(const Alarm& alarm, QStatus reason)
+void AllJoynPeerObj::DeliverMessagesPendingAuth(Message& trigger, QStatus status)
 {
-    QCC_UNUSED(reason);
+    PeerStateTable* peerStateTable = bus->GetInternal().GetPeerStateTable();
+    /*
+     * Check each message that is queued waiting for an authentication to complete
+     * to see if this is the authentication the message was waiting for.
+     */
+    lock.Lock(MUTEX_CONTEXT);
+    std::deque<Message>::iterator iter = msgsPendingAuth.begin();
+    while (iter != msgsPendingAuth.end()) {
+        Message msg = *iter;
+        if (peerStateTable->IsAlias(msg->GetDestination(), trigger->GetDestination())) {
+            if (status != ER_OK) {
+                /*
+                 * If the failed message was a method call push an error response.
+                 */
+                if (msg->GetType() == MESSAGE_METHOD_CALL) {
+                    Message reply(*bus);
+                    reply->ErrorMsg(status, msg->GetCallSerial());
+                    bus->GetInternal().GetLocalEndpoint()->PushMessage(reply);
+                }
+            } else {
+                if (msg->GetType() == MESSAGE_METHOD_CALL) {
+                    bus->GetInternal().GetLocalEndpoint()->ResumeReplyHandlerTimeout(msg);
+                }
+                BusEndpoint busEndpoint = BusEndpoint::cast(bus->GetInternal().GetLocalEndpoint());
+                status = bus->GetInternal().GetRouter().PushMessage(msg, busEndpoint);
+                if (status == ER_PERMISSION_DENIED) {
+                    if (trigger->GetType() == MESSAGE_METHOD_CALL) {
+                        Message reply(*bus);
+                        reply->ErrorMsg(status, trigger->GetCallSerial());
+                        bus->GetInternal().GetLocalEndpoint()->PushMessage(reply);
+                    }
+                }
+            }
+            iter = msgsPendingAuth.erase(iter);
+        } else {
+            iter++;
+        }
+    }
+    lock.Unlock(MUTEX_CONTEXT);
+    /*
+     * Report a single error for the message the triggered the authentication
+     */
+    if (status != ER_OK) {
+        peerAuthListener.SecurityViolation(status, trigger);
+    }
+}
 
+void AllJoynPeerObj::AlarmTriggered(const Alarm& alarm, QStatus reason)
+{
     QStatus status;
+    shared_ptr<AuthConversation> conv;
 
     QCC_ASSERT(bus);
     QCC_DbgHLPrintf(("AllJoynPeerObj::AlarmTriggered"));
@@ -1652,54 +2028,12 @@ void AllJoynPeerObj::AlarmTriggered(const Alarm& alarm, QStatus reason)
         if (req->msg->GetType() == MESSAGE_METHOD_CALL) {
             bus->GetInternal().GetLocalEndpoint()->PauseReplyHandlerTimeout(req->msg);
         }
-        status = AuthenticatePeer(req->msg->GetType(), req->msg->GetDestination(), false, &req->msg);
-        if (status != ER_WOULDBLOCK) {
-            PeerStateTable* peerStateTable = bus->GetInternal().GetPeerStateTable();
-            /*
-             * Check each message that is queued waiting for an authentication to complete
-             * to see if this is the authentication the message was waiting for.
-             */
-            lock.Lock(MUTEX_CONTEXT);
-            std::deque<Message>::iterator iter = msgsPendingAuth.begin();
-            while (iter != msgsPendingAuth.end()) {
-                Message msg = *iter;
-                if (peerStateTable->IsAlias(msg->GetDestination(), req->msg->GetDestination())) {
-                    LocalEndpoint lep =  bus->GetInternal().GetLocalEndpoint();
-                    if (status != ER_OK) {
-                        /*
-                         * If the failed message was a method call push an error response.
-                         */
-                        if (msg->GetType() == MESSAGE_METHOD_CALL) {
-                            Message reply(*bus);
-                            reply->ErrorMsg(status, msg->GetCallSerial());
-                            bus->GetInternal().GetLocalEndpoint()->PushMessage(reply);
-                        }
-                    } else {
-                        if (msg->GetType() == MESSAGE_METHOD_CALL) {
-                            bus->GetInternal().GetLocalEndpoint()->ResumeReplyHandlerTimeout(msg);
-                        }
-                        BusEndpoint busEndpoint = BusEndpoint::cast(bus->GetInternal().GetLocalEndpoint());
-                        status = bus->GetInternal().GetRouter().PushMessage(msg, busEndpoint);
-                        if (status == ER_PERMISSION_DENIED) {
-                            if (req->msg->GetType() == MESSAGE_METHOD_CALL) {
-                                Message reply(*bus);
-                                reply->ErrorMsg(status, req->msg->GetCallSerial());
-                                bus->GetInternal().GetLocalEndpoint()->PushMessage(reply);
-                            }
-                        }
-                    }
-                    iter = msgsPendingAuth.erase(iter);
-                } else {
-                    iter++;
-                }
-            }
-            lock.Unlock(MUTEX_CONTEXT);
-            /*
-             * Report a single error for the message the triggered the authentication
-             */
-            if (status != ER_OK) {
-                peerAuthListener.SecurityViolation(status, req->msg);
-            }
+        /*
+         * A conversation that is started delivers the queued messages when it finishes.
+         */
+        status = StartConversation(req->msg->GetType(), req->msg->GetDestination(), req->msg, AUTHENTICATE_PEER, false, false, conv);
+        if ((status != ER_WOULDBLOCK) && (status != ER_BUS_AUTHENTICATION_PENDING)) {
+            DeliverMessagesPendingAuth(req->msg, status);
         }
         break;
 
@@ -1716,12 +2050,16 @@ void AllJoynPeerObj::AlarmTriggered(const Alarm& alarm, QStatus reason)
         break;
 
     case SECURE_CONNECTION:
-        status = AuthenticatePeer(MESSAGE_METHOD_CALL, req->data, true);
-        if (status != ER_OK) {
+        status = StartConversation(MESSAGE_METHOD_CALL, req->data, req->msg, SECURE_CONNECTION, false, false, conv);
+        if ((status != ER_OK) && (status != ER_WOULDBLOCK) && (status != ER_BUS_AUTHENTICATION_PENDING)) {
             peerAuthListener.SecurityViolation(status, req->msg);
         }
         break;
 
+    case AUTH_CONVERSATION:
+        ResumeConversation(req->conversationId, req->msg, reason);
+        break;
+
     }
 
     delete req;
@@ -1913,20 +2251,6 @@ QStatus AllJoynPeerObj::HandleMethodReply(Message& msg, Message& replyMsg, const
     return MethodReply(msg, args, numArgs, &replyMsg);
 }
 
-QStatus KeyExchangerCB::SendKeyExchange(MsgArg* args, size_t numArgs, Message* sentMsg, Message* replyMsg)
-{
-    const InterfaceDescription::Member* keyExchange = ifc->GetMember("KeyExchange");
-    QCC_ASSERT(keyExchange);
-    return remoteObj.MethodCall(*keyExchange, args, numArgs, *replyMsg, timeout, 0, sentMsg);
-}
-
-QStatus KeyExchangerCB::SendKeyAuthentication(MsgArg* msg, Message* sentMsg, Message* replyMsg)
-{
-    const InterfaceDescription::Member* keyAuth = ifc->GetMember("KeyAuthentication");
-    QCC_ASSERT(keyAuth);
-    return remoteObj.MethodCall(*keyAuth, msg, 1, *replyMsg, timeout, 0, sentMsg);
-}
-
 class SortableAuthSuite {
   public:
     SortableAuthSuite(uint8_t weight, uint32_t suite) : weight(weight), suite(suite)
@@ -2224,49 +2548,50 @@ Exit:
     return status;
 }
 
-QStatus AllJoynPeerObj::SendMembershipData(ProxyBusObject& remotePeerObj, const InterfaceDescription* ifc, const qcc::GUID128& remotePeerGuid)
+QStatus AllJoynPeerObj::SendMembershipData(shared_ptr<AuthConversation> conv)
 {
-    std::vector<std::vector<MsgArg*> > args;
-    QStatus status = securityApplicationObj.GenerateSendMemberships(args, remotePeerGuid);
+    QStatus status = securityApplicationObj.GenerateSendMemberships(conv->membershipArgs, conv->remotePeerGuid);
     if (ER_OK != status) {
         return status;
     }
-    size_t argCount = args.size();
+    conv->membershipsSent = 0;
+    return SendNextMembership(conv);
+}
 
-    Message replyMsg(*bus);
-    const InterfaceDescription::Member* sendMembershipData = ifc->GetMember("SendMemberships");
+QStatus AllJoynPeerObj::SendNextMembership(shared_ptr<AuthConversation> conv)
+{
+    size_t argCount = conv->membershipArgs.size();
+    MsgArg inputs[2];
+    QStatus status;
+    if (conv->membershipsSent == argCount) {
+        std::vector<MsgArg*> emptyArgs;
+        status = SetUpSendMembershipInput(emptyArgs, conv->membershipsSent, argCount, inputs, 2);
+    } else {
+        status = SetUpSendMembershipInput(conv->membershipArgs[conv->membershipsSent], conv->membershipsSent, argCount, inputs, 2);
+    }
+    /* membershipsSent is updated by SetUpSendMembershipInput */
+    if (ER_OK != status) {
+        return status;
+    }
+    return SendConversationCall(conv, AUTH_STEP_SEND_MEMBERSHIPS, "SendMemberships", inputs, 2, DEFAULT_TIMEOUT);
+}
 
+QStatus AllJoynPeerObj::SendMembershipsReply(shared_ptr<AuthConversation> conv, Message& reply, QStatus status)
+{
+    if (ER_OK != status) {
+        return status;
+    }
+    /* process the reply */
     bool gotAllFromPeer = false;
-    uint8_t cnt = 0;
-    while (true) {
-        MsgArg inputs[2];
-        if (cnt == argCount) {
-            std::vector<MsgArg*> emptyArgs;
-            status = SetUpSendMembershipInput(emptyArgs, cnt, argCount, inputs, 2);
-        } else {
-            status = SetUpSendMembershipInput(args[cnt], cnt, argCount, inputs, 2);
-        }
-        /* cnt is updated by SetUpSendMembershipInput */
-        if (ER_OK != status) {
-            goto Exit;
-        }
-        status = remotePeerObj.MethodCall(*sendMembershipData, inputs, 2, replyMsg, DEFAULT_TIMEOUT);
-        if (ER_OK != status) {
-            goto Exit;
-        }
-        /* process the reply */
-        status = securityApplicationObj.ParseSendMemberships(replyMsg, gotAllFromPeer);
-        if (ER_OK != status) {
-            goto Exit;
-        }
-        if (gotAllFromPeer && (cnt == argCount)) {
-            break;
-        }
+    status = securityApplicationObj.ParseSendMemberships(reply, gotAllFromPeer);
+    if (ER_OK != status) {
+        return status;
     }
-
-Exit:
-    _PeerState::ClearGuildArgs(args);
-    return status;
+    if (gotAllFromPeer && (conv->membershipsSent == conv->membershipArgs.size())) {
+        _PeerState::ClearGuildArgs(conv->membershipArgs);
+        return ER_OK;
+    }
+    return SendNextMembership(conv);
 }
 
 void AllJoynPeerObj::SendMemberships(const InterfaceDescription::Member* member, Message& msg)
@@ -54,6 +54,7 @@
 #include "PeerState.h"
 #include "AuthMechanism.h"
 #include "KeyExchanger.h"
+#include "ECDHEKeyPool.h"
 #include "SecurityApplicationObj.h"
 
 namespace ajn {
@@ -131,6 +132,8 @@ class AllJoynPeerObj : public BusObject, public BusListener, public qcc::AlarmLi
 
     /**
      * Authenticate the connection to a remote peer. Authentication establishes a session key with a remote peer.
+     * The conversation with the peer runs on the peer object's conversation dispatcher, the calling
+     * thread only waits for its result.
      *
      * @param msgType   Message type we're trying to send.
      * @param busName   The bus name of the remote peer we are securing.
@@ -252,6 +255,13 @@ class AllJoynPeerObj : public BusObject, public BusListener, public qcc::AlarmLi
      */
     QStatus HandleMethodReply(Message& msg, Message& sentMsg, const MsgArg* args = NULL, size_t numArgs = 0);
 
+    /**
+     * Get the pool of pre-generated ECDHE key pairs used by the key exchangers.
+     *
+     * @return The ECDHE key pool.
+     */
+    ECDHEKeyPool& GetECDHEKeyPool() { return ecdheKeyPool; }
+
     /**
      * Destructor
      */
@@ -267,7 +277,8 @@ class AllJoynPeerObj : public BusObject, public BusListener, public qcc::AlarmLi
         AUTH_CHALLENGE,
         SECURE_CONNECTION,
         KEY_EXCHANGE,
-        KEY_AUTHENTICATION
+        KEY_AUTHENTICATION,
+        AUTH_CONVERSATION
     } RequestType;
 
     /* Dispatcher context */
@@ -275,11 +286,30 @@ class AllJoynPeerObj : public BusObject, public BusListener, public qcc::AlarmLi
         Message msg;
         RequestType reqType;
         const qcc::String data;
-        Request(const Message& msg, RequestType type, const qcc::String& data) : msg(msg), reqType(type), data(data) { }
+        uint32_t conversationId;
+        Request(const Message& msg, RequestType type, const qcc::String& data, uint32_t conversationId) : msg(msg), reqType(type), data(data), conversationId(conversationId) { }
       private:
         Request& operator=(const Request& other);
     };
 
+    /**
+     * The method call an authentication conversation started by this peer is waiting on.
+     */
+    typedef enum {
+        AUTH_STEP_EXCHANGE_GUIDS,
+        AUTH_STEP_GEN_SESSION_KEY,
+        AUTH_STEP_EXCHANGE_SUITES,
+        AUTH_STEP_KEY_EXCHANGE,
+        AUTH_STEP_KEY_AUTHENTICATION,
+        AUTH_STEP_AUTH_CHALLENGE,
+        AUTH_STEP_EXCHANGE_GROUP_KEYS,
+        AUTH_STEP_SEND_MANIFESTS,
+        AUTH_STEP_SEND_MEMBERSHIPS
+    } AuthStep;
+
+    /* An authentication conversation started by this peer */
+    struct AuthConversation;
+
     /**
      * ExchangeGuids method call handler
      *
@@ -415,8 +445,9 @@ class AllJoynPeerObj : public BusObject, public BusListener, public qcc::AlarmLi
      * @param msg       Message to be dispatched.
      * @param reqType   Type of AllJoynPeerObj request.
      * @param data      Optional reqType specific data.
+     * @param conversationId  Authentication conversation to resume for AUTH_CONVERSATION requests.
      */
-    QStatus DispatchRequest(Message& msg, AllJoynPeerObj::RequestType reqType, const qcc::String data = "");
+    QStatus DispatchRequest(Message& msg, AllJoynPeerObj::RequestType reqType, const qcc::String data = "", uint32_t conversationId = 0);
 
     /**
      * Record the master secret.
@@ -427,25 +458,104 @@ class AllJoynPeerObj : public BusObject, public BusListener, public qcc::AlarmLi
     QStatus RecordMasterSecret(const qcc::String& sender, std::shared_ptr<KeyExchanger> keyExchanger, PeerState peerState);
 
     /**
-     * Ask for remote authentication suites.
-     * @param peerAuthVersion the authentication version used for this session
-     * @param remotePeerObj the remote peer object
-     * @param ifc the interface object
-     * @param remoteAuthSuites the buffer to store the remote auth suites
-     * @param remoteAuthCount the buffer to receive the number of suites stored in remoteAuthSuites
-     * @param peerState the remote peer's PeerState object
+     * Start an authentication conversation with a remote peer.
+     *
+     * @param msgType      Message type we're trying to send.
+     * @param busName      The bus name of the remote peer we are securing.
+     * @param msg          The message that triggered the authentication, may be invalid.
+     * @param reqType      AUTHENTICATE_PEER or SECURE_CONNECTION, determines how the result of an
+     *                     asynchronous conversation is reported.
+     * @param synchronous  True if the caller waits on the conversation.
+     * @param wait         A synchronous caller waits if the peer is already being authenticated.
+     * @param[out] conv    The conversation that was started.
+     *
+     * @return
+     *      - ER_BUS_AUTHENTICATION_PENDING if the conversation was started, its result is in conv
+     *        when it is done.
+     *      - ER_OK if the peer is already secure.
+     *      - ER_WOULDBLOCK if the peer is being authenticated by another conversation that will
+     *        report the result.
+     *      - An error status otherwise
+     */
+    QStatus StartConversation(AllJoynMessageType msgType, const qcc::String& busName, const Message& msg, RequestType reqType, bool synchronous, bool wait, std::shared_ptr<AuthConversation>& conv);
+
+    /**
+     * Attach a conversation to the conversation that is already authenticating the peer, it
+     * completes with that conversation. Must be called holding the lock.
+     *
+     * @return true if the conversation was attached.
      */
-    QStatus AskForAuthSuites(uint32_t peerAuthVersion, ProxyBusObject& remotePeerObj, const InterfaceDescription* ifc, uint32_t** remoteAuthSuites, size_t* remoteAuthCount, PeerState peerState);
+    bool FollowConversation(std::shared_ptr<AuthConversation> conv, PeerState& peerState);
 
     /**
-     * Authenticate Peer using SASL protocol
+     * Make the next method call of an authentication conversation. The conversation must not be
+     * touched after the call was sent, the reply may already be running on another thread.
+     *
+     * @return
+     *      - ER_BUS_AUTHENTICATION_PENDING if the method call was sent.
+     *      - An error status otherwise
      */
-    QStatus AuthenticatePeerUsingSASL(const qcc::String& busName, PeerState peerState, qcc::String& localGuidStr, ProxyBusObject& remotePeerObj, const InterfaceDescription* ifc, KeyStore::Key& remotePeerKey, qcc::String& mech);
+    QStatus SendConversationCall(std::shared_ptr<AuthConversation> conv, AuthStep step, const char* member, const MsgArg* args, size_t numArgs, uint32_t timeout, uint8_t flags = 0);
 
     /**
-     * Authenticate Peer using new Key Exchanger protocol for ECDHE auths
+     * Reply handler for the method calls of authentication conversations.
+     *
+     * @param reply    The reply message.
+     * @param context  The conversation id.
      */
-    QStatus AuthenticatePeerUsingKeyExchange(const uint32_t* requestingAuthList, size_t requestingAuthCount, const qcc::String& busName, PeerState peerState, qcc::String& localGuidStr, ProxyBusObject& remotePeerObj, const InterfaceDescription* ifc, qcc::String& mech);
+    void ConversationReply(Message& reply, void* context);
+
+    /**
+     * Resume an authentication conversation on the conversation dispatcher.
+     *
+     * @param id      The conversation id.
+     * @param reply   The reply to the method call the conversation was waiting on.
+     * @param reason  ER_OK unless the dispatcher is exiting.
+     */
+    void ResumeConversation(uint32_t id, Message& reply, QStatus reason);
+
+    /**
+     * Steps of an authentication conversation. Each returns ER_BUS_AUTHENTICATION_PENDING if the
+     * conversation is waiting on a method call, or the result of the conversation.
+     */
+    QStatus ExchangeGuidsReply(std::shared_ptr<AuthConversation> conv, Message& reply, QStatus status);
+    QStatus SendGenSessionKey(std::shared_ptr<AuthConversation> conv);
+    QStatus GenSessionKeyReply(std::shared_ptr<AuthConversation> conv, Message& reply, QStatus status);
+    QStatus SessionKeyFailed(std::shared_ptr<AuthConversation> conv, QStatus status);
+    QStatus SendExchangeSuites(std::shared_ptr<AuthConversation> conv);
+    QStatus ExchangeSuitesReply(std::shared_ptr<AuthConversation> conv, Message& reply, QStatus status);
+    QStatus SendKeyExchange(std::shared_ptr<AuthConversation> conv);
+    QStatus KeyExchangeReply(std::shared_ptr<AuthConversation> conv, Message& reply, QStatus status);
+    QStatus KeyAuthenticationReply(std::shared_ptr<AuthConversation> conv, Message& reply, QStatus status);
+    QStatus KeyExchangeFailed(std::shared_ptr<AuthConversation> conv, QStatus status);
+    QStatus StartSASL(std::shared_ptr<AuthConversation> conv);
+    QStatus SendAuthChallenge(std::shared_ptr<AuthConversation> conv);
+    QStatus AuthChallengeReply(std::shared_ptr<AuthConversation> conv, Message& reply, QStatus status);
+    QStatus AuthAttemptDone(std::shared_ptr<AuthConversation> conv, QStatus status);
+    QStatus SendExchangeGroupKeys(std::shared_ptr<AuthConversation> conv, QStatus status);
+    QStatus ExchangeGroupKeysReply(std::shared_ptr<AuthConversation> conv, Message& reply, QStatus status);
+    QStatus SendManifests(std::shared_ptr<AuthConversation> conv);
+    QStatus SendManifestsReply(std::shared_ptr<AuthConversation> conv, Message& reply, QStatus status);
+    QStatus SendMembershipData(std::shared_ptr<AuthConversation> conv);
+    QStatus SendNextMembership(std::shared_ptr<AuthConversation> conv);
+    QStatus SendMembershipsReply(std::shared_ptr<AuthConversation> conv, Message& reply, QStatus status);
+
+    /**
+     * Complete an authentication conversation, release anyone waiting on it and report the result
+     * of an asynchronous conversation. Only the first call for a conversation has any effect.
+     *
+     * @param conv    The conversation.
+     * @param status  The result of the conversation.
+     */
+    void FinishConversation(std::shared_ptr<AuthConversation> conv, QStatus status);
+
+    /**
+     * Forward or fail the messages that were queued waiting for an authentication to complete.
+     *
+     * @param trigger  The message that triggered the authentication.
+     * @param status   The result of the authentication.
+     */
+    void DeliverMessagesPendingAuth(Message& trigger, QStatus status);
 
     /**
      * SendManifest method call handler
@@ -455,14 +565,6 @@ class AllJoynPeerObj : public BusObject, public BusListener, public qcc::AlarmLi
      */
     void HandleSendManifests(const InterfaceDescription::Member* member, Message& msg);
 
-    /**
-     * Send an SendMembership to the peer
-     * @param remotePeerObj  The remote peer
-     * @param ifc     The interface object
-     * @param remotePeerGuid The remote peer's authentication GUID
-     */
-    QStatus SendMembershipData(ProxyBusObject& remotePeerObj, const InterfaceDescription* ifc, const qcc::GUID128& remotePeerGuid);
-
     /**
      * SendMembership method call handler
      *
@@ -511,12 +613,26 @@ class AllJoynPeerObj : public BusObject, public BusListener, public qcc::AlarmLi
      */
     std::map<qcc::String, std::shared_ptr<KeyExchanger> > keyExConversations;
 
+    /**
+     * Authentication conversations started by this peer, by id
+     */
+    std::map<uint32_t, std::shared_ptr<AuthConversation> > authConversations;
+
+    /** Id of the next authentication conversation */
+    uint32_t nextConversationId;
+
     /** Short term lock to protect the peer object. */
     qcc::Mutex lock;
 
     /** Dispatcher for handling peer object requests */
     qcc::Timer dispatcher;
 
+    /**
+     * Dispatcher for resuming authentication conversations when their replies arrive. Kept apart
+     * from dispatcher since responder requests may block waiting on our own conversations.
+     */
+    qcc::Timer conversationDispatcher;
+
     /** Queue of encrypted messages waiting for an authentication to complete */
     std::deque<Message> msgsPendingAuth;
 
@@ -525,6 +641,9 @@ class AllJoynPeerObj : public BusObject, public BusListener, public qcc::AlarmLi
 
     /* PermissionMgmtObj to handle message permssion */
     SecurityApplicationObj securityApplicationObj;
+
+    /** Ephemeral key pairs for ECDHE key exchanges, generated ahead of the handshakes */
+    ECDHEKeyPool ecdheKeyPool;
 };
 
 
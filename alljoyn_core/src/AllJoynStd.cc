@@ -222,6 +222,7 @@ QStatus org::alljoyn::CreateInterfaces(BusAttachment& bus)
             return status;
         }
         QCC_VERIFY(ER_OK == ifc->AddMethod("SetDebugLevel",  "su", NULL, "module,level", 0));
+        QCC_VERIFY(ER_OK == ifc->AddMethod("GetLockProfile", "b",  "s",  "reset,profile", 0));
         ifc->Activate();
     }
     {
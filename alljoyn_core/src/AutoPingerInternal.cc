@@ -35,6 +35,7 @@
 #include <algorithm>
 #include <memory>
 #include <set>
+#include <vector>
 
 #define PING_TIMEOUT 5000
 
@@ -68,7 +69,7 @@ struct PingGroup {
               qcc::AlarmListener* alarmListener,
               void* context,
               PingListener& _pingListener) :
-        alarm(pingInterval, alarmListener, context, pingInterval), pingListener(_pingListener) { }
+        alarm(pingInterval, alarmListener, context, pingInterval), pingInterval(pingInterval), pingListener(_pingListener) { }
 
     ~PingGroup() {
         qcc::String* ctx = static_cast<qcc::String*>(alarm->GetContext());
@@ -79,6 +80,7 @@ struct PingGroup {
     }
 
     qcc::Alarm alarm;
+    uint32_t pingInterval; /* milliseconds */
     PingListener& pingListener;
     std::map<Destination, unsigned int> destinations;
   private:
@@ -89,25 +91,55 @@ struct PingGroup {
 class PingAsyncContext {
   public:
     PingAsyncContext(AutoPingerInternal* _pinger,
-                     const qcc::String& _group,
-                     const qcc::String& _destination,
-                     const AutoPingerInternal::PingState _oldState,
-                     PingListener& listener) :
-        pinger(_pinger), group(_group), destination(_destination), oldState(_oldState), pingListener(listener)  { }
+                     const qcc::String& _destination) :
+        pinger(_pinger), destination(_destination) { }
 
     AutoPingerInternal* pinger;
-    qcc::String group;
     qcc::String destination;
-    AutoPingerInternal::PingState oldState;
-    PingListener& pingListener;
+    std::set<qcc::String> groups; /* groups waiting for the outcome of this ping */
   private:
     PingAsyncContext& operator=(const PingAsyncContext&);
 };
 
+// Listener call collected under the global lock and made after releasing it
+struct PingNotification {
+    PingNotification(PingListener* _pingListener,
+                     const qcc::String& _group,
+                     const qcc::String& _destination,
+                     bool _found) :
+        pingListener(_pingListener), group(_group), destination(_destination), found(_found) { }
+
+    PingListener* pingListener;
+    qcc::String group;
+    qcc::String destination;
+    bool found;
+};
+
 static std::set<PingAsyncContext*>* ctxs = NULL;
 static qcc::Mutex* globalPingerLock = NULL;
 static bool callbackInProgress = false;
 
+/* called with global lock taken */
+static void DeliverNotifications(const std::vector<PingNotification>& notifications)
+{
+    if (notifications.empty()) {
+        return;
+    }
+
+    // call external listeners
+    callbackInProgress = true;
+    globalPingerLock->Unlock(MUTEX_CONTEXT);
+    for (std::vector<PingNotification>::const_iterator it = notifications.begin(); it != notifications.end(); ++it) {
+        if (it->found) {
+            it->pingListener->DestinationFound(it->group, it->destination);
+        } else {
+            it->pingListener->DestinationLost(it->group, it->destination);
+        }
+    }
+    globalPingerLock->Lock(MUTEX_CONTEXT);
+    callbackInProgress = false;
+}
+
 // Callback handler for async ping calls
 class AutoPingAsyncCB : public BusAttachment::PingAsyncCB {
   public:
@@ -123,37 +155,26 @@ class AutoPingAsyncCB : public BusAttachment::PingAsyncCB {
         }
 
         if (found) {
-            if (ctx->pinger->IsRunning() && !ctx->pinger->pausing) {
-                if (ER_OK != status) {
-                    if (ER_ALLJOYN_PING_REPLY_IN_PROGRESS != status) {
-                        if (ctx->oldState != AutoPingerInternal::LOST) {
-                            // update state
-                            if (ctx->pinger->UpdatePingStateOfDestination(ctx->group, ctx->destination, AutoPingerInternal::LOST)) {
-
-                                // call external listener
-                                callbackInProgress = true;
-                                globalPingerLock->Unlock(MUTEX_CONTEXT);
-                                ctx->pingListener.DestinationLost(ctx->group, ctx->destination);
-                                globalPingerLock->Lock(MUTEX_CONTEXT);
-                                callbackInProgress = false;
-                            }
-                        }
+            AutoPingerInternal* pinger = ctx->pinger;
+            std::map<qcc::String, PingAsyncContext*>::iterator fit = pinger->pingsInFlight.find(ctx->destination);
+            if ((fit != pinger->pingsInFlight.end()) && (fit->second == ctx)) {
+                pinger->pingsInFlight.erase(fit);
+            }
+
+            if (pinger->IsRunning() && !pinger->pausing) {
+                if (ER_ALLJOYN_PING_REPLY_IN_PROGRESS != status) {
+                    AutoPingerInternal::PingState state = (ER_OK == status) ? AutoPingerInternal::AVAILABLE : AutoPingerInternal::LOST;
+                    if (pinger->HasDestination(ctx->destination)) {
+                        pinger->pingResults[ctx->destination] = AutoPingerInternal::PingResult(state, qcc::GetTimestamp64());
                     }
-                } else {
-                    if (ctx->oldState != AutoPingerInternal::AVAILABLE) {
-                        // update state
-                        if (ctx->pinger->UpdatePingStateOfDestination(ctx->group, ctx->destination, AutoPingerInternal::AVAILABLE)) {
-
-                            // call external listener
-                            callbackInProgress = true;
-                            globalPingerLock->Unlock(MUTEX_CONTEXT);
-                            ctx->pingListener.DestinationFound(ctx->group, ctx->destination);
-                            globalPingerLock->Lock(MUTEX_CONTEXT);
-                            callbackInProgress = false;
-                        }
+
+                    // update state of every group that was waiting for this ping
+                    std::vector<PingNotification> notifications;
+                    for (std::set<qcc::String>::const_iterator git = ctx->groups.begin(); git != ctx->groups.end(); ++git) {
+                        pinger->ApplyPingResult(*git, ctx->destination, state, notifications);
                     }
+                    DeliverNotifications(notifications);
                 }
-
             } else {
                 QCC_DbgPrintf(("AutoPingerInternal: ignoring callback - pinger not running"));
             }
@@ -243,37 +264,91 @@ void AutoPingerInternal::AlarmTriggered(const qcc::Alarm& alarm, QStatus reason)
     globalPingerLock->Lock(MUTEX_CONTEXT);
     if ((false == pausing) && (NULL != groupName)) {
         // Ping all destination of the group
-        PingGroupDestinations(*groupName);
+        std::vector<PingNotification> notifications;
+        PingGroupDestinations(*groupName, notifications);
+        DeliverNotifications(notifications);
     }
     globalPingerLock->Unlock(MUTEX_CONTEXT);
 }
 
-void AutoPingerInternal::PingGroupDestinations(const qcc::String& group)
+void AutoPingerInternal::PingGroupDestinations(const qcc::String& group, std::vector<PingNotification>& notifications)
 {
     /* called with global lock taken */
     QCC_DbgPrintf(("AutoPingerInternal: start pinging destination in group: '%s'", group.c_str()));
     std::map<qcc::String, PingGroup*>::const_iterator it = pingGroups.find(group);
     if (it != pingGroups.end()) {
+        /* A reply that arrived within half a ping interval, most likely on behalf of another
+         * group, is recent enough to stand in for a ping of our own. */
+        uint64_t now = qcc::GetTimestamp64();
+        uint64_t maxAge = it->second->pingInterval / 2;
         std::map<Destination, unsigned int>::iterator mapIt = (*it).second->destinations.begin();
         for (; mapIt != (*it).second->destinations.end(); ++mapIt) {
-            PingDestination(group, mapIt->first.destination, mapIt->first.oldState, it->second->pingListener);
+            const qcc::String& destination = mapIt->first.destination;
+            std::map<qcc::String, PingResult>::const_iterator rit = pingResults.find(destination);
+            if ((rit != pingResults.end()) && ((now - rit->second.timestamp) < maxAge)) {
+                ApplyPingResult(group, destination, rit->second.state, notifications);
+            } else {
+                PingDestination(group, destination);
+            }
         }
     }
 }
 
-void AutoPingerInternal::PingDestination(const qcc::String& group, const qcc::String& destination, PingState oldState, PingListener& pingListener)
+void AutoPingerInternal::PingDestination(const qcc::String& group, const qcc::String& destination)
 {
     /* called with global lock taken */
-    PingAsyncContext* context =
-        new PingAsyncContext(this, group, destination, oldState, pingListener);
+    std::map<qcc::String, PingAsyncContext*>::iterator fit = pingsInFlight.find(destination);
+    if (fit != pingsInFlight.end()) {
+        // Piggyback on the ping that is already on its way
+        fit->second->groups.insert(group);
+        return;
+    }
+
+    PingAsyncContext* context = new PingAsyncContext(this, destination);
+    context->groups.insert(group);
 
     std::pair<std::set<PingAsyncContext*>::iterator, bool> pair = ctxs->insert(context);
+    pingsInFlight[destination] = context;
     if (ER_OK != busAttachment.PingAsync(destination.c_str(), PING_TIMEOUT, pingCallback, context)) {
         ctxs->erase(pair.first);
+        pingsInFlight.erase(destination);
         delete context;
     }
 }
 
+void AutoPingerInternal::ApplyPingResult(const qcc::String& group,
+                                         const qcc::String& destination,
+                                         const AutoPingerInternal::PingState state,
+                                         std::vector<PingNotification>& notifications)
+{
+    /* called with global lock taken */
+    std::map<qcc::String, PingGroup*>::iterator it = pingGroups.find(group);
+    if ((it != pingGroups.end()) && UpdatePingStateOfDestination(group, destination, state)) {
+        notifications.push_back(PingNotification(&it->second->pingListener, group, destination, (state == AVAILABLE)));
+    }
+}
+
+bool AutoPingerInternal::HasDestination(const qcc::String& destination) const
+{
+    /* called with global lock taken */
+    Destination dummy(destination, AutoPingerInternal::UNKNOWN);
+    std::map<qcc::String, PingGroup*>::const_iterator it = pingGroups.begin();
+    for (; it != pingGroups.end(); ++it) {
+        if (it->second->destinations.find(dummy) != it->second->destinations.end()) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void AutoPingerInternal::ForgetDestination(const qcc::String& destination)
+{
+    /* called with global lock taken */
+    if (!HasDestination(destination)) {
+        pingResults.erase(destination);
+    }
+}
+
 void AutoPingerInternal::Pause()
 {
     // Stop all pending alarms
@@ -326,6 +401,7 @@ void AutoPingerInternal::AddPingGroup(const qcc::String& group, PingListener& li
             // Alarm is a managed object (auto cleanup when overwritten)
             qcc::AlarmListener* alarmListener = (qcc::AlarmListener*)this;
             (*it).second->alarm = qcc::Alarm(intervalMillisec, alarmListener, context, intervalMillisec);
+            (*it).second->pingInterval = intervalMillisec;
             timer.AddAlarmNonBlocking((*it).second->alarm);
         }
     } else {
@@ -359,8 +435,15 @@ void AutoPingerInternal::RemovePingGroup(const qcc::String& group)
     if (it != pingGroups.end()) {
         // destructor of PingGroup cleans-up context
         timer.RemoveAlarm((*it).second->alarm, false);
+        std::map<Destination, unsigned int> destinations;
+        destinations.swap(it->second->destinations);
         delete it->second;
         pingGroups.erase(it);
+
+        std::map<Destination, unsigned int>::const_iterator dit = destinations.begin();
+        for (; dit != destinations.end(); ++dit) {
+            ForgetDestination(dit->first.destination);
+        }
     }
     globalPingerLock->Unlock(MUTEX_CONTEXT);
 }
@@ -385,6 +468,7 @@ QStatus AutoPingerInternal::SetPingInterval(const qcc::String& group, uint32_t p
             uint32_t intervalMillisec = pingInterval * 1000;
             qcc::AlarmListener* alarmListener = (qcc::AlarmListener*)this;
             (*it).second->alarm = qcc::Alarm(intervalMillisec, alarmListener, context, intervalMillisec);
+            (*it).second->pingInterval = intervalMillisec;
             timer.AddAlarmNonBlocking((*it).second->alarm);
 
             status = ER_OK;
@@ -413,7 +497,7 @@ QStatus AutoPingerInternal::AddDestination(const qcc::String& group, const qcc::
              * wait until the next periodic ping to learn about the initial
              * state of the destination. Therefore, we launch an
              * out-of-sequence ping right now. */
-            PingDestination(group, destination, AutoPingerInternal::UNKNOWN, it->second->pingListener);
+            PingDestination(group, destination);
         } else {
             dit->second++;
             QCC_DbgPrintf(("AutoPingerInternal: destination: '%s' already present in group: %s; increasing refcount", destination.c_str(), group.c_str()));
@@ -450,6 +534,7 @@ QStatus AutoPingerInternal::RemoveDestination(const qcc::String& group, const qc
 
             if (dit->second == 0) {
                 it->second->destinations.erase(dit);
+                ForgetDestination(destination);
             }
         }
     } else {
@@ -41,6 +41,7 @@
 #endif
 
 #include <map>
+#include <vector>
 #include <qcc/Timer.h>
 #include <qcc/String.h>
 #include <qcc/Mutex.h>
@@ -52,6 +53,8 @@ namespace ajn {
 /// @cond ALLJOYN_DEV
 /** @internal Forward references */
 struct PingGroup;
+struct PingNotification;
+class PingAsyncContext;
 class BusAttachment;
 /// @endcond
 
@@ -148,12 +151,23 @@ class AutoPingerInternal : public qcc::AlarmListener {
         AVAILABLE
     };
 
+    /* Outcome of the most recent ping to a destination, shared by all groups */
+    struct PingResult {
+        PingResult() : state(UNKNOWN), timestamp(0) { }
+        PingResult(PingState state, uint64_t timestamp) : state(state), timestamp(timestamp) { }
+        PingState state;
+        uint64_t timestamp;
+    };
+
     AutoPingerInternal(const AutoPingerInternal&);
     void operator=(const AutoPingerInternal&);
 
     bool UpdatePingStateOfDestination(const qcc::String& group, const qcc::String& destination, const AutoPingerInternal::PingState state);
-    void PingGroupDestinations(const qcc::String& group);
-    void PingDestination(const qcc::String& group, const qcc::String& destination, PingState oldState, PingListener& pingListener);
+    void ApplyPingResult(const qcc::String& group, const qcc::String& destination, PingState state, std::vector<PingNotification>& notifications);
+    void PingGroupDestinations(const qcc::String& group, std::vector<PingNotification>& notifications);
+    void PingDestination(const qcc::String& group, const qcc::String& destination);
+    bool HasDestination(const qcc::String& destination) const;
+    void ForgetDestination(const qcc::String& destination);
     bool IsRunning();
     void AlarmTriggered(const qcc::Alarm& alarm, QStatus reason);
 
@@ -161,6 +175,14 @@ class AutoPingerInternal : public qcc::AlarmListener {
     BusAttachment& busAttachment;
     std::map<qcc::String, PingGroup*> pingGroups;
 
+    /*
+     * A destination that is present in several groups is pinged once: groups whose timer fires
+     * while a ping is in flight join that ping, and groups that fire shortly after a reply reuse
+     * its result.
+     */
+    std::map<qcc::String, PingAsyncContext*> pingsInFlight;
+    std::map<qcc::String, PingResult> pingResults;
+
     bool pausing;
 };
 }
@@ -35,6 +35,7 @@
 #include <qcc/Debug.h>
 #include <qcc/Util.h>
 #include <qcc/Event.h>
+#include <qcc/ManagedObj.h>
 #include <qcc/String.h>
 #include <qcc/Timer.h>
 #include <qcc/atomic.h>
@@ -154,6 +155,22 @@ struct AddMatchCBContext {
     { }
 };
 
+/*
+ * Shared by the AddMatch calls of one AddMatchRules(), the waiting thread and every outstanding
+ * reply each hold a reference.
+ */
+struct _AddMatchRulesContext {
+    Event done;
+    volatile int32_t pending;
+    volatile int32_t errors;
+
+    _AddMatchRulesContext() :
+        pending(0),
+        errors(0)
+    { }
+};
+typedef ManagedObj<_AddMatchRulesContext> AddMatchRulesContext;
+
 struct RemoveMatchCBContext {
     BusAttachment::RemoveMatchAsyncCB* callback;
     void* context;
@@ -214,6 +231,7 @@ BusAttachment::Internal::Internal(const char* appName,
     router(router ? router : new ClientRouter),
     localEndpoint(transportList.GetLocalTransport()->GetLocalEndpoint()),
     allowRemoteMessages(allowRemoteMessages),
+    inProcessRouterBus(NULL),
     listenAddresses(listenAddresses ? listenAddresses : ""),
     stopLock(),
     stopCount(0),
@@ -632,12 +650,6 @@ QStatus BusAttachment::RegisterSignalHandlers()
                                        static_cast<MessageReceiver::SignalHandler>(&BusAttachment::Internal::AllJoynSignalHandler),
                                        iface->GetMember("NameOwnerChanged"),
                                        NULL);
-        if (ER_OK == status) {
-            Message reply(*this);
-            MsgArg arg("s", "type='signal',interface='org.freedesktop.DBus'");
-            const ProxyBusObject& dbusObj = this->GetDBusProxyObj();
-            status = dbusObj.MethodCall(org::freedesktop::DBus::InterfaceName, "AddMatch", &arg, 1, reply);
-        }
         /* Register org.alljoyn.Bus signal handler */
         const InterfaceDescription* ajIface = GetInterface(org::alljoyn::Bus::InterfaceName);
         if (ER_OK == status) {
@@ -688,11 +700,16 @@ QStatus BusAttachment::RegisterSignalHandlers()
                                            stateSignalMember,
                                            NULL);
         }
+        /*
+         * The match rules are added last and together so that connecting waits for a single round
+         * trip to the router rather than one per rule.
+         */
         if (ER_OK == status) {
-            Message reply(*this);
-            MsgArg arg("s", "type='signal',interface='org.alljoyn.Bus'");
-            const ProxyBusObject& dbusObj = this->GetDBusProxyObj();
-            status = dbusObj.MethodCall(org::freedesktop::DBus::InterfaceName, "AddMatch", &arg, 1, reply);
+            static const char* const rules[] = {
+                "type='signal',interface='org.freedesktop.DBus'",
+                "type='signal',interface='org.alljoyn.Bus'"
+            };
+            status = busInternal->AddMatchRules(rules, ArraySize(rules));
         }
     }
     return status;
@@ -1080,6 +1097,16 @@ bool BusAttachment::Internal::IsConnected() const {
     return router->IsBusRunning();
 }
 
+bool BusAttachment::Internal::IsInProcessDestination(const qcc::String& destination)
+{
+    BusAttachment* routerBus = inProcessRouterBus;
+    if (!routerBus || destination.empty() || (destination[0] != ':') || (destination == localEndpoint->GetUniqueName())) {
+        return false;
+    }
+    BusEndpoint ep = routerBus->GetInternal().GetRouter().FindEndpoint(destination);
+    return ep->IsValid() && (ep->GetEndpointType() == ENDPOINT_TYPE_NULL);
+}
+
 QStatus BusAttachment::Internal::AddApplicationStateListener(ApplicationStateListener& applicationStateListener)
 {
     QStatus status = ER_OK;
@@ -1364,6 +1391,72 @@ void BusAttachment::Internal::AddMatchAsyncCB(Message& reply, void* context)
     delete ctx;
 }
 
+QStatus BusAttachment::Internal::AddMatchRules(const char* const* rules, size_t numRules)
+{
+    /* Waiting for the replies blocks just like a synchronous method call */
+    if (localEndpoint->IsReentrantCall()) {
+        return ER_BUS_BLOCKING_CALL_NOT_ALLOWED;
+    }
+
+    QStatus status = ER_OK;
+    if (numRules == 0) {
+        return status;
+    }
+    AddMatchRulesContext ctx;
+    ctx->pending = static_cast<int32_t>(numRules);
+
+    const ProxyBusObject& dbusObj = bus.GetDBusProxyObj();
+    for (size_t i = 0; i < numRules; ++i) {
+        MsgArg arg("s", rules[i]);
+        AddMatchRulesContext* heapCtx = new AddMatchRulesContext(ctx);
+        QStatus callStatus = dbusObj.MethodCallAsync(org::freedesktop::DBus::InterfaceName, "AddMatch",
+                                                     this,
+                                                     static_cast<MessageReceiver::ReplyHandler>(&BusAttachment::Internal::AddMatchRulesCB),
+                                                     &arg, 1, heapCtx);
+        if (ER_OK != callStatus) {
+            /* The reply handler will not be called for this rule */
+            QCC_LogError(callStatus, ("Failed to call %s.AddMatch", org::freedesktop::DBus::InterfaceName));
+            delete heapCtx;
+            if (ER_OK == status) {
+                status = callStatus;
+            }
+            if (DecrementAndFetch(&ctx->pending) == 0) {
+                ctx->done.SetEvent();
+            }
+        }
+    }
+
+    /*
+     * A reply that does not arrive is turned into an error reply by the local endpoint's reply
+     * timer, so this wait ends even if the router never answers.
+     */
+    QStatus waitStatus = Event::Wait(ctx->done);
+    if (ER_ALERTED_THREAD == waitStatus) {
+        Thread::GetThread()->ResetAlertCode();
+    }
+    if (ER_OK == status) {
+        status = waitStatus;
+    }
+    if ((ER_OK == status) && (ctx->errors != 0)) {
+        status = ER_BUS_REPLY_IS_ERROR_MESSAGE;
+    }
+    return status;
+}
+
+void BusAttachment::Internal::AddMatchRulesCB(Message& reply, void* context)
+{
+    AddMatchRulesContext* ctx = reinterpret_cast<AddMatchRulesContext*>(context);
+
+    if (reply->GetType() == MESSAGE_ERROR) {
+        QCC_LogError(ER_BUS_REPLY_IS_ERROR_MESSAGE, ("%s.AddMatch returned ERROR_MESSAGE (error=%s)", org::freedesktop::DBus::InterfaceName, reply->GetErrorDescription().c_str()));
+        IncrementAndFetch(&(*ctx)->errors);
+    }
+    if (DecrementAndFetch(&(*ctx)->pending) == 0) {
+        (*ctx)->done.SetEvent();
+    }
+    delete ctx;
+}
+
 QStatus BusAttachment::AddMatchNonBlocking(const char* rule)
 {
     if (!IsConnected()) {
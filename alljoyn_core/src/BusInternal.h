@@ -50,6 +50,7 @@
 #include <alljoyn/InterfaceDescription.h>
 #include <alljoyn/PermissionConfigurator.h>
 
+#include "AboutDataCache.h"
 #include "AuthManager.h"
 #include "ObserverManager.h"
 #include "ClientRouter.h"
@@ -178,6 +179,13 @@ class BusAttachment::Internal : public MessageReceiver, public JoinSessionAsyncC
      */
     QStatus GetAnnouncedObjectDescription(MsgArg& objectDescriptionArg);
 
+    /**
+     * Get the cache of the about data dictionaries of the AboutObjs on this bus.
+     *
+     * @return  The about data cache
+     */
+    AboutDataCache& GetAboutDataCache() { return aboutDataCache; }
+
     /**
      * Constructor called by BusAttachment.
      */
@@ -212,6 +220,29 @@ class BusAttachment::Internal : public MessageReceiver, public JoinSessionAsyncC
      */
     bool AllowRemoteMessages() const { return allowRemoteMessages; }
 
+    /**
+     * Check if a message for a destination is delivered in-process, that is the destination is
+     * another bus attachment linked to the same bundled router. Messages for such a destination
+     * carry a copy of their arguments and only marshal the body if they have to.
+     *
+     * @param destination  The destination of the message.
+     *
+     * @return true if the destination is the unique name of another in-process bus attachment.
+     */
+    bool IsInProcessDestination(const qcc::String& destination);
+
+    /**
+     * Called by the null transport when this bus is linked to the bundled router.
+     *
+     * @param routerBus  The bus attachment of the bundled router.
+     */
+    void EnableInProcessDelivery(BusAttachment& routerBus) { inProcessRouterBus = &routerBus; }
+
+    /**
+     * Called by the null transport when this bus is unlinked from the bundled router.
+     */
+    void DisableInProcessDelivery() { inProcessRouterBus = NULL; }
+
     /**
      * Get the bus addresses that this daemon uses to listen on.
      * For clients, this list is empty since clients dont listen.
@@ -328,6 +359,25 @@ class BusAttachment::Internal : public MessageReceiver, public JoinSessionAsyncC
      */
     void AddMatchAsyncCB(Message& message, void* context);
 
+    /**
+     * Add several match rules with the router for one round trip. All of the AddMatch calls are
+     * sent before waiting for the first reply.
+     *
+     * @param rules     The match rules to add.
+     * @param numRules  The number of match rules.
+     *
+     * @return
+     *      - ER_OK if every match rule was added.
+     *      - ER_BUS_REPLY_IS_ERROR_MESSAGE if the router rejected any match rule.
+     *      - An error status otherwise.
+     */
+    virtual QStatus AddMatchRules(const char* const* rules, size_t numRules);
+
+    /**
+     * AddMatchRules method_reply handler
+     */
+    void AddMatchRulesCB(Message& message, void* context);
+
     /**
      * RemoveMatchAsync method_reply handler
      */
@@ -596,6 +646,7 @@ class BusAttachment::Internal : public MessageReceiver, public JoinSessionAsyncC
     LocalEndpoint localEndpoint;          /* The local endpoint */
 
     bool allowRemoteMessages;             /* true iff endpoints of this attachment can receive messages from remote devices */
+    BusAttachment* volatile inProcessRouterBus; /* The bundled router bus this attachment is linked to in-process */
     qcc::String listenAddresses;          /* The set of bus addresses that this bus can listen on. (empty for clients) */
     qcc::Mutex stopLock;                  /* Protects BusAttachement::Stop from being reentered */
     volatile int32_t stopCount;           /* Number of caller's blocked in BusAttachment::Stop() */
@@ -623,6 +674,7 @@ class BusAttachment::Internal : public MessageReceiver, public JoinSessionAsyncC
     AboutListenerSet aboutListeners; /* About Signals are received out of Sessions so a set is all that is needed */
 
     qcc::Mutex aboutListenersLock;   /* Lock protecting the aboutListeners set */
+    AboutDataCache aboutDataCache;   /* About data dictionaries of the AboutObjs on this bus */
 
     struct JoinContext {
         QStatus status;
@@ -46,6 +46,7 @@
 #include "LocalTransport.h"
 #include "ClientRouter.h"
 #include "BusInternal.h"
+#include "MessageTrace.h"
 
 #define QCC_MODULE "ALLJOYN"
 
@@ -58,6 +59,8 @@ QStatus ClientRouter::PushMessage(Message& msg, BusEndpoint& sender)
 {
     QStatus status = ER_OK;
 
+    MessageTrace::Stamp(MessageTrace::ROUTE, *msg);
+
     /*
      * Grab local copies of the local and non-local endpoints since the members
      * may be overwritten by another thread wandering through ClientRouter.
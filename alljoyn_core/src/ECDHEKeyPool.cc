@@ -0,0 +1,180 @@
+/**
+ * @file
+ * Pool of pre-generated ephemeral ECDHE key pairs used by the key exchangers.
+ */
+
+/******************************************************************************
+ *    Copyright (c) Open Connectivity Foundation (OCF), AllJoyn Open Source
+ *    Project (AJOSP) Contributors and others.
+ *
+ *    SPDX-License-Identifier: Apache-2.0
+ *
+ *    All rights reserved. This program and the accompanying materials are
+ *    made available under the terms of the Apache License, Version 2.0
+ *    which accompanies this distribution, and is available at
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Copyright (c) Open Connectivity Foundation and Contributors to AllSeen
+ *    Alliance. All rights reserved.
+ *
+ *    Permission to use, copy, modify, and/or distribute this software for
+ *    any purpose with or without fee is hereby granted, provided that the
+ *    above copyright notice and this permission notice appear in all
+ *    copies.
+ *
+ *    THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+ *    WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+ *    WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ *    AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ *    DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ *    PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+ *    TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ *    PERFORMANCE OF THIS SOFTWARE.
+ ******************************************************************************/
+
+#include <qcc/platform.h>
+#include <qcc/Debug.h>
+#include <qcc/Event.h>
+#include <qcc/LockLevel.h>
+
+#include "ECDHEKeyPool.h"
+
+#define QCC_MODULE "AUTH_KEY_EXCHANGER"
+
+using namespace qcc;
+
+namespace ajn {
+
+ECDHEKeyPool::ECDHEKeyPool(size_t capacity) :
+    Thread("ECDHEKeyPool"),
+    capacity(capacity),
+    lock(LOCK_LEVEL_ECDHEKEYPOOL_LOCK),
+    started(false),
+    stopping(false)
+{
+}
+
+ECDHEKeyPool::~ECDHEKeyPool()
+{
+    Stop();
+    Join();
+    while (!pairs.empty()) {
+        delete pairs.front();
+        pairs.pop_front();
+    }
+}
+
+QStatus ECDHEKeyPool::Take(Crypto_ECC& ecc)
+{
+    KeyPair* pair = NULL;
+
+    lock.Lock(MUTEX_CONTEXT);
+    if (!pairs.empty()) {
+        pair = pairs.front();
+        pairs.pop_front();
+    }
+    bool start = !stopping && !started;
+    bool wake = !stopping && started;
+    started = started || start;
+    lock.Unlock(MUTEX_CONTEXT);
+
+    /*
+     * Start or wake the refill thread outside the lock, it only takes the lock to add key pairs.
+     */
+    if (start) {
+        QStatus status = Start();
+        if (status != ER_OK) {
+            QCC_LogError(status, ("Failed to start ECDHE key pool refill thread"));
+            lock.Lock(MUTEX_CONTEXT);
+            stopping = true;
+            lock.Unlock(MUTEX_CONTEXT);
+        }
+    } else if (wake) {
+        Alert();
+    }
+
+    if (!pair) {
+        return ER_EOF;
+    }
+    ecc.SetDHPublicKey(&pair->publicKey);
+    ecc.SetDHPrivateKey(&pair->privateKey);
+    /* The private key is cleared by its destructor */
+    delete pair;
+    return ER_OK;
+}
+
+size_t ECDHEKeyPool::GetAvailable()
+{
+    lock.Lock(MUTEX_CONTEXT);
+    size_t available = pairs.size();
+    lock.Unlock(MUTEX_CONTEXT);
+    return available;
+}
+
+QStatus ECDHEKeyPool::Stop()
+{
+    lock.Lock(MUTEX_CONTEXT);
+    stopping = true;
+    lock.Unlock(MUTEX_CONTEXT);
+    return Thread::Stop();
+}
+
+QStatus ECDHEKeyPool::Join()
+{
+    QStatus status = Thread::Join();
+    /* Allow the next Take() to start the refill thread again */
+    lock.Lock(MUTEX_CONTEXT);
+    started = false;
+    stopping = false;
+    lock.Unlock(MUTEX_CONTEXT);
+    return status;
+}
+
+ThreadReturn STDCALL ECDHEKeyPool::Run(void* arg)
+{
+    QCC_UNUSED(arg);
+
+    while (!IsStopping()) {
+        lock.Lock(MUTEX_CONTEXT);
+        /* Stop() may have run before this thread was started */
+        bool done = stopping;
+        bool full = (pairs.size() >= capacity);
+        lock.Unlock(MUTEX_CONTEXT);
+
+        if (done) {
+            break;
+        }
+        if (full) {
+            QStatus status = Event::Wait(Event::neverSet);
+            if (status == ER_ALERTED_THREAD) {
+                ResetAlertCode();
+                GetStopEvent().ResetEvent();
+            }
+            continue;
+        }
+
+        /*
+         * Generate one key pair at a time so a handshake that finds the pool empty never waits
+         * behind more than a single scalar multiplication on this thread.
+         */
+        Crypto_ECC ecc;
+        QStatus status = ecc.GenerateDHKeyPair();
+        if (status != ER_OK) {
+            QCC_LogError(status, ("Failed to generate ECDHE key pair for the pool"));
+            lock.Lock(MUTEX_CONTEXT);
+            stopping = true;
+            lock.Unlock(MUTEX_CONTEXT);
+            break;
+        }
+        KeyPair* pair = new KeyPair();
+        pair->publicKey = *ecc.GetDHPublicKey();
+        pair->privateKey = *ecc.GetDHPrivateKey();
+
+        lock.Lock(MUTEX_CONTEXT);
+        pairs.push_back(pair);
+        lock.Unlock(MUTEX_CONTEXT);
+    }
+    return 0;
+}
+
+}
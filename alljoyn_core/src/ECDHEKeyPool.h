@@ -0,0 +1,149 @@
+/**
+ * @file
+ * Pool of pre-generated ephemeral ECDHE key pairs used by the key exchangers.
+ */
+
+/******************************************************************************
+ *    Copyright (c) Open Connectivity Foundation (OCF), AllJoyn Open Source
+ *    Project (AJOSP) Contributors and others.
+ *
+ *    SPDX-License-Identifier: Apache-2.0
+ *
+ *    All rights reserved. This program and the accompanying materials are
+ *    made available under the terms of the Apache License, Version 2.0
+ *    which accompanies this distribution, and is available at
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Copyright (c) Open Connectivity Foundation and Contributors to AllSeen
+ *    Alliance. All rights reserved.
+ *
+ *    Permission to use, copy, modify, and/or distribute this software for
+ *    any purpose with or without fee is hereby granted, provided that the
+ *    above copyright notice and this permission notice appear in all
+ *    copies.
+ *
+ *    THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+ *    WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+ *    WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ *    AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ *    DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ *    PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+ *    TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ *    PERFORMANCE OF THIS SOFTWARE.
+ ******************************************************************************/
+
+#ifndef _ALLJOYN_ECDHEKEYPOOL_H
+#define _ALLJOYN_ECDHEKEYPOOL_H
+
+#ifndef __cplusplus
+#error Only include ECDHEKeyPool.h in C++ code.
+#endif
+
+#include <qcc/platform.h>
+
+#include <deque>
+
+#include <qcc/CryptoECC.h>
+#include <qcc/Mutex.h>
+#include <qcc/Thread.h>
+
+#include <alljoyn/Status.h>
+
+namespace ajn {
+
+/**
+ * A bounded pool of ephemeral ECDHE key pairs. A background thread keeps the pool topped up so
+ * that an authentication conversation does not have to generate its key pair on the critical path
+ * of the handshake. Every key pair is handed out exactly once.
+ *
+ * Key pairs derived from a password (ECDHE_SPEKE) must not come from the pool.
+ */
+class ECDHEKeyPool : public qcc::Thread {
+  public:
+
+    /**
+     * Default number of key pairs kept ready.
+     */
+    static const size_t DEFAULT_CAPACITY = 8;
+
+    /**
+     * Constructor.
+     *
+     * @param capacity  Maximum number of key pairs kept ready.
+     */
+    ECDHEKeyPool(size_t capacity = DEFAULT_CAPACITY);
+
+    /**
+     * Destructor. Stops the refill thread and clears any key pairs that were not used.
+     */
+    ~ECDHEKeyPool();
+
+    /**
+     * Load a pre-generated key pair into an ECC context. The first call starts the refill thread.
+     *
+     * @param ecc  The ECC context to load the key pair into.
+     *
+     * @return
+     *      - ER_OK if a key pair was loaded.
+     *      - ER_EOF if the pool is empty, the caller must generate its own key pair.
+     */
+    QStatus Take(qcc::Crypto_ECC& ecc);
+
+    /**
+     * Get the number of key pairs currently ready.
+     *
+     * @return  The number of key pairs in the pool.
+     */
+    size_t GetAvailable();
+
+    /**
+     * Stop the refill thread.
+     *
+     * @return ER_OK if successful.
+     */
+    QStatus Stop();
+
+    /**
+     * Wait for the refill thread to exit. Once joined, the next call to Take() starts the refill
+     * thread again so the pool can be reused across a Stop()/Join() cycle.
+     *
+     * @return ER_OK if successful.
+     */
+    QStatus Join();
+
+  protected:
+
+    /**
+     * Refill thread. Generates key pairs one at a time until the pool is full and then sleeps
+     * until a key pair is taken.
+     */
+    qcc::ThreadReturn STDCALL Run(void* arg);
+
+  private:
+
+    /**
+     * Assignment not allowed
+     */
+    ECDHEKeyPool& operator=(const ECDHEKeyPool& other);
+
+    /**
+     * Copy constructor not allowed
+     */
+    ECDHEKeyPool(const ECDHEKeyPool& other);
+
+    /** A pre-generated key pair */
+    struct KeyPair {
+        qcc::ECCPublicKey publicKey;    /**< The ephemeral public key */
+        qcc::ECCPrivateKey privateKey;  /**< The ephemeral private key */
+    };
+
+    const size_t capacity;          /**< Maximum number of key pairs kept ready */
+    std::deque<KeyPair*> pairs;     /**< Key pairs ready to be handed out */
+    qcc::Mutex lock;                /**< Lock protecting the pool */
+    bool started;                   /**< True once the refill thread has been started */
+    bool stopping;                  /**< True once Stop() has been called */
+};
+
+}
+
+#endif
@@ -341,6 +341,10 @@ static const char AgreeVersion[] = "EXTENSION_AGREE_VERSION";
 
 static const char InformProtocolVersion[] = "INFORM_PROTO_VERSION";
 
+static const char NegotiateCompression[] = "NEGOTIATE_COMPRESSION";
+static const char AgreeCompression[] = "AGREE_COMPRESSION";
+static const char CompressionLZ4[] = "LZ4";
+
 qcc::String EndpointAuth::SASLCallout(SASLEngine& sasl, const qcc::String& extCmd)
 {
     QCC_DbgTrace(("EndpointAuth::SASLCallout(sasl=0x%p, extCmd=\"%s\")", &sasl, extCmd.c_str()));
@@ -355,6 +359,13 @@ qcc::String EndpointAuth::SASLCallout(SASLEngine& sasl, const qcc::String& extCm
             rsp += " " + qcc::U32ToString(qcc::GetPid());
 #endif
             endpoint->GetFeatures().handlePassing = false;
+        } else if (extCmd.empty() && endpoint->GetFeatures().isBusToBus) {
+            // bus-to-bus: offer body compression, a daemon that doesn't know the command responds with ERROR
+            rsp = NegotiateCompression;
+            rsp += " ";
+            rsp += CompressionLZ4;
+        } else if (extCmd.find(AgreeCompression) == 0) {
+            endpoint->GetFeatures().bodyCompression = (extCmd.find(CompressionLZ4, sizeof(AgreeCompression) - 1) != qcc::String::npos);
         } else if (extCmd.find(AgreeUnixFd) == 0) {
             // step 3: client receives "AGREE_UNIX_FD [<pid>]" and sets options
             endpoint->GetFeatures().handlePassing = true;
@@ -386,6 +397,14 @@ qcc::String EndpointAuth::SASLCallout(SASLEngine& sasl, const qcc::String& extCm
 #endif
             endpoint->GetFeatures().handlePassing = true;
             endpoint->GetFeatures().processId = qcc::StringToU32(extCmd.substr(sizeof(NegotiateUnixFd) - 1), 0, (uint32_t)-1);
+        } else if (extCmd.find(NegotiateCompression) == 0) {
+            // bus-to-bus: agree to body compression if we share an algorithm, otherwise fall through to ERROR
+            if (extCmd.find(CompressionLZ4, sizeof(NegotiateCompression) - 1) != qcc::String::npos) {
+                rsp = AgreeCompression;
+                rsp += " ";
+                rsp += CompressionLZ4;
+                endpoint->GetFeatures().bodyCompression = true;
+            }
         } else if (extCmd.find(NegotiateVersion) == 0) {
             // step 5: daemon receives "EXTENSION_NEGOTIATE_VERSION <version>", negotiates lowest common version
             rsp = AgreeVersion;
@@ -294,6 +294,10 @@ class SigInfoECC : public SigInfo {
 
 QStatus KeyExchangerECDHE::GenerateECDHEKeyPair()
 {
+    /* Use a key pair generated ahead of time if one is ready */
+    if (peerObj && (peerObj->GetECDHEKeyPool().Take(ecc) == ER_OK)) {
+        return ER_OK;
+    }
     return ecc.GenerateDHKeyPair();
 }
 
@@ -477,7 +481,7 @@ void KeyExchangerECDHE::KeyExchangeGenLegacyKey(MsgArg& variant)
     peerState->UpdateHash(IsInitiator(), CONVERSATION_V1, buf, sizeof(buf));
     peerState->ReleaseConversationHashLock(IsInitiator());
 
-    /* In CONVERSATION_V4, this content is hashed one level up in ExecKeyExchange or
+    /* In CONVERSATION_V4, this content is hashed one level up in KeyExchangeReadReply or
      * RespondToKeyExchange. So no hashing is done here for that version.
      */
 }
@@ -505,7 +509,7 @@ QStatus KeyExchangerECDHE::KeyExchangeReadLegacyKey(MsgArg& variant)
     peerState->UpdateHash(IsInitiator(), CONVERSATION_V1, replyPubKey, replyPubKeyLen);
     peerState->ReleaseConversationHashLock(IsInitiator());
 
-    /* In CONVERSATION_V4, this content is hashed one level up in ExecKeyExchange or
+    /* In CONVERSATION_V4, this content is hashed one level up in KeyExchangeReadReply or
      * RespondToKeyExchange. So no hashing is done here for that version.
      */
 
@@ -549,7 +553,7 @@ void KeyExchangerECDHE::KeyExchangeGenKey(MsgArg& variant)
         peerState->UpdateHash(IsInitiator(), CONVERSATION_V1, exportedPublicKey, exportedPublicKeySize);
         peerState->ReleaseConversationHashLock(IsInitiator());
 
-        /* In CONVERSATION_V4, this content is hashed one level up in ExecKeyExchange or
+        /* In CONVERSATION_V4, this content is hashed one level up in KeyExchangeReadReply or
          * RespondToKeyExchange. So no hashing is done here for that version.
          */
     }
@@ -611,7 +615,7 @@ QStatus KeyExchangerECDHE::KeyExchangeReadKey(MsgArg& variant)
         peerState->UpdateHash(IsInitiator(), CONVERSATION_V1, replyPubKey, replyPubKeyLen);
         peerState->ReleaseConversationHashLock(IsInitiator());
 
-        /* In CONVERSATION_V4, this content is hashed one level up in ExecKeyExchange or
+        /* In CONVERSATION_V4, this content is hashed one level up in KeyExchangeReadReply or
          * RespondToKeyExchange. So no hashing is done here for that version.
          */
 
@@ -620,9 +624,9 @@ QStatus KeyExchangerECDHE::KeyExchangeReadKey(MsgArg& variant)
     return KeyExchangeReadKeyInfo(variant);
 }
 
-QStatus KeyExchangerECDHE::ExecKeyExchange(uint32_t authMask, KeyExchangerCB& callback, uint32_t* remoteAuthMask)
+QStatus KeyExchangerECDHE::KeyExchangeGenArgs(uint32_t authMask, MsgArg* args)
 {
-    QCC_DbgTrace(("%s (authMask=%u, remoteAuthMask=%u)", __FUNCTION__, authMask, *remoteAuthMask));
+    QCC_DbgTrace(("%s (authMask=%u)", __FUNCTION__, authMask));
 
     QStatus status = GenerateECDHEKeyPair();
     if (status != ER_OK) {
@@ -642,30 +646,34 @@ QStatus KeyExchangerECDHE::ExecKeyExchange(uint32_t authMask, KeyExchangerCB& ca
     } else {
         KeyExchangeGenKey(variant);
     }
-    Message sentMsg(bus);
-    Message replyMsg(bus);
-    MsgArg args[2];
     args[0].Set("u", authMask);
     status = args[1].Set("v", &variant);
     if (status != ER_OK) {
-        QCC_DbgHLPrintf(("KeyExchangerECDHE::ExecKeyExchange set variant fails status 0x%x\n", status));
+        QCC_DbgHLPrintf(("KeyExchangerECDHE::KeyExchangeGenArgs set variant fails status 0x%x\n", status));
         return status;
     }
+    /* The variant is local to this function */
+    args[1].Stabilize();
+    return ER_OK;
+}
+
+QStatus KeyExchangerECDHE::KeyExchangeReadReply(QStatus callStatus, Message& sentMsg, Message& replyMsg, uint32_t* remoteAuthMask)
+{
+    QCC_DbgTrace(("%s (callStatus=%s)", __FUNCTION__, QCC_StatusText(callStatus)));
 
     peerState->AcquireConversationHashLock(IsInitiator());
-    status = callback.SendKeyExchange(args, ArraySize(args), &sentMsg, &replyMsg);
     peerState->UpdateHash(IsInitiator(), CONVERSATION_V4, sentMsg);
     peerState->UpdateHash(IsInitiator(), CONVERSATION_V4, replyMsg);
     peerState->ReleaseConversationHashLock(IsInitiator());
-    if (status != ER_OK) {
-        QCC_DbgHLPrintf(("KeyExchangerECDHE::ExecKeyExchange send KeyExchange fails status 0x%x\n", status));
-        return status;
+    if (callStatus != ER_OK) {
+        QCC_DbgHLPrintf(("KeyExchangerECDHE::KeyExchangeReadReply send KeyExchange fails status 0x%x\n", callStatus));
+        return callStatus;
     }
     *remoteAuthMask = replyMsg->GetArg(0)->v_uint32;
     MsgArg* outVariant;
-    status = replyMsg->GetArg(1)->Get("v", &outVariant);
+    QStatus status = replyMsg->GetArg(1)->Get("v", &outVariant);
     if (status != ER_OK) {
-        QCC_DbgHLPrintf(("KeyExchangerECDHE::ExecKeyExchange send KeyExchange fails to retrieve variant from response status 0x%x\n", status));
+        QCC_DbgHLPrintf(("KeyExchangerECDHE::KeyExchangeReadReply fails to retrieve variant from response status 0x%x\n", status));
         return status;
     }
 
@@ -682,6 +690,36 @@ QStatus KeyExchangerECDHE::ExecKeyExchange(uint32_t authMask, KeyExchangerCB& ca
     return status;
 }
 
+QStatus KeyExchangerECDHE::KeyAuthenticationReadReply(QStatus callStatus, Message& sentMsg, Message& replyMsg, const char* peerName, uint8_t* authorized)
+{
+    QCC_DbgTrace(("%s (callStatus=%s)", __FUNCTION__, QCC_StatusText(callStatus)));
+
+    *authorized = false;
+    peerState->AcquireConversationHashLock(IsInitiator());
+    peerState->UpdateHash(IsInitiator(), CONVERSATION_V4, sentMsg);
+    if (callStatus != ER_OK) {
+        peerState->UpdateHash(IsInitiator(), CONVERSATION_V4, replyMsg);
+        peerState->ReleaseConversationHashLock(IsInitiator());
+        return callStatus;
+    }
+    peerState->ReleaseConversationHashLock(IsInitiator());
+
+    MsgArg* variant;
+    QStatus status = replyMsg->GetArg(0)->Get("v", &variant);
+    if (status != ER_OK) {
+        peerState->AcquireConversationHashLock(IsInitiator());
+        peerState->UpdateHash(IsInitiator(), CONVERSATION_V4, replyMsg);
+        peerState->ReleaseConversationHashLock(IsInitiator());
+        return status;
+    }
+    status = ValidateRemoteVerifierVariant(peerName, variant, authorized);
+    /* Hash the reply after ValidateRemoteVerifierVariant so the verifier is correctly computed. */
+    peerState->AcquireConversationHashLock(IsInitiator());
+    peerState->UpdateHash(IsInitiator(), CONVERSATION_V4, replyMsg);
+    peerState->ReleaseConversationHashLock(IsInitiator());
+    return status;
+}
+
 static QStatus GenerateVerifier(const char* label, const uint8_t* handshake, size_t handshakeLen, const KeyBlob& secretBlob, uint8_t* verifier, size_t verifierLen)
 {
     vector<uint8_t, SecureAllocator<uint8_t> > seed;
@@ -972,11 +1010,10 @@ QStatus KeyExchangerECDHE_NULL::RequestCredentialsCB(const char* peerName)
     return ER_OK;
 }
 
-QStatus KeyExchangerECDHE_NULL::KeyAuthentication(KeyExchangerCB& callback, const char* peerName, uint8_t* authorized)
+QStatus KeyExchangerECDHE_NULL::KeyAuthenticationGenArg(const char* peerName, MsgArg& verifierMsg)
 {
     QCC_DbgTrace(("%s", __FUNCTION__));
 
-    *authorized = false;
     QStatus status = GenerateMasterSecret(&peerPubKey);
     if (status != ER_OK) {
         return status;
@@ -991,35 +1028,14 @@ QStatus KeyExchangerECDHE_NULL::KeyAuthentication(KeyExchangerCB& callback, cons
     if (status != ER_OK) {
         return status;
     }
-    Message sentMsg(bus);
-    Message replyMsg(bus);
     MsgArg verifierArg("ay", sizeof(verifier), verifier);
-    MsgArg verifierMsg("v", &verifierArg);
+    verifierMsg.Set("v", &verifierArg);
+    verifierMsg.Stabilize();
 
     peerState->AcquireConversationHashLock(IsInitiator());
     peerState->UpdateHash(IsInitiator(), CONVERSATION_V1, verifier, sizeof(verifier));
-    status = callback.SendKeyAuthentication(&verifierMsg, &sentMsg, &replyMsg);
-    peerState->UpdateHash(IsInitiator(), CONVERSATION_V4, sentMsg);
-    if (status != ER_OK) {
-        peerState->UpdateHash(IsInitiator(), CONVERSATION_V4, replyMsg);
-        peerState->ReleaseConversationHashLock(IsInitiator());
-        return status;
-    }
-    peerState->ReleaseConversationHashLock(IsInitiator());
-
-    MsgArg* variant;
-    status = replyMsg->GetArg(0)->Get("v", &variant);
-    if (status != ER_OK) {
-        peerState->AcquireConversationHashLock(IsInitiator());
-        peerState->UpdateHash(IsInitiator(), CONVERSATION_V4, replyMsg);
-        peerState->ReleaseConversationHashLock(IsInitiator());
-        return status;
-    }
-    status = ValidateRemoteVerifierVariant(peerName, variant, authorized);
-    peerState->AcquireConversationHashLock(IsInitiator());
-    peerState->UpdateHash(IsInitiator(), CONVERSATION_V4, replyMsg);
     peerState->ReleaseConversationHashLock(IsInitiator());
-    return status;
+    return ER_OK;
 }
 
 QStatus KeyExchangerECDHE_PSK::ReplyWithVerifier(Message& msg)
@@ -1176,11 +1192,10 @@ QStatus KeyExchangerECDHE_PSK::ValidateRemoteVerifierVariant(const char* peerNam
     return ER_OK;
 }
 
-QStatus KeyExchangerECDHE_PSK::KeyAuthentication(KeyExchangerCB& callback, const char* peerName, uint8_t* authorized)
+QStatus KeyExchangerECDHE_PSK::KeyAuthenticationGenArg(const char* peerName, MsgArg& verifierMsg)
 {
     QCC_DbgTrace(("%s", __FUNCTION__));
 
-    *authorized = false;
     QStatus status = GenerateMasterSecret(&peerPubKey);
     if (status != ER_OK) {
         return status;
@@ -1207,39 +1222,18 @@ QStatus KeyExchangerECDHE_PSK::KeyAuthentication(KeyExchangerCB& callback, const
     if (status != ER_OK) {
         return status;
     }
-    Message sentMsg(bus);
-    Message replyMsg(bus);
     MsgArg verifierArg;
     status = verifierArg.Set("(ayay)", pskName.length(), pskName.data(), sizeof(verifier), verifier);
     if (status != ER_OK) {
         return status;
     }
-    MsgArg verifierMsg("v", &verifierArg);
+    verifierMsg.Set("v", &verifierArg);
+    verifierMsg.Stabilize();
 
     peerState->AcquireConversationHashLock(IsInitiator());
     peerState->UpdateHash(IsInitiator(), CONVERSATION_V1, verifier, sizeof(verifier));
-
-    status = callback.SendKeyAuthentication(&verifierMsg, &sentMsg, &replyMsg);
-    peerState->UpdateHash(IsInitiator(), CONVERSATION_V4, sentMsg);
-    if (status != ER_OK) {
-        peerState->UpdateHash(IsInitiator(), CONVERSATION_V4, replyMsg);
-        peerState->ReleaseConversationHashLock(IsInitiator());
-        return status;
-    }
-    peerState->ReleaseConversationHashLock(IsInitiator());
-    MsgArg* variant;
-    status = replyMsg->GetArg(0)->Get("v", &variant);
-    if (status != ER_OK) {
-        peerState->AcquireConversationHashLock(IsInitiator());
-        peerState->UpdateHash(IsInitiator(), CONVERSATION_V4, replyMsg);
-        peerState->ReleaseConversationHashLock(IsInitiator());
-        return status;
-    }
-    status = ValidateRemoteVerifierVariant(peerName, variant, authorized);
-    peerState->AcquireConversationHashLock(IsInitiator());
-    peerState->UpdateHash(IsInitiator(), CONVERSATION_V4, replyMsg);
     peerState->ReleaseConversationHashLock(IsInitiator());
-    return status;
+    return ER_OK;
 }
 
 QStatus KeyExchangerECDHE_ECDSA::ParseCertChainPEM(String& encodedCertChain)
@@ -1720,11 +1714,10 @@ QStatus KeyExchangerECDHE_ECDSA::GenVerifierSigInfoArg(MsgArg& msgArg, bool upda
     return ER_OK;
 }
 
-QStatus KeyExchangerECDHE_ECDSA::KeyAuthentication(KeyExchangerCB& callback, const char* peerName, uint8_t* authorized)
+QStatus KeyExchangerECDHE_ECDSA::KeyAuthenticationGenArg(const char* peerName, MsgArg& verifierMsg)
 {
     QCC_DbgTrace(("%s", __FUNCTION__));
 
-    *authorized = false;
     QStatus status = GenerateMasterSecret(&peerPubKey);
     if (status != ER_OK) {
         QCC_LogError(status, ("Error generating master secret"));
@@ -1746,32 +1739,9 @@ QStatus KeyExchangerECDHE_ECDSA::KeyAuthentication(KeyExchangerCB& callback, con
     }
     variant.SetOwnershipFlags(MsgArg::OwnsArgs, true);
 
-    MsgArg verifierMsg("v", &variant);
-
-    Message sentMsg(bus);
-    Message replyMsg(bus);
-    peerState->AcquireConversationHashLock(IsInitiator());
-    status = callback.SendKeyAuthentication(&verifierMsg, &sentMsg, &replyMsg);
-    peerState->UpdateHash(IsInitiator(), CONVERSATION_V4, sentMsg);
-    if (status != ER_OK) {
-        peerState->UpdateHash(IsInitiator(), CONVERSATION_V4, replyMsg);
-        peerState->ReleaseConversationHashLock(IsInitiator());
-        return status;
-    }
-    peerState->ReleaseConversationHashLock(IsInitiator());
-    MsgArg* remoteVariant;
-    status = replyMsg->GetArg(0)->Get("v", &remoteVariant);
-    if (status != ER_OK) {
-        peerState->AcquireConversationHashLock(IsInitiator());
-        peerState->UpdateHash(IsInitiator(), CONVERSATION_V4, replyMsg);
-        peerState->ReleaseConversationHashLock(IsInitiator());
-        return status;
-    }
-    status = ValidateRemoteVerifierVariant(peerName, remoteVariant, authorized);
-    peerState->AcquireConversationHashLock(IsInitiator());
-    peerState->UpdateHash(IsInitiator(), CONVERSATION_V4, replyMsg);
-    peerState->ReleaseConversationHashLock(IsInitiator());
-    return status;
+    verifierMsg.Set("v", &variant);
+    verifierMsg.Stabilize();
+    return ER_OK;
 }
 
 bool KeyExchanger::IsLegacyPeer()
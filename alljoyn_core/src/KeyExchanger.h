@@ -56,25 +56,6 @@ namespace ajn {
 class AllJoynPeerObj;
 
 
-/**
- * the Key exchanger Callback
- */
-class KeyExchangerCB {
-  public:
-    KeyExchangerCB(ProxyBusObject& remoteObj, const InterfaceDescription* ifc, uint32_t timeout) : remoteObj(remoteObj), ifc(ifc), timeout(timeout) { }
-    QStatus SendKeyExchange(MsgArg* args, size_t numArgs, Message* sentMsg, Message* replyMsg);
-    QStatus SendKeyAuthentication(MsgArg* msg, Message* sentMsg, Message* replyMsg);
-
-    ~KeyExchangerCB() { }
-  private:
-    /* Private assigment operator - does nothing */
-    KeyExchangerCB operator=(const KeyExchangerCB&);
-
-    ProxyBusObject& remoteObj;
-    const InterfaceDescription* ifc;
-    uint32_t timeout;
-};
-
 class KeyExchanger {
   public:
 
@@ -123,14 +104,64 @@ class KeyExchanger {
         QCC_UNUSED(authMask);
         return ER_NOT_IMPLEMENTED;
     }
-    virtual QStatus ExecKeyExchange(uint32_t authMask, KeyExchangerCB& callback, uint32_t* remoteAuthMask) {
+
+    /**
+     * Generate the arguments of the KeyExchange method call sent by the initiator.
+     *
+     * @param authMask    The auth suite requested from the peer.
+     * @param[out] args   Array of two arguments receiving the method call arguments.
+     * @return ER_OK if successful; otherwise, an error code.
+     */
+    virtual QStatus KeyExchangeGenArgs(uint32_t authMask, MsgArg* args) {
         QCC_UNUSED(authMask);
-        QCC_UNUSED(callback);
+        QCC_UNUSED(args);
+        return ER_NOT_IMPLEMENTED;
+    }
+
+    /**
+     * Process the reply to the KeyExchange method call sent by the initiator.
+     *
+     * @param callStatus      The status of the method call.
+     * @param sentMsg         The KeyExchange method call that was sent.
+     * @param replyMsg        The reply to the method call.
+     * @param[out] remoteAuthMask  The auth suite the peer agreed to.
+     * @return ER_OK if successful; otherwise, an error code.
+     */
+    virtual QStatus KeyExchangeReadReply(QStatus callStatus, Message& sentMsg, Message& replyMsg, uint32_t* remoteAuthMask) {
+        QCC_UNUSED(callStatus);
+        QCC_UNUSED(sentMsg);
+        QCC_UNUSED(replyMsg);
         QCC_UNUSED(remoteAuthMask);
         return ER_NOT_IMPLEMENTED;
     }
-    virtual QStatus KeyAuthentication(KeyExchangerCB& callback, const char* peerName, uint8_t* authorized) {
-        QCC_UNUSED(callback);
+
+    /**
+     * Generate the verifier argument of the KeyAuthentication method call sent by the initiator.
+     *
+     * @param peerName       The name of the peer being authenticated.
+     * @param[out] verifier  Receives the method call argument.
+     * @return ER_OK if successful; otherwise, an error code.
+     */
+    virtual QStatus KeyAuthenticationGenArg(const char* peerName, MsgArg& verifier) {
+        QCC_UNUSED(peerName);
+        QCC_UNUSED(verifier);
+        return ER_NOT_IMPLEMENTED;
+    }
+
+    /**
+     * Process the reply to the KeyAuthentication method call sent by the initiator.
+     *
+     * @param callStatus       The status of the method call.
+     * @param sentMsg          The KeyAuthentication method call that was sent.
+     * @param replyMsg         The reply to the method call.
+     * @param peerName         The name of the peer being authenticated.
+     * @param[out] authorized  Set to true if the peer's verifier is valid.
+     * @return ER_OK if successful; otherwise, an error code.
+     */
+    virtual QStatus KeyAuthenticationReadReply(QStatus callStatus, Message& sentMsg, Message& replyMsg, const char* peerName, uint8_t* authorized) {
+        QCC_UNUSED(callStatus);
+        QCC_UNUSED(sentMsg);
+        QCC_UNUSED(replyMsg);
         QCC_UNUSED(peerName);
         QCC_UNUSED(authorized);
         return ER_NOT_IMPLEMENTED;
@@ -264,18 +295,14 @@ class KeyExchangerECDHE : public KeyExchanger {
 
     QStatus RespondToKeyExchange(Message& msg, MsgArg* variant, uint32_t remoteAuthMask, uint32_t authMask);
 
-    virtual QStatus ExecKeyExchange(uint32_t authMask, KeyExchangerCB& callback, uint32_t* remoteAuthMask);
+    virtual QStatus KeyExchangeGenArgs(uint32_t authMask, MsgArg* args);
+    virtual QStatus KeyExchangeReadReply(QStatus callStatus, Message& sentMsg, Message& replyMsg, uint32_t* remoteAuthMask);
     virtual void KeyExchangeGenLegacyKey(MsgArg& variant);
     virtual void KeyExchangeGenKey(MsgArg& variant);
     virtual QStatus KeyExchangeReadLegacyKey(MsgArg& variant);
     virtual QStatus KeyExchangeReadKey(MsgArg& variant);
 
-    virtual QStatus KeyAuthentication(KeyExchangerCB& callback, const char* peerName, uint8_t* authorized) {
-        QCC_UNUSED(callback);
-        QCC_UNUSED(peerName);
-        QCC_UNUSED(authorized);
-        return ER_OK;
-    }
+    virtual QStatus KeyAuthenticationReadReply(QStatus callStatus, Message& sentMsg, Message& replyMsg, const char* peerName, uint8_t* authorized);
 
 
   protected:
@@ -330,7 +357,7 @@ class KeyExchangerECDHE_NULL : public KeyExchangerECDHE {
     const char* GetSuiteName() {
         return AuthName();
     }
-    QStatus KeyAuthentication(KeyExchangerCB& callback, const char* peerName, uint8_t* authorized);
+    QStatus KeyAuthenticationGenArg(const char* peerName, MsgArg& verifier);
 
     QStatus RequestCredentialsCB(const char* peerName);
 
@@ -384,7 +411,7 @@ class KeyExchangerECDHE_PSK : public KeyExchangerECDHE {
     QStatus GenerateRemoteVerifier(uint8_t* peerPskName, size_t peerPskNameLen, uint8_t* verifier, size_t verifierLen);
     QStatus ValidateRemoteVerifierVariant(const char* peerName, MsgArg* variant, uint8_t* authorized);
 
-    QStatus KeyAuthentication(KeyExchangerCB& callback, const char* peerName, uint8_t* authorized);
+    QStatus KeyAuthenticationGenArg(const char* peerName, MsgArg& verifier);
 
     QStatus RequestCredentialsCB(const char* peerName);
 
@@ -494,7 +521,7 @@ class KeyExchangerECDHE_ECDSA : public KeyExchangerECDHE {
 
     QStatus ReplyWithVerifier(Message& msg);
 
-    QStatus KeyAuthentication(KeyExchangerCB& callback, const char* peerName, uint8_t* authorized);
+    QStatus KeyAuthenticationGenArg(const char* peerName, MsgArg& verifier);
 
     QStatus RequestCredentialsCB(const char* peerName);
     QStatus ValidateRemoteVerifierVariant(const char* peerName, MsgArg* variant, uint8_t* authorized);
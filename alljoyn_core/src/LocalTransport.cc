@@ -57,6 +57,7 @@
 #include "AllJoynPeerObj.h"
 #include "BusUtil.h"
 #include "BusInternal.h"
+#include "MessageTrace.h"
 
 #define QCC_MODULE "LOCAL_TRANSPORT"
 
@@ -662,6 +663,8 @@ QStatus _LocalEndpoint::PushMessage(Message& message)
 {
     QStatus ret;
 
+    MessageTrace::Stamp(MessageTrace::LOCAL_QUEUE, *message);
+
     if (running) {
         BusEndpoint ep = bus->GetInternal().GetRouter().FindEndpoint(message->GetSender());
         /* Determine if the source of this message is local to the process */
@@ -685,6 +688,7 @@ QStatus _LocalEndpoint::DoPushMessage(Message& message)
         QCC_DbgHLPrintf(("Local transport not running discarding %s", message->Description().c_str()));
     } else {
         QCC_DbgPrintf(("Pushing %s into local endpoint", message->Description().c_str()));
+        MessageTrace::Stamp(MessageTrace::DISPATCH, *message);
 
         switch (message->GetType()) {
         case MESSAGE_METHOD_CALL:
@@ -704,6 +708,7 @@ QStatus _LocalEndpoint::DoPushMessage(Message& message)
             status = ER_FAIL;
             break;
         }
+        MessageTrace::Stamp(MessageTrace::HANDLED, *message);
 
         handlerThreadsLock.Lock(MUTEX_CONTEXT);
         handlerThreadsDone.Broadcast();
@@ -45,6 +45,8 @@
 #include <qcc/time.h>
 #include <qcc/Util.h>
 #include <qcc/Debug.h>
+#include <qcc/LZ4.h>
+#include <qcc/atomic.h>
 
 #include <alljoyn/Message.h>
 #include <alljoyn/BusAttachment.h>
@@ -66,6 +68,36 @@ namespace ajn {
 
 char _Message::outEndian = _Message::myEndian;
 
+/*
+ * Args carried with a message for an in-process destination so the receiver can adopt them instead
+ * of unmarshaling the body. Copies of the message and buffers copied from one another share them.
+ */
+struct CarriedArgs {
+    volatile int32_t refs;   /* Number of buffers holding these args */
+    MsgArg* args;
+    uint8_t numArgs;
+};
+
+/*
+ * State of the bytes in a message buffer
+ */
+static const uint8_t MSG_BUF_BODY_DEFERRED = 0x01;       /* Body space is allocated but not marshalled */
+static const uint8_t MSG_BUF_ENCRYPTION_SKIPPED = 0x02;  /* Body left in plain text for in-process delivery */
+
+/*
+ * Copies of a message share the marshalled bytes rather than copying them. The reference count and
+ * a link to the buffer the current one was copied from are kept in front of the message data along
+ * with the in-process delivery state, which belongs to the bytes rather than to any one copy.
+ */
+struct MsgBufHeader {
+    volatile int32_t refs;   /* Number of messages and newer buffers holding this buffer */
+    uint8_t* origBuf;        /* Buffer this one was copied from, header fields and args may point into it */
+    uint8_t state;           /* MSG_BUF_* flags */
+    CarriedArgs* carried;    /* Args carried for an in-process destination or NULL */
+};
+
+static const size_t MSG_BUF_HDR_LEN = (sizeof(MsgBufHeader) + 7) & ~7;
+
 const uint32_t _Message::AUTH_FALLBACK_VERSION = 2;
 
 qcc::String _Message::ToString() const
@@ -353,6 +385,7 @@ void _Message::Init(BusAttachment& busAttachment)
     readState = MESSAGE_NEW;
     countRead = 0;
     writeState = MESSAGE_NEW;
+    writePtr = NULL;
     countWrite = 0;
     msgHeader.msgType = MESSAGE_INVALID;
     msgHeader.endian = myEndian;
@@ -362,7 +395,7 @@ void _Message::Init(BusAttachment& busAttachment)
 
 _Message::~_Message(void)
 {
-    delete [] _msgBuf;
+    ReleaseMsgBuf(_msgBuf);
     delete [] msgArgs;
     while (numHandles) {
         qcc::Close(handles[--numHandles]);
@@ -389,6 +422,7 @@ _Message::_Message(const _Message& other) :
     readState(other.readState),
     countRead(other.countRead),
     writeState(other.writeState),
+    writePtr(other.writePtr),
     countWrite(other.countWrite),
     hdrFields(other.hdrFields),
     encryptionNotification(other.encryptionNotification),
@@ -396,16 +430,15 @@ _Message::_Message(const _Message& other) :
 {
     if (bufSize > 0) {
         QCC_ASSERT(other.msgBuf != NULL);
-        _msgBuf = new uint8_t[bufSize + 7];
-        msgBuf = (uint64_t*)((uintptr_t)(_msgBuf + 7) & ~7);
-        bufEOD = ((uint8_t*)msgBuf) + (other.bufEOD - ((uint8_t*)other.msgBuf));
-        bufPos = ((uint8_t*)msgBuf) + (other.bufPos - ((uint8_t*)other.msgBuf));
-        bodyPtr = ((uint8_t*)msgBuf) + (other.bodyPtr - ((uint8_t*)other.msgBuf));
         /*
-         * Copy in buffer and zero fill the pad at the end of the data
+         * Share the buffer with the other message, it is copied if either message modifies it
          */
-        ::memcpy(msgBuf, other.msgBuf, bufSize);
-        ::memset(bufEOD, 0, (uint8_t*)msgBuf + bufSize - bufEOD);
+        _msgBuf = other._msgBuf;
+        IncrementAndFetch(&reinterpret_cast<MsgBufHeader*>(_msgBuf)->refs);
+        msgBuf = other.msgBuf;
+        bufEOD = other.bufEOD;
+        bufPos = other.bufPos;
+        bodyPtr = other.bodyPtr;
     } else {
         QCC_ASSERT(other.msgBuf == NULL);
         _msgBuf = NULL;
@@ -442,6 +475,14 @@ _Message::_Message(const _Message& other) :
 
 QStatus _Message::ReMarshal(const char* senderName)
 {
+    /*
+     * The body is copied into the new buffer and adopted args are about to be freed
+     */
+    QStatus status = MarshalDeferredBody();
+    if (status != ER_OK) {
+        return status;
+    }
+
     if (senderName) {
         hdrFields.field[ALLJOYN_HDR_FIELD_SENDER].Set("s", senderName);
     }
@@ -470,8 +511,7 @@ QStatus _Message::ReMarshal(const char* senderName)
      * message reducing the places where we need to check for bufEOD when unmarshaling the body.
      */
     bufSize = sizeof(msgHeader) + ((((msgHeader.headerLen + 7) & ~7) + msgHeader.bodyLen + 7) & ~7) + 8;
-    _msgBuf = new uint8_t[bufSize + 7];
-    msgBuf = (uint64_t*)((uintptr_t)(_msgBuf + 7) & ~7); /* Align to 8 byte boundary */
+    AllocMsgBuf(bufSize);
     bufPos = (uint8_t*)msgBuf;
     memcpy(bufPos, &msgHeader, sizeof(msgHeader));
     bufPos += sizeof(msgHeader);
@@ -503,7 +543,249 @@ QStatus _Message::ReMarshal(const char* senderName)
      */
     QCC_ASSERT((size_t)(bufEOD - (uint8_t*)msgBuf) < bufSize);
     memset(bufEOD, 0, (uint8_t*)msgBuf + bufSize - bufEOD);
-    delete [] _savBuf;
+    if (_savBuf) {
+        CopyMsgBufState(_savBuf);
+    }
+    ReleaseMsgBuf(_savBuf);
+    return ER_OK;
+}
+
+void _Message::AllocMsgBuf(size_t size)
+{
+    _msgBuf = new uint8_t[MSG_BUF_HDR_LEN + size + 7];
+    MsgBufHeader* hdr = reinterpret_cast<MsgBufHeader*>(_msgBuf);
+    hdr->refs = 1;
+    hdr->origBuf = NULL;
+    hdr->state = 0;
+    hdr->carried = NULL;
+    msgBuf = (uint64_t*)((uintptr_t)(_msgBuf + MSG_BUF_HDR_LEN + 7) & ~7); /* Align to 8 byte boundary */
+}
+
+void _Message::ReleaseMsgBuf(uint8_t* buf)
+{
+    while (buf) {
+        MsgBufHeader* hdr = reinterpret_cast<MsgBufHeader*>(buf);
+        if (DecrementAndFetch(&hdr->refs) != 0) {
+            break;
+        }
+        if (hdr->carried && (DecrementAndFetch(&hdr->carried->refs) == 0)) {
+            delete [] hdr->carried->args;
+            delete hdr->carried;
+        }
+        uint8_t* origBuf = hdr->origBuf;
+        delete [] buf;
+        buf = origBuf;
+    }
+}
+
+void _Message::UnshareMsgBuf()
+{
+    if (!_msgBuf || (reinterpret_cast<MsgBufHeader*>(_msgBuf)->refs == 1)) {
+        return;
+    }
+    uint8_t* oldBuf = _msgBuf;
+    uint8_t* oldData = reinterpret_cast<uint8_t*>(msgBuf);
+    AllocMsgBuf(bufSize);
+    uint8_t* newData = reinterpret_cast<uint8_t*>(msgBuf);
+    memcpy(newData, oldData, bufSize);
+    /*
+     * Our reference to the old buffer moves to the new buffer so that header fields and
+     * unmarshalled args that point into the old buffer stay valid.
+     */
+    reinterpret_cast<MsgBufHeader*>(_msgBuf)->origBuf = oldBuf;
+    CopyMsgBufState(oldBuf);
+    bufEOD = newData + (bufEOD - oldData);
+    if (bufPos) {
+        bufPos = newData + (bufPos - oldData);
+    }
+    if (bodyPtr) {
+        bodyPtr = newData + (bodyPtr - oldData);
+    }
+    if (writePtr) {
+        writePtr = newData + (writePtr - oldData);
+    }
+}
+
+void _Message::CopyMsgBufState(const uint8_t* buf)
+{
+    const MsgBufHeader* from = reinterpret_cast<const MsgBufHeader*>(buf);
+    MsgBufHeader* hdr = reinterpret_cast<MsgBufHeader*>(_msgBuf);
+    QCC_ASSERT(hdr->carried == NULL);
+    hdr->state = from->state;
+    hdr->carried = from->carried;
+    if (hdr->carried) {
+        IncrementAndFetch(&hdr->carried->refs);
+    }
+}
+
+bool _Message::IsBodyDeferred() const
+{
+    return _msgBuf && (reinterpret_cast<const MsgBufHeader*>(_msgBuf)->state & MSG_BUF_BODY_DEFERRED);
+}
+
+void _Message::SetBodyDeferred(bool deferred)
+{
+    MsgBufHeader* hdr = reinterpret_cast<MsgBufHeader*>(_msgBuf);
+    if (deferred) {
+        hdr->state |= MSG_BUF_BODY_DEFERRED;
+    } else {
+        hdr->state &= ~MSG_BUF_BODY_DEFERRED;
+    }
+}
+
+bool _Message::IsEncryptionSkipped() const
+{
+    return _msgBuf && (reinterpret_cast<const MsgBufHeader*>(_msgBuf)->state & MSG_BUF_ENCRYPTION_SKIPPED);
+}
+
+void _Message::SetEncryptionSkipped()
+{
+    reinterpret_cast<MsgBufHeader*>(_msgBuf)->state |= MSG_BUF_ENCRYPTION_SKIPPED;
+}
+
+void _Message::CarryArgs(const MsgArg* args, uint8_t numArgs)
+{
+    MsgBufHeader* hdr = reinterpret_cast<MsgBufHeader*>(_msgBuf);
+    QCC_ASSERT(hdr->carried == NULL);
+    /*
+     * The caller owns the args so they are copied once here, every copy of the message shares
+     * this copy and the receiver takes it over when it holds the only reference.
+     */
+    CarriedArgs* carried = new CarriedArgs;
+    carried->refs = 1;
+    carried->args = new MsgArg[numArgs];
+    for (uint8_t i = 0; i < numArgs; ++i) {
+        carried->args[i] = args[i];
+    }
+    carried->numArgs = numArgs;
+    hdr->carried = carried;
+}
+
+const MsgArg* _Message::GetCarriedArgs(uint8_t& numArgs) const
+{
+    const CarriedArgs* carried = _msgBuf ? reinterpret_cast<const MsgBufHeader*>(_msgBuf)->carried : NULL;
+    numArgs = carried ? carried->numArgs : 0;
+    return carried ? carried->args : NULL;
+}
+
+MsgArg* _Message::AdoptCarriedArgs(uint8_t& numArgs)
+{
+    MsgBufHeader* hdr = reinterpret_cast<MsgBufHeader*>(_msgBuf);
+    CarriedArgs* carried = hdr->carried;
+    QCC_ASSERT(carried != NULL);
+    numArgs = carried->numArgs;
+    MsgArg* args;
+    if ((hdr->refs == 1) && (carried->refs == 1)) {
+        /*
+         * Nothing else can see the args so move them, MarshalDeferredBody uses msgArgs after this
+         */
+        args = carried->args;
+        delete carried;
+        hdr->carried = NULL;
+    } else {
+        args = new MsgArg[numArgs];
+        for (uint8_t i = 0; i < numArgs; ++i) {
+            args[i] = carried->args[i];
+        }
+    }
+    return args;
+}
+
+void _Message::CompressBody(size_t threshold)
+{
+    size_t bodyLen = msgHeader.bodyLen;
+    if ((threshold == 0) || (bodyLen < threshold) || handles) {
+        return;
+    }
+    /*
+     * Encrypted bodies don't compress
+     */
+    if (msgHeader.flags & (ALLJOYN_FLAG_ENCRYPTED | BODY_COMPRESSED_FLAG)) {
+        return;
+    }
+    uint8_t* oldBuf = _msgBuf;
+    uint8_t* oldData = reinterpret_cast<uint8_t*>(msgBuf);
+    size_t hdrLen = sizeof(msgHeader) + ((msgHeader.headerLen + 7) & ~7);
+    QCC_ASSERT((size_t)(bufEOD - oldData) == hdrLen + bodyLen);
+
+    size_t bound = LZ4CompressBound(bodyLen);
+    size_t newSize = hdrLen + sizeof(uint32_t) + ((bound + 7) & ~7) + sizeof(uint64_t);
+    AllocMsgBuf(newSize);
+    uint8_t* newData = reinterpret_cast<uint8_t*>(msgBuf);
+    size_t compressedLen = LZ4Compress(oldData + hdrLen, bodyLen, newData + hdrLen + sizeof(uint32_t), bound);
+    size_t newBodyLen = sizeof(uint32_t) + compressedLen;
+    if ((compressedLen == 0) || (newBodyLen >= bodyLen)) {
+        ReleaseMsgBuf(_msgBuf);
+        _msgBuf = oldBuf;
+        msgBuf = reinterpret_cast<uint64_t*>(oldData);
+        return;
+    }
+    QCC_DbgPrintf(("CompressBody %s %u -> %u", Description().c_str(), bodyLen, newBodyLen));
+    /*
+     * The header and the uncompressed length are in the same byte order as the rest of the message
+     */
+    memcpy(newData, oldData, hdrLen);
+    uint32_t origLen = endianSwap ? EndianSwap32((uint32_t)bodyLen) : (uint32_t)bodyLen;
+    memcpy(newData + hdrLen, &origLen, sizeof(origLen));
+    msgHeader.bodyLen = (uint32_t)newBodyLen;
+    msgHeader.flags |= BODY_COMPRESSED_FLAG;
+    MessageHeader* hdr = reinterpret_cast<MessageHeader*>(newData);
+    hdr->bodyLen = endianSwap ? EndianSwap32(msgHeader.bodyLen) : msgHeader.bodyLen;
+    hdr->flags |= BODY_COMPRESSED_FLAG;
+    /*
+     * Header fields may point into the old buffer so keep it alive for as long as this one
+     */
+    reinterpret_cast<MsgBufHeader*>(_msgBuf)->origBuf = oldBuf;
+    bufSize = newSize;
+    bodyPtr = newData + hdrLen;
+    bufPos = bodyPtr;
+    bufEOD = bodyPtr + newBodyLen;
+    memset(bufEOD, 0, newData + bufSize - bufEOD);
+}
+
+QStatus _Message::ExpandBody()
+{
+    uint8_t* oldBuf = _msgBuf;
+    uint8_t* oldData = reinterpret_cast<uint8_t*>(msgBuf);
+    size_t hdrLen = sizeof(msgHeader) + ((msgHeader.headerLen + 7) & ~7);
+    size_t compressedLen = msgHeader.bodyLen;
+
+    if (compressedLen <= sizeof(uint32_t)) {
+        return ER_BUS_BAD_BODY_LEN;
+    }
+    uint32_t bodyLen;
+    memcpy(&bodyLen, oldData + hdrLen, sizeof(bodyLen));
+    if (endianSwap) {
+        bodyLen = EndianSwap32(bodyLen);
+    }
+    size_t newPktSize = (hdrLen - sizeof(msgHeader)) + bodyLen;
+    if ((newPktSize > ALLJOYN_MAX_PACKET_LEN) || (bodyLen > ALLJOYN_MAX_PACKET_LEN)) {
+        return ER_BUS_BAD_BODY_LEN;
+    }
+    size_t newSize = sizeof(msgHeader) + ((newPktSize + 7) & ~7) + sizeof(uint64_t);
+    AllocMsgBuf(newSize);
+    uint8_t* newData = reinterpret_cast<uint8_t*>(msgBuf);
+    size_t expandedLen;
+    QStatus status = LZ4Decompress(oldData + hdrLen + sizeof(uint32_t), compressedLen - sizeof(uint32_t), newData + hdrLen, bodyLen, expandedLen);
+    if ((status != ER_OK) || (expandedLen != bodyLen)) {
+        ReleaseMsgBuf(_msgBuf);
+        _msgBuf = oldBuf;
+        msgBuf = reinterpret_cast<uint64_t*>(oldData);
+        return ER_BUS_BAD_BODY_LEN;
+    }
+    memcpy(newData, oldData, hdrLen);
+    ReleaseMsgBuf(oldBuf);
+
+    msgHeader.bodyLen = bodyLen;
+    msgHeader.flags &= ~BODY_COMPRESSED_FLAG;
+    MessageHeader* hdr = reinterpret_cast<MessageHeader*>(newData);
+    hdr->bodyLen = endianSwap ? EndianSwap32(bodyLen) : bodyLen;
+    hdr->flags &= ~BODY_COMPRESSED_FLAG;
+    bufSize = newSize;
+    pktSize = newPktSize;
+    bufPos = newData + sizeof(msgHeader);
+    bufEOD = newData + hdrLen + bodyLen;
+    memset(bufEOD, 0, newData + bufSize - bufEOD);
     return ER_OK;
 }
 
@@ -0,0 +1,522 @@
+/**
+ * @file
+ * Message lifecycle tracing
+ */
+
+
+/******************************************************************************
+ *    Copyright (c) Open Connectivity Foundation (OCF), AllJoyn Open Source
+ *    Project (AJOSP) Contributors and others.
+ *
+ *    SPDX-License-Identifier: Apache-2.0
+ *
+ *    All rights reserved. This program and the accompanying materials are
+ *    made available under the terms of the Apache License, Version 2.0
+ *    which accompanies this distribution, and is available at
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Copyright (c) Open Connectivity Foundation and Contributors to AllSeen
+ *    Alliance. All rights reserved.
+ *
+ *    Permission to use, copy, modify, and/or distribute this software for
+ *    any purpose with or without fee is hereby granted, provided that the
+ *    above copyright notice and this permission notice appear in all
+ *    copies.
+ *
+ *    THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+ *    WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+ *    WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ *    AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ *    DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ *    PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+ *    TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ *    PERFORMANCE OF THIS SOFTWARE.
+ ******************************************************************************/
+
+#include <qcc/platform.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <stdio.h>
+#include <string.h>
+
+#if defined(QCC_OS_GROUP_WINDOWS)
+#include <windows.h>
+#else
+#include <pthread.h>
+#endif
+
+#include <qcc/atomic.h>
+#include <qcc/Environ.h>
+#include <qcc/FileStream.h>
+#include <qcc/StringUtil.h>
+#include <qcc/Thread.h>
+#include <qcc/Util.h>
+
+#include "MessageTrace.h"
+
+#define QCC_MODULE "ALLJOYN"
+
+/*
+ * Stamps are recorded on the message path, including from inside IODispatch callbacks, so the
+ * calling thread finds its buffer through a thread local pointer rather than a locked map. A
+ * thread specific key with a destructor hands the buffer back when the thread exits.
+ */
+#if defined(_MSC_VER)
+#define MESSAGE_TRACE_THREAD_LOCAL __declspec(thread)
+#else
+#define MESSAGE_TRACE_THREAD_LOCAL __thread
+#endif
+
+using namespace std;
+using namespace qcc;
+
+namespace ajn {
+
+volatile bool MessageTrace::s_enabled = false;
+volatile uint32_t MessageTrace::s_sampleInterval = 1;
+volatile int32_t MessageTrace::s_generation = 0;
+volatile int32_t MessageTrace::s_threadCount = 0;
+volatile uint32_t MessageTrace::s_bufferCapacity = MessageTrace::DEFAULT_BUFFER_CAPACITY;
+MessageTrace::ThreadBuffer* MessageTrace::s_buffers = NULL;
+qcc::String* MessageTrace::s_traceFile = NULL;
+
+/*
+ * Protects the list of buffers and the identity (index and name) of each buffer. It is taken once
+ * per thread to find a buffer and by the readers, never when a stamp is recorded. A Mutex cannot
+ * be used since stamps may be recorded before AllJoynInit() or after AllJoynShutdown().
+ */
+static std::atomic_flag s_buffersLock = ATOMIC_FLAG_INIT;
+
+static void LockBuffers()
+{
+    while (s_buffersLock.test_and_set(std::memory_order_acquire)) {
+        qcc::Sleep(0);
+    }
+}
+
+static void UnlockBuffers()
+{
+    s_buffersLock.clear(std::memory_order_release);
+}
+
+/**
+ * The stamps recorded by one thread, kept in a ring that overwrites the oldest stamps. When the
+ * thread exits the buffer is handed over to the next thread that starts tracing, so the stamps
+ * of a thread that has exited are exported until its buffer is taken over.
+ */
+class MessageTrace::ThreadBuffer {
+  public:
+    ThreadBuffer(uint32_t capacity) : next(NULL), index(0), generation(0), count(0), inUse(true), capacity(capacity), slots(new Slot[capacity])
+    {
+        for (uint32_t i = 0; i < capacity; ++i) {
+            slots[i].sequence.store(0, std::memory_order_relaxed);
+        }
+    }
+
+    ~ThreadBuffer() { delete [] slots; }
+
+    /* Called with the buffers lock held when a thread takes the buffer */
+    void Attach(uint32_t threadIndex, const qcc::String& threadName)
+    {
+        index = threadIndex;
+        name = threadName;
+        generation = s_generation;
+        count.store(0, std::memory_order_release);
+    }
+
+    void Add(const Event& event)
+    {
+        uint32_t n = count.load(std::memory_order_relaxed);
+        if (generation != s_generation) {
+            /* Drop the stamps recorded before Reset() was called */
+            n = 0;
+            count.store(0, std::memory_order_release);
+            generation = s_generation;
+        }
+        Slot& slot = slots[n % capacity];
+        /* Mark the slot as being written so a reader copying the stamp it holds discards it */
+        slot.sequence.store(0, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        slot.event = event;
+        /* Publish the stamp only once it is complete */
+        slot.sequence.store(n + 1, std::memory_order_release);
+        count.store(n + 1, std::memory_order_release);
+    }
+
+    /*
+     * Copy the n'th stamp recorded since the buffer was attached. Returns false if the slot no
+     * longer holds that stamp, or was overwritten while it was copied, because the ring wrapped.
+     */
+    bool Get(uint32_t n, Event& event) const
+    {
+        const Slot& slot = slots[n % capacity];
+        if (slot.sequence.load(std::memory_order_acquire) != n + 1) {
+            return false;
+        }
+        event = slot.event;
+        std::atomic_thread_fence(std::memory_order_acquire);
+        return slot.sequence.load(std::memory_order_relaxed) == n + 1;
+    }
+
+    ThreadBuffer* next;
+    uint32_t index;
+    volatile int32_t generation;
+    std::atomic<uint32_t> count;
+    std::atomic<bool> inUse;
+    qcc::String name;
+    const uint32_t capacity;
+
+  private:
+    /* A stamp and the sequence number (its index in the ring plus one) it was recorded with */
+    struct Slot {
+        std::atomic<uint32_t> sequence;
+        Event event;
+    };
+
+    Slot* slots;
+
+    ThreadBuffer(const ThreadBuffer& other);
+    ThreadBuffer& operator=(const ThreadBuffer& other);
+};
+
+/* The calling thread's MessageTrace::ThreadBuffer */
+static MESSAGE_TRACE_THREAD_LOCAL void* s_threadBuffer = NULL;
+
+/* Hands the calling thread's buffer back when the thread exits */
+#if defined(QCC_OS_GROUP_WINDOWS)
+static VOID WINAPI ReleaseThreadBuffer(PVOID arg)
+#else
+static void ReleaseThreadBuffer(void* arg)
+#endif
+{
+    s_threadBuffer = NULL;
+    if (arg) {
+        static_cast<std::atomic<bool>*>(arg)->store(false, std::memory_order_release);
+    }
+}
+
+/* Created by the first thread that takes a buffer while holding the buffers lock */
+#if defined(QCC_OS_GROUP_WINDOWS)
+static DWORD s_releaseKey = FLS_OUT_OF_INDEXES;
+#else
+static pthread_key_t s_releaseKey;
+static bool s_releaseKeyCreated = false;
+#endif
+
+static void SetThreadBufferRelease(std::atomic<bool>* inUse)
+{
+#if defined(QCC_OS_GROUP_WINDOWS)
+    if (s_releaseKey == FLS_OUT_OF_INDEXES) {
+        s_releaseKey = FlsAlloc(ReleaseThreadBuffer);
+    }
+    if (s_releaseKey != FLS_OUT_OF_INDEXES) {
+        FlsSetValue(s_releaseKey, inUse);
+    }
+#else
+    if (!s_releaseKeyCreated) {
+        s_releaseKeyCreated = (pthread_key_create(&s_releaseKey, ReleaseThreadBuffer) == 0);
+    }
+    if (s_releaseKeyCreated) {
+        pthread_setspecific(s_releaseKey, inUse);
+    }
+#endif
+}
+
+static const char* const StageNames[MessageTrace::STAGE_COUNT] = {
+    "marshal",
+    "route",
+    "tx_queue",
+    "tx_write",
+    "rx_unmarshal",
+    "local_queue",
+    "dispatch",
+    "handled"
+};
+
+static const char* const TypeNames[] = { "invalid", "call", "reply", "error", "signal" };
+
+static void CopyTruncated(char* dest, size_t size, const char* src)
+{
+    size_t len = src ? strlen(src) : 0;
+    if (len == 0) {
+        dest[0] = '\0';
+        return;
+    }
+    if (len >= size) {
+        len = size - 1;
+    }
+    memcpy(dest, src, len);
+    dest[len] = '\0';
+}
+
+void MessageTrace::Init()
+{
+    Environ* env = Environ::GetAppEnviron();
+    qcc::String capacity = env->Find("ER_MESSAGE_TRACE_BUFFER");
+    if (!capacity.empty()) {
+        SetBufferCapacity(StringToU32(capacity, 10, DEFAULT_BUFFER_CAPACITY));
+    }
+    qcc::String interval = env->Find("ER_MESSAGE_TRACE");
+    if (!interval.empty()) {
+        uint32_t n = StringToU32(interval, 10, 0);
+        if (n != 0) {
+            qcc::String file = env->Find("ER_MESSAGE_TRACE_FILE");
+            if (file.empty()) {
+                file = "alljoyn-trace-" + U32ToString(GetPid()) + ".json";
+            }
+            s_traceFile = new qcc::String(file);
+            SetEnabled(true, n);
+        }
+    }
+}
+
+void MessageTrace::Shutdown()
+{
+    if (s_traceFile) {
+        SetEnabled(false);
+        QStatus status = WriteJson(*s_traceFile);
+        if (status != ER_OK) {
+            QCC_LogError(status, ("Failed to write message trace to %s", s_traceFile->c_str()));
+        }
+        delete s_traceFile;
+        s_traceFile = NULL;
+    }
+}
+
+void MessageTrace::SetEnabled(bool enabled, uint32_t sampleInterval)
+{
+    s_sampleInterval = (sampleInterval == 0) ? 1 : sampleInterval;
+    s_enabled = enabled;
+}
+
+void MessageTrace::SetBufferCapacity(uint32_t capacity)
+{
+    s_bufferCapacity = (capacity == 0) ? 1 : capacity;
+}
+
+void MessageTrace::Reset()
+{
+    IncrementAndFetch(&s_generation);
+}
+
+MessageTrace::ThreadBuffer* MessageTrace::GetThreadBuffer()
+{
+    ThreadBuffer* buffer = static_cast<ThreadBuffer*>(s_threadBuffer);
+    if (!buffer) {
+        uint32_t index = static_cast<uint32_t>(IncrementAndFetch(&s_threadCount));
+        qcc::String name = Thread::GetThreadName();
+        LockBuffers();
+        /* Take over the buffer of a thread that has exited before allocating a new one */
+        for (buffer = s_buffers; buffer; buffer = buffer->next) {
+            bool inUse = false;
+            if ((buffer->capacity == s_bufferCapacity) && buffer->inUse.compare_exchange_strong(inUse, true)) {
+                break;
+            }
+        }
+        if (!buffer) {
+            buffer = new ThreadBuffer(s_bufferCapacity);
+            buffer->next = s_buffers;
+            s_buffers = buffer;
+        }
+        buffer->Attach(index, name);
+        SetThreadBufferRelease(&buffer->inUse);
+        UnlockBuffers();
+        s_threadBuffer = buffer;
+    }
+    return buffer;
+}
+
+size_t MessageTrace::GetBufferCount()
+{
+    size_t n = 0;
+    LockBuffers();
+    for (ThreadBuffer* buffer = s_buffers; buffer; buffer = buffer->next) {
+        ++n;
+    }
+    UnlockBuffers();
+    return n;
+}
+
+void MessageTrace::Record(Stage stage, const _Message& msg)
+{
+    uint32_t serial = msg.GetCallSerial();
+    if ((serial % s_sampleInterval) != 0) {
+        return;
+    }
+    ThreadBuffer* buffer = GetThreadBuffer();
+    Event event;
+    event.timestampNs = chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now().time_since_epoch()).count();
+    event.serial = serial;
+    event.msgType = static_cast<uint8_t>(msg.GetType());
+    event.replySerial = ((event.msgType == MESSAGE_METHOD_RET) || (event.msgType == MESSAGE_ERROR)) ? msg.GetReplySerial() : 0;
+    event.threadIndex = buffer->index;
+    event.stage = static_cast<uint8_t>(stage);
+    CopyTruncated(event.sender, sizeof(event.sender), msg.GetSender());
+    CopyTruncated(event.member, sizeof(event.member), (event.msgType == MESSAGE_ERROR) ? msg.GetErrorName() : msg.GetMemberName());
+    buffer->Add(event);
+}
+
+static bool EventByTime(const MessageTrace::Event& a, const MessageTrace::Event& b)
+{
+    return a.timestampNs < b.timestampNs;
+}
+
+void MessageTrace::GetEvents(vector<Event>& events)
+{
+    events.clear();
+    int32_t generation = s_generation;
+    LockBuffers();
+    for (ThreadBuffer* buffer = s_buffers; buffer; buffer = buffer->next) {
+        if (buffer->generation != generation) {
+            continue;
+        }
+        uint32_t count = buffer->count.load(std::memory_order_acquire);
+        uint32_t first = (count > buffer->capacity) ? (count - buffer->capacity) : 0;
+        Event event;
+        for (uint32_t i = first; i < count; ++i) {
+            if (buffer->Get(i, event)) {
+                events.push_back(event);
+            }
+        }
+    }
+    UnlockBuffers();
+    stable_sort(events.begin(), events.end(), EventByTime);
+}
+
+qcc::String MessageTrace::GetThreadName(uint32_t threadIndex)
+{
+    qcc::String name;
+    LockBuffers();
+    for (ThreadBuffer* buffer = s_buffers; buffer; buffer = buffer->next) {
+        if (buffer->index == threadIndex) {
+            name = buffer->name;
+            break;
+        }
+    }
+    UnlockBuffers();
+    return name;
+}
+
+const char* MessageTrace::GetStageName(Stage stage)
+{
+    return (stage < STAGE_COUNT) ? StageNames[stage] : "unknown";
+}
+
+/* Messages are identified across stages and processes by sender and serial number */
+static bool SameMessage(const MessageTrace::Event& a, const MessageTrace::Event& b)
+{
+    return (a.serial == b.serial) && (strcmp(a.sender, b.sender) == 0);
+}
+
+static bool EventByMessage(const MessageTrace::Event& a, const MessageTrace::Event& b)
+{
+    int cmp = strcmp(a.sender, b.sender);
+    if (cmp != 0) {
+        return cmp < 0;
+    }
+    return (a.serial != b.serial) ? (a.serial < b.serial) : (a.timestampNs < b.timestampNs);
+}
+
+static uint64_t MessageId(const MessageTrace::Event& event)
+{
+    /* FNV-1a hash of the sender in the upper half, serial number in the lower half */
+    uint32_t hash = 2166136261u;
+    for (const char* c = event.sender; *c; ++c) {
+        hash = (hash ^ static_cast<uint8_t>(*c)) * 16777619u;
+    }
+    return (static_cast<uint64_t>(hash) << 32) | event.serial;
+}
+
+/* Copy a string into a JSON document, escaping as needed */
+static void AppendJsonString(qcc::String& json, const char* str)
+{
+    json += '"';
+    for (const char* c = str; *c; ++c) {
+        if ((*c == '"') || (*c == '\\')) {
+            json += '\\';
+            json += *c;
+        } else if (static_cast<uint8_t>(*c) < 0x20) {
+            char esc[8];
+            snprintf(esc, sizeof(esc), "\\u%04x", static_cast<uint8_t>(*c));
+            json += esc;
+        } else {
+            json += *c;
+        }
+    }
+    json += '"';
+}
+
+static void AppendEvent(qcc::String& json, const MessageTrace::Event& event, const char* name, char phase, uint32_t pid)
+{
+    char buf[160];
+    json += ",\n{\"name\":";
+    AppendJsonString(json, name);
+    snprintf(buf, sizeof(buf), ",\"cat\":\"message\",\"ph\":\"%c\",\"id\":\"0x%016llx\",\"ts\":%llu.%03u,\"pid\":%u,\"tid\":%u,\"args\":{\"serial\":%u",
+             phase, static_cast<unsigned long long>(MessageId(event)), static_cast<unsigned long long>(event.timestampNs / 1000),
+             static_cast<uint32_t>(event.timestampNs % 1000), pid, event.threadIndex, event.serial);
+    json += buf;
+    if (event.replySerial) {
+        snprintf(buf, sizeof(buf), ",\"reply_serial\":%u", event.replySerial);
+        json += buf;
+    }
+    json += ",\"sender\":";
+    AppendJsonString(json, event.sender);
+    json += "}}";
+}
+
+qcc::String MessageTrace::ToJson()
+{
+    vector<Event> events;
+    GetEvents(events);
+    uint32_t pid = GetPid();
+
+    char buf[128];
+    qcc::String json = "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n";
+    snprintf(buf, sizeof(buf), "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":%u,\"tid\":0,\"args\":{\"name\":\"alljoyn %u\"}}", pid, pid);
+    json += buf;
+    LockBuffers();
+    for (ThreadBuffer* buffer = s_buffers; buffer; buffer = buffer->next) {
+        snprintf(buf, sizeof(buf), ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":%u,\"tid\":%u,\"args\":{\"name\":", pid, buffer->index);
+        json += buf;
+        AppendJsonString(json, buffer->name.c_str());
+        json += "}}";
+    }
+    UnlockBuffers();
+
+    stable_sort(events.begin(), events.end(), EventByMessage);
+    for (size_t first = 0; first < events.size();) {
+        size_t last = first;
+        while ((last + 1 < events.size()) && SameMessage(events[first], events[last + 1])) {
+            ++last;
+        }
+        const Event& start = events[first];
+        qcc::String name = TypeNames[(start.msgType < ArraySize(TypeNames)) ? start.msgType : 0];
+        if (start.member[0]) {
+            name += ' ';
+            name += start.member;
+        }
+        AppendEvent(json, start, name.c_str(), 'b', pid);
+        for (size_t i = first; i <= last; ++i) {
+            AppendEvent(json, events[i], GetStageName(static_cast<Stage>(events[i].stage)), 'n', pid);
+        }
+        AppendEvent(json, events[last], name.c_str(), 'e', pid);
+        first = last + 1;
+    }
+    json += "\n]}\n";
+    return json;
+}
+
+QStatus MessageTrace::WriteJson(const qcc::String& fileName)
+{
+    FileSink sink(fileName);
+    if (!sink.IsValid()) {
+        return ER_OS_ERROR;
+    }
+    qcc::String json = ToJson();
+    size_t sent;
+    return sink.PushBytes(json.data(), json.size(), sent);
+}
+
+}
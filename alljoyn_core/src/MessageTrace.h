@@ -0,0 +1,234 @@
+/**
+ * @file
+ * MessageTrace records timestamps for a sampled subset of messages as they move through the
+ * stages of the bus and exports them in the Chrome trace event format.
+ */
+
+
+/******************************************************************************
+ *    Copyright (c) Open Connectivity Foundation (OCF), AllJoyn Open Source
+ *    Project (AJOSP) Contributors and others.
+ *
+ *    SPDX-License-Identifier: Apache-2.0
+ *
+ *    All rights reserved. This program and the accompanying materials are
+ *    made available under the terms of the Apache License, Version 2.0
+ *    which accompanies this distribution, and is available at
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Copyright (c) Open Connectivity Foundation and Contributors to AllSeen
+ *    Alliance. All rights reserved.
+ *
+ *    Permission to use, copy, modify, and/or distribute this software for
+ *    any purpose with or without fee is hereby granted, provided that the
+ *    above copyright notice and this permission notice appear in all
+ *    copies.
+ *
+ *    THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+ *    WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+ *    WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ *    AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ *    DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ *    PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+ *    TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ *    PERFORMANCE OF THIS SOFTWARE.
+ ******************************************************************************/
+#ifndef _ALLJOYN_MESSAGETRACE_H
+#define _ALLJOYN_MESSAGETRACE_H
+
+#ifndef __cplusplus
+#error Only include MessageTrace.h in C++ code.
+#endif
+
+#include <qcc/platform.h>
+#include <qcc/String.h>
+
+#include <vector>
+
+#include <alljoyn/Message.h>
+
+#include <alljoyn/Status.h>
+
+namespace ajn {
+
+/**
+ * Message lifecycle tracing.
+ *
+ * When enabled each sampled message is stamped with the monotonic time and the recording thread
+ * as it passes the stages below. Stamps go into fixed size buffers owned by the recording thread
+ * so tracing adds no locking to the message path, and when tracing is disabled every stage costs
+ * a single test of a global flag.
+ *
+ * A message is sampled if its serial number is a multiple of the sampling interval. The decision
+ * only depends on the message itself so every process on the path samples the same messages;
+ * stamps are matched up across processes by sender and serial number. Timestamps come from the
+ * system monotonic clock so the traces of processes on the same host line up.
+ *
+ * Tracing is enabled at AllJoynInit() time by setting ER_MESSAGE_TRACE to the sampling interval,
+ * e.g. ER_MESSAGE_TRACE=1 to trace every message. The trace is written at AllJoynShutdown() to the
+ * file named by ER_MESSAGE_TRACE_FILE, or alljoyn-trace-<pid>.json if that is not set. The file
+ * can be loaded in chrome://tracing or https://ui.perfetto.dev. ER_MESSAGE_TRACE_BUFFER sets how
+ * many stamps each thread keeps.
+ *
+ * A thread's buffer is handed over to the next thread that starts tracing once the thread exits,
+ * so the memory used is bounded by the number of threads tracing at the same time.
+ */
+class MessageTrace {
+  public:
+
+    /**
+     * The points on the message path that are stamped.
+     */
+    typedef enum {
+        MARSHAL,        /**< Message marshaled by the sender */
+        ROUTE,          /**< Message handed to the router (ClientRouter or DaemonRouter) */
+        TX_QUEUE,       /**< Message pushed to a remote endpoint's transmit queue */
+        TX_WRITE,       /**< Last byte of the message written to the remote endpoint's stream */
+        RX_UNMARSHAL,   /**< Message read and unmarshaled from a remote endpoint's stream */
+        LOCAL_QUEUE,    /**< Message pushed to the local endpoint for dispatch */
+        DISPATCH,       /**< Dispatcher started delivering the message to the application */
+        HANDLED,        /**< Method, signal or reply handler returned */
+        STAGE_COUNT
+    } Stage;
+
+    /**
+     * One stamp.
+     */
+    struct Event {
+        uint64_t timestampNs;       /**< Monotonic time of the stamp */
+        uint32_t serial;            /**< Serial number of the message */
+        uint32_t replySerial;       /**< Reply serial of method replies and errors, otherwise 0 */
+        uint32_t threadIndex;       /**< Index of the recording thread, see GetThreadName() */
+        uint8_t stage;              /**< Stage of the stamp */
+        uint8_t msgType;            /**< AllJoynMessageType of the message */
+        char sender[24];            /**< Sender of the message, truncated */
+        char member[38];            /**< Member name of the message, truncated */
+    };
+
+    /**
+     * Default number of stamps kept by each thread.
+     */
+    static const uint32_t DEFAULT_BUFFER_CAPACITY = 256;
+
+    /**
+     * Called from AllJoynInit() to apply ER_MESSAGE_TRACE, ER_MESSAGE_TRACE_FILE and ER_MESSAGE_TRACE_BUFFER.
+     */
+    static void Init();
+
+    /**
+     * Called from AllJoynShutdown() to write the trace file if tracing was enabled from the environment.
+     */
+    static void Shutdown();
+
+    /**
+     * Turn tracing on or off.
+     *
+     * @param enabled         true to start tracing.
+     * @param sampleInterval  Trace messages whose serial number is a multiple of sampleInterval, 1 traces all messages.
+     */
+    static void SetEnabled(bool enabled, uint32_t sampleInterval = 1);
+
+    /**
+     * Set the number of stamps kept by each thread, the oldest stamps are overwritten once a
+     * thread's buffer is full. Only applies to buffers allocated after the call.
+     *
+     * @param capacity  Number of stamps kept by each thread.
+     */
+    static void SetBufferCapacity(uint32_t capacity);
+
+    /**
+     * @return true if messages are being traced.
+     */
+    static bool IsEnabled() { return s_enabled; }
+
+    /**
+     * Discard all stamps recorded so far.
+     */
+    static void Reset();
+
+    /**
+     * Stamp a message at a stage of its path if tracing is enabled and the message is sampled.
+     *
+     * @param stage  The stage the message has reached.
+     * @param msg    The message.
+     */
+    static void Stamp(Stage stage, const _Message& msg)
+    {
+        if (s_enabled) {
+            Record(stage, msg);
+        }
+    }
+
+    /**
+     * Get the stamps recorded by all threads. Threads keep recording while the stamps are copied
+     * so the most recent stamps of a busy thread may be missing, and stamps overwritten while
+     * they are copied because the thread's buffer wrapped are left out.
+     *
+     * @param[out] events  The stamps ordered by time.
+     */
+    static void GetEvents(std::vector<Event>& events);
+
+    /**
+     * Get the name of the thread that recorded a stamp.
+     *
+     * @param threadIndex  Event::threadIndex of the stamp.
+     *
+     * @return  The qcc::Thread name of the recording thread.
+     */
+    static qcc::String GetThreadName(uint32_t threadIndex);
+
+    /**
+     * Get the number of per-thread buffers allocated so far.
+     *
+     * @return  The number of buffers.
+     */
+    static size_t GetBufferCount();
+
+    /**
+     * Get the name of a stage as it appears in the exported trace.
+     *
+     * @param stage  The stage.
+     *
+     * @return  The stage name.
+     */
+    static const char* GetStageName(Stage stage);
+
+    /**
+     * Format the recorded stamps as a Chrome trace event JSON document. Each message is an async
+     * slice spanning its first to its last stamp with an instant event per stage.
+     *
+     * @return  The JSON document.
+     */
+    static qcc::String ToJson();
+
+    /**
+     * Write the recorded stamps to a file as a Chrome trace event JSON document.
+     *
+     * @param fileName  Name of the file to write.
+     *
+     * @return
+     *      - ER_OK if the file was written.
+     *      - An error status otherwise.
+     */
+    static QStatus WriteJson(const qcc::String& fileName);
+
+  private:
+
+    class ThreadBuffer;
+
+    static void Record(Stage stage, const _Message& msg);
+
+    static ThreadBuffer* GetThreadBuffer();
+
+    static volatile bool s_enabled;
+    static volatile uint32_t s_sampleInterval;
+    static volatile int32_t s_generation;
+    static volatile int32_t s_threadCount;
+    static volatile uint32_t s_bufferCapacity;
+    static ThreadBuffer* s_buffers;
+    static qcc::String* s_traceFile;
+};
+
+}
+
+#endif
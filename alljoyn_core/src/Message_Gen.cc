@@ -55,6 +55,7 @@
 #include "AllJoynPeerObj.h"
 #include "SignatureUtils.h"
 #include "BusInternal.h"
+#include "MessageTrace.h"
 
 #define QCC_MODULE "ALLJOYN"
 
@@ -482,6 +483,22 @@ QStatus _Message::Deliver(RemoteEndpoint& endpoint)
         QCC_LogError(status, ("Message is empty"));
         return status;
     }
+    /*
+     * A message that skipped encryption for in-process delivery must not go over the wire.
+     */
+    if (IsEncryptionSkipped()) {
+        status = ER_BUS_MESSAGE_NOT_ENCRYPTED;
+        QCC_LogError(status, ("In-process message cannot be delivered to %s", endpoint->GetUniqueName().c_str()));
+        return status;
+    }
+    /*
+     * The body was not marshalled if the message was meant for an in-process destination.
+     */
+    status = MarshalDeferredBody();
+    if (status != ER_OK) {
+        return status;
+    }
+    buf = reinterpret_cast<uint8_t*>(msgBuf);
     /*
      * Handles can only be passed if that feature was negotiated.
      */
@@ -511,7 +528,11 @@ QStatus _Message::Deliver(RemoteEndpoint& endpoint)
         if (ER_PERMISSION_DENIED == status) {
             return status;
         }
-
+        /*
+         * Encryption may move the message to a private buffer and increases the packet length
+         */
+        buf = reinterpret_cast<uint8_t*>(msgBuf);
+        len = bufEOD - buf;
     }
     /*
      * Push the message to the endpoint sink (only push handles in the first chunk)
@@ -557,6 +578,21 @@ QStatus _Message::DeliverNonBlocking(RemoteEndpoint& endpoint)
             QCC_LogError(status, ("Message is empty"));
             return status;
         }
+        /*
+         * A message that skipped encryption for in-process delivery must not go over the wire.
+         */
+        if (IsEncryptionSkipped()) {
+            status = ER_BUS_MESSAGE_NOT_ENCRYPTED;
+            QCC_LogError(status, ("In-process message cannot be delivered to %s", endpoint->GetUniqueName().c_str()));
+            return status;
+        }
+        /*
+         * The body was not marshalled if the message was meant for an in-process destination.
+         */
+        status = MarshalDeferredBody();
+        if (status != ER_OK) {
+            return status;
+        }
         /*
          * Handles can only be passed if that feature was negotiated.
          */
@@ -591,6 +627,15 @@ QStatus _Message::DeliverNonBlocking(RemoteEndpoint& endpoint)
              */
             countWrite = bufEOD - writePtr;
         }
+        /*
+         * Compress large bodies on bus-to-bus connections that negotiated it. This is a copy
+         * of the queued message so the body is only compressed for this connection.
+         */
+        if (endpoint->GetFeatures().bodyCompression) {
+            CompressBody(endpoint->GetCompressThreshold());
+            writePtr = reinterpret_cast<uint8_t*>(msgBuf);
+            countWrite = bufEOD - writePtr;
+        }
         writeState = MESSAGE_HEADERFIELDS;
     /* no break  FALLTHROUGH*/
 
@@ -760,7 +805,7 @@ size_t _Message::ComputeHeaderLen()
     return ROUNDUP8(sizeof(msgHeader) + hdrLen);
 }
 
-QStatus _Message::EncryptMessage()
+QStatus _Message::EncryptMessage(bool inProcess)
 {
     KeyBlob key;
     PeerState peerState = bus->GetInternal().GetPeerStateTable()->GetPeerState(GetDestination());
@@ -802,9 +847,28 @@ QStatus _Message::EncryptMessage()
 
         QCC_ASSERT(0 <= GetAuthVersion());
 
+        if (inProcess) {
+            /*
+             * The message never leaves the process so the body stays in plain text. The receiver
+             * still performs the key and authorization checks before accepting the message.
+             */
+            QCC_DbgHLPrintf(("EncryptMessage: skipped for in-process delivery %s", Description().c_str()));
+            authMechanism = key.GetTag();
+            encrypt = false;
+            SetEncryptionSkipped();
+            NotifyEncryptionComplete();
+            return ER_OK;
+        }
+
+        status = MarshalDeferredBody();
+        if (status != ER_OK) {
+            return status;
+        }
+
         size_t hdrLen = ROUNDUP8(sizeof(msgHeader) + msgHeader.headerLen);
         size_t bodyLen = msgHeader.bodyLen;
 
+        UnshareMsgBuf();
         status = ajn::Crypto::Encrypt(*this, key, (uint8_t*)msgBuf, hdrLen, bodyLen);
         if (status == ER_OK) {
             QCC_DbgHLPrintf(("EncryptMessage: %s", Description().c_str()));
@@ -866,30 +930,12 @@ QStatus _Message::MarshalMessage(const qcc::String& expectedSignature,
     /*
      * We marshal new messages in native endianess
      */
-    encrypt = (flags & ALLJOYN_FLAG_ENCRYPTED) ? true : false;
     msgHeader.endian = outEndian;
     msgHeader.flags = flags;
     msgHeader.msgType = (uint8_t)msgType;
     msgHeader.majorVersion = ALLJOYN_MAJOR_PROTOCOL_VERSION;
 
-    /*
-     * If the encrypt flag is set and the peerState is secure, then the AuthVersion will be available.
-     */
-    PeerStateTable*peerStateTable = bus->GetInternal().GetPeerStateTable();
-    if (peerStateTable->IsKnownPeer(destination)) {
-        PeerState peerState = peerStateTable->GetPeerState(destination);
-        if (encrypt && peerState->IsSecure() && !destination.empty()) {
-            authVersion = (int32_t)(peerState->GetAuthVersion() >> 16);
-            QCC_ASSERT(0 <= authVersion);
-        }
-    }
-
-    /*
-     * Encryption will appends data to the message so we need to allocate more space in the buffer.
-     */
-    if (encrypt) {
-        maxCryptoValsLen = ajn::Crypto::MaxMACLength + ajn::Crypto::MaxExtraNonceLength;
-    }
+    maxCryptoValsLen = PrepareEncryption(destination, flags);
     msgHeader.bodyLen = static_cast<uint32_t>(argsLen);
 
     /*
@@ -979,8 +1025,7 @@ QStatus _Message::MarshalMessage(const qcc::String& expectedSignature,
      * Allocate buffer for entire message.
      */
     bufSize = (hdrLen + msgHeader.bodyLen + maxCryptoValsLen + 16);
-    _msgBuf = new uint8_t[bufSize];
-    msgBuf = (uint64_t*)((uintptr_t)(_msgBuf + 7) & ~7); /* Align to 8 byte boundary */
+    AllocMsgBuf(bufSize);
     /*
      * Initialize the buffer and copy in the message header
      */
@@ -1010,19 +1055,74 @@ QStatus _Message::MarshalMessage(const qcc::String& expectedSignature,
      */
     MarshalHeaderFields();
     QCC_ASSERT((bufPos - (uint8_t*)msgBuf) == static_cast<ptrdiff_t>(hdrLen));
-    if (msgHeader.bodyLen == 0) {
-        bufEOD = bufPos;
+    /*
+     * Marshal the message body, unless the message is for another bus attachment in this process
+     */
+    status = MarshalBody(args, numArgs, IsInProcessBody(destination, signature, flags));
+
+ExitMarshalMessage:
+
+    /*
+     * Don't need the old message buffer any more
+     */
+    ReleaseMsgBuf(_oldMsgBuf);
+
+    if (status == ER_OK) {
+        QCC_DbgHLPrintf(("MarshalMessage: %d+%d %s %s", hdrLen, msgHeader.bodyLen, Description().c_str(), encrypt ? " (encrypted)" : ""));
+        MessageTrace::Stamp(MessageTrace::MARSHAL, *this);
+    } else {
+        QCC_LogError(status, ("MarshalMessage: %s", Description().c_str()));
+        msgBuf = NULL;
+        ReleaseMsgBuf(_msgBuf);
+        _msgBuf = NULL;
         bodyPtr = NULL;
-        goto ExitMarshalMessage;
+        bufPos = NULL;
+        bufEOD = NULL;
+        ClearHeader();
     }
+    return status;
+}
 
+size_t _Message::PrepareEncryption(const qcc::String& destination, uint8_t flags)
+{
+    encrypt = (flags & ALLJOYN_FLAG_ENCRYPTED) ? true : false;
+    /*
+     * If the encrypt flag is set and the peerState is secure, then the AuthVersion will be available.
+     */
+    PeerStateTable*peerStateTable = bus->GetInternal().GetPeerStateTable();
+    if (peerStateTable->IsKnownPeer(destination)) {
+        PeerState peerState = peerStateTable->GetPeerState(destination);
+        if (encrypt && peerState->IsSecure() && !destination.empty()) {
+            authVersion = (int32_t)(peerState->GetAuthVersion() >> 16);
+            QCC_ASSERT(0 <= authVersion);
+        }
+    }
     /*
-     * Marshal the message body
+     * Encryption will appends data to the message so we need to allocate more space in the buffer.
      */
+    return encrypt ? (ajn::Crypto::MaxMACLength + ajn::Crypto::MaxExtraNonceLength) : 0;
+}
+
+QStatus _Message::MarshalBody(const MsgArg* args, uint8_t numArgs, bool deferBody)
+{
+    if (msgHeader.bodyLen == 0) {
+        bufEOD = bufPos;
+        bodyPtr = NULL;
+        return ER_OK;
+    }
     bodyPtr = bufPos;
-    status = MarshalArgs(args, numArgs);
-    if (status != ER_OK) {
-        goto ExitMarshalMessage;
+    QStatus status = ER_OK;
+    if (deferBody) {
+        /*
+         * Leave the space for the body, it is filled in by MarshalDeferredBody if needed.
+         */
+        SetBodyDeferred(true);
+        bufPos += msgHeader.bodyLen;
+    } else {
+        status = MarshalArgs(args, numArgs);
+        if (status != ER_OK) {
+            return status;
+        }
     }
     /*
      * If there handles to be marshalled we need to patch up the message header to add the
@@ -1033,13 +1133,13 @@ QStatus _Message::MarshalMessage(const qcc::String& expectedSignature,
         hdrFields.field[ALLJOYN_HDR_FIELD_HANDLES].Set("u", numHandles);
         status = ReMarshal(NULL);
         if (status != ER_OK) {
-            goto ExitMarshalMessage;
+            return status;
         }
     }
     /*
      * Assert that our two different body size computations agree
      */
-    QCC_ASSERT((bufPos - bodyPtr) == (ptrdiff_t)argsLen);
+    QCC_ASSERT((bufPos - bodyPtr) == (ptrdiff_t)msgHeader.bodyLen);
     bufEOD = bodyPtr + msgHeader.bodyLen;
 
     /* track the msgArgs so it can be used to check the ACLs for properties */
@@ -1054,29 +1154,57 @@ QStatus _Message::MarshalMessage(const qcc::String& expectedSignature,
         refMsgArgs = NULL;
     }
 
+    /*
+     * Carry the args with the message for an in-process destination so the receiver can adopt
+     * them instead of unmarshaling the body.
+     */
+    if (deferBody) {
+        CarryArgs(args, numArgs);
+    }
+
     while (numArgs--) {
         QCC_DbgPrintf(("\n%s\n", args->ToString().c_str()));
         ++args;
     }
+    return ER_OK;
+}
 
-ExitMarshalMessage:
-
+bool _Message::IsInProcessBody(const qcc::String& destination, const char* signature, uint8_t flags)
+{
     /*
-     * Don't need the old message buffer any more
+     * Sessionless messages are stored and may be delivered anywhere later, handles have to be
+     * marshalled to be duplicated.
      */
-    delete [] _oldMsgBuf;
+    if ((flags & ALLJOYN_FLAG_SESSIONLESS) || !*signature || strchr(signature, 'h')) {
+        return false;
+    }
+    return bus->GetInternal().IsInProcessDestination(destination);
+}
 
+QStatus _Message::MarshalDeferredBody()
+{
+    if (!IsBodyDeferred()) {
+        return ER_OK;
+    }
+    /*
+     * The receiver may already have adopted the carried args
+     */
+    uint8_t numCarried;
+    const MsgArg* args = GetCarriedArgs(numCarried);
+    size_t numArgs = numCarried;
+    if (!args) {
+        args = msgArgs;
+        numArgs = numMsgArgs;
+    }
+    UnshareMsgBuf();
+    bufPos = bodyPtr;
+    QStatus status = MarshalArgs(args, numArgs);
     if (status == ER_OK) {
-        QCC_DbgHLPrintf(("MarshalMessage: %d+%d %s %s", hdrLen, msgHeader.bodyLen, Description().c_str(), encrypt ? " (encrypted)" : ""));
+        QCC_ASSERT((bufPos - bodyPtr) == (ptrdiff_t)msgHeader.bodyLen);
+        QCC_DbgHLPrintf(("MarshalDeferredBody: %s", Description().c_str()));
+        SetBodyDeferred(false);
     } else {
-        QCC_LogError(status, ("MarshalMessage: %s", Description().c_str()));
-        msgBuf = NULL;
-        delete [] _msgBuf;
-        _msgBuf = NULL;
-        bodyPtr = NULL;
-        bufPos = NULL;
-        bufEOD = NULL;
-        ClearHeader();
+        QCC_LogError(status, ("MarshalDeferredBody: %s", Description().c_str()));
     }
     return status;
 }
@@ -1213,6 +1341,11 @@ QStatus _Message::CallMsg(const qcc::String& signature,
     if (flags & ~(ALLJOYN_FLAG_NO_REPLY_EXPECTED | ALLJOYN_FLAG_AUTO_START | ALLJOYN_FLAG_ENCRYPTED | 0x40 /* ALLJOYN_FLAG_COMPRESSED */ | ALLJOYN_FLAG_SESSIONLESS)) {
         return ER_BUS_BAD_HDR_FLAGS;
     }
+    /*
+     * The deprecated compression bit is accepted for compatibility but dropped, on bus-to-bus
+     * connections the same bit marks a compressed body.
+     */
+    flags &= ~BODY_COMPRESSED_FLAG;
     /*
      * Clear any stale header fields
      */
@@ -1262,6 +1395,226 @@ ExitCallMsg:
     return status;
 }
 
+QStatus _Message::CallTemplate(const qcc::String& signature,
+                               const qcc::String& destination,
+                               SessionId sessionId,
+                               const qcc::String& objPath,
+                               const qcc::String& iface,
+                               const qcc::String& methodName)
+{
+    if (!bus->IsStarted()) {
+        return ER_BUS_BUS_NOT_STARTED;
+    }
+    qcc::String sender = bus->GetInternal().GetLocalEndpoint()->GetUniqueName();
+    /*
+     * Clear any stale header fields
+     */
+    ClearHeader();
+    if (!IsLegalObjectPath(objPath.c_str())) {
+        return ER_BUS_BAD_OBJ_PATH;
+    }
+    if (destination.empty()) {
+        return ER_BUS_BAD_BUS_NAME;
+    }
+    if (signature.size() > 255) {
+        return ER_BUS_BAD_SIGNATURE;
+    }
+    hdrFields.field[ALLJOYN_HDR_FIELD_PATH].typeId = ALLJOYN_OBJECT_PATH;
+    hdrFields.field[ALLJOYN_HDR_FIELD_PATH].v_objPath.str = objPath.c_str();
+    hdrFields.field[ALLJOYN_HDR_FIELD_PATH].v_objPath.len = objPath.size();
+    hdrFields.field[ALLJOYN_HDR_FIELD_MEMBER].typeId = ALLJOYN_STRING;
+    hdrFields.field[ALLJOYN_HDR_FIELD_MEMBER].v_string.str = methodName.c_str();
+    hdrFields.field[ALLJOYN_HDR_FIELD_MEMBER].v_string.len = methodName.size();
+    if (!iface.empty()) {
+        hdrFields.field[ALLJOYN_HDR_FIELD_INTERFACE].typeId = ALLJOYN_STRING;
+        hdrFields.field[ALLJOYN_HDR_FIELD_INTERFACE].v_string.str = iface.c_str();
+        hdrFields.field[ALLJOYN_HDR_FIELD_INTERFACE].v_string.len = iface.size();
+    }
+    hdrFields.field[ALLJOYN_HDR_FIELD_DESTINATION].typeId = ALLJOYN_STRING;
+    hdrFields.field[ALLJOYN_HDR_FIELD_DESTINATION].v_string.str = destination.c_str();
+    hdrFields.field[ALLJOYN_HDR_FIELD_DESTINATION].v_string.len = destination.size();
+    if (!sender.empty()) {
+        hdrFields.field[ALLJOYN_HDR_FIELD_SENDER].typeId = ALLJOYN_STRING;
+        hdrFields.field[ALLJOYN_HDR_FIELD_SENDER].v_string.str = sender.c_str();
+        hdrFields.field[ALLJOYN_HDR_FIELD_SENDER].v_string.len = sender.size();
+    }
+    if (!signature.empty()) {
+        hdrFields.field[ALLJOYN_HDR_FIELD_SIGNATURE].typeId = ALLJOYN_SIGNATURE;
+        hdrFields.field[ALLJOYN_HDR_FIELD_SIGNATURE].v_signature.sig = signature.c_str();
+        hdrFields.field[ALLJOYN_HDR_FIELD_SIGNATURE].v_signature.len = (uint8_t)signature.size();
+    }
+    if (sessionId != 0) {
+        hdrFields.field[ALLJOYN_HDR_FIELD_SESSION_ID].typeId = ALLJOYN_UINT32;
+        hdrFields.field[ALLJOYN_HDR_FIELD_SESSION_ID].v_uint32 = sessionId;
+    }
+
+    endianSwap = outEndian != myEndian;
+    msgHeader.endian = outEndian;
+    msgHeader.flags = 0;
+    msgHeader.msgType = (uint8_t)MESSAGE_METHOD_CALL;
+    msgHeader.majorVersion = ALLJOYN_MAJOR_PROTOCOL_VERSION;
+    msgHeader.bodyLen = 0;
+    msgHeader.serialNum = 0;
+
+    uint8_t* _oldMsgBuf = _msgBuf;
+    bodyPtr = NULL;
+    msgBuf = NULL;
+    _msgBuf = NULL;
+    size_t hdrLen = ComputeHeaderLen();
+    bufSize = hdrLen + sizeof(uint64_t);
+    AllocMsgBuf(bufSize);
+    bufPos = (uint8_t*)msgBuf;
+    memcpy(bufPos, &msgHeader, sizeof(msgHeader));
+    if (endianSwap) {
+        ((MessageHeader*)msgBuf)->headerLen = EndianSwap32(msgHeader.headerLen);
+    }
+    bufPos += sizeof(msgHeader);
+    /*
+     * The string fields are relocated into the template buffer so the template does not
+     * depend on the lifetime of the values passed in.
+     */
+    MarshalHeaderFields();
+    QCC_ASSERT((bufPos - (uint8_t*)msgBuf) == static_cast<ptrdiff_t>(hdrLen));
+    bufEOD = bufPos;
+    ReleaseMsgBuf(_oldMsgBuf);
+    return ER_OK;
+}
+
+QStatus _Message::CallMsg(const _Message& callTemplate,
+                          const MsgArg* args,
+                          size_t numArgs,
+                          uint8_t flags)
+{
+    char signature[256];
+    QStatus status = ER_OK;
+
+    /*
+     * Same flags as the other CallMsg
+     */
+    if (flags & ~(ALLJOYN_FLAG_NO_REPLY_EXPECTED | ALLJOYN_FLAG_AUTO_START | ALLJOYN_FLAG_ENCRYPTED | 0x40 /* ALLJOYN_FLAG_COMPRESSED */ | ALLJOYN_FLAG_SESSIONLESS)) {
+        return ER_BUS_BAD_HDR_FLAGS;
+    }
+    /*
+     * The deprecated compression bit is accepted for compatibility but dropped, on bus-to-bus
+     * connections the same bit marks a compressed body.
+     */
+    flags &= ~BODY_COMPRESSED_FLAG;
+    if (!callTemplate.msgBuf || (callTemplate.msgHeader.msgType != MESSAGE_METHOD_CALL)) {
+        return ER_FAIL;
+    }
+    if (args == NULL) {
+        numArgs = 0;
+    }
+    /*
+     * The args must still match the signature in the template
+     */
+    signature[0] = 0;
+    if (numArgs > 0) {
+        size_t sigLen = 0;
+        status = SignatureUtils::MakeSignature(args, numArgs, signature, sigLen);
+        if (status != ER_OK) {
+            return status;
+        }
+    }
+    if (strcmp(signature, callTemplate.GetSignature()) != 0) {
+        status = ER_BUS_UNEXPECTED_SIGNATURE;
+        QCC_LogError(status, ("CallMsg expected signature \"%s\" got \"%s\"", callTemplate.GetSignature(), signature));
+        return status;
+    }
+    size_t argsLen = (numArgs == 0) ? 0 : SignatureUtils::GetSize(args, numArgs);
+    size_t hdrLen = sizeof(msgHeader) + ROUNDUP8(callTemplate.msgHeader.headerLen);
+    if ((hdrLen + argsLen) > ALLJOYN_MAX_PACKET_LEN) {
+        status = ER_BUS_BAD_BODY_LEN;
+        QCC_LogError(status, ("Message size %d exceeds maximum size", hdrLen + argsLen));
+        return status;
+    }
+    /*
+     * Clear any stale header fields
+     */
+    ClearHeader();
+    uint8_t* _oldMsgBuf = _msgBuf;
+    bodyPtr = NULL;
+    bufPos = NULL;
+    bufEOD = NULL;
+    msgBuf = NULL;
+    _msgBuf = NULL;
+
+    endianSwap = callTemplate.endianSwap;
+    msgHeader = callTemplate.msgHeader;
+    msgHeader.flags = flags;
+    msgHeader.bodyLen = static_cast<uint32_t>(argsLen);
+    size_t maxCryptoValsLen = PrepareEncryption(callTemplate.GetDestination(), flags);
+
+    bufSize = (hdrLen + msgHeader.bodyLen + maxCryptoValsLen + 16);
+    AllocMsgBuf(bufSize);
+    uint8_t* base = (uint8_t*)msgBuf;
+    const uint8_t* tmplBase = (const uint8_t*)callTemplate.msgBuf;
+    memcpy(base, tmplBase, hdrLen);
+    /*
+     * Point the header fields at the copies in this message's buffer
+     */
+    for (uint32_t fieldId = ALLJOYN_HDR_FIELD_PATH; fieldId < ArraySize(hdrFields.field); fieldId++) {
+        const MsgArg& src = callTemplate.hdrFields.field[fieldId];
+        MsgArg& dst = hdrFields.field[fieldId];
+        switch (src.typeId) {
+        case ALLJOYN_STRING:
+            dst.typeId = ALLJOYN_STRING;
+            dst.v_string.str = (const char*)base + ((const uint8_t*)src.v_string.str - tmplBase);
+            dst.v_string.len = src.v_string.len;
+            break;
+
+        case ALLJOYN_OBJECT_PATH:
+            dst.typeId = ALLJOYN_OBJECT_PATH;
+            dst.v_objPath.str = (const char*)base + ((const uint8_t*)src.v_objPath.str - tmplBase);
+            dst.v_objPath.len = src.v_objPath.len;
+            break;
+
+        case ALLJOYN_SIGNATURE:
+            dst.typeId = ALLJOYN_SIGNATURE;
+            dst.v_signature.sig = (const char*)base + ((const uint8_t*)src.v_signature.sig - tmplBase);
+            dst.v_signature.len = src.v_signature.len;
+            break;
+
+        case ALLJOYN_UINT32:
+            dst.typeId = ALLJOYN_UINT32;
+            dst.v_uint32 = src.v_uint32;
+            break;
+
+        default:
+            break;
+        }
+    }
+    /*
+     * Stamp the serial number, flags and body length into the copied header
+     */
+    SetSerialNumber();
+    MessageHeader* hdr = (MessageHeader*)msgBuf;
+    hdr->flags = flags ^ ALLJOYN_FLAG_AUTO_START;
+    hdr->bodyLen = endianSwap ? EndianSwap32(msgHeader.bodyLen) : msgHeader.bodyLen;
+    bufPos = base + hdrLen;
+    /*
+     * Marshal the message body, unless the message is for another bus attachment in this process
+     */
+    status = MarshalBody(args, numArgs, IsInProcessBody(callTemplate.GetDestination(), callTemplate.GetSignature(), flags));
+
+    ReleaseMsgBuf(_oldMsgBuf);
+
+    if (status == ER_OK) {
+        QCC_DbgHLPrintf(("CallMsg: %d+%d %s %s", hdrLen, msgHeader.bodyLen, Description().c_str(), encrypt ? " (encrypted)" : ""));
+        MessageTrace::Stamp(MessageTrace::MARSHAL, *this);
+    } else {
+        QCC_LogError(status, ("CallMsg: %s", Description().c_str()));
+        msgBuf = NULL;
+        ReleaseMsgBuf(_msgBuf);
+        _msgBuf = NULL;
+        bodyPtr = NULL;
+        bufPos = NULL;
+        bufEOD = NULL;
+        ClearHeader();
+    }
+    return status;
+}
+
 QStatus _Message::SignalMsg(const qcc::String& signature,
                             const char* destination,
                             SessionId sessionId,
@@ -1305,6 +1658,11 @@ QStatus _Message::SignalMsg(const qcc::String& signature,
     if (flags & ~(ALLJOYN_FLAG_ENCRYPTED | 0x40 /* ALLJOYN_FLAG_COMPRESSED */ | ALLJOYN_FLAG_GLOBAL_BROADCAST | ALLJOYN_FLAG_SESSIONLESS)) {
         return ER_BUS_BAD_HDR_FLAGS;
     }
+    /*
+     * The deprecated compression bit is accepted for compatibility but dropped, on bus-to-bus
+     * connections the same bit marks a compressed body.
+     */
+    flags &= ~BODY_COMPRESSED_FLAG;
     /*
      * Clear any stale header fields
      */
@@ -1606,6 +1964,7 @@ void _Message::SetSerialNumber(uint32_t serialNumber)
 {
     msgHeader.serialNum = serialNumber;
     if (msgBuf) {
+        UnshareMsgBuf();
         ((MessageHeader*)msgBuf)->serialNum = endianSwap ? EndianSwap32(msgHeader.serialNum) : msgHeader.serialNum;
     }
 }
@@ -582,6 +582,8 @@ QStatus _Message::UnmarshalArgs(PeerStateTable* peerStateTable,
     QStatus status = ER_OK;
     int _numMsgArgs = 0;
     MsgArg* _msgArgs = NULL;
+    const MsgArg* carriedArgs = NULL;
+    uint8_t numCarried = 0;
 
     /* Check if message body is already unmarshaled */
     if (msgArgs != NULL) {
@@ -659,19 +661,49 @@ QStatus _Message::UnmarshalArgs(PeerStateTable* peerStateTable,
         }
         QCC_ASSERT(0 <= authVersion);
 
-        QCC_DbgHLPrintf(("Decrypting message from %s", GetSender()));
-        /*
-         * Decryption will  make the body length  smaller because the encryption
-         * algorithm appends data to the end of the encrypted data.
-         */
-        size_t bodyLen = msgHeader.bodyLen;
-        status = ajn::Crypto::Decrypt(*this, key, (uint8_t*)msgBuf, hdrLen, bodyLen);
-        if (status != ER_OK) {
-            goto ExitUnmarshalArgs;
+        if (IsEncryptionSkipped()) {
+            /*
+             * The body was never encrypted because the message was routed in-process.
+             */
+            QCC_DbgHLPrintf(("Accepting in-process message from %s", GetSender()));
+        } else {
+            QCC_DbgHLPrintf(("Decrypting message from %s", GetSender()));
+            /*
+             * Decryption will  make the body length  smaller because the encryption
+             * algorithm appends data to the end of the encrypted data.
+             */
+            size_t bodyLen = msgHeader.bodyLen;
+            UnshareMsgBuf();
+            status = ajn::Crypto::Decrypt(*this, key, (uint8_t*)msgBuf, hdrLen, bodyLen);
+            if (status != ER_OK) {
+                goto ExitUnmarshalArgs;
+            }
+            msgHeader.bodyLen = static_cast<uint32_t>(bodyLen);
         }
-        msgHeader.bodyLen = static_cast<uint32_t>(bodyLen);
         authMechanism = key.GetTag();
     }
+    /*
+     * If the message was handed to us in-process adopt the args the sender marshalled from. They
+     * are checked against the signature in the header just like a parsed body would be.
+     */
+    carriedArgs = GetCarriedArgs(numCarried);
+    if (carriedArgs) {
+        if (MsgArg::Signature(carriedArgs, numCarried) != sig) {
+            status = ER_BUS_BAD_SIGNATURE;
+            QCC_LogError(status, ("In-process args do not match signature \"%s\"", sig));
+            goto ExitUnmarshalArgs;
+        }
+        _msgArgs = AdoptCarriedArgs(numCarried);
+        _numMsgArgs = numCarried;
+        goto ExitUnmarshalArgs;
+    }
+    /*
+     * The body is parsed from the buffer so it must be marshalled if it was deferred
+     */
+    status = MarshalDeferredBody();
+    if (status != ER_OK) {
+        goto ExitUnmarshalArgs;
+    }
     /*
      * Calculate how many arguments there are
      */
@@ -953,8 +985,7 @@ QStatus _Message::InterpretHeader()
      */
     bufSize = sizeof(msgHeader) + ((pktSize + 7) & ~7) + sizeof(uint64_t);
     QCC_ASSERT(_msgBuf == nullptr);
-    _msgBuf = new uint8_t[bufSize + 7];
-    msgBuf = (uint64_t*)((uintptr_t)(_msgBuf + 7) & ~7); /* Align to 8 byte boundary */
+    AllocMsgBuf(bufSize);
     /*
      * Copy header into the buffer
      */
@@ -1131,7 +1162,7 @@ QStatus _Message::Read(RemoteEndpoint& endpoint, bool checkSender, bool pedantic
      * Clear out any stale message state
      */
     msgBuf = NULL;
-    delete [] _msgBuf;
+    ReleaseMsgBuf(_msgBuf);
     _msgBuf = NULL;
     ClearHeader();
     readState = MESSAGE_NEW;
@@ -1153,6 +1184,27 @@ QStatus _Message::Unmarshal(RemoteEndpoint& endpoint, bool checkSender, bool ped
 {
     qcc::String endpointName = endpoint->GetUniqueName();
     bool handlePassing = endpoint->GetFeatures().handlePassing;
+    /*
+     * Bodies are only compressed on bus-to-bus connections that negotiated it
+     */
+    if ((msgHeader.flags & BODY_COMPRESSED_FLAG) && endpoint->GetFeatures().bodyCompression) {
+        QStatus status = ExpandBody();
+        if (status != ER_OK) {
+            QCC_LogError(status, ("Failed to expand compressed message body received on %s", endpointName.c_str()));
+            msgBuf = NULL;
+            ReleaseMsgBuf(_msgBuf);
+            _msgBuf = NULL;
+            ClearHeader();
+            return status;
+        }
+    } else if (msgHeader.flags & BODY_COMPRESSED_FLAG) {
+        /*
+         * Older applications may still set the deprecated header compression bit. The body is plain
+         * so drop the bit before the message can be forwarded to a connection where it has a meaning.
+         */
+        msgHeader.flags &= ~BODY_COMPRESSED_FLAG;
+        reinterpret_cast<MessageHeader*>(msgBuf)->flags &= ~BODY_COMPRESSED_FLAG;
+    }
     return Unmarshal(endpointName, handlePassing, checkSender, pedantic, timeout);
 }
 
@@ -1375,7 +1427,7 @@ ExitUnmarshal:
          * There was an unrecoverable failure while unmarshaling the message, cleanup before we return.
          */
         msgBuf = NULL;
-        delete [] _msgBuf;
+        ReleaseMsgBuf(_msgBuf);
         _msgBuf = NULL;
         ClearHeader();
         if ((status != ER_SOCK_OTHER_END_CLOSED) && (status != ER_STOPPING_THREAD)) {
@@ -80,7 +80,9 @@ typedef ManagedObj<_NullEndpoint> NullEndpoint;
  * The null endpoint simply moves messages between the daemon router to the client router and lets
  * the routers handle it from there. The only wrinkle is that messages forwarded to the routing node may
  * need to be encrypted because in the non-bundled case encryption is done in _Message::Deliver()
- * and that method does not get called in this case.
+ * and that method does not get called in this case. Messages that are destined for another bus
+ * attachment linked to the same bundled router never leave the process so they are not encrypted
+ * and the receiver adopts the args the sender marshalled from rather than unmarshaling the body.
  */
 class _NullEndpoint : public _BusEndpoint {
 
@@ -148,6 +150,19 @@ class _NullEndpoint : public _BusEndpoint {
         }
     }
 
+    /*
+     * Check if a message will be routed to another bus attachment linked in-process to the
+     * bundled router.
+     */
+    bool IsInProcessDestination(Message& msg)
+    {
+        if (!msg->HasDestination()) {
+            return false;
+        }
+        BusEndpoint ep = routerBus.GetInternal().GetRouter().FindEndpoint(msg->GetDestination());
+        return ep->IsValid() && (ep->GetEndpointType() == ENDPOINT_TYPE_NULL);
+    }
+
   private:
     /* Private assigment operator - does nothing */
     _NullEndpoint operator=(const _NullEndpoint&);
@@ -204,10 +219,10 @@ QStatus _NullEndpoint::PushMessage(Message& msg)
          * In the non-bundled case messages are encrypted when they are delivered to the routing node
          * endpoint by a call to Message::Deliver. The null transport bypasses Message::Deliver
          * by pushing the messages directly to the daemon router. This means we need to encrypt
-         * messages here before we do the push.
+         * messages here before we do the push unless the destination is in-process.
          */
         if (msg->encrypt) {
-            status = msg->EncryptMessage();
+            status = msg->EncryptMessage(IsInProcessDestination(msg));
             /* Report authorization failure as a security violation */
             if (status == ER_BUS_NOT_AUTHORIZED) {
                 clientBus.GetInternal().GetLocalEndpoint()->GetPeerObj()->HandleSecurityViolation(msg, status);
@@ -307,6 +322,11 @@ QStatus NullTransport::LinkBus(BusAttachment* otherBus)
      * Initialize the null endpoint
      */
     NullEndpoint ep(bus, *otherBus);
+    /*
+     * Both busses can now exchange messages without going through the wire format.
+     */
+    bus.GetInternal().EnableInProcessDelivery(*otherBus);
+    otherBus->GetInternal().EnableInProcessDelivery(*otherBus);
     /*
      * Register the null endpoint with the daemon router. The endpoint is registered with the client
      * router either below or in PushMessage if a message is received before the call to register
@@ -355,6 +375,7 @@ QStatus NullTransport::Disconnect(const char* connectSpec)
     if (endpoint->IsValid()) {
         NullEndpoint ep = NullEndpoint::cast(endpoint);
         QCC_ASSERT(routerLauncher);
+        ep->clientBus.GetInternal().DisableInProcessDelivery();
         ep->clientBus.GetInternal().GetRouter().UnregisterEndpoint(ep->GetUniqueName(), ep->GetEndpointType());
         ep->routerBus.GetInternal().GetRouter().UnregisterEndpoint(ep->GetUniqueName(), ep->GetEndpointType());
         ep->Invalidate();
@@ -289,7 +289,14 @@ void _PeerState::UpdateHash(bool initiator, uint32_t conversationVersion, const
         return;
     }
 
-    UpdateHash(initiator, conversationVersion, msg->GetBuffer(), msg->GetBufferSize());
+    /*
+     * Messages between in-process bus attachments may not have a marshalled body yet
+     */
+    Message hashed = msg;
+    if (hashed->MarshalDeferredBody() != ER_OK) {
+        return;
+    }
+    UpdateHash(initiator, conversationVersion, hashed->GetBuffer(), hashed->GetBufferSize());
 }
 
 void _PeerState::GetDigest(bool initiator, uint8_t* digest, bool keepAlive)
@@ -3227,17 +3227,9 @@ static bool MatchesPrefix(const qcc::String& str, const qcc::String& prefix)
     return !WildcardMatch(str, prefix);
 }
 
-QStatus PermissionMgmtObj::SendManifests(const ProxyBusObject* remotePeerObj, Message* msg)
+QStatus PermissionMgmtObj::SelectManifestsToSend(PeerState& peerState, Message* msg, vector<Manifest>& manifestsToSend, bool& sendManifests)
 {
-    if ((nullptr == remotePeerObj) && (nullptr == msg)) {
-        return ER_BAD_ARG_1;
-    }
-
-    const InterfaceDescription* ifc = bus.GetInterface(org::alljoyn::Bus::Peer::Authentication::InterfaceName);
-    if (ifc == nullptr) {
-        return ER_BUS_NO_SUCH_INTERFACE;
-    }
-
+    sendManifests = false;
     if (nullptr != msg) {
         /* Manifests only apply to method calls and signals. */
         AllJoynMessageType msgType = (*msg)->GetType();
@@ -3251,10 +3243,6 @@ QStatus PermissionMgmtObj::SendManifests(const ProxyBusObject* remotePeerObj, Me
         }
     }
 
-    AJ_PCSTR destination = ((nullptr != msg) ? (*msg)->GetDestination() : remotePeerObj->GetUniqueName().c_str());
-
-    PeerState peerState = bus.GetInternal().GetPeerStateTable()->GetPeerState(destination, false);
-
     /* This will be false for peers that aren't secure, and unknown peers.
      * In both cases, nothing to do.
      */
@@ -3271,8 +3259,8 @@ QStatus PermissionMgmtObj::SendManifests(const ProxyBusObject* remotePeerObj, Me
         return ER_OK;
     }
 
-    QCC_DbgTrace(("%s: passed early exit checks. Destination is %s, peer GUID is %s",
-                  __FUNCTION__, destination, peerState->GetGuid().ToString().c_str()));
+    QCC_DbgTrace(("%s: passed early exit checks. Peer GUID is %s",
+                  __FUNCTION__, peerState->GetGuid().ToString().c_str()));
 
     vector<Manifest> manifests;
     QStatus status = RetrieveManifests(manifests);
@@ -3284,8 +3272,6 @@ QStatus PermissionMgmtObj::SendManifests(const ProxyBusObject* remotePeerObj, Me
         }
     }
 
-    vector<Manifest> manifestsToSend;
-
     /* We don't have a copy of the message, probably because the app is calling SecureConnection
      * explicitly. This gives us no basis on which to send manifests.
      *
@@ -3364,6 +3350,44 @@ QStatus PermissionMgmtObj::SendManifests(const ProxyBusObject* remotePeerObj, Me
         return ER_OK;
     }
 
+    sendManifests = true;
+    return ER_OK;
+}
+
+QStatus PermissionMgmtObj::SendManifestsReply(Message& replyMsg, PeerState& peerState, const vector<Manifest>& manifestsSent)
+{
+    for (Manifest manifest : manifestsSent) {
+        QStatus status = peerState->StoreSentManifest(manifest);
+        if (status != ER_OK) {
+            return status;
+        }
+    }
+    /* process the reply */
+    return ParseSendManifests(replyMsg, peerState);
+}
+
+QStatus PermissionMgmtObj::SendManifests(const ProxyBusObject* remotePeerObj, Message* msg)
+{
+    if ((nullptr == remotePeerObj) && (nullptr == msg)) {
+        return ER_BAD_ARG_1;
+    }
+
+    const InterfaceDescription* ifc = bus.GetInterface(org::alljoyn::Bus::Peer::Authentication::InterfaceName);
+    if (ifc == nullptr) {
+        return ER_BUS_NO_SUCH_INTERFACE;
+    }
+
+    AJ_PCSTR destination = ((nullptr != msg) ? (*msg)->GetDestination() : remotePeerObj->GetUniqueName().c_str());
+
+    PeerState peerState = bus.GetInternal().GetPeerStateTable()->GetPeerState(destination, false);
+
+    vector<Manifest> manifestsToSend;
+    bool sendNeeded = false;
+    QStatus status = SelectManifestsToSend(peerState, msg, manifestsToSend, sendNeeded);
+    if ((status != ER_OK) || !sendNeeded) {
+        return status;
+    }
+
     MsgArg sendManifestsArg;
     status = _Manifest::GetArrayMsgArg(manifestsToSend, sendManifestsArg);
     if (ER_OK != status) {
@@ -3388,14 +3412,7 @@ QStatus PermissionMgmtObj::SendManifests(const ProxyBusObject* remotePeerObj, Me
     if (status != ER_OK) {
         return status;
     }
-    for (Manifest manifest : manifestsToSend) {
-        status = peerState->StoreSentManifest(manifest);
-        if (status != ER_OK) {
-            return status;
-        }
-    }
-    /* process the reply */
-    return ParseSendManifests(replyMsg, peerState);
+    return SendManifestsReply(replyMsg, peerState, manifestsToSend);
 }
 
 QStatus PermissionMgmtObj::AddMembershipsToPeerState(PeerState& peerState,
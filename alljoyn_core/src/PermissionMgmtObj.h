@@ -625,6 +625,31 @@ class PermissionMgmtObj : public BusObject {
      */
     QStatus SendManifests(const ProxyBusObject* remotePeerObj, Message* msg);
 
+    /**
+     * Select the manifests to send to a peer in advance of a message, the first half of
+     * SendManifests for callers that make the SendManifests method call themselves.
+     *
+     * @param[in] peerState The state of the peer the message is sent to.
+     * @param[in] msg The message about to be sent. If nullptr, no manifests are selected but the
+     *                call may still be needed to let the peer send its manifests.
+     * @param[out] manifestsToSend The manifests to send, possibly none.
+     * @param[out] sendManifests true if the SendManifests method call must be made.
+     *
+     * @return #ER_OK if successful; otherwise, an error code.
+     */
+    QStatus SelectManifestsToSend(PeerState& peerState, Message* msg, std::vector<Manifest>& manifestsToSend, bool& sendManifests);
+
+    /**
+     * Process the reply to a SendManifests method call, the second half of SendManifests.
+     *
+     * @param replyMsg The reply message.
+     * @param peerState The state of the peer the manifests were sent to.
+     * @param manifestsSent The manifests that were sent.
+     *
+     * @return ER_OK if successful; otherwise, an error code.
+     */
+    QStatus SendManifestsReply(Message& replyMsg, PeerState& peerState, const std::vector<Manifest>& manifestsSent);
+
     /**
      * Perform claiming of this app locally/offline.
      *
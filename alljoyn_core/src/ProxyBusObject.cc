@@ -346,6 +346,9 @@ class ProxyBusObject::Internal : public MessageReceiver, public BusAttachment::A
 
     /** Property changed handlers */
     multimap<std::string, PropertiesChangedCB> propertiesChangedCBs;
+
+    /** Method call headers prepared by PrepareMethodCall() */
+    mutable map<const InterfaceDescription::Member*, Message> callTemplates;
 };
 
 ProxyBusObject::Internal::~Internal()
@@ -2111,6 +2114,55 @@ QStatus ProxyBusObject::RemoveChild(const char* inPath)
 
 
 
+QStatus ProxyBusObject::PrepareMethodCall(const InterfaceDescription::Member& method) const
+{
+    if (!ImplementsInterface(method.iface->GetName())) {
+        QStatus status = ER_BUS_OBJECT_NO_SUCH_INTERFACE;
+        QCC_LogError(status, ("Object %s does not implement %s", internal->path.c_str(), method.iface->GetName()));
+        return status;
+    }
+    Message callTemplate(*internal->bus);
+    QStatus status = callTemplate->CallTemplate(method.signature, internal->serviceName, internal->sessionId, internal->path, method.iface->GetName(), method.name);
+    if (status == ER_OK) {
+        internal->lock.Lock(MUTEX_CONTEXT);
+        internal->callTemplates.erase(&method);
+        internal->callTemplates.insert(pair<const InterfaceDescription::Member*, Message>(&method, callTemplate));
+        internal->lock.Unlock(MUTEX_CONTEXT);
+    }
+    return status;
+}
+
+QStatus ProxyBusObject::BuildMethodCall(const InterfaceDescription::Member& method,
+                                        Message& msg,
+                                        const MsgArg* args,
+                                        size_t numArgs,
+                                        uint8_t flags) const
+{
+    Message callTemplate(*internal->bus);
+    bool prepared = false;
+    internal->lock.Lock(MUTEX_CONTEXT);
+    if (!internal->callTemplates.empty()) {
+        map<const InterfaceDescription::Member*, Message>::const_iterator it = internal->callTemplates.find(&method);
+        if (it != internal->callTemplates.end()) {
+            callTemplate = it->second;
+            prepared = true;
+        }
+    }
+    internal->lock.Unlock(MUTEX_CONTEXT);
+
+    if (prepared) {
+        /*
+         * The prepared header carries the sender so it is stale if the bus has since reconnected
+         * with a different unique name. Rebuild it for the next call and marshal this one in full.
+         */
+        if (internal->bus->GetUniqueName() == callTemplate->GetSender()) {
+            return msg->CallMsg(*callTemplate, args, numArgs, flags);
+        }
+        PrepareMethodCall(method);
+    }
+    return msg->CallMsg(method.signature, internal->serviceName, internal->sessionId, internal->path, method.iface->GetName(), method.name, args, numArgs, flags);
+}
+
 QStatus ProxyBusObject::MethodCallAsync(const InterfaceDescription::Member& method,
                                         MessageReceiver* receiver,
                                         MessageReceiver::ReplyHandler replyHandler,
@@ -2120,7 +2172,19 @@ QStatus ProxyBusObject::MethodCallAsync(const InterfaceDescription::Member& meth
                                         uint32_t timeout,
                                         uint8_t flags) const
 {
+    return MethodCallAsync(method, receiver, replyHandler, args, numArgs, context, timeout, flags, NULL);
+}
 
+QStatus ProxyBusObject::MethodCallAsync(const InterfaceDescription::Member& method,
+                                        MessageReceiver* receiver,
+                                        MessageReceiver::ReplyHandler replyHandler,
+                                        const MsgArg* args,
+                                        size_t numArgs,
+                                        void* context,
+                                        uint32_t timeout,
+                                        uint8_t flags,
+                                        Message* callMsg) const
+{
     QStatus status;
     Message msg(*internal->bus);
     LocalEndpoint localEndpoint = internal->bus->GetInternal().GetLocalEndpoint();
@@ -2148,8 +2212,15 @@ QStatus ProxyBusObject::MethodCallAsync(const InterfaceDescription::Member& meth
     if ((flags & ALLJOYN_FLAG_ENCRYPTED) && !internal->bus->IsPeerSecurityEnabled()) {
         return ER_BUS_SECURITY_NOT_ENABLED;
     }
-    status = msg->CallMsg(method.signature, internal->serviceName, internal->sessionId, internal->path, method.iface->GetName(), method.name, args, numArgs, flags);
+    status = BuildMethodCall(method, msg, args, numArgs, flags);
     if (status == ER_OK) {
+        /*
+         * Copy the call message before it is sent, the reply handler may run before this
+         * function returns.
+         */
+        if (NULL != callMsg) {
+            *callMsg = msg;
+        }
         if (!(flags & ALLJOYN_FLAG_NO_REPLY_EXPECTED)) {
             status = localEndpoint->RegisterReplyHandler(receiver, replyHandler, method, msg, context, timeout);
         }
@@ -2243,7 +2314,7 @@ QStatus ProxyBusObject::MethodCall(const InterfaceDescription::Member& method,
         status = ER_BUS_SECURITY_NOT_ENABLED;
         goto MethodCallExit;
     }
-    status = msg->CallMsg(method.signature, internal->serviceName, internal->sessionId, internal->path, method.iface->GetName(), method.name, args, numArgs, flags);
+    status = BuildMethodCall(method, msg, args, numArgs, flags);
     if (status != ER_OK) {
         goto MethodCallExit;
     }
@@ -52,6 +52,7 @@
 
 #include "AllJoynPeerObj.h"
 #include "BusInternal.h"
+#include "MessageTrace.h"
 
 #ifndef NDEBUG
 #include <qcc/time.h>
@@ -128,7 +129,16 @@ class _RemoteEndpoint::Internal {
         sendTimeout(0),
         maxControlMessages(30),
         numControlMessages(0),
-        numDataMessages(0)
+        numDataMessages(0),
+        txCoalescing(false),
+        txCorked(false),
+        txCorkMaxBytes(DEFAULT_TX_CORK_BYTES),
+        txCorkMaxMs(DEFAULT_TX_CORK_MS),
+        txCorkedBytes(0),
+        txCorkedTime(0),
+        txMessages(0),
+        txFlushes(0),
+        compressThreshold(0)
     {
     }
 
@@ -180,6 +190,15 @@ class _RemoteEndpoint::Internal {
                                                   - used on Routing nodes only */
     volatile size_t numControlMessages;      /**< Number of control messages in txQueue - used on Routing nodes only */
     volatile size_t numDataMessages;         /**< Number of data messages in txQueue - used on Routing nodes only */
+    bool txCoalescing;                       /**< True to cork the stream during bursts of signals */
+    bool txCorked;                           /**< True while the stream is corked */
+    size_t txCorkMaxBytes;                   /**< Bytes written while corked after which the stream is flushed */
+    uint32_t txCorkMaxMs;                    /**< Time in ms after corking after which the stream is flushed */
+    size_t txCorkedBytes;                    /**< Bytes written since the stream was corked */
+    uint64_t txCorkedTime;                   /**< Timestamp when the stream was corked */
+    uint64_t txMessages;                     /**< Number of messages written */
+    uint64_t txFlushes;                      /**< Number of times written data was pushed out rather than held back */
+    size_t compressThreshold;                /**< Smallest message body to compress, 0 to never compress */
   private:
     Internal& operator=(const Internal&);
 };
@@ -227,6 +246,57 @@ const qcc::String& _RemoteEndpoint::GetRemoteName() const
     }
 }
 
+size_t _RemoteEndpoint::GetTxQueueDepth() const
+{
+    if (internal) {
+        /*
+         * The counters are only changed with internal->lock held but are read here without
+         * it, so the sum can be off by a message that is being queued or sent right now.
+         * Callers only use it to spread new senders over parallel routes, where a stale
+         * value just means a less balanced choice. Taking the lock would serialize route
+         * selection with the writer thread of every candidate endpoint.
+         */
+        return internal->numControlMessages + internal->numDataMessages;
+    } else {
+        return 0;
+    }
+}
+
+void _RemoteEndpoint::SetTxCoalescing(bool enable, size_t maxCorkBytes, uint32_t maxCorkMs)
+{
+    if (internal) {
+        internal->lock.Lock(MUTEX_CONTEXT);
+        internal->txCoalescing = enable;
+        internal->txCorkMaxBytes = maxCorkBytes;
+        internal->txCorkMaxMs = maxCorkMs;
+        internal->lock.Unlock(MUTEX_CONTEXT);
+    }
+}
+
+void _RemoteEndpoint::SetCompressThreshold(size_t threshold)
+{
+    if (internal) {
+        internal->compressThreshold = threshold;
+    }
+}
+
+size_t _RemoteEndpoint::GetCompressThreshold() const
+{
+    return internal ? internal->compressThreshold : 0;
+}
+
+void _RemoteEndpoint::GetTxStats(uint64_t& messages, uint64_t& flushes) const
+{
+    messages = 0;
+    flushes = 0;
+    if (internal) {
+        internal->lock.Lock(MUTEX_CONTEXT);
+        messages = internal->txMessages;
+        flushes = internal->txFlushes;
+        internal->lock.Unlock(MUTEX_CONTEXT);
+    }
+}
+
 void _RemoteEndpoint::SetRemoteName(const qcc::String& remoteName)
 {
     if (internal) {
@@ -793,6 +863,7 @@ QStatus _RemoteEndpoint::ReadCallback(qcc::Source& source, bool isTimedOut)
                 status = msg->Unmarshal(rep, (internal->validateSender && !bus2bus));
                 switch (status) {
                 case ER_OK:
+                    MessageTrace::Stamp(MessageTrace::RX_UNMARSHAL, *msg);
                     internal->idleTimeoutCount = 0;
                     bool isAck;
                     if ((internal->pingCallSerial != 0) &&
@@ -1059,13 +1130,55 @@ QStatus _RemoteEndpoint::WriteCallback(qcc::Sink& sink, bool isTimedOut)
         if (internal->getNextMsg) {
             if (!internal->txQueue.empty()) {
                 /*
-                 * Make a deep copy of the message since there is state
+                 * Make a copy of the message since there is state
                  * information inside the message.  Each copy of the message
-                 * could be in different write state.
+                 * could be in different write state.  The copy shares the
+                 * marshalled bytes with the queued message.
                  */
                 internal->currentWriteMsg = Message(internal->txQueue.back(), true);
                 internal->getNextMsg = false;
+                if (internal->txCoalescing) {
+                    /*
+                     * Hold back a signal that has more messages queued behind it, anything
+                     * else (method calls and replies in particular) goes out at once. The
+                     * transmit queue only holds a message or two so senders blocked in
+                     * PushMessage() count as queued messages too.
+                     */
+                    bool more = (internal->txQueue.size() > 1) || !internal->txWaitQueue.empty();
+                    bool cork = (internal->currentWriteMsg->GetType() == MESSAGE_SIGNAL) && more;
+                    if (cork && internal->txCorked &&
+                        ((internal->txCorkedBytes >= internal->txCorkMaxBytes) ||
+                         ((GetTimestamp64() - internal->txCorkedTime) >= internal->txCorkMaxMs))) {
+                        /*
+                         * A long burst is flushed in pieces so its first signals are not held
+                         * back until the whole burst has been written.
+                         */
+                        if (internal->stream->SetCork(false) == ER_OK) {
+                            internal->txCorked = false;
+                            internal->txFlushes++;
+                        }
+                    }
+                    if ((cork != internal->txCorked) && (internal->stream->SetCork(cork) == ER_OK)) {
+                        internal->txCorked = cork;
+                        if (cork) {
+                            internal->txCorkedBytes = 0;
+                            internal->txCorkedTime = GetTimestamp64();
+                        } else {
+                            internal->txFlushes++;
+                        }
+                    }
+                }
             } else {
+                if (internal->txCorked && internal->txWaitQueue.empty()) {
+                    /*
+                     * The burst is over, flush it. While senders are still blocked in
+                     * PushMessage() the next message is on its way so the stream stays corked,
+                     * the kernel still flushes held back data after a short delay.
+                     */
+                    internal->stream->SetCork(false);
+                    internal->txCorked = false;
+                    internal->txFlushes++;
+                }
                 internal->bus.GetInternal().GetIODispatch().DisableWriteCallback(internal->stream);
                 if (internal->txWaitQueue.empty()) {
                     switch (internal->state) {
@@ -1130,8 +1243,15 @@ QStatus _RemoteEndpoint::WriteCallback(qcc::Sink& sink, bool isTimedOut)
         internal->lock.Lock(MUTEX_CONTEXT);
         if (status == ER_OK) {
             /* Message has been successfully delivered. i.e. PushBytes is complete */
+            MessageTrace::Stamp(MessageTrace::TX_WRITE, *internal->currentWriteMsg);
             internal->txQueue.pop_back();
             internal->getNextMsg = true;
+            internal->txMessages++;
+            if (internal->txCorked) {
+                internal->txCorkedBytes += internal->currentWriteMsg->GetBufferSize();
+            } else {
+                internal->txFlushes++;
+            }
             if (internal->bus.GetInternal().GetRouter().IsDaemon()) {
                 if (IsControlMessage(internal->currentWriteMsg)) {
                     QCC_ASSERT(internal->numControlMessages > 0);
@@ -1193,6 +1313,8 @@ QStatus _RemoteEndpoint::PushMessage(Message& msg)
         return ER_BUS_NO_ENDPOINT;
     }
 
+    MessageTrace::Stamp(MessageTrace::TX_QUEUE, *msg);
+
     internal->lock.Lock(MUTEX_CONTEXT);
 
     count = internal->txQueue.size();
@@ -76,7 +76,7 @@ class _RemoteEndpoint : public _BusEndpoint, public qcc::ThreadListener, public
       public:
 
         Features() : isBusToBus(false), allowRemote(false), handlePassing(false), ajVersion(0), protocolVersion(0),
-            processId(0), trusted(false), nameTransfer(SessionOpts::P2P_NAMES)
+            processId(0), trusted(false), nameTransfer(SessionOpts::P2P_NAMES), bodyCompression(false)
         { }
 
         bool isBusToBus;       /**< When initiating connection this is an input value indicating if this is a bus-to-bus connection.
@@ -99,6 +99,9 @@ class _RemoteEndpoint : public _BusEndpoint, public qcc::ThreadListener, public
 
         SessionOpts::NameTransferType nameTransfer; /**< The name transfer type set up for this endpoint */
 
+        bool bodyCompression;      /**< Indicates if both ends of a bus-to-bus connection can expand LZ4 compressed
+                                        message bodies. Negotiated during authentication. */
+
     };
 
     /**
@@ -287,6 +290,65 @@ class _RemoteEndpoint : public _BusEndpoint, public qcc::ThreadListener, public
      */
     virtual const qcc::String& GetRemoteName() const;
 
+    /**
+     * Get the number of messages waiting in the transmit queue of this endpoint. Only
+     * maintained on routing nodes. The value is read without taking the endpoint lock so
+     * it can be off by the message being queued or sent concurrently. It is meant as a
+     * hint for load balancing, not as an exact count.
+     *
+     * @return  The number of queued control and data messages.
+     */
+    virtual size_t GetTxQueueDepth() const;
+
+    /**
+     * Default limits on how much of a signal burst is held back before it is flushed.
+     */
+    static const size_t DEFAULT_TX_CORK_BYTES = 16384;
+    static const uint32_t DEFAULT_TX_CORK_MS = 10;
+
+    /**
+     * Enable or disable coalescing of signal bursts on the transmit side. While enabled, a
+     * signal that has more messages queued behind it, or senders blocked waiting for room in
+     * the queue, is written with the stream corked so that a burst leaves in full frames. The
+     * stream is uncorked, and the burst flushed, as soon as the queue drains with no sender
+     * waiting or any other kind of message is about to be written. A long burst is flushed
+     * whenever the data held back reaches maxCorkBytes or has been held for maxCorkMs, so the
+     * start of the burst is not delayed until its end. Has no effect on streams that do not
+     * support corking.
+     *
+     * @param enable        true to coalesce signal bursts.
+     * @param maxCorkBytes  Bytes written while corked after which the burst is flushed.
+     * @param maxCorkMs     Milliseconds after corking after which the burst is flushed.
+     */
+    void SetTxCoalescing(bool enable, size_t maxCorkBytes = DEFAULT_TX_CORK_BYTES, uint32_t maxCorkMs = DEFAULT_TX_CORK_MS);
+
+    /**
+     * Get transmit counters for this endpoint.
+     *
+     * @param[out] messages  Number of messages written to the stream.
+     * @param[out] flushes   Number of times written data was pushed out rather than held
+     *                       back. flushes / messages approximates the segments per message.
+     */
+    void GetTxStats(uint64_t& messages, uint64_t& flushes) const;
+
+    /**
+     * Set the smallest message body that is compressed when written to this endpoint. Bodies
+     * are only compressed if compression was negotiated when the bus-to-bus connection was
+     * established. Must be called before the endpoint is started.
+     *
+     * @param threshold  Body length in bytes at or above which bodies are compressed, 0 to
+     *                   never compress.
+     */
+    void SetCompressThreshold(size_t threshold);
+
+    /**
+     * Get the smallest message body that is compressed when written to this endpoint.
+     *
+     * @return  The body length at or above which bodies are compressed or 0 if compression
+     *          is off for this endpoint.
+     */
+    size_t GetCompressThreshold() const;
+
     /**
      * Set the bus name for the peer at the remote end of this endpoint.
      *
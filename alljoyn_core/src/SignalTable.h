@@ -44,6 +44,7 @@
 #include <vector>
 
 #include <qcc/String.h>
+#include <qcc/StringMapKey.h>
 #include <qcc/Mutex.h>
 
 #include <alljoyn/InterfaceDescription.h>
@@ -68,14 +69,14 @@ class SignalTable {
      * Type definition for signal hash table key
      */
     struct Key {
-        std::string iface;                /**< The Interface name */
-        std::string signalName;           /**< The signal name */
+        qcc::StringMapKey iface;          /**< The Interface name */
+        qcc::StringMapKey signalName;     /**< The signal name */
 
         /**
-         * Constructor used for lookups only (no storage)
+         * Constructor used for lookups only (no storage, borrows the strings)
          */
         Key(const char* ifc, const char* sig)
-            : iface(ifc), signalName(sig) { }
+            : iface(qcc::StringMapKey::Borrow(ifc)), signalName(qcc::StringMapKey::Borrow(sig)) { }
 
         /**
          * Constructor used for storage into hash table (no dangling char*)
@@ -112,14 +113,8 @@ class SignalTable {
     struct Hash {
         /** Calculate hash for Key k */
         size_t operator()(const Key& k) const {
-            size_t hash = 0;
-            for (const char* p = k.signalName.c_str(); *p; ++p) {
-                hash = *p + hash * 11;
-            }
-            for (const char* p = k.iface.c_str(); *p; ++p) {
-                hash += *p * 7;
-            }
-            return hash;
+            qcc::StringMapKey::Hash hash;
+            return hash(k.signalName) * 11 + hash(k.iface);
         }
     };
 
@@ -127,8 +122,7 @@ class SignalTable {
     struct Equal {
         /** Return true two keys are equal */
         bool operator()(const Key& k1, const Key& k2) const {
-            return (0 == strcmp(k1.iface.c_str(), k2.iface.c_str())) && \
-                   (0 == strcmp(k1.signalName.c_str(), k2.signalName.c_str()));
+            return (k1.iface == k2.iface) && (k1.signalName == k2.signalName);
         }
     };
 
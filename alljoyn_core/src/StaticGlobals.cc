@@ -40,6 +40,7 @@
 #include "AutoPingerInternal.h"
 #include "BusInternal.h"
 #include "KeyStoreListener.h"
+#include "MessageTrace.h"
 #include "NamedPipeClientTransport.h"
 #include "ProtectedAuthListener.h"
 #include "XmlManifestTemplateConverter.h"
@@ -73,10 +74,12 @@ class StaticGlobals {
         XmlRulesConverter::Init();
         XmlRulesValidator::Init();
         PermissionPolicyInit();
+        MessageTrace::Init();
     }
 
     static void Shutdown()
     {
+        MessageTrace::Shutdown();
         PermissionPolicyShutdown();
         XmlRulesValidator::Shutdown();
         XmlRulesConverter::Shutdown();
@@ -172,8 +172,7 @@ class DefaultKeyStoreListener : public KeyStoreListener {
             std::vector<uint8_t, SecureAllocator<uint8_t> > sbuf;        /**< storage for byte stream */
         };
 
-        FileLock writeLock;
-        QStatus status = fileLocker.GetFileLockForWrite(&writeLock);
+        QStatus status = fileLocker.HasWriteLock() ? ER_OK : ER_BUS_NOT_ALLOWED;
         if (status == ER_OK) {
             BufferSink buffer;
             status = keyStore.Push(buffer);
@@ -181,20 +180,15 @@ class DefaultKeyStoreListener : public KeyStoreListener {
                 QCC_LogError(status, ("StoreRequest error during data buffering"));
                 return status;
             }
-            size_t pushed = 0;
-            status = writeLock.GetSink()->PushBytes(buffer.GetBuffer().data(), buffer.GetBuffer().size(), pushed);
+            /*
+             * Write the whole key store to a new file and rename it over the old one so a crash
+             * part way through the write never leaves a truncated key store behind.
+             */
+            status = fileLocker.ReplaceFile(buffer.GetBuffer().data(), buffer.GetBuffer().size());
             if (status != ER_OK) {
                 QCC_LogError(status, ("StoreRequest error during data saving"));
                 return status;
             }
-            if (pushed != buffer.GetBuffer().size()) {
-                status = ER_BUS_CORRUPT_KEYSTORE;
-                QCC_LogError(status, ("StoreRequest failed to save data correctly"));
-                return status;
-            }
-            if (!writeLock.GetSink()->Truncate()) {
-                QCC_LogError(ER_WARNING, ("FileSink::Truncate failed"));
-            }
             QCC_DbgHLPrintf(("Wrote key store to %s", fileLocker.GetFileName()));
         } else {
             QCC_LogError(status, ("Failed to store request - write lock has not been taken, status=(%#x)", status));
@@ -0,0 +1,881 @@
+/* ajload - end-to-end latency and throughput load generator */
+
+/******************************************************************************
+ *    Copyright (c) Open Connectivity Foundation (OCF), AllJoyn Open Source
+ *    Project (AJOSP) Contributors and others.
+ *
+ *    SPDX-License-Identifier: Apache-2.0
+ *
+ *    All rights reserved. This program and the accompanying materials are
+ *    made available under the terms of the Apache License, Version 2.0
+ *    which accompanies this distribution, and is available at
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Copyright (c) Open Connectivity Foundation and Contributors to AllSeen
+ *    Alliance. All rights reserved.
+ *
+ *    Permission to use, copy, modify, and/or distribute this software for
+ *    any purpose with or without fee is hereby granted, provided that the
+ *    above copyright notice and this permission notice appear in all
+ *    copies.
+ *
+ *    THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+ *    WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+ *    WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ *    AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ *    DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ *    PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+ *    TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ *    PERFORMANCE OF THIS SOFTWARE.
+ ******************************************************************************/
+#include <qcc/platform.h>
+
+#include <inttypes.h>
+#include <math.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <chrono>
+#include <map>
+#include <vector>
+
+#include <qcc/Condition.h>
+#include <qcc/Debug.h>
+#include <qcc/Mutex.h>
+#include <qcc/String.h>
+#include <qcc/StringUtil.h>
+#include <qcc/Thread.h>
+#include <qcc/Util.h>
+#include <qcc/time.h>
+
+#include <alljoyn/AuthListener.h>
+#include <alljoyn/BusAttachment.h>
+#include <alljoyn/BusObject.h>
+#include <alljoyn/Init.h>
+#include <alljoyn/KeyStoreListener.h>
+#include <alljoyn/MsgArg.h>
+#include <alljoyn/ProxyBusObject.h>
+#include <alljoyn/version.h>
+
+#include <alljoyn/Status.h>
+
+#define QCC_MODULE "ALLJOYN"
+
+using namespace std;
+using namespace qcc;
+using namespace ajn;
+
+namespace org {
+namespace alljoyn {
+namespace load_test {
+const char* Interface = "org.alljoyn.load_test";
+const char* Path = "/org/alljoyn/load_test";
+}
+}
+}
+
+static const char ifcXML[] =
+    "<node name=\"/org/alljoyn/load_test\">"
+    "  <interface name=\"org.alljoyn.load_test\">"
+    "    <method name=\"Call\">"
+    "      <arg name=\"timestamp\" type=\"t\" direction=\"in\"/>"
+    "      <arg name=\"payload\" type=\"ay\" direction=\"in\"/>"
+    "      <arg name=\"timestamp\" type=\"t\" direction=\"out\"/>"
+    "    </method>"
+    "    <signal name=\"Data\">"
+    "      <arg name=\"timestamp\" type=\"t\"/>"
+    "      <arg name=\"payload\" type=\"ay\"/>"
+    "    </signal>"
+    "  </interface>"
+    "</node>";
+
+static const char secureIfcXML[] =
+    "<node name=\"/org/alljoyn/load_test\">"
+    "  <interface name=\"org.alljoyn.load_test\">"
+    "    <annotation name=\"org.alljoyn.Bus.Secure\" value=\"true\"/>"
+    "    <method name=\"Call\">"
+    "      <arg name=\"timestamp\" type=\"t\" direction=\"in\"/>"
+    "      <arg name=\"payload\" type=\"ay\" direction=\"in\"/>"
+    "      <arg name=\"timestamp\" type=\"t\" direction=\"out\"/>"
+    "    </method>"
+    "    <signal name=\"Data\">"
+    "      <arg name=\"timestamp\" type=\"t\"/>"
+    "      <arg name=\"payload\" type=\"ay\"/>"
+    "    </signal>"
+    "  </interface>"
+    "</node>";
+
+static volatile sig_atomic_t g_interrupt = false;
+
+static void CDECL_CALL SigIntHandler(int sig)
+{
+    QCC_UNUSED(sig);
+    g_interrupt = true;
+}
+
+/** Monotonic time in nanoseconds, producers and consumers share the clock since they are in one process */
+static uint64_t NowNs()
+{
+    return (uint64_t)chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/**
+ * Latency histogram in the style of HdrHistogram. Values are grouped into power of two ranges
+ * each divided into 2^SUB_BITS linear sub-buckets so every recorded value is kept to within
+ * 1/2^SUB_BITS (about 0.2%) of its true value with a fixed memory footprint. Values beyond
+ * MAX_VALUE are clamped.
+ */
+class Histogram {
+  public:
+    static const uint32_t SUB_BITS = 9;
+    static const uint32_t SUB_COUNT = 1 << SUB_BITS;
+    static const uint32_t MAX_BITS = 40;  /* ~18 minutes in ns */
+    static const uint64_t MAX_VALUE = ((uint64_t)1 << MAX_BITS) - 1;
+
+    Histogram() : counts(Index(MAX_VALUE) + 1, 0) { Reset(); }
+
+    void Reset()
+    {
+        memset(&counts[0], 0, counts.size() * sizeof(counts[0]));
+        total = 0;
+        sum = 0;
+        min = MAX_VALUE;
+        max = 0;
+    }
+
+    void Record(uint64_t value)
+    {
+        if (value > MAX_VALUE) {
+            value = MAX_VALUE;
+        }
+        ++counts[Index(value)];
+        ++total;
+        sum += value;
+        min = (std::min)(min, value);
+        max = (std::max)(max, value);
+    }
+
+    void Merge(const Histogram& other)
+    {
+        for (size_t i = 0; i < counts.size(); ++i) {
+            counts[i] += other.counts[i];
+        }
+        total += other.total;
+        sum += other.sum;
+        min = (std::min)(min, other.min);
+        max = (std::max)(max, other.max);
+    }
+
+    uint64_t Count() const { return total; }
+    uint64_t Min() const { return total ? min : 0; }
+    uint64_t Max() const { return max; }
+    double Mean() const { return total ? (double)sum / total : 0.0; }
+
+    /**
+     * @param percentile  Percentile in the range 0 to 100.
+     *
+     * @return The highest value equivalent to the value at the percentile.
+     */
+    uint64_t ValueAtPercentile(double percentile) const
+    {
+        if (total == 0) {
+            return 0;
+        }
+        uint64_t target = (uint64_t)ceil((percentile / 100.0) * total);
+        if (target == 0) {
+            target = 1;
+        }
+        uint64_t seen = 0;
+        for (size_t i = 0; i < counts.size(); ++i) {
+            seen += counts[i];
+            if (seen >= target) {
+                return (std::min)(HighestEquivalent(i), max);
+            }
+        }
+        return max;
+    }
+
+  private:
+
+    static uint32_t Msb(uint64_t v)
+    {
+        uint32_t n = 0;
+        while (v >>= 1) {
+            ++n;
+        }
+        return n;
+    }
+
+    /*
+     * Values below 2 * SUB_COUNT map directly to an index. Above that, the bucket number b is
+     * how far the value has to be shifted right to fit in [SUB_COUNT, 2 * SUB_COUNT).
+     */
+    static size_t Index(uint64_t v)
+    {
+        uint32_t msb = Msb(v);
+        uint32_t b = (msb > SUB_BITS) ? msb - SUB_BITS : 0;
+        return (size_t)(b * SUB_COUNT + (v >> b));
+    }
+
+    static uint64_t HighestEquivalent(size_t index)
+    {
+        uint32_t b = (index < 2 * SUB_COUNT) ? 0 : (uint32_t)(index / SUB_COUNT) - 1;
+        uint64_t low = (uint64_t)(index - b * SUB_COUNT) << b;
+        return low + ((uint64_t)1 << b) - 1;
+    }
+
+    std::vector<uint32_t> counts;
+    uint64_t total;
+    uint64_t sum;
+    uint64_t min;
+    uint64_t max;
+};
+
+/** Run configuration */
+struct Config {
+    uint32_t producers;
+    uint32_t consumers;
+    uint32_t callPercent;
+    vector<size_t> payloadSizes;
+    uint32_t window;
+    uint32_t warmupMs;
+    uint32_t durationMs;
+    bool secure;
+    String transport;
+    String connectSpec;
+    String outFile;
+
+    Config() :
+        producers(1), consumers(1), callPercent(50), window(8), warmupMs(1000), durationMs(10000),
+        secure(false), transport("null")
+    { }
+};
+
+static Config g_config;
+
+/*
+ * Keeps the key store in memory so runs with security enabled do not touch the file system.
+ */
+class MemoryKeyStoreListener : public KeyStoreListener {
+  public:
+    QStatus LoadRequest(KeyStore& keyStore)
+    {
+        lock.Lock(MUTEX_CONTEXT);
+        QStatus status = PutKeys(keyStore, keys, "ajload");
+        lock.Unlock(MUTEX_CONTEXT);
+        return status;
+    }
+
+    QStatus StoreRequest(KeyStore& keyStore)
+    {
+        lock.Lock(MUTEX_CONTEXT);
+        QStatus status = GetKeys(keyStore, keys);
+        lock.Unlock(MUTEX_CONTEXT);
+        return status;
+    }
+
+  private:
+    Mutex lock;
+    String keys;
+};
+
+/*
+ * Bus attachment setup common to producers and consumers.
+ */
+class Peer {
+  public:
+    Peer(const String& name) : msgBus(name.c_str(), true) { }
+
+    virtual ~Peer() { }
+
+    QStatus Init()
+    {
+        QStatus status = msgBus.Start();
+        if (status == ER_OK) {
+            status = msgBus.CreateInterfacesFromXml(g_config.secure ? secureIfcXML : ifcXML);
+        }
+        if ((status == ER_OK) && g_config.secure) {
+            status = msgBus.RegisterKeyStoreListener(keyStore);
+            if (status == ER_OK) {
+                status = msgBus.EnablePeerSecurity("ALLJOYN_ECDHE_NULL", &authListener, NULL, false);
+            }
+        }
+        if (status == ER_OK) {
+            status = RegisterObjects();
+        }
+        if (status == ER_OK) {
+            status = msgBus.Connect(g_config.connectSpec.c_str());
+        }
+        if (status == ER_OK) {
+            status = Connected();
+        }
+        return status;
+    }
+
+    void Shutdown()
+    {
+        msgBus.Disconnect();
+        msgBus.Stop();
+        msgBus.Join();
+    }
+
+    const InterfaceDescription::Member* DataMember() const
+    {
+        return msgBus.GetInterface(::org::alljoyn::load_test::Interface)->GetMember("Data");
+    }
+
+    BusAttachment msgBus;
+
+  protected:
+    virtual QStatus RegisterObjects() = 0;
+    virtual QStatus Connected() { return ER_OK; }
+
+  private:
+    MemoryKeyStoreListener keyStore;
+    DefaultECDHEAuthListener authListener;
+};
+
+class Producer;
+
+/** Map from producer unique name to producer so consumers can return signal credit */
+static map<String, Producer*> g_producers;
+
+class Producer : public Peer, public qcc::Thread, public BusObject {
+  public:
+    Producer(uint32_t id) :
+        Peer("ajload-p" + U32ToString(id)),
+        qcc::Thread("ajload-p" + U32ToString(id)),
+        BusObject(::org::alljoyn::load_test::Path),
+        callErrors(0), id(id), dataMember(NULL), callsSent(0), callsDone(0), callsDoneMeasured(0),
+        signalsSent(0), signalsDone(0), deliveries(0), measuring(false)
+    { }
+
+    ~Producer()
+    {
+        for (size_t i = 0; i < proxies.size(); ++i) {
+            delete proxies[i];
+        }
+    }
+
+    /**
+     * Create proxies for the consumers and authenticate with them if security is enabled.
+     */
+    QStatus AddConsumers(const vector<String>& names)
+    {
+        QStatus status = ER_OK;
+        const InterfaceDescription* ifc = msgBus.GetInterface(::org::alljoyn::load_test::Interface);
+        for (size_t i = 0; (status == ER_OK) && (i < names.size()); ++i) {
+            ProxyBusObject* proxy = new ProxyBusObject(msgBus, names[i].c_str(), ::org::alljoyn::load_test::Path, 0);
+            proxies.push_back(proxy);
+            status = proxy->AddInterface(*ifc);
+            if ((status == ER_OK) && g_config.secure) {
+                status = msgBus.SecureConnection(names[i].c_str());
+            }
+        }
+        return status;
+    }
+
+    /** Called by the consumers when they receive a signal from this producer */
+    void SignalDelivered(uint64_t latency)
+    {
+        lock.Lock(MUTEX_CONTEXT);
+        ++deliveries;
+        if (measuring) {
+            signalLatency.Record(latency);
+            ++signalsDone;
+        }
+        credit.Signal();
+        lock.Unlock(MUTEX_CONTEXT);
+    }
+
+    /** Discard the warm-up results */
+    void StartMeasuring()
+    {
+        lock.Lock(MUTEX_CONTEXT);
+        callLatency.Reset();
+        signalLatency.Reset();
+        callsDoneMeasured = 0;
+        signalsDone = 0;
+        callErrors = 0;
+        measuring = true;
+        lock.Unlock(MUTEX_CONTEXT);
+    }
+
+    /** Snapshot the measured counts at the end of the run */
+    void StopMeasuring(uint64_t& calls, uint64_t& signals)
+    {
+        lock.Lock(MUTEX_CONTEXT);
+        measuring = false;
+        calls = callsDoneMeasured;
+        signals = signalsDone;
+        lock.Unlock(MUTEX_CONTEXT);
+    }
+
+    /** Wait up to timeout ms for all outstanding messages to complete */
+    bool Drain(uint32_t timeout)
+    {
+        uint64_t end = GetTimestamp64() + timeout;
+        lock.Lock(MUTEX_CONTEXT);
+        while (Outstanding() > 0) {
+            uint64_t now = GetTimestamp64();
+            if (now >= end) {
+                break;
+            }
+            credit.TimedWait(lock, (uint32_t)(end - now));
+        }
+        bool drained = (Outstanding() == 0);
+        lock.Unlock(MUTEX_CONTEXT);
+        return drained;
+    }
+
+    Histogram callLatency;
+    Histogram signalLatency;
+    uint64_t callErrors;
+
+  protected:
+
+    QStatus RegisterObjects()
+    {
+        const InterfaceDescription* ifc = msgBus.GetInterface(::org::alljoyn::load_test::Interface);
+        QStatus status = AddInterface(*ifc);
+        if (status == ER_OK) {
+            dataMember = ifc->GetMember("Data");
+            status = msgBus.RegisterBusObject(*this);
+        }
+        return status;
+    }
+
+  private:
+
+    /*
+     * Messages in flight. A signal is complete once every consumer has received it.
+     */
+    uint64_t Outstanding() const
+    {
+        uint64_t numConsumers = proxies.size();
+        uint64_t pendingDeliveries = signalsSent * numConsumers - deliveries;
+        return (callsSent - callsDone) + (pendingDeliveries + numConsumers - 1) / numConsumers;
+    }
+
+    void ReplyHandler(Message& reply, void* context)
+    {
+        QCC_UNUSED(context);
+        uint64_t now = NowNs();
+        uint64_t sent = 0;
+        bool ok = (reply->GetType() == MESSAGE_METHOD_RET) && (reply->GetArgs("t", &sent) == ER_OK);
+        lock.Lock(MUTEX_CONTEXT);
+        ++callsDone;
+        if (measuring) {
+            if (ok) {
+                callLatency.Record(now - sent);
+                ++callsDoneMeasured;
+            } else {
+                ++callErrors;
+            }
+        }
+        credit.Signal();
+        lock.Unlock(MUTEX_CONTEXT);
+    }
+
+    qcc::ThreadReturn STDCALL Run(void* arg)
+    {
+        QCC_UNUSED(arg);
+
+        size_t maxPayload = 0;
+        for (size_t i = 0; i < g_config.payloadSizes.size(); ++i) {
+            maxPayload = (std::max)(maxPayload, g_config.payloadSizes[i]);
+        }
+        vector<uint8_t> payload(maxPayload + 1, (uint8_t)id);
+        size_t nextSize = 0;
+        size_t nextConsumer = id;
+        uint32_t mix = 0;
+
+        while (!IsStopping()) {
+            lock.Lock(MUTEX_CONTEXT);
+            while (!IsStopping() && (Outstanding() >= g_config.window)) {
+                credit.TimedWait(lock, 100);
+            }
+            lock.Unlock(MUTEX_CONTEXT);
+            if (IsStopping()) {
+                break;
+            }
+
+            size_t size = g_config.payloadSizes[nextSize++ % g_config.payloadSizes.size()];
+            MsgArg args[2];
+            args[0].Set("t", NowNs());
+            args[1].Set("ay", size, &payload[0]);
+
+            /* Spread calls and signals evenly according to the configured mix */
+            mix += g_config.callPercent;
+            QStatus status;
+            if (mix >= 100) {
+                mix -= 100;
+                lock.Lock(MUTEX_CONTEXT);
+                ++callsSent;
+                lock.Unlock(MUTEX_CONTEXT);
+                ProxyBusObject* proxy = proxies[nextConsumer++ % proxies.size()];
+                status = proxy->MethodCallAsync(::org::alljoyn::load_test::Interface, "Call", this,
+                                                static_cast<MessageReceiver::ReplyHandler>(&Producer::ReplyHandler),
+                                                args, ArraySize(args));
+                if (status != ER_OK) {
+                    lock.Lock(MUTEX_CONTEXT);
+                    --callsSent;
+                    callErrors += (status != ER_STOPPING_THREAD) ? 1 : 0;
+                    lock.Unlock(MUTEX_CONTEXT);
+                }
+            } else {
+                lock.Lock(MUTEX_CONTEXT);
+                ++signalsSent;
+                lock.Unlock(MUTEX_CONTEXT);
+                status = Signal(NULL, 0, *dataMember, args, ArraySize(args));
+                if (status != ER_OK) {
+                    lock.Lock(MUTEX_CONTEXT);
+                    --signalsSent;
+                    callErrors += (status != ER_STOPPING_THREAD) ? 1 : 0;
+                    lock.Unlock(MUTEX_CONTEXT);
+                }
+            }
+            /* A send blocked on a full transport queue is unblocked by Stop() at the end of the run */
+            if (status == ER_STOPPING_THREAD) {
+                break;
+            } else if (status != ER_OK) {
+                QCC_LogError(status, ("Producer %u failed to send", id));
+                qcc::Sleep(10);
+            }
+        }
+        return (qcc::ThreadReturn)0;
+    }
+
+    uint32_t id;
+    const InterfaceDescription::Member* dataMember;
+    vector<ProxyBusObject*> proxies;
+    Mutex lock;
+    Condition credit;
+    uint64_t callsSent;
+    uint64_t callsDone;
+    uint64_t callsDoneMeasured;
+    uint64_t signalsSent;
+    uint64_t signalsDone;
+    uint64_t deliveries;
+    bool measuring;
+};
+
+class Consumer : public Peer, public BusObject {
+  public:
+    Consumer(uint32_t id) :
+        Peer("ajload-c" + U32ToString(id)),
+        BusObject(::org::alljoyn::load_test::Path)
+    { }
+
+  protected:
+
+    QStatus RegisterObjects()
+    {
+        const InterfaceDescription* ifc = msgBus.GetInterface(::org::alljoyn::load_test::Interface);
+        QStatus status = AddInterface(*ifc);
+        if (status == ER_OK) {
+            status = AddMethodHandler(ifc->GetMember("Call"), static_cast<MessageReceiver::MethodHandler>(&Consumer::Call));
+        }
+        if (status == ER_OK) {
+            status = msgBus.RegisterBusObject(*this);
+        }
+        if (status == ER_OK) {
+            status = msgBus.RegisterSignalHandler(this, static_cast<MessageReceiver::SignalHandler>(&Consumer::Data), ifc->GetMember("Data"), NULL);
+        }
+        return status;
+    }
+
+    QStatus Connected()
+    {
+        return msgBus.AddMatch("type='signal',interface='org.alljoyn.load_test',member='Data'");
+    }
+
+  private:
+
+    void Call(const InterfaceDescription::Member* member, Message& msg)
+    {
+        QCC_UNUSED(member);
+        MethodReply(msg, msg->GetArg(0), 1);
+    }
+
+    void Data(const InterfaceDescription::Member* member, const char* srcPath, Message& msg)
+    {
+        QCC_UNUSED(member);
+        QCC_UNUSED(srcPath);
+        uint64_t now = NowNs();
+        uint64_t sent;
+        if (msg->GetArg(0)->Get("t", &sent) != ER_OK) {
+            return;
+        }
+        map<String, Producer*>::iterator it = g_producers.find(msg->GetSender());
+        if (it != g_producers.end()) {
+            it->second->SignalDelivered(now - sent);
+        }
+    }
+};
+
+static void PrintLatency(FILE* out, const char* name, const Histogram& h, uint64_t count, double seconds)
+{
+    fprintf(out, "%-12s %10" PRIu64 " %12.1f %10.1f %10.1f %10.1f %10.1f %10.1f %10.1f\n",
+            name, count, seconds > 0 ? count / seconds : 0.0,
+            h.ValueAtPercentile(50.0) / 1000.0, h.ValueAtPercentile(90.0) / 1000.0, h.ValueAtPercentile(99.0) / 1000.0,
+            h.ValueAtPercentile(99.9) / 1000.0, h.Max() / 1000.0, h.Mean() / 1000.0);
+}
+
+static void JsonLatency(FILE* out, const char* name, const Histogram& h, uint64_t count, double seconds, bool last)
+{
+    fprintf(out, "    \"%s\": {\n", name);
+    fprintf(out, "      \"count\": %" PRIu64 ",\n", count);
+    fprintf(out, "      \"msgs_per_second\": %.1f,\n", seconds > 0 ? count / seconds : 0.0);
+    fprintf(out, "      \"latency_ns\": {\"min\": %" PRIu64 ", \"mean\": %.1f, \"p50\": %" PRIu64 ", \"p90\": %" PRIu64
+            ", \"p99\": %" PRIu64 ", \"p99.9\": %" PRIu64 ", \"max\": %" PRIu64 "}\n",
+            h.Min(), h.Mean(), h.ValueAtPercentile(50.0), h.ValueAtPercentile(90.0), h.ValueAtPercentile(99.0),
+            h.ValueAtPercentile(99.9), h.Max());
+    fprintf(out, "    }%s\n", last ? "" : ",");
+}
+
+static void usage(void)
+{
+    printf("Usage: ajload [options]\n\n");
+    printf("Starts a bundled router plus producer and consumer bus attachments in this process and\n");
+    printf("reports method call round trip and signal delivery latency percentiles and throughput.\n\n");
+    printf("Options:\n");
+    printf("   -h                    = Print this help message\n");
+    printf("   -p <n>                = Number of producers (default 1)\n");
+    printf("   -m <n>                = Number of consumers (default 1)\n");
+    printf("   -x <percent>          = Percentage of messages that are method calls, the rest are signals (default 50)\n");
+    printf("   -s <size>[,<size>...] = Payload sizes in bytes, used round robin (default 64)\n");
+    printf("   -w <n>                = Messages in flight per producer (default 8)\n");
+    printf("   -d <ms>               = Measurement duration in milliseconds (default 10000)\n");
+    printf("   -W <ms>               = Warm-up duration in milliseconds, not measured (default 1000)\n");
+    printf("   -e                    = Enable security (ECDHE_NULL authentication and encryption)\n");
+    printf("   -t null|unix          = Transport between the applications and the bundled router (default null)\n");
+    printf("   -c <connect spec>     = Connect to an external router instead of the bundled router\n");
+    printf("   -o <file>             = Also write the results as JSON to <file>\n");
+}
+
+static bool ParseSizes(const char* arg, vector<size_t>& sizes)
+{
+    sizes.clear();
+    String str(arg);
+    size_t pos = 0;
+    while (pos != String::npos) {
+        size_t comma = str.find_first_of(',', pos);
+        String tok = str.substr(pos, (comma == String::npos) ? String::npos : comma - pos);
+        uint32_t size = StringToU32(tok, 0, 0xFFFFFFFF);
+        if ((size == 0xFFFFFFFF) || (size > ALLJOYN_MAX_ARRAY_LEN)) {
+            return false;
+        }
+        sizes.push_back(size);
+        pos = (comma == String::npos) ? String::npos : comma + 1;
+    }
+    return !sizes.empty();
+}
+
+/** Main entry point */
+int CDECL_CALL main(int argc, char** argv)
+{
+    g_config.payloadSizes.push_back(64);
+
+    for (int i = 1; i < argc; ++i) {
+        bool hasParam = (i + 1 < argc);
+        if (0 == strcmp("-h", argv[i])) {
+            usage();
+            exit(0);
+        } else if ((0 == strcmp("-p", argv[i])) && hasParam) {
+            g_config.producers = strtoul(argv[++i], NULL, 0);
+        } else if ((0 == strcmp("-m", argv[i])) && hasParam) {
+            g_config.consumers = strtoul(argv[++i], NULL, 0);
+        } else if ((0 == strcmp("-x", argv[i])) && hasParam) {
+            g_config.callPercent = strtoul(argv[++i], NULL, 0);
+        } else if ((0 == strcmp("-s", argv[i])) && hasParam) {
+            if (!ParseSizes(argv[++i], g_config.payloadSizes)) {
+                printf("Invalid payload sizes %s\n", argv[i]);
+                exit(1);
+            }
+        } else if ((0 == strcmp("-w", argv[i])) && hasParam) {
+            g_config.window = strtoul(argv[++i], NULL, 0);
+        } else if ((0 == strcmp("-d", argv[i])) && hasParam) {
+            g_config.durationMs = strtoul(argv[++i], NULL, 0);
+        } else if ((0 == strcmp("-W", argv[i])) && hasParam) {
+            g_config.warmupMs = strtoul(argv[++i], NULL, 0);
+        } else if (0 == strcmp("-e", argv[i])) {
+            g_config.secure = true;
+        } else if ((0 == strcmp("-t", argv[i])) && hasParam) {
+            g_config.transport = argv[++i];
+        } else if ((0 == strcmp("-c", argv[i])) && hasParam) {
+            g_config.connectSpec = argv[++i];
+        } else if ((0 == strcmp("-o", argv[i])) && hasParam) {
+            g_config.outFile = argv[++i];
+        } else {
+            printf("Unknown option %s\n", argv[i]);
+            usage();
+            exit(1);
+        }
+    }
+    if ((g_config.producers == 0) || (g_config.consumers == 0) || (g_config.window == 0) || (g_config.callPercent > 100)) {
+        usage();
+        exit(1);
+    }
+
+    /*
+     * The routing node only needs a socket listener for the unix transport, the null transport
+     * links the attachments to the bundled router directly.
+     */
+    String routerConfig;
+    if (g_config.connectSpec.empty()) {
+        if (g_config.transport == "null") {
+            g_config.connectSpec = "null:";
+        } else if (g_config.transport == "unix") {
+            String path = "ajload-" + U32ToString(GetPid());
+            g_config.connectSpec = "unix:abstract=" + path;
+            routerConfig = "<busconfig><listen>unix:abstract=" + path + "</listen></busconfig>";
+        } else {
+            printf("Unsupported transport %s\n", g_config.transport.c_str());
+            usage();
+            exit(1);
+        }
+    }
+
+    if (AllJoynInit() != ER_OK) {
+        return 1;
+    }
+#ifdef ROUTER
+    if (AllJoynRouterInitWithConfig(routerConfig.c_str()) != ER_OK) {
+        AllJoynShutdown();
+        return 1;
+    }
+#endif
+
+    printf("AllJoyn Library version: %s\n", ajn::GetVersion());
+    printf("AllJoyn Library build info: %s\n", ajn::GetBuildInfo());
+
+    signal(SIGINT, SigIntHandler);
+
+    QStatus status = ER_OK;
+    vector<Consumer*> consumers;
+    vector<Producer*> producers;
+    vector<String> consumerNames;
+
+    for (uint32_t i = 0; (status == ER_OK) && (i < g_config.consumers); ++i) {
+        Consumer* consumer = new Consumer(i);
+        consumers.push_back(consumer);
+        status = consumer->Init();
+        consumerNames.push_back(consumer->msgBus.GetUniqueName());
+    }
+    for (uint32_t i = 0; (status == ER_OK) && (i < g_config.producers); ++i) {
+        Producer* producer = new Producer(i);
+        producers.push_back(producer);
+        status = producer->Init();
+        if (status == ER_OK) {
+            g_producers[producer->msgBus.GetUniqueName()] = producer;
+            status = producer->AddConsumers(consumerNames);
+        }
+    }
+    if (status != ER_OK) {
+        QCC_LogError(status, ("Failed to set up producers and consumers over %s", g_config.connectSpec.c_str()));
+    }
+
+    double seconds = 0.0;
+    uint64_t calls = 0;
+    uint64_t signals = 0;
+    Histogram callLatency;
+    Histogram signalLatency;
+    uint64_t errors = 0;
+
+    if (status == ER_OK) {
+        printf("Running %u producers and %u consumers over %s for %u ms (%u ms warm-up)\n",
+               g_config.producers, g_config.consumers, g_config.connectSpec.c_str(), g_config.durationMs, g_config.warmupMs);
+
+        for (size_t i = 0; i < producers.size(); ++i) {
+            producers[i]->Start();
+        }
+        qcc::Sleep(g_config.warmupMs);
+        for (size_t i = 0; i < producers.size(); ++i) {
+            producers[i]->StartMeasuring();
+        }
+        uint64_t start = NowNs();
+        uint64_t end = GetTimestamp64() + g_config.durationMs;
+        while (!g_interrupt && (GetTimestamp64() < end)) {
+            qcc::Sleep(10);
+        }
+        for (size_t i = 0; i < producers.size(); ++i) {
+            uint64_t c, s;
+            producers[i]->StopMeasuring(c, s);
+            calls += c;
+            signals += s;
+        }
+        seconds = (NowNs() - start) / 1e9;
+
+        for (size_t i = 0; i < producers.size(); ++i) {
+            producers[i]->Stop();
+        }
+        for (size_t i = 0; i < producers.size(); ++i) {
+            producers[i]->Join();
+            if (!producers[i]->Drain(5000)) {
+                printf("Producer %u did not drain\n", (uint32_t)i);
+                ++errors;
+            }
+            callLatency.Merge(producers[i]->callLatency);
+            signalLatency.Merge(producers[i]->signalLatency);
+            errors += producers[i]->callErrors;
+        }
+
+        printf("\n%-12s %10s %12s %10s %10s %10s %10s %10s %10s\n", "", "count", "msgs/sec", "p50 us", "p90 us", "p99 us", "p99.9 us", "max us", "mean us");
+        PrintLatency(stdout, "method_call", callLatency, calls, seconds);
+        PrintLatency(stdout, "signal", signalLatency, signals, seconds);
+        printf("%-12s %10" PRIu64 " %12.1f\n", "total", calls + signals, seconds > 0 ? (calls + signals) / seconds : 0.0);
+        printf("errors: %" PRIu64 "\n", errors);
+
+        if (!g_config.outFile.empty()) {
+            FILE* out = fopen(g_config.outFile.c_str(), "w");
+            if (out) {
+                fprintf(out, "{\n");
+                fprintf(out, "  \"config\": {\"producers\": %u, \"consumers\": %u, \"call_percent\": %u, \"window\": %u, "
+                        "\"duration_ms\": %u, \"warmup_ms\": %u, \"secure\": %s, \"connect_spec\": \"%s\", \"payload_sizes\": [",
+                        g_config.producers, g_config.consumers, g_config.callPercent, g_config.window,
+                        g_config.durationMs, g_config.warmupMs, g_config.secure ? "true" : "false", g_config.connectSpec.c_str());
+                for (size_t i = 0; i < g_config.payloadSizes.size(); ++i) {
+                    fprintf(out, "%s%u", i ? ", " : "", (uint32_t)g_config.payloadSizes[i]);
+                }
+                fprintf(out, "]},\n");
+                fprintf(out, "  \"seconds\": %.3f,\n", seconds);
+                fprintf(out, "  \"errors\": %" PRIu64 ",\n", errors);
+                fprintf(out, "  \"msgs_per_second\": %.1f,\n", seconds > 0 ? (calls + signals) / seconds : 0.0);
+                fprintf(out, "  \"results\": {\n");
+                JsonLatency(out, "method_call", callLatency, calls, seconds, false);
+                JsonLatency(out, "signal", signalLatency, signals, seconds, true);
+                fprintf(out, "  }\n}\n");
+                fclose(out);
+            } else {
+                printf("Unable to open %s\n", g_config.outFile.c_str());
+            }
+        }
+    }
+
+    for (size_t i = 0; i < producers.size(); ++i) {
+        producers[i]->Shutdown();
+    }
+    for (size_t i = 0; i < consumers.size(); ++i) {
+        consumers[i]->Shutdown();
+    }
+    g_producers.clear();
+    for (size_t i = 0; i < producers.size(); ++i) {
+        delete producers[i];
+    }
+    for (size_t i = 0; i < consumers.size(); ++i) {
+        delete consumers[i];
+    }
+
+#ifdef ROUTER
+    AllJoynRouterShutdown();
+#endif
+    AllJoynShutdown();
+
+    if (status != ER_OK) {
+        return 1;
+    }
+    return ((errors == 0) && (calls + signals > 0)) ? 0 : 2;
+}
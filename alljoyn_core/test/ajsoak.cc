@@ -0,0 +1,1618 @@
+/* ajsoak - simulated-scale router soak test */
+
+/******************************************************************************
+ *
+ *
+ *    Copyright (c) Open Connectivity Foundation (OCF), AllJoyn Open Source
+ *    Project (AJOSP) Contributors and others.
+ *
+ *    SPDX-License-Identifier: Apache-2.0
+ *
+ *    All rights reserved. This program and the accompanying materials are
+ *    made available under the terms of the Apache License, Version 2.0
+ *    which accompanies this distribution, and is available at
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Copyright (c) Open Connectivity Foundation and Contributors to AllSeen
+ *    Alliance. All rights reserved.
+ *
+ *    Permission to use, copy, modify, and/or distribute this software for
+ *    any purpose with or without fee is hereby granted, provided that the
+ *    above copyright notice and this permission notice appear in all
+ *    copies.
+ *
+ *    THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+ *    WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+ *    WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ *    AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ *    DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ *    PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+ *    TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ *    PERFORMANCE OF THIS SOFTWARE.
+ ******************************************************************************/
+#include <qcc/platform.h>
+
+#include <errno.h>
+#include <inttypes.h>
+#include <poll.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/resource.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <linux/sockios.h>
+
+#include <map>
+#include <vector>
+
+#include <qcc/Debug.h>
+#include <qcc/LockProfiler.h>
+#include <qcc/Mutex.h>
+#include <qcc/String.h>
+#include <qcc/StringUtil.h>
+#include <qcc/Thread.h>
+#include <qcc/Util.h>
+#include <qcc/time.h>
+
+#include <alljoyn/AllJoynStd.h>
+#include <alljoyn/BusAttachment.h>
+#include <alljoyn/DBusStd.h>
+#include <alljoyn/Init.h>
+#include <alljoyn/Message.h>
+#include <alljoyn/version.h>
+
+#include <alljoyn/Status.h>
+
+#define QCC_MODULE "ALLJOYN"
+
+using namespace std;
+using namespace qcc;
+using namespace ajn;
+
+/*
+ * ajsoak opens thousands of lightweight client connections to a single routing node. Each virtual
+ * client is nothing more than a unix socket that does the SASL EXTERNAL exchange and Hello by hand
+ * and then marshals the handful of bus controller calls it needs directly onto the wire, so a
+ * single process can drive far more endpoints than it could with a BusAttachment per client.
+ */
+
+static const char SoakInterface[] = "org.alljoyn.soak";
+static const char SoakPath[] = "/org/alljoyn/soak";
+static const SessionPort SoakPort = 100;
+
+#if (QCC_TARGET_ENDIAN == QCC_LITTLE_ENDIAN)
+static const uint8_t NativeEndian = ALLJOYN_LITTLE_ENDIAN;
+#else
+static const uint8_t NativeEndian = ALLJOYN_BIG_ENDIAN;
+#endif
+
+static const uint32_t CALL_TIMEOUT_MS = 30000;
+static const uint32_t HANDSHAKE_TIMEOUT_MS = 10000;
+static const size_t MAX_MSG_SIZE = 128 * 1024 * 1024;
+static const uint32_t MAX_CONNECTS_PER_POLL = 8;
+
+enum SoakOp {
+    OP_CONNECT,
+    OP_REQUEST_NAME,
+    OP_RELEASE_NAME,
+    OP_ADD_MATCH,
+    OP_REMOVE_MATCH,
+    OP_BIND_SESSION_PORT,
+    OP_JOIN_SESSION,
+    OP_LEAVE_SESSION,
+    OP_SESSIONLESS_RX,
+    OP_COUNT
+};
+
+static const char* OpNames[OP_COUNT] = {
+    "connect",
+    "request_name",
+    "release_name",
+    "add_match",
+    "remove_match",
+    "bind_port",
+    "join_session",
+    "leave_session",
+    "sessionless_rx"
+};
+
+struct SoakConfig {
+    SoakConfig() : clients(1000), threads(4), rate(1.0), durationSec(60), intervalMs(1000), churnPercent(2), routerPid(0) { }
+    uint32_t clients;
+    uint32_t threads;
+    double rate;
+    uint32_t durationSec;
+    uint32_t intervalMs;
+    uint32_t churnPercent;
+    uint32_t routerPid;
+    String connectSpec;
+    String outFile;
+};
+
+static SoakConfig g_config;
+static volatile sig_atomic_t g_interrupt = false;
+
+static void CDECL_CALL SigIntHandler(int sig)
+{
+    QCC_UNUSED(sig);
+    g_interrupt = true;
+}
+
+static uint64_t NowUs()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+static uint64_t ThreadCpuUs()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return (uint64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+/**
+ * Latency statistics for one operation type. Latencies are kept in power of two microsecond
+ * buckets, which is plenty of resolution for spotting a router that stops scaling.
+ */
+struct OpStats {
+    OpStats() : count(0), errors(0), sumUs(0), maxUs(0) { memset(buckets, 0, sizeof(buckets)); }
+
+    void Record(uint64_t us)
+    {
+        ++count;
+        sumUs += us;
+        maxUs = (us > maxUs) ? us : maxUs;
+        uint32_t b = 0;
+        while ((b < 63) && ((1ULL << (b + 1)) <= us)) {
+            ++b;
+        }
+        ++buckets[b];
+    }
+
+    void Merge(const OpStats& other)
+    {
+        count += other.count;
+        errors += other.errors;
+        sumUs += other.sumUs;
+        maxUs = (other.maxUs > maxUs) ? other.maxUs : maxUs;
+        for (size_t i = 0; i < ArraySize(buckets); ++i) {
+            buckets[i] += other.buckets[i];
+        }
+    }
+
+    /* Upper bound of the bucket holding the given percentile */
+    uint64_t Percentile(double pct) const
+    {
+        uint64_t target = (uint64_t)(count * pct / 100.0 + 0.5);
+        uint64_t seen = 0;
+        for (size_t i = 0; i < ArraySize(buckets); ++i) {
+            seen += buckets[i];
+            if (seen >= target && seen > 0) {
+                return (2ULL << i) - 1;
+            }
+        }
+        return maxUs;
+    }
+
+    uint64_t count;
+    uint64_t errors;
+    uint64_t sumUs;
+    uint64_t maxUs;
+    uint64_t buckets[64];
+};
+
+/**
+ * Minimal native endian marshaller for the message header and the few body
+ * signatures the virtual clients send. Offsets are relative to the start of the buffer which is
+ * always 8 byte aligned on the wire.
+ */
+class WireWriter {
+  public:
+    WireWriter(vector<uint8_t>& buf) : buf(buf) { }
+
+    void Align(size_t a)
+    {
+        while (buf.size() % a) {
+            buf.push_back(0);
+        }
+    }
+    void Byte(uint8_t v) { buf.push_back(v); }
+    void U16(uint16_t v) { Align(2); Raw(&v, sizeof(v)); }
+    void U32(uint32_t v) { Align(4); Raw(&v, sizeof(v)); }
+    void U64(uint64_t v) { Align(8); Raw(&v, sizeof(v)); }
+    void Str(const char* s)
+    {
+        uint32_t len = strlen(s);
+        U32(len);
+        Raw(s, len + 1);
+    }
+    void Sig(const char* s)
+    {
+        Byte((uint8_t)strlen(s));
+        Raw(s, strlen(s) + 1);
+    }
+    /* Patch a previously written 32 bit value */
+    void Put32(size_t offset, uint32_t v) { memcpy(&buf[offset], &v, sizeof(v)); }
+    size_t Size() const { return buf.size(); }
+
+    /* The standard session options dictionary a{sv} */
+    void SessionOptions()
+    {
+        U32(0);
+        size_t lenPos = Size() - 4;
+        Align(8);
+        size_t start = Size();
+        Align(8); Str("traf"); Sig("y"); Byte(SessionOpts::TRAFFIC_MESSAGES);
+        Align(8); Str("multi"); Sig("b"); U32(1);
+        Align(8); Str("prox"); Sig("y"); Byte(SessionOpts::PROXIMITY_ANY);
+        Align(8); Str("trans"); Sig("q"); U16(TRANSPORT_ANY);
+        Put32(lenPos, Size() - start);
+    }
+
+  private:
+    void Raw(const void* p, size_t n) { buf.insert(buf.end(), (const uint8_t*)p, (const uint8_t*)p + n); }
+    vector<uint8_t>& buf;
+};
+
+/** The header fields of an outgoing message */
+struct OutHeader {
+    OutHeader(AllJoynMessageType type) : type(type), flags(0), replySerial(0), path(NULL), iface(NULL), member(NULL),
+        errorName(NULL), destination(NULL), sender(NULL), signature(NULL) { }
+    AllJoynMessageType type;
+    uint8_t flags;
+    uint32_t replySerial;
+    const char* path;
+    const char* iface;
+    const char* member;
+    const char* errorName;
+    const char* destination;
+    const char* sender;
+    const char* signature;
+};
+
+static void StrField(WireWriter& w, uint8_t code, const char* typeSig, const char* val)
+{
+    if (val) {
+        w.Align(8);
+        w.Byte(code);
+        w.Sig(typeSig);
+        if (typeSig[0] == 'g') {
+            w.Sig(val);
+        } else {
+            w.Str(val);
+        }
+    }
+}
+
+static void AppendMessage(vector<uint8_t>& out, const OutHeader& hdr, uint32_t serial, const vector<uint8_t>& body)
+{
+    size_t base = out.size();
+    vector<uint8_t> msg;
+    WireWriter w(msg);
+    w.Byte(NativeEndian);
+    w.Byte((uint8_t)hdr.type);
+    w.Byte(hdr.flags);
+    w.Byte(1);
+    w.U32(body.size());
+    w.U32(serial);
+    w.U32(0);
+    StrField(w, 1, "o", hdr.path);
+    StrField(w, 2, "s", hdr.iface);
+    StrField(w, 3, "s", hdr.member);
+    StrField(w, 4, "s", hdr.errorName);
+    if (hdr.replySerial) {
+        w.Align(8);
+        w.Byte(5);
+        w.Sig("u");
+        w.U32(hdr.replySerial);
+    }
+    StrField(w, 6, "s", hdr.destination);
+    StrField(w, 7, "s", hdr.sender);
+    StrField(w, 8, "g", hdr.signature);
+    w.Put32(12, msg.size() - 16);
+    w.Align(8);
+    msg.insert(msg.end(), body.begin(), body.end());
+    out.resize(base + msg.size());
+    memcpy(&out[base], &msg[0], msg.size());
+}
+
+/** A parsed incoming message, pointers refer into the receive buffer */
+struct InMessage {
+    InMessage() : type(MESSAGE_INVALID), flags(0), serial(0), replySerial(0), iface(""), member(""), sender(""),
+        signature(""), body(NULL), bodyLen(0) { }
+    AllJoynMessageType type;
+    uint8_t flags;
+    uint32_t serial;
+    uint32_t replySerial;
+    const char* iface;
+    const char* member;
+    const char* sender;
+    const char* signature;
+    const uint8_t* body;
+    size_t bodyLen;
+};
+
+/** Bounds checked reader for header fields and simple bodies */
+class WireReader {
+  public:
+    WireReader(const uint8_t* p, size_t len) : p(p), len(len), pos(0), ok(true) { }
+
+    bool Align(size_t a)
+    {
+        pos = (pos + a - 1) & ~(a - 1);
+        return Check(0);
+    }
+    uint8_t Byte() { return Check(1) ? p[pos++] : 0; }
+    uint32_t U32()
+    {
+        uint32_t v = 0;
+        if (Align(4) && Check(4)) {
+            memcpy(&v, p + pos, 4);
+            pos += 4;
+        }
+        return v;
+    }
+    uint64_t U64()
+    {
+        uint64_t v = 0;
+        if (Align(8) && Check(8)) {
+            memcpy(&v, p + pos, 8);
+            pos += 8;
+        }
+        return v;
+    }
+    const char* Str()
+    {
+        uint32_t n = U32();
+        if (!Check(n + 1)) {
+            return "";
+        }
+        const char* s = (const char*)(p + pos);
+        pos += n + 1;
+        return s;
+    }
+    const char* Sig()
+    {
+        uint8_t n = Byte();
+        if (!Check(n + 1)) {
+            return "";
+        }
+        const char* s = (const char*)(p + pos);
+        pos += n + 1;
+        return s;
+    }
+    bool Skip(size_t n) { if (Check(n)) { pos += n; } return ok; }
+    size_t Pos() const { return pos; }
+    bool Ok() const { return ok; }
+
+  private:
+    bool Check(size_t n)
+    {
+        if (pos + n > len) {
+            ok = false;
+        }
+        return ok;
+    }
+    const uint8_t* p;
+    size_t len;
+    size_t pos;
+    bool ok;
+};
+
+/*
+ * Returns the total size of the first message in the buffer, 0 if more bytes are needed or
+ * (size_t)-1 if the header is garbage.
+ */
+static size_t MessageSize(const uint8_t* p, size_t len)
+{
+    if (len < 16) {
+        return 0;
+    }
+    uint32_t bodyLen;
+    uint32_t fieldsLen;
+    memcpy(&bodyLen, p + 4, 4);
+    memcpy(&fieldsLen, p + 12, 4);
+    size_t total = ((16 + (size_t)fieldsLen + 7) & ~(size_t)7) + bodyLen;
+    if ((p[0] != NativeEndian) || (total > MAX_MSG_SIZE)) {
+        return (size_t)-1;
+    }
+    return (total <= len) ? total : 0;
+}
+
+static bool ParseMessage(const uint8_t* p, size_t len, InMessage& msg)
+{
+    msg.type = (AllJoynMessageType)p[1];
+    msg.flags = p[2];
+    memcpy(&msg.serial, p + 8, 4);
+    uint32_t fieldsLen;
+    memcpy(&fieldsLen, p + 12, 4);
+    WireReader r(p, 16 + fieldsLen);
+    r.Skip(16);
+    while (r.Ok() && (r.Pos() < 16 + fieldsLen)) {
+        r.Align(8);
+        uint8_t code = r.Byte();
+        const char* sig = r.Sig();
+        const char* str = NULL;
+        switch (sig[0]) {
+        case 's':
+        case 'o':
+            str = r.Str();
+            break;
+
+        case 'g':
+            str = r.Sig();
+            break;
+
+        case 'u':
+            if (code == 5) {
+                msg.replySerial = r.U32();
+            } else {
+                r.U32();
+            }
+            break;
+
+        case 'q':
+            r.Align(2);
+            r.Skip(2);
+            break;
+
+        case 'y':
+            r.Skip(1);
+            break;
+
+        default:
+            return false;
+        }
+        if (str) {
+            switch (code) {
+            case 2: msg.iface = str; break;
+
+            case 3: msg.member = str; break;
+
+            case 7: msg.sender = str; break;
+
+            case 8: msg.signature = str; break;
+
+            default: break;
+            }
+        }
+    }
+    if (!r.Ok()) {
+        return false;
+    }
+    size_t bodyStart = (16 + (size_t)fieldsLen + 7) & ~(size_t)7;
+    msg.body = p + bodyStart;
+    msg.bodyLen = len - bodyStart;
+    return true;
+}
+
+/** Router wide state the virtual clients use to pick session hosts */
+class HostDirectory {
+  public:
+    void Resize(size_t n) { names.resize(n); }
+    void Set(size_t i, const String& name)
+    {
+        lock.Lock(MUTEX_CONTEXT);
+        names[i] = name;
+        lock.Unlock(MUTEX_CONTEXT);
+    }
+    String Get(size_t i)
+    {
+        lock.Lock(MUTEX_CONTEXT);
+        String name = names[i];
+        lock.Unlock(MUTEX_CONTEXT);
+        return name;
+    }
+    size_t Size() const { return names.size(); }
+  private:
+    Mutex lock;
+    vector<String> names;
+};
+
+static HostDirectory g_hosts;
+
+struct PendingCall {
+    PendingCall() : op(OP_COUNT), startUs(0) { }
+    PendingCall(SoakOp op, uint64_t startUs, const String& arg) : op(op), startUs(startUs), arg(arg) { }
+    SoakOp op;
+    uint64_t startUs;
+    String arg;
+};
+
+/** One virtual client connection */
+struct VirtualClient {
+    VirtualClient(uint32_t id) : id(id), fd(-1), serial(0), rxOff(0), txOff(0), bound(false), nameCounter(0), nextOpUs(0) { }
+
+    bool Connected() const { return fd >= 0; }
+    uint32_t NextSerial() { return (++serial == 0) ? ++serial : serial; }
+
+    uint32_t id;
+    int fd;
+    String uniqueName;
+    uint32_t serial;
+    vector<uint8_t> rx;
+    size_t rxOff;
+    vector<uint8_t> tx;
+    size_t txOff;
+    map<uint32_t, PendingCall> pending;
+    vector<String> names;
+    vector<String> rules;
+    vector<uint32_t> sessions;
+    bool bound;
+    uint32_t nameCounter;
+    uint64_t nextOpUs;
+};
+
+static bool ParseConnectSpec(const String& spec, struct sockaddr_un& addr, socklen_t& addrLen)
+{
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    String path;
+    bool abstract = false;
+    if (spec.find("unix:abstract=") == 0) {
+        path = spec.substr(strlen("unix:abstract="));
+        abstract = true;
+    } else if (spec.find("unix:path=") == 0) {
+        path = spec.substr(strlen("unix:path="));
+    } else {
+        return false;
+    }
+    size_t comma = path.find_first_of(',');
+    if (comma != String::npos) {
+        path = path.substr(0, comma);
+    }
+    if (path.empty() || (path.size() + 1 >= sizeof(addr.sun_path))) {
+        return false;
+    }
+    memcpy(addr.sun_path + (abstract ? 1 : 0), path.c_str(), path.size());
+    addrLen = offsetof(struct sockaddr_un, sun_path) + path.size() + (abstract ? 1 : 0);
+    return true;
+}
+
+/**
+ * A worker thread drives a slice of the virtual clients with a single poll loop.
+ */
+class SoakWorker : public Thread {
+  public:
+    SoakWorker(uint32_t index, uint32_t first, uint32_t count) :
+        Thread("ajsoak-" + U32ToString(index)), seed(0x9E3779B9u * (index + 1)), cpuUs(0), rxBacklog(0), txBacklog(0),
+        connected(0), lostConnections(0), timeouts(0), opsIssued(0), intervalMaxUs(0)
+    {
+        for (uint32_t i = 0; i < count; ++i) {
+            clients.push_back(new VirtualClient(first + i));
+        }
+    }
+
+    ~SoakWorker()
+    {
+        for (size_t i = 0; i < clients.size(); ++i) {
+            Disconnect(*clients[i]);
+            delete clients[i];
+        }
+    }
+
+    /** Merge this worker's totals into the caller's and reset the per-interval values */
+    void Snapshot(OpStats* totals, uint64_t& maxUs, uint64_t& ops, uint32_t& conns, uint64_t& rxBytes, uint64_t& txBytes,
+                  uint64_t& lost, uint64_t& timedOut, uint64_t& cpu)
+    {
+        lock.Lock(MUTEX_CONTEXT);
+        for (size_t i = 0; i < OP_COUNT; ++i) {
+            totals[i].Merge(stats[i]);
+        }
+        maxUs = (intervalMaxUs > maxUs) ? intervalMaxUs : maxUs;
+        intervalMaxUs = 0;
+        ops += opsIssued;
+        conns += connected;
+        rxBytes += rxBacklog;
+        txBytes += txBacklog;
+        lost += lostConnections;
+        timedOut += timeouts;
+        cpu += cpuUs;
+        lock.Unlock(MUTEX_CONTEXT);
+    }
+
+  private:
+    uint32_t Random()
+    {
+        seed ^= seed << 13;
+        seed ^= seed >> 17;
+        seed ^= seed << 5;
+        return seed;
+    }
+
+    void ScheduleNext(VirtualClient& c, uint64_t now)
+    {
+        uint64_t meanUs = (uint64_t)(1000000.0 / g_config.rate);
+        c.nextOpUs = now + (meanUs ? (Random() % (2 * meanUs)) : 0);
+    }
+
+    void Record(SoakOp op, uint64_t us, bool ok)
+    {
+        lock.Lock(MUTEX_CONTEXT);
+        if (ok) {
+            stats[op].Record(us);
+            intervalMaxUs = (us > intervalMaxUs) ? us : intervalMaxUs;
+        } else {
+            ++stats[op].errors;
+        }
+        lock.Unlock(MUTEX_CONTEXT);
+    }
+
+    QStatus WaitFd(int fd, short events, uint64_t deadline)
+    {
+        uint64_t now = NowUs();
+        if (now >= deadline) {
+            return ER_TIMEOUT;
+        }
+        struct pollfd pfd = { fd, events, 0 };
+        int ret = poll(&pfd, 1, (int)((deadline - now) / 1000) + 1);
+        return (ret > 0) ? ER_OK : (ret == 0 ? ER_TIMEOUT : ER_OS_ERROR);
+    }
+
+    QStatus WriteAll(int fd, const void* data, size_t len, uint64_t deadline)
+    {
+        const uint8_t* p = (const uint8_t*)data;
+        while (len) {
+            ssize_t n = send(fd, p, len, MSG_NOSIGNAL);
+            if (n > 0) {
+                p += n;
+                len -= n;
+            } else if ((n < 0) && (errno == EAGAIN)) {
+                QStatus status = WaitFd(fd, POLLOUT, deadline);
+                if (status != ER_OK) {
+                    return status;
+                }
+            } else if ((n < 0) && (errno == EINTR)) {
+                continue;
+            } else {
+                return ER_WRITE_ERROR;
+            }
+        }
+        return ER_OK;
+    }
+
+    /* Reads one CRLF terminated line a byte at a time so nothing after BEGIN is consumed */
+    QStatus ReadLine(int fd, String& line, uint64_t deadline)
+    {
+        line.clear();
+        while (true) {
+            char ch;
+            ssize_t n = recv(fd, &ch, 1, 0);
+            if (n == 1) {
+                if (ch == '\n') {
+                    if (!line.empty() && (line[line.size() - 1] == '\r')) {
+                        line.erase(line.size() - 1, 1);
+                    }
+                    return ER_OK;
+                }
+                line.push_back(ch);
+                if (line.size() > 1024) {
+                    return ER_BUS_ESTABLISH_FAILED;
+                }
+            } else if ((n < 0) && ((errno == EAGAIN) || (errno == EINTR))) {
+                QStatus status = WaitFd(fd, POLLIN, deadline);
+                if (status != ER_OK) {
+                    return status;
+                }
+            } else {
+                return ER_SOCK_OTHER_END_CLOSED;
+            }
+        }
+    }
+
+    /* Sends the credentials byte the daemon transport expects ahead of the SASL exchange */
+    QStatus SendCredentials(int fd)
+    {
+        char nulbuf = 0;
+        struct iovec iov[] = { { &nulbuf, sizeof(nulbuf) } };
+        char cbuf[CMSG_SPACE(sizeof(struct ucred))];
+        memset(cbuf, 0, sizeof(cbuf));
+        struct msghdr msg;
+        memset(&msg, 0, sizeof(msg));
+        msg.msg_iov = iov;
+        msg.msg_iovlen = ArraySize(iov);
+        msg.msg_control = cbuf;
+        msg.msg_controllen = sizeof(cbuf);
+        struct cmsghdr* cmsg = CMSG_FIRSTHDR(&msg);
+        cmsg->cmsg_level = SOL_SOCKET;
+        cmsg->cmsg_type = SCM_CREDENTIALS;
+        cmsg->cmsg_len = CMSG_LEN(sizeof(struct ucred));
+        struct ucred* cred = reinterpret_cast<struct ucred*>(CMSG_DATA(cmsg));
+        cred->uid = GetUid();
+        cred->gid = GetGid();
+        cred->pid = GetPid();
+        return (sendmsg(fd, &msg, MSG_NOSIGNAL) == 1) ? ER_OK : ER_OS_ERROR;
+    }
+
+    /**
+     * Blocking connect, SASL EXTERNAL and Hello. The daemon transport authenticates connections
+     * one at a time on its accept thread so there is nothing to gain from overlapping these.
+     */
+    QStatus Connect(VirtualClient& c)
+    {
+        uint64_t start = NowUs();
+        uint64_t deadline = start + HANDSHAKE_TIMEOUT_MS * 1000;
+        struct sockaddr_un addr;
+        socklen_t addrLen;
+        if (!ParseConnectSpec(g_config.connectSpec, addr, addrLen)) {
+            return ER_BUS_BAD_TRANSPORT_ARGS;
+        }
+        int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+        if (fd < 0) {
+            QCC_LogError(ER_OS_ERROR, ("socket() failed: %s", strerror(errno)));
+            Record(OP_CONNECT, 0, false);
+            return ER_OS_ERROR;
+        }
+        QStatus status = ER_OK;
+        /*
+         * A non-blocking connect on a unix socket fails with EAGAIN rather than EINPROGRESS when
+         * the listen backlog is full, the connection has not been queued so it must be retried.
+         */
+        while (connect(fd, (struct sockaddr*)&addr, addrLen) < 0) {
+            if (((errno == EAGAIN) || (errno == EINTR)) && (NowUs() < deadline)) {
+                qcc::Sleep(1);
+            } else {
+                status = (errno == EAGAIN) ? ER_TIMEOUT : ER_CONN_REFUSED;
+                break;
+            }
+        }
+        if (status == ER_OK) {
+            status = SendCredentials(fd);
+        }
+        if (status == ER_OK) {
+            String uid = U32ToString(GetUid());
+            String auth = "AUTH EXTERNAL " + BytesToHexString((const uint8_t*)uid.data(), uid.size(), true) + "\r\n";
+            status = WriteAll(fd, auth.data(), auth.size(), deadline);
+        }
+        String line;
+        while (status == ER_OK) {
+            status = ReadLine(fd, line, deadline);
+            if (status != ER_OK) {
+                break;
+            }
+            if (line.find("OK") == 0) {
+                static const char begin[] = "BEGIN\r\n";
+                status = WriteAll(fd, begin, sizeof(begin) - 1, deadline);
+                break;
+            } else if (line.find("DATA") == 0) {
+                static const char data[] = "DATA\r\n";
+                status = WriteAll(fd, data, sizeof(data) - 1, deadline);
+            } else {
+                status = ER_AUTH_FAIL;
+            }
+        }
+
+        c.fd = fd;
+        c.serial = 0;
+        c.rx.clear();
+        c.rxOff = 0;
+        c.tx.clear();
+        c.txOff = 0;
+        c.uniqueName.clear();
+        if (status == ER_OK) {
+            OutHeader hdr(MESSAGE_METHOD_CALL);
+            hdr.path = org::freedesktop::DBus::ObjectPath;
+            hdr.iface = org::freedesktop::DBus::InterfaceName;
+            hdr.member = "Hello";
+            hdr.destination = org::freedesktop::DBus::WellKnownName;
+            vector<uint8_t> body;
+            uint32_t serial = c.NextSerial();
+            AppendMessage(c.tx, hdr, serial, body);
+            status = WriteAll(fd, &c.tx[0], c.tx.size(), deadline);
+            c.tx.clear();
+            while ((status == ER_OK) && c.uniqueName.empty()) {
+                status = WaitFd(fd, POLLIN, deadline);
+                if (status == ER_OK) {
+                    status = ReadAvailable(c);
+                }
+                while ((status == ER_OK) && c.uniqueName.empty()) {
+                    InMessage msg;
+                    size_t size;
+                    status = NextMessage(c, msg, size);
+                    if ((status != ER_OK) || (size == 0)) {
+                        break;
+                    }
+                    if ((msg.type == MESSAGE_METHOD_RET) && (msg.replySerial == serial)) {
+                        WireReader r(msg.body, msg.bodyLen);
+                        c.uniqueName = r.Str();
+                        if (!r.Ok() || c.uniqueName.empty()) {
+                            status = ER_BUS_ESTABLISH_FAILED;
+                        }
+                    } else if (msg.type == MESSAGE_ERROR) {
+                        status = ER_BUS_ESTABLISH_FAILED;
+                    }
+                    c.rxOff += size;
+                }
+            }
+        }
+        if (status != ER_OK) {
+            QCC_LogError(status, ("Client %u failed to connect to %s", c.id, g_config.connectSpec.c_str()));
+            Disconnect(c);
+            Record(OP_CONNECT, 0, false);
+            return status;
+        }
+        Record(OP_CONNECT, NowUs() - start, true);
+        g_hosts.Set(c.id, c.uniqueName);
+        lock.Lock(MUTEX_CONTEXT);
+        ++connected;
+        lock.Unlock(MUTEX_CONTEXT);
+        ScheduleNext(c, NowUs());
+        return ER_OK;
+    }
+
+    void Disconnect(VirtualClient& c)
+    {
+        if (c.fd >= 0) {
+            close(c.fd);
+            c.fd = -1;
+            if (!c.uniqueName.empty()) {
+                lock.Lock(MUTEX_CONTEXT);
+                --connected;
+                lock.Unlock(MUTEX_CONTEXT);
+                g_hosts.Set(c.id, String());
+            }
+        }
+        c.uniqueName.clear();
+        c.pending.clear();
+        c.names.clear();
+        c.rules.clear();
+        c.sessions.clear();
+        c.bound = false;
+        c.tx.clear();
+        c.txOff = 0;
+    }
+
+    QStatus ReadAvailable(VirtualClient& c)
+    {
+        if (c.rxOff && (c.rxOff == c.rx.size())) {
+            c.rx.clear();
+            c.rxOff = 0;
+        }
+        while (true) {
+            size_t have = c.rx.size();
+            c.rx.resize(have + 16384);
+            ssize_t n = recv(c.fd, &c.rx[have], 16384, 0);
+            c.rx.resize(have + ((n > 0) ? n : 0));
+            if (n > 0) {
+                continue;
+            } else if (n == 0) {
+                return ER_SOCK_OTHER_END_CLOSED;
+            } else if ((errno == EAGAIN) || (errno == EINTR)) {
+                return ER_OK;
+            } else {
+                return ER_READ_ERROR;
+            }
+        }
+    }
+
+    /* Returns the next complete message, size is 0 if there is none yet */
+    QStatus NextMessage(VirtualClient& c, InMessage& msg, size_t& size)
+    {
+        size = MessageSize(c.rx.empty() ? NULL : &c.rx[c.rxOff], c.rx.size() - c.rxOff);
+        if (size == (size_t)-1) {
+            return ER_BUS_BAD_HEADER_FIELD;
+        }
+        if (size && !ParseMessage(&c.rx[c.rxOff], size, msg)) {
+            return ER_BUS_BAD_HEADER_FIELD;
+        }
+        return ER_OK;
+    }
+
+    QStatus Flush(VirtualClient& c)
+    {
+        while (c.txOff < c.tx.size()) {
+            ssize_t n = send(c.fd, &c.tx[c.txOff], c.tx.size() - c.txOff, MSG_NOSIGNAL);
+            if (n > 0) {
+                c.txOff += n;
+            } else if ((n < 0) && (errno == EAGAIN)) {
+                return ER_OK;
+            } else if ((n < 0) && (errno == EINTR)) {
+                continue;
+            } else {
+                return ER_WRITE_ERROR;
+            }
+        }
+        c.tx.clear();
+        c.txOff = 0;
+        return ER_OK;
+    }
+
+    uint32_t Send(VirtualClient& c, OutHeader& hdr, const vector<uint8_t>& body)
+    {
+        uint32_t serial = c.NextSerial();
+        hdr.sender = c.uniqueName.c_str();
+        AppendMessage(c.tx, hdr, serial, body);
+        return serial;
+    }
+
+    void Call(VirtualClient& c, SoakOp op, const char* iface, const char* member, const char* sig,
+              const vector<uint8_t>& body, const String& arg = String())
+    {
+        OutHeader hdr(MESSAGE_METHOD_CALL);
+        if (strcmp(iface, org::alljoyn::Bus::InterfaceName) == 0) {
+            hdr.path = org::alljoyn::Bus::ObjectPath;
+            hdr.destination = org::alljoyn::Bus::WellKnownName;
+        } else {
+            hdr.path = org::freedesktop::DBus::ObjectPath;
+            hdr.destination = org::freedesktop::DBus::WellKnownName;
+        }
+        hdr.iface = iface;
+        hdr.member = member;
+        hdr.signature = sig;
+        uint32_t serial = Send(c, hdr, body);
+        c.pending[serial] = PendingCall(op, NowUs(), arg);
+        lock.Lock(MUTEX_CONTEXT);
+        ++opsIssued;
+        lock.Unlock(MUTEX_CONTEXT);
+    }
+
+    /* A random match rule, a third of them pull in sessionless signals */
+    String MakeRule(VirtualClient& c)
+    {
+        String rule = "type='signal',interface='" + String(SoakInterface) + "'";
+        switch (Random() % 3) {
+        case 0:
+            rule += ",member='Tick',sessionless='t'";
+            break;
+
+        case 1: {
+                String host = g_hosts.Get(Random() % g_hosts.Size());
+                if (!host.empty()) {
+                    rule += ",sender='" + host + "'";
+                }
+                break;
+            }
+
+        default:
+            rule += ",member='Tock" + U32ToString(c.id) + "_" + U32ToString(c.nameCounter++) + "'";
+            break;
+        }
+        return rule;
+    }
+
+    /** Issue one random operation for a client that has nothing outstanding */
+    void IssueOp(VirtualClient& c, uint64_t now)
+    {
+        vector<uint8_t> body;
+        WireWriter w(body);
+        if (!c.bound) {
+            w.U16(SoakPort);
+            w.SessionOptions();
+            Call(c, OP_BIND_SESSION_PORT, org::alljoyn::Bus::InterfaceName, "BindSessionPort", "qa{sv}", body);
+            return;
+        }
+        uint32_t pick = Random() % 100;
+        if (pick < g_config.churnPercent) {
+            /* Drop the connection and come back, the router has to unwind everything this client owned */
+            Disconnect(c);
+            Connect(c);
+            return;
+        }
+        pick = Random() % 100;
+        if (pick < 30) {
+            if (!c.names.empty() && ((c.names.size() >= 4) || (Random() & 1))) {
+                String name = c.names.back();
+                c.names.pop_back();
+                w.Str(name.c_str());
+                Call(c, OP_RELEASE_NAME, org::freedesktop::DBus::InterfaceName, "ReleaseName", "s", body);
+            } else {
+                String name = "org.alljoyn.soak.c" + U32ToString(c.id) + ".n" + U32ToString(c.nameCounter++);
+                w.Str(name.c_str());
+                w.U32(DBUS_NAME_FLAG_DO_NOT_QUEUE);
+                Call(c, OP_REQUEST_NAME, org::freedesktop::DBus::InterfaceName, "RequestName", "su", body, name);
+            }
+        } else if (pick < 60) {
+            if (!c.rules.empty() && ((c.rules.size() >= 8) || (Random() & 1))) {
+                size_t i = Random() % c.rules.size();
+                String rule = c.rules[i];
+                c.rules.erase(c.rules.begin() + i);
+                w.Str(rule.c_str());
+                Call(c, OP_REMOVE_MATCH, org::freedesktop::DBus::InterfaceName, "RemoveMatch", "s", body);
+            } else {
+                String rule = MakeRule(c);
+                w.Str(rule.c_str());
+                Call(c, OP_ADD_MATCH, org::freedesktop::DBus::InterfaceName, "AddMatch", "s", body, rule);
+            }
+        } else if (pick < 85) {
+            if (!c.sessions.empty() && ((c.sessions.size() >= 2) || (Random() & 1))) {
+                w.U32(c.sessions.back());
+                c.sessions.pop_back();
+                Call(c, OP_LEAVE_SESSION, org::alljoyn::Bus::InterfaceName, "LeaveSession", "u", body);
+            } else {
+                String host = g_hosts.Get(Random() % g_hosts.Size());
+                if (host.empty() || (host == c.uniqueName)) {
+                    ScheduleNext(c, now);
+                    return;
+                }
+                w.Str(host.c_str());
+                w.U16(SoakPort);
+                w.SessionOptions();
+                Call(c, OP_JOIN_SESSION, org::alljoyn::Bus::InterfaceName, "JoinSession", "sqa{sv}", body);
+            }
+        } else {
+            /* Sessionless signal carrying its send time so receivers can measure delivery */
+            OutHeader hdr(MESSAGE_SIGNAL);
+            hdr.flags = ALLJOYN_FLAG_SESSIONLESS;
+            hdr.path = SoakPath;
+            hdr.iface = SoakInterface;
+            hdr.member = "Tick";
+            hdr.signature = "t";
+            w.U64(NowUs());
+            Send(c, hdr, body);
+            lock.Lock(MUTEX_CONTEXT);
+            ++opsIssued;
+            lock.Unlock(MUTEX_CONTEXT);
+            ScheduleNext(c, now);
+        }
+    }
+
+    void HandleReply(VirtualClient& c, const InMessage& msg, uint64_t now)
+    {
+        map<uint32_t, PendingCall>::iterator it = c.pending.find(msg.replySerial);
+        if (it == c.pending.end()) {
+            return;
+        }
+        PendingCall call = it->second;
+        c.pending.erase(it);
+        bool ok = (msg.type == MESSAGE_METHOD_RET);
+        WireReader r(msg.body, msg.bodyLen);
+        /* AddMatch and RemoveMatch have no reply arguments, everything else leads with a disposition */
+        bool hasDisposition = (call.op != OP_ADD_MATCH) && (call.op != OP_REMOVE_MATCH);
+        uint32_t disposition = (ok && hasDisposition) ? r.U32() : 0;
+        switch (call.op) {
+        case OP_REQUEST_NAME:
+            ok = ok && (disposition == DBUS_REQUEST_NAME_REPLY_PRIMARY_OWNER);
+            if (ok) {
+                c.names.push_back(call.arg);
+            }
+            break;
+
+        case OP_ADD_MATCH:
+            if (ok) {
+                c.rules.push_back(call.arg);
+            }
+            break;
+
+        case OP_BIND_SESSION_PORT:
+            c.bound = ok && ((disposition == ALLJOYN_BINDSESSIONPORT_REPLY_SUCCESS) ||
+                             (disposition == ALLJOYN_BINDSESSIONPORT_REPLY_ALREADY_EXISTS));
+            ok = c.bound;
+            break;
+
+        case OP_JOIN_SESSION:
+            if (ok && (disposition == ALLJOYN_JOINSESSION_REPLY_SUCCESS)) {
+                c.sessions.push_back(r.U32());
+            } else {
+                /* Hosts come and go under churn, a refused join is expected and not an error */
+                ok = ok && (disposition != 0);
+            }
+            break;
+
+        default:
+            break;
+        }
+        Record(call.op, now - call.startUs, ok && r.Ok());
+        ScheduleNext(c, now);
+    }
+
+    /* The router calls into the client to accept joiners and probe liveness */
+    void HandleIncoming(VirtualClient& c, const InMessage& msg, uint64_t now)
+    {
+        if (msg.type == MESSAGE_METHOD_CALL) {
+            if (msg.flags & ALLJOYN_FLAG_NO_REPLY_EXPECTED) {
+                return;
+            }
+            vector<uint8_t> body;
+            WireWriter w(body);
+            OutHeader hdr(MESSAGE_METHOD_RET);
+            hdr.replySerial = msg.serial;
+            hdr.destination = msg.sender[0] ? msg.sender : NULL;
+            if (strcmp(msg.member, "AcceptSession") == 0) {
+                hdr.signature = "b";
+                w.U32(1);
+            } else {
+                hdr.type = MESSAGE_ERROR;
+                hdr.errorName = "org.freedesktop.DBus.Error.UnknownMethod";
+            }
+            Send(c, hdr, body);
+        } else if (msg.type == MESSAGE_SIGNAL) {
+            if ((strcmp(msg.member, "ProbeReq") == 0) && (strcmp(msg.iface, org::alljoyn::Daemon::InterfaceName) == 0)) {
+                OutHeader hdr(MESSAGE_SIGNAL);
+                hdr.path = "/";
+                hdr.iface = org::alljoyn::Daemon::InterfaceName;
+                hdr.member = "ProbeAck";
+                vector<uint8_t> body;
+                Send(c, hdr, body);
+            } else if ((strcmp(msg.member, "Tick") == 0) && (strcmp(msg.iface, SoakInterface) == 0)) {
+                WireReader r(msg.body, msg.bodyLen);
+                uint64_t sent = r.U64();
+                if (r.Ok() && (sent <= now)) {
+                    Record(OP_SESSIONLESS_RX, now - sent, true);
+                }
+            }
+        }
+    }
+
+    /* Drain everything readable, returns false if the connection was lost */
+    bool Service(VirtualClient& c, uint64_t now)
+    {
+        QStatus status = ReadAvailable(c);
+        while (status == ER_OK) {
+            InMessage msg;
+            size_t size;
+            status = NextMessage(c, msg, size);
+            if ((status != ER_OK) || (size == 0)) {
+                break;
+            }
+            if ((msg.type == MESSAGE_METHOD_RET) || (msg.type == MESSAGE_ERROR)) {
+                HandleReply(c, msg, now);
+            } else {
+                HandleIncoming(c, msg, now);
+            }
+            c.rxOff += size;
+        }
+        if (status == ER_OK) {
+            status = Flush(c);
+        }
+        if (status != ER_OK) {
+            QCC_LogError(status, ("Client %u (%s) lost its connection", c.id, c.uniqueName.c_str()));
+            return false;
+        }
+        return true;
+    }
+
+    void Housekeeping(uint64_t now)
+    {
+        uint64_t rxBytes = 0;
+        uint64_t txBytes = 0;
+        uint32_t expired = 0;
+        for (size_t i = 0; i < clients.size(); ++i) {
+            VirtualClient& c = *clients[i];
+            if (!c.Connected()) {
+                continue;
+            }
+            /* Bytes the router has not read yet and bytes it has queued that we have not read */
+            int outq = 0;
+            int inq = 0;
+            if (ioctl(c.fd, SIOCOUTQ, &outq) == 0) {
+                rxBytes += outq;
+            }
+            if (ioctl(c.fd, SIOCINQ, &inq) == 0) {
+                txBytes += inq;
+            }
+            for (map<uint32_t, PendingCall>::iterator it = c.pending.begin(); it != c.pending.end();) {
+                if ((now - it->second.startUs) > CALL_TIMEOUT_MS * 1000ULL) {
+                    QCC_LogError(ER_TIMEOUT, ("Client %u: %s timed out", c.id, OpNames[it->second.op]));
+                    ++expired;
+                    c.pending.erase(it++);
+                    ScheduleNext(c, now);
+                } else {
+                    ++it;
+                }
+            }
+        }
+        lock.Lock(MUTEX_CONTEXT);
+        rxBacklog = rxBytes;
+        txBacklog = txBytes;
+        timeouts += expired;
+        cpuUs = ThreadCpuUs();
+        lock.Unlock(MUTEX_CONTEXT);
+    }
+
+    ThreadReturn STDCALL Run(void* arg)
+    {
+        QCC_UNUSED(arg);
+        vector<struct pollfd> fds;
+        vector<VirtualClient*> polled;
+        uint64_t nextHousekeeping = 0;
+        while (!IsStopping()) {
+            uint64_t now = NowUs();
+            fds.clear();
+            polled.clear();
+            /*
+             * Clients are connected a few at a time between polls. The router broadcasts to the
+             * clients that are already connected while others join, if they stop reading the
+             * router's transmit queues fill up and new connections stall.
+             */
+            uint32_t connects = 0;
+            for (size_t i = 0; i < clients.size(); ++i) {
+                VirtualClient& c = *clients[i];
+                if (!c.Connected()) {
+                    if ((now >= c.nextOpUs) && (connects < MAX_CONNECTS_PER_POLL)) {
+                        ++connects;
+                        if (Connect(c) != ER_OK) {
+                            c.nextOpUs = now + 1000000;
+                        }
+                    }
+                    continue;
+                }
+                if (c.pending.empty() && (now >= c.nextOpUs)) {
+                    IssueOp(c, now);
+                    if (!c.Connected()) {
+                        continue;
+                    }
+                    if (Flush(c) != ER_OK) {
+                        Lost(c);
+                        continue;
+                    }
+                }
+                struct pollfd pfd = { c.fd, (short)(POLLIN | ((c.txOff < c.tx.size()) ? POLLOUT : 0)), 0 };
+                fds.push_back(pfd);
+                polled.push_back(&c);
+            }
+            int ret = poll(fds.empty() ? NULL : &fds[0], fds.size(), 10);
+            now = NowUs();
+            for (size_t i = 0; (ret > 0) && (i < fds.size()); ++i) {
+                if (fds[i].revents && !Service(*polled[i], now)) {
+                    Lost(*polled[i]);
+                }
+            }
+            if (now >= nextHousekeeping) {
+                Housekeeping(now);
+                nextHousekeeping = now + 250000;
+            }
+        }
+        Housekeeping(NowUs());
+        return (ThreadReturn)0;
+    }
+
+    void Lost(VirtualClient& c)
+    {
+        Disconnect(c);
+        lock.Lock(MUTEX_CONTEXT);
+        ++lostConnections;
+        lock.Unlock(MUTEX_CONTEXT);
+        c.nextOpUs = NowUs() + 1000000;
+    }
+
+    vector<VirtualClient*> clients;
+    uint32_t seed;
+    Mutex lock;
+    OpStats stats[OP_COUNT];
+    uint64_t cpuUs;
+    uint64_t rxBacklog;
+    uint64_t txBacklog;
+    uint32_t connected;
+    uint64_t lostConnections;
+    uint64_t timeouts;
+    uint64_t opsIssued;
+    uint64_t intervalMaxUs;
+};
+
+/** CPU time and resident set of a process from procfs */
+static bool ProcessUsage(uint32_t pid, uint64_t& cpuUs, uint64_t& rssBytes)
+{
+    String base = "/proc/" + (pid ? U32ToString(pid) : String("self"));
+    FILE* f = fopen((base + "/stat").c_str(), "r");
+    if (!f) {
+        return false;
+    }
+    char buf[1024];
+    size_t n = fread(buf, 1, sizeof(buf) - 1, f);
+    fclose(f);
+    buf[n] = 0;
+    /* The command name may contain spaces, fields are counted from the closing parenthesis */
+    const char* p = strrchr(buf, ')');
+    if (!p) {
+        return false;
+    }
+    vector<String> fields;
+    String rest(p + 2);
+    size_t pos = 0;
+    while (pos < rest.size()) {
+        size_t sp = rest.find_first_of(' ', pos);
+        fields.push_back(rest.substr(pos, (sp == String::npos) ? String::npos : sp - pos));
+        pos = (sp == String::npos) ? rest.size() : sp + 1;
+    }
+    /* utime, stime and rss are fields 14, 15 and 24 of which the first two are consumed above */
+    if (fields.size() < 22) {
+        return false;
+    }
+    uint64_t utime = StringToU64(fields[11], 10, 0);
+    uint64_t stime = StringToU64(fields[12], 10, 0);
+    uint64_t rssPages = StringToU64(fields[21], 10, 0);
+    long ticks = sysconf(_SC_CLK_TCK);
+    cpuUs = (uint64_t)(utime + stime) * 1000000 / (ticks > 0 ? ticks : 100);
+    rssBytes = (uint64_t)rssPages * sysconf(_SC_PAGESIZE);
+    return true;
+}
+
+struct Sample {
+    double seconds;
+    uint32_t connected;
+    double opsPerSec;
+    uint64_t errors;
+    uint64_t timeouts;
+    uint64_t lost;
+    uint64_t maxUs;
+    uint64_t rxBacklog;
+    uint64_t txBacklog;
+    double routerCpu;
+    uint64_t rssBytes;
+};
+
+static void usage(void)
+{
+    printf("Usage: ajsoak [options]\n\n");
+    printf("Opens many raw client connections to one routing node over unix sockets and churns bus names,\n");
+    printf("match rules, sessions and sessionless signals while sampling the router's CPU, memory and\n");
+    printf("queue depths.\n\n");
+    printf("Options:\n");
+    printf("   -h                    = Print this help message\n");
+    printf("   -n <n>                = Number of virtual clients (default 1000)\n");
+    printf("   -T <n>                = Number of client threads (default 4)\n");
+    printf("   -r <ops/sec>          = Operations per second per client (default 1)\n");
+    printf("   -k <percent>          = Percentage of operations that drop and re-establish the connection (default 2)\n");
+    printf("   -d <sec>              = Duration in seconds (default 60)\n");
+    printf("   -i <ms>               = Sample interval in milliseconds (default 1000)\n");
+    printf("   -c <connect spec>     = unix: spec of an external router instead of the bundled router\n");
+    printf("   -P <pid>              = Process id of the external router, used for CPU and memory samples\n");
+    printf("   -o <file>             = Also write the samples and totals as JSON to <file>\n");
+#ifdef QCC_LOCK_PROFILER
+    printf("\nSet ER_LOCK_PROFILE=1 to rank the bundled router's most contended locks at the end of the run.\n");
+#endif
+}
+
+/** Main entry point */
+int CDECL_CALL main(int argc, char** argv)
+{
+    for (int i = 1; i < argc; ++i) {
+        bool hasParam = (i + 1 < argc);
+        if (0 == strcmp("-h", argv[i])) {
+            usage();
+            exit(0);
+        } else if ((0 == strcmp("-n", argv[i])) && hasParam) {
+            g_config.clients = strtoul(argv[++i], NULL, 0);
+        } else if ((0 == strcmp("-T", argv[i])) && hasParam) {
+            g_config.threads = strtoul(argv[++i], NULL, 0);
+        } else if ((0 == strcmp("-r", argv[i])) && hasParam) {
+            g_config.rate = strtod(argv[++i], NULL);
+        } else if ((0 == strcmp("-k", argv[i])) && hasParam) {
+            g_config.churnPercent = strtoul(argv[++i], NULL, 0);
+        } else if ((0 == strcmp("-d", argv[i])) && hasParam) {
+            g_config.durationSec = strtoul(argv[++i], NULL, 0);
+        } else if ((0 == strcmp("-i", argv[i])) && hasParam) {
+            g_config.intervalMs = strtoul(argv[++i], NULL, 0);
+        } else if ((0 == strcmp("-c", argv[i])) && hasParam) {
+            g_config.connectSpec = argv[++i];
+        } else if ((0 == strcmp("-P", argv[i])) && hasParam) {
+            g_config.routerPid = strtoul(argv[++i], NULL, 0);
+        } else if ((0 == strcmp("-o", argv[i])) && hasParam) {
+            g_config.outFile = argv[++i];
+        } else {
+            printf("Unknown option %s\n", argv[i]);
+            usage();
+            exit(1);
+        }
+    }
+    if ((g_config.clients == 0) || (g_config.threads == 0) || (g_config.rate <= 0.0) || (g_config.intervalMs == 0) ||
+        (g_config.churnPercent > 100)) {
+        usage();
+        exit(1);
+    }
+    if (g_config.threads > g_config.clients) {
+        g_config.threads = g_config.clients;
+    }
+
+    /* Every virtual client is a socket, and with the bundled router the router's side is too */
+    struct rlimit rl;
+    if (getrlimit(RLIMIT_NOFILE, &rl) == 0) {
+        rl.rlim_cur = rl.rlim_max;
+        setrlimit(RLIMIT_NOFILE, &rl);
+        if (rl.rlim_cur < 2 * g_config.clients + 256) {
+            printf("Warning: open file limit %lu may be too low for %u clients\n", (unsigned long)rl.rlim_cur, g_config.clients);
+        }
+    }
+
+    if (AllJoynInit() != ER_OK) {
+        return 1;
+    }
+    bool bundled = g_config.connectSpec.empty();
+    BusAttachment* starter = NULL;
+    if (bundled) {
+#ifdef ROUTER
+        String path = "ajsoak-" + U32ToString(GetPid());
+        g_config.connectSpec = "unix:abstract=" + path;
+        String routerConfig = "<busconfig><listen>unix:abstract=" + path + "</listen></busconfig>";
+        if (AllJoynRouterInitWithConfig(routerConfig.c_str()) != ER_OK) {
+            AllJoynShutdown();
+            return 1;
+        }
+        /* The bundled router only comes up when an application attaches to it */
+        starter = new BusAttachment("ajsoak", true);
+        QStatus status = starter->Start();
+        if (status == ER_OK) {
+            status = starter->Connect("null:");
+        }
+        if (status != ER_OK) {
+            QCC_LogError(status, ("Failed to start the bundled router"));
+            delete starter;
+            AllJoynRouterShutdown();
+            AllJoynShutdown();
+            return 1;
+        }
+#else
+        printf("This build has no bundled router, use -c to name an external router\n");
+        usage();
+        AllJoynShutdown();
+        exit(1);
+#endif
+    }
+
+    struct sockaddr_un addr;
+    socklen_t addrLen;
+    if (!ParseConnectSpec(g_config.connectSpec, addr, addrLen)) {
+        printf("Unsupported connect spec %s, only unix:abstract= and unix:path= are supported\n", g_config.connectSpec.c_str());
+        exit(1);
+    }
+
+    printf("AllJoyn Library version: %s\n", ajn::GetVersion());
+    printf("AllJoyn Library build info: %s\n", ajn::GetBuildInfo());
+
+    signal(SIGINT, SigIntHandler);
+
+    g_hosts.Resize(g_config.clients);
+    vector<SoakWorker*> workers;
+    uint32_t first = 0;
+    for (uint32_t i = 0; i < g_config.threads; ++i) {
+        uint32_t count = g_config.clients / g_config.threads + ((i < g_config.clients % g_config.threads) ? 1 : 0);
+        workers.push_back(new SoakWorker(i, first, count));
+        first += count;
+    }
+
+    printf("Connecting %u clients to %s%s\n", g_config.clients, g_config.connectSpec.c_str(), bundled ? " (bundled router)" : "");
+    for (size_t i = 0; i < workers.size(); ++i) {
+        workers[i]->Start();
+    }
+
+    printf("\n%8s %8s %10s %8s %8s %8s %10s %10s %10s %8s %9s\n", "time s", "clients", "ops/s", "errors", "timeouts",
+           "lost", "max ms", "rx-q KB", "tx-q KB", "cpu %", "rss MB");
+
+    vector<Sample> samples;
+    uint64_t start = NowUs();
+    uint64_t end = start + (uint64_t)g_config.durationSec * 1000000;
+    uint64_t lastSample = start;
+    uint64_t lastOps = 0;
+    uint64_t lastErrors = 0;
+    uint64_t lastRouterCpu = 0;
+    uint64_t procCpu = 0;
+    uint64_t rss = 0;
+    ProcessUsage(bundled ? 0 : g_config.routerPid, procCpu, rss);
+    lastRouterCpu = procCpu;
+    uint64_t peakRss = rss;
+
+    while (!g_interrupt) {
+        uint64_t now = NowUs();
+        if (now >= end) {
+            break;
+        }
+        uint64_t wake = lastSample + g_config.intervalMs * 1000ULL;
+        if (now < wake) {
+            qcc::Sleep((uint32_t)(((wake < end ? wake : end) - now) / 1000) + 1);
+            continue;
+        }
+        OpStats cumulative[OP_COUNT];
+        Sample s;
+        memset(&s, 0, sizeof(s));
+        uint64_t ops = 0;
+        uint64_t clientCpu = 0;
+        for (size_t i = 0; i < workers.size(); ++i) {
+            workers[i]->Snapshot(cumulative, s.maxUs, ops, s.connected, s.rxBacklog, s.txBacklog, s.lost, s.timeouts, clientCpu);
+        }
+        uint64_t errors = 0;
+        for (size_t i = 0; i < OP_COUNT; ++i) {
+            errors += cumulative[i].errors;
+        }
+        now = NowUs();
+        double dt = (now - lastSample) / 1e6;
+        s.seconds = (now - start) / 1e6;
+        s.opsPerSec = (ops - lastOps) / dt;
+        s.errors = errors - lastErrors;
+        if (ProcessUsage(bundled ? 0 : g_config.routerPid, procCpu, rss)) {
+            /* With the bundled router the client threads share the process, take their time out */
+            uint64_t routerCpu = bundled ? procCpu - (clientCpu < procCpu ? clientCpu : procCpu) : procCpu;
+            s.routerCpu = (routerCpu > lastRouterCpu) ? 100.0 * (routerCpu - lastRouterCpu) / (now - lastSample) : 0.0;
+            lastRouterCpu = routerCpu;
+            s.rssBytes = rss;
+            peakRss = (rss > peakRss) ? rss : peakRss;
+        }
+        lastSample = now;
+        lastOps = ops;
+        lastErrors = errors;
+        samples.push_back(s);
+        printf("%8.1f %8u %10.1f %8" PRIu64 " %8" PRIu64 " %8" PRIu64 " %10.2f %10.1f %10.1f %8.1f %9.1f\n",
+               s.seconds, s.connected, s.opsPerSec, s.errors, s.timeouts, s.lost, s.maxUs / 1000.0,
+               s.rxBacklog / 1024.0, s.txBacklog / 1024.0, s.routerCpu, s.rssBytes / (1024.0 * 1024.0));
+        fflush(stdout);
+    }
+
+    for (size_t i = 0; i < workers.size(); ++i) {
+        workers[i]->Stop();
+    }
+    for (size_t i = 0; i < workers.size(); ++i) {
+        workers[i]->Join();
+    }
+    Sample last;
+    memset(&last, 0, sizeof(last));
+    uint64_t ops = 0;
+    uint64_t cpu = 0;
+    OpStats totals[OP_COUNT];
+    for (size_t i = 0; i < workers.size(); ++i) {
+        workers[i]->Snapshot(totals, last.maxUs, ops, last.connected, last.rxBacklog, last.txBacklog, last.lost, last.timeouts, cpu);
+    }
+    double seconds = (NowUs() - start) / 1e6;
+
+    uint64_t errors = 0;
+    printf("\n%-16s %10s %8s %10s %10s %10s %10s\n", "operation", "count", "errors", "mean ms", "p50 ms", "p99 ms", "max ms");
+    for (size_t i = 0; i < OP_COUNT; ++i) {
+        const OpStats& st = totals[i];
+        errors += st.errors;
+        printf("%-16s %10" PRIu64 " %8" PRIu64 " %10.3f %10.3f %10.3f %10.3f\n", OpNames[i], st.count, st.errors,
+               st.count ? st.sumUs / 1000.0 / st.count : 0.0, st.Percentile(50) / 1000.0, st.Percentile(99) / 1000.0,
+               st.maxUs / 1000.0);
+    }
+    printf("ops: %" PRIu64 " in %.1f s (%.1f ops/s), timeouts: %" PRIu64 ", lost connections: %" PRIu64 ", peak rss: %.1f MB\n",
+           ops, seconds, seconds > 0 ? ops / seconds : 0.0, last.timeouts, last.lost, peakRss / (1024.0 * 1024.0));
+#ifdef QCC_LOCK_PROFILER
+    if (bundled && LockProfiler::IsEnabled()) {
+        printf("\n%s", LockProfiler::Dump(10).c_str());
+    }
+#endif
+
+    if (!g_config.outFile.empty()) {
+        FILE* out = fopen(g_config.outFile.c_str(), "w");
+        if (out) {
+            fprintf(out, "{\n");
+            fprintf(out, "  \"config\": {\"clients\": %u, \"threads\": %u, \"rate\": %.3f, \"churn_percent\": %u, \"duration_s\": %u, "
+                    "\"interval_ms\": %u, \"connect_spec\": \"%s\", \"bundled\": %s},\n",
+                    g_config.clients, g_config.threads, g_config.rate, g_config.churnPercent, g_config.durationSec,
+                    g_config.intervalMs, g_config.connectSpec.c_str(), bundled ? "true" : "false");
+            fprintf(out, "  \"samples\": [\n");
+            for (size_t i = 0; i < samples.size(); ++i) {
+                const Sample& s = samples[i];
+                fprintf(out, "    {\"t\": %.3f, \"clients\": %u, \"ops_per_second\": %.1f, \"errors\": %" PRIu64 ", "
+                        "\"timeouts\": %" PRIu64 ", \"lost\": %" PRIu64 ", \"max_us\": %" PRIu64 ", \"rx_queue_bytes\": %" PRIu64 ", "
+                        "\"tx_queue_bytes\": %" PRIu64 ", \"router_cpu_percent\": %.1f, \"rss_bytes\": %" PRIu64 "}%s\n",
+                        s.seconds, s.connected, s.opsPerSec, s.errors, s.timeouts, s.lost, s.maxUs, s.rxBacklog,
+                        s.txBacklog, s.routerCpu, s.rssBytes, (i + 1 < samples.size()) ? "," : "");
+            }
+            fprintf(out, "  ],\n  \"operations\": {\n");
+            for (size_t i = 0; i < OP_COUNT; ++i) {
+                const OpStats& st = totals[i];
+                fprintf(out, "    \"%s\": {\"count\": %" PRIu64 ", \"errors\": %" PRIu64 ", \"mean_us\": %.1f, \"p50_us\": %" PRIu64 ", "
+                        "\"p99_us\": %" PRIu64 ", \"max_us\": %" PRIu64 "}%s\n", OpNames[i], st.count, st.errors,
+                        st.count ? (double)st.sumUs / st.count : 0.0, st.Percentile(50), st.Percentile(99), st.maxUs,
+                        (i + 1 < OP_COUNT) ? "," : "");
+            }
+            fprintf(out, "  },\n  \"peak_rss_bytes\": %" PRIu64 "\n}\n", peakRss);
+            fclose(out);
+        } else {
+            printf("Unable to open %s\n", g_config.outFile.c_str());
+        }
+    }
+
+    for (size_t i = 0; i < workers.size(); ++i) {
+        delete workers[i];
+    }
+    if (starter) {
+        starter->Disconnect();
+        starter->Stop();
+        starter->Join();
+        delete starter;
+    }
+#ifdef ROUTER
+    if (bundled) {
+        AllJoynRouterShutdown();
+    }
+#endif
+    AllJoynShutdown();
+
+    return ((errors == 0) && (last.timeouts == 0) && (last.lost == 0) && (ops > 0)) ? 0 : 2;
+}
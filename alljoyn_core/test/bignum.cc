@@ -32,6 +32,8 @@
 #include <string.h>
 
 #include <qcc/BigNum.h>
+#include <qcc/time.h>
+#include <qcc/Util.h>
 #include <alljoyn/Init.h>
 #include <alljoyn/Status.h>
 
@@ -104,8 +106,104 @@ static const char Prime50[] = "BC5A136B0D466A89DEB3128C9EC165E3185E1CD887944721F
 
 static const uint8_t zeroes[256] = { 0 };
 
-int CDECL_CALL main()
+/*
+ * Each benchmark runs for at least this many milliseconds so the coarse timestamp granularity on
+ * some platforms does not dominate the result.
+ */
+static const uint64_t BENCH_MIN_MS = 1000;
+
+enum BenchOp {
+    BENCH_MUL,
+    BENCH_MOD,
+    BENCH_MOD_EXP
+};
+
+static void Benchmark(const char* name, BenchOp op, const BigNum& a, const BigNum& b, const BigNum& m)
 {
+    BigNum r;
+    uint64_t iterations = 0;
+    uint64_t start = GetTimestamp64();
+    uint64_t elapsed = 0;
+    do {
+        for (int i = 0; i < 10; ++i) {
+            switch (op) {
+            case BENCH_MUL:
+                r = a * b;
+                break;
+
+            case BENCH_MOD:
+                r = a % m;
+                break;
+
+            case BENCH_MOD_EXP:
+                r = a.mod_exp(b, m);
+                break;
+            }
+        }
+        iterations += 10;
+        elapsed = GetTimestamp64() - start;
+    } while (elapsed < BENCH_MIN_MS);
+    printf("%-28s %10.2f us/op (%u ops)\n", name, (1000.0 * elapsed) / iterations, (unsigned)iterations);
+}
+
+static void RunBenchmarks()
+{
+    BigNum a;
+    BigNum b;
+    BigNum m;
+    BigNum e;
+    BigNum g = 2;
+
+    printf("BigNum benchmarks (%u bit digits)\n", (unsigned)BigNum::digit_bits);
+
+    static const size_t mulSizes[] = { 128, 256, 512, 1024, 2048 };
+    for (size_t i = 0; i < ArraySize(mulSizes); ++i) {
+        char name[64];
+        a.gen_rand(mulSizes[i]);
+        b.gen_rand(mulSizes[i]);
+        snprintf(name, sizeof(name), "mul %u x %u", (unsigned)(8 * mulSizes[i]), (unsigned)(8 * mulSizes[i]));
+        Benchmark(name, BENCH_MUL, a, b, m);
+    }
+
+    m.set_bytes(Prime1024, sizeof(Prime1024));
+    a.gen_rand(2 * sizeof(Prime1024));
+    Benchmark("mod 2048 % 1024", BENCH_MOD, a, b, m);
+
+    // The modular exponentiations performed by an SRP handshake
+    e.gen_rand(32);
+    Benchmark("mod_exp 1024, 256 bit exp", BENCH_MOD_EXP, g, e, m);
+    e.gen_rand(sizeof(Prime1024));
+    Benchmark("mod_exp 1024, 1024 bit exp", BENCH_MOD_EXP, g, e, m);
+
+    m.set_bytes(Prime1536, sizeof(Prime1536));
+    e.gen_rand(sizeof(Prime1536));
+    Benchmark("mod_exp 1536, 1536 bit exp", BENCH_MOD_EXP, g, e, m);
+
+    // Even modulus does not use Montgomery multiplication
+    m = m + 1;
+    e.gen_rand(sizeof(Prime1024));
+    Benchmark("mod_exp 1536 even, 1024 exp", BENCH_MOD_EXP, g, e, m);
+}
+
+static void Usage()
+{
+    printf("Usage: bignum [-b]\n");
+    printf("   -b   Run the benchmarks only\n");
+}
+
+int CDECL_CALL main(int argc, char** argv)
+{
+    bool benchOnly = false;
+
+    for (int i = 1; i < argc; ++i) {
+        if (strcmp(argv[i], "-b") == 0) {
+            benchOnly = true;
+        } else {
+            Usage();
+            return 1;
+        }
+    }
+
     if (AllJoynInit() != ER_OK) {
         return 1;
     }
@@ -116,6 +214,15 @@ int CDECL_CALL main()
     }
 #endif
 
+    if (benchOnly) {
+        RunBenchmarks();
+#ifdef ROUTER
+        AllJoynRouterShutdown();
+#endif
+        AllJoynShutdown();
+        return 0;
+    }
+
     BigNum M;
     BigNum E;
     BigNum bn1;
@@ -475,6 +582,22 @@ int CDECL_CALL main()
     }
     printf("\n");
 
+    printf("large multiplication stress\n");
+    for (int i = 200; i < 1200; i += 50) {
+        for (int n = 0; n < 20; ++n) {
+            bn1.gen_rand(i + n);
+            bn2.gen_rand(i);
+            bn3.gen_rand(i / 2);
+            bn4 = bn1 * bn2;
+            // Check against division and against products of smaller operands
+            CHECK((bn4 / bn2) == bn1);
+            CHECK((bn4 % bn2) == 0);
+            CHECK((bn1 * (bn2 + bn3)) == (bn4 + bn1 * bn3));
+        }
+        printf("%d ", i);
+    }
+    printf("\n");
+
     printf("Modular exponentiation stress\n");
     // Modular exponentiation stress
     for (int i = 2; i < 200; ++i) {
@@ -505,6 +628,25 @@ int CDECL_CALL main()
                 printf("!!!!!check failed\n");
                 exit(1);
             }
+            // Same again with an even modulus
+            m = m + 1;
+            check = 1;
+            k = e.bit_len();
+            while (k) {
+                check = (check * check) % m;
+                if (e.test_bit(--k)) {
+                    check = (check * a) % m;
+                }
+            }
+            exp = a.mod_exp(e, m);
+            if (exp != check) {
+                printf("mod_exp (even modulus) failed\n");
+                printf("val: %s\n", a.get_hex().c_str());
+                printf("exp: %s\n", e.get_hex().c_str());
+                printf("mod: %s\n", m.get_hex().c_str());
+                printf("!!!!!check failed\n");
+                exit(1);
+            }
         }
         printf("%d ", i);
         if ((i % 20) == 0) {
@@ -514,6 +656,9 @@ int CDECL_CALL main()
 
     delete [] buf;
 
+    printf("\n");
+    RunBenchmarks();
+
 #ifdef ROUTER
     AllJoynRouterShutdown();
 #endif
@@ -2263,6 +2263,42 @@ TEST(AboutDataTest, caseInsensitiveLanguageTag) {
     EXPECT_STREQ("dispositivo", deviceName);
 }
 
+TEST(AboutDataTest, GetAboutDataVersion) {
+    AboutData aboutData("en");
+    // Caching is opt-in
+    EXPECT_EQ(0U, aboutData.GetAboutDataVersion());
+    aboutData.SetCacheable(true);
+    uint32_t version = aboutData.GetAboutDataVersion();
+    EXPECT_NE(0U, version);
+
+    // Reading the about data does not change its version
+    MsgArg aboutArg;
+    aboutData.GetAboutData(&aboutArg, "en");
+    char* defaultLanguage;
+    EXPECT_EQ(ER_OK, aboutData.GetDefaultLanguage(&defaultLanguage));
+    EXPECT_EQ(version, aboutData.GetAboutDataVersion());
+
+    EXPECT_EQ(ER_OK, aboutData.SetModelNumber("123456"));
+    EXPECT_NE(version, aboutData.GetAboutDataVersion());
+    version = aboutData.GetAboutDataVersion();
+
+    EXPECT_EQ(ER_OK, aboutData.SetDeviceName("dispositivo", "es"));
+    EXPECT_NE(version, aboutData.GetAboutDataVersion());
+
+    // A copy does not inherit the setting and never reuses the version of
+    // the AboutData it was copied from
+    AboutData copy(aboutData);
+    EXPECT_EQ(0U, copy.GetAboutDataVersion());
+    copy.SetCacheable(true);
+    EXPECT_NE(0U, copy.GetAboutDataVersion());
+    EXPECT_NE(aboutData.GetAboutDataVersion(), copy.GetAboutDataVersion());
+
+    // Translations from an external translator can change at any time
+    MyAboutDataTranslator translator;
+    aboutData.SetTranslator(&translator);
+    EXPECT_EQ(0U, aboutData.GetAboutDataVersion());
+}
+
 //TEST(AboutDataTest, SetSupportUrlEmpty) {
 //    QStatus status = ER_FAIL;
 //    AboutData aboutData("en");
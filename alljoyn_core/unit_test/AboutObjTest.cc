@@ -38,6 +38,7 @@
 
 #include <qcc/Thread.h>
 #include <qcc/GUID.h>
+#include <qcc/StringUtil.h>
 
 #include "ajTestCommon.h"
 
@@ -575,3 +576,216 @@ TEST_F(AboutObjTest, Unannounce) {
     clientBus.Stop();
     clientBus.Join();
 }
+
+TEST_F(AboutObjTest, GetAboutDataAfterAboutDataChanges) {
+    QStatus status = ER_FAIL;
+
+    aboutData.SetCacheable(true);
+    AboutObj aboutObj(*serviceBus);
+    status = aboutObj.Announce(port, aboutData);
+    EXPECT_EQ(ER_OK, status);
+
+    BusAttachment clientBus("AboutObjTestClient", true);
+    status = clientBus.Start();
+    EXPECT_EQ(ER_OK, status);
+    status = clientBus.Connect();
+    EXPECT_EQ(ER_OK, status);
+
+    SessionId sessionId;
+    SessionOpts opts;
+    status = clientBus.JoinSession(serviceBus->GetUniqueName().c_str(), port, NULL, sessionId, opts);
+    ASSERT_EQ(ER_OK, status);
+
+    AboutProxy aProxy(clientBus, serviceBus->GetUniqueName().c_str(), sessionId);
+
+    // Ask twice so the second reply comes from the cached dictionary
+    for (int i = 0; i < 2; ++i) {
+        MsgArg aboutArg;
+        status = aProxy.GetAboutData("en", aboutArg);
+        EXPECT_EQ(ER_OK, status);
+        AboutData testAboutData(aboutArg);
+        char* desc;
+        status = testAboutData.GetDescription(&desc);
+        EXPECT_EQ(ER_OK, status);
+        EXPECT_STREQ("A poetic description of this application", desc);
+    }
+
+    // The next reply must not come from the cache
+    status = aboutData.SetDescription("A prosaic description of this application");
+    EXPECT_EQ(ER_OK, status);
+
+    MsgArg aboutArg;
+    status = aProxy.GetAboutData("en", aboutArg);
+    EXPECT_EQ(ER_OK, status);
+    AboutData testAboutData(aboutArg);
+    char* desc;
+    status = testAboutData.GetDescription(&desc);
+    EXPECT_EQ(ER_OK, status);
+    EXPECT_STREQ("A prosaic description of this application", desc);
+
+    // Announcing again picks up the change as well
+    status = aboutObj.Announce(port, aboutData);
+    EXPECT_EQ(ER_OK, status);
+
+    clientBus.Stop();
+    clientBus.Join();
+}
+
+TEST_F(AboutObjTest, GetAboutDataAfterAnnounceWithFieldChangedInPlace) {
+    QStatus status = ER_FAIL;
+
+    aboutData.SetCacheable(true);
+    AboutObj aboutObj(*serviceBus);
+    status = aboutObj.Announce(port, aboutData);
+    EXPECT_EQ(ER_OK, status);
+
+    BusAttachment clientBus("AboutObjTestClient", true);
+    status = clientBus.Start();
+    EXPECT_EQ(ER_OK, status);
+    status = clientBus.Connect();
+    EXPECT_EQ(ER_OK, status);
+
+    SessionId sessionId;
+    SessionOpts opts;
+    status = clientBus.JoinSession(serviceBus->GetUniqueName().c_str(), port, NULL, sessionId, opts);
+    ASSERT_EQ(ER_OK, status);
+
+    AboutProxy aProxy(clientBus, serviceBus->GetUniqueName().c_str(), sessionId);
+
+    MsgArg aboutArg;
+    status = aProxy.GetAboutData("en", aboutArg);
+    EXPECT_EQ(ER_OK, status);
+
+    // Changing a field through GetField does not change the version of the
+    // about data but announcing it again must not reuse the cached dictionary
+    MsgArg* modelNumber;
+    status = aboutData.GetField("ModelNumber", modelNumber);
+    ASSERT_EQ(ER_OK, status);
+    status = modelNumber->Set("s", "654321");
+    EXPECT_EQ(ER_OK, status);
+    status = aboutObj.Announce(port, aboutData);
+    EXPECT_EQ(ER_OK, status);
+
+    status = aProxy.GetAboutData("en", aboutArg);
+    EXPECT_EQ(ER_OK, status);
+    AboutData testAboutData(aboutArg);
+    char* model;
+    status = testAboutData.GetModelNumber(&model);
+    EXPECT_EQ(ER_OK, status);
+    EXPECT_STREQ("654321", model);
+
+    clientBus.Stop();
+    clientBus.Join();
+}
+
+/* AboutDataListener that is not an AboutData, its about data is never cached */
+class AboutObjTestAboutDataListener : public AboutDataListener {
+  public:
+    AboutObjTestAboutDataListener(AboutData& aboutData) : aboutData(aboutData) { }
+
+    QStatus GetAboutData(MsgArg* msgArg, const char* language) {
+        return aboutData.GetAboutData(msgArg, language);
+    }
+
+    QStatus GetAnnouncedAboutData(MsgArg* msgArg) {
+        return aboutData.GetAnnouncedAboutData(msgArg);
+    }
+
+  private:
+    AboutData& aboutData;
+};
+
+TEST_F(AboutObjTest, GetAboutDataFromListenerIsNotCached) {
+    QStatus status = ER_FAIL;
+
+    AboutObjTestAboutDataListener aboutDataListener(aboutData);
+    AboutObj aboutObj(*serviceBus);
+    status = aboutObj.Announce(port, aboutDataListener);
+    EXPECT_EQ(ER_OK, status);
+
+    BusAttachment clientBus("AboutObjTestClient", true);
+    status = clientBus.Start();
+    EXPECT_EQ(ER_OK, status);
+    status = clientBus.Connect();
+    EXPECT_EQ(ER_OK, status);
+
+    SessionId sessionId;
+    SessionOpts opts;
+    status = clientBus.JoinSession(serviceBus->GetUniqueName().c_str(), port, NULL, sessionId, opts);
+    ASSERT_EQ(ER_OK, status);
+
+    AboutProxy aProxy(clientBus, serviceBus->GetUniqueName().c_str(), sessionId);
+
+    MsgArg aboutArg;
+    status = aProxy.GetAboutData("en", aboutArg);
+    EXPECT_EQ(ER_OK, status);
+
+    // The listener is asked again for every call
+    MsgArg* modelNumber;
+    status = aboutData.GetField("ModelNumber", modelNumber);
+    ASSERT_EQ(ER_OK, status);
+    status = modelNumber->Set("s", "654321");
+    EXPECT_EQ(ER_OK, status);
+
+    status = aProxy.GetAboutData("en", aboutArg);
+    EXPECT_EQ(ER_OK, status);
+    AboutData testAboutData(aboutArg);
+    char* model;
+    status = testAboutData.GetModelNumber(&model);
+    EXPECT_EQ(ER_OK, status);
+    EXPECT_STREQ("654321", model);
+
+    clientBus.Stop();
+    clientBus.Join();
+}
+
+/* AboutData subclass that builds a new dictionary for every GetAboutData call, so it is not cacheable */
+class AboutObjTestCountingAboutData : public AboutData {
+  public:
+    AboutObjTestCountingAboutData(const AboutData& aboutData) : AboutData(aboutData), calls(0) { }
+
+    QStatus GetAboutData(MsgArg* msgArg, const char* language) {
+        SetModelNumber(qcc::U32ToString(++calls).c_str());
+        return AboutData::GetAboutData(msgArg, language);
+    }
+
+  private:
+    uint32_t calls;
+};
+
+TEST_F(AboutObjTest, GetAboutDataFromAboutDataSubclassIsNotCached) {
+    QStatus status = ER_FAIL;
+
+    AboutObjTestCountingAboutData countingAboutData(aboutData);
+    AboutObj aboutObj(*serviceBus);
+    status = aboutObj.Announce(port, countingAboutData);
+    EXPECT_EQ(ER_OK, status);
+
+    BusAttachment clientBus("AboutObjTestClient", true);
+    status = clientBus.Start();
+    EXPECT_EQ(ER_OK, status);
+    status = clientBus.Connect();
+    EXPECT_EQ(ER_OK, status);
+
+    SessionId sessionId;
+    SessionOpts opts;
+    status = clientBus.JoinSession(serviceBus->GetUniqueName().c_str(), port, NULL, sessionId, opts);
+    ASSERT_EQ(ER_OK, status);
+
+    AboutProxy aProxy(clientBus, serviceBus->GetUniqueName().c_str(), sessionId);
+
+    // Announce asked once, every GetAboutData call asks again
+    for (uint32_t i = 2; i < 4; ++i) {
+        MsgArg aboutArg;
+        status = aProxy.GetAboutData("en", aboutArg);
+        EXPECT_EQ(ER_OK, status);
+        AboutData testAboutData(aboutArg);
+        char* model;
+        status = testAboutData.GetModelNumber(&model);
+        EXPECT_EQ(ER_OK, status);
+        EXPECT_STREQ(qcc::U32ToString(i).c_str(), model);
+    }
+
+    clientBus.Stop();
+    clientBus.Join();
+}
@@ -32,6 +32,8 @@
 #include <qcc/GUID.h>
 #include <qcc/StringUtil.h>
 #include <qcc/Thread.h>
+#include <qcc/atomic.h>
+#include <qcc/time.h>
 
 #include <alljoyn/KeyStoreListener.h>
 #include <alljoyn/Status.h>
@@ -1358,3 +1360,231 @@ TEST_F(AuthListenerECDHETest, ConcurrentKeyExchange_2Threads_SRP)
     EXPECT_STREQ(clientListener.chosenMechanism.c_str(), mechanism);
     EXPECT_STREQ(serverListener.chosenMechanism.c_str(), mechanism);
 }
+
+/*
+ * Listener that can hold the key exchange of the peer it belongs to until the test releases it,
+ * so the conversation of the other peer is known to be waiting on a reply.
+ */
+class GatedKeyXListener : public AuthListenerECDHETest::ECDHEKeyXListener {
+  public:
+    GatedKeyXListener(bool server, bool gated) : ECDHEKeyXListener(server), authCompleteCount(0), securityViolationCount(0), lastViolation(ER_OK)
+    {
+        if (!gated) {
+            gate.SetEvent();
+        }
+    }
+
+    bool RequestCredentials(const char* authMechanism, const char* authPeer, uint16_t authCount, const char* userId, uint16_t credMask, Credentials& creds)
+    {
+        requested.SetEvent();
+        Event::Wait(gate, 60000);
+        return ECDHEKeyXListener::RequestCredentials(authMechanism, authPeer, authCount, userId, credMask, creds);
+    }
+
+    void AuthenticationComplete(const char* authMechanism, const char* authPeer, bool success)
+    {
+        ECDHEKeyXListener::AuthenticationComplete(authMechanism, authPeer, success);
+        IncrementAndFetch(&authCompleteCount);
+        completed.SetEvent();
+    }
+
+    void SecurityViolation(QStatus status, const Message& msg)
+    {
+        QCC_UNUSED(msg);
+        lastViolation = status;
+        IncrementAndFetch(&securityViolationCount);
+        violated.SetEvent();
+    }
+
+    Event requested;
+    Event gate;
+    Event completed;
+    Event violated;
+    volatile int32_t authCompleteCount;
+    volatile int32_t securityViolationCount;
+    QStatus lastViolation;
+};
+
+class SecureConnectionThread : public Thread {
+  public:
+    SecureConnectionThread(BusAttachment& bus, const String& peerName) : Thread("SecureConnectionThread"), bus(bus), peerName(peerName), result(ER_FAIL)
+    {
+    }
+    QStatus GetResult() const
+    {
+        return result;
+    }
+  protected:
+    ThreadReturn STDCALL Run(void* arg) {
+        QCC_UNUSED(arg);
+        result = bus.SecureConnection(peerName.c_str());
+        return static_cast<ThreadReturn>(0);
+    }
+  private:
+    BusAttachment& bus;
+    String peerName;
+    QStatus result;
+};
+
+TEST_F(AuthListenerECDHETest, ConversationsCompleteWithTheConversationInProgress)
+{
+    GatedKeyXListener gatedServerListener(true, true);
+    GatedKeyXListener countingClientListener(false, false);
+    EXPECT_EQ(ER_OK, serverBus.EnablePeerSecurity("ALLJOYN_ECDHE_NULL", &gatedServerListener, NULL));
+    EXPECT_EQ(ER_OK, clientBus.EnablePeerSecurity("ALLJOYN_ECDHE_NULL", &countingClientListener, NULL));
+
+    SecureConnectionThread first(clientBus, serverBus.GetUniqueName());
+    first.Start();
+    ASSERT_EQ(ER_OK, Event::Wait(gatedServerListener.requested, METHOD_CALL_TIMEOUT));
+
+    /* A synchronous caller waits for the conversation, an asynchronous one attaches to it */
+    SecureConnectionThread second(clientBus, serverBus.GetUniqueName());
+    second.Start();
+    EXPECT_EQ(ER_OK, clientBus.SecureConnectionAsync(serverBus.GetUniqueName().c_str()));
+    qcc::Sleep(WAIT_TIME_500);
+    gatedServerListener.gate.SetEvent();
+
+    first.Join();
+    second.Join();
+    EXPECT_EQ(ER_OK, first.GetResult());
+    EXPECT_EQ(ER_OK, second.GetResult());
+    EXPECT_EQ(1, countingClientListener.authCompleteCount);
+    EXPECT_TRUE(countingClientListener.authComplete);
+    EXPECT_EQ(ER_TIMEOUT, Event::Wait(countingClientListener.violated, WAIT_TIME_500));
+    EXPECT_EQ(ER_OK, ExerciseOn());
+}
+
+TEST_F(AuthListenerECDHETest, ConversationsFailWithTheConversationInProgress)
+{
+    GatedKeyXListener gatedServerListener(true, true);
+    GatedKeyXListener countingClientListener(false, false);
+    gatedServerListener.sendKeys = false;
+    EXPECT_EQ(ER_OK, serverBus.EnablePeerSecurity("ALLJOYN_ECDHE_NULL", &gatedServerListener, NULL));
+    EXPECT_EQ(ER_OK, clientBus.EnablePeerSecurity("ALLJOYN_ECDHE_NULL", &countingClientListener, NULL));
+
+    SecureConnectionThread first(clientBus, serverBus.GetUniqueName());
+    first.Start();
+    ASSERT_EQ(ER_OK, Event::Wait(gatedServerListener.requested, METHOD_CALL_TIMEOUT));
+
+    SecureConnectionThread second(clientBus, serverBus.GetUniqueName());
+    second.Start();
+    EXPECT_EQ(ER_OK, clientBus.SecureConnectionAsync(serverBus.GetUniqueName().c_str()));
+    qcc::Sleep(WAIT_TIME_500);
+    gatedServerListener.gate.SetEvent();
+
+    first.Join();
+    second.Join();
+    EXPECT_EQ(ER_AUTH_FAIL, first.GetResult());
+    EXPECT_EQ(ER_AUTH_FAIL, second.GetResult());
+    EXPECT_EQ(1, countingClientListener.authCompleteCount);
+    EXPECT_FALSE(countingClientListener.authComplete);
+    /* Only the asynchronous request reports its failure as a security violation */
+    ASSERT_EQ(ER_OK, Event::Wait(countingClientListener.violated, METHOD_CALL_TIMEOUT));
+    EXPECT_EQ(1, countingClientListener.securityViolationCount);
+    EXPECT_EQ(ER_AUTH_FAIL, countingClientListener.lastViolation);
+}
+
+TEST_F(AuthListenerECDHETest, ConversationFailsOnErrorReply)
+{
+    GatedKeyXListener countingClientListener(false, false);
+    EXPECT_EQ(ER_OK, clientBus.EnablePeerSecurity("ALLJOYN_ECDHE_NULL", &countingClientListener, NULL));
+
+    /* The router answers ExchangeGuids with an error for a peer that does not exist */
+    uint64_t start = GetTimestamp64();
+    EXPECT_EQ(ER_AUTH_FAIL, clientBus.SecureConnection(":AuthListenerECDHETest.1"));
+    /* The conversation ends with the error reply, it does not wait for the reply timeout */
+    EXPECT_GT(static_cast<uint64_t>(METHOD_CALL_TIMEOUT), GetTimestamp64() - start);
+    EXPECT_EQ(0, countingClientListener.authCompleteCount);
+}
+
+class BlockingObject : public BusObject {
+  public:
+    BlockingObject(BusAttachment& bus) : BusObject("/AuthListenerECDHETest/Blocking")
+    {
+        const InterfaceDescription* ifc = CreateInterface(bus);
+        EXPECT_TRUE(ifc != NULL);
+        if (ifc != NULL) {
+            EXPECT_EQ(ER_OK, AddInterface(*ifc));
+            EXPECT_EQ(ER_OK, AddMethodHandler(ifc->GetMember("Block"), static_cast<MessageReceiver::MethodHandler>(&BlockingObject::Block)));
+        }
+    }
+
+    static const InterfaceDescription* CreateInterface(BusAttachment& bus)
+    {
+        InterfaceDescription* ifc = NULL;
+        if (bus.CreateInterface("org.alljoyn.test.Blocking", ifc) == ER_OK) {
+            ifc->AddMethod("Block", NULL, NULL, NULL);
+            ifc->Activate();
+        }
+        return bus.GetInterface("org.alljoyn.test.Blocking");
+    }
+
+    void Block(const InterfaceDescription::Member* member, Message& msg)
+    {
+        QCC_UNUSED(member);
+        QCC_UNUSED(msg);
+        blocked.SetEvent();
+        Event::Wait(release, 60000);
+    }
+
+    Event blocked;
+    Event release;
+};
+
+TEST_F(AuthListenerECDHETest, ConversationFailsOnTimeoutReply)
+{
+    /* A peer with a single dispatcher thread that is kept busy does not answer ExchangeGuids in time */
+    BusAttachment blockedBus("AuthListenerECDHETestBlocked", false, 1);
+    InMemoryKeyStoreListener blockedKeyStoreListener;
+    GatedKeyXListener blockedListener(true, false);
+    BlockingObject blockingObject(blockedBus);
+    ASSERT_EQ(ER_OK, blockedBus.Start());
+    ASSERT_EQ(ER_OK, blockedBus.Connect());
+    EXPECT_EQ(ER_OK, blockedBus.RegisterKeyStoreListener(blockedKeyStoreListener));
+    EXPECT_EQ(ER_OK, blockedBus.EnablePeerSecurity("ALLJOYN_ECDHE_NULL", &blockedListener, NULL));
+    EXPECT_EQ(ER_OK, blockedBus.RegisterBusObject(blockingObject));
+
+    GatedKeyXListener countingClientListener(false, false);
+    EXPECT_EQ(ER_OK, clientBus.EnablePeerSecurity("ALLJOYN_ECDHE_NULL", &countingClientListener, NULL));
+    const InterfaceDescription* blockingIfc = BlockingObject::CreateInterface(clientBus);
+    ASSERT_TRUE(blockingIfc != NULL);
+    ProxyBusObject proxy(clientBus, blockedBus.GetUniqueName().c_str(), blockingObject.GetPath(), 0);
+    EXPECT_EQ(ER_OK, proxy.AddInterface(*blockingIfc));
+    /* No reply is expected, the call only keeps the dispatcher of the blocked bus busy */
+    EXPECT_EQ(ER_OK, proxy.MethodCall("org.alljoyn.test.Blocking", "Block", NULL, 0));
+    ASSERT_EQ(ER_OK, Event::Wait(blockingObject.blocked, METHOD_CALL_TIMEOUT));
+
+    EXPECT_EQ(ER_AUTH_FAIL, clientBus.SecureConnection(blockedBus.GetUniqueName().c_str()));
+    EXPECT_EQ(0, countingClientListener.authCompleteCount);
+
+    blockingObject.release.SetEvent();
+    blockedBus.UnregisterBusObject(blockingObject);
+    EXPECT_EQ(ER_OK, blockedBus.Stop());
+    EXPECT_EQ(ER_OK, blockedBus.Join());
+}
+
+TEST_F(AuthListenerECDHETest, JoinFinishesConversationsWaitingOnReplies)
+{
+    GatedKeyXListener gatedServerListener(true, true);
+    EXPECT_EQ(ER_OK, serverBus.EnablePeerSecurity("ALLJOYN_ECDHE_NULL", &gatedServerListener, NULL));
+
+    BusAttachment stoppingBus("AuthListenerECDHETestStopping", false);
+    InMemoryKeyStoreListener stoppingKeyStoreListener;
+    GatedKeyXListener stoppingListener(false, false);
+    ASSERT_EQ(ER_OK, stoppingBus.Start());
+    ASSERT_EQ(ER_OK, stoppingBus.Connect());
+    EXPECT_EQ(ER_OK, stoppingBus.RegisterKeyStoreListener(stoppingKeyStoreListener));
+    EXPECT_EQ(ER_OK, stoppingBus.EnablePeerSecurity("ALLJOYN_ECDHE_NULL", &stoppingListener, NULL));
+
+    SecureConnectionThread waiting(stoppingBus, serverBus.GetUniqueName());
+    waiting.Start();
+    ASSERT_EQ(ER_OK, Event::Wait(gatedServerListener.requested, METHOD_CALL_TIMEOUT));
+
+    EXPECT_EQ(ER_OK, stoppingBus.Stop());
+    EXPECT_EQ(ER_OK, stoppingBus.Join());
+    waiting.Join();
+    EXPECT_EQ(ER_BUS_STOPPING, waiting.GetResult());
+    gatedServerListener.gate.SetEvent();
+    /* The server side of the conversation still reports to its listener */
+    EXPECT_EQ(ER_OK, Event::Wait(gatedServerListener.completed, METHOD_CALL_TIMEOUT));
+}
@@ -215,3 +215,39 @@ TEST_F(AutoPingerTest, Multibus) {
     }
 
 }
+
+TEST_F(AutoPingerTest, DestinationInSeveralGroups) {
+
+    BusAttachment clientBus("app", false);
+    EXPECT_EQ(ER_OK, clientBus.Start());
+    EXPECT_EQ(ER_OK, clientBus.Connect());
+
+    TestPingListener fastListener;
+    TestPingListener slowListener;
+    autoPinger.AddPingGroup("fastgroup", fastListener, 1);
+    autoPinger.AddPingGroup("slowgroup", slowListener, 2);
+
+    qcc::String uniqueName = clientBus.GetUniqueName();
+    EXPECT_EQ(ER_OK, autoPinger.AddDestination("fastgroup", uniqueName));
+    EXPECT_EQ(ER_OK, autoPinger.AddDestination("slowgroup", uniqueName));
+
+    fastListener.WaitUntilFound(uniqueName);
+    slowListener.WaitUntilFound(uniqueName);
+    clientBus.Disconnect();
+    fastListener.WaitUntilLost(uniqueName);
+    slowListener.WaitUntilLost(uniqueName);
+
+    /* removing the destination from one group must not affect the other */
+    EXPECT_EQ(ER_OK, autoPinger.RemoveDestination("fastgroup", uniqueName));
+    clientBus.Connect();
+    uniqueName = clientBus.GetUniqueName();
+    EXPECT_EQ(ER_OK, autoPinger.AddDestination("slowgroup", uniqueName));
+    slowListener.WaitUntilFound(uniqueName);
+
+    autoPinger.RemovePingGroup("fastgroup");
+    autoPinger.RemovePingGroup("slowgroup");
+
+    clientBus.Disconnect();
+    clientBus.Stop();
+    clientBus.Join();
+}
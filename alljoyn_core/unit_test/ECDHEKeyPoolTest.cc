@@ -0,0 +1,120 @@
+/******************************************************************************
+ *    Copyright (c) Open Connectivity Foundation (OCF), AllJoyn Open Source
+ *    Project (AJOSP) Contributors and others.
+ *
+ *    SPDX-License-Identifier: Apache-2.0
+ *
+ *    All rights reserved. This program and the accompanying materials are
+ *    made available under the terms of the Apache License, Version 2.0
+ *    which accompanies this distribution, and is available at
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Copyright (c) Open Connectivity Foundation and Contributors to AllSeen
+ *    Alliance. All rights reserved.
+ *
+ *    Permission to use, copy, modify, and/or distribute this software for
+ *    any purpose with or without fee is hereby granted, provided that the
+ *    above copyright notice and this permission notice appear in all
+ *    copies.
+ *
+ *    THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+ *    WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+ *    WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ *    AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ *    DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ *    PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+ *    TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ *    PERFORMANCE OF THIS SOFTWARE.
+ ******************************************************************************/
+#include <gtest/gtest.h>
+#include "ajTestCommon.h"
+
+#include <string.h>
+
+#include <qcc/Crypto.h>
+#include <qcc/CryptoECC.h>
+#include <qcc/Thread.h>
+
+#include "ECDHEKeyPool.h"
+
+using namespace ajn;
+using namespace qcc;
+
+static bool WaitForKeyPairs(ECDHEKeyPool& pool, size_t count)
+{
+    for (int i = 0; i < 500; ++i) {
+        if (pool.GetAvailable() >= count) {
+            return true;
+        }
+        qcc::Sleep(10);
+    }
+    return false;
+}
+
+TEST(ECDHEKeyPoolTest, EmptyPoolStartsRefill)
+{
+    ECDHEKeyPool pool(2);
+    Crypto_ECC ecc;
+
+    EXPECT_EQ(static_cast<size_t>(0), pool.GetAvailable());
+    EXPECT_EQ(ER_EOF, pool.Take(ecc));
+    ASSERT_TRUE(WaitForKeyPairs(pool, 2));
+    qcc::Sleep(50);
+    EXPECT_EQ(static_cast<size_t>(2), pool.GetAvailable());
+}
+
+TEST(ECDHEKeyPoolTest, KeyPairsAreUsableAndUnique)
+{
+    ECDHEKeyPool pool(2);
+    Crypto_ECC ecc1;
+    Crypto_ECC ecc2;
+
+    EXPECT_EQ(ER_EOF, pool.Take(ecc1));
+    ASSERT_TRUE(WaitForKeyPairs(pool, 2));
+    ASSERT_EQ(ER_OK, pool.Take(ecc1));
+    ASSERT_EQ(ER_OK, pool.Take(ecc2));
+    EXPECT_FALSE(*ecc1.GetDHPublicKey() == *ecc2.GetDHPublicKey());
+    EXPECT_FALSE(*ecc1.GetDHPrivateKey() == *ecc2.GetDHPrivateKey());
+
+    ECCSecret secret1;
+    ECCSecret secret2;
+    ASSERT_EQ(ER_OK, ecc1.GenerateSharedSecret(ecc2.GetDHPublicKey(), &secret1));
+    ASSERT_EQ(ER_OK, ecc2.GenerateSharedSecret(ecc1.GetDHPublicKey(), &secret2));
+    uint8_t pms1[Crypto_SHA256::DIGEST_SIZE];
+    uint8_t pms2[Crypto_SHA256::DIGEST_SIZE];
+    ASSERT_EQ(ER_OK, secret1.DerivePreMasterSecret(pms1, sizeof(pms1)));
+    ASSERT_EQ(ER_OK, secret2.DerivePreMasterSecret(pms2, sizeof(pms2)));
+    EXPECT_EQ(0, memcmp(pms1, pms2, sizeof(pms1)));
+
+    /* Taking key pairs wakes the refill thread */
+    EXPECT_TRUE(WaitForKeyPairs(pool, 2));
+}
+
+TEST(ECDHEKeyPoolTest, StoppedPoolDoesNotRefill)
+{
+    ECDHEKeyPool pool(2);
+    Crypto_ECC ecc;
+
+    EXPECT_EQ(ER_OK, pool.Stop());
+    EXPECT_EQ(ER_EOF, pool.Take(ecc));
+    qcc::Sleep(100);
+    EXPECT_EQ(static_cast<size_t>(0), pool.GetAvailable());
+}
+
+TEST(ECDHEKeyPoolTest, JoinedPoolRefillsAgain)
+{
+    ECDHEKeyPool pool(2);
+    Crypto_ECC ecc;
+
+    EXPECT_EQ(ER_EOF, pool.Take(ecc));
+    ASSERT_TRUE(WaitForKeyPairs(pool, 2));
+    EXPECT_EQ(ER_OK, pool.Stop());
+    EXPECT_EQ(ER_OK, pool.Join());
+
+    /* Key pairs generated before the pool was stopped are still handed out */
+    ASSERT_EQ(ER_OK, pool.Take(ecc));
+    ASSERT_EQ(ER_OK, pool.Take(ecc));
+
+    /* And taking them started the refill thread again */
+    EXPECT_TRUE(WaitForKeyPairs(pool, 2));
+}
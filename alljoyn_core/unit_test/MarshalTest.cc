@@ -29,6 +29,7 @@
 #include <ctype.h>
 #include <qcc/platform.h>
 #include <queue>
+#include <vector>
 #include <algorithm>
 
 #include <qcc/Util.h>
@@ -36,8 +37,11 @@
 #include <qcc/String.h>
 #include <qcc/StringUtil.h>
 
+#include <alljoyn/AuthListener.h>
 #include <alljoyn/BusAttachment.h>
+#include <alljoyn/BusObject.h>
 #include <alljoyn/Message.h>
+#include <alljoyn/ProxyBusObject.h>
 #include <alljoyn/version.h>
 
 #include <alljoyn/Status.h>
@@ -113,6 +117,8 @@ class MyMessage : public _Message {
 
     MyMessage(MyMessage& msg) : _Message(msg) { };
 
+    MyMessage(const _Message& msg) : _Message(msg) { };
+
     QStatus MethodCall(const char* destination,
                        const char* objPath,
                        const char* iface,
@@ -125,6 +131,23 @@ class MyMessage : public _Message {
         return CallMsg(sig, destination, 0, objPath, iface, methodName, argList, numArgs, flags);
     }
 
+    QStatus Template(const char* destination,
+                     const char* objPath,
+                     const char* iface,
+                     const char* methodName,
+                     const char* sig)
+    {
+        return CallTemplate(sig, destination, 0, objPath, iface, methodName);
+    }
+
+    QStatus MethodCall(const MyMessage& callTemplate,
+                       const MsgArg* argList,
+                       size_t numArgs,
+                       uint8_t flags = 0)
+    {
+        return CallMsg(callTemplate, argList, numArgs, flags);
+    }
+
     QStatus Signal(const char* destination,
                    const char* objPath,
                    const char* iface,
@@ -156,6 +179,16 @@ class MyMessage : public _Message {
     {
         return _Message::Deliver(ep);
     }
+
+    QStatus DeliverNonBlocking(RemoteEndpoint& ep)
+    {
+        return _Message::DeliverNonBlocking(ep);
+    }
+
+    void SetSerial(uint32_t serial)
+    {
+        _Message::SetSerialNumber(serial);
+    }
 };
 
 
@@ -320,6 +353,311 @@ TEST(MarshalTest, TestMsgUnpack) {
     delete bus;
 }
 
+TEST(MarshalTest, CopyOnWriteBuffer) {
+    BusAttachment* bus = new BusAttachment("CopyOnWriteBuffer", false);
+    bus->Start();
+
+    TestPipe stream;
+    TestPipe* pStream = &stream;
+    static const bool falsiness = false;
+    RemoteEndpoint ep(*bus, falsiness, pStream);
+
+    MyMessage msg(*bus);
+    MsgArg arg("s", "hello");
+    ASSERT_EQ(ER_OK, msg.Signal("a.b.c", "/foo/bar", "foo.bar", "test", &arg, 1));
+    uint32_t serial = msg.GetCallSerial();
+
+    /* The copy shares the marshalled bytes, changing its serial number must not change the original */
+    MyMessage copy(msg);
+    copy.SetSerial(serial + 1);
+    ASSERT_EQ(ER_OK, copy.Deliver(ep));
+    ASSERT_EQ(ER_OK, msg.Deliver(ep));
+
+    uint32_t expectedSerials[] = { serial + 1, serial };
+    for (size_t i = 0; i < ArraySize(expectedSerials); ++i) {
+        MyMessage rcv(*bus);
+        ASSERT_EQ(ER_OK, rcv.Read(ep, ":88.88"));
+        ASSERT_EQ(ER_OK, rcv.Unmarshal(ep, ":88.88"));
+        ASSERT_EQ(ER_OK, rcv.UnmarshalBody());
+        EXPECT_EQ(expectedSerials[i], rcv.GetCallSerial());
+        const char* str;
+        ASSERT_EQ(ER_OK, rcv.GetArgs("s", &str));
+        EXPECT_STREQ("hello", str);
+    }
+    delete bus;
+}
+
+TEST(MarshalTest, CallFromTemplate) {
+    BusAttachment* bus = new BusAttachment("CallFromTemplate", false);
+    bus->Start();
+
+    TestPipe stream;
+    TestPipe* pStream = &stream;
+    static const bool falsiness = false;
+    RemoteEndpoint ep(*bus, falsiness, pStream);
+
+    MyMessage callTemplate(*bus);
+    ASSERT_EQ(ER_OK, callTemplate.Template("a.b.c", "/foo/bar", "foo.bar", "test", "su"));
+
+    /* The signature in the template must match the arguments */
+    MyMessage bad(*bus);
+    MsgArg badArg("s", "hello");
+    EXPECT_EQ(ER_BUS_UNEXPECTED_SIGNATURE, bad.MethodCall(callTemplate, &badArg, 1));
+
+    const char* strs[] = { "hello", "a somewhat longer string than the first one" };
+    uint32_t serials[ArraySize(strs)];
+    for (size_t i = 0; i < ArraySize(strs); ++i) {
+        MyMessage msg(*bus);
+        MsgArg args[2];
+        args[0].Set("s", strs[i]);
+        args[1].Set("u", static_cast<uint32_t>(i));
+        ASSERT_EQ(ER_OK, msg.MethodCall(callTemplate, args, ArraySize(args), ALLJOYN_FLAG_NO_REPLY_EXPECTED));
+        serials[i] = msg.GetCallSerial();
+        ASSERT_EQ(ER_OK, msg.Deliver(ep));
+    }
+    EXPECT_NE(serials[0], serials[1]);
+
+    for (size_t i = 0; i < ArraySize(strs); ++i) {
+        MyMessage rcv(*bus);
+        ASSERT_EQ(ER_OK, rcv.Read(ep, ":88.88"));
+        ASSERT_EQ(ER_OK, rcv.Unmarshal(ep, ":88.88"));
+        ASSERT_EQ(ER_OK, rcv.UnmarshalBody());
+        EXPECT_EQ(serials[i], rcv.GetCallSerial());
+        EXPECT_EQ(MESSAGE_METHOD_CALL, rcv.GetType());
+        EXPECT_EQ(ALLJOYN_FLAG_NO_REPLY_EXPECTED, rcv.GetFlags() & ALLJOYN_FLAG_NO_REPLY_EXPECTED);
+        EXPECT_STREQ("/foo/bar", rcv.GetObjectPath());
+        EXPECT_STREQ("foo.bar", rcv.GetInterface());
+        EXPECT_STREQ("test", rcv.GetMemberName());
+        EXPECT_STREQ("a.b.c", rcv.GetDestination());
+        EXPECT_STREQ("su", rcv.GetSignature());
+        const char* str;
+        uint32_t u;
+        ASSERT_EQ(ER_OK, rcv.GetArgs("su", &str, &u));
+        EXPECT_STREQ(strs[i], str);
+        EXPECT_EQ(i, u);
+    }
+    delete bus;
+}
+
+/* The bit that marks a compressed body on bus-to-bus connections, formerly ALLJOYN_FLAG_COMPRESSED */
+static const uint8_t COMPRESSED_FLAG = 0x40;
+
+/* Offset of the flags in the fixed message header */
+static const size_t FLAGS_OFFSET = 2;
+
+static const bool incoming = false;
+
+class CompressionTest : public testing::Test {
+  public:
+    BusAttachment bus;
+    TestPipe stream;
+    TestPipe* pStream;
+    RemoteEndpoint ep;
+    qcc::String big;
+
+    CompressionTest() : bus("CompressionTest", false), pStream(&stream), ep(bus, incoming, pStream), big(2048, 'x') { }
+
+    virtual void SetUp() {
+        ASSERT_EQ(ER_OK, bus.Start());
+        ep->SetCompressThreshold(256);
+    }
+
+    /* Deliver a message and return the number of bytes written to the stream */
+    size_t Send(MyMessage& msg) {
+        size_t before = stream.AvailBytes();
+        EXPECT_EQ(ER_OK, msg.DeliverNonBlocking(ep));
+        return stream.AvailBytes() - before;
+    }
+
+    /* Read a message back and check it carries the expected string */
+    void Receive(const char* expected) {
+        MyMessage rcv(bus);
+        ASSERT_EQ(ER_OK, rcv.Read(ep, ":88.88"));
+        ASSERT_EQ(ER_OK, rcv.Unmarshal(ep, ":88.88"));
+        EXPECT_EQ(0, rcv.GetFlags() & COMPRESSED_FLAG);
+        ASSERT_EQ(ER_OK, rcv.UnmarshalBody());
+        const char* str;
+        ASSERT_EQ(ER_OK, rcv.GetArgs("s", &str));
+        EXPECT_STREQ(expected, str);
+    }
+};
+
+TEST_F(CompressionTest, LargeBodyRoundTrip) {
+    ep->GetFeatures().bodyCompression = true;
+    MyMessage msg(bus);
+    MsgArg arg("s", big.c_str());
+    ASSERT_EQ(ER_OK, msg.Signal("a.b.c", "/foo/bar", "foo.bar", "test", &arg, 1));
+
+    EXPECT_LT(Send(msg), big.size());
+    Receive(big.c_str());
+}
+
+TEST_F(CompressionTest, BodyBelowThresholdIsSentAsIs) {
+    ep->GetFeatures().bodyCompression = true;
+    qcc::String small(200, 'x');
+    MyMessage msg(bus);
+    MsgArg arg("s", small.c_str());
+    ASSERT_EQ(ER_OK, msg.Signal("a.b.c", "/foo/bar", "foo.bar", "test", &arg, 1));
+
+    EXPECT_GT(Send(msg), small.size());
+    Receive(small.c_str());
+}
+
+TEST_F(CompressionTest, PeerWithoutCompressionGetsPlainBody) {
+    MyMessage msg(bus);
+    MsgArg arg("s", big.c_str());
+    ASSERT_EQ(ER_OK, msg.Signal("a.b.c", "/foo/bar", "foo.bar", "test", &arg, 1));
+
+    EXPECT_GT(Send(msg), big.size());
+    Receive(big.c_str());
+}
+
+TEST_F(CompressionTest, ApplicationCannotSetCompressedFlag) {
+    ep->GetFeatures().bodyCompression = true;
+    qcc::String small(16, 'x');
+    MyMessage msg(bus);
+    MsgArg arg("s", small.c_str());
+    ASSERT_EQ(ER_OK, msg.MethodCall("a.b.c", "/foo/bar", "foo.bar", "test", &arg, 1, COMPRESSED_FLAG));
+    EXPECT_EQ(0, msg.GetFlags() & COMPRESSED_FLAG);
+
+    /* A plain body flagged as compressed would fail to expand on the receiving router */
+    Send(msg);
+    Receive(small.c_str());
+}
+
+TEST_F(CompressionTest, CompressedFlagIsDroppedOnPlainConnection) {
+    qcc::String small(16, 'x');
+    MyMessage msg(bus);
+    MsgArg arg("s", small.c_str());
+    ASSERT_EQ(ER_OK, msg.Signal("a.b.c", "/foo/bar", "foo.bar", "test", &arg, 1));
+    size_t len = Send(msg);
+
+    /* Set the bit on the wire like an old application would */
+    std::vector<uint8_t> buf(len);
+    size_t actual;
+    ASSERT_EQ(ER_OK, stream.PullBytes(&buf[0], len, actual));
+    ASSERT_EQ(len, actual);
+    buf[FLAGS_OFFSET] |= COMPRESSED_FLAG;
+    ASSERT_EQ(ER_OK, stream.PushBytes(&buf[0], len, actual));
+
+    Receive(small.c_str());
+}
+
+static const char* IN_PROCESS_SECURE_INTERFACE = "org.alljoyn.test.InProcess.Secure";
+static const char* IN_PROCESS_PLAIN_INTERFACE = "org.alljoyn.test.InProcess.Plain";
+
+class InProcessTestObject : public BusObject {
+  public:
+    Message received;
+
+    InProcessTestObject(BusAttachment& bus) : BusObject("/test"), received(bus) {
+        const char* ifaceNames[] = { IN_PROCESS_SECURE_INTERFACE, IN_PROCESS_PLAIN_INTERFACE };
+        for (size_t i = 0; i < ArraySize(ifaceNames); ++i) {
+            const InterfaceDescription* iface = bus.GetInterface(ifaceNames[i]);
+            EXPECT_TRUE(iface != NULL);
+            AddInterface(*iface);
+            AddMethodHandler(iface->GetMember("Echo"), static_cast<MessageReceiver::MethodHandler>(&InProcessTestObject::Echo));
+        }
+    }
+
+    void Echo(const InterfaceDescription::Member* member, Message& msg) {
+        QCC_UNUSED(member);
+        received = msg;
+        MethodReply(msg, msg->GetArg(0), 1);
+    }
+};
+
+/*
+ * Both bus attachments connect to the bundled router so they exchange messages in-process.
+ */
+class InProcessTest : public testing::Test {
+  public:
+    BusAttachment serviceBus;
+    BusAttachment clientBus;
+    DefaultECDHEAuthListener serviceAuthListener;
+    DefaultECDHEAuthListener clientAuthListener;
+    InProcessTestObject* obj;
+    TestPipe stream;
+    TestPipe* pStream;
+    RemoteEndpoint ep;
+
+    InProcessTest() : serviceBus("InProcessService", false), clientBus("InProcessClient", false), obj(NULL),
+        pStream(&stream), ep(clientBus, incoming, pStream) { }
+
+    void CreateInterfaces(BusAttachment& bus) {
+        InterfaceDescription* iface = NULL;
+        ASSERT_EQ(ER_OK, bus.CreateInterface(IN_PROCESS_SECURE_INTERFACE, iface, AJ_IFC_SECURITY_REQUIRED));
+        ASSERT_EQ(ER_OK, iface->AddMethod("Echo", "s", "s", "in,out"));
+        iface->Activate();
+        ASSERT_EQ(ER_OK, bus.CreateInterface(IN_PROCESS_PLAIN_INTERFACE, iface));
+        ASSERT_EQ(ER_OK, iface->AddMethod("Echo", "s", "s", "in,out"));
+        iface->Activate();
+    }
+
+    virtual void SetUp() {
+        CreateInterfaces(serviceBus);
+        CreateInterfaces(clientBus);
+        ASSERT_EQ(ER_OK, serviceBus.Start());
+        ASSERT_EQ(ER_OK, serviceBus.Connect());
+        ASSERT_EQ(ER_OK, clientBus.Start());
+        ASSERT_EQ(ER_OK, clientBus.Connect());
+        ASSERT_EQ(ER_OK, serviceBus.EnablePeerSecurity("ALLJOYN_ECDHE_NULL", &serviceAuthListener, "InProcessTestServiceKeyStore"));
+        ASSERT_EQ(ER_OK, clientBus.EnablePeerSecurity("ALLJOYN_ECDHE_NULL", &clientAuthListener, "InProcessTestClientKeyStore"));
+        obj = new InProcessTestObject(serviceBus);
+        ASSERT_EQ(ER_OK, serviceBus.RegisterBusObject(*obj));
+    }
+
+    virtual void TearDown() {
+        if (obj) {
+            serviceBus.UnregisterBusObject(*obj);
+            delete obj;
+        }
+        serviceBus.ClearKeyStore();
+        clientBus.ClearKeyStore();
+    }
+
+    QStatus Call(const char* ifaceName, const char* str, Message& reply) {
+        ProxyBusObject proxy(clientBus, serviceBus.GetUniqueName().c_str(), "/test", 0);
+        proxy.AddInterface(*clientBus.GetInterface(ifaceName));
+        MsgArg arg("s", str);
+        return proxy.MethodCall(ifaceName, "Echo", &arg, 1, reply);
+    }
+};
+
+TEST_F(InProcessTest, SecureMessageIsNeverDeliveredUnencrypted) {
+    Message reply(clientBus);
+    ASSERT_EQ(ER_OK, Call(IN_PROCESS_SECURE_INTERFACE, "secret", reply));
+    EXPECT_STREQ("secret", reply->GetArg(0)->v_string.str);
+    EXPECT_TRUE(reply->IsEncrypted());
+
+    /* The body of the call was left in plain text so it must not be written to a remote hop */
+    ASSERT_TRUE(obj->received->IsEncrypted());
+    MyMessage call(*obj->received);
+    EXPECT_EQ(ER_BUS_MESSAGE_NOT_ENCRYPTED, call.Deliver(ep));
+    EXPECT_EQ(ER_BUS_MESSAGE_NOT_ENCRYPTED, call.DeliverNonBlocking(ep));
+
+    MyMessage replyCopy(*reply);
+    EXPECT_EQ(ER_BUS_MESSAGE_NOT_ENCRYPTED, replyCopy.Deliver(ep));
+    EXPECT_EQ(0U, stream.AvailBytes());
+}
+
+TEST_F(InProcessTest, PlainMessageIsMarshalledWhenDeliveredRemotely) {
+    Message reply(clientBus);
+    ASSERT_EQ(ER_OK, Call(IN_PROCESS_PLAIN_INTERFACE, "plain", reply));
+    EXPECT_STREQ("plain", reply->GetArg(0)->v_string.str);
+
+    /* The call was delivered without a marshalled body, it is built when the wire format is needed */
+    MyMessage call(*obj->received);
+    ASSERT_EQ(ER_OK, call.Deliver(ep));
+    MyMessage rcv(clientBus);
+    ASSERT_EQ(ER_OK, rcv.Read(ep, ":88.88"));
+    ASSERT_EQ(ER_OK, rcv.Unmarshal(ep, ":88.88"));
+    ASSERT_EQ(ER_OK, rcv.UnmarshalBody());
+    const char* str;
+    ASSERT_EQ(ER_OK, rcv.GetArgs("s", &str));
+    EXPECT_STREQ("plain", str);
+}
+
 TEST(MarshalTest, ReplayProtection) {
     QStatus status = ER_OK;
 
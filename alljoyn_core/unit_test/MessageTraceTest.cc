@@ -0,0 +1,303 @@
+/******************************************************************************
+ *    Copyright (c) Open Connectivity Foundation (OCF), AllJoyn Open Source
+ *    Project (AJOSP) Contributors and others.
+ *
+ *    SPDX-License-Identifier: Apache-2.0
+ *
+ *    All rights reserved. This program and the accompanying materials are
+ *    made available under the terms of the Apache License, Version 2.0
+ *    which accompanies this distribution, and is available at
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Copyright (c) Open Connectivity Foundation and Contributors to AllSeen
+ *    Alliance. All rights reserved.
+ *
+ *    Permission to use, copy, modify, and/or distribute this software for
+ *    any purpose with or without fee is hereby granted, provided that the
+ *    above copyright notice and this permission notice appear in all
+ *    copies.
+ *
+ *    THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+ *    WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+ *    WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ *    AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ *    DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ *    PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+ *    TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ *    PERFORMANCE OF THIS SOFTWARE.
+ ******************************************************************************/
+#include <gtest/gtest.h>
+#include "ajTestCommon.h"
+
+#include <string.h>
+#include <vector>
+
+#include <alljoyn/BusAttachment.h>
+#include <alljoyn/BusObject.h>
+#include <alljoyn/InterfaceDescription.h>
+#include <alljoyn/Message.h>
+#include <alljoyn/ProxyBusObject.h>
+#include <qcc/StringUtil.h>
+#include <qcc/Thread.h>
+
+#include "MessageTrace.h"
+
+using namespace ajn;
+using namespace qcc;
+
+static const char* TRACE_INTERFACE = "org.alljoyn.test.MessageTrace";
+static const char* TRACE_PATH = "/org/alljoyn/test/MessageTrace";
+
+class MessageTraceTestObject : public BusObject {
+  public:
+    MessageTraceTestObject(BusAttachment& bus) : BusObject(TRACE_PATH)
+    {
+        const InterfaceDescription* intf = bus.GetInterface(TRACE_INTERFACE);
+        EXPECT_TRUE(intf != NULL);
+        if (intf) {
+            AddInterface(*intf);
+            AddMethodHandler(intf->GetMember("Ping"), static_cast<MessageReceiver::MethodHandler>(&MessageTraceTestObject::Ping));
+        }
+    }
+
+    void Ping(const InterfaceDescription::Member* member, Message& msg)
+    {
+        QCC_UNUSED(member);
+        MethodReply(msg, msg->GetArg(0), 1);
+    }
+};
+
+/* Stamps one message a number of times and exits */
+class MessageTraceStampThread : public Thread {
+  public:
+    MessageTraceStampThread(const char* name, BusAttachment& bus, uint32_t stamps = 1) : Thread(name), msg(bus), stamps(stamps) { }
+
+  protected:
+    ThreadReturn STDCALL Run(void* arg)
+    {
+        QCC_UNUSED(arg);
+        for (uint32_t i = 0; i < stamps; ++i) {
+            MessageTrace::Stamp(MessageTrace::MARSHAL, *msg);
+        }
+        return 0;
+    }
+
+  private:
+    Message msg;
+    uint32_t stamps;
+};
+
+class MessageTraceTest : public testing::Test {
+  public:
+    MessageTraceTest() : bus("MessageTraceTest"), object(NULL) { }
+
+    virtual void SetUp()
+    {
+        InterfaceDescription* intf = NULL;
+        ASSERT_EQ(ER_OK, bus.CreateInterface(TRACE_INTERFACE, intf));
+        ASSERT_EQ(ER_OK, intf->AddMethod("Ping", "s", "s", "in,out"));
+        intf->Activate();
+        object = new MessageTraceTestObject(bus);
+        ASSERT_EQ(ER_OK, bus.RegisterBusObject(*object));
+        ASSERT_EQ(ER_OK, bus.Start());
+        ASSERT_EQ(ER_OK, bus.Connect(getConnectArg().c_str()));
+        MessageTrace::Reset();
+    }
+
+    virtual void TearDown()
+    {
+        MessageTrace::SetEnabled(false);
+        MessageTrace::Reset();
+        bus.UnregisterBusObject(*object);
+        bus.Disconnect();
+        bus.Stop();
+        bus.Join();
+        delete object;
+    }
+
+    /* Ping our own object and return the serial number of the method call */
+    uint32_t Ping()
+    {
+        ProxyBusObject proxy(bus, bus.GetUniqueName().c_str(), TRACE_PATH, 0);
+        EXPECT_EQ(ER_OK, proxy.AddInterface(TRACE_INTERFACE));
+        Message reply(bus);
+        MsgArg arg("s", "ping");
+        EXPECT_EQ(ER_OK, proxy.MethodCall(TRACE_INTERFACE, "Ping", &arg, 1, reply));
+        return reply->GetReplySerial();
+    }
+
+    /* Stages stamped for the message with the given serial sent by this bus, in time order */
+    std::vector<MessageTrace::Stage> Stages(const std::vector<MessageTrace::Event>& events, uint32_t serial)
+    {
+        std::vector<MessageTrace::Stage> stages;
+        for (size_t i = 0; i < events.size(); ++i) {
+            if ((events[i].serial == serial) && (strncmp(events[i].sender, bus.GetUniqueName().c_str(), sizeof(events[i].sender) - 1) == 0)) {
+                stages.push_back(static_cast<MessageTrace::Stage>(events[i].stage));
+            }
+        }
+        return stages;
+    }
+
+    BusAttachment bus;
+    MessageTraceTestObject* object;
+};
+
+TEST_F(MessageTraceTest, DisabledRecordsNothing)
+{
+    MessageTrace::SetEnabled(false);
+    uint32_t serial = Ping();
+
+    std::vector<MessageTrace::Event> events;
+    MessageTrace::GetEvents(events);
+    EXPECT_TRUE(Stages(events, serial).empty());
+}
+
+TEST_F(MessageTraceTest, MethodCallStages)
+{
+    MessageTrace::SetEnabled(true, 1);
+    uint32_t serial = Ping();
+    MessageTrace::SetEnabled(false);
+
+    std::vector<MessageTrace::Event> events;
+    MessageTrace::GetEvents(events);
+    std::vector<MessageTrace::Stage> stages = Stages(events, serial);
+
+    /*
+     * The call is routed back to our own local endpoint. How many routers it passes through
+     * depends on how the test connects to the routing node.
+     */
+    qcc::String path;
+    for (size_t i = 0; i < stages.size(); ++i) {
+        path += qcc::String(" ") + MessageTrace::GetStageName(stages[i]);
+    }
+    ASSERT_LE(5U, stages.size()) << path.c_str();
+    size_t last = stages.size() - 1;
+    EXPECT_EQ(MessageTrace::MARSHAL, stages[0]) << path.c_str();
+    for (size_t i = 1; i < last - 2; ++i) {
+        EXPECT_TRUE((stages[i] == MessageTrace::ROUTE) || (stages[i] == MessageTrace::TX_QUEUE) ||
+                    (stages[i] == MessageTrace::TX_WRITE) || (stages[i] == MessageTrace::RX_UNMARSHAL)) << path.c_str();
+    }
+    EXPECT_EQ(MessageTrace::ROUTE, stages[1]) << path.c_str();
+    EXPECT_EQ(MessageTrace::LOCAL_QUEUE, stages[last - 2]) << path.c_str();
+    EXPECT_EQ(MessageTrace::DISPATCH, stages[last - 1]) << path.c_str();
+    EXPECT_EQ(MessageTrace::HANDLED, stages[last]) << path.c_str();
+
+    for (size_t i = 1; i < events.size(); ++i) {
+        EXPECT_LE(events[i - 1].timestampNs, events[i].timestampNs);
+    }
+
+    /* The reply is traced too and refers back to the call */
+    bool sawReply = false;
+    for (size_t i = 0; i < events.size(); ++i) {
+        if (events[i].replySerial == serial) {
+            EXPECT_EQ(MESSAGE_METHOD_RET, events[i].msgType);
+            sawReply = true;
+        } else if (events[i].serial == serial) {
+            EXPECT_STREQ("Ping", events[i].member);
+            EXPECT_EQ(MESSAGE_METHOD_CALL, events[i].msgType);
+            EXPECT_FALSE(MessageTrace::GetThreadName(events[i].threadIndex).empty());
+        }
+    }
+    EXPECT_TRUE(sawReply);
+}
+
+TEST_F(MessageTraceTest, SamplingFollowsSerial)
+{
+    MessageTrace::SetEnabled(true, 2);
+    std::vector<uint32_t> serials;
+    for (int i = 0; i < 6; ++i) {
+        serials.push_back(Ping());
+    }
+    MessageTrace::SetEnabled(false);
+
+    std::vector<MessageTrace::Event> events;
+    MessageTrace::GetEvents(events);
+    for (size_t i = 0; i < serials.size(); ++i) {
+        EXPECT_EQ((serials[i] % 2) == 0, !Stages(events, serials[i]).empty()) << "serial " << serials[i];
+    }
+    for (size_t i = 0; i < events.size(); ++i) {
+        EXPECT_EQ(0U, events[i].serial % 2);
+    }
+}
+
+TEST_F(MessageTraceTest, ChromeTraceJson)
+{
+    MessageTrace::SetEnabled(true, 1);
+    uint32_t serial = Ping();
+    MessageTrace::SetEnabled(false);
+
+    qcc::String json = MessageTrace::ToJson();
+    EXPECT_EQ(0U, json.find("{\"displayTimeUnit\":\"ns\",\"traceEvents\":["));
+    EXPECT_NE(qcc::String::npos, json.find("\"name\":\"call Ping\",\"cat\":\"message\",\"ph\":\"b\""));
+    EXPECT_NE(qcc::String::npos, json.find("\"name\":\"call Ping\",\"cat\":\"message\",\"ph\":\"e\""));
+    EXPECT_NE(qcc::String::npos, json.find("\"name\":\"dispatch\",\"cat\":\"message\",\"ph\":\"n\""));
+    EXPECT_NE(qcc::String::npos, json.find("\"serial\":" + U32ToString(serial)));
+    EXPECT_NE(qcc::String::npos, json.find("\"reply_serial\":" + U32ToString(serial)));
+    EXPECT_NE(qcc::String::npos, json.find("\"name\":\"thread_name\""));
+    EXPECT_EQ(qcc::String::npos, json.find(",,"));
+    EXPECT_EQ("]}\n", json.substr(json.size() - 3));
+
+    MessageTrace::Reset();
+    std::vector<MessageTrace::Event> events;
+    MessageTrace::GetEvents(events);
+    EXPECT_TRUE(events.empty());
+}
+
+TEST_F(MessageTraceTest, BufferOfExitedThreadIsReused)
+{
+    MessageTrace::SetEnabled(true, 1);
+
+    MessageTraceStampThread first("MessageTraceFirst", bus);
+    ASSERT_EQ(ER_OK, first.Start());
+    ASSERT_EQ(ER_OK, first.Join());
+    size_t buffers = MessageTrace::GetBufferCount();
+
+    MessageTraceStampThread second("MessageTraceSecond", bus);
+    ASSERT_EQ(ER_OK, second.Start());
+    ASSERT_EQ(ER_OK, second.Join());
+    MessageTrace::SetEnabled(false);
+
+    /* The second thread took over a buffer handed back by an exited thread */
+    EXPECT_EQ(buffers, MessageTrace::GetBufferCount());
+
+    std::vector<MessageTrace::Event> events;
+    MessageTrace::GetEvents(events);
+    bool sawSecond = false;
+    for (size_t i = 0; i < events.size(); ++i) {
+        if (MessageTrace::GetThreadName(events[i].threadIndex) == "MessageTraceSecond") {
+            EXPECT_EQ(MessageTrace::MARSHAL, events[i].stage);
+            sawSecond = true;
+        }
+    }
+    EXPECT_TRUE(sawSecond);
+}
+
+TEST_F(MessageTraceTest, ReadWhileBufferWraps)
+{
+    MessageTrace::SetBufferCapacity(4);
+    MessageTrace::SetEnabled(true, 1);
+
+    MessageTraceStampThread writer("MessageTraceWriter", bus, 100000);
+    ASSERT_EQ(ER_OK, writer.Start());
+    std::vector<MessageTrace::Event> events;
+    while (writer.IsRunning()) {
+        MessageTrace::GetEvents(events);
+        /* Stamps overwritten while they were copied are left out rather than returned garbled */
+        for (size_t i = 0; i < events.size(); ++i) {
+            EXPECT_EQ(MessageTrace::MARSHAL, events[i].stage);
+            EXPECT_STREQ("", events[i].sender);
+        }
+    }
+    ASSERT_EQ(ER_OK, writer.Join());
+    MessageTrace::SetEnabled(false);
+    MessageTrace::SetBufferCapacity(MessageTrace::DEFAULT_BUFFER_CAPACITY);
+
+    size_t writerStamps = 0;
+    MessageTrace::GetEvents(events);
+    for (size_t i = 0; i < events.size(); ++i) {
+        if (MessageTrace::GetThreadName(events[i].threadIndex) == "MessageTraceWriter") {
+            ++writerStamps;
+        }
+    }
+    EXPECT_EQ(4U, writerStamps);
+}
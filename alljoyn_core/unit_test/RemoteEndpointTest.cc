@@ -28,6 +28,11 @@
  ******************************************************************************/
 #include <qcc/platform.h>
 
+#include <algorithm>
+#include <limits>
+#include <string.h>
+#include <vector>
+
 #include "RemoteEndpoint.h"
 
 /* Header files included for Google Test Framework */
@@ -74,6 +79,15 @@ class _TestMessage : public _Message {
 };
 typedef qcc::ManagedObj<_TestMessage> TestMessage;
 
+class _TestMethodCall : public _Message {
+  public:
+    _TestMethodCall(BusAttachment& bus) : _Message(bus) {
+        EXPECT_EQ(ER_OK, CallMsg("", "sender", ":test.3", 0, "/path", "iface", "methodName", NULL, 0, 0));
+    }
+    virtual ~_TestMethodCall() { }
+};
+typedef qcc::ManagedObj<_TestMethodCall> TestMethodCall;
+
 class _TestRemoteEndpoint : public _RemoteEndpoint {
   public:
     _TestRemoteEndpoint(const char* uniqueName, BusAttachment& bus, bool incoming, qcc::Stream* stream)
@@ -213,6 +227,142 @@ TEST_F(RemoteEndpointTest, TxFail)
     EXPECT_TRUE(tts.closed);
 }
 
+/* Records the writes and the SetCork() calls made on it: 'W' for a write, 'C' to cork and 'U' to uncork */
+class CorkTestStream : public TestStream {
+  public:
+    virtual QStatus PushBytes(const void*, size_t numBytes, size_t& numSent) {
+        numSent = numBytes;
+        lock.Lock(MUTEX_CONTEXT);
+        log += 'W';
+        lock.Unlock(MUTEX_CONTEXT);
+        return ER_OK;
+    }
+    virtual QStatus SetCork(bool cork) {
+        lock.Lock(MUTEX_CONTEXT);
+        log += cork ? 'C' : 'U';
+        lock.Unlock(MUTEX_CONTEXT);
+        return ER_OK;
+    }
+    /* Wait for a number of writes and return the log */
+    qcc::String WaitForWrites(size_t writes) {
+        qcc::String result;
+        for (int i = 0; i < 200; ++i) {
+            lock.Lock(MUTEX_CONTEXT);
+            result = log;
+            lock.Unlock(MUTEX_CONTEXT);
+            if (static_cast<size_t>(count(result.begin(), result.end(), 'W')) >= writes) {
+                break;
+            }
+            qcc::Sleep(10);
+        }
+        return result;
+    }
+  private:
+    qcc::Mutex lock;
+    qcc::String log;
+};
+
+class PushMessageThread : public Thread {
+  public:
+    PushMessageThread(TestRemoteEndpoint& trep, Message& msg) : Thread("PushMessage"), trep(trep), msg(msg) { }
+  protected:
+    ThreadReturn STDCALL Run(void*) {
+        EXPECT_EQ(ER_OK, trep->PushMessage(msg));
+        return 0;
+    }
+  private:
+    TestRemoteEndpoint trep;
+    Message msg;
+};
+
+/*
+ * Send signals ('S') and method calls ('M') in order and return the log of the stream. Nothing
+ * is written until the senders of all but the first message are blocked in PushMessage() so
+ * the messages make up a burst.
+ */
+static qcc::String WriteBurst(BusAttachment& bus, bool coalesce, const char* types, uint64_t& messages, uint64_t& flushes,
+                              size_t maxCorkBytes = _RemoteEndpoint::DEFAULT_TX_CORK_BYTES)
+{
+    CorkTestStream cts;
+    Stream* s = &cts;
+    bool incoming = false;
+    TestRemoteEndpoint trep(":test.3", bus, incoming, s);
+    /* No time limit so that a slow test machine does not split the burst */
+    trep->SetTxCoalescing(coalesce, maxCorkBytes, (numeric_limits<uint32_t>::max)());
+    EXPECT_EQ(ER_OK, trep->Start());
+
+    vector<PushMessageThread*> senders;
+    for (const char* t = types; *t; ++t) {
+        Message m(bus);
+        if (*t == 'M') {
+            TestMethodCall tm(bus);
+            m = Message::cast(tm);
+        } else {
+            TestMessage tm(bus);
+            m = Message::cast(tm);
+        }
+        if (t == types) {
+            EXPECT_EQ(ER_OK, trep->PushMessage(m));
+        } else {
+            senders.push_back(new PushMessageThread(trep, m));
+            EXPECT_EQ(ER_OK, senders.back()->Start());
+            /* Wait for the sender to block so the senders queue up in order */
+            qcc::Sleep(ENDPOINT_TEST_WAIT_TIME / 5);
+        }
+    }
+    cts.sinkEvent.SetEvent();
+    qcc::String log = cts.WaitForWrites(strlen(types));
+    for (size_t i = 0; i < senders.size(); ++i) {
+        EXPECT_EQ(ER_OK, senders[i]->Join());
+        delete senders[i];
+    }
+    trep->GetTxStats(messages, flushes);
+
+    EXPECT_EQ(ER_OK, trep->Stop());
+    cts.sourceEvent.SetEvent();
+    EXPECT_EQ(ER_OK, trep->Join(ENDPOINT_TEST_JOIN_TIMEOUT));
+    return log;
+}
+
+TEST_F(RemoteEndpointTest, TxCoalescingUncorksWhenBurstEnds)
+{
+    uint64_t messages;
+    uint64_t flushes;
+    /* The stream is corked while signals have more behind them and uncorked for the last one */
+    EXPECT_STREQ("CWWWUW", WriteBurst(bus, true, "SSSS", messages, flushes).c_str());
+    EXPECT_EQ(4U, messages);
+    EXPECT_EQ(2U, flushes);
+}
+
+TEST_F(RemoteEndpointTest, TxCoalescingUncorksForMethodCall)
+{
+    uint64_t messages;
+    uint64_t flushes;
+    /* A method call is never held back even if more signals follow it */
+    EXPECT_STREQ("CWWUWW", WriteBurst(bus, true, "SSMS", messages, flushes).c_str());
+    EXPECT_EQ(4U, messages);
+    EXPECT_EQ(3U, flushes);
+}
+
+TEST_F(RemoteEndpointTest, TxCoalescingFlushesLongBurst)
+{
+    uint64_t messages;
+    uint64_t flushes;
+    /* With a one byte limit every signal written while corked is flushed before the next one */
+    EXPECT_STREQ("CWUCWUCWUW", WriteBurst(bus, true, "SSSS", messages, flushes, 1).c_str());
+    EXPECT_EQ(4U, messages);
+    EXPECT_EQ(4U, flushes);
+}
+
+TEST_F(RemoteEndpointTest, TxCoalescingDisabledNeverCorks)
+{
+    uint64_t messages;
+    uint64_t flushes;
+    EXPECT_STREQ("WWWW", WriteBurst(bus, false, "SSSS", messages, flushes).c_str());
+    EXPECT_EQ(4U, messages);
+    EXPECT_EQ(4U, flushes);
+}
+
 #ifdef ROUTER
 #include "DaemonRouter.h"
 
@@ -97,6 +97,11 @@ class TestBusAttachment : public BusAttachment {
             return ER_OK;
         }
         virtual const ProxyBusObject& GetDBusProxyObj() const { return dbusObj; }
+        virtual QStatus AddMatchRules(const char* const* rules, size_t numRules) {
+            QCC_UNUSED(rules);
+            QCC_UNUSED(numRules);
+            return ER_OK;
+        }
         virtual QStatus RegisterSignalHandler(MessageReceiver* receiver, MessageReceiver::SignalHandler signalHandler,
                                               const InterfaceDescription::Member* member, const char* matchRule) {
             QCC_UNUSED(receiver);
@@ -0,0 +1,68 @@
+/******************************************************************************
+ *    Copyright (c) Open Connectivity Foundation (OCF), AllJoyn Open Source
+ *    Project (AJOSP) Contributors and others.
+ *
+ *    SPDX-License-Identifier: Apache-2.0
+ *
+ *    All rights reserved. This program and the accompanying materials are
+ *    made available under the terms of the Apache License, Version 2.0
+ *    which accompanies this distribution, and is available at
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Copyright (c) Open Connectivity Foundation and Contributors to AllSeen
+ *    Alliance. All rights reserved.
+ *
+ *    Permission to use, copy, modify, and/or distribute this software for
+ *    any purpose with or without fee is hereby granted, provided that the
+ *    above copyright notice and this permission notice appear in all
+ *    copies.
+ *
+ *    THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+ *    WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+ *    WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ *    AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ *    DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ *    PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+ *    TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ *    PERFORMANCE OF THIS SOFTWARE.
+ ******************************************************************************/
+#include <qcc/platform.h>
+
+#include <alljoyn/Session.h>
+
+#include "Bus.h"
+#include "ConfigDB.h"
+#include "DaemonTransport.h"
+
+/* Header files included for Google Test Framework */
+#include <gtest/gtest.h>
+#include "../ajTestCommon.h"
+
+using namespace ajn;
+
+/*
+ * AllJoynObj only binds a session port if some transport supports the session options. A
+ * router that listens on local sockets alone must still be able to bind session ports, the
+ * sessionless object of the router binds one at startup.
+ */
+TEST(DaemonTransportTest, SupportsReliableSessionOptions)
+{
+    ConfigDB configDb("");
+    configDb.LoadConfig();
+
+    TransportFactoryContainer factories;
+    Bus bus("DaemonTransportTest", factories);
+    DaemonTransport transport(bus);
+
+    SessionOpts opts(SessionOpts::TRAFFIC_MESSAGES, false, SessionOpts::PROXIMITY_ANY, TRANSPORT_ANY);
+    EXPECT_TRUE(transport.SupportsOptions(opts));
+    opts.isMultipoint = true;
+    EXPECT_TRUE(transport.SupportsOptions(opts));
+
+    opts.traffic = SessionOpts::TRAFFIC_RAW_RELIABLE;
+    opts.isMultipoint = false;
+    EXPECT_TRUE(transport.SupportsOptions(opts));
+
+    opts.traffic = SessionOpts::TRAFFIC_RAW_UNRELIABLE;
+    EXPECT_FALSE(transport.SupportsOptions(opts));
+}
@@ -0,0 +1,351 @@
+/******************************************************************************
+ *    Copyright (c) Open Connectivity Foundation (OCF), AllJoyn Open Source
+ *    Project (AJOSP) Contributors and others.
+ *
+ *    SPDX-License-Identifier: Apache-2.0
+ *
+ *    All rights reserved. This program and the accompanying materials are
+ *    made available under the terms of the Apache License, Version 2.0
+ *    which accompanies this distribution, and is available at
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Copyright (c) Open Connectivity Foundation and Contributors to AllSeen
+ *    Alliance. All rights reserved.
+ *
+ *    Permission to use, copy, modify, and/or distribute this software for
+ *    any purpose with or without fee is hereby granted, provided that the
+ *    above copyright notice and this permission notice appear in all
+ *    copies.
+ *
+ *    THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+ *    WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+ *    WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ *    AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ *    DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ *    PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+ *    TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ *    PERFORMANCE OF THIS SOFTWARE.
+ ******************************************************************************/
+#include <qcc/platform.h>
+#include <qcc/GUID.h>
+#include <qcc/Stream.h>
+#include <qcc/String.h>
+#include <qcc/StringUtil.h>
+
+#include <vector>
+
+#include <alljoyn/BusAttachment.h>
+#include <alljoyn/Message.h>
+
+#include "RemoteEndpoint.h"
+#include "VirtualEndpoint.h"
+
+/* Header files included for Google Test Framework */
+#include <gtest/gtest.h>
+#include "../ajTestCommon.h"
+
+using namespace std;
+using namespace qcc;
+using namespace ajn;
+
+/*
+ * Stream that is never read or written, the test endpoints are not started.
+ */
+class IdleStream : public Stream {
+  public:
+    virtual QStatus PullBytes(void*, size_t, size_t& actualBytes, uint32_t) { actualBytes = 0; return ER_SOCK_OTHER_END_CLOSED; }
+    virtual Event& GetSourceEvent() { return sourceEvent; }
+    virtual QStatus PushBytes(const void*, size_t numBytes, size_t& numSent) { numSent = numBytes; return ER_OK; }
+    virtual Event& GetSinkEvent() { return sinkEvent; }
+  private:
+    Event sourceEvent;
+    Event sinkEvent;
+};
+
+/*
+ * Bus-to-bus endpoint that records the messages pushed to it in a log shared by all
+ * the routes of a test, fails them on request and reports a given queue depth.
+ */
+class _RouteEndpoint : public _RemoteEndpoint {
+  public:
+    _RouteEndpoint(BusAttachment& bus, Stream* stream, const char* name, const GUID128& remoteGuid, vector<String>& log) :
+        _RemoteEndpoint(bus, false, stream), status(ER_OK), depth(0), log(log)
+    {
+        SetUniqueName(name);
+        SetRemoteGUID(remoteGuid);
+    }
+    virtual ~_RouteEndpoint() { }
+    QStatus PushMessage(Message& msg) {
+        QCC_UNUSED(msg);
+        log.push_back(GetUniqueName());
+        return status;
+    }
+    size_t GetTxQueueDepth() const { return depth; }
+    QStatus status;
+    size_t depth;
+  private:
+    /* Private assigment operator - does nothing */
+    _RouteEndpoint operator=(const _RouteEndpoint&);
+    vector<String>& log;
+};
+typedef ManagedObj<_RouteEndpoint> RouteEndpoint;
+
+class _RouteTestMessage : public _Message {
+  public:
+    _RouteTestMessage(BusAttachment& bus, const char* sender, SessionId id) : _Message(bus) {
+        EXPECT_EQ(ER_OK, SignalMsg("", sender, NULL, id, "/route/test", "org.alljoyn.test.route", "Routed", NULL, 0, 0, 0));
+    }
+};
+
+class VirtualEndpointTest : public testing::Test {
+  public:
+    BusAttachment bus;
+    IdleStream idleStream;
+    Stream* stream;
+    GUID128 remoteGuid;
+    GUID128 otherGuid;
+    vector<String> log;
+
+    VirtualEndpointTest() : bus("VirtualEndpointTest"), stream(&idleStream) { }
+
+    RemoteEndpoint NewRoute(const char* name, GUID128& guid) {
+        RouteEndpoint route(bus, stream, name, guid, log);
+        return RemoteEndpoint::cast(route);
+    }
+
+    /* A route to the router of the virtual endpoint */
+    RemoteEndpoint Direct(const char* name) { return NewRoute(name, remoteGuid); }
+
+    /* A route through some other router */
+    RemoteEndpoint Indirect(const char* name) { return NewRoute(name, otherGuid); }
+
+    VirtualEndpoint NewVirtualEndpoint(RemoteEndpoint& b2bEp) {
+        String name = ":" + remoteGuid.ToShortString() + ".2";
+        return VirtualEndpoint(name, b2bEp);
+    }
+
+    QStatus Send(VirtualEndpoint& vep, const char* sender, SessionId id = 0) {
+        ManagedObj<_RouteTestMessage> testMsg(bus, sender, id);
+        Message msg = Message::cast(testMsg);
+        return vep->PushMessage(msg, id);
+    }
+};
+
+TEST_F(VirtualEndpointTest, DirectRouteIsPreferredWhenAddedLater)
+{
+    RemoteEndpoint indirect = Indirect(":indirect.1");
+    RemoteEndpoint direct = Direct(":direct.1");
+    VirtualEndpoint vep = NewVirtualEndpoint(indirect);
+    EXPECT_TRUE(vep->AddBusToBusEndpoint(direct));
+
+    EXPECT_EQ(ER_OK, Send(vep, ":sender.1"));
+    ASSERT_EQ(1U, log.size());
+    EXPECT_STREQ(":direct.1", log[0].c_str());
+}
+
+TEST_F(VirtualEndpointTest, RemovingLastDirectRouteEmptiesVirtualEndpoint)
+{
+    RemoteEndpoint direct = Direct(":direct.1");
+    RemoteEndpoint indirect = Indirect(":indirect.1");
+    VirtualEndpoint vep = NewVirtualEndpoint(direct);
+    EXPECT_TRUE(vep->AddBusToBusEndpoint(indirect));
+
+    /* The remaining route is indirect so the virtual endpoint reports itself as empty */
+    EXPECT_TRUE(vep->RemoveBusToBusEndpoint(direct));
+    EXPECT_EQ(ER_OK, Send(vep, ":sender.1"));
+    ASSERT_EQ(1U, log.size());
+    EXPECT_STREQ(":indirect.1", log[0].c_str());
+}
+
+TEST_F(VirtualEndpointTest, RemovingIndirectRouteKeepsVirtualEndpoint)
+{
+    RemoteEndpoint indirect = Indirect(":indirect.1");
+    RemoteEndpoint direct = Direct(":direct.1");
+    VirtualEndpoint vep = NewVirtualEndpoint(indirect);
+    EXPECT_TRUE(vep->AddBusToBusEndpoint(direct));
+
+    EXPECT_FALSE(vep->RemoveBusToBusEndpoint(indirect));
+    EXPECT_EQ(ER_OK, Send(vep, ":sender.1"));
+    ASSERT_EQ(1U, log.size());
+    EXPECT_STREQ(":direct.1", log[0].c_str());
+}
+
+TEST_F(VirtualEndpointTest, FallbackTriesDirectRoutesBeforeIndirectOnes)
+{
+    RemoteEndpoint indirectA = Indirect(":indirectA.1");
+    RemoteEndpoint directA = Direct(":directA.1");
+    RemoteEndpoint indirectB = Indirect(":indirectB.1");
+    RemoteEndpoint directB = Direct(":directB.1");
+    VirtualEndpoint vep = NewVirtualEndpoint(indirectA);
+    EXPECT_TRUE(vep->AddBusToBusEndpoint(directA));
+    EXPECT_TRUE(vep->AddBusToBusEndpoint(indirectB));
+    EXPECT_TRUE(vep->AddBusToBusEndpoint(directB));
+
+    RouteEndpoint::cast(directA)->status = ER_BUS_ENDPOINT_CLOSING;
+    RouteEndpoint::cast(directB)->status = ER_BUS_ENDPOINT_CLOSING;
+    EXPECT_EQ(ER_OK, Send(vep, ":sender.1"));
+    ASSERT_EQ(3U, log.size());
+    EXPECT_STREQ(":directA.1", log[0].c_str());
+    EXPECT_STREQ(":directB.1", log[1].c_str());
+    EXPECT_STREQ(":indirectA.1", log[2].c_str());
+}
+
+TEST_F(VirtualEndpointTest, FallbackReturnsLastErrorWhenAllRoutesFail)
+{
+    RemoteEndpoint direct = Direct(":direct.1");
+    RemoteEndpoint indirect = Indirect(":indirect.1");
+    VirtualEndpoint vep = NewVirtualEndpoint(direct);
+    EXPECT_TRUE(vep->AddBusToBusEndpoint(indirect));
+
+    RouteEndpoint::cast(direct)->status = ER_BUS_ENDPOINT_CLOSING;
+    RouteEndpoint::cast(indirect)->status = ER_BUS_NO_ROUTE;
+    EXPECT_EQ(ER_BUS_NO_ROUTE, Send(vep, ":sender.1"));
+    ASSERT_EQ(2U, log.size());
+    EXPECT_STREQ(":direct.1", log[0].c_str());
+    EXPECT_STREQ(":indirect.1", log[1].c_str());
+}
+
+TEST_F(VirtualEndpointTest, SessionStaysOnItsRoute)
+{
+    RemoteEndpoint direct = Direct(":direct.1");
+    RemoteEndpoint indirect = Indirect(":indirect.1");
+    VirtualEndpoint vep = NewVirtualEndpoint(direct);
+    EXPECT_TRUE(vep->AddBusToBusEndpoint(indirect));
+    EXPECT_EQ(ER_OK, vep->AddSessionRef(5, indirect));
+
+    /* The direct route is preferred for session 0 only */
+    EXPECT_EQ(ER_OK, Send(vep, ":sender.1", 5));
+    EXPECT_EQ(ER_OK, Send(vep, ":sender.1", 0));
+    ASSERT_EQ(2U, log.size());
+    EXPECT_STREQ(":indirect.1", log[0].c_str());
+    EXPECT_STREQ(":direct.1", log[1].c_str());
+
+    /* A session without a route fails rather than using a session 0 route */
+    EXPECT_EQ(ER_BUS_NO_ROUTE, Send(vep, ":sender.1", 6));
+    EXPECT_EQ(2U, log.size());
+}
+
+TEST_F(VirtualEndpointTest, SenderStaysOnItsRouteWhenQueuesChange)
+{
+    RemoteEndpoint directA = Direct(":directA.1");
+    RemoteEndpoint directB = Direct(":directB.1");
+    VirtualEndpoint vep = NewVirtualEndpoint(directA);
+    EXPECT_TRUE(vep->AddBusToBusEndpoint(directB));
+
+    EXPECT_EQ(ER_OK, Send(vep, ":sender.1"));
+    RouteEndpoint::cast(directA)->depth = 5;
+    EXPECT_EQ(ER_OK, Send(vep, ":sender.1"));
+    EXPECT_EQ(ER_OK, Send(vep, ":sender.2"));
+    ASSERT_EQ(3U, log.size());
+    EXPECT_STREQ(":directA.1", log[0].c_str());
+    EXPECT_STREQ(":directA.1", log[1].c_str());
+    EXPECT_STREQ(":directB.1", log[2].c_str());
+}
+
+TEST_F(VirtualEndpointTest, SingleRouteDoesNotPinSenders)
+{
+    RemoteEndpoint directA = Direct(":directA.1");
+    RemoteEndpoint directB = Direct(":directB.1");
+    VirtualEndpoint vep = NewVirtualEndpoint(directA);
+
+    EXPECT_EQ(ER_OK, Send(vep, ":sender.1"));
+    EXPECT_TRUE(vep->AddBusToBusEndpoint(directB));
+    RouteEndpoint::cast(directA)->depth = 5;
+    EXPECT_EQ(ER_OK, Send(vep, ":sender.1"));
+    ASSERT_EQ(2U, log.size());
+    EXPECT_STREQ(":directA.1", log[0].c_str());
+    EXPECT_STREQ(":directB.1", log[1].c_str());
+}
+
+TEST_F(VirtualEndpointTest, FullPinTableKeepsSendersOnBusyRoutes)
+{
+    RemoteEndpoint directA = Direct(":directA.1");
+    RemoteEndpoint directB = Direct(":directB.1");
+    VirtualEndpoint vep = NewVirtualEndpoint(directA);
+    EXPECT_TRUE(vep->AddBusToBusEndpoint(directB));
+
+    /* Pin a sender to A and keep A busy while the table fills up with senders on B */
+    EXPECT_EQ(ER_OK, Send(vep, ":busy.1"));
+    RouteEndpoint::cast(directA)->depth = 1;
+    for (int i = 0; i < 255; ++i) {
+        String sender = ":idle." + I32ToString(i);
+        EXPECT_EQ(ER_OK, Send(vep, sender.c_str()));
+    }
+    EXPECT_EQ(256U, log.size());
+    EXPECT_STREQ(":directB.1", log.back().c_str());
+
+    /* The next new sender drops the pins to B, which has nothing queued */
+    EXPECT_EQ(ER_OK, Send(vep, ":new.1"));
+    log.clear();
+    EXPECT_EQ(ER_OK, Send(vep, ":busy.1"));
+    RouteEndpoint::cast(directA)->depth = 0;
+    RouteEndpoint::cast(directB)->depth = 2;
+    EXPECT_EQ(ER_OK, Send(vep, ":idle.0"));
+    EXPECT_EQ(ER_OK, Send(vep, ":new.1"));
+    ASSERT_EQ(3U, log.size());
+    EXPECT_STREQ(":directA.1", log[0].c_str());
+    EXPECT_STREQ(":directA.1", log[1].c_str());
+    EXPECT_STREQ(":directB.1", log[2].c_str());
+}
+
+TEST_F(VirtualEndpointTest, RemovedRouteReleasesPinnedSenders)
+{
+    RemoteEndpoint directA = Direct(":directA.1");
+    RemoteEndpoint directB = Direct(":directB.1");
+    RemoteEndpoint directC = Direct(":directC.1");
+    VirtualEndpoint vep = NewVirtualEndpoint(directA);
+    EXPECT_TRUE(vep->AddBusToBusEndpoint(directB));
+    EXPECT_TRUE(vep->AddBusToBusEndpoint(directC));
+
+    EXPECT_EQ(ER_OK, Send(vep, ":sender.1"));
+    EXPECT_FALSE(vep->RemoveBusToBusEndpoint(directA));
+    RouteEndpoint::cast(directB)->depth = 5;
+    EXPECT_EQ(ER_OK, Send(vep, ":sender.1"));
+    ASSERT_EQ(2U, log.size());
+    EXPECT_STREQ(":directA.1", log[0].c_str());
+    EXPECT_STREQ(":directC.1", log[1].c_str());
+}
+
+TEST_F(VirtualEndpointTest, PinnedRouteFailureFallsBackWithoutMovingSender)
+{
+    RemoteEndpoint directA = Direct(":directA.1");
+    RemoteEndpoint directB = Direct(":directB.1");
+    VirtualEndpoint vep = NewVirtualEndpoint(directA);
+    EXPECT_TRUE(vep->AddBusToBusEndpoint(directB));
+
+    EXPECT_EQ(ER_OK, Send(vep, ":sender.1"));
+    RouteEndpoint::cast(directA)->status = ER_BUS_ENDPOINT_CLOSING;
+    EXPECT_EQ(ER_OK, Send(vep, ":sender.1"));
+    RouteEndpoint::cast(directA)->status = ER_OK;
+    EXPECT_EQ(ER_OK, Send(vep, ":sender.1"));
+    ASSERT_EQ(4U, log.size());
+    EXPECT_STREQ(":directA.1", log[0].c_str());
+    EXPECT_STREQ(":directA.1", log[1].c_str());
+    EXPECT_STREQ(":directB.1", log[2].c_str());
+    EXPECT_STREQ(":directA.1", log[3].c_str());
+}
+
+TEST_F(VirtualEndpointTest, SessionsToSameRouterKeepTheirOwnLinks)
+{
+    /* Two sessions joined to the same router, each over the link opened for it */
+    RemoteEndpoint directA = Direct(":directA.1");
+    RemoteEndpoint directB = Direct(":directB.1");
+    VirtualEndpoint vep = NewVirtualEndpoint(directA);
+    EXPECT_TRUE(vep->AddBusToBusEndpoint(directB));
+    EXPECT_EQ(ER_OK, vep->AddSessionRef(5, directA));
+    EXPECT_EQ(ER_OK, vep->AddSessionRef(6, directB));
+
+    /* Queue depth does not move a session, session 0 senders are spread over both links */
+    RouteEndpoint::cast(directA)->depth = 5;
+    EXPECT_EQ(ER_OK, Send(vep, ":sender.1", 5));
+    EXPECT_EQ(ER_OK, Send(vep, ":sender.1", 6));
+    EXPECT_EQ(ER_OK, Send(vep, ":sender.1"));
+    RouteEndpoint::cast(directA)->depth = 0;
+    RouteEndpoint::cast(directB)->depth = 5;
+    EXPECT_EQ(ER_OK, Send(vep, ":sender.2"));
+    ASSERT_EQ(4U, log.size());
+    EXPECT_STREQ(":directA.1", log[0].c_str());
+    EXPECT_STREQ(":directB.1", log[1].c_str());
+    EXPECT_STREQ(":directB.1", log[2].c_str());
+    EXPECT_STREQ(":directA.1", log[3].c_str());
+}
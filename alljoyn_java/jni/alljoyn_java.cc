@@ -12530,11 +12530,7 @@ JNIEXPORT jbyteArray JNICALL Java_org_alljoyn_bus_MsgArg_getByteArray(JNIEnv* en
     if (!jarray) {
         return NULL;
     }
-    jbyte* jelements = env->GetByteArrayElements(jarray, NULL);
-    for (size_t i = 0; i < msgArg->v_scalarArray.numElements; ++i) {
-        jelements[i] = msgArg->v_scalarArray.v_byte[i];
-    }
-    env->ReleaseByteArrayElements(jarray, jelements, 0);
+    env->SetByteArrayRegion(jarray, 0, msgArg->v_scalarArray.numElements, reinterpret_cast<const jbyte*>(msgArg->v_scalarArray.v_byte));
     return jarray;
 }
 
@@ -12551,12 +12547,7 @@ JNIEXPORT jshortArray JNICALL Java_org_alljoyn_bus_MsgArg_getInt16Array(JNIEnv*
         return NULL;
     }
 
-    jshort* jelements = env->GetShortArrayElements(jarray, NULL);
-    for (size_t i = 0; i < msgArg->v_scalarArray.numElements; ++i) {
-        jelements[i] = msgArg->v_scalarArray.v_int16[i];
-    }
-
-    env->ReleaseShortArrayElements(jarray, jelements, 0);
+    env->SetShortArrayRegion(jarray, 0, msgArg->v_scalarArray.numElements, reinterpret_cast<const jshort*>(msgArg->v_scalarArray.v_int16));
     return jarray;
 }
 
@@ -12573,12 +12564,7 @@ JNIEXPORT jshortArray JNICALL Java_org_alljoyn_bus_MsgArg_getUint16Array(JNIEnv*
         return NULL;
     }
 
-    jshort* jelements = env->GetShortArrayElements(jarray, NULL);
-    for (size_t i = 0; i < msgArg->v_scalarArray.numElements; ++i) {
-        jelements[i] = msgArg->v_scalarArray.v_uint16[i];
-    }
-
-    env->ReleaseShortArrayElements(jarray, jelements, 0);
+    env->SetShortArrayRegion(jarray, 0, msgArg->v_scalarArray.numElements, reinterpret_cast<const jshort*>(msgArg->v_scalarArray.v_uint16));
     return jarray;
 }
 
@@ -12617,12 +12603,7 @@ JNIEXPORT jintArray JNICALL Java_org_alljoyn_bus_MsgArg_getUint32Array(JNIEnv* e
         return NULL;
     }
 
-    jint* jelements = env->GetIntArrayElements(jarray, NULL);
-    for (size_t i = 0; i < msgArg->v_scalarArray.numElements; ++i) {
-        jelements[i] = msgArg->v_scalarArray.v_uint32[i];
-    }
-
-    env->ReleaseIntArrayElements(jarray, jelements, 0);
+    env->SetIntArrayRegion(jarray, 0, msgArg->v_scalarArray.numElements, reinterpret_cast<const jint*>(msgArg->v_scalarArray.v_uint32));
     return jarray;
 }
 
@@ -12639,12 +12620,7 @@ JNIEXPORT jintArray JNICALL Java_org_alljoyn_bus_MsgArg_getInt32Array(JNIEnv* en
         return NULL;
     }
 
-    jint* jelements = env->GetIntArrayElements(jarray, NULL);
-    for (size_t i = 0; i < msgArg->v_scalarArray.numElements; ++i) {
-        jelements[i] = msgArg->v_scalarArray.v_int32[i];
-    }
-
-    env->ReleaseIntArrayElements(jarray, jelements, 0);
+    env->SetIntArrayRegion(jarray, 0, msgArg->v_scalarArray.numElements, reinterpret_cast<const jint*>(msgArg->v_scalarArray.v_int32));
     return jarray;
 }
 
@@ -12661,12 +12637,7 @@ JNIEXPORT jlongArray JNICALL Java_org_alljoyn_bus_MsgArg_getInt64Array(JNIEnv* e
         return NULL;
     }
 
-    jlong* jelements = env->GetLongArrayElements(jarray, NULL);
-    for (size_t i = 0; i < msgArg->v_scalarArray.numElements; ++i) {
-        jelements[i] = msgArg->v_scalarArray.v_int64[i];
-    }
-
-    env->ReleaseLongArrayElements(jarray, jelements, 0);
+    env->SetLongArrayRegion(jarray, 0, msgArg->v_scalarArray.numElements, reinterpret_cast<const jlong*>(msgArg->v_scalarArray.v_int64));
     return jarray;
 }
 
@@ -12683,12 +12654,7 @@ JNIEXPORT jlongArray JNICALL Java_org_alljoyn_bus_MsgArg_getUint64Array(JNIEnv*
         return NULL;
     }
 
-    jlong* jelements = env->GetLongArrayElements(jarray, NULL);
-    for (size_t i = 0; i < msgArg->v_scalarArray.numElements; ++i) {
-        jelements[i] = msgArg->v_scalarArray.v_uint64[i];
-    }
-
-    env->ReleaseLongArrayElements(jarray, jelements, 0);
+    env->SetLongArrayRegion(jarray, 0, msgArg->v_scalarArray.numElements, reinterpret_cast<const jlong*>(msgArg->v_scalarArray.v_uint64));
     return jarray;
 }
 
@@ -12705,12 +12671,7 @@ JNIEXPORT jdoubleArray JNICALL Java_org_alljoyn_bus_MsgArg_getDoubleArray(JNIEnv
         return NULL;
     }
 
-    jdouble* jelements = env->GetDoubleArrayElements(jarray, NULL);
-    for (size_t i = 0; i < msgArg->v_scalarArray.numElements; ++i) {
-        jelements[i] = msgArg->v_scalarArray.v_double[i];
-    }
-
-    env->ReleaseDoubleArrayElements(jarray, jelements, 0);
+    env->SetDoubleArrayRegion(jarray, 0, msgArg->v_scalarArray.numElements, reinterpret_cast<const jdouble*>(msgArg->v_scalarArray.v_double));
     return jarray;
 }
 
@@ -13010,14 +12971,17 @@ JNIEXPORT jlong JNICALL Java_org_alljoyn_bus_MsgArg_set__JLjava_lang_String_2_3B
     QCC_UNUSED(clazz);
     // QCC_DbgPrintf(("MsgArg_set__JLjava_lang_String_2_3B"));
 
-    jbyte* jelements = env->GetByteArrayElements(jarray, NULL);
+    /* Copy straight into storage owned by the MsgArg rather than pinning the array and copying again */
+    jsize numElements = env->GetArrayLength(jarray);
+    uint8_t* elements = new uint8_t[numElements];
+    env->GetByteArrayRegion(jarray, 0, numElements, reinterpret_cast<jbyte*>(elements));
 
-    MsgArg* arg = Set(env, (MsgArg*)jmsgArg, jsignature, env->GetArrayLength(jarray), jelements);
+    MsgArg* arg = Set(env, (MsgArg*)jmsgArg, jsignature, (size_t)numElements, reinterpret_cast<jbyte*>(elements));
     if (arg) {
-        arg->Stabilize();
+        arg->SetOwnershipFlags(MsgArg::OwnsData);
+    } else {
+        delete [] elements;
     }
-
-    env->ReleaseByteArrayElements(jarray, jelements, JNI_ABORT);
     return (jlong)arg;
 }
 
@@ -13055,14 +13019,16 @@ JNIEXPORT jlong JNICALL Java_org_alljoyn_bus_MsgArg_set__JLjava_lang_String_2_3S
     QCC_UNUSED(clazz);
     // QCC_DbgPrintf(("MsgArg_set__JLjava_lang_String_2_3S"));
 
-    jshort* jelements = env->GetShortArrayElements(jarray, NULL);
+    jsize numElements = env->GetArrayLength(jarray);
+    uint16_t* elements = new uint16_t[numElements];
+    env->GetShortArrayRegion(jarray, 0, numElements, reinterpret_cast<jshort*>(elements));
 
-    MsgArg* arg = Set(env, (MsgArg*)jmsgArg, jsignature, env->GetArrayLength(jarray), jelements);
+    MsgArg* arg = Set(env, (MsgArg*)jmsgArg, jsignature, (size_t)numElements, reinterpret_cast<jshort*>(elements));
     if (arg) {
-        arg->Stabilize();
+        arg->SetOwnershipFlags(MsgArg::OwnsData);
+    } else {
+        delete [] elements;
     }
-
-    env->ReleaseShortArrayElements(jarray, jelements, JNI_ABORT);
     return (jlong)arg;
 }
 
@@ -13071,14 +13037,16 @@ JNIEXPORT jlong JNICALL Java_org_alljoyn_bus_MsgArg_set__JLjava_lang_String_2_3I
     QCC_UNUSED(clazz);
     // QCC_DbgPrintf(("MsgArg_set__JLjava_lang_String_2_3I"));
 
-    jint* jelements = env->GetIntArrayElements(jarray, NULL);
+    jsize numElements = env->GetArrayLength(jarray);
+    uint32_t* elements = new uint32_t[numElements];
+    env->GetIntArrayRegion(jarray, 0, numElements, reinterpret_cast<jint*>(elements));
 
-    MsgArg* arg = Set(env, (MsgArg*)jmsgArg, jsignature, env->GetArrayLength(jarray), jelements);
+    MsgArg* arg = Set(env, (MsgArg*)jmsgArg, jsignature, (size_t)numElements, reinterpret_cast<jint*>(elements));
     if (arg) {
-        arg->Stabilize();
+        arg->SetOwnershipFlags(MsgArg::OwnsData);
+    } else {
+        delete [] elements;
     }
-
-    env->ReleaseIntArrayElements(jarray, jelements, JNI_ABORT);
     return (jlong)arg;
 }
 
@@ -13087,14 +13055,16 @@ JNIEXPORT jlong JNICALL Java_org_alljoyn_bus_MsgArg_set__JLjava_lang_String_2_3J
     QCC_UNUSED(clazz);
     // QCC_DbgPrintf(("MsgArg_set__JLjava_lang_String_2_3J"));
 
-    jlong* jelements = env->GetLongArrayElements(jarray, NULL);
+    jsize numElements = env->GetArrayLength(jarray);
+    uint64_t* elements = new uint64_t[numElements];
+    env->GetLongArrayRegion(jarray, 0, numElements, reinterpret_cast<jlong*>(elements));
 
-    MsgArg* arg = Set(env, (MsgArg*)jmsgArg, jsignature, env->GetArrayLength(jarray), jelements);
+    MsgArg* arg = Set(env, (MsgArg*)jmsgArg, jsignature, (size_t)numElements, reinterpret_cast<jlong*>(elements));
     if (arg) {
-        arg->Stabilize();
+        arg->SetOwnershipFlags(MsgArg::OwnsData);
+    } else {
+        delete [] elements;
     }
-
-    env->ReleaseLongArrayElements(jarray, jelements, JNI_ABORT);
     return (jlong)arg;
 }
 
@@ -13103,14 +13073,16 @@ JNIEXPORT jlong JNICALL Java_org_alljoyn_bus_MsgArg_set__JLjava_lang_String_2_3D
     QCC_UNUSED(clazz);
     // QCC_DbgPrintf(("MsgArg_set__JLjava_lang_String_2_3D"));
 
-    jdouble* jelements = env->GetDoubleArrayElements(jarray, NULL);
+    jsize numElements = env->GetArrayLength(jarray);
+    uint64_t* elements = new uint64_t[numElements];
+    env->GetDoubleArrayRegion(jarray, 0, numElements, reinterpret_cast<jdouble*>(elements));
 
-    MsgArg* arg = Set(env, (MsgArg*)jmsgArg, jsignature, env->GetArrayLength(jarray), jelements);
+    MsgArg* arg = Set(env, (MsgArg*)jmsgArg, jsignature, (size_t)numElements, reinterpret_cast<jdouble*>(elements));
     if (arg) {
-        arg->Stabilize();
+        arg->SetOwnershipFlags(MsgArg::OwnsData);
+    } else {
+        delete [] elements;
     }
-
-    env->ReleaseDoubleArrayElements(jarray, jelements, JNI_ABORT);
     return (jlong)arg;
 }
 
@@ -32,13 +32,13 @@ package org.alljoyn.bus;
 import java.lang.reflect.Array;
 import java.lang.reflect.Field;
 import java.lang.reflect.GenericArrayType;
-import java.lang.reflect.InvocationTargetException;
 import java.lang.reflect.Method;
 import java.lang.reflect.ParameterizedType;
 import java.lang.reflect.Type;
 import java.util.AbstractMap;
 import java.util.HashMap;
 import java.util.Map;
+import java.util.concurrent.ConcurrentHashMap;
 
 /**
  * MsgArg provides methods for marshalling from Java types to native types and
@@ -85,6 +85,10 @@ public final class MsgArg {
     private static final int ALLJOYN_INT64_ARRAY      = ('x' << 8) | 'a';
     private static final int ALLJOYN_BYTE_ARRAY       = ('y' << 8) | 'a';
 
+    /** The constants of each enum type unmarshalled so far, indexed by ordinal value. */
+    private static final ConcurrentHashMap<Class<?>, Object[]> enumConstants =
+        new ConcurrentHashMap<Class<?>, Object[]>();
+
     private MsgArg() {}
 
     /**
@@ -102,17 +106,15 @@ public final class MsgArg {
         if (type instanceof Class) {
             Class<?> c = (Class<?>) type;
             if (c.isEnum()) {
+                Object[] values = enumConstants.get(c);
+                if (values == null) {
+                    values = c.getEnumConstants();
+                    enumConstants.putIfAbsent(c, values);
+                }
                 try {
-                    Object[] values = (Object[]) c.getMethod("values").invoke(null);
                     return (Enum<?>) values[value];
                 } catch (ArrayIndexOutOfBoundsException ex) {
                     throw new BusException("failed to get " + c + " for value " + value, ex);
-                } catch (NoSuchMethodException ex) {
-                    throw new BusException("failed to get " + c + " for value " + value, ex);
-                } catch (IllegalAccessException ex) {
-                    throw new BusException("failed to get " + c + " for value " + value, ex);
-                } catch (InvocationTargetException ex) {
-                    throw new BusException("failed to get " + c + " for value " + value, ex);
                 }
             }
         }
@@ -128,25 +130,8 @@ public final class MsgArg {
      *                      value cannot be determined
      */
     private static int getEnumValue(Object obj) throws BusException {
-        if (obj != null) {
-            Class<?> c = obj.getClass();
-            if (c.isEnum()) {
-                try {
-                    Object[] values = (Object[]) c.getMethod("values").invoke(null);
-                    for (int i = 0; i < values.length; ++i) {
-                        if (values[i].equals(obj)) {
-                            return i;
-                        }
-                    }
-                    throw new BusException("failed to get ordinal value for " + obj);
-                } catch (NoSuchMethodException ex) {
-                    throw new BusException("failed to get ordinal value for " + obj, ex);
-                } catch (IllegalAccessException ex) {
-                    throw new BusException("failed to get ordinal value for " + obj, ex);
-                } catch (InvocationTargetException ex) {
-                    throw new BusException("failed to get ordinal value for " + obj, ex);
-                }
-            }
+        if (obj != null && obj.getClass().isEnum()) {
+            return ((Enum<?>) obj).ordinal();
         }
         return -1;
     }
@@ -255,9 +240,10 @@ public final class MsgArg {
                     Type rawType = ((ParameterizedType) type).getRawType();
                     rawType = (rawType == Map.class) ? HashMap.class : rawType;
                     object = ((Class<?>) rawType).newInstance();
-                    for (int i = 0; i < getNumElements(msgArg); ++i) {
+                    Type[] typeArgs = ((ParameterizedType) type).getActualTypeArguments();
+                    int numElements = getNumElements(msgArg);
+                    for (int i = 0; i < numElements; ++i) {
                         long element  = getElement(msgArg, i);
-                        Type[] typeArgs = ((ParameterizedType) type).getActualTypeArguments();
                         // TODO Can't seem to get it to suppress the warning here...
                         ((Map<Object, Object>) object).put(unmarshal(getKey(element), typeArgs[0]),
                                                            unmarshal(getVal(element), typeArgs[1]));
@@ -275,8 +261,9 @@ public final class MsgArg {
                     } else {
                         componentClass = (Class<?>) componentType;
                     }
-                    object = Array.newInstance(componentClass, getNumElements(msgArg));
-                    for (int i = 0; i < getNumElements(msgArg); ++i) {
+                    int numElements = getNumElements(msgArg);
+                    object = Array.newInstance(componentClass, numElements);
+                    for (int i = 0; i < numElements; ++i) {
                         /*
                          * Under Sun the Array.set() is sufficient to check the
                          * type.  Under Android that is not the case.
@@ -352,29 +339,32 @@ public final class MsgArg {
                  */
                 if (type == Object.class || type == Object[].class) {
                     String signature = getSignature(new long[] {msgArg});
-                    String[] sigs = Signature.split(signature.substring(1,signature.length()-1));
-                    if (sigs.length != getNumMembers(msgArg)) {
+                    String[] sigs = Signature.splitCached(signature.substring(1,signature.length()-1));
+                    int numMembers = getNumMembers(msgArg);
+                    if (sigs.length != numMembers) {
                         throw new MarshalBusException(
                             "cannot marshal '" + signature + "' with "
-                            + getNumMembers(msgArg) + " members into " + type + " with "
+                            + numMembers + " members into " + type + " with "
                             + sigs.length + " fields");
                     }
                     Object[] array = (Object[]) Array.newInstance(Object.class, sigs.length);
-                    for (int i = 0; i < getNumMembers(msgArg); ++i) {
+                    for (int i = 0; i < numMembers; ++i) {
                         array[i] = unmarshal(getMember(msgArg, i), toType(sigs[i]));
                     }
                     return array; // returned structure represented as a generic Object[]
                 } else {
-                    Type[] types = Signature.structTypes((Class<?>) type);
-                    if (types.length != getNumMembers(msgArg)) {
+                    Signature.StructLayout layout = Signature.structLayout((Class<?>) type);
+                    Type[] types = layout.types;
+                    int numMembers = getNumMembers(msgArg);
+                    if (types.length != numMembers) {
                         throw new MarshalBusException(
                             "cannot marshal '" + getSignature(new long[] { msgArg }) + "' with "
-                            + getNumMembers(msgArg) + " members into " + type + " with "
+                            + numMembers + " members into " + type + " with "
                             + types.length + " fields");
                     }
                     object = ((Class<?>) type).newInstance();
-                    Field[] fields = Signature.structFields((Class<?>) type);
-                    for (int i = 0; i < getNumMembers(msgArg); ++i) {
+                    Field[] fields = layout.fields;
+                    for (int i = 0; i < numMembers; ++i) {
                         Object value = unmarshal(getMember(msgArg, i), types[i]);
                         fields[i].set(object, value);
                     }
@@ -554,7 +544,7 @@ public final class MsgArg {
                     String elemSig = sig.substring(1);
                     Object[] args = (Object[]) arg;
                     setArray(msgArg, elemSig, args.length);
-                    for (int i = 0; i < getNumElements(msgArg); ++i) {
+                    for (int i = 0; i < args.length; ++i) {
                         marshal(getElement(msgArg, i), elemSig, args[i]);
                     }
                     break;
@@ -562,13 +552,13 @@ public final class MsgArg {
                 break;
             case ALLJOYN_STRUCT_OPEN:
                 Object[] args = Signature.structArgs(arg);
-                String[] memberSigs = Signature.split(sig.substring(1, sig.length() - 1));
+                String[] memberSigs = Signature.splitCached(sig.substring(1, sig.length() - 1));
                 if (memberSigs == null) {
                     throw new MarshalBusException("cannot marshal " + arg.getClass() + " into '"
                                                   + sig + "'");
                 }
                 setStruct(msgArg, memberSigs.length);
-                for (int i = 0; i < getNumMembers(msgArg); ++i) {
+                for (int i = 0; i < memberSigs.length; ++i) {
                     marshal(getMember(msgArg, i), memberSigs[i], args[i]);
                 }
                 break;
@@ -583,7 +573,7 @@ public final class MsgArg {
                 break;
             case ALLJOYN_DICT_ENTRY_OPEN:
                 Map.Entry<?, ?> entry = (Map.Entry<?, ?>) arg;
-                String[] sigs = Signature.split(sig.substring(1, sig.length() - 1));
+                String[] sigs = Signature.splitCached(sig.substring(1, sig.length() - 1));
                 if (sigs == null) {
                     throw new MarshalBusException("cannot marshal " + arg.getClass() + " into '"
                                                   + sig + "'");
@@ -612,12 +602,13 @@ public final class MsgArg {
      * @throws MarshalBusException if the marshalling fails
      */
     public static void marshal(long msgArg, String sig, Object[] args) throws BusException {
-        String[] sigs = Signature.split(sig);
+        String[] sigs = Signature.splitCached(sig);
         if (sigs == null) {
             throw new MarshalBusException("cannot marshal args into '" + sig + "', bad signature");
         }
-        setStruct(msgArg, (args == null) ? 0 : args.length);
-        for (int i = 0; i < getNumMembers(msgArg); ++i) {
+        int numArgs = (args == null) ? 0 : args.length;
+        setStruct(msgArg, numArgs);
+        for (int i = 0; i < numArgs; ++i) {
             marshal(getMember(msgArg, i), sigs[i], args[i]);
         }
     }
@@ -40,6 +40,7 @@ import java.util.ArrayList;
 import java.util.Arrays;
 import java.util.List;
 import java.util.Map;
+import java.util.concurrent.ConcurrentHashMap;
 
 /**
  * Signature provides static methods for converting between Java and DBus type signatures.
@@ -49,10 +50,57 @@ public final class Signature {
 
     private Signature() {}
 
+    /**
+     * The public instance fields of a struct class and their generic types, both ordered by the
+     * {@code Position} annotation of the fields.
+     */
+    static final class StructLayout {
+        final Field[] fields;
+        final Type[] types;
+
+        private StructLayout(Field[] fields, Type[] types) {
+            this.fields = fields;
+            this.types = types;
+        }
+    }
+
+    /** Upper bound on the number of split signatures remembered by {@link #splitCached}. */
+    private static final int MAX_CACHED_SIGNATURES = 512;
+
+    /*
+     * Marshalling needs the same reflection results and signature splits for every message of a
+     * given type, so they are computed once and shared.  Both maps only ever grow; entries are
+     * immutable once published.
+     */
+    private static final ConcurrentHashMap<Class<?>, StructLayout> structLayouts =
+        new ConcurrentHashMap<Class<?>, StructLayout>();
+    private static final ConcurrentHashMap<String, String[]> splitSignatures =
+        new ConcurrentHashMap<String, String[]>();
+
+    static StructLayout structLayout(Class<?> cls) throws AnnotationBusException {
+        StructLayout layout = structLayouts.get(cls);
+        if (layout == null) {
+            Field[] fields = getInstanceFields(cls);
+            Field[] orderedFields = new Field[fields.length];
+            Type[] types = new Type[fields.length];
+            for (Field field : fields) {
+                Position position = field.getAnnotation(Position.class);
+                if (position == null) {
+                    throw new AnnotationBusException("field " + field + " of " + cls
+                                                     + " does not annotate position");
+                }
+                orderedFields[position.value()] = field;
+                types[position.value()] = field.getGenericType();
+            }
+            layout = new StructLayout(orderedFields, types);
+            structLayouts.putIfAbsent(cls, layout);
+        }
+        return layout;
+    }
+
     public static Object[] structArgs(Object struct) throws IllegalAccessException,
                                                             BusException {
         Class<?> type = struct.getClass();
-        Field[] fields = getInstanceFields(type);
 
         /*
          * If the given struct is an instance of Object[], there is no implementation class from
@@ -64,44 +112,20 @@ public final class Signature {
             return Arrays.copyOf(objArray, objArray.length);
         }
 
+        Field[] fields = structLayout(type).fields;
         Object[] args = new Object[fields.length];
-        for (Field field : fields) {
-            Position position = field.getAnnotation(Position.class);
-            if (position == null) {
-                throw new BusException("field " + field + " of " + type
-                                       + " does not annotate position");
-            }
-            args[position.value()] = field.get(struct);
+        for (int i = 0; i < fields.length; ++i) {
+            args[i] = fields[i].get(struct);
         }
         return args;
     }
 
     public static Field[] structFields(Class<?> cls) throws BusException {
-        Field[] fields = getInstanceFields(cls);
-        Field[] orderedFields = new Field[fields.length];
-        for (Field field : fields) {
-            Position position = field.getAnnotation(Position.class);
-            if (position == null) {
-                throw new BusException("field " + field + " of " + cls
-                                       + " does not annotate position");
-            }
-            orderedFields[position.value()] = field;
-        }
-        return orderedFields;
+        return structLayout(cls).fields.clone();
     }
 
     public static Type[] structTypes(Class<?> cls) throws AnnotationBusException {
-        Field[] fields = getInstanceFields(cls);
-        Type[] types = new Type[fields.length];
-        for (Field field : fields) {
-            Position position = field.getAnnotation(Position.class);
-            if (position == null) {
-                throw new AnnotationBusException("field " + field + " of " + cls
-                                                 + " does not annotate position");
-            }
-            types[position.value()] = field.getGenericType();
-        }
-        return types;
+        return structLayout(cls).types.clone();
     }
 
     public static String structSig(Class<?> cls) throws AnnotationBusException {
@@ -130,6 +154,25 @@ public final class Signature {
 
     public static native String[] split(String signature);
 
+    /**
+     * Same as {@link #split(String)}, but remembers the result so that marshalling the same
+     * signature again does not cross into native code.  The returned array is shared and must
+     * not be modified.
+     */
+    static String[] splitCached(String signature) {
+        if (signature == null) {
+            return null;
+        }
+        String[] sigs = splitSignatures.get(signature);
+        if (sigs == null) {
+            sigs = split(signature);
+            if (sigs != null && splitSignatures.size() < MAX_CACHED_SIGNATURES) {
+                splitSignatures.putIfAbsent(signature, sigs);
+            }
+        }
+        return sigs;
+    }
+
     /**
      * Compute the DBus type signature of the type.
      *
@@ -195,7 +238,7 @@ public final class Signature {
         } else if (cls.isEnum() && signature == null) {
             throw new AnnotationBusException("enum type " + cls + " is missing annotation");
         } else if (signature == null || "r".equals(signature)) {
-            String sig = typeSig(structTypes(cls), structSig(cls));
+            String sig = typeSig(structLayout(cls).types, structSig(cls));
             if (sig.length() == 0) {
                 throw new AnnotationBusException("cannot determine signature for " + cls);
             }
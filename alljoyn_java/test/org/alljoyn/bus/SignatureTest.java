@@ -30,6 +30,10 @@
 package org.alljoyn.bus;
 
 import org.alljoyn.bus.Signature;
+import org.alljoyn.bus.annotation.Position;
+
+import java.lang.reflect.Field;
+import java.util.Arrays;
 
 import junit.framework.TestCase;
 import static org.alljoyn.bus.Assert.*;
@@ -48,4 +52,27 @@ public class SignatureTest extends TestCase {
         assertArrayEquals(struct, Signature.structArgs(struct));
     }
 
+    public static class Point {
+        @Position(1) public int y;
+        @Position(0) public int x;
+    }
+
+    public void testStructArgs_repeated() throws Exception {
+        Point point = new Point();
+        point.x = 1;
+        point.y = 2;
+        for (int i = 0; i < 2; ++i) {
+            assertTrue(Arrays.equals(new Object[] {1, 2}, Signature.structArgs(point)));
+        }
+    }
+
+    public void testStructFields_returnsCopy() throws Exception {
+        Field[] fields = Signature.structFields(Point.class);
+        assertEquals("x", fields[0].getName());
+        assertEquals("y", fields[1].getName());
+        fields[0] = null;
+        assertEquals("x", Signature.structFields(Point.class)[0].getName());
+        assertEquals(int.class, Signature.structTypes(Point.class)[0]);
+    }
+
 }
@@ -39,6 +39,7 @@
 
 #include <qcc/platform.h>
 
+#include <qcc/atomic.h>
 #include <qcc/Crypto.h>
 #include "Crypto.h"
 #include <qcc/Util.h>
@@ -46,6 +47,7 @@
 #include <Status.h>
 
 #include <sys/types.h>
+#include <pthread.h>
 
 using namespace qcc;
 
@@ -73,8 +75,25 @@ class Crypto_DRBG::Context {
     }
 };
 
-// One instance per application
-static Crypto_DRBG* drbgctx = NULL;
+/*
+ * Each thread generates from its own DRBG so random bytes are produced without a lock.
+ * The DRBG is created and seeded on the thread's first request and destroyed when the
+ * thread exits.
+ */
+struct ThreadDRBG {
+    Crypto_DRBG drbg;
+    int32_t generation;     /* Value of drbgGeneration when the DRBG was seeded */
+};
+
+static pthread_key_t drbgKey;
+static pthread_once_t drbgKeyOnce = PTHREAD_ONCE_INIT;
+
+/*
+ * Set to a new value by every Crypto::Init() so that per-thread DRBGs seeded before a
+ * shutdown are reseeded, zero while the crypto library is shut down.
+ */
+static volatile int32_t drbgGeneration = 0;
+static volatile int32_t drbgInitCount = 0;
 
 static uint32_t PlatformEntropy(uint8_t* data, uint32_t size)
 {
@@ -183,15 +202,53 @@ void Crypto_DRBG::Update(uint8_t* data)
     ClearMemory(tmp, sizeof(tmp));
 }
 
-QStatus qcc::Crypto_GetRandomBytes(uint8_t* data, size_t len)
+static void DeleteThreadDRBG(void* arg)
+{
+    delete static_cast<ThreadDRBG*>(arg);
+}
+
+static void CreateDRBGKey()
 {
-    QStatus status = ER_CRYPTO_ERROR;
+    pthread_key_create(&drbgKey, DeleteThreadDRBG);
+}
 
-    if (NULL != data) {
-        status = drbgctx->Generate(data, len);
+static QStatus SeedThreadDRBG(ThreadDRBG* ctx, int32_t generation)
+{
+    uint8_t seed[Crypto_DRBG::SEEDLEN];
+    size_t size = PlatformEntropy(seed, sizeof (seed));
+    if (sizeof (seed) != size) {
+        QCC_DbgHLPrintf(("Low entropy: %" PRIuSIZET " (requested %" PRIuSIZET ")\n", size, sizeof (seed)));
+        return ER_CRYPTO_ERROR;
     }
+    ctx->drbg.Seed(seed, sizeof (seed));
+    ctx->generation = generation;
+    ClearMemory(seed, sizeof (seed));
+    return ER_OK;
+}
 
-    return status;
+QStatus qcc::Crypto_GetRandomBytes(uint8_t* data, size_t len)
+{
+    if (NULL == data) {
+        return ER_CRYPTO_ERROR;
+    }
+    int32_t generation = drbgGeneration;
+    if (0 == generation) {
+        /* Crypto::Init() has not been called */
+        return ER_CRYPTO_ERROR;
+    }
+    ThreadDRBG* ctx = static_cast<ThreadDRBG*>(pthread_getspecific(drbgKey));
+    if (NULL == ctx) {
+        ctx = new ThreadDRBG;
+        ctx->generation = 0;
+        pthread_setspecific(drbgKey, ctx);
+    }
+    if (ctx->generation != generation) {
+        QStatus status = SeedThreadDRBG(ctx, generation);
+        if (ER_OK != status) {
+            return status;
+        }
+    }
+    return ctx->drbg.Generate(data, len);
 }
 
 QStatus Crypto::Init()
@@ -199,23 +256,26 @@ QStatus Crypto::Init()
     uint8_t seed[Crypto_DRBG::SEEDLEN];
     size_t size;
 
-    if (NULL == drbgctx) {
-        drbgctx = new Crypto_DRBG;
-    }
-    /* Initial seeding, fail on error */
+    pthread_once(&drbgKeyOnce, CreateDRBGKey);
+    /* Check the platform entropy source now so a failure is reported here, fail on error */
     size = PlatformEntropy(seed, sizeof (seed));
-    if (sizeof (seed) == size) {
-        drbgctx->Seed(seed, sizeof (seed));
-    } else {
+    ClearMemory(seed, sizeof (seed));
+    if (sizeof (seed) != size) {
         QCC_DbgHLPrintf(("Low entropy: %" PRIuSIZET " (requested %" PRIuSIZET ")\n", size, sizeof (seed)));
         return ER_CRYPTO_ERROR;
     }
-
-    ClearMemory(seed, sizeof (seed));
+    int32_t generation = IncrementAndFetch(&drbgInitCount);
+    if (0 == generation) {
+        generation = IncrementAndFetch(&drbgInitCount);
+    }
+    drbgGeneration = generation;
     return ER_OK;
 }
 
 void Crypto::Shutdown() {
-    delete drbgctx;
-    drbgctx = NULL;
+    /*
+     * The per-thread DRBGs are owned by their threads, they are reseeded from the platform
+     * source on their next use after Crypto::Init() is called again.
+     */
+    drbgGeneration = 0;
 }
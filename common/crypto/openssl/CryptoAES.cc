@@ -54,6 +54,10 @@
 #include <Status.h>
 #include "OpenSsl.h"
 
+#ifdef QCC_LINUX_OPENSSL_GT_1_1_X
+#include <pthread.h>
+#endif
+
 using namespace std;
 using namespace qcc;
 
@@ -83,20 +87,11 @@ Crypto_AES::Crypto_AES(const KeyBlob& key, Mode mode) : mode(mode), keyState(new
     OpenSsl_ScopedLock lock;
 
     AES_set_encrypt_key((unsigned char*)key.GetData(), key.GetSize() * 8, &keyState->key);
-
-#ifdef QCC_LINUX_OPENSSL_GT_1_1_X
-    ERR_load_crypto_strings();
-    OpenSSL_add_all_algorithms();
-#endif
 }
 
 Crypto_AES::~Crypto_AES()
 {
     delete keyState;
-#ifdef QCC_LINUX_OPENSSL_GT_1_1_X
-    EVP_cleanup();
-    ERR_free_strings();
-#endif
 }
 
 QStatus Crypto_AES::Encrypt(const Block* in, Block* out, uint32_t numBlocks)
@@ -392,9 +387,42 @@ QStatus Crypto_AES::Decrypt_CCM(const void* in, void* out, size_t& len, const Ke
 #ifndef AES_CCM_IV_MIN_LEN
 #define AES_CCM_IV_MIN_LEN 7
 #endif
-//Get the openssl libcrypto errors and return QStatus
-static QStatus CCM_handleErrors(QStatus status)
+/*
+ * The EVP cipher context is cached per thread and reinitialized for every message, so a thread
+ * never shares its context and does not allocate a new one for each encryption or decryption.
+ */
+static pthread_key_t cipherCtxKey;
+static pthread_once_t cipherCtxKeyOnce = PTHREAD_ONCE_INIT;
+
+static void FreeCipherCtx(void* arg)
+{
+    EVP_CIPHER_CTX_free(static_cast<EVP_CIPHER_CTX*>(arg));
+}
+
+static void CreateCipherCtxKey()
+{
+    pthread_key_create(&cipherCtxKey, FreeCipherCtx);
+}
+
+static EVP_CIPHER_CTX* GetThreadCipherCtx()
+{
+    pthread_once(&cipherCtxKeyOnce, CreateCipherCtxKey);
+    EVP_CIPHER_CTX* ctx = static_cast<EVP_CIPHER_CTX*>(pthread_getspecific(cipherCtxKey));
+    if (nullptr == ctx) {
+        ctx = EVP_CIPHER_CTX_new();
+        if (nullptr != ctx) {
+            pthread_setspecific(cipherCtxKey, ctx);
+        }
+    }
+    return ctx;
+}
+
+//Get the openssl libcrypto errors, clear the context and return QStatus
+static QStatus CCM_handleErrors(EVP_CIPHER_CTX* ctx, QStatus status)
 {
+    if (nullptr != ctx) {
+        EVP_CIPHER_CTX_reset(ctx);
+    }
     char* buf = static_cast<char*>(calloc(128, sizeof(char)));
     if (nullptr == buf) {
         status = ER_OUT_OF_MEMORY;
@@ -411,7 +439,6 @@ static QStatus CCM_handleErrors(QStatus status)
 //Set the IV
 static QStatus SetIV(const KeyBlob& nonce, Crypto_AES::Block& iv, int& ivLen)
 {
-    OpenSsl_ScopedLock lock;
     size_t origLen = nonce.GetSize();
 
     //Just in case this function is called somewhere else without input check
@@ -474,63 +501,63 @@ QStatus Crypto_AES::Encrypt_CCM(const void* in, void* out, size_t& len, const Ke
     int encrypt_len;
     Block tag(0);
 
-    /* Create and initialize the context */
-    if (!(ctx = EVP_CIPHER_CTX_new())) {
-        return CCM_handleErrors(ER_CRYPTO_CTX_NEW_FAIL);
+    /* Get this thread's context, it is reinitialized below */
+    if (!(ctx = GetThreadCipherCtx())) {
+        return CCM_handleErrors(nullptr, ER_CRYPTO_CTX_NEW_FAIL);
     }
 
     /* Initialize the encryption operation. */
     if (1 != EVP_EncryptInit_ex(ctx, EVP_aes_128_ccm(), nullptr, nullptr, nullptr)) {
-        return CCM_handleErrors(ER_CRYPTO_CTX_INIT_FAIL);
+        return CCM_handleErrors(ctx, ER_CRYPTO_CTX_INIT_FAIL);
     }
 
     /* Set IV len, minimal & default is 7.*/
     if (1 != EVP_CIPHER_CTX_ctrl(ctx, EVP_CTRL_CCM_SET_IVLEN, ivLen, nullptr)) {
-        return CCM_handleErrors(ER_CRYPTO_CTX_CTRL_FAIL);
+        return CCM_handleErrors(ctx, ER_CRYPTO_CTX_CTRL_FAIL);
     }
 
     /* Set tag length, must use nullptr for the buffer here */
     if (1 != EVP_CIPHER_CTX_ctrl(ctx, EVP_CTRL_CCM_SET_TAG, authLen, nullptr)) {
-        return CCM_handleErrors(ER_CRYPTO_CTX_CTRL_FAIL);
+        return CCM_handleErrors(ctx, ER_CRYPTO_CTX_CTRL_FAIL);
     }
 
     /* Initialize key and IV */
     if (1 != EVP_EncryptInit_ex(ctx, nullptr, nullptr, reinterpret_cast<const uint8_t*>(&keyState->key), iv.data)) {
-        return CCM_handleErrors(ER_CRYPTO_CTX_INIT_FAIL);
+        return CCM_handleErrors(ctx, ER_CRYPTO_CTX_INIT_FAIL);
     }
 
     /* Provide the total plaintext length */
     if (1 != EVP_EncryptUpdate(ctx, nullptr, &encrypt_len, nullptr, plaintext_len)) {
-        return CCM_handleErrors(ER_CRYPTO_CTX_UPDATE_FAIL);
+        return CCM_handleErrors(ctx, ER_CRYPTO_CTX_UPDATE_FAIL);
     }
 
     /* Provide AAD data, if there is any */
     if ((aadLen > 0) && (nullptr != aadData)) {
         if (1 != EVP_EncryptUpdate(ctx, nullptr, &encrypt_len, static_cast<const uint8_t*>(aadData), aadLen)) {
-            return CCM_handleErrors(ER_CRYPTO_CTX_UPDATE_FAIL);
+            return CCM_handleErrors(ctx, ER_CRYPTO_CTX_UPDATE_FAIL);
         }
     }
 
     /* Provide the message to be encrypted, and obtain the encrypted output. */
     if (1 != EVP_EncryptUpdate(ctx, static_cast<uint8_t*>(out), &encrypt_len, static_cast<const uint8_t*>(in), plaintext_len)) {
-        return CCM_handleErrors(ER_CRYPTO_CTX_UPDATE_FAIL);
+        return CCM_handleErrors(ctx, ER_CRYPTO_CTX_UPDATE_FAIL);
     }
 
     ciphertext_len = encrypt_len;
 
     /* Finalize the encryption. */
     if (1 != EVP_EncryptFinal_ex(ctx, static_cast<uint8_t*>(out) + encrypt_len, &encrypt_len)) {
-        return CCM_handleErrors(ER_CRYPTO_CTX_FINAL_FAIL);
+        return CCM_handleErrors(ctx, ER_CRYPTO_CTX_FINAL_FAIL);
     }
     ciphertext_len += encrypt_len;
 
     /* Get the tag */
     if (1 != EVP_CIPHER_CTX_ctrl(ctx, EVP_CTRL_CCM_GET_TAG, authLen, tag.data)) {
-        return CCM_handleErrors(ER_CRYPTO_CTX_CTRL_FAIL);
+        return CCM_handleErrors(ctx, ER_CRYPTO_CTX_CTRL_FAIL);
     }
 
-    /* Clean up CTX */
-    EVP_CIPHER_CTX_free(ctx);
+    /* Clear the key schedule from the context */
+    EVP_CIPHER_CTX_reset(ctx);
 
     /* Append the tag data to the end of ciphertext(out), and increase the length of total message
      */
@@ -588,19 +615,19 @@ QStatus Crypto_AES::Decrypt_CCM(const void* in, void* out, size_t& len, const Ke
     Block tag(0);
     memcpy(tag.data, static_cast<const uint8_t*>(in) + ciphertext_len, authLen);
 
-    /* Create and initialize the context */
-    if (!(ctx = EVP_CIPHER_CTX_new())) {
-        return CCM_handleErrors(ER_CRYPTO_CTX_NEW_FAIL);
+    /* Get this thread's context, it is reinitialized below */
+    if (!(ctx = GetThreadCipherCtx())) {
+        return CCM_handleErrors(nullptr, ER_CRYPTO_CTX_NEW_FAIL);
     }
 
     /* Initialise the encryption operation. */
     if (1 != EVP_DecryptInit_ex(ctx, EVP_aes_128_ccm(), nullptr, nullptr, nullptr)) {
-        return CCM_handleErrors(ER_CRYPTO_CTX_INIT_FAIL);
+        return CCM_handleErrors(ctx, ER_CRYPTO_CTX_INIT_FAIL);
     }
 
     /* Set IV len, minimal & default is 7.*/
     if (1 != EVP_CIPHER_CTX_ctrl(ctx, EVP_CTRL_CCM_SET_IVLEN, ivLen, nullptr)) {
-        return CCM_handleErrors(ER_CRYPTO_CTX_CTRL_FAIL);
+        return CCM_handleErrors(ctx, ER_CRYPTO_CTX_CTRL_FAIL);
     }
 
     /* Set tag and length */
@@ -608,18 +635,18 @@ QStatus Crypto_AES::Decrypt_CCM(const void* in, void* out, size_t& len, const Ke
 
     /* Initialize key and IV */
     if (1 != EVP_DecryptInit_ex(ctx, nullptr, nullptr, reinterpret_cast<const uint8_t*>(&keyState->key), iv.data)) {
-        return CCM_handleErrors(ER_CRYPTO_CTX_INIT_FAIL);
+        return CCM_handleErrors(ctx, ER_CRYPTO_CTX_INIT_FAIL);
     }
 
     /* Provide the total plaintext length */
     if (1 != EVP_DecryptUpdate(ctx, nullptr, &decrypt_len, nullptr, ciphertext_len)) {
-        return CCM_handleErrors(ER_CRYPTO_CTX_UPDATE_FAIL);
+        return CCM_handleErrors(ctx, ER_CRYPTO_CTX_UPDATE_FAIL);
     }
 
     /* Provide AAD data if there is any */
     if ((aadLen > 0) && (nullptr != aadData)) {
         if (1 != EVP_DecryptUpdate(ctx, nullptr, &decrypt_len, static_cast<const uint8_t*>(aadData), aadLen)) {
-            return CCM_handleErrors(ER_CRYPTO_CTX_UPDATE_FAIL);
+            return CCM_handleErrors(ctx, ER_CRYPTO_CTX_UPDATE_FAIL);
         }
     }
 
@@ -628,7 +655,7 @@ QStatus Crypto_AES::Decrypt_CCM(const void* in, void* out, size_t& len, const Ke
      */
     if (1 != EVP_DecryptUpdate(ctx, static_cast<uint8_t*>(out), &decrypt_len, static_cast<const uint8_t*>(in), ciphertext_len)) {
         /* usually this fails due to auth data(Tag) mismatch between the input and computed */
-        return CCM_handleErrors(ER_AUTH_FAIL);
+        return CCM_handleErrors(ctx, ER_AUTH_FAIL);
     }
     len = decrypt_len;
 
@@ -636,8 +663,8 @@ QStatus Crypto_AES::Decrypt_CCM(const void* in, void* out, size_t& len, const Ke
      * for CCM mode, we should consider calling it for consistency once OpenSSL fixes it
      */
 
-    /* Clean up */
-    EVP_CIPHER_CTX_free(ctx);
+    /* Clear the key schedule from the context */
+    EVP_CIPHER_CTX_reset(ctx);
 
     return ER_OK;
 }
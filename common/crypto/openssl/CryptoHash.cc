@@ -239,21 +239,29 @@ QStatus Crypto_Hash::GetDigest(uint8_t* digest, bool keepAlive)
     return status;
 }
 #else
+/*
+ * The OpenSSL contexts are kept for the lifetime of the Crypto_Hash and reset when it is
+ * reinitialized, so hashing the same object repeatedly does not allocate new contexts.
+ */
 class Crypto_Hash::Context {
   public:
 
-    Context(bool MAC) : MAC(MAC) { }
+    Context() : hmac(nullptr), md(nullptr) { }
 
-    /// Union of context storage for HMAC or MD.
-    union {
-        HMAC_CTX* hmac;    ///< Storage for the HMAC context.
-        EVP_MD_CTX* md;    ///< Storage for the MD context.
-    };
+    ~Context()
+    {
+        if (nullptr != hmac) {
+            HMAC_CTX_free(hmac);
+        }
+        if (nullptr != md) {
+            EVP_MD_CTX_free(md);
+        }
+    }
 
-    bool MAC;
+    HMAC_CTX* hmac;    ///< The HMAC context, allocated on first use.
+    EVP_MD_CTX* md;    ///< The MD context, allocated on first use.
 
   private:
-    Context() { }
     Context(const Context&) = delete;
     Context& operator=(const Context&) = delete;
 
@@ -268,19 +276,13 @@ QStatus Crypto_Hash::Init(Algorithm alg, const uint8_t* hmacKey, size_t keyLen)
 
     QStatus status = ER_OK;
 
-    if (nullptr != ctx) {
-        delete ctx;
-        ctx = nullptr;
-        initialized = false;
-    }
+    initialized = false;
 
     MAC = (hmacKey != nullptr);
 
     if (MAC && (0 == keyLen)) {
         status = ER_CRYPTO_ERROR;
         QCC_LogError(status, ("HMAC key length cannot be zero"));
-        delete ctx;
-        ctx = nullptr;
         return status;
     }
 
@@ -305,23 +307,32 @@ QStatus Crypto_Hash::Init(Algorithm alg, const uint8_t* hmacKey, size_t keyLen)
         return status;
     }
 
-    ctx = new Crypto_Hash::Context(MAC);
+    if (nullptr == ctx) {
+        ctx = new Crypto_Hash::Context();
+    }
     if (MAC) {
-        ctx->hmac = HMAC_CTX_new();
-        HMAC_Init_ex(ctx->hmac, hmacKey, keyLen, mdAlgorithm, nullptr);
+        if (nullptr == ctx->hmac) {
+            ctx->hmac = HMAC_CTX_new();
+        } else {
+            HMAC_CTX_reset(ctx->hmac);
+        }
+        if ((nullptr == ctx->hmac) || (HMAC_Init_ex(ctx->hmac, hmacKey, keyLen, mdAlgorithm, nullptr) == 0)) {
+            status = ER_CRYPTO_ERROR;
+            QCC_LogError(status, ("Failed to initialize HMAC"));
+        }
     } else {
-        ctx->md = EVP_MD_CTX_create();
-        if (EVP_DigestInit_ex(ctx->md, mdAlgorithm, nullptr) == 0) {
+        if (nullptr == ctx->md) {
+            ctx->md = EVP_MD_CTX_new();
+        } else {
+            EVP_MD_CTX_reset(ctx->md);
+        }
+        if ((nullptr == ctx->md) || (EVP_DigestInit_ex(ctx->md, mdAlgorithm, nullptr) == 0)) {
             status = ER_CRYPTO_ERROR;
-            EVP_MD_CTX_free(ctx->md);
             QCC_LogError(status, ("Failed to initialize hash digest"));
         }
     }
     if (ER_OK == status) {
         initialized = true;
-    } else {
-        delete ctx;
-        ctx = nullptr;
     }
     return status;
 }
@@ -333,17 +344,7 @@ Crypto_Hash::~Crypto_Hash(void)
      */
     OpenSsl_ScopedLock lock;
 
-    if (nullptr != ctx) {
-        if (initialized) {
-            if (MAC) {
-                HMAC_CTX_free(ctx->hmac);
-
-            } else {
-                EVP_MD_CTX_free(ctx->md);
-            }
-        }
-        delete ctx;
-    }
+    delete ctx;
 }
 
 QStatus Crypto_Hash::Update(const uint8_t* buf, size_t bufSize)
@@ -403,27 +404,21 @@ QStatus Crypto_Hash::GetDigest(uint8_t* digest, bool keepAlive)
                 keepAlive = false;
             }
             HMAC_Final(ctx->hmac, digest, nullptr);
-            HMAC_CTX_free(ctx->hmac);
             initialized = false;
-        } else {
-            Context* keep = nullptr;
-            /* To keep the hash alive we need to copy the context before calling EVP_DigestFinal */
-            if (keepAlive) {
-                keep = new Context(false);
-                keep->md = EVP_MD_CTX_create();
-                EVP_MD_CTX_copy(keep->md, ctx->md);
-            }
-            if (EVP_DigestFinal(ctx->md, digest, nullptr) == 0) {
+        } else if (keepAlive) {
+            /* To keep the hash alive the digest is finalized on a copy of the context */
+            EVP_MD_CTX* copy = EVP_MD_CTX_new();
+            if ((nullptr == copy) || (EVP_MD_CTX_copy_ex(copy, ctx->md) == 0) || (EVP_DigestFinal_ex(copy, digest, nullptr) == 0)) {
                 status = ER_CRYPTO_ERROR;
                 QCC_LogError(status, ("Failed to finalize hash digest"));
             }
-            EVP_MD_CTX_free(ctx->md);
-            if (nullptr != keep) {
-                delete ctx;
-                ctx = keep;
-            } else {
-                initialized = false;
+            EVP_MD_CTX_free(copy);
+        } else {
+            if (EVP_DigestFinal_ex(ctx->md, digest, nullptr) == 0) {
+                status = ER_CRYPTO_ERROR;
+                QCC_LogError(status, ("Failed to finalize hash digest"));
             }
+            initialized = false;
         }
     } else {
         status = ER_CRYPTO_HASH_UNINITIALIZED;
@@ -37,6 +37,9 @@
 
 #include <qcc/Crypto.h>
 
+#include <limits.h>
+#include <openssl/rand.h>
+
 #include <Status.h>
 #include "OpenSsl.h"
 
@@ -44,23 +47,25 @@
 
 QStatus qcc::Crypto_GetRandomBytes(uint8_t* data, size_t len)
 {
+    if (NULL == data) {
+        return ER_CRYPTO_ERROR;
+    }
     /*
      * Protect the open ssl APIs.
      */
     OpenSsl_ScopedLock lock;
 
-    QStatus status = ER_OK;
-    BIGNUM* rand = BN_new();
-    if (!rand) {
-        status = ER_OUT_OF_MEMORY;
-        QCC_LogError(status, ("Failed to allocate memory for EVP PKEY"));
-        return status;
-    }
-    if (BN_rand(rand, len * 8, -1, 0)) {
-        BN_bn2bin(rand, data);
-    } else {
-        status = ER_CRYPTO_ERROR;
+    /*
+     * RAND_bytes fills the buffer directly from OpenSSL's generator, which keeps its own
+     * per-thread state in OpenSSL 1.1.1 and later.
+     */
+    while (len > 0) {
+        int chunk = (len > INT_MAX) ? INT_MAX : static_cast<int>(len);
+        if (RAND_bytes(data, chunk) != 1) {
+            return ER_CRYPTO_ERROR;
+        }
+        data += chunk;
+        len -= chunk;
     }
-    BN_free(rand);
-    return status;
+    return ER_OK;
 }
@@ -44,7 +44,57 @@
 
 using namespace qcc;
 
-#if defined(OPENSSL_THREADS) && !defined(QCC_LINUX_OPENSSL_GT_1_1_X)
+#if !defined(OPENSSL_THREADS)
+
+static Mutex* s_mutex = NULL;
+static volatile int32_t s_refCount = 0;
+
+OpenSsl_ScopedLock::OpenSsl_ScopedLock()
+{
+    if (IncrementAndFetch(&s_refCount) == 1) {
+        s_mutex = new Mutex();
+    } else {
+        DecrementAndFetch(&s_refCount);
+        while (!s_mutex) {
+            qcc::Sleep(1);
+        }
+    }
+    s_mutex->Lock();
+}
+
+OpenSsl_ScopedLock::~OpenSsl_ScopedLock()
+{
+    QCC_ASSERT(s_mutex);
+    s_mutex->Unlock();
+}
+
+QStatus Crypto::Init() {
+    return ER_OK;
+}
+
+void Crypto::Shutdown() {
+}
+
+#elif defined(QCC_LINUX_OPENSSL_GT_1_1_X)
+
+/*
+ * OpenSSL 1.1.0 and later do their own locking, and the wrappers never share an OpenSSL
+ * context between threads, so no lock is needed around the calls.
+ */
+OpenSsl_ScopedLock::OpenSsl_ScopedLock() {
+}
+
+OpenSsl_ScopedLock::~OpenSsl_ScopedLock() {
+}
+
+QStatus Crypto::Init() {
+    return ER_OK;
+}
+
+void Crypto::Shutdown() {
+}
+
+#else /* OPENSSL_THREADS && !QCC_LINUX_OPENSSL_GT_1_1_X */
 
 OpenSsl_ScopedLock::OpenSsl_ScopedLock() {
 }
@@ -88,35 +138,4 @@ void Crypto::Shutdown()
     s_locks = NULL;
 }
 
-#else /* !OPENSSL_THREADS  || QCC_LINUX_OPENSSL_GT_1_1_X */
-
-static Mutex* s_mutex = NULL;
-static volatile int32_t s_refCount = 0;
-
-OpenSsl_ScopedLock::OpenSsl_ScopedLock()
-{
-    if (IncrementAndFetch(&s_refCount) == 1) {
-        s_mutex = new Mutex();
-    } else {
-        DecrementAndFetch(&s_refCount);
-        while (!s_mutex) {
-            qcc::Sleep(1);
-        }
-    }
-    s_mutex->Lock();
-}
-
-OpenSsl_ScopedLock::~OpenSsl_ScopedLock()
-{
-    QCC_ASSERT(s_mutex);
-    s_mutex->Unlock();
-}
-
-QStatus Crypto::Init() {
-    return ER_OK;
-}
-
-void Crypto::Shutdown() {
-}
-
 #endif
@@ -55,7 +55,7 @@ namespace qcc {
  * any OpenSSL crypto library APIs.
  *
  * This is a no-op when OpenSSL is compiled with multi-threaded
- * support.
+ * support and always with OpenSSL 1.1.0 or later.
  */
 class OpenSsl_ScopedLock {
   public:
@@ -50,8 +50,22 @@ namespace qcc {
 class BigNum {
   public:
 
+#if defined(__SIZEOF_INT128__)
+    // Digit type with a double-width type for intermediate products. Where the compiler provides
+    // a 128 bit integer type the digits are 64 bits wide, halving the number of inner loop
+    // iterations and quartering the number of partial products.
+    typedef uint64_t digit_t;
+    __extension__ typedef unsigned __int128 ddigit_t;
+#else
+    typedef uint32_t digit_t;
+    typedef uint64_t ddigit_t;
+#endif
+
+    // Number of bits in a digit
+    static const size_t digit_bits = 8 * sizeof(digit_t);
+
     // Default constructor - initializes the BigNum to zero
-    BigNum() : digits((uint32_t*) &zero_digit), length(1), neg(false), storage(NULL) { }
+    BigNum() : digits((digit_t*) &zero_digit), length(1), neg(false), storage(NULL) { }
 
     // Constructor that initializes a BigNum from a small integer value.
     BigNum(uint32_t v);
@@ -231,8 +245,8 @@ class BigNum {
 
     // Test if a specific bit is set.
     bool test_bit(size_t index) const {
-        size_t d = index >> 5;
-        return (d < length) && (digits[d] & (1 << (index & 0x1F)));
+        size_t d = index / digit_bits;
+        return (d < length) && ((digits[d] >> (index % digit_bits)) & 1);
     }
 
     // Destructor
@@ -240,14 +254,7 @@ class BigNum {
 
   private:
 
-    // Montgomery multiplication
-    // @param r    Returns the Montgomery product
-    // @param n    The multiplicand
-    // @param m    The modulus
-    // @param rho  The inverse modulus
-    BigNum& monty_mul(BigNum& r, const BigNum& n, const BigNum& m, uint32_t rho) const;
-
-    // Mongtomery modular exponentiation
+    // Mongtomery modular exponentiation using a sliding window over the exponent
     BigNum monty_mod_exp(const BigNum& n, const BigNum& mod) const;
 
     // Count the trailing zeroes
@@ -285,7 +292,7 @@ class BigNum {
     static BigNum& AJ_CALL right_shift(BigNum& result, const BigNum& n, uint32_t shift);
 
     // Multiplication by an integer putting result into an existing BigNum
-    static BigNum& AJ_CALL mul(BigNum& result, const BigNum& a, uint32_t b, bool neg);
+    static BigNum& AJ_CALL mul(BigNum& result, const BigNum& a, digit_t b, bool neg);
 
     // Multiplication putting result into an existing BigNum
     static BigNum& AJ_CALL mul(BigNum& result, const BigNum& a, const BigNum& b);
@@ -294,13 +301,13 @@ class BigNum {
     BigNum div(const BigNum& y, BigNum& rem) const;
 
     // Returns reference to the most significant digit
-    uint32_t& msdigit() const { return digits[length - 1]; }
+    digit_t& msdigit() const { return digits[length - 1]; }
 
     // Check if value has unsuppressed leading zeroes
     bool haslz() const { return length > 1 && digits[length - 1] == 0; }
 
     // Convenience function for temporary values that don't own storage
-    BigNum& Set(uint32_t* newDigits, size_t digitsLength, bool negative = false) {
+    BigNum& Set(digit_t* newDigits, size_t digitsLength, bool negative = false) {
         this->digits = newDigits;
         this->length = digitsLength;
         this->neg = negative;
@@ -312,7 +319,7 @@ class BigNum {
     BigNum& sub(const BigNum& n, size_t shift = 0);
 
     // Pointer to the digits array
-    uint32_t* digits;
+    digit_t* digits;
 
     // Length of the digits array
     size_t length;
@@ -327,7 +334,7 @@ class BigNum {
     Storage* storage;
 
     // Shared zero value
-    static uint32_t zero_digit;
+    static digit_t zero_digit;
 };
 
 }
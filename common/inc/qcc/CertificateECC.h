@@ -37,6 +37,7 @@
 
 #include <qcc/platform.h>
 #include <qcc/GUID.h>
+#include <qcc/Crypto.h>
 #include <qcc/CryptoECC.h>
 #include <qcc/KeyInfoECC.h>
 
@@ -829,15 +830,15 @@ class CertificateX509 {
 
     QStatus DecodeCertificateTBS();
     QStatus EncodeCertificateTBS();
-    QStatus DecodeCertificateName(const qcc::String& dn, CertificateX509::DistinguishedName& name);
+    QStatus DecodeCertificateName(const qcc::Crypto_ASN1::View& dn, CertificateX509::DistinguishedName& name);
     QStatus EncodeCertificateName(qcc::String& dn, const CertificateX509::DistinguishedName& name) const;
-    QStatus DecodeCertificateTime(const qcc::String& time);
+    QStatus DecodeCertificateTime(const qcc::Crypto_ASN1::View& time);
     QStatus EncodeCertificateTime(qcc::String& time) const;
-    QStatus DecodeCertificatePub(const qcc::String& pub);
+    QStatus DecodeCertificatePub(const qcc::Crypto_ASN1::View& pub);
     QStatus EncodeCertificatePub(qcc::String& pub) const;
-    QStatus DecodeCertificateExt(const qcc::String& ext);
+    QStatus DecodeCertificateExt(const qcc::Crypto_ASN1::View& ext);
     QStatus EncodeCertificateExt(qcc::String& ext) const;
-    QStatus DecodeCertificateSig(const qcc::String& sig);
+    QStatus DecodeCertificateSig(const qcc::Crypto_ASN1::View& sig);
     QStatus EncodeCertificateSig(qcc::String& sig) const;
 
     CertificateType type;
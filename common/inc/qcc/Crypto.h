@@ -776,6 +776,214 @@ class Crypto_ASN1 {
      */
     static qcc::String AJ_CALL ToString(const uint8_t* asn, size_t len, size_t indent = 0);
 
+    /**
+     * A range of bytes within a DER formatted ASN1 data blob. A view does not own or copy the
+     * bytes it refers to so it is only valid for as long as the data blob being decoded.
+     */
+    struct View {
+        const uint8_t* data;  ///< Start of the range
+        size_t len;           ///< Length of the range
+
+        View() : data(NULL), len(0) { }
+
+        View(const uint8_t* data, size_t len) : data(data), len(len) { }
+
+        /**
+         * @return true if the view is empty.
+         */
+        bool empty() const { return len == 0; }
+
+        /**
+         * @return A copy of the bytes in the view.
+         */
+        qcc::String ToString() const { return qcc::String((const char*)data, len); }
+    };
+
+    /**
+     * Single pass reader for DER formatted ASN1 data. Each Read call consumes the next element and
+     * returns views into the original data rather than copies. The contents of constructed elements
+     * (sequences, sets and tagged types) are read with a nested reader. The rules applied to each
+     * element are the same as those applied by the corresponding Decode syntax character. A read
+     * that fails does not consume anything so an optional element can be probed for.
+     */
+    class Reader {
+      public:
+
+        /**
+         * Construct a reader with no data.
+         */
+        Reader() : asn(NULL), eod(NULL), nested(false) { }
+
+        /**
+         * Construct a reader over a DER formatted data blob.
+         *
+         * @param asn     The data to read
+         * @param asnLen  The length of the data
+         */
+        Reader(const uint8_t* asn, size_t asnLen) : asn(asn), eod(asn + asnLen), nested(false) { }
+
+        /**
+         * Construct a reader over the contents of a view.
+         *
+         * @param view  The data to read
+         */
+        Reader(const View& view) : asn(view.data), eod(view.data + view.len), nested(false) { }
+
+        /**
+         * @return true if all of the elements have been read.
+         */
+        bool AtEnd() const { return asn >= eod; }
+
+        /**
+         * Check that all of the elements have been read.
+         *
+         * @return ER_OK if there are no elements left. Otherwise the same status Decode returns for
+         *         unexpected elements: ER_FAIL within a constructed element, ER_BAD_ARG_1 at the top level.
+         */
+        QStatus ExpectEnd() const;
+
+        /**
+         * @return A view of the elements not read yet, the same as the '.' syntax character.
+         */
+        View Remaining() const { return View(asn, eod - asn); }
+
+        /**
+         * Read a sequence ('(...)'). The contents must not be empty.
+         *
+         * @param contents  Returns a reader over the contents of the sequence.
+         * @param raw       If not NULL returns a view of the entire encoded sequence.
+         *
+         * @return ER_OK if the next element is a sequence, ER_FAIL otherwise.
+         */
+        QStatus ReadSequence(Reader& contents, View* raw = NULL);
+
+        /**
+         * Read a set-of ('{...}'). The contents must not be empty.
+         *
+         * @param contents  Returns a reader over the contents of the set.
+         *
+         * @return ER_OK if the next element is a set, ER_FAIL otherwise.
+         */
+        QStatus ReadSet(Reader& contents);
+
+        /**
+         * Read an explicitly tagged context specific type ('c(...)'). The contents must not be empty.
+         *
+         * @param tagNum    The context specific tag number, must be less than 32.
+         * @param contents  Returns a reader over the contents of the tagged type.
+         *
+         * @return ER_OK if the next element is a constructed type with the expected tag, ER_FAIL otherwise.
+         */
+        QStatus ReadContext(uint32_t tagNum, Reader& contents);
+
+        /**
+         * Read the value of a context specific type ('c(.)'). The type can be either primitive or
+         * constructed, in the latter case the value contains the encoded elements.
+         *
+         * @param tagNum  The context specific tag number, must be less than 32.
+         * @param value   Returns a view of the value.
+         *
+         * @return ER_OK if the next element has the expected tag, ER_FAIL otherwise.
+         */
+        QStatus ReadContextValue(uint32_t tagNum, View& value);
+
+        /**
+         * Read an integer of 4 bytes or less ('i').
+         *
+         * @param v  Returns the integer value.
+         *
+         * @return ER_OK if the next element is a small integer, ER_FAIL otherwise.
+         */
+        QStatus ReadInteger(uint32_t& v);
+
+        /**
+         * Read an arbitrary length integer ('l'). A leading zero byte is suppressed.
+         *
+         * @param v  Returns a view of the big-endian integer bytes.
+         *
+         * @return ER_OK if the next element is an integer, ER_FAIL otherwise.
+         */
+        QStatus ReadInteger(View& v);
+
+        /**
+         * Read an object id ('o').
+         *
+         * @param oid  Returns the object id in dotted notation.
+         *
+         * @return ER_OK if the next element is an object id, ER_FAIL otherwise.
+         */
+        QStatus ReadOID(qcc::String& oid);
+
+        /**
+         * Read an octet string ('x').
+         *
+         * @param v  Returns a view of the octets.
+         *
+         * @return ER_OK if the next element is an octet string, ER_FAIL otherwise.
+         */
+        QStatus ReadOctets(View& v);
+
+        /**
+         * Read a bit string ('b').
+         *
+         * @param v       Returns a view of the bits excluding the unused bits count.
+         * @param bitLen  Returns the length of the bit string in bits.
+         *
+         * @return ER_OK if the next element is a bit string, ER_FAIL otherwise.
+         */
+        QStatus ReadBits(View& v, size_t& bitLen);
+
+        /**
+         * Read a boolean ('z').
+         *
+         * @param v  Returns 0 for false, other values are true.
+         *
+         * @return ER_OK if the next element is a boolean, ER_FAIL otherwise.
+         */
+        QStatus ReadBoolean(uint32_t& v);
+
+        /**
+         * Read a utf8 string ('u').
+         *
+         * @param v  Returns a view of the string.
+         *
+         * @return ER_OK if the next element is a utf8 string, ER_FAIL otherwise.
+         */
+        QStatus ReadUTF8(View& v);
+
+        /**
+         * Read a UTC time or a generalized time ('t' or 'T').
+         *
+         * @param v  Returns a view of the time string.
+         *
+         * @return ER_OK if the next element is a time, ER_FAIL otherwise.
+         */
+        QStatus ReadTime(View& v);
+
+        /**
+         * Skip over the next element ('*').
+         *
+         * @return ER_OK if there was an element to skip, ER_FAIL otherwise.
+         */
+        QStatus Skip();
+
+      private:
+
+        /*
+         * Locate the next element which must have the specified tag without consuming it.
+         */
+        QStatus PeekElement(uint8_t tag, View& value, const uint8_t*& next) const;
+
+        /*
+         * Read the next element which must have the specified tag.
+         */
+        QStatus ReadPrimitive(uint8_t tag, View& value);
+
+        const uint8_t* asn;
+        const uint8_t* eod;
+        bool nested;
+    };
+
   private:
 
     static const uint8_t ASN_BOOLEAN   = 0x01;
@@ -139,6 +139,82 @@ SocketFd NetworkEventSocket();
  */
 NetworkEventType NetworkEventReceive(SocketFd sockFd, NetworkEventSet& networkEvents);
 
+#if defined(QCC_OS_LINUX) || defined(QCC_OS_ANDROID)
+/**
+ * @brief A table of the network interfaces on the host that is kept up to
+ * date from link and address notifications.
+ *
+ * The table holds the same entries that IfConfig() returns.  It is loaded once
+ * when opened and from then on each notification only changes the entries of
+ * the interface it describes, so that a client can find out exactly which
+ * interface/address combinations came and went without enumerating every
+ * interface on the host again.  If notifications are lost the table reloads
+ * itself.
+ */
+class IfConfigTable {
+  public:
+    /**
+     * Construct an empty table that is not yet tracking the host.
+     */
+    IfConfigTable();
+
+    /**
+     * Destructor.
+     */
+    ~IfConfigTable();
+
+    /**
+     * Subscribe to link and address notifications and load the table.
+     *
+     * @return ER_OK if the table is now tracking the host.
+     */
+    QStatus Open();
+
+    /**
+     * Stop tracking the host and empty the table.
+     */
+    void Close();
+
+    /**
+     * @return true if the table is tracking the host.
+     */
+    bool IsOpen() const;
+
+    /**
+     * @return The socket that becomes readable when notifications are pending
+     *         or INVALID_SOCKET_FD if the table is not open.
+     */
+    SocketFd GetSocketFd() const;
+
+    /**
+     * Apply the pending notifications to the table.  An entry whose flags or
+     * MTU changed is reported both as removed and as added.
+     *
+     * @param networkEvents The interfaces that gained an address are added to this set.
+     * @param added         Entries that are new in the table are appended here.
+     * @param removed       Entries that are no longer in the table are appended here.
+     *
+     * @return QCC_RTM_NEWADDR if an entry was added, QCC_RTM_DELADDR if entries
+     *         were only removed and QCC_RTM_IGNORED if the table did not change.
+     */
+    NetworkEventType Update(NetworkEventSet& networkEvents, std::vector<IfConfigEntry>& added, std::vector<IfConfigEntry>& removed);
+
+    /**
+     * Get the current contents of the table.
+     *
+     * @param entries Filled out with the same entries IfConfig() would return.
+     */
+    void GetEntries(std::vector<IfConfigEntry>& entries) const;
+
+  private:
+    IfConfigTable(const IfConfigTable& other);
+    IfConfigTable& operator=(const IfConfigTable& other);
+
+    SocketFd m_sockFd;                      /**< Socket subscribed to link and address notifications */
+    std::vector<IfConfigEntry> m_entries;   /**< The interface/address combinations on the host */
+};
+#endif
+
 } // namespace ajn
 
 #endif // _IFCONFIG_H
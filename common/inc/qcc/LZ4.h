@@ -0,0 +1,90 @@
+/**
+ * @file
+ *
+ * LZ4 block format compression used for message bodies on bus-to-bus links.
+ */
+
+/******************************************************************************
+ *    Copyright (c) Open Connectivity Foundation (OCF), AllJoyn Open Source
+ *    Project (AJOSP) Contributors and others.
+ *
+ *    SPDX-License-Identifier: Apache-2.0
+ *
+ *    All rights reserved. This program and the accompanying materials are
+ *    made available under the terms of the Apache License, Version 2.0
+ *    which accompanies this distribution, and is available at
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Copyright (c) Open Connectivity Foundation and Contributors to AllSeen
+ *    Alliance. All rights reserved.
+ *
+ *    Permission to use, copy, modify, and/or distribute this software for
+ *    any purpose with or without fee is hereby granted, provided that the
+ *    above copyright notice and this permission notice appear in all
+ *    copies.
+ *
+ *    THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+ *    WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+ *    WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ *    AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ *    DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ *    PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+ *    TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ *    PERFORMANCE OF THIS SOFTWARE.
+ ******************************************************************************/
+
+#ifndef _QCC_LZ4_H
+#define _QCC_LZ4_H
+
+#ifndef __cplusplus
+#error Only include LZ4.h in C++ code.
+#endif
+
+#include <qcc/platform.h>
+
+#include <Status.h>
+
+namespace qcc {
+
+/**
+ * Get the size of the output buffer needed to compress any input of a given length.
+ *
+ * @param len  Length of the data to compress.
+ *
+ * @return  The worst case length of the compressed data.
+ */
+size_t LZ4CompressBound(size_t len);
+
+/**
+ * Compress a buffer into a single LZ4 block. The block carries no framing so the length of the
+ * uncompressed data must be sent along with it.
+ *
+ * @param src     The data to compress.
+ * @param srcLen  Length of the data to compress.
+ * @param dst     Buffer to receive the compressed block.
+ * @param dstLen  Size of dst, must be at least LZ4CompressBound(srcLen).
+ *
+ * @return  The length of the compressed block or 0 if dst is too small.
+ */
+size_t LZ4Compress(const uint8_t* src, size_t srcLen, uint8_t* dst, size_t dstLen);
+
+/**
+ * Decompress a single LZ4 block. The block is untrusted input, every length and offset is checked
+ * against the input and output buffers.
+ *
+ * @param src     The compressed block.
+ * @param srcLen  Length of the compressed block.
+ * @param dst     Buffer to receive the decompressed data.
+ * @param dstLen  Size of dst.
+ * @param outLen  Returns the length of the decompressed data.
+ *
+ * @return
+ *      - ER_OK if the block was decompressed.
+ *      - ER_BUFFER_TOO_SMALL if the decompressed data does not fit in dst.
+ *      - ER_INVALID_DATA if the block is malformed.
+ */
+QStatus LZ4Decompress(const uint8_t* src, size_t srcLen, uint8_t* dst, size_t dstLen, size_t& outLen);
+
+}
+
+#endif
@@ -190,6 +190,9 @@ typedef enum {
     /* AboutObjectDescription.cc */
     LOCK_LEVEL_ABOUTOBJECTDESCRIPTION_INTERNAL_ANNOUNCEOBJECTSMAPLOCK = 30000,
 
+    /* AboutDataCache.cc */
+    LOCK_LEVEL_ABOUTDATACACHE_LOCK = 30100,
+
     /* PermissionMgmtObj.cc */
     LOCK_LEVEL_PERMISSIONMGMTOBJ_LOCK = 31000,
 
@@ -209,6 +212,9 @@ typedef enum {
     /* Timer.cc */
     LOCK_LEVEL_TIMERIMPL_LOCK = 36000,
 
+    /* ECDHEKeyPool.cc */
+    LOCK_LEVEL_ECDHEKEYPOOL_LOCK = 36500,
+
     /* OpenSsl.cc */
     LOCK_LEVEL_OPENSSL_LOCK = 37000,
 
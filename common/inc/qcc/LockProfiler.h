@@ -0,0 +1,173 @@
+/**
+ * @file
+ *
+ * Opt-in lock contention profiler for Mutex objects.
+ */
+
+/******************************************************************************
+ *    Copyright (c) Open Connectivity Foundation (OCF), AllJoyn Open Source
+ *    Project (AJOSP) Contributors and others.
+ *
+ *    SPDX-License-Identifier: Apache-2.0
+ *
+ *    All rights reserved. This program and the accompanying materials are
+ *    made available under the terms of the Apache License, Version 2.0
+ *    which accompanies this distribution, and is available at
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Copyright (c) Open Connectivity Foundation and Contributors to AllSeen
+ *    Alliance. All rights reserved.
+ *
+ *    Permission to use, copy, modify, and/or distribute this software for
+ *    any purpose with or without fee is hereby granted, provided that the
+ *    above copyright notice and this permission notice appear in all
+ *    copies.
+ *
+ *    THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+ *    WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+ *    WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ *    AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ *    DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ *    PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+ *    TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ *    PERFORMANCE OF THIS SOFTWARE.
+ ******************************************************************************/
+
+#ifndef _QCC_LOCKPROFILER_H
+#define _QCC_LOCKPROFILER_H
+
+#include <qcc/platform.h>
+#include <qcc/String.h>
+
+#include <vector>
+
+namespace qcc {
+
+class MutexInternal;
+
+/**
+ * Wait and hold time statistics for the Mutex acquisitions made at one source code location.
+ */
+struct LockSiteStats {
+    /** Number of histogram buckets, bucket i counts durations in [2^i, 2^(i+1)) nanoseconds */
+    static const size_t HISTOGRAM_BUCKETS = 32;
+
+    const char* file;                             /**< File passed to Lock() through MUTEX_CONTEXT, NULL if unknown */
+    uint32_t line;                                /**< Line passed to Lock() through MUTEX_CONTEXT */
+    uint64_t acquisitions;                        /**< Number of sampled acquisitions */
+    uint64_t contended;                           /**< Sampled acquisitions that had to wait for another thread */
+    uint64_t waitNs;                              /**< Total time spent waiting to acquire */
+    uint64_t maxWaitNs;                           /**< Longest wait */
+    uint64_t holdNs;                              /**< Total time the lock was held */
+    uint64_t maxHoldNs;                           /**< Longest hold */
+    uint32_t waitHistogram[HISTOGRAM_BUCKETS];    /**< log2 histogram of contended wait times */
+    uint32_t holdHistogram[HISTOGRAM_BUCKETS];    /**< log2 histogram of hold times */
+
+    /**
+     * Estimate a wait time percentile from the histogram.
+     *
+     * @param percentile  Percentile between 0 and 100.
+     *
+     * @return  Upper bound of the histogram bucket holding the percentile, in nanoseconds.
+     */
+    uint64_t WaitPercentileNs(double percentile) const { return Percentile(waitHistogram, percentile); }
+
+    /**
+     * Estimate a hold time percentile from the histogram.
+     *
+     * @param percentile  Percentile between 0 and 100.
+     *
+     * @return  Upper bound of the histogram bucket holding the percentile, in nanoseconds.
+     */
+    uint64_t HoldPercentileNs(double percentile) const { return Percentile(holdHistogram, percentile); }
+
+  private:
+    static uint64_t Percentile(const uint32_t* histogram, double percentile);
+};
+
+/**
+ * LockProfiler records how long Mutex objects are waited on and held, keyed by the
+ * MUTEX_CONTEXT file and line of the Lock() call. Mutex only reports to it when built
+ * with QCC_LOCK_PROFILER defined (scons LOCK_PROFILER=on), and it is off at runtime until
+ * SetEnabled() is called or the ER_LOCK_PROFILE environment variable is set to the
+ * sampling interval, e.g. ER_LOCK_PROFILE=1 to time every acquisition.
+ *
+ * Samples go into histograms owned by the recording thread so profiling does not
+ * add contention of its own. Reading the statistics merges the per-thread data
+ * without stopping the recording threads, so the numbers may be slightly stale.
+ */
+class LockProfiler {
+  public:
+    /**
+     * Called by qcc::Init() to apply the ER_LOCK_PROFILE environment variable.
+     */
+    static void Init();
+
+    /**
+     * Turn recording on or off.
+     *
+     * @param enabled         true to start recording.
+     * @param sampleInterval  Time one in sampleInterval acquisitions on each thread, 1 times all of them.
+     */
+    static void SetEnabled(bool enabled, uint32_t sampleInterval = 1);
+
+    /**
+     * @return true if acquisitions are currently being recorded.
+     */
+    static bool IsEnabled() { return s_enabled; }
+
+    /**
+     * Discard everything recorded so far.
+     */
+    static void Reset();
+
+    /**
+     * Merge the statistics recorded by all threads.
+     *
+     * @param[out] stats  One entry per lock site, ordered by decreasing total wait time.
+     */
+    static void GetSiteStats(std::vector<LockSiteStats>& stats);
+
+    /**
+     * Format the busiest lock sites as a table.
+     *
+     * @param maxSites  Maximum number of sites to include, 0 for all of them.
+     *
+     * @return  The table, one line per site ordered by decreasing total wait time.
+     */
+    static qcc::String Dump(size_t maxSites = 0);
+
+  private:
+    friend class MutexInternal;
+
+    class ThreadProfile;
+
+    /* Monotonic time in nanoseconds */
+    static uint64_t Now();
+
+    /* true if the calling thread should time its next acquisition */
+    static bool ShouldSample();
+
+    /* Record that a sampled acquisition completed after waiting waitNs */
+    static void RecordAcquire(const char* file, uint32_t line, uint64_t waitNs, bool contended);
+
+    /* Record that a sampled acquisition was released after holding the lock for holdNs */
+    static void RecordRelease(const char* file, uint32_t line, uint64_t holdNs);
+
+    /* Remember the site of a lock released by a Condition wait so the hold can resume on wakeup */
+    static void SuspendHold(const char* file, uint32_t line);
+
+    /* Retrieve the site saved by SuspendHold, returns false if nothing was suspended */
+    static bool ResumeHold(const char*& file, uint32_t& line);
+
+    static ThreadProfile* GetThreadProfile();
+
+    static volatile bool s_enabled;
+    static volatile uint32_t s_sampleInterval;
+    static volatile int32_t s_generation;
+    static ThreadProfile* volatile s_profiles;
+};
+
+} /* namespace */
+
+#endif  /* _QCC_LOCKPROFILER_H */
@@ -50,9 +50,10 @@ namespace qcc {
  * help when debugging Mutex related issues. When running in debug mode, this
  * will cause the code to log the name of the file and the line number of that
  * file each time a Mutex lock is obtained and released. Logging must be turned
- * on to see this information.
+ * on to see this information. Builds with the lock profiler (QCC_LOCK_PROFILER)
+ * also use it to attribute wait and hold times to lock sites.
  */
-#ifndef NDEBUG
+#if !defined(NDEBUG) || defined(QCC_LOCK_PROFILER)
 #define MUTEX_CONTEXT __FILE__, __LINE__
 #else
 #define MUTEX_CONTEXT
@@ -163,6 +163,17 @@ public:
 #endif
 
 private:
+    /* Acquire the platform lock, timing the acquisition when the lock profiler is recording */
+    QStatus AcquireLock(const char* file, uint32_t line);
+
+    /* Common implementation of the Lock overloads */
+    QStatus LockInternal(const char* file, uint32_t line);
+
+#ifdef QCC_LOCK_PROFILER
+    QStatus ProfiledLock(const char* file, uint32_t line);
+    void ProfiledUnlock();
+#endif
+
     bool PlatformSpecificInit();
     void PlatformSpecificDestroy();
     QStatus PlatformSpecificLock();
@@ -181,6 +192,18 @@ private:
     /* true if mutex was successfully initialized */
     bool m_initialized;
 
+#ifdef QCC_LOCK_PROFILER
+    /* Site of the acquisition being timed by the lock profiler */
+    const char* m_profileFile;
+    uint32_t m_profileLine;
+
+    /* Recursion depth of the timed acquisition, 0 if the current hold is not being timed */
+    uint32_t m_profileDepth;
+
+    /* LockProfiler::Now() when the timed acquisition completed */
+    uint64_t m_profileAcquiredNs;
+#endif
+
 #ifndef NDEBUG
     /* Pointer back to the mutex object that owns this MutexInternal object */
     Mutex *m_ownerLock;
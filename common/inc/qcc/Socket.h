@@ -443,6 +443,15 @@ QStatus SetLinger(SocketFd sockfd, bool onoff, uint32_t linger);
  */
 QStatus SetNagle(SocketFd sockfd, bool useNagle);
 
+/**
+ * Set TCP based socket to hold back partial frames until uncorked (TCP_CORK)
+ *
+ * @param sockfd  Socket descriptor.
+ * @param cork    Set to true to hold back partial frames. Set to false to send them.
+ * @return ER_NOT_IMPLEMENTED if the platform has no equivalent of TCP_CORK.
+ */
+QStatus SetCork(SocketFd sockfd, bool cork);
+
 /**
  * @brief Allow a service to bind to a TCP endpoint which is in the TIME_WAIT
  * state.
@@ -284,6 +284,13 @@ class SocketStream : public Stream {
      */
     QStatus SetNagle(bool reuse);
 
+    /**
+     * Set TCP based socket to hold back partial frames until uncorked (TCP_CORK)
+     *
+     * @param cork  Set to true to hold back partial frames. Set to false to send them.
+     */
+    QStatus SetCork(bool cork);
+
   private:
 
     /*
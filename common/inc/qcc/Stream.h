@@ -198,6 +198,18 @@ class Sink {
     virtual void SetSendTimeout(uint32_t sendTimeout) {
         QCC_UNUSED(sendTimeout);
     }
+
+    /**
+     * Hold back partially filled frames until the sink is uncorked, so that a burst of
+     * small writes leaves in as few frames as possible.
+     *
+     * @param cork   true to hold back partial frames, false to send them immediately.
+     * @return ER_OK if successful or ER_NOT_IMPLEMENTED if the sink cannot do this.
+     */
+    virtual QStatus SetCork(bool cork) {
+        QCC_UNUSED(cork);
+        return ER_NOT_IMPLEMENTED;
+    }
 };
 
 /**
@@ -0,0 +1,249 @@
+/**
+ * @file
+ *
+ * Key type for string keyed maps that can be searched without copying the string.
+ */
+
+
+/******************************************************************************
+ *    Copyright (c) Open Connectivity Foundation (OCF), AllJoyn Open Source
+ *    Project (AJOSP) Contributors and others.
+ *
+ *    SPDX-License-Identifier: Apache-2.0
+ *
+ *    All rights reserved. This program and the accompanying materials are
+ *    made available under the terms of the Apache License, Version 2.0
+ *    which accompanies this distribution, and is available at
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Copyright (c) Open Connectivity Foundation and Contributors to AllSeen
+ *    Alliance. All rights reserved.
+ *
+ *    Permission to use, copy, modify, and/or distribute this software for
+ *    any purpose with or without fee is hereby granted, provided that the
+ *    above copyright notice and this permission notice appear in all
+ *    copies.
+ *
+ *    THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+ *    WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+ *    WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ *    AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ *    DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ *    PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+ *    TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ *    PERFORMANCE OF THIS SOFTWARE.
+ ******************************************************************************/
+#ifndef _QCC_STRINGMAPKEY_H
+#define _QCC_STRINGMAPKEY_H
+
+#include <qcc/platform.h>
+#include <qcc/String.h>
+
+#include <string.h>
+#include <string>
+
+namespace qcc {
+
+/**
+ * StringMapKey is used as the key of std::map and std::unordered_map containers that are indexed
+ * by bus names, interface names and similar strings.
+ *
+ * A key either owns a copy of its characters or borrows the characters of a string owned by the
+ * caller. The converting constructors and the copy constructor always make owning keys so a key
+ * stored in a container can never dangle. Borrow() makes a key that refers to the caller's string
+ * without allocating; it is only meant to be passed to find(), count(), erase() and the like while
+ * the borrowed string is still alive.
+ */
+class StringMapKey {
+  public:
+
+    /**
+     * Construct an empty key.
+     */
+    StringMapKey() : borrowed(NULL), len(0) { }
+
+    /**
+     * Construct a key owning a copy of a nul terminated string.
+     *
+     * @param str  The string (NULL is treated as the empty string).
+     */
+    StringMapKey(const char* str) : owned(str ? str : ""), borrowed(NULL), len(owned.size()) { }
+
+    /**
+     * Construct a key owning a copy of a qcc::String.
+     *
+     * @param str  The string.
+     */
+    StringMapKey(const qcc::String& str) : owned(str.data(), str.size()), borrowed(NULL), len(owned.size()) { }
+
+    /**
+     * Construct a key owning a copy of a std::string.
+     *
+     * @param str  The string.
+     */
+    StringMapKey(const std::string& str) : owned(str), borrowed(NULL), len(owned.size()) { }
+
+    /**
+     * Copy constructor. The new key always owns its characters.
+     *
+     * @param other  The key to copy.
+     */
+    StringMapKey(const StringMapKey& other) : owned(other.data(), other.len), borrowed(NULL), len(other.len) { }
+
+    /**
+     * Assignment operator. The assigned key always owns its characters.
+     *
+     * @param other  The key to copy.
+     */
+    StringMapKey& operator=(const StringMapKey& other)
+    {
+        if (this != &other) {
+            owned.assign(other.data(), other.len);
+            borrowed = NULL;
+            len = other.len;
+        }
+        return *this;
+    }
+
+    /**
+     * Make a lookup key that borrows the characters of a nul terminated string.
+     *
+     * @param str  The string, which must outlive the returned key (NULL is treated as "").
+     *
+     * @return  A key that does not own its characters.
+     */
+    static StringMapKey Borrow(const char* str) { return str ? StringMapKey(str, strlen(str), true) : StringMapKey(); }
+
+    /**
+     * Make a lookup key that borrows the first @a length characters of a string.
+     *
+     * @param str     The string, which must outlive the returned key.
+     * @param length  Number of characters of @a str that make up the key.
+     *
+     * @return  A key that does not own its characters.
+     */
+    static StringMapKey Borrow(const char* str, size_t length) { return StringMapKey(str, length, true); }
+
+    /**
+     * Make a lookup key that borrows the characters of a qcc::String.
+     *
+     * @param str  The string, which must outlive the returned key and not be modified while it is in use.
+     *
+     * @return  A key that does not own its characters.
+     */
+    static StringMapKey Borrow(const qcc::String& str) { return StringMapKey(str.data(), str.size(), true); }
+
+    /**
+     * Make a lookup key that borrows the characters of a std::string.
+     *
+     * @param str  The string, which must outlive the returned key and not be modified while it is in use.
+     *
+     * @return  A key that does not own its characters.
+     */
+    static StringMapKey Borrow(const std::string& str) { return StringMapKey(str.data(), str.size(), true); }
+
+    /**
+     * Get the characters of the key. Only owning keys are guaranteed to be nul terminated.
+     *
+     * @return  Pointer to the first character of the key.
+     */
+    const char* data() const { return borrowed ? borrowed : owned.data(); }
+
+    /**
+     * Get the length of the key.
+     *
+     * @return  The number of characters in the key.
+     */
+    size_t size() const { return len; }
+
+    /**
+     * Test if the key is the empty string.
+     *
+     * @return  true if the key has no characters.
+     */
+    bool empty() const { return len == 0; }
+
+    /**
+     * Get a copy of the key as a qcc::String.
+     *
+     * @return  The key as a qcc::String.
+     */
+    qcc::String ToString() const { return qcc::String(data(), len); }
+
+    /**
+     * Compare the key to a nul terminated string without allocating.
+     *
+     * @param str  The string to compare against.
+     *
+     * @return  true if the key and @a str have the same characters.
+     */
+    bool Equals(const char* str) const { return str && (strlen(str) == len) && (memcmp(data(), str, len) == 0); }
+
+    /**
+     * Equality operator.
+     *
+     * @param other  The key to compare against.
+     *
+     * @return  true if both keys have the same characters.
+     */
+    bool operator==(const StringMapKey& other) const { return (len == other.len) && (memcmp(data(), other.data(), len) == 0); }
+
+    /**
+     * Inequality operator.
+     *
+     * @param other  The key to compare against.
+     *
+     * @return  true if the keys have different characters.
+     */
+    bool operator!=(const StringMapKey& other) const { return !(*this == other); }
+
+    /**
+     * Less than operator. Keys are ordered the same way std::string orders its values.
+     *
+     * @param other  The key to compare against.
+     *
+     * @return  true if this key sorts before @a other.
+     */
+    bool operator<(const StringMapKey& other) const
+    {
+        int c = memcmp(data(), other.data(), (len < other.len) ? len : other.len);
+        return (c < 0) || ((c == 0) && (len < other.len));
+    }
+
+    /**
+     * Hash functor for use with std::unordered_map (FNV-1a).
+     */
+    struct Hash {
+        /**
+         * Calculate the hash of a key.
+         *
+         * @param key  The key to hash.
+         *
+         * @return  The hash value.
+         */
+        size_t operator()(const StringMapKey& key) const
+        {
+            uint32_t hash = 2166136261U;
+            const uint8_t* p = reinterpret_cast<const uint8_t*>(key.data());
+            for (size_t i = 0; i < key.len; ++i) {
+                hash = (hash ^ p[i]) * 16777619U;
+            }
+            return hash;
+        }
+    };
+
+  private:
+
+    /**
+     * Construct a borrowing key.
+     */
+    StringMapKey(const char* str, size_t length, bool borrow) : borrowed(str ? str : ""), len(str ? length : 0) { QCC_UNUSED(borrow); }
+
+    std::string owned;     /**< Characters of an owning key */
+    const char* borrowed;  /**< Characters of a borrowing key, NULL if the key owns its characters */
+    size_t len;            /**< Number of characters in the key */
+};
+
+}
+
+#endif
@@ -69,10 +69,14 @@ QStatus DeleteFile(qcc::String fileName);
  */
 QStatus FileExists(const qcc::String& fileName);
 
+class FileLock;
+
 /**
  * FileSource is an implementation of Source used for reading from files.
  */
 class FileSource : public Source {
+    /* Required to access fd. */
+    friend class FileLock;
   public:
 
     /**
@@ -160,14 +164,27 @@ class FileSource : public Source {
      */
     void Unlock();
 
+    /**
+     * Map the file into memory so that PullBytes() copies from the mapping instead of issuing a
+     * read for every call. Pulling continues from the current file offset. The file must not be
+     * truncated while it is mapped.
+     *
+     * @return true if the file is mapped, false if it is empty or could not be mapped, in which
+     *         case PullBytes() keeps reading from the file.
+     */
+    bool Map();
+
   private:
-    int fd;        /**< File descriptor */
-    Event* event;  /**< I/O event */
-    bool ownsFd;   /**< true if sink is responsible for closing fd */
-    bool locked;   /**< true if the sink has been locked for exclusive access */
+    int fd;           /**< File descriptor */
+    Event* event;     /**< I/O event */
+    bool ownsFd;      /**< true if sink is responsible for closing fd */
+    bool locked;      /**< true if the sink has been locked for exclusive access */
+    uint8_t* map;     /**< Mapping of the file or NULL if the file is not mapped */
+    size_t mapSize;   /**< Size of the mapping */
+    size_t mapPos;    /**< Offset of the next byte to pull from the mapping */
 };
 
-class FileLock;
+class FileLocker;
 
 /**
  * FileSink is an implementation of Sink used to write to files.
@@ -175,6 +192,7 @@ class FileLock;
 class FileSink : public Sink {
     /* Required to access fd. */
     friend class FileLock;
+    friend class FileLocker;
   public:
 
     /**
@@ -255,6 +273,13 @@ class FileSink : public Sink {
      */
     bool Truncate();
 
+    /**
+     * Flush the data written so far to the storage device.
+     *
+     * @return true on success.
+     */
+    bool Sync();
+
     /**
      * Lock the underlying file for exclusive access
      *
@@ -278,8 +303,6 @@ class FileSink : public Sink {
     bool locked;   /**< true if the sink has been locked for exclusive access */
 };
 
-class FileLocker;
-
 class FileLock {
     friend class FileLocker;
   public:
@@ -312,6 +335,13 @@ class FileLocker {
     QStatus AcquireWriteLock();
     void ReleaseWriteLock();
 
+    /*
+     * Replace the contents of the shared file, the caller must hold the write lock. The data is
+     * written to a temporary file, flushed to disk and renamed over the shared file, so a crash
+     * leaves either the old or the new contents. The write lock is kept on the new file.
+     */
+    QStatus ReplaceFile(const void* data, size_t len);
+
   private:
     qcc::String m_fileName;
     std::shared_ptr<FileSink> m_sink;
@@ -36,6 +36,8 @@
 
 #include <errno.h>
 #include <fcntl.h>
+#include <limits.h>
+#include <poll.h>
 #include <pthread.h>
 #include <time.h>
 #include <unistd.h>
@@ -205,25 +207,27 @@ QStatus Event::Wait(Event& evt, uint32_t maxWaitMs)
     }
 }
 #else
+/*
+ * Converts a wait in milliseconds into a poll() timeout. poll() is used rather than select()
+ * because select() cannot watch descriptors numbered FD_SETSIZE or above, which a router with
+ * many connected clients quickly exceeds.
+ */
+static int PollTimeout(uint32_t maxWaitMs)
+{
+    if (maxWaitMs == Event::WAIT_FOREVER) {
+        return -1;
+    }
+    return (maxWaitMs > (uint32_t)INT_MAX) ? INT_MAX : (int)maxWaitMs;
+}
+
 QStatus Event::Wait(Event& evt, uint32_t maxWaitMs)
 {
-    fd_set set;
-    fd_set stopSet;
-    int maxFd = -1;
-    struct timeval tval;
-    struct timeval* pTval = NULL;
+    struct pollfd pollFds[3];
+    nfds_t numFds = 0;
+    int timeoutMs = PollTimeout(maxWaitMs);
 
     Thread* thread = Thread::GetThread();
 
-    FD_ZERO(&set);
-    FD_ZERO(&stopSet);
-
-    if (maxWaitMs != WAIT_FOREVER) {
-        tval.tv_sec = maxWaitMs / 1000;
-        tval.tv_usec = (maxWaitMs % 1000) * 1000;
-        pTval = &tval;
-    }
-
     if (evt.eventType == TIMED) {
         uint32_t now = GetTimestamp();
         if (evt.timestamp <= now) {
@@ -231,44 +235,51 @@ QStatus Event::Wait(Event& evt, uint32_t maxWaitMs)
                 evt.timestamp += (((now - evt.timestamp) / evt.period) + 1) * evt.period;
             }
             return ER_OK;
-        } else if (!pTval || ((evt.timestamp - now) < (uint32_t) (tval.tv_sec * 1000 + tval.tv_usec / 1000))) {
-            tval.tv_sec = (evt.timestamp - now) / 1000;
-            tval.tv_usec = 1000 * ((evt.timestamp - now) % 1000);
-            pTval = &tval;
+        } else if ((timeoutMs < 0) || ((evt.timestamp - now) < (uint32_t)timeoutMs)) {
+            timeoutMs = (int)(evt.timestamp - now);
         }
     } else {
+        short events = (evt.eventType == IO_WRITE) ? POLLOUT : POLLIN;
         if (0 <= evt.fd) {
-            FD_SET(evt.fd, &set);
-            maxFd = max(maxFd, evt.fd);
+            pollFds[numFds].fd = evt.fd;
+            pollFds[numFds].events = events;
+            pollFds[numFds].revents = 0;
+            ++numFds;
         }
         if (0 <= evt.ioFd) {
-            FD_SET(evt.ioFd, &set);
-            maxFd = max(maxFd, evt.ioFd);
+            pollFds[numFds].fd = evt.ioFd;
+            pollFds[numFds].events = events;
+            pollFds[numFds].revents = 0;
+            ++numFds;
         }
     }
+    nfds_t evtFds = numFds;
 
     int stopFd = -1;
     if (thread) {
         stopFd = thread->GetStopEvent().fd;
-        if (evt.eventType == IO_WRITE) {
-            FD_SET(stopFd, &stopSet);
-        } else {
-            FD_SET(stopFd, &set);
-        }
-        maxFd = max(maxFd, stopFd);
+        pollFds[numFds].fd = stopFd;
+        pollFds[numFds].events = POLLIN;
+        pollFds[numFds].revents = 0;
+        ++numFds;
     }
 
     evt.IncrementNumThreads();
 
-    int ret = select(maxFd + 1,
-                     (evt.eventType == IO_WRITE) ? &stopSet : &set,
-                     (evt.eventType == IO_WRITE) ? &set : NULL,
-                     NULL,
-                     pTval);
+    int ret = poll(pollFds, numFds, timeoutMs);
 
     evt.DecrementNumThreads();
 
-    if ((0 <= stopFd) && (FD_ISSET(stopFd, &set) || FD_ISSET(stopFd, &stopSet))) {
+    bool signaled = false;
+    for (nfds_t i = 0; i < numFds; ++i) {
+        if (pollFds[i].revents & POLLNVAL) {
+            ret = -1;
+        } else if ((i < evtFds) && pollFds[i].revents) {
+            signaled = true;
+        }
+    }
+
+    if ((0 <= stopFd) && (0 < ret) && pollFds[evtFds].revents) {
         return thread->IsStopping() ? ER_STOPPING_THREAD : ER_ALERTED_THREAD;
     } else if (evt.eventType == TIMED) {
         uint32_t now = GetTimestamp();
@@ -280,7 +291,7 @@ QStatus Event::Wait(Event& evt, uint32_t maxWaitMs)
         } else {
             return ER_TIMEOUT;
         }
-    } else if ((0 < ret) && (((0 <= evt.fd) && FD_ISSET(evt.fd, &set)) || ((0 <= evt.ioFd) && FD_ISSET(evt.ioFd, &set)))) {
+    } else if ((0 < ret) && signaled) {
         return ER_OK;
     } else if (0 <= ret) {
         return ER_TIMEOUT;
@@ -392,78 +403,56 @@ QStatus Event::Wait(const vector<Event*>& checkEvents, vector<Event*>& signaledE
 #else
 QStatus Event::Wait(const vector<Event*>& checkEvents, vector<Event*>& signaledEvents, uint32_t maxWaitMs)
 {
-    fd_set rdset;
-    fd_set wrset;
-    struct timeval tval;
-    struct timeval* pTval = NULL;
-    bool rdSetEmpty = true;
-    bool wrSetEmpty = true;
-
-    if (maxWaitMs != WAIT_FOREVER) {
-        tval.tv_sec = maxWaitMs / 1000;
-        tval.tv_usec = (maxWaitMs % 1000) * 1000;
-        pTval = &tval;
-    }
+    int timeoutMs = PollTimeout(maxWaitMs);
 
-    FD_ZERO(&rdset);
-    FD_ZERO(&wrset);
-    int maxFd = 0;
+    /* Each event contributes up to two descriptors, firstFd records where an event's entries start */
+    vector<struct pollfd> pollFds;
+    vector<size_t> firstFd;
+    pollFds.reserve(2 * checkEvents.size());
+    firstFd.reserve(checkEvents.size() + 1);
     vector<Event*>::const_iterator it;
 
     for (it = checkEvents.begin(); it != checkEvents.end(); ++it) {
         Event* evt = *it;
         evt->IncrementNumThreads();
-        if ((evt->eventType == IO_READ) || (evt->eventType == GEN_PURPOSE)) {
-            if (0 <= evt->fd) {
-                FD_SET(evt->fd, &rdset);
-                maxFd = std::max(maxFd, evt->fd);
-                rdSetEmpty = false;
-            }
-            if (0 <= evt->ioFd) {
-                FD_SET(evt->ioFd, &rdset);
-                maxFd = std::max(maxFd, evt->ioFd);
-                rdSetEmpty = false;
-            }
-        } else if (evt->eventType == IO_WRITE) {
+        firstFd.push_back(pollFds.size());
+        if ((evt->eventType == IO_READ) || (evt->eventType == GEN_PURPOSE) || (evt->eventType == IO_WRITE)) {
+            struct pollfd pfd;
+            pfd.events = (evt->eventType == IO_WRITE) ? POLLOUT : POLLIN;
+            pfd.revents = 0;
             if (0 <= evt->fd) {
-                FD_SET(evt->fd, &wrset);
-                wrSetEmpty = false;
-                maxFd = std::max(maxFd, evt->fd);
+                pfd.fd = evt->fd;
+                pollFds.push_back(pfd);
             }
             if (0 <= evt->ioFd) {
-                FD_SET(evt->ioFd, &wrset);
-                wrSetEmpty = false;
-                maxFd = std::max(maxFd, evt->ioFd);
+                pfd.fd = evt->ioFd;
+                pollFds.push_back(pfd);
             }
         } else if (evt->eventType == TIMED) {
             uint32_t now = GetTimestamp();
             if (evt->timestamp <= now) {
-                tval.tv_sec = 0;
-                tval.tv_usec = 0;
-                pTval = &tval;
-            } else if (!pTval || ((evt->timestamp - now) < (uint32_t) (tval.tv_sec * 1000 + tval.tv_usec / 1000))) {
-                tval.tv_sec = (evt->timestamp - now) / 1000;
-                tval.tv_usec = 1000 * ((evt->timestamp - now) % 1000);
-                pTval = &tval;
+                timeoutMs = 0;
+            } else if ((timeoutMs < 0) || ((evt->timestamp - now) < (uint32_t)timeoutMs)) {
+                timeoutMs = (int)(evt->timestamp - now);
             }
         }
     }
+    firstFd.push_back(pollFds.size());
 
-    int ret = select(maxFd + 1, rdSetEmpty ? NULL : &rdset, wrSetEmpty ? NULL : &wrset, NULL, pTval);
+    int ret = poll(pollFds.empty() ? NULL : &pollFds[0], pollFds.size(), timeoutMs);
+    for (size_t i = 0; (0 < ret) && (i < pollFds.size()); ++i) {
+        if (pollFds[i].revents & POLLNVAL) {
+            errno = EBADF;
+            ret = -1;
+        }
+    }
 
     if (0 <= ret) {
-        for (it = checkEvents.begin(); it != checkEvents.end(); ++it) {
+        size_t n = 0;
+        for (it = checkEvents.begin(); it != checkEvents.end(); ++it, ++n) {
             Event* evt = *it;
             evt->DecrementNumThreads();
-            if (!rdSetEmpty && ((evt->eventType == IO_READ) || (evt->eventType == GEN_PURPOSE))) {
-                if (((0 <= evt->fd) && FD_ISSET(evt->fd, &rdset)) || ((0 <= evt->ioFd) && FD_ISSET(evt->ioFd, &rdset))) {
-                    signaledEvents.push_back(evt);
-                }
-            } else if (!wrSetEmpty && (evt->eventType == IO_WRITE)) {
-                if (((0 <= evt->fd) && FD_ISSET(evt->fd, &wrset)) || ((0 <= evt->ioFd) && FD_ISSET(evt->ioFd, &wrset))) {
-                    signaledEvents.push_back(evt);
-                }
-            } else if (evt->eventType == TIMED) {
+            if (evt->eventType == TIMED) {
                 uint32_t now = GetTimestamp();
                 if (evt->timestamp <= now) {
                     signaledEvents.push_back(evt);
@@ -471,6 +460,13 @@ QStatus Event::Wait(const vector<Event*>& checkEvents, vector<Event*>& signaledE
                         evt->timestamp += (((now - evt->timestamp) / evt->period) + 1) * evt->period;
                     }
                 }
+            } else {
+                for (size_t i = firstFd[n]; i < firstFd[n + 1]; ++i) {
+                    if (pollFds[i].revents) {
+                        signaledEvents.push_back(evt);
+                        break;
+                    }
+                }
             }
         }
         return signaledEvents.empty() ? ER_TIMEOUT : ER_OK;
@@ -478,7 +474,7 @@ QStatus Event::Wait(const vector<Event*>& checkEvents, vector<Event*>& signaledE
         for (it = checkEvents.begin(); it != checkEvents.end(); ++it) {
             (*it)->DecrementNumThreads();
         }
-        QCC_LogError(ER_FAIL, ("select failed with %d (%s)", errno, strerror(errno)));
+        QCC_LogError(ER_FAIL, ("poll failed with %d (%s)", errno, strerror(errno)));
         return ER_FAIL;
     }
 }
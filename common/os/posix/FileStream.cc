@@ -37,12 +37,15 @@
 #include <qcc/Debug.h>
 #include <qcc/FileStream.h>
 #include <qcc/String.h>
+#include <qcc/StringUtil.h>
 
+#include <algorithm>
 #include <fcntl.h>
 #include <string.h>
 #include <sys/types.h>
 #include <sys/stat.h>
 #include <sys/file.h>
+#include <sys/mman.h>
 
 using namespace std;
 using namespace qcc;
@@ -75,7 +78,8 @@ QStatus qcc::FileExists(const qcc::String& fileName)
 }
 
 FileSource::FileSource(qcc::String fileName) :
-    fd(open(fileName.c_str(), O_RDONLY)), event(new Event(fd, Event::IO_READ)), ownsFd(true), locked(false)
+    fd(open(fileName.c_str(), O_RDONLY)), event(new Event(fd, Event::IO_READ)), ownsFd(true), locked(false),
+    map(NULL), mapSize(0), mapPos(0)
 {
 #ifndef NDEBUG
     if (0 > fd) {
@@ -85,23 +89,30 @@ FileSource::FileSource(qcc::String fileName) :
 }
 
 FileSource::FileSource(int fdesc) :
-    fd(dup(fdesc)), event(new Event(fd, Event::IO_READ)), ownsFd(true), locked(false)
+    fd(dup(fdesc)), event(new Event(fd, Event::IO_READ)), ownsFd(true), locked(false),
+    map(NULL), mapSize(0), mapPos(0)
 {
 }
 
 FileSource::FileSource() :
-    fd(0), event(new Event(fd, Event::IO_READ)), ownsFd(false), locked(false)
+    fd(0), event(new Event(fd, Event::IO_READ)), ownsFd(false), locked(false),
+    map(NULL), mapSize(0), mapPos(0)
 {
 }
 
 FileSource::FileSource(const FileSource& other) :
-    fd(dup(other.fd)), event(new Event(fd, Event::IO_READ)), ownsFd(true), locked(other.locked)
+    fd(dup(other.fd)), event(new Event(fd, Event::IO_READ)), ownsFd(true), locked(other.locked),
+    map(NULL), mapSize(0), mapPos(0)
 {
 }
 
 FileSource FileSource::operator=(const FileSource& other)
 {
     if (&other != this) {
+        if (map) {
+            munmap(map, mapSize);
+            map = NULL;
+        }
         if (ownsFd && (0 <= fd)) {
             close(fd);
         }
@@ -116,6 +127,9 @@ FileSource FileSource::operator=(const FileSource& other)
 
 FileSource::~FileSource()
 {
+    if (map) {
+        munmap(map, mapSize);
+    }
     Unlock();
     if (ownsFd && (0 <= fd)) {
         close(fd);
@@ -152,6 +166,12 @@ QStatus FileSource::PullBytes(void* buf, size_t reqBytes, size_t& actualBytes, u
         actualBytes = 0;
         return ER_OK;
     }
+    if (map) {
+        actualBytes = std::min(reqBytes, mapSize - mapPos);
+        memcpy(buf, map + mapPos, actualBytes);
+        mapPos += actualBytes;
+        return (0 == actualBytes) ? ER_EOF : ER_OK;
+    }
     ssize_t ret = read(fd, buf, reqBytes);
     if (0 > ret) {
         QCC_LogError(ER_FAIL, ("read returned error (%d)", errno));
@@ -185,6 +205,34 @@ void FileSource::Unlock()
     }
 }
 
+bool FileSource::Map()
+{
+    if (map) {
+        return true;
+    }
+    if (0 > fd) {
+        return false;
+    }
+    struct stat buf = { };
+    if (0 > fstat(fd, &buf)) {
+        QCC_LogError(ER_OS_ERROR, ("fstat fd %d failed with '%s'", fd, strerror(errno)));
+        return false;
+    }
+    off_t pos = lseek(fd, 0, SEEK_CUR);
+    if ((0 >= buf.st_size) || (0 > pos) || (pos > buf.st_size)) {
+        return false;
+    }
+    void* addr = mmap(NULL, buf.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    if (MAP_FAILED == addr) {
+        QCC_DbgHLPrintf(("mmap fd %d failed with '%s'", fd, strerror(errno)));
+        return false;
+    }
+    map = static_cast<uint8_t*>(addr);
+    mapSize = buf.st_size;
+    mapPos = pos;
+    return true;
+}
+
 FileSink::FileSink(qcc::String fileName, Mode mode)
     : fd(-1), event(new Event(fd, Event::IO_WRITE)), ownsFd(true), locked(false)
 {
@@ -371,6 +419,20 @@ bool FileSink::Truncate()
     return true;
 }
 
+bool FileSink::Sync()
+{
+#if defined(QCC_OS_DARWIN)
+    int ret = fsync(fd);
+#else
+    int ret = fdatasync(fd);
+#endif
+    if (ret < 0) {
+        QCC_LogError(ER_OS_ERROR, ("Sync fd %d failed with '%s'", fd, strerror(errno)));
+        return false;
+    }
+    return true;
+}
+
 bool FileSink::Lock(bool block)
 {
     if (fd < 0) {
@@ -394,6 +456,35 @@ void FileSink::Unlock()
     }
 }
 
+/*
+ * FileLocker::ReplaceFile() renames a new file over the shared file, so a lock taken on an open
+ * file only protects the shared file while that file is still the one at fileName.
+ */
+static bool IsCurrentFile(int fd, const qcc::String& fileName)
+{
+    struct stat fdStat;
+    struct stat nameStat;
+    if ((0 > fstat(fd, &fdStat)) || (0 > stat(fileName.c_str(), &nameStat))) {
+        return false;
+    }
+    return (fdStat.st_dev == nameStat.st_dev) && (fdStat.st_ino == nameStat.st_ino);
+}
+
+/* Make a rename in the directory containing fileName durable */
+static void SyncDirectory(const qcc::String& fileName)
+{
+    size_t slash = fileName.find_last_of_std('/');
+    qcc::String dir = (slash == String::npos) ? "." : ((slash == 0) ? "/" : fileName.substr(0, slash));
+    int dirFd = open(dir.c_str(), O_RDONLY);
+    if (0 > dirFd) {
+        return;
+    }
+    if (0 > fsync(dirFd)) {
+        QCC_DbgHLPrintf(("fsync(%s) failed with '%s'", dir.c_str(), strerror(errno)));
+    }
+    close(dirFd);
+}
+
 FileSource* FileLock::GetSource()
 {
     return m_source.get();
@@ -412,15 +503,22 @@ void FileLock::Release()
 
 QStatus FileLock::InitReadOnly(const char* fullFileName)
 {
-    m_source.reset(new FileSource(fullFileName));
     m_sink.reset();
-    if (!m_source->IsValid()) {
-        m_source.reset();
-        return ER_EOF;
-    }
-    if (!m_source->Lock(true)) {
-        return ER_READ_ERROR;
+    for (;;) {
+        m_source.reset(new FileSource(fullFileName));
+        if (!m_source->IsValid()) {
+            m_source.reset();
+            return ER_EOF;
+        }
+        if (!m_source->Lock(true)) {
+            return ER_READ_ERROR;
+        }
+        if (IsCurrentFile(m_source->fd, fullFileName)) {
+            break;
+        }
+        /* The file was replaced while waiting for the lock, lock the new file instead */
     }
+    m_source->Map();
     return ER_OK;
 }
 
@@ -522,8 +620,21 @@ QStatus FileLocker::AcquireWriteLock()
     /* Release sinkLock in preparation for acquiring the file lock. */
     m_sinkLock.Unlock(MUTEX_CONTEXT);
 
-    /* Try to acquire the file lock. */
-    if (!sink->Lock(true)) {
+    /* Try to acquire the file lock, the file may be replaced while waiting for it. */
+    bool locked = sink->Lock(true);
+    while (locked && !IsCurrentFile(sink->fd, m_fileName)) {
+        std::shared_ptr<FileSink> current = std::make_shared<FileSink>(m_fileName, false, FileSink::PRIVATE);
+        if (!current->IsValid()) {
+            locked = false;
+            break;
+        }
+        sink = current;
+        QCC_VERIFY(ER_OK == m_sinkLock.Lock(MUTEX_CONTEXT));
+        m_sink = sink;
+        m_sinkLock.Unlock(MUTEX_CONTEXT);
+        locked = sink->Lock(true);
+    }
+    if (!locked) {
         /* Failed to acquire the file lock, release the sink ref count (under sinkLock). */
         QCC_VERIFY(ER_OK == m_sinkLock.Lock(MUTEX_CONTEXT));
         m_sink.reset();
@@ -539,3 +650,51 @@ void FileLocker::ReleaseWriteLock()
     m_sink.reset();
     m_sinkLock.Unlock(MUTEX_CONTEXT);
 }
+
+QStatus FileLocker::ReplaceFile(const void* data, size_t len)
+{
+    if (!HasWriteLock()) {
+        return ER_BUS_NOT_ALLOWED;
+    }
+
+    qcc::String tempName = m_fileName + ".tmp" + U32ToString(static_cast<uint32_t>(getpid()));
+    std::shared_ptr<FileSink> temp = std::make_shared<FileSink>(tempName, true, FileSink::PRIVATE);
+    if (!temp->IsValid()) {
+        return ER_OS_ERROR;
+    }
+    /* Lock the new file before it is renamed into place so the write lock is never given up */
+    if (!temp->Lock(true)) {
+        temp.reset();
+        unlink(tempName.c_str());
+        return ER_OS_ERROR;
+    }
+
+    QStatus status = ER_OK;
+    const uint8_t* buf = static_cast<const uint8_t*>(data);
+    while ((ER_OK == status) && (len > 0)) {
+        size_t sent = 0;
+        status = temp->PushBytes(buf, len, sent);
+        if ((ER_OK == status) && (0 == sent)) {
+            status = ER_OS_ERROR;
+        }
+        buf += sent;
+        len -= sent;
+    }
+    if ((ER_OK == status) && !temp->Sync()) {
+        status = ER_OS_ERROR;
+    }
+    if ((ER_OK == status) && (0 > rename(tempName.c_str(), m_fileName.c_str()))) {
+        status = ER_OS_ERROR;
+        QCC_LogError(status, ("rename(%s) failed with '%s'", m_fileName.c_str(), strerror(errno)));
+    }
+    if (ER_OK != status) {
+        unlink(tempName.c_str());
+        return status;
+    }
+    SyncDirectory(m_fileName);
+
+    QCC_VERIFY(ER_OK == m_sinkLock.Lock(MUTEX_CONTEXT));
+    m_sink = temp;
+    m_sinkLock.Unlock(MUTEX_CONTEXT);
+    return ER_OK;
+}
@@ -364,6 +364,34 @@ class IfEntry {
     uint32_t m_flags;
 };
 
+//
+// Pull the link layer information out of an RTM_NEWLINK or RTM_DELLINK
+// message.  These messages come both as replies to an RTM_GETLINK dump and as
+// notifications on a socket subscribed to RTMGRP_LINK.
+//
+static void ParseLink(struct nlmsghdr* nh, IfEntry& entry)
+{
+    struct ifinfomsg* ifi = (struct ifinfomsg*)NLMSG_DATA(nh);
+    entry.m_index = ifi->ifi_index;
+    entry.m_flags = ifi->ifi_flags;
+    entry.m_mtu = 0;
+
+    struct rtattr* rta = IFLA_RTA(ifi);
+    uint32_t rtalen = IFLA_PAYLOAD(nh);
+
+    for (; RTA_OK(rta, rtalen); rta = RTA_NEXT(rta, rtalen)) {
+        switch (rta->rta_type) {
+        case IFLA_IFNAME:
+            entry.m_name = qcc::String((char*)RTA_DATA(rta));
+            break;
+
+        case IFLA_MTU:
+            entry.m_mtu = *(int*)RTA_DATA(rta);
+            break;
+        }
+    }
+}
+
 //
 // There are two fundamental pieces to the puzzle we want to solve.  We need
 // to get a list of interfaces on the system and then we want to get a list
@@ -427,26 +455,7 @@ static std::list<IfEntry> NetlinkGetInterfaces(void)
         case RTM_NEWLINK:
             {
                 IfEntry entry;
-
-                struct ifinfomsg* ifi = (struct ifinfomsg*)NLMSG_DATA(nh);
-                entry.m_index = ifi->ifi_index;
-                entry.m_flags = ifi->ifi_flags;
-                entry.m_mtu = 0;
-
-                struct rtattr* rta = IFLA_RTA(ifi);
-                uint32_t rtalen = IFLA_PAYLOAD(nh);
-
-                for (; RTA_OK(rta, rtalen); rta = RTA_NEXT(rta, rtalen)) {
-                    switch (rta->rta_type) {
-                    case IFLA_IFNAME:
-                        entry.m_name = qcc::String((char*)RTA_DATA(rta));
-                        break;
-
-                    case IFLA_MTU:
-                        entry.m_mtu = *(int*)RTA_DATA(rta);
-                        break;
-                    }
-                }
+                ParseLink(nh, entry);
                 entries.push_back(entry);
                 break;
             }
@@ -481,6 +490,54 @@ class AddrEntry {
     qcc::String m_addr;
 };
 
+//
+// Pull the network layer information out of an RTM_NEWADDR or RTM_DELADDR
+// message, either from an RTM_GETADDR dump or from a notification on a socket
+// subscribed to RTMGRP_IPV4_IFADDR or RTMGRP_IPV6_IFADDR.
+//
+static void ParseAddress(struct nlmsghdr* nh, AddrEntry& entry)
+{
+    struct ifaddrmsg* ifa = (struct ifaddrmsg*)NLMSG_DATA(nh);
+
+    entry.m_family = ifa->ifa_family;
+    entry.m_prefixlen = ifa->ifa_prefixlen;
+    entry.m_flags = ifa->ifa_flags;
+    entry.m_scope = ifa->ifa_scope;
+    entry.m_index = ifa->ifa_index;
+
+    struct rtattr* rta = IFA_RTA(ifa);
+    uint32_t rtalen = IFA_PAYLOAD(nh);
+
+    for (; RTA_OK(rta, rtalen); rta = RTA_NEXT(rta, rtalen)) {
+        switch (rta->rta_type) {
+        case IFA_ADDRESS:
+            if (ifa->ifa_family == AF_INET) {
+                struct in_addr* p = (struct in_addr*)RTA_DATA(rta);
+                //
+                // Android seems to stash INADDR_ANY in as an
+                // IFA_ADDRESS in the case of an AF_INET address
+                // for some reason, so we ignore those.
+                //
+                if (p->s_addr != 0) {
+                    char buffer[17];
+                    inet_ntop(AF_INET, p, buffer, sizeof(buffer));
+                    entry.m_addr = qcc::String(buffer);
+                }
+            }
+            if (ifa->ifa_family == AF_INET6) {
+                struct in6_addr* p = (struct in6_addr*)RTA_DATA(rta);
+                char buffer[41];
+                inet_ntop(AF_INET6, p, buffer, sizeof(buffer));
+                entry.m_addr = qcc::String(buffer);
+            }
+            break;
+
+        default:
+            break;
+        }
+    }
+}
+
 //
 // There are two fundamental pieces to the puzzle we want to solve.  We need
 // to get a list of interfaces on the system and then we want to get a list
@@ -543,46 +600,7 @@ static std::list<AddrEntry> NetlinkGetAddresses(uint32_t family)
         case RTM_NEWADDR:
             {
                 AddrEntry entry;
-
-                struct ifaddrmsg* ifa = (struct ifaddrmsg*)NLMSG_DATA(nh);
-
-                entry.m_family = ifa->ifa_family;
-                entry.m_prefixlen = ifa->ifa_prefixlen;
-                entry.m_flags = ifa->ifa_flags;
-                entry.m_scope = ifa->ifa_scope;
-                entry.m_index = ifa->ifa_index;
-
-                struct rtattr* rta = IFA_RTA(ifa);
-                uint32_t rtalen = IFA_PAYLOAD(nh);
-
-                for (; RTA_OK(rta, rtalen); rta = RTA_NEXT(rta, rtalen)) {
-                    switch (rta->rta_type) {
-                    case IFA_ADDRESS:
-                        if (ifa->ifa_family == AF_INET) {
-                            struct in_addr* p = (struct in_addr*)RTA_DATA(rta);
-                            //
-                            // Android seems to stash INADDR_ANY in as an
-                            // IFA_ADDRESS in the case of an AF_INET address
-                            // for some reason, so we ignore those.
-                            //
-                            if (p->s_addr != 0) {
-                                char buffer[17];
-                                inet_ntop(AF_INET, p, buffer, sizeof(buffer));
-                                entry.m_addr = qcc::String(buffer);
-                            }
-                        }
-                        if (ifa->ifa_family == AF_INET6) {
-                            struct in6_addr* p = (struct in6_addr*)RTA_DATA(rta);
-                            char buffer[41];
-                            inet_ntop(AF_INET6, p, buffer, sizeof(buffer));
-                            entry.m_addr = qcc::String(buffer);
-                        }
-                        break;
-
-                    default:
-                        break;
-                    }
-                }
+                ParseAddress(nh, entry);
                 entries.push_back(entry);
             }
             break;
@@ -674,7 +692,7 @@ QStatus IfConfig(std::vector<IfConfigEntry>& entries)
         if (nAddresses == 0) {
             IfConfigEntry entry;
             entry.m_name = (*i).m_name.c_str();
-            entry.m_flags = (*i).m_flags;
+            entry.m_flags = TranslateFlags((*i).m_flags);
             entry.m_mtu = (*i).m_mtu;
             entry.m_index = (*i).m_index;
 
@@ -740,7 +758,7 @@ static NetworkEventType NetworkEventRecv(qcc::SocketFd sockFd, char* buffer, int
  * This is the high-level function that creates a socket on which
  * to receive network event notifications.
  */
-static SocketFd NetworkChangeEventSocket()
+static SocketFd NetworkChangeEventSocket(uint32_t groups)
 {
     int sockFd;
     struct sockaddr_nl addr;
@@ -753,7 +771,7 @@ static SocketFd NetworkChangeEventSocket()
     fcntl(sockFd, F_SETFL, O_NONBLOCK);
     memset(&addr, 0, sizeof(addr));
     addr.nl_family = AF_NETLINK;
-    addr.nl_groups = RTMGRP_IPV6_IFADDR | RTMGRP_IPV4_IFADDR;
+    addr.nl_groups = groups;
 
     if (bind(sockFd, reinterpret_cast<struct sockaddr*>(&addr), sizeof(addr)) < 0) {
         QCC_LogError(ER_FAIL, ("NetworkChangeEventSocket(): Error binding to NETLINK_ROUTE socket: %s", strerror(errno)));
@@ -766,7 +784,7 @@ static SocketFd NetworkChangeEventSocket()
 
 SocketFd NetworkEventSocket()
 {
-    return NetworkChangeEventSocket();
+    return NetworkChangeEventSocket(RTMGRP_IPV6_IFADDR | RTMGRP_IPV4_IFADDR);
 }
 
 NetworkEventType NetworkEventReceive(qcc::SocketFd sockFd, NetworkEventSet& networkEvents)
@@ -780,6 +798,294 @@ NetworkEventType NetworkEventReceive(qcc::SocketFd sockFd, NetworkEventSet& netw
     return ret;
 }
 
+//
+// The table below is kept as a list of the same interface/address
+// combinations that IfConfig() returns, so that the entries a client gets
+// from the table look exactly like the ones it would get from a complete
+// IfConfig().  Notifications are applied to the entries of the one interface
+// they describe, and the changes are found by comparing the table before and
+// after a batch of notifications has been applied.
+//
+static bool SameEntry(const IfConfigEntry& a, const IfConfigEntry& b)
+{
+    return a.m_index == b.m_index && a.m_family == b.m_family && a.m_addr == b.m_addr &&
+           a.m_prefixlen == b.m_prefixlen && a.m_name == b.m_name && a.m_flags == b.m_flags && a.m_mtu == b.m_mtu;
+}
+
+//
+// Append the entries of <from> that have no identical entry in <to> onto <diff>.
+//
+static void DiffEntries(const std::vector<IfConfigEntry>& from, const std::vector<IfConfigEntry>& to, std::vector<IfConfigEntry>& diff)
+{
+    for (std::vector<IfConfigEntry>::const_iterator i = from.begin(); i != from.end(); ++i) {
+        bool found = false;
+        for (std::vector<IfConfigEntry>::const_iterator j = to.begin(); j != to.end(); ++j) {
+            if (SameEntry(*i, *j)) {
+                found = true;
+                break;
+            }
+        }
+        if (!found) {
+            diff.push_back(*i);
+        }
+    }
+}
+
+//
+// An interface that has no addresses is still described by a single entry
+// with no address, exactly as IfConfig() does it.
+//
+static void AddPlaceholder(std::vector<IfConfigEntry>& entries, const IfConfigEntry& link)
+{
+    IfConfigEntry entry;
+    entry.m_name = link.m_name;
+    entry.m_flags = link.m_flags;
+    entry.m_mtu = link.m_mtu;
+    entry.m_index = link.m_index;
+    entry.m_addr = qcc::String();
+    entry.m_family = QCC_AF_UNSPEC;
+    entry.m_prefixlen = 0;
+    entries.push_back(entry);
+}
+
+//
+// Apply one link or address notification to the table.  Returns false if the
+// notification cannot be applied, in which case the table has to be reloaded.
+//
+static bool ApplyNetworkEvent(std::vector<IfConfigEntry>& entries, struct nlmsghdr* nh)
+{
+    switch (nh->nlmsg_type) {
+    case RTM_NEWLINK:
+        {
+            IfEntry link;
+            ParseLink(nh, link);
+            bool found = false;
+            for (std::vector<IfConfigEntry>::iterator i = entries.begin(); i != entries.end(); ++i) {
+                if (i->m_index == link.m_index) {
+                    //
+                    // Notifications are not required to carry every
+                    // attribute, so keep what we know if one is missing.
+                    //
+                    if (!link.m_name.empty()) {
+                        i->m_name = link.m_name;
+                    }
+                    if (link.m_mtu) {
+                        i->m_mtu = link.m_mtu;
+                    }
+                    i->m_flags = TranslateFlags(link.m_flags);
+                    found = true;
+                }
+            }
+            if (!found) {
+                if (link.m_name.empty()) {
+                    return false;
+                }
+                IfConfigEntry entry;
+                entry.m_name = link.m_name;
+                entry.m_flags = TranslateFlags(link.m_flags);
+                entry.m_mtu = link.m_mtu;
+                entry.m_index = link.m_index;
+                AddPlaceholder(entries, entry);
+            }
+            return true;
+        }
+
+    case RTM_DELLINK:
+        {
+            IfEntry link;
+            ParseLink(nh, link);
+            for (std::vector<IfConfigEntry>::iterator i = entries.begin(); i != entries.end();) {
+                if (i->m_index == link.m_index) {
+                    i = entries.erase(i);
+                } else {
+                    ++i;
+                }
+            }
+            return true;
+        }
+
+    case RTM_NEWADDR:
+        {
+            AddrEntry addr;
+            ParseAddress(nh, addr);
+            if (addr.m_family != AF_INET && addr.m_family != AF_INET6) {
+                return true;
+            }
+            AddressFamily family = TranslateFamily(addr.m_family);
+            std::vector<IfConfigEntry>::iterator link = entries.end();
+            for (std::vector<IfConfigEntry>::iterator i = entries.begin(); i != entries.end(); ++i) {
+                if (i->m_index != addr.m_index) {
+                    continue;
+                }
+                if (i->m_family == family && i->m_addr == addr.m_addr) {
+                    i->m_prefixlen = addr.m_prefixlen;
+                    return true;
+                }
+                link = i;
+            }
+            if (link == entries.end()) {
+                //
+                // We have not seen the link this address lives on yet.
+                //
+                return false;
+            }
+            IfConfigEntry entry = *link;
+            entry.m_addr = addr.m_addr;
+            entry.m_family = family;
+            entry.m_prefixlen = addr.m_prefixlen;
+            if (link->m_family == QCC_AF_UNSPEC) {
+                *link = entry;
+            } else {
+                entries.push_back(entry);
+            }
+            return true;
+        }
+
+    case RTM_DELADDR:
+        {
+            AddrEntry addr;
+            ParseAddress(nh, addr);
+            AddressFamily family = TranslateFamily(addr.m_family);
+            for (std::vector<IfConfigEntry>::iterator i = entries.begin(); i != entries.end(); ++i) {
+                if (i->m_index == addr.m_index && i->m_family == family && i->m_addr == addr.m_addr) {
+                    IfConfigEntry link = *i;
+                    entries.erase(i);
+                    for (std::vector<IfConfigEntry>::const_iterator j = entries.begin(); j != entries.end(); ++j) {
+                        if (j->m_index == link.m_index) {
+                            return true;
+                        }
+                    }
+                    AddPlaceholder(entries, link);
+                    return true;
+                }
+            }
+            return true;
+        }
+
+    default:
+        return true;
+    }
+}
+
+IfConfigTable::IfConfigTable() : m_sockFd(qcc::INVALID_SOCKET_FD)
+{
+}
+
+IfConfigTable::~IfConfigTable()
+{
+    Close();
+}
+
+QStatus IfConfigTable::Open()
+{
+    QCC_DbgPrintf(("IfConfigTable::Open()"));
+    Close();
+
+    //
+    // Subscribe before loading the table so that no change can fall between
+    // the two.  A notification for a change that the load already picked up
+    // leaves the table as it is.
+    //
+    m_sockFd = NetworkChangeEventSocket(RTMGRP_LINK | RTMGRP_IPV4_IFADDR | RTMGRP_IPV6_IFADDR);
+    if (m_sockFd == qcc::INVALID_SOCKET_FD) {
+        return ER_OS_ERROR;
+    }
+    QStatus status = IfConfig(m_entries);
+    if (status != ER_OK) {
+        Close();
+    }
+    return status;
+}
+
+void IfConfigTable::Close()
+{
+    if (m_sockFd != qcc::INVALID_SOCKET_FD) {
+        qcc::Close(m_sockFd);
+        m_sockFd = qcc::INVALID_SOCKET_FD;
+    }
+    m_entries.clear();
+}
+
+bool IfConfigTable::IsOpen() const
+{
+    return m_sockFd != qcc::INVALID_SOCKET_FD;
+}
+
+SocketFd IfConfigTable::GetSocketFd() const
+{
+    return m_sockFd;
+}
+
+NetworkEventType IfConfigTable::Update(NetworkEventSet& networkEvents, std::vector<IfConfigEntry>& added, std::vector<IfConfigEntry>& removed)
+{
+    if (m_sockFd == qcc::INVALID_SOCKET_FD) {
+        return QCC_RTM_IGNORED;
+    }
+
+    std::vector<IfConfigEntry> before = m_entries;
+    bool reload = false;
+
+    //
+    // Drain the pending notifications, but in batches of up to 100 datagrams
+    // so that a storm of notifications cannot starve the caller.  Anything
+    // left over keeps the socket readable.
+    //
+    const uint32_t BUFSIZE = 65536;
+    char* buffer = new char[BUFSIZE];
+    for (uint32_t count = 0; count < 100; ++count) {
+        ssize_t nBytes = recv(m_sockFd, buffer, BUFSIZE, 0);
+        if (nBytes < 0) {
+            if (errno == ENOBUFS) {
+                //
+                // The kernel dropped notifications because we did not keep
+                // up, so the table can no longer be trusted.
+                //
+                QCC_DbgPrintf(("IfConfigTable::Update(): Notifications lost, reloading"));
+                reload = true;
+                continue;
+            }
+            break;
+        }
+        uint32_t len = nBytes;
+        for (struct nlmsghdr* nh = (struct nlmsghdr*)buffer; NLMSG_OK(nh, len); nh = NLMSG_NEXT(nh, len)) {
+            if (!reload && !ApplyNetworkEvent(m_entries, nh)) {
+                reload = true;
+            }
+        }
+    }
+    delete[] buffer;
+
+    if (reload) {
+        std::vector<IfConfigEntry> entries;
+        if (IfConfig(entries) == ER_OK) {
+            m_entries.swap(entries);
+        }
+    }
+
+    DiffEntries(before, m_entries, removed);
+    DiffEntries(m_entries, before, added);
+
+    for (std::vector<IfConfigEntry>::const_iterator i = added.begin(); i != added.end(); ++i) {
+        if (i->m_family != QCC_AF_UNSPEC) {
+            networkEvents.insert(i->m_index << 2);
+        }
+    }
+
+    QCC_DbgPrintf(("IfConfigTable::Update(): %d entries added, %d entries removed", added.size(), removed.size()));
+    if (!added.empty()) {
+        return QCC_RTM_NEWADDR;
+    }
+    if (!removed.empty()) {
+        return QCC_RTM_DELADDR;
+    }
+    return QCC_RTM_IGNORED;
+}
+
+void IfConfigTable::GetEntries(std::vector<IfConfigEntry>& entries) const
+{
+    entries = m_entries;
+}
+
 } // namespace ajn
 
 #endif // !defined(QCC_OS_DARWIN)
@@ -47,6 +47,7 @@
 #include <errno.h>
 #include <fcntl.h>
 #include <netdb.h>
+#include <poll.h>
 #include <stddef.h>
 #include <string.h>
 #include <sys/socket.h>
@@ -225,11 +226,6 @@ QStatus Connect(SocketFd sockfd, const IPAddress& remoteAddr, uint16_t remotePor
         return status;
     }
 
-    fd_set wfdset;
-    /* This should always be called after a socket is created */
-    FD_ZERO(&wfdset);
-    FD_SET(sockfd, &wfdset);
-
     /* Set the socket to non-blocking since by default our socket is blocking */
     int flags = fcntl(sockfd, F_GETFL, 0);
     ret = fcntl(sockfd, F_SETFL, flags | O_NONBLOCK);
@@ -242,16 +238,17 @@ QStatus Connect(SocketFd sockfd, const IPAddress& remoteAddr, uint16_t remotePor
     ret = connect(static_cast<int>(sockfd), reinterpret_cast<struct sockaddr*>(&addr), addrLen);
     if (ret == -1) {
         if ((errno == EINPROGRESS) || (errno == EALREADY)) {
-            int selectRet;
+            int pollRet;
             int so_error;
             socklen_t slen = sizeof(so_error);
-            struct timeval tv;
-            tv.tv_sec = CONNECT_TIMEOUT;
-            tv.tv_usec = 0;
-            /* Call select to wait for the connect to take place */
-            selectRet = select(sockfd + 1, NULL, &wfdset, NULL, &tv);
-            /* select will return 1 when it indicates that the socket is writable */
-            if (selectRet == 1) {
+            struct pollfd pfd;
+            pfd.fd = sockfd;
+            pfd.events = POLLOUT;
+            pfd.revents = 0;
+            /* Call poll to wait for the connect to take place, unlike select it works for any descriptor number */
+            pollRet = poll(&pfd, 1, CONNECT_TIMEOUT * 1000);
+            /* poll will return 1 when it indicates that the socket is writable */
+            if (pollRet == 1) {
                 getsockopt(sockfd, SOL_SOCKET, SO_ERROR, &so_error, &slen);
                 if (so_error == 0) {
                     status = ER_OK;
@@ -966,7 +963,7 @@ QStatus SetLinger(SocketFd sockfd, bool onoff, uint32_t linger)
 QStatus SetNagle(SocketFd sockfd, bool useNagle)
 {
     QStatus status = ER_OK;
-    int arg = useNagle ? 1 : -0;
+    int arg = useNagle ? 0 : 1;
     int r = setsockopt(sockfd, IPPROTO_TCP, TCP_NODELAY, (void*)&arg, sizeof(int));
     if (r != 0) {
         status = ER_OS_ERROR;
@@ -975,6 +972,24 @@ QStatus SetNagle(SocketFd sockfd, bool useNagle)
     return status;
 }
 
+QStatus SetCork(SocketFd sockfd, bool cork)
+{
+#if defined(TCP_CORK)
+    QStatus status = ER_OK;
+    int arg = cork ? 1 : 0;
+    int r = setsockopt(sockfd, IPPROTO_TCP, TCP_CORK, (void*)&arg, sizeof(int));
+    if (r != 0) {
+        status = ER_OS_ERROR;
+        QCC_LogError(status, ("Setting TCP_CORK failed: (%d) %s", errno, strerror(errno)));
+    }
+    return status;
+#else
+    QCC_UNUSED(sockfd);
+    QCC_UNUSED(cork);
+    return ER_NOT_IMPLEMENTED;
+#endif
+}
+
 /*
  * Some systems do not define SO_REUSEPORT (which is a BSD-ism from the first
  * days of multicast support).  In this case they special case SO_REUSEADDR in
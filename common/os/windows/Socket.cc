@@ -974,7 +974,7 @@ QStatus SetLinger(SocketFd sockfd, bool onoff, uint32_t linger)
 QStatus SetNagle(SocketFd sockfd, bool useNagle)
 {
     QStatus status = ER_OK;
-    int arg = useNagle ? 1 : -0;
+    int arg = useNagle ? 0 : 1;
     int r = setsockopt(sockfd, IPPROTO_TCP, TCP_NODELAY, (char*)&arg, sizeof(int));
     if (r != 0) {
         status = ER_OS_ERROR;
@@ -983,6 +983,14 @@ QStatus SetNagle(SocketFd sockfd, bool useNagle)
     return status;
 }
 
+QStatus SetCork(SocketFd sockfd, bool cork)
+{
+    /* Winsock has no TCP_CORK */
+    QCC_UNUSED(sockfd);
+    QCC_UNUSED(cork);
+    return ER_NOT_IMPLEMENTED;
+}
+
 QStatus SetReuseAddress(SocketFd sockfd, bool reuse)
 {
     QStatus status = ER_OK;
@@ -728,6 +728,214 @@ bool Crypto_ASN1::DecodeLen(const uint8_t*& p, const uint8_t* eod, size_t& l)
     return l <= (uintptr_t)eod - (uintptr_t)p;
 }
 
+QStatus Crypto_ASN1::Reader::PeekElement(uint8_t tag, View& value, const uint8_t*& next) const
+{
+    if (asn >= eod) {
+        return ER_FAIL;
+    }
+    const uint8_t* p = asn;
+    uint8_t t = *p++;
+    if (ASN_CONTEXT_SPECIFIC != (t & ASN_CONTEXT_SPECIFIC)) {
+        t &= 0x1F;
+    }
+    size_t len;
+    if ((t != tag) || !DecodeLen(p, eod, len)) {
+        return ER_FAIL;
+    }
+    value = View(p, len);
+    next = p + len;
+    return ER_OK;
+}
+
+QStatus Crypto_ASN1::Reader::ReadSequence(Reader& contents, View* raw)
+{
+    View v;
+    const uint8_t* next;
+    /* Constructed types must have content, the same as Decode() */
+    if ((PeekElement(ASN_SEQ, v, next) != ER_OK) || v.empty()) {
+        return ER_FAIL;
+    }
+    contents = Reader(v);
+    contents.nested = true;
+    if (raw) {
+        *raw = View(asn, next - asn);
+    }
+    asn = next;
+    return ER_OK;
+}
+
+QStatus Crypto_ASN1::Reader::ReadSet(Reader& contents)
+{
+    View v;
+    const uint8_t* next;
+    if ((PeekElement(ASN_SET_OF, v, next) != ER_OK) || v.empty()) {
+        return ER_FAIL;
+    }
+    contents = Reader(v);
+    contents.nested = true;
+    asn = next;
+    return ER_OK;
+}
+
+QStatus Crypto_ASN1::Reader::ReadContext(uint32_t tagNum, Reader& contents)
+{
+    if ((asn >= eod) || (ASN_CONSTRUCTED_ENCODING != (*asn & ASN_CONSTRUCTED_ENCODING))) {
+        return ER_FAIL;
+    }
+    View v;
+    if (ReadContextValue(tagNum, v) != ER_OK) {
+        return ER_FAIL;
+    }
+    contents = Reader(v);
+    contents.nested = true;
+    return ER_OK;
+}
+
+QStatus Crypto_ASN1::Reader::ReadContextValue(uint32_t tagNum, View& value)
+{
+    if ((tagNum >= 32) || (asn >= eod)) {
+        return ER_FAIL;
+    }
+    /* Only the context specific bit and the tag number are checked, the same as Decode() */
+    uint8_t tag = *asn;
+    if ((ASN_CONTEXT_SPECIFIC != (tag & ASN_CONTEXT_SPECIFIC)) || ((uint8_t) (tag & 0x1F) != tagNum)) {
+        return ER_FAIL;
+    }
+    View v;
+    const uint8_t* next;
+    if ((PeekElement(tag, v, next) != ER_OK) ||
+        ((ASN_CONSTRUCTED_ENCODING == (tag & ASN_CONSTRUCTED_ENCODING)) && v.empty())) {
+        return ER_FAIL;
+    }
+    value = v;
+    asn = next;
+    return ER_OK;
+}
+
+QStatus Crypto_ASN1::Reader::ReadInteger(uint32_t& v)
+{
+    View i;
+    const uint8_t* next;
+    if ((PeekElement(ASN_INTEGER, i, next) != ER_OK) || (i.len > 5) || (i.len < 1)) {
+        return ER_FAIL;
+    }
+    v = 0;
+    for (size_t n = 0; n < i.len; ++n) {
+        v = (v << 8) + i.data[n];
+    }
+    asn = next;
+    return ER_OK;
+}
+
+QStatus Crypto_ASN1::Reader::ReadInteger(View& v)
+{
+    View i;
+    const uint8_t* next;
+    if ((PeekElement(ASN_INTEGER, i, next) != ER_OK) || (i.len < 1)) {
+        return ER_FAIL;
+    }
+    // Supress leading zero
+    if (*i.data == 0) {
+        ++i.data;
+        --i.len;
+    }
+    v = i;
+    asn = next;
+    return ER_OK;
+}
+
+QStatus Crypto_ASN1::Reader::ReadOID(qcc::String& oid)
+{
+    View v;
+    const uint8_t* next;
+    if (PeekElement(ASN_OID, v, next) != ER_OK) {
+        return ER_FAIL;
+    }
+    oid = DecodeOID(v.data, v.len);
+    asn = next;
+    return ER_OK;
+}
+
+QStatus Crypto_ASN1::Reader::ReadOctets(View& v)
+{
+    return ReadPrimitive(ASN_OCTETS, v);
+}
+
+QStatus Crypto_ASN1::Reader::ReadBits(View& v, size_t& bitLen)
+{
+    View b;
+    const uint8_t* next;
+    if ((PeekElement(ASN_BITS, b, next) != ER_OK) || (b.len < 2)) {
+        return ER_FAIL;
+    }
+    size_t unusedBits = *b.data;
+    if (unusedBits > 7) {
+        return ER_FAIL;
+    }
+    v = View(b.data + 1, b.len - 1);
+    bitLen = v.len * 8 - unusedBits;
+    asn = next;
+    return ER_OK;
+}
+
+QStatus Crypto_ASN1::Reader::ReadBoolean(uint32_t& v)
+{
+    View b;
+    const uint8_t* next;
+    if ((PeekElement(ASN_BOOLEAN, b, next) != ER_OK) || (b.len != 1)) {
+        return ER_FAIL;
+    }
+    v = *b.data;
+    asn = next;
+    return ER_OK;
+}
+
+QStatus Crypto_ASN1::Reader::ReadUTF8(View& v)
+{
+    return ReadPrimitive(ASN_UTF8, v);
+}
+
+QStatus Crypto_ASN1::Reader::ReadTime(View& v)
+{
+    if (ReadPrimitive(ASN_UTC_TIME, v) == ER_OK) {
+        return ER_OK;
+    }
+    return ReadPrimitive(ASN_GEN_TIME, v);
+}
+
+QStatus Crypto_ASN1::Reader::ReadPrimitive(uint8_t tag, View& v)
+{
+    const uint8_t* next;
+    if (PeekElement(tag, v, next) != ER_OK) {
+        return ER_FAIL;
+    }
+    asn = next;
+    return ER_OK;
+}
+
+QStatus Crypto_ASN1::Reader::Skip()
+{
+    if (asn >= eod) {
+        return ER_FAIL;
+    }
+    const uint8_t* p = asn + 1;
+    size_t len;
+    if (!DecodeLen(p, eod, len)) {
+        return ER_FAIL;
+    }
+    asn = p + len;
+    return ER_OK;
+}
+
+QStatus Crypto_ASN1::Reader::ExpectEnd() const
+{
+    if (AtEnd()) {
+        return ER_OK;
+    }
+    /* Decode() reports unexpected elements as a syntax error unless they are nested */
+    return nested ? ER_FAIL : ER_BAD_ARG_1;
+}
+
 void Crypto_ASN1::EncodeLen(qcc::String& asn, size_t len)
 {
     if (len < 128) {
@@ -39,10 +39,22 @@
 
 using namespace qcc;
 
-uint32_t BigNum::zero_digit = 0;
+typedef BigNum::digit_t digit_t;
+typedef BigNum::ddigit_t ddigit_t;
+
+static const size_t DIGIT_BITS = BigNum::digit_bits;
+
+BigNum::digit_t BigNum::zero_digit = 0;
 
 const BigNum BigNum::zero;
 
+/*
+ * Operands with at least this many digits are multiplied using the Karatsuba algorithm, smaller
+ * operands use schoolbook multiplication. The crossover was measured with the benchmarks in
+ * alljoyn_core/test/bignum.cc.
+ */
+#define KARATSUBA_THRESHOLD (2048 / DIGIT_BITS)
+
 #define USE_DEBRUIJN_POS
 
 static inline uint32_t log2(uint32_t n)
@@ -92,13 +104,62 @@ static inline uint32_t log2(uint32_t n)
 #endif
 }
 
+static inline uint32_t log2(uint64_t n)
+{
+    uint32_t hi = (uint32_t)(n >> 32);
+    return hi ? 32 + log2(hi) : log2((uint32_t)n);
+}
+
+/*
+ * Scratch space for the digit arrays used by a single operation. Exponentiation and Karatsuba
+ * multiplication need many short-lived temporaries; carving them all from one allocation avoids a
+ * malloc/free pair per intermediate product. The memory is cleared when the arena is released
+ * because the temporaries may hold secret values.
+ */
+class DigitArena {
+  public:
+
+    DigitArena(size_t size) : size(size), used(0)
+    {
+        buffer = (digit_t*)malloc(size * sizeof(digit_t));
+        QCC_ASSERT(buffer);
+        if (NULL == buffer) {
+            abort();
+        }
+    }
+
+    ~DigitArena()
+    {
+        ClearMemory(buffer, size * sizeof(digit_t));
+        free(buffer);
+    }
+
+    // Returns the next len digits from the arena
+    digit_t* Alloc(size_t len)
+    {
+        QCC_ASSERT((used + len) <= size);
+        digit_t* p = buffer + used;
+        used += len;
+        return p;
+    }
+
+  private:
+
+    DigitArena(const DigitArena& other);
+    DigitArena& operator=(const DigitArena& other);
+
+    digit_t* buffer;
+    size_t size;
+    size_t used;
+};
+
 // Type for storage
 class BigNum::Storage {
   public:
 
-    static Storage* New(size_t sz, uint32_t* val = NULL, size_t extra = 4)
+    static Storage* New(size_t sz, digit_t* val = NULL, size_t extra = 4)
     {
-        size_t mallocSz = sizeof(Storage) + (sz + extra) * sizeof(uint32_t);
+        size_t mallocSz = sizeof(Storage) + (sz + extra) * sizeof(digit_t);
         uint8_t* p = (uint8_t*)malloc(mallocSz);
         QCC_ASSERT(p);
         if (NULL == p) {
@@ -107,16 +168,16 @@ class BigNum::Storage {
             abort();
         }
         Storage* s = new (p)Storage();
-        s->buffer = reinterpret_cast<uint32_t*>(p + sizeof(Storage));
+        s->buffer = reinterpret_cast<digit_t*>(p + sizeof(Storage));
         s->size = sz + extra;
         s->refCount = 1;
         if (val) {
-            memcpy(s->buffer, val, sizeof(uint32_t) * sz);
+            memcpy(s->buffer, val, sizeof(digit_t) * sz);
             if (extra) {
-                memset(s->buffer + sz, 0, sizeof(uint32_t) * extra);
+                memset(s->buffer + sz, 0, sizeof(digit_t) * extra);
             }
         } else {
-            memset(s->buffer, 0, sizeof(uint32_t) * s->size);
+            memset(s->buffer, 0, sizeof(digit_t) * s->size);
         }
         return s;
     }
@@ -126,10 +187,10 @@ class BigNum::Storage {
     bool DecRef() { return --refCount == 0; }
 
     ~Storage() {
-        ClearMemory(buffer, size);
+        ClearMemory(buffer, size * sizeof(digit_t));
     }
 
-    uint32_t* buffer;
+    digit_t* buffer;
     size_t size;
     uint32_t refCount;
 
@@ -162,7 +223,8 @@ BigNum::BigNum(uint32_t v)
         storage = NULL;
         digits = zero.digits;
     } else {
-        storage = Storage::New(1, (uint32_t*)&v);
+        digit_t d = v;
+        storage = Storage::New(1, &d);
         digits = storage->buffer;
     }
 }
@@ -224,7 +286,7 @@ BigNum& BigNum::zero_ext(size_t size)
         if (storage) {
             QCC_ASSERT(digits == storage->buffer);
             if (size <= storage->size) {
-                memset(digits + length, 0, (size - length) * sizeof(uint32_t));
+                memset(digits + length, 0, (size - length) * sizeof(digit_t));
             } else {
                 Storage* s = Storage::New(length, digits, size - length);
                 if (storage->DecRef()) {
@@ -256,7 +318,7 @@ BigNum& BigNum::reset(size_t len, bool isNegative, bool clear)
     }
     if (storage) {
         if (clear) {
-            memset(storage->buffer, 0, len * sizeof(uint32_t));
+            memset(storage->buffer, 0, len * sizeof(digit_t));
         }
     } else {
         storage = Storage::New(len);
@@ -296,7 +358,7 @@ bool BigNum::set_hex(const qcc::String& number)
         ++p;
         --len;
     }
-    length = (len + 7) / 8;
+    length = (len + (DIGIT_BITS / 4) - 1) / (DIGIT_BITS / 4);
     // Special case for 0
     if (length == 0) {
         *this = zero;
@@ -305,17 +367,17 @@ bool BigNum::set_hex(const qcc::String& number)
     storage = Storage::New(length);
     digits = storage->buffer;
     // Build in little-endian order
-    uint32_t* v = digits;
+    digit_t* v = digits;
     p += len - 1;
     while (len > 0) {
-        uint32_t n = 0;
-        for (int i = 0; (i < 32) && len; i += 4, --len) {
+        digit_t n = 0;
+        for (size_t i = 0; (i < DIGIT_BITS) && len; i += 4, --len) {
             if (*p >= '0' && *p <= '9') {
-                n |= (*p - '0') << i;
+                n |= (digit_t)(*p - '0') << i;
             } else if (*p >= 'a' && *p <= 'f') {
-                n |=  (*p + 10 - 'a') << i;
+                n |= (digit_t)(*p + 10 - 'a') << i;
             } else if (*p >= 'A' && *p <= 'F') {
-                n |=  (*p + 10 - 'A') << i;
+                n |= (digit_t)(*p + 10 - 'A') << i;
             } else {
                 storage->Storage::~Storage();
                 free(storage);
@@ -338,16 +400,16 @@ void BigNum::set_bytes(const uint8_t* data, size_t len)
         free(storage);
         storage = NULL;
     }
-    length = (len + 3) / 4;
+    length = (len + sizeof(digit_t) - 1) / sizeof(digit_t);
     storage = Storage::New(length);
     digits = storage->buffer;
     neg = false;
-    uint32_t* v = digits;
+    digit_t* v = digits;
     const uint8_t* p = data + len;
     while (len) {
-        uint32_t n = 0;
-        for (int i = 0; (i < 32) && len; i += 8, --len) {
-            n |= *(--p) << i;
+        digit_t n = 0;
+        for (size_t i = 0; (i < DIGIT_BITS) && len; i += 8, --len) {
+            n |= (digit_t)*(--p) << i;
         }
         *v++ = n;
     }
@@ -356,11 +418,11 @@ void BigNum::set_bytes(const uint8_t* data, size_t len)
 void BigNum::gen_rand(size_t len)
 {
     // Allocate enough room
-    reset((3 + len) / sizeof(uint32_t), false, false);
-    Crypto_GetRandomBytes((uint8_t*)digits, length * sizeof(uint32_t));
+    reset((sizeof(digit_t) - 1 + len) / sizeof(digit_t), false, false);
+    Crypto_GetRandomBytes((uint8_t*)digits, length * sizeof(digit_t));
     // Mask of excess bytes
-    size_t excess = length * sizeof(uint32_t) - len;
-    digits[length - 1] &= (0xFFFFFFFF >> (8 * excess));
+    size_t excess = length * sizeof(digit_t) - len;
+    digits[length - 1] &= (~(digit_t)0 >> (8 * excess));
 }
 
 size_t BigNum::get_bytes(uint8_t* buffer, size_t len, bool pad) const
@@ -375,11 +437,11 @@ size_t BigNum::get_bytes(uint8_t* buffer, size_t len, bool pad) const
         p += padLen;
         len -= padLen;
     }
-    const uint32_t* digit = &digits[length - 1];
-    for (size_t i = 0; i < length; ++i) {
-        uint32_t d = *digit--;
-        for (size_t j = 0; j < 4; ++j) {
-            if ((nZ |= (*p = (uint8_t)(d >> 24)))) {
+    const digit_t* digit = &digits[length - 1];
+    for (size_t i = 0; (i < length) && len; ++i) {
+        digit_t d = *digit--;
+        for (size_t j = 0; j < sizeof(digit_t); ++j) {
+            if ((nZ |= (*p = (uint8_t)(d >> (DIGIT_BITS - 8))))) {
                 ++p;
                 --len;
             }
@@ -407,9 +469,12 @@ qcc::String BigNum::get_hex(bool toLower) const
     const char* fmt = toLower ? "%08x" : "%08X";
 
     for (size_t n = length; n > 0; --n) {
-        char i[9];
-        snprintf(i, 9, fmt, digits[n - 1]);
-        str += i;
+        // Digits are rendered 32 bits at a time
+        for (size_t h = sizeof(digit_t) / 4; h > 0; --h) {
+            char i[9];
+            snprintf(i, 9, fmt, (uint32_t)(digits[n - 1] >> (32 * (h - 1))));
+            str += i;
+        }
     }
     // Trim leading zeroes and set sign
     size_t nz = str.find_first_not_of("0", 0);
@@ -433,8 +498,8 @@ BigNum BigNum::operator+(const BigNum& n) const
     if (neg) {
         return n - (-*this);
     }
-    const uint32_t* x;
-    const uint32_t* y;
+    const digit_t* x;
+    const digit_t* y;
     size_t xLen, yLen, rLen;
     if (length >= n.length) {
         xLen = length;
@@ -448,25 +513,25 @@ BigNum BigNum::operator+(const BigNum& n) const
         y = digits;
     }
     BigNum result(xLen + 1, false);
-    uint32_t* r = result.digits;
+    digit_t* r = result.digits;
     rLen = 0;
-    uint64_t carry = 0;
+    ddigit_t carry = 0;
     // Loop while we have both x and y digits
     while (rLen < yLen) {
-        uint64_t num = (uint64_t)*x++ + (uint64_t)*y++ + carry;
-        carry = num >> 32;
-        *r++ = (uint32_t)num;
+        ddigit_t num = (ddigit_t)*x++ + (ddigit_t)*y++ + carry;
+        carry = num >> DIGIT_BITS;
+        *r++ = (digit_t)num;
         ++rLen;
     }
     // Continue propogating carry
     while (rLen < xLen) {
-        uint64_t num = (uint64_t)*x++ + carry;
-        carry = num >> 32;
-        *r++ = (uint32_t)num;
+        ddigit_t num = (ddigit_t)*x++ + carry;
+        carry = num >> DIGIT_BITS;
+        *r++ = (digit_t)num;
         ++rLen;
     }
     if (carry) {
-        *r = carry;
+        *r = (digit_t)carry;
         ++rLen;
     }
     result.length = rLen;
@@ -489,9 +554,10 @@ BigNum BigNum::operator+(uint32_t i) const
     if (i == 0) {
         return *this;
     } else {
+        digit_t d = i;
         BigNum n;
         n.length = 1;
-        n.digits = &i;
+        n.digits = &d;
         return *this + n;
     }
 }
@@ -499,9 +565,10 @@ BigNum BigNum::operator+(uint32_t i) const
 // Add an integer to an BigNum
 BigNum& BigNum::operator+=(uint32_t i)
 {
+    digit_t d = i;
     BigNum n;
     n.length = 1;
-    n.digits = &i;
+    n.digits = &d;
     return *this += n;
 }
 
@@ -514,8 +581,8 @@ BigNum BigNum::operator-(const BigNum& n) const
     if (neg) {
         return -(n - *this);
     }
-    const uint32_t* x;
-    const uint32_t* y;
+    const digit_t* x;
+    const digit_t* y;
     bool isNegative;
     size_t xLen, yLen;
     // Subtract smaller value from larger value
@@ -550,21 +617,21 @@ BigNum BigNum::operator-(const BigNum& n) const
         yLen = xLen;
     }
     BigNum result(xLen, isNegative);
-    uint32_t* r = result.digits;
+    digit_t* r = result.digits;
     size_t rLen = 0;
-    uint64_t borrow = 0;
+    ddigit_t borrow = 0;
     // Loop while we have both x and y values
     while (rLen < yLen) {
-        uint64_t num = (uint64_t)*x++ - (uint64_t)*y++ - borrow;
-        borrow = num >> 63;
-        *r++ = (uint32_t)num;
+        ddigit_t num = (ddigit_t)*x++ - (ddigit_t)*y++ - borrow;
+        borrow = num >> (2 * DIGIT_BITS - 1);
+        *r++ = (digit_t)num;
         ++rLen;
     }
     // Continue propogating borrow
     while (rLen < xLen) {
-        uint64_t num = (uint64_t)*x++ - borrow;
-        borrow = num >> 63;
-        *r++ = (uint32_t)num;
+        ddigit_t num = (ddigit_t)*x++ - borrow;
+        borrow = num >> (2 * DIGIT_BITS - 1);
+        *r++ = (digit_t)num;
         ++rLen;
     }
     result.length = rLen;
@@ -598,10 +665,11 @@ BigNum BigNum::operator-(uint32_t i) const
     if (i == 0) {
         return *this;
     } else {
+        digit_t d = i;
         BigNum n;
         n.length = 1;
         n.neg = false;
-        n.digits = &i;
+        n.digits = &d;
         return *this - n;
     }
 }
@@ -610,10 +678,11 @@ BigNum BigNum::operator-(uint32_t i) const
 BigNum& BigNum::operator-=(uint32_t i)
 {
     QCC_ASSERT(!haslz());
+    digit_t d = i;
     BigNum n;
     n.length = 1;
     n.neg = false;
-    n.digits = &i;
+    n.digits = &d;
     if (this->neg) {
         return *this = *this - n;
     } else {
@@ -621,22 +690,119 @@ BigNum& BigNum::operator-=(uint32_t i)
     }
 }
 
+// r[0..aLen+bLen) = a * b using schoolbook multiplication
+static void school_mul(digit_t* r, const digit_t* a, size_t aLen, const digit_t* b, size_t bLen)
+{
+    memset(r, 0, (aLen + bLen) * sizeof(digit_t));
+    for (size_t i = 0; i < aLen; ++i, ++r) {
+        ddigit_t x = a[i];
+        const digit_t* y = b;
+        digit_t* s = r;
+        ddigit_t carry = 0;
+        for (size_t j = 0; j < bLen; ++j) {
+            ddigit_t p = x * (ddigit_t)*y++ + (ddigit_t)*s + carry;
+            *s++ = (digit_t)p;
+            carry = p >> DIGIT_BITS;
+        }
+        *s = (digit_t)carry;
+    }
+}
+
+// r[0..aLen) = a + b where aLen >= bLen, returns the carry out
+static digit_t add_digits(digit_t* r, const digit_t* a, size_t aLen, const digit_t* b, size_t bLen)
+{
+    ddigit_t carry = 0;
+    for (size_t i = 0; i < aLen; ++i) {
+        ddigit_t num = (ddigit_t)a[i] + carry;
+        if (i < bLen) {
+            num += b[i];
+        }
+        r[i] = (digit_t)num;
+        carry = num >> DIGIT_BITS;
+    }
+    return (digit_t)carry;
+}
+
+// a[0..aLen) -= b where aLen >= bLen, returns the borrow out
+static digit_t sub_digits(digit_t* a, size_t aLen, const digit_t* b, size_t bLen)
+{
+    ddigit_t borrow = 0;
+    for (size_t i = 0; i < aLen; ++i) {
+        ddigit_t num = (ddigit_t)a[i] - borrow;
+        if (i < bLen) {
+            num -= b[i];
+        } else if (!borrow) {
+            break;
+        }
+        a[i] = (digit_t)num;
+        borrow = num >> (2 * DIGIT_BITS - 1);
+    }
+    return (digit_t)borrow;
+}
+
+// Number of scratch digits needed by karatsuba_mul() for n digit operands
+static size_t karatsuba_scratch(size_t n)
+{
+    if (n < KARATSUBA_THRESHOLD) {
+        return 0;
+    }
+    size_t l = (n + 1) / 2;
+    return 4 * (l + 1) + karatsuba_scratch(l + 1);
+}
+
+/*
+ * r[0..2n) = a * b where a and b are both n digits long. The operands are split into high and
+ * low halves and the product is assembled from three half-size products:
+ *
+ *     z0 = a0 * b0, z2 = a1 * b1, z1 = (a0 + a1) * (b0 + b1) - z0 - z2
+ *
+ * The scratch space must be at least karatsuba_scratch(n) digits.
+ */
+static void karatsuba_mul(digit_t* r, const digit_t* a, const digit_t* b, size_t n, digit_t* scratch)
+{
+    if (n < KARATSUBA_THRESHOLD) {
+        school_mul(r, a, n, b, n);
+        return;
+    }
+    const size_t l = (n + 1) / 2;
+    const size_t h = n - l;
+
+    digit_t* sa = scratch;
+    digit_t* sb = sa + l + 1;
+    digit_t* z1 = sb + l + 1;
+    digit_t* next = z1 + 2 * (l + 1);
+
+    sa[l] = add_digits(sa, a, l, a + l, h);
+    sb[l] = add_digits(sb, b, l, b + l, h);
+
+    karatsuba_mul(r, a, b, l, next);
+    karatsuba_mul(r + 2 * l, a + l, b + l, h, next);
+    karatsuba_mul(z1, sa, sb, l + 1, next);
+
+    sub_digits(z1, 2 * (l + 1), r, 2 * l);
+    sub_digits(z1, 2 * (l + 1), r + 2 * l, 2 * h);
+
+    // Any digits of z1 beyond the end of the product are known to be zero
+    size_t z1Len = std::min(2 * (l + 1), 2 * n - l);
+    add_digits(r + l, r + l, 2 * n - l, z1, z1Len);
+}
+
 // multiple-precision multiplication by an integer
-BigNum & AJ_CALL BigNum::mul(BigNum& result, const BigNum& a, uint32_t b, bool bneg)
+BigNum & AJ_CALL BigNum::mul(BigNum& result, const BigNum& a, digit_t b, bool bneg)
 {
     QCC_ASSERT(!result.storage || (result.storage != a.storage));
     if (b > 2) {
         result.reset(a.length + 1, a.neg ^ bneg);
         // single-precision multiplication
-        uint32_t* r = result.digits;
-        const uint32_t* v = a.digits;
-        uint64_t carry = 0;
+        digit_t* r = result.digits;
+        const digit_t* v = a.digits;
+        ddigit_t carry = 0;
         for (size_t i = 0; i < a.length; ++i) {
-            uint64_t x = (uint64_t)(*v++) * b + carry;
-            *r++ = (uint32_t)x;
-            carry = x >> 32;
+            ddigit_t x = (ddigit_t)(*v++) * b + carry;
+            *r++ = (digit_t)x;
+            carry = x >> DIGIT_BITS;
         }
-        *r = (uint32_t)carry;
+        *r = (digit_t)carry;
     } else if (b == 1) {
         result = a.clone();
         result.neg = a.neg ^ bneg;
@@ -661,20 +827,18 @@ BigNum& BigNum::mul(BigNum& result, const BigNum& a, const BigNum& b)
     if (a.length == 1) {
         return mul(result, b, a.digits[0], a.neg);
     }
-    result.reset(a.length + b.length, a.neg ^ b.neg);
-    // multiple-precision multiplication
-    uint32_t* r = result.digits;
-    for (size_t i = 0; i < a.length; ++i, ++r) {
-        uint64_t x = a.digits[i];
-        const uint32_t* y = b.digits;
-        uint32_t* s = r;
-        uint64_t carry = 0;
-        for (size_t j = 0; j < b.length; ++j) {
-            uint64_t p = x * (uint64_t)*y++ + (uint64_t)*s + carry;
-            *s++ = (uint32_t)p;
-            carry = p >> 32;
-        }
-        *s = (uint32_t)carry;
+    if ((a.length >= KARATSUBA_THRESHOLD) && ((2 * a.length) > b.length)) {
+        // Operands are large and of similar length, pad the shorter one for Karatsuba
+        size_t n = b.length;
+        DigitArena arena(n + karatsuba_scratch(n));
+        digit_t* x = arena.Alloc(n);
+        memcpy(x, a.digits, a.length * sizeof(digit_t));
+        memset(x + a.length, 0, (n - a.length) * sizeof(digit_t));
+        result.reset(2 * n, a.neg ^ b.neg, false);
+        karatsuba_mul(result.digits, x, b.digits, n, arena.Alloc(karatsuba_scratch(n)));
+    } else {
+        result.reset(a.length + b.length, a.neg ^ b.neg, false);
+        school_mul(result.digits, a.digits, a.length, b.digits, b.length);
     }
     return strip_lz(result);
 }
@@ -720,45 +884,46 @@ BigNum BigNum::div(const BigNum& divisor, BigNum& rem) const
 
     // Special case single digit divisor
     if (t == 0) {
-        uint32_t Y = y.digits[0];
-        uint64_t carry = 0;
+        digit_t Y = y.digits[0];
+        ddigit_t carry = 0;
         q.length = n + 1;
         do {
-            uint64_t X = (uint64_t)x.digits[n] + (carry << 32);
-            uint64_t digit = X / Y;
+            ddigit_t X = (ddigit_t)x.digits[n] + (carry << DIGIT_BITS);
+            ddigit_t digit = X / Y;
             carry = X - digit * Y;
-            q.digits[n] = (uint32_t)digit;
+            q.digits[n] = (digit_t)digit;
         } while (n--);
-        rem = (uint32_t)carry;
+        rem.reset(1);
+        rem.digits[0] = (digit_t)carry;
         // Remainder is negative if dividend is negative
         rem.neg = neg && (rem != 0);
         return strip_lz(q);
     }
     // Special case small number of digits
     if (n < 2) {
-        BigNum r(2);
-        uint64_t X = x.digits[0];
-        uint64_t Y = y.digits[0];
+        BigNum r(2, false);
+        ddigit_t X = x.digits[0];
+        ddigit_t Y = y.digits[0];
         if (n == 1) {
-            X += ((uint64_t)x.digits[1] << 32);
+            X += ((ddigit_t)x.digits[1] << DIGIT_BITS);
         }
         if (t == 1) {
-            Y += ((uint64_t)y.digits[1] << 32);
+            Y += ((ddigit_t)y.digits[1] << DIGIT_BITS);
         }
-        uint64_t Q = X / Y;
-        uint64_t R = X - Y * Q;
-        q.digits[0] = (uint32_t)Q;
+        ddigit_t Q = X / Y;
+        ddigit_t R = X - Y * Q;
+        q.digits[0] = (digit_t)Q;
         q.length = 1;
-        Q >>= 32;
+        Q >>= DIGIT_BITS;
         if (Q) {
-            q.digits[1] = (uint32_t)Q;
+            q.digits[1] = (digit_t)Q;
             ++q.length;
         }
-        r.digits[0] = (uint32_t)R;
+        r.digits[0] = (digit_t)R;
         r.length = 1;
-        R >>= 32;
+        R >>= DIGIT_BITS;
         if (R) {
-            r.digits[1] = (uint32_t)R;
+            r.digits[1] = (digit_t)R;
             ++r.length;
         }
         rem = r;
@@ -770,8 +935,8 @@ BigNum BigNum::div(const BigNum& divisor, BigNum& rem) const
     // Algorithm operates in-place so we need to operate on a clone
     x = x.clone();
 
-    // Normalize divisor. In this case means left-shifting so the most significant digit of divisor is >= 2^31
-    uint32_t norm = 31 - log2(y.digits[t]);
+    // Normalize divisor. In this case means left-shifting so the most significant bit of the divisor is set
+    uint32_t norm = (uint32_t)(DIGIT_BITS - 1) - log2(y.digits[t]);
     if (norm) {
         x <<= norm;
         y <<= norm;
@@ -805,18 +970,18 @@ BigNum BigNum::div(const BigNum& divisor, BigNum& rem) const
     BigNum prod;
 
     // most significant digit of y
-    const uint32_t ymsd = y.digits[t];
+    const digit_t ymsd = y.digits[t];
 
     for (size_t i = n; i > t; --i) {
         // d tracks the quotient digit index == (i - t - 1)
         --d;
-        uint32_t qdigit;
+        digit_t qdigit;
         // Estimate quotient digit
         if (x.digits[i] == ymsd) {
-            qdigit = 0xFFFFFFFF;
+            qdigit = ~(digit_t)0;
         } else {
-            uint64_t z = ((uint64_t)x.digits[i] << 32) + x.digits[i - 1];
-            qdigit = (uint32_t)(z / ymsd);
+            ddigit_t z = ((ddigit_t)x.digits[i] << DIGIT_BITS) + x.digits[i - 1];
+            qdigit = (digit_t)(z / ymsd);
         }
         // Adjust estimate
         xm3.digits = &x.digits[i - 2];
@@ -858,9 +1023,10 @@ BigNum BigNum::operator/(uint32_t i) const
 {
     // TODO - check for power of 2 and shift
     QCC_ASSERT(i != 0);
+    digit_t d = i;
     BigNum n;
     BigNum rem;
-    n.digits = &i;
+    n.digits = &d;
     n.length = 1;
     return div(n, rem);
 }
@@ -878,24 +1044,24 @@ BigNum & AJ_CALL BigNum::right_shift(BigNum& result, const BigNum& n, uint32_t s
     if (shift == 0) {
         result = n;
     }
-    size_t shift32 = shift >> 5;
-    if (n.length > shift32) {
+    size_t shiftDigits = shift / DIGIT_BITS;
+    if (n.length > shiftDigits) {
         BigNum t = n;
         strip_lz(t);
-        size_t len = t.length - shift32;
-        shift &= 0x1F;
+        size_t len = t.length - shiftDigits;
+        shift %= DIGIT_BITS;
         result.reset(len, t.neg, false);
         if (shift == 0) {
-            // Shift is multiple of 32 bits
-            memmove(result.digits, t.digits + shift32, len * sizeof(uint32_t));
+            // Shift is multiple of the digit size
+            memmove(result.digits, t.digits + shiftDigits, len * sizeof(digit_t));
         } else {
-            uint32_t* x = result.digits + len;
-            const uint32_t* y = t.digits + t.length;
-            uint32_t ext = 0;
+            digit_t* x = result.digits + len;
+            const digit_t* y = t.digits + t.length;
+            digit_t ext = 0;
             for (size_t i = 0; i < len; ++i) {
-                uint32_t v = *--y;
+                digit_t v = *--y;
                 *--x = ext | (v >> shift);
-                ext = v << (32 - shift);
+                ext = v << (DIGIT_BITS - shift);
             }
         }
         return strip_lz(result);
@@ -923,21 +1089,21 @@ BigNum BigNum::operator<<(uint32_t shift) const
     if (shift == 0) {
         return *this;
     }
-    size_t shift32 = shift >> 5;
-    BigNum result(length + shift32 + 1, neg);
-    shift &= 0x1F;
+    size_t shiftDigits = shift / DIGIT_BITS;
+    BigNum result(length + shiftDigits + 1, neg);
+    shift %= DIGIT_BITS;
     if (shift == 0) {
-        // Shift is multiple of 32 bits
-        memcpy(result.digits + shift32, digits, length * sizeof(uint32_t));
-        result.length = length + shift32;
+        // Shift is multiple of the digit size
+        memcpy(result.digits + shiftDigits, digits, length * sizeof(digit_t));
+        result.length = length + shiftDigits;
     } else {
-        uint32_t* x = result.digits + shift32;
-        const uint32_t* y = digits;
-        uint32_t ext = 0;
+        digit_t* x = result.digits + shiftDigits;
+        const digit_t* y = digits;
+        digit_t ext = 0;
         for (size_t i = 0; i < length; ++i) {
-            uint64_t v = (uint64_t)(*y++) << shift;
-            *x++ = (uint32_t)v | ext;
-            ext = (uint32_t)(v >> 32);
+            ddigit_t v = (ddigit_t)(*y++) << shift;
+            *x++ = (digit_t)v | ext;
+            ext = (digit_t)(v >> DIGIT_BITS);
         }
         *x = ext;
     }
@@ -959,7 +1125,7 @@ size_t BigNum::bit_len() const
             return 0;
         }
     }
-    return len * 32 + 1 + log2(digits[len]);
+    return len * DIGIT_BITS + 1 + log2(digits[len]);
 }
 
 // Exponentiation
@@ -984,6 +1150,47 @@ BigNum BigNum::exp(const BigNum& e) const
     return strip_lz(a);
 }
 
+/*
+ * Choose the sliding window size for an exponent of the given bit length. Larger windows need
+ * fewer multiplications but a bigger table of precomputed odd powers.
+ */
+static size_t window_bits(size_t expBits)
+{
+    if (expBits > 671) {
+        return 6;
+    } else if (expBits > 239) {
+        return 5;
+    } else if (expBits > 79) {
+        return 4;
+    } else if (expBits > 23) {
+        return 3;
+    } else {
+        return 1;
+    }
+}
+
+/*
+ * Find the next window of a left-to-right sliding window scan of exponent e. On entry i is the
+ * number of exponent bits still to be processed and the bit at i - 1 is set. On return i has been
+ * moved past the window and the odd value of the window is returned in val.
+ *
+ * @return  The number of bits in the window
+ */
+static size_t next_window(const BigNum& e, size_t& i, size_t w, size_t& val)
+{
+    size_t j = (i > w) ? i - w : 0;
+    // Windows always end on a set bit so the value is odd
+    while (!e.test_bit(j)) {
+        ++j;
+    }
+    size_t len = i - j;
+    val = 0;
+    while (i > j) {
+        val = (val << 1) | (e.test_bit(--i) ? 1 : 0);
+    }
+    return len;
+}
+
 // Modular exponentiation
 BigNum BigNum::mod_exp(const BigNum& e, const BigNum& m) const
 {
@@ -995,21 +1202,41 @@ BigNum BigNum::mod_exp(const BigNum& e, const BigNum& m) const
     if (m.is_odd()) {
         return x.monty_mod_exp(e, m);
     } else {
-        BigNum a = 1;
-
-        BigNum tmp1;
-        BigNum tmp2;
+        const size_t w = window_bits(e.bit_len());
+        const size_t tableLen = (size_t)1 << (w - 1);
+
+        // Odd powers x^1, x^3, x^5 ... x^(2^w - 1)
+        BigNum* table = new BigNum[tableLen];
+        table[0] = x % m;
+        if (tableLen > 1) {
+            BigNum x2 = (table[0] * table[0]) % m;
+            for (size_t k = 1; k < tableLen; ++k) {
+                table[k] = (table[k - 1] * x2) % m;
+            }
+        }
 
+        BigNum a = 1;
+        bool started = false;
         size_t i = e.bit_len();
         while (i) {
-            a = mul(tmp1, a, a) % m;
-            if (e.test_bit(--i)) {
-                a = mul(tmp2, a, x) % m;
+            if (!e.test_bit(i - 1)) {
+                a = (a * a) % m;
+                --i;
+                continue;
+            }
+            size_t val;
+            size_t len = next_window(e, i, w, val);
+            if (started) {
+                while (len--) {
+                    a = (a * a) % m;
+                }
+                a = (a * table[val >> 1]) % m;
             } else {
-                tmp1 = tmp2;
-                tmp2 = a;
+                a = table[val >> 1];
+                started = true;
             }
         }
+        delete [] table;
         return strip_lz(a);
     }
 }
@@ -1019,13 +1246,13 @@ int AJ_CALL BigNum::compare(const BigNum& a, const BigNum& b)
 {
     // strip leading zeroes
     size_t aLen = a.length;
-    const uint32_t* aDigits = &a.digits[aLen];
+    const digit_t* aDigits = &a.digits[aLen];
     while (*--aDigits == 0 && --aLen) {
     }
     ;
     // strip leading zeroes
     size_t bLen = b.length;
-    const uint32_t* bDigits = &b.digits[bLen];
+    const digit_t* bDigits = &b.digits[bLen];
     while (*--bDigits == 0 && --bLen) {
     }
     ;
@@ -1053,21 +1280,21 @@ BigNum& BigNum::sub(const BigNum& n, size_t shift)
 {
     QCC_ASSERT(this->abs() >= n.abs());
     size_t len = 0;
-    uint64_t borrow = 0;
-    uint32_t* l = digits + shift;
-    const uint32_t* r = n.digits;
+    ddigit_t borrow = 0;
+    digit_t* l = digits + shift;
+    const digit_t* r = n.digits;
 
     while (len < n.length) {
-        uint64_t num = (uint64_t)*l - (uint64_t)*r++ - borrow;
-        borrow = num >> 63;
-        *l++ = (uint32_t)num;
+        ddigit_t num = (ddigit_t)*l - (ddigit_t)*r++ - borrow;
+        borrow = num >> (2 * DIGIT_BITS - 1);
+        *l++ = (digit_t)num;
         ++len;
     }
     // Continue propogating borrow
     while (borrow) {
-        uint64_t num = (uint64_t)*l - borrow;
-        borrow = num >> 63;
-        *l++ = (uint32_t)num;
+        ddigit_t num = (ddigit_t)*l - borrow;
+        borrow = num >> (2 * DIGIT_BITS - 1);
+        *l++ = (digit_t)num;
     }
     strip_lz(*this);
     return *this;
@@ -1098,8 +1325,8 @@ uint32_t BigNum::num_trailing_zeroes() const
     uint32_t z = 0;
 
     for (size_t i = 0; i < length; ++i) {
-        uint32_t x = digits[i];
-        for (size_t j = 0; j < 4; ++j, x >>= 8) {
+        digit_t x = digits[i];
+        for (size_t j = 0; j < sizeof(digit_t); ++j, x >>= 8) {
             uint32_t zx = tz[x & 0xFF];
             z += zx;
             if (zx < 8) {
@@ -1110,90 +1337,141 @@ uint32_t BigNum::num_trailing_zeroes() const
     return 0;
 }
 
-static uint32_t monty_rho(uint64_t b)
+// Computes -1/b mod 2^DIGIT_BITS
+static digit_t monty_rho(digit_t b)
 {
     // Modular inversion not defined for even values
     if (!(b & 1)) {
         return 0;
     }
-    uint64_t x = (((b + 2) & 4) << 1) + b;
-    x *= 2 - b * x;
-    x *= 2 - b * x;
-    x *= 2 - b * x;
-    return (uint32_t)-x;
+    // b is its own inverse modulo 8, each Newton iteration doubles the number of correct bits
+    digit_t x = b;
+    for (size_t bits = 3; bits < DIGIT_BITS; bits *= 2) {
+        x *= 2 - b * x;
+    }
+    return (digit_t)0 - x;
 }
 
-BigNum& BigNum::monty_mul(BigNum& r, const BigNum& n, const BigNum& m, uint32_t rho) const
+/*
+ * Montgomery multiplication r = x * y / R mod m where R = 2^(DIGIT_BITS * len). All operands are
+ * len digits long, r may alias x or y. The product is accumulated in t which must have room for
+ * len + 2 digits.
+ */
+static void monty_mul(digit_t* r, const digit_t* x, const digit_t* y, const digit_t* m, size_t len, digit_t rho, digit_t* t)
 {
-    size_t len = m.length;
-    QCC_ASSERT(length <= len);
-    QCC_ASSERT(n.length <= len);
-
-    // Zero pad inputs if needed
-    BigNum x = (length < len) ? clone(len - length) : *this;
-    BigNum y = (n.length < len) ? n.clone(len - n.length) : n;
-
-    r.reset(len + 1);
-    // This avoids a final shift right
-    ++r.digits;
+    memset(t, 0, (len + 2) * sizeof(digit_t));
     for (size_t i = 0; i < len; ++i) {
-        uint64_t X = x.digits[i];
-        uint32_t u = (r.digits[0] + X * y.digits[0]) * rho;
-        uint64_t carry = 0;
-        uint64_t R;
-        uint32_t* rd = r.digits;
-        for (size_t j = 0; j < len; ++j, ++rd) {
-            uint64_t Y = X * y.digits[j];
-            uint64_t M = (uint64_t)u * m.digits[j];
-            R = (uint64_t)*rd + carry + (uint32_t)Y + (uint32_t)M;
-            carry = (R >> 32) + (Y >> 32) + (M >> 32);
-            *(rd - 1) = (uint32_t)R;
+        // t += x[i] * y
+        ddigit_t X = x[i];
+        ddigit_t carry = 0;
+        for (size_t j = 0; j < len; ++j) {
+            ddigit_t p = X * y[j] + t[j] + carry;
+            t[j] = (digit_t)p;
+            carry = p >> DIGIT_BITS;
+        }
+        ddigit_t s = (ddigit_t)t[len] + carry;
+        t[len] = (digit_t)s;
+        t[len + 1] = (digit_t)(s >> DIGIT_BITS);
+        // t = (t + u * m) / 2^DIGIT_BITS, u is chosen so the least significant digit is zero
+        ddigit_t u = (digit_t)(t[0] * rho);
+        carry = (u * m[0] + t[0]) >> DIGIT_BITS;
+        for (size_t j = 1; j < len; ++j) {
+            ddigit_t p = u * m[j] + t[j] + carry;
+            t[j - 1] = (digit_t)p;
+            carry = p >> DIGIT_BITS;
         }
-        R = (uint64_t)*rd + carry;
-        carry = (R >> 32);
-        *(rd - 1) = (uint32_t)R;
-        *rd = (uint32_t)carry;
+        s = (ddigit_t)t[len] + carry;
+        t[len - 1] = (digit_t)s;
+        t[len] = t[len + 1] + (digit_t)(s >> DIGIT_BITS);
+    }
+    // t < 2m so at most one subtraction is needed
+    bool ge = (t[len] != 0);
+    if (!ge) {
+        size_t k = len;
+        while (k && (t[k - 1] == m[k - 1])) {
+            --k;
+        }
+        ge = (k == 0) || (t[k - 1] > m[k - 1]);
     }
-
-    if (r >= m) {
-        r.sub(m);
+    if (ge) {
+        sub_digits(t, len + 1, m, len);
     }
-    return strip_lz(r);
+    memcpy(r, t, len * sizeof(digit_t));
 }
 
 // Modular exponentiation using Montgomery multiplication
 BigNum BigNum::monty_mod_exp(const BigNum& e, const BigNum& m) const
 {
     QCC_ASSERT(m.is_odd());
-    uint32_t rho = monty_rho(m.digits[0]);
+    QCC_ASSERT(length <= m.length);
+    const size_t len = m.length;
+    const digit_t rho = monty_rho(m.digits[0]);
+    const size_t w = window_bits(e.bit_len());
+    const size_t tableLen = (size_t)1 << (w - 1);
 
-    BigNum R = 1;
-    BigNum RR = 1;
+    BigNum R;
+    BigNum RR;
 
-    R.reset(m.length + 1);
+    R.reset(len + 1);
     R.msdigit() = 1;
-    RR.reset(m.length * 2 + 1);
+    RR.reset(len * 2 + 1);
     RR.msdigit() = 1;
 
-    BigNum x;
-    BigNum a = R % m;
+    BigNum one = R % m;
+    BigNum RRm = RR % m;
+
+    // All of the working values for the exponentiation come from a single allocation
+    DigitArena arena((tableLen + 4) * len + 2);
+    digit_t* t = arena.Alloc(len + 2);
+    digit_t* a = arena.Alloc(len);
+    digit_t* x = arena.Alloc(len);
+    digit_t* x2 = arena.Alloc(len);
+    digit_t* table = arena.Alloc(tableLen * len);
 
     // Convert to Montgomery domain
-    this->monty_mul(x, RR % m, m, rho);
+    memset(x, 0, len * sizeof(digit_t));
+    memcpy(x, digits, length * sizeof(digit_t));
+    memset(x2, 0, len * sizeof(digit_t));
+    memcpy(x2, RRm.digits, RRm.length * sizeof(digit_t));
+    monty_mul(table, x, x2, m.digits, len, rho, t);
+
+    // Odd powers x^1, x^3, x^5 ... x^(2^w - 1)
+    if (tableLen > 1) {
+        monty_mul(x2, table, table, m.digits, len, rho, t);
+        for (size_t k = 1; k < tableLen; ++k) {
+            monty_mul(table + k * len, table + (k - 1) * len, x2, m.digits, len, rho, t);
+        }
+    }
 
-    BigNum tmp1;
-    BigNum tmp2;
+    memset(a, 0, len * sizeof(digit_t));
+    memcpy(a, one.digits, one.length * sizeof(digit_t));
 
+    bool started = false;
     size_t i = e.bit_len();
     while (i) {
-        a = a.monty_mul(tmp1, a, m, rho);
-        if (e.test_bit(--i)) {
-            a = a.monty_mul(tmp2, x, m, rho);
+        if (!e.test_bit(i - 1)) {
+            monty_mul(a, a, a, m.digits, len, rho, t);
+            --i;
+            continue;
+        }
+        size_t val;
+        size_t winLen = next_window(e, i, w, val);
+        const digit_t* pow = table + (val >> 1) * len;
+        if (started) {
+            while (winLen--) {
+                monty_mul(a, a, a, m.digits, len, rho, t);
+            }
+            monty_mul(a, a, pow, m.digits, len, rho, t);
         } else {
-            tmp1 = tmp2;
-            tmp2 = a;
+            memcpy(a, pow, len * sizeof(digit_t));
+            started = true;
         }
     }
-    BigNum r;
-    return a.monty_mul(r, 1, m, rho);
+
+    // Convert out of Montgomery domain
+    memset(x, 0, len * sizeof(digit_t));
+    x[0] = 1;
+    BigNum r(len, false);
+    monty_mul(r.digits, a, x, m.digits, len, rho, t);
+    return strip_lz(r);
 }
@@ -350,39 +350,64 @@ QStatus AJ_CALL DecodePublicKeyPEM(const String& encoded, uint8_t* publicKey, si
 
 
 
-QStatus CertificateX509::DecodeCertificateName(const qcc::String& dn, CertificateX509::DistinguishedName& name)
+/*
+ * Decode a value that must be a single UTF8 string.
+ */
+static QStatus DecodeUTF8(const Crypto_ASN1::View& asn, Crypto_ASN1::View& val)
+{
+    Crypto_ASN1::Reader reader(asn);
+    QStatus status = reader.ReadUTF8(val);
+    if (ER_OK == status) {
+        status = reader.ExpectEnd();
+    }
+    return status;
+}
+
+QStatus CertificateX509::DecodeCertificateName(const Crypto_ASN1::View& dn, CertificateX509::DistinguishedName& name)
 {
     QStatus status = ER_OK;
-    qcc::String tmp = dn;
+    Crypto_ASN1::Reader rdns(dn);
 
-    while ((ER_OK == status) && (tmp.size())) {
+    while ((ER_OK == status) && !rdns.AtEnd()) {
+        Crypto_ASN1::Reader rdn;
+        Crypto_ASN1::Reader attr;
         qcc::String oid;
-        qcc::String str;
-        qcc::String rem;
-        status = Crypto_ASN1::Decode(tmp, "{(o.)}.", &oid, &str, &rem);
+        status = rdns.ReadSet(rdn);
+        if (ER_OK == status) {
+            status = rdn.ReadSequence(attr);
+        }
+        if (ER_OK == status) {
+            status = attr.ReadOID(oid);
+        }
+        if ((ER_OK == status) && attr.AtEnd()) {
+            /* the attribute value is missing */
+            status = ER_FAIL;
+        }
+        if (ER_OK == status) {
+            status = rdn.ExpectEnd();
+        }
         if (ER_OK != status) {
             QCC_LogError(status, ("Error decoding distinguished name"));
             return status;
         }
         if (OID_DN_OU == oid) {
-            qcc::String val;
-            status = Crypto_ASN1::Decode(str, "u", &val);
+            Crypto_ASN1::View val;
+            status = DecodeUTF8(attr.Remaining(), val);
             if (ER_OK != status) {
                 QCC_LogError(status, ("Error decoding OU field of the distinguished name"));
                 return status;
             }
-            name.SetOU((const uint8_t*) val.data(), val.length());
+            name.SetOU(val.data, val.len);
         } else if (OID_DN_CN == oid) {
-            qcc::String val;
-            status = Crypto_ASN1::Decode(str, "u", &val);
+            Crypto_ASN1::View val;
+            status = DecodeUTF8(attr.Remaining(), val);
             if (ER_OK != status) {
                 QCC_LogError(status, ("Error decoding CN field of the distinguished name"));
                 return status;
             }
-            name.SetCN((const uint8_t*) val.data(), val.length());
+            name.SetCN(val.data, val.len);
         }
         /* do not parse the other fields of the distinguished name */
-        tmp = rem;
     }
 
     return status;
@@ -412,23 +437,30 @@ QStatus CertificateX509::EncodeCertificateName(qcc::String& dn, const Certificat
     return ER_OK;
 }
 
-static QStatus DecodeTime(uint64_t& epoch, const qcc::String& t)
+static QStatus DecodeTime(uint64_t& epoch, const Crypto_ASN1::View& time)
 {
     struct tm tm;
+    char t[16];
+
+    if (time.len >= sizeof(t)) {
+        return ER_FAIL;
+    }
+    memcpy(t, time.data, time.len);
+    t[time.len] = '\0';
 
     /* Parse the string into the tm struct.  Can't use strptime since it not
         available in some platforms like Android or Windows */
-    if (0xD == t.size()) {
+    if (0xD == time.len) {
         /* the time format is "%y%m%d%H%M%SZ".  Sample input: 150205230725Z */
-        if (sscanf(t.c_str(), "%2d%2d%2d%2d%2d%2dZ", &tm.tm_year, &tm.tm_mon, &tm.tm_mday, &tm.tm_hour, &tm.tm_min, &tm.tm_sec) != 6) {
+        if (sscanf(t, "%2d%2d%2d%2d%2d%2dZ", &tm.tm_year, &tm.tm_mon, &tm.tm_mday, &tm.tm_hour, &tm.tm_min, &tm.tm_sec) != 6) {
             return ER_FAIL;
         }
         if ((tm.tm_year >= 0) && (tm.tm_year <= 68)) {
             tm.tm_year += 100;    /* tm_year holds  Year - 1900 */
         }
-    } else if (0xF == t.size()) {
+    } else if (0xF == time.len) {
         /* the time format is "%Y%m%d%H%M%SZ".  Sample input: 20150205230725Z*/
-        if (sscanf(t.c_str(), "%4d%2d%2d%2d%2d%2dZ", &tm.tm_year, &tm.tm_mon, &tm.tm_mday, &tm.tm_hour, &tm.tm_min, &tm.tm_sec) != 6) {
+        if (sscanf(t, "%4d%2d%2d%2d%2d%2dZ", &tm.tm_year, &tm.tm_mon, &tm.tm_mday, &tm.tm_hour, &tm.tm_min, &tm.tm_sec) != 6) {
             return ER_FAIL;
         }
         tm.tm_year -= 1900;    /* tm_year hold Year - 1900 */
@@ -473,43 +505,22 @@ static QStatus DecodeTime(uint64_t& epoch, const qcc::String& t)
     return ER_OK;
 }
 
-QStatus CertificateX509::DecodeCertificateTime(const qcc::String& time)
+QStatus CertificateX509::DecodeCertificateTime(const Crypto_ASN1::View& time)
 {
-    QStatus status;
-    qcc::String tmp;
-    qcc::String time1;
-    qcc::String time2;
+    Crypto_ASN1::Reader reader(time);
+    Crypto_ASN1::View time1;
+    Crypto_ASN1::View time2;
 
-    tmp = time;
-    status = Crypto_ASN1::Decode(tmp, "t.", &time1, &time2);
-    if (ER_OK != status) {
-        status = Crypto_ASN1::Decode(tmp, "T.", &time1, &time2);
+    QStatus status = reader.ReadTime(time1);
+    if (ER_OK == status) {
+        status = reader.ReadTime(time2);
     }
-    if (ER_OK != status) {
-        return status;
-    }
-    tmp = time2;
-    status = Crypto_ASN1::Decode(tmp, "t", &time2);
-    if (ER_OK != status) {
-        status = Crypto_ASN1::Decode(tmp, "T", &time2);
+    if ((ER_OK == status) && !reader.AtEnd()) {
+        status = ER_FAIL;
     }
     if (ER_OK != status) {
         return status;
     }
-
-    if ((0xD != time1.size()) && (0xF != time1.size())) {
-        return ER_FAIL;
-    }
-    if ((0xD != time2.size()) && (0xF != time2.size())) {
-        return ER_FAIL;
-    }
-
-    char buf1[16];
-    char buf2[16];
-    memset(buf1, 0, 16);
-    memset(buf2, 0, 16);
-    memcpy(buf1, time1.data(), time1.size());
-    memcpy(buf2, time2.data(), time2.size());
     status = DecodeTime(validity.validFrom, time1);
     if (ER_OK != status) {
         return status;
@@ -565,15 +576,32 @@ QStatus CertificateX509::EncodeCertificateTime(qcc::String& time) const
     return status;
 }
 
-QStatus CertificateX509::DecodeCertificatePub(const qcc::String& pub)
+QStatus CertificateX509::DecodeCertificatePub(const Crypto_ASN1::View& pub)
 {
     QStatus status = ER_OK;
+    Crypto_ASN1::Reader reader(pub);
+    Crypto_ASN1::Reader alg;
     qcc::String oid1;
     qcc::String oid2;
-    qcc::String key;
+    Crypto_ASN1::View key;
     size_t keylen = 0;
 
-    status = Crypto_ASN1::Decode(pub, "(oo)b", &oid1, &oid2, &key, &keylen);
+    status = reader.ReadSequence(alg);
+    if (ER_OK == status) {
+        status = alg.ReadOID(oid1);
+    }
+    if (ER_OK == status) {
+        status = alg.ReadOID(oid2);
+    }
+    if (ER_OK == status) {
+        status = alg.ExpectEnd();
+    }
+    if (ER_OK == status) {
+        status = reader.ReadBits(key, keylen);
+    }
+    if (ER_OK == status) {
+        status = reader.ExpectEnd();
+    }
     if (ER_OK != status) {
         return status;
     }
@@ -583,14 +611,14 @@ QStatus CertificateX509::DecodeCertificatePub(const qcc::String& pub)
     if (OID_CRV_PRIME256V1 != oid2) {
         return ER_FAIL;
     }
-    if (1 + publickey.GetSize() != key.size()) {
+    if (1 + publickey.GetSize() != key.len) {
         return ER_FAIL;
     }
     // Uncompressed points only
-    if (0x4 != *key.data()) {
+    if (0x4 != *key.data) {
         return ER_FAIL;
     }
-    status = publickey.Import((const uint8_t*)(key.data() + 1), key.size() - 1);
+    status = publickey.Import(key.data + 1, key.len - 1);
 
     return status;
 }
@@ -620,36 +648,56 @@ QStatus CertificateX509::EncodeCertificatePub(qcc::String& pub) const
     return status;
 }
 
-QStatus CertificateX509::DecodeCertificateExt(const qcc::String& ext)
+QStatus CertificateX509::DecodeCertificateExt(const Crypto_ASN1::View& ext)
 {
     QStatus status = ER_OK;
-    qcc::String tmp;
+    Crypto_ASN1::Reader reader(ext);
+    Crypto_ASN1::Reader tagged;
+    Crypto_ASN1::Reader exts;
 
-    status = Crypto_ASN1::Decode(ext, "c((.))", 3, &tmp);
+    status = reader.ReadContext(3, tagged);
+    if (ER_OK == status) {
+        status = tagged.ReadSequence(exts);
+    }
+    if (ER_OK == status) {
+        status = tagged.ExpectEnd();
+    }
+    if (ER_OK == status) {
+        status = reader.ExpectEnd();
+    }
     if (ER_OK != status) {
         return status;
     }
-    while ((ER_OK == status) && (tmp.size())) {
+    while ((ER_OK == status) && !exts.AtEnd()) {
+        Crypto_ASN1::Reader extn;
         qcc::String oid;
-        qcc::String str;
-        qcc::String critical;
-        qcc::String rem;
-        status = Crypto_ASN1::Decode(tmp, "(ozx).", &oid, &critical, &str, &rem);
+        uint32_t critical;
+        Crypto_ASN1::View str;
+        status = exts.ReadSequence(extn);
+        if (ER_OK == status) {
+            status = extn.ReadOID(oid);
+        }
+        if (ER_OK == status) {
+            /* the critical boolean flag is optional */
+            extn.ReadBoolean(critical);
+            status = extn.ReadOctets(str);
+        }
+        if (ER_OK == status) {
+            status = extn.ExpectEnd();
+        }
         if (ER_OK != status) {
-            /* the critical boolean flag is not present */
-            status = Crypto_ASN1::Decode(tmp, "(ox).", &oid, &str, &rem);
-            if (ER_OK != status) {
-                return status;
-            }
+            return status;
         }
         if (OID_BASIC_CONSTRAINTS == oid) {
-            qcc::String opt;
-            status = Crypto_ASN1::Decode(str, "(.)", &opt);
-            if (ER_OK != status) {
-                status = ER_OK;  /* The sequence can be empty since CA is false by default */
-            } else if (opt.size()) {
+            Crypto_ASN1::Reader bc(str);
+            Crypto_ASN1::Reader opt;
+            /* The sequence can be empty since CA is false by default */
+            if ((ER_OK == bc.ReadSequence(opt)) && bc.AtEnd()) {
                 /* do not parse the path len field */
-                status = Crypto_ASN1::Decode(opt, "z*", &ca);
+                status = opt.ReadBoolean(ca);
+                while ((ER_OK == status) && !opt.AtEnd()) {
+                    status = opt.Skip();
+                }
                 if (ER_OK != status) {
                     return status;
                 }
@@ -657,37 +705,36 @@ QStatus CertificateX509::DecodeCertificateExt(const qcc::String& ext)
         } else if (OID_EKU == oid) {
             bool identityEKUPresent = false;
             bool membershipEKUPresent = false;
+            Crypto_ASN1::Reader eku(str);
+            Crypto_ASN1::Reader ekus;
 
-            status = Crypto_ASN1::Decode(str, "(.)", &tmp);
+            /* There has to be at least one EKU listed per the RFC. If the sequence is empty,
+             * the cert is malformed. */
+            status = eku.ReadSequence(ekus);
+            if (ER_OK == status) {
+                status = eku.ExpectEnd();
+            }
             if (ER_OK != status) {
                 return status;
             }
-            /* There has to be at least one EKU listed per the RFC. If tmp is empty,
-             * the cert is malformed. */
-            if (0 == tmp.size()) {
-                return ER_FAIL;
-            }
-            while ((ER_OK == status) && (tmp.size() > 0)) {
-                qcc::String eku;
-                qcc::String rem;
-                status = Crypto_ASN1::Decode(tmp, "o.", &eku, &rem);
+            while ((ER_OK == status) && !ekus.AtEnd()) {
+                qcc::String ekuOid;
+                status = ekus.ReadOID(ekuOid);
                 if (ER_OK == status) {
-                    if (OID_CUSTOM_EKU_IDENTITY == eku) {
+                    if (OID_CUSTOM_EKU_IDENTITY == ekuOid) {
                         if (identityEKUPresent) {
                             QCC_DbgPrintf(("Identity EKU seen multiple times"));
                         }
                         identityEKUPresent = true;
-                    } else if (OID_CUSTOM_EKU_MEMBERSHIP == eku) {
+                    } else if (OID_CUSTOM_EKU_MEMBERSHIP == ekuOid) {
                         if (membershipEKUPresent) {
                             QCC_DbgPrintf(("Membership EKU seen multiple times"));
                         }
                         membershipEKUPresent = true;
                     } else {
                         /* An unrelated EKU. Unexpected but not fatal. Log and move on. */
-                        QCC_DbgPrintf(("Informational: Saw unexpected EKU %s", eku.c_str()));
+                        QCC_DbgPrintf(("Informational: Saw unexpected EKU %s", ekuOid.c_str()));
                     }
-
-                    tmp = rem;
                 }
             }
 
@@ -708,35 +755,82 @@ QStatus CertificateX509::DecodeCertificateExt(const qcc::String& ext)
                 type = INVALID_CERTIFICATE;
             }
         } else if (OID_SUB_ALTNAME == oid) {
+            Crypto_ASN1::Reader san(str);
+            Crypto_ASN1::Reader names;
+            Crypto_ASN1::Reader otherName;
             qcc::String otherNameOid;
-            qcc::String otherName;
             /* only interested in the otherName field [0] */
-            if (ER_OK == Crypto_ASN1::Decode(str, "(c(o.))", 0, &otherNameOid, &otherName)) {
+            if ((ER_OK == san.ReadSequence(names)) && san.AtEnd() &&
+                (ER_OK == names.ReadContext(0, otherName)) && names.AtEnd() &&
+                (ER_OK == otherName.ReadOID(otherNameOid)) && !otherName.AtEnd()) {
                 if ((OID_CUSTOM_SECURITY_GROUP_ID == otherNameOid) || (OID_CUSTOM_IDENTITY_ALIAS == otherNameOid)) {
-                    status = Crypto_ASN1::Decode(otherName, "c(x)", 0, &subjectAltName);
+                    Crypto_ASN1::Reader value(otherName.Remaining());
+                    Crypto_ASN1::Reader tagged;
+                    Crypto_ASN1::View alias;
+                    status = value.ReadContext(0, tagged);
+                    if (ER_OK == status) {
+                        status = tagged.ReadOctets(alias);
+                    }
+                    if (ER_OK == status) {
+                        status = tagged.ExpectEnd();
+                    }
+                    if (ER_OK == status) {
+                        status = value.ExpectEnd();
+                    }
                     if (ER_OK != status) {
                         return status;
                     }
+                    if (!alias.empty()) {
+                        subjectAltName = alias.ToString();
+                    }
                 }
             }
         } else if (OID_CUSTOM_DIGEST == oid) {
-            qcc::String dig;
+            Crypto_ASN1::Reader dig(str);
+            Crypto_ASN1::Reader seq;
+            Crypto_ASN1::View val;
             oid.clear();
-            status = Crypto_ASN1::Decode(str, "(ox)", &oid, &dig);
+            status = dig.ReadSequence(seq);
+            if (ER_OK == status) {
+                status = seq.ReadOID(oid);
+            }
+            if (ER_OK == status) {
+                status = seq.ReadOctets(val);
+            }
+            if (ER_OK == status) {
+                status = seq.ExpectEnd();
+            }
+            if (ER_OK == status) {
+                status = dig.ExpectEnd();
+            }
             if (ER_OK != status) {
                 return status;
             }
             if (OID_DIG_SHA256 != oid) {
                 return ER_INVALID_DATA;
             }
-            digest = dig;
+            digest = val.ToString();
         } else if (OID_AUTHORITY_KEY_IDENTIFIER == oid) {
-            status = Crypto_ASN1::Decode(str, "(c(.))", 0, &aki);
+            Crypto_ASN1::Reader akid(str);
+            Crypto_ASN1::Reader seq;
+            Crypto_ASN1::View val;
+            status = akid.ReadSequence(seq);
+            if (ER_OK == status) {
+                status = seq.ReadContextValue(0, val);
+            }
+            if (ER_OK == status) {
+                status = seq.ExpectEnd();
+            }
+            if (ER_OK == status) {
+                status = akid.ExpectEnd();
+            }
             if (ER_OK != status) {
                 return status;
             }
+            if (!val.empty()) {
+                aki = val.ToString();
+            }
         }
-        tmp = rem;
     }
     return status;
 }
@@ -862,15 +956,57 @@ QStatus CertificateX509::DecodeCertificateTBS()
     QStatus status = ER_OK;
     uint32_t x509Version = 0;
     qcc::String oid;
-    qcc::String iss;
-    qcc::String sub;
-    qcc::String time;
-    qcc::String pub;
-    qcc::String ext;
-    qcc::String serialStr;
+    Crypto_ASN1::Reader reader((const uint8_t*) tbs.data(), tbs.size());
+    Crypto_ASN1::Reader fields;
+    Crypto_ASN1::Reader version;
+    Crypto_ASN1::Reader alg;
+    Crypto_ASN1::Reader iss;
+    Crypto_ASN1::Reader time;
+    Crypto_ASN1::Reader sub;
+    Crypto_ASN1::Reader pub;
+    Crypto_ASN1::View serialView;
 
-    status = Crypto_ASN1::Decode(tbs, "(c(i)l(o)(.)(.)(.)(.).)",
-                                 0, &x509Version, &serialStr, &oid, &iss, &time, &sub, &pub, &ext);
+    status = reader.ReadSequence(fields);
+    if (ER_OK == status) {
+        status = fields.ReadContext(0, version);
+    }
+    if (ER_OK == status) {
+        status = version.ReadInteger(x509Version);
+    }
+    if (ER_OK == status) {
+        status = version.ExpectEnd();
+    }
+    if (ER_OK == status) {
+        status = fields.ReadInteger(serialView);
+    }
+    if (ER_OK == status) {
+        status = fields.ReadSequence(alg);
+    }
+    if (ER_OK == status) {
+        status = alg.ReadOID(oid);
+    }
+    if (ER_OK == status) {
+        status = alg.ExpectEnd();
+    }
+    if (ER_OK == status) {
+        status = fields.ReadSequence(iss);
+    }
+    if (ER_OK == status) {
+        status = fields.ReadSequence(time);
+    }
+    if (ER_OK == status) {
+        status = fields.ReadSequence(sub);
+    }
+    if (ER_OK == status) {
+        status = fields.ReadSequence(pub);
+    }
+    if ((ER_OK == status) && fields.AtEnd()) {
+        /* the extensions are required */
+        status = ER_FAIL;
+    }
+    if (ER_OK == status) {
+        status = reader.ExpectEnd();
+    }
     if (ER_OK != status) {
         QCC_LogError(status, ("Error decoding certificate"));
         return status;
@@ -879,32 +1015,32 @@ QStatus CertificateX509::DecodeCertificateTBS()
         QCC_LogError(status, ("Certificate not X.509v3"));
         return ER_FAIL;
     }
-    this->SetSerial((const uint8_t*)serialStr.data(), serialStr.size());
+    this->SetSerial(serialView.data, serialView.len);
     if (OID_SIG_ECDSA_SHA256 != oid) {
         QCC_LogError(status, ("Certificate signature must be SHA-256"));
         return ER_FAIL;
     }
-    status = DecodeCertificateName(iss, issuer);
+    status = DecodeCertificateName(iss.Remaining(), issuer);
     if (ER_OK != status) {
         QCC_LogError(status, ("Error decoding certificate issuer"));
         return status;
     }
-    status = DecodeCertificateTime(time);
+    status = DecodeCertificateTime(time.Remaining());
     if (ER_OK != status) {
         QCC_LogError(status, ("Error decoding certificate validity period"));
         return status;
     }
-    status = DecodeCertificateName(sub, subject);
+    status = DecodeCertificateName(sub.Remaining(), subject);
     if (ER_OK != status) {
         QCC_LogError(status, ("Error decoding certificate subject"));
         return status;
     }
-    status = DecodeCertificatePub(pub);
+    status = DecodeCertificatePub(pub.Remaining());
     if (ER_OK != status) {
         QCC_LogError(status, ("Error decoding certificate subject public key"));
         return status;
     }
-    status = DecodeCertificateExt(ext);
+    status = DecodeCertificateExt(fields.Remaining());
     if (ER_OK != status) {
         QCC_LogError(status, ("Error decoding certificate extensions"));
     }
@@ -952,32 +1088,46 @@ QStatus CertificateX509::EncodeCertificateTBS()
     return status;
 }
 
-QStatus CertificateX509::DecodeCertificateSig(const qcc::String& sig)
+QStatus CertificateX509::DecodeCertificateSig(const Crypto_ASN1::View& sig)
 {
     QStatus status = ER_OK;
-    qcc::String r;
-    qcc::String s;
+    Crypto_ASN1::Reader reader(sig);
+    Crypto_ASN1::Reader seq;
+    Crypto_ASN1::View r;
+    Crypto_ASN1::View s;
 
-    status = Crypto_ASN1::Decode(sig, "(ll)", &r, &s);
+    status = reader.ReadSequence(seq);
+    if (ER_OK == status) {
+        status = seq.ReadInteger(r);
+    }
+    if (ER_OK == status) {
+        status = seq.ReadInteger(s);
+    }
+    if (ER_OK == status) {
+        status = seq.ExpectEnd();
+    }
+    if (ER_OK == status) {
+        status = reader.ExpectEnd();
+    }
     if (ER_OK != status) {
         return status;
     }
     memset(&signature, 0, sizeof (signature));
-    if (sizeof (signature.r) < r.size()) {
+    if (sizeof (signature.r) < r.len) {
         return ER_FAIL;
     }
-    if (sizeof (signature.s) < s.size()) {
+    if (sizeof (signature.s) < s.len) {
         return ER_FAIL;
     }
     /* need to prepend leading zero bytes if r size smaller than signagure.r size because the ASN.1 encoder strips the leading zero bytes for type l */
     uint8_t* p = signature.r;
-    p += (sizeof (signature.r) - r.size());
-    memcpy(p, r.data(), r.size());
+    p += (sizeof (signature.r) - r.len);
+    memcpy(p, r.data, r.len);
 
     /* need to prepend leading zero bytes if s size smaller than signagure.s size because the ASN.1 encoder strips the leading zero bytes for type l */
     p = signature.s;
-    p += (sizeof (signature.s) - s.size());
-    memcpy(p, s.data(), s.size());
+    p += (sizeof (signature.s) - s.len);
+    memcpy(p, s.data, s.len);
 
     return status;
 }
@@ -999,21 +1149,42 @@ QStatus CertificateX509::EncodeCertificateSig(qcc::String& sig) const
 QStatus CertificateX509::DecodeCertificateDER(const qcc::String& der)
 {
     QStatus status;
+    Crypto_ASN1::Reader reader((const uint8_t*) der.data(), der.size());
+    Crypto_ASN1::Reader cert;
+    Crypto_ASN1::Reader tbsContents;
+    Crypto_ASN1::Reader alg;
+    Crypto_ASN1::View raw;
+    Crypto_ASN1::View sig;
     qcc::String oid;
-    qcc::String sig;
-    qcc::String tmp;
     size_t siglen = 0;
 
-    status = Crypto_ASN1::Decode(der, "((.)(o)b)", &tmp, &oid, &sig, &siglen);
-    if (ER_OK != status) {
-        return status;
+    status = reader.ReadSequence(cert);
+    if (ER_OK == status) {
+        status = cert.ReadSequence(tbsContents, &raw);
+    }
+    if (ER_OK == status) {
+        status = cert.ReadSequence(alg);
+    }
+    if (ER_OK == status) {
+        status = alg.ReadOID(oid);
+    }
+    if (ER_OK == status) {
+        status = alg.ExpectEnd();
+    }
+    if (ER_OK == status) {
+        status = cert.ReadBits(sig, siglen);
+    }
+    if (ER_OK == status) {
+        status = cert.ExpectEnd();
+    }
+    if (ER_OK == status) {
+        status = reader.ExpectEnd();
     }
-    // Put the sequence back on the TBS
-    tbs.clear();
-    status = Crypto_ASN1::Encode(tbs, "(R)", &tmp);
     if (ER_OK != status) {
         return status;
     }
+    /* The TBS is kept exactly as encoded so the signature can be verified over it */
+    tbs.assign_std((const char*) raw.data, raw.len);
     if (OID_SIG_ECDSA_SHA256 != oid) {
         return ER_FAIL;
     }
@@ -622,7 +622,13 @@ QStatus IODispatch::EnableReadCallback(const Source* source, uint32_t timeout)
         uint32_t temp = timeout * 1000;
         AlarmListener* listener = this;
 
-        Alarm readAlarm = Alarm(temp, listener, it->second.readTimeoutCtxt);
+        /*
+         * Every stream holds a long-lived timeout alarm so these must not count towards
+         * the timer's alarm limit, otherwise the limit caps the number of streams.
+         */
+        uint32_t zero = 0;
+        bool limitable = false;
+        Alarm readAlarm = Alarm(temp, listener, it->second.readTimeoutCtxt, zero, limitable);
         QStatus status = ER_TIMER_FULL;
         while (isRunning && status == ER_TIMER_FULL &&  it != dispatchEntries.end() && it->second.stopping_state == IO_RUNNING) {
             /* Call the non-blocking version of AddAlarm, while holding the
@@ -690,7 +696,9 @@ QStatus IODispatch::EnableTimeoutCallback(const Source* source, uint32_t timeout
         /* If timeout is non-zero, add a timeout alarm */
         uint32_t temp = timeout * 1000;
         AlarmListener* listener = this;
-        Alarm readAlarm = Alarm(temp, listener, it->second.readTimeoutCtxt);
+        uint32_t zero = 0;
+        bool limitable = false;
+        Alarm readAlarm = Alarm(temp, listener, it->second.readTimeoutCtxt, zero, limitable);
 
         /* Remove previous read timeout alarm if any */
         timer.RemoveAlarm(prevAlarm, false);
@@ -823,7 +831,9 @@ QStatus IODispatch::EnableWriteCallback(Sink* sink, uint32_t timeout)
         AlarmListener* listener = this;
 
         /* Add a write alarm to fire by default if there is no sink event after this amount of time */
-        Alarm writeAlarm = Alarm(when, listener, it->second.writeTimeoutCtxt);
+        uint32_t zero = 0;
+        bool limitable = false;
+        Alarm writeAlarm = Alarm(when, listener, it->second.writeTimeoutCtxt, zero, limitable);
         QStatus status = ER_TIMER_FULL;
 
         map<Stream*, IODispatchEntry>::iterator dispatchEntriesIt = dispatchEntries.find(lookup);
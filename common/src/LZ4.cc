@@ -0,0 +1,236 @@
+/**
+ * @file
+ *
+ * LZ4 block format compression used for message bodies on bus-to-bus links.
+ */
+
+/******************************************************************************
+ *    Copyright (c) Open Connectivity Foundation (OCF), AllJoyn Open Source
+ *    Project (AJOSP) Contributors and others.
+ *
+ *    SPDX-License-Identifier: Apache-2.0
+ *
+ *    All rights reserved. This program and the accompanying materials are
+ *    made available under the terms of the Apache License, Version 2.0
+ *    which accompanies this distribution, and is available at
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Copyright (c) Open Connectivity Foundation and Contributors to AllSeen
+ *    Alliance. All rights reserved.
+ *
+ *    Permission to use, copy, modify, and/or distribute this software for
+ *    any purpose with or without fee is hereby granted, provided that the
+ *    above copyright notice and this permission notice appear in all
+ *    copies.
+ *
+ *    THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+ *    WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+ *    WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ *    AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ *    DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ *    PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+ *    TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ *    PERFORMANCE OF THIS SOFTWARE.
+ ******************************************************************************/
+
+#include <qcc/platform.h>
+
+#include <string.h>
+
+#include <qcc/LZ4.h>
+
+#define QCC_MODULE "LZ4"
+
+namespace qcc {
+
+/*
+ * Limits from the LZ4 block format: matches are at least MIN_MATCH bytes, the last LAST_LITERALS
+ * bytes of a block are always literals and the last match starts at least MF_LIMIT bytes before
+ * the end of the block.
+ */
+static const size_t MIN_MATCH = 4;
+static const size_t LAST_LITERALS = 5;
+static const size_t MF_LIMIT = 12;
+static const size_t MAX_OFFSET = 65535;
+static const size_t RUN_MASK = 15;
+
+/*
+ * The hash table holds 4K positions which is plenty for message bodies of at most
+ * ALLJOYN_MAX_PACKET_LEN bytes and keeps the table at 16K bytes on the stack.
+ */
+static const uint32_t HASH_LOG = 12;
+
+static inline uint32_t Read32(const uint8_t* p)
+{
+    uint32_t v;
+    memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+static inline uint32_t Hash(uint32_t v)
+{
+    return (v * 2654435761U) >> (32 - HASH_LOG);
+}
+
+static inline uint8_t* PutLength(uint8_t* op, size_t len)
+{
+    while (len >= 255) {
+        *op++ = 255;
+        len -= 255;
+    }
+    *op++ = (uint8_t)len;
+    return op;
+}
+
+static inline bool GetLength(const uint8_t*& ip, const uint8_t* iend, size_t& len)
+{
+    uint8_t b;
+    do {
+        if (ip >= iend) {
+            return false;
+        }
+        b = *ip++;
+        len += b;
+    } while (b == 255);
+    return true;
+}
+
+size_t LZ4CompressBound(size_t len)
+{
+    return len + (len / 255) + 16;
+}
+
+size_t LZ4Compress(const uint8_t* src, size_t srcLen, uint8_t* dst, size_t dstLen)
+{
+    if (dstLen < LZ4CompressBound(srcLen)) {
+        return 0;
+    }
+    const uint8_t* ip = src;
+    const uint8_t* anchor = src;
+    const uint8_t* end = src + srcLen;
+    uint8_t* op = dst;
+
+    if (srcLen > MF_LIMIT) {
+        uint32_t table[1 << HASH_LOG];
+        memset(table, 0, sizeof(table));
+        const uint8_t* mfLimit = end - MF_LIMIT;
+        const uint8_t* matchLimit = end - LAST_LITERALS;
+        /*
+         * Step over incompressible data faster the longer we go without finding a match
+         */
+        size_t misses = 0;
+
+        while (ip < mfLimit) {
+            uint32_t seq = Read32(ip);
+            uint32_t h = Hash(seq);
+            const uint8_t* ref = src + table[h];
+            table[h] = (uint32_t)(ip - src);
+            if ((ref == ip) || ((size_t)(ip - ref) > MAX_OFFSET) || (Read32(ref) != seq)) {
+                ip += 1 + (misses++ >> 5);
+                continue;
+            }
+            misses = 0;
+            while ((ip > anchor) && (ref > src) && (ip[-1] == ref[-1])) {
+                --ip;
+                --ref;
+            }
+            const uint8_t* mp = ip + MIN_MATCH;
+            const uint8_t* rp = ref + MIN_MATCH;
+            while ((mp < matchLimit) && (*mp == *rp)) {
+                ++mp;
+                ++rp;
+            }
+            size_t litLen = ip - anchor;
+            size_t matchLen = (mp - ip) - MIN_MATCH;
+            size_t offset = ip - ref;
+
+            uint8_t* token = op++;
+            *token = (uint8_t)(((litLen < RUN_MASK) ? litLen : RUN_MASK) << 4);
+            if (litLen >= RUN_MASK) {
+                op = PutLength(op, litLen - RUN_MASK);
+            }
+            memcpy(op, anchor, litLen);
+            op += litLen;
+            *op++ = (uint8_t)offset;
+            *op++ = (uint8_t)(offset >> 8);
+            *token |= (uint8_t)((matchLen < RUN_MASK) ? matchLen : RUN_MASK);
+            if (matchLen >= RUN_MASK) {
+                op = PutLength(op, matchLen - RUN_MASK);
+            }
+            ip = anchor = mp;
+        }
+    }
+    /*
+     * Whatever is left goes out as literals
+     */
+    size_t litLen = end - anchor;
+    *op++ = (uint8_t)(((litLen < RUN_MASK) ? litLen : RUN_MASK) << 4);
+    if (litLen >= RUN_MASK) {
+        op = PutLength(op, litLen - RUN_MASK);
+    }
+    memcpy(op, anchor, litLen);
+    op += litLen;
+    return op - dst;
+}
+
+QStatus LZ4Decompress(const uint8_t* src, size_t srcLen, uint8_t* dst, size_t dstLen, size_t& outLen)
+{
+    const uint8_t* ip = src;
+    const uint8_t* iend = src + srcLen;
+    uint8_t* op = dst;
+    uint8_t* oend = dst + dstLen;
+
+    outLen = 0;
+    if (srcLen == 0) {
+        return ER_INVALID_DATA;
+    }
+    while (ip < iend) {
+        uint8_t token = *ip++;
+        size_t litLen = token >> 4;
+        if ((litLen == RUN_MASK) && !GetLength(ip, iend, litLen)) {
+            return ER_INVALID_DATA;
+        }
+        if ((size_t)(iend - ip) < litLen) {
+            return ER_INVALID_DATA;
+        }
+        if ((size_t)(oend - op) < litLen) {
+            return ER_BUFFER_TOO_SMALL;
+        }
+        memcpy(op, ip, litLen);
+        op += litLen;
+        ip += litLen;
+        /*
+         * The last sequence has literals only
+         */
+        if (ip == iend) {
+            break;
+        }
+        if ((iend - ip) < 2) {
+            return ER_INVALID_DATA;
+        }
+        size_t offset = ip[0] | (ip[1] << 8);
+        ip += 2;
+        if ((offset == 0) || (offset > (size_t)(op - dst))) {
+            return ER_INVALID_DATA;
+        }
+        size_t matchLen = token & RUN_MASK;
+        if ((matchLen == RUN_MASK) && !GetLength(ip, iend, matchLen)) {
+            return ER_INVALID_DATA;
+        }
+        matchLen += MIN_MATCH;
+        if ((size_t)(oend - op) < matchLen) {
+            return ER_BUFFER_TOO_SMALL;
+        }
+        /*
+         * Copy a byte at a time, a match may overlap the bytes it is producing
+         */
+        const uint8_t* ref = op - offset;
+        while (matchLen--) {
+            *op++ = *ref++;
+        }
+    }
+    outLen = op - dst;
+    return ER_OK;
+}
+
+}
@@ -0,0 +1,331 @@
+/**
+ * @file
+ *
+ * Opt-in lock contention profiler for Mutex objects.
+ */
+
+/******************************************************************************
+ *    Copyright (c) Open Connectivity Foundation (OCF), AllJoyn Open Source
+ *    Project (AJOSP) Contributors and others.
+ *
+ *    SPDX-License-Identifier: Apache-2.0
+ *
+ *    All rights reserved. This program and the accompanying materials are
+ *    made available under the terms of the Apache License, Version 2.0
+ *    which accompanies this distribution, and is available at
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Copyright (c) Open Connectivity Foundation and Contributors to AllSeen
+ *    Alliance. All rights reserved.
+ *
+ *    Permission to use, copy, modify, and/or distribute this software for
+ *    any purpose with or without fee is hereby granted, provided that the
+ *    above copyright notice and this permission notice appear in all
+ *    copies.
+ *
+ *    THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+ *    WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+ *    WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ *    AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ *    DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ *    PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+ *    TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ *    PERFORMANCE OF THIS SOFTWARE.
+ ******************************************************************************/
+
+#include <qcc/platform.h>
+
+#include <algorithm>
+#include <chrono>
+#include <map>
+#include <stdio.h>
+#include <string.h>
+
+#include <qcc/atomic.h>
+#include <qcc/Environ.h>
+#include <qcc/LockProfiler.h>
+#include <qcc/StringUtil.h>
+
+#define QCC_MODULE "MUTEX"
+
+/*
+ * The profiler runs inside Mutex::Lock so it cannot use a Mutex, or Thread::GetThread()
+ * which takes one, to find the calling thread's histograms.
+ */
+#if defined(_MSC_VER)
+#define LOCK_PROFILER_THREAD_LOCAL __declspec(thread)
+#else
+#define LOCK_PROFILER_THREAD_LOCAL __thread
+#endif
+
+using namespace std;
+using namespace qcc;
+
+volatile bool LockProfiler::s_enabled = false;
+volatile uint32_t LockProfiler::s_sampleInterval = 1;
+volatile int32_t LockProfiler::s_generation = 0;
+LockProfiler::ThreadProfile* volatile LockProfiler::s_profiles = NULL;
+
+/**
+ * The sites recorded by one thread. Profiles are never freed so the samples of threads
+ * that have exited are still reported.
+ */
+class LockProfiler::ThreadProfile {
+  public:
+    /* Sites are kept in a fixed size open addressed table, samples for sites that do not fit are dropped */
+    static const size_t MAX_SITES = 256;
+
+    ThreadProfile() : next(NULL), generation(s_generation), sampleCount(0), dropped(0), suspendedFile(NULL), suspendedLine(0), suspended(false)
+    {
+        memset(sites, 0, sizeof(sites));
+    }
+
+    LockSiteStats* Find(const char* file, uint32_t line)
+    {
+        if (generation != s_generation) {
+            memset(sites, 0, sizeof(sites));
+            dropped = 0;
+            generation = s_generation;
+        }
+        size_t hash = ((reinterpret_cast<size_t>(file) >> 3) ^ (line * 2654435761u)) % MAX_SITES;
+        for (size_t i = 0; i < MAX_SITES; ++i) {
+            LockSiteStats& site = sites[(hash + i) % MAX_SITES];
+            if ((site.file == file) && (site.line == line) && (site.acquisitions || site.holdNs)) {
+                return &site;
+            }
+            if ((site.acquisitions == 0) && (site.holdNs == 0)) {
+                site.file = file;
+                site.line = line;
+                return &site;
+            }
+        }
+        ++dropped;
+        return NULL;
+    }
+
+    ThreadProfile* next;
+    int32_t generation;
+    uint32_t sampleCount;
+    uint64_t dropped;
+    const char* suspendedFile;
+    uint32_t suspendedLine;
+    bool suspended;
+    LockSiteStats sites[MAX_SITES];
+};
+
+/* The calling thread's LockProfiler::ThreadProfile */
+static LOCK_PROFILER_THREAD_LOCAL void* s_threadProfile = NULL;
+
+static inline size_t Bucket(uint64_t ns)
+{
+    size_t bucket = 0;
+    while ((ns >>= 1) && (bucket < LockSiteStats::HISTOGRAM_BUCKETS - 1)) {
+        ++bucket;
+    }
+    return bucket;
+}
+
+uint64_t LockSiteStats::Percentile(const uint32_t* histogram, double percentile)
+{
+    uint64_t total = 0;
+    for (size_t i = 0; i < HISTOGRAM_BUCKETS; ++i) {
+        total += histogram[i];
+    }
+    if (total == 0) {
+        return 0;
+    }
+    uint64_t rank = static_cast<uint64_t>((percentile / 100.0) * total + 0.5);
+    rank = (rank == 0) ? 1 : rank;
+    uint64_t seen = 0;
+    for (size_t i = 0; i < HISTOGRAM_BUCKETS; ++i) {
+        seen += histogram[i];
+        if (seen >= rank) {
+            return static_cast<uint64_t>(1) << (i + 1);
+        }
+    }
+    return static_cast<uint64_t>(1) << HISTOGRAM_BUCKETS;
+}
+
+void LockProfiler::Init()
+{
+    qcc::String interval = Environ::GetAppEnviron()->Find("ER_LOCK_PROFILE");
+    if (!interval.empty()) {
+        uint32_t n = StringToU32(interval, 10, 0);
+        SetEnabled(n != 0, n);
+    }
+}
+
+void LockProfiler::SetEnabled(bool enabled, uint32_t sampleInterval)
+{
+    s_sampleInterval = (sampleInterval == 0) ? 1 : sampleInterval;
+    s_enabled = enabled;
+}
+
+void LockProfiler::Reset()
+{
+    IncrementAndFetch(&s_generation);
+}
+
+uint64_t LockProfiler::Now()
+{
+    return chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+LockProfiler::ThreadProfile* LockProfiler::GetThreadProfile()
+{
+    ThreadProfile* profile = static_cast<ThreadProfile*>(s_threadProfile);
+    if (!profile) {
+        profile = new ThreadProfile();
+        do {
+            profile->next = s_profiles;
+        } while (!CompareAndExchangePointer(reinterpret_cast<void* volatile*>(&s_profiles), profile->next, profile));
+        s_threadProfile = profile;
+    }
+    return profile;
+}
+
+bool LockProfiler::ShouldSample()
+{
+    uint32_t interval = s_sampleInterval;
+    if (interval <= 1) {
+        return true;
+    }
+    ThreadProfile* profile = GetThreadProfile();
+    if (++profile->sampleCount >= interval) {
+        profile->sampleCount = 0;
+        return true;
+    }
+    return false;
+}
+
+void LockProfiler::RecordAcquire(const char* file, uint32_t line, uint64_t waitNs, bool contended)
+{
+    LockSiteStats* site = GetThreadProfile()->Find(file, line);
+    if (site) {
+        ++site->acquisitions;
+        if (contended) {
+            ++site->contended;
+            site->waitNs += waitNs;
+            site->maxWaitNs = max(site->maxWaitNs, waitNs);
+            ++site->waitHistogram[Bucket(waitNs)];
+        }
+    }
+}
+
+void LockProfiler::RecordRelease(const char* file, uint32_t line, uint64_t holdNs)
+{
+    LockSiteStats* site = GetThreadProfile()->Find(file, line);
+    if (site) {
+        site->holdNs += holdNs;
+        site->maxHoldNs = max(site->maxHoldNs, holdNs);
+        ++site->holdHistogram[Bucket(holdNs)];
+    }
+}
+
+void LockProfiler::SuspendHold(const char* file, uint32_t line)
+{
+    ThreadProfile* profile = GetThreadProfile();
+    profile->suspendedFile = file;
+    profile->suspendedLine = line;
+    profile->suspended = true;
+}
+
+bool LockProfiler::ResumeHold(const char*& file, uint32_t& line)
+{
+    ThreadProfile* profile = static_cast<ThreadProfile*>(s_threadProfile);
+    if (!profile || !profile->suspended) {
+        return false;
+    }
+    file = profile->suspendedFile;
+    line = profile->suspendedLine;
+    profile->suspended = false;
+    return true;
+}
+
+static bool SiteByName(const LockSiteStats& a, const LockSiteStats& b)
+{
+    int cmp = strcmp(a.file ? a.file : "", b.file ? b.file : "");
+    return (cmp != 0) ? (cmp < 0) : (a.line < b.line);
+}
+
+static bool SiteByWait(const LockSiteStats& a, const LockSiteStats& b)
+{
+    return (a.waitNs != b.waitNs) ? (a.waitNs > b.waitNs) : (a.holdNs > b.holdNs);
+}
+
+void LockProfiler::GetSiteStats(vector<LockSiteStats>& stats)
+{
+    stats.clear();
+    int32_t generation = s_generation;
+    for (ThreadProfile* profile = s_profiles; profile; profile = profile->next) {
+        if (profile->generation != generation) {
+            continue;
+        }
+        for (size_t i = 0; i < ThreadProfile::MAX_SITES; ++i) {
+            const LockSiteStats& site = profile->sites[i];
+            if (site.acquisitions || site.holdNs) {
+                stats.push_back(site);
+            }
+        }
+    }
+
+    /* The same site shows up once per thread that used it, and __FILE__ may not be pooled across translation units */
+    sort(stats.begin(), stats.end(), SiteByName);
+    size_t out = 0;
+    for (size_t i = 0; i < stats.size(); ++i) {
+        if ((out > 0) && !SiteByName(stats[out - 1], stats[i])) {
+            LockSiteStats& merged = stats[out - 1];
+            merged.acquisitions += stats[i].acquisitions;
+            merged.contended += stats[i].contended;
+            merged.waitNs += stats[i].waitNs;
+            merged.maxWaitNs = max(merged.maxWaitNs, stats[i].maxWaitNs);
+            merged.holdNs += stats[i].holdNs;
+            merged.maxHoldNs = max(merged.maxHoldNs, stats[i].maxHoldNs);
+            for (size_t b = 0; b < LockSiteStats::HISTOGRAM_BUCKETS; ++b) {
+                merged.waitHistogram[b] += stats[i].waitHistogram[b];
+                merged.holdHistogram[b] += stats[i].holdHistogram[b];
+            }
+        } else {
+            stats[out++] = stats[i];
+        }
+    }
+    stats.resize(out);
+    sort(stats.begin(), stats.end(), SiteByWait);
+}
+
+qcc::String LockProfiler::Dump(size_t maxSites)
+{
+    vector<LockSiteStats> stats;
+    GetSiteStats(stats);
+
+    uint64_t dropped = 0;
+    int32_t generation = s_generation;
+    for (ThreadProfile* profile = s_profiles; profile; profile = profile->next) {
+        dropped += (profile->generation == generation) ? profile->dropped : 0;
+    }
+
+    char line[256];
+    snprintf(line, sizeof(line), "Lock profile: %s, 1 in %u acquisitions sampled, %u sites, %llu samples dropped\n",
+             s_enabled ? "enabled" : "disabled", s_sampleInterval, static_cast<uint32_t>(stats.size()),
+             static_cast<unsigned long long>(dropped));
+    qcc::String out = line;
+    snprintf(line, sizeof(line), "%10s %10s %10s %6s %10s %10s %10s %10s %10s  %s\n",
+             "wait ms", "hold ms", "samples", "cont%", "p50 w us", "p99 w us", "max w us", "p99 h us", "max h us", "site");
+    out += line;
+
+    size_t count = (maxSites && (maxSites < stats.size())) ? maxSites : stats.size();
+    for (size_t i = 0; i < count; ++i) {
+        const LockSiteStats& s = stats[i];
+        const char* file = s.file ? s.file : "(no MUTEX_CONTEXT)";
+        const char* slash = strrchr(file, '/');
+        const char* backslash = strrchr(file, '\\');
+        file = (slash > backslash) ? slash + 1 : (backslash ? backslash + 1 : file);
+        snprintf(line, sizeof(line), "%10.3f %10.3f %10llu %6.1f %10.1f %10.1f %10.1f %10.1f %10.1f  %s:%u\n",
+                 s.waitNs / 1e6, s.holdNs / 1e6, static_cast<unsigned long long>(s.acquisitions),
+                 s.acquisitions ? (100.0 * s.contended / s.acquisitions) : 0.0,
+                 s.WaitPercentileNs(50) / 1e3, s.WaitPercentileNs(99) / 1e3, s.maxWaitNs / 1e3,
+                 s.HoldPercentileNs(99) / 1e3, s.maxHoldNs / 1e3, file, s.line);
+        out += line;
+    }
+    return out;
+}
@@ -35,6 +35,7 @@
 #include <qcc/platform.h>
 #include <qcc/Mutex.h>
 #include <qcc/MutexInternal.h>
+#include <qcc/LockProfiler.h>
 #include <qcc/Debug.h>
 
 #define QCC_MODULE "MUTEX"
@@ -54,6 +55,12 @@ MutexInternal::MutexInternal(Mutex* ownerLock, LockLevel level)
     m_level = level;
     m_ownerLock = ownerLock;
 #endif
+#ifdef QCC_LOCK_PROFILER
+    m_profileFile = NULL;
+    m_profileLine = 0;
+    m_profileDepth = 0;
+    m_profileAcquiredNs = 0;
+#endif
 
     m_initialized = PlatformSpecificInit();
     QCC_ASSERT(m_initialized);
@@ -72,9 +79,7 @@ QStatus MutexInternal::Lock(const char* file, uint32_t line)
     QCC_ASSERT(m_initialized);
 
 #ifdef NDEBUG
-    QCC_UNUSED(file);
-    QCC_UNUSED(line);
-    return Lock();
+    return LockInternal(file, line);
 #else
     if (!m_initialized) {
         return ER_INIT_FAILED;
@@ -87,7 +92,7 @@ QStatus MutexInternal::Lock(const char* file, uint32_t line)
      * Release code path could have inflicted a small perf overhead.
      */
     AcquiringLock(file, line);
-    QStatus status = PlatformSpecificLock();
+    QStatus status = AcquireLock(file, line);
     if (status == ER_OK) {
         QCC_DbgPrintf(("Lock Acquired %s:%d", file, line));
         m_file = file;
@@ -101,6 +106,11 @@ QStatus MutexInternal::Lock(const char* file, uint32_t line)
 }
 
 QStatus MutexInternal::Lock()
+{
+    return LockInternal(NULL, 0);
+}
+
+QStatus MutexInternal::LockInternal(const char* file, uint32_t line)
 {
     QCC_ASSERT(m_initialized);
     if (!m_initialized) {
@@ -108,7 +118,7 @@ QStatus MutexInternal::Lock()
     }
 
     AcquiringLock();
-    QStatus status = PlatformSpecificLock();
+    QStatus status = AcquireLock(file, line);
     if (status == ER_OK) {
         LockAcquired();
     }
@@ -116,6 +126,59 @@ QStatus MutexInternal::Lock()
     return status;
 }
 
+QStatus MutexInternal::AcquireLock(const char* file, uint32_t line)
+{
+#ifdef QCC_LOCK_PROFILER
+    /* A timed hold must keep counting recursive acquisitions even if the profiler was just disabled */
+    if (LockProfiler::IsEnabled() || (m_profileDepth != 0)) {
+        return ProfiledLock(file, line);
+    }
+#else
+    QCC_UNUSED(file);
+    QCC_UNUSED(line);
+#endif
+    return PlatformSpecificLock();
+}
+
+#ifdef QCC_LOCK_PROFILER
+QStatus MutexInternal::ProfiledLock(const char* file, uint32_t line)
+{
+    bool sampled = LockProfiler::ShouldSample();
+    uint64_t start = 0;
+    bool contended = false;
+    QStatus status = ER_OK;
+
+    if (sampled) {
+        start = LockProfiler::Now();
+        contended = !PlatformSpecificTryLock();
+    }
+    if (!sampled || contended) {
+        status = PlatformSpecificLock();
+    }
+    if (status == ER_OK) {
+        if (m_profileDepth != 0) {
+            /* Recursive acquire by the thread whose hold is being timed */
+            ++m_profileDepth;
+        } else if (sampled) {
+            uint64_t now = contended ? LockProfiler::Now() : start;
+            m_profileFile = file;
+            m_profileLine = line;
+            m_profileDepth = 1;
+            m_profileAcquiredNs = now;
+            LockProfiler::RecordAcquire(file, line, now - start, contended);
+        }
+    }
+    return status;
+}
+
+void MutexInternal::ProfiledUnlock()
+{
+    if (--m_profileDepth == 0) {
+        LockProfiler::RecordRelease(m_profileFile, m_profileLine, LockProfiler::Now() - m_profileAcquiredNs);
+    }
+}
+#endif
+
 QStatus MutexInternal::Unlock(const char* file, uint32_t line)
 {
     QCC_ASSERT(m_initialized);
@@ -140,6 +203,11 @@ QStatus MutexInternal::Unlock()
     }
 
     ReleasingLock();
+#ifdef QCC_LOCK_PROFILER
+    if (m_profileDepth != 0) {
+        ProfiledUnlock();
+    }
+#endif
     return PlatformSpecificUnlock();
 }
 
@@ -172,6 +240,11 @@ bool MutexInternal::TryLock()
     AcquiringLock();
     bool locked = PlatformSpecificTryLock();
     if (locked) {
+#ifdef QCC_LOCK_PROFILER
+        if (m_profileDepth != 0) {
+            ++m_profileDepth;
+        }
+#endif
         LockAcquired();
     }
     return locked;
@@ -236,6 +309,18 @@ void MutexInternal::LockAcquired()
 
 void MutexInternal::LockAcquired(Mutex& lock)
 {
+#ifdef QCC_LOCK_PROFILER
+    /* Resume timing a hold that was interrupted by a Condition wait */
+    MutexInternal* internal = lock.m_mutexInternal;
+    const char* file;
+    uint32_t line;
+    if ((internal->m_profileDepth == 0) && LockProfiler::ResumeHold(file, line)) {
+        internal->m_profileFile = file;
+        internal->m_profileLine = line;
+        internal->m_profileDepth = 1;
+        internal->m_profileAcquiredNs = LockProfiler::Now();
+    }
+#endif
     lock.m_mutexInternal->LockAcquired();
 }
 
@@ -270,6 +355,17 @@ void MutexInternal::ReleasingLock()
 void MutexInternal::ReleasingLock(Mutex& lock)
 {
     lock.m_mutexInternal->ReleasingLock();
+#ifdef QCC_LOCK_PROFILER
+    /* A Condition wait releases the lock, the time spent waiting does not count as holding it */
+    MutexInternal* internal = lock.m_mutexInternal;
+    if (internal->m_profileDepth != 0) {
+        const char* file = internal->m_profileFile;
+        uint32_t line = internal->m_profileLine;
+        internal->m_profileDepth = 1;
+        internal->ProfiledUnlock();
+        LockProfiler::SuspendHold(file, line);
+    }
+#endif
 }
 
 /**
@@ -360,3 +360,12 @@ QStatus SocketStream::SetNagle(bool reuse)
         return ER_OS_ERROR;
     }
 }
+
+QStatus SocketStream::SetCork(bool cork)
+{
+    if (sock != qcc::INVALID_SOCKET_FD) {
+        return qcc::SetCork(sock, cork);
+    } else {
+        return ER_OS_ERROR;
+    }
+}
@@ -36,6 +36,7 @@
 #ifdef CRYPTO_CNG
 #include <qcc/CngCache.h>
 #endif
+#include <qcc/LockProfiler.h>
 #include <qcc/Logger.h>
 #include <qcc/String.h>
 #include <qcc/Thread.h>
@@ -75,6 +76,7 @@ class StaticGlobals {
         String::Init();
         DebugControl::Init();
         LoggerSetting::Init();
+        LockProfiler::Init();
         QStatus status = Thread::StaticInit();
         if (status != ER_OK) {
             Shutdown();
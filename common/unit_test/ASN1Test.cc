@@ -343,3 +343,60 @@ TEST(ASN1Test, encode_and_decode_base64_stress_test) {
         }
     }
 }
+
+TEST(ASN1Test, reader_matches_decode) {
+    String oid("1.2.840.10045.4.3.2");
+    String serial("\x00\x81\x02", 3);
+    String octets("octets");
+    String inner;
+    String asn;
+
+    ASSERT_EQ(ER_OK, Crypto_ASN1::Encode(inner, "c(x)", 1, &octets));
+    ASSERT_EQ(ER_OK, Crypto_ASN1::Encode(asn, "(c(i)l(o)zR)", 0, 2, &serial, &oid, 1, &inner));
+
+    Crypto_ASN1::Reader reader((const uint8_t*) asn.data(), asn.size());
+    Crypto_ASN1::Reader seq;
+    Crypto_ASN1::Reader version;
+    Crypto_ASN1::Reader alg;
+    Crypto_ASN1::Reader tagged;
+    Crypto_ASN1::View raw;
+    Crypto_ASN1::View view;
+    uint32_t v = 0;
+    String decodedOid;
+
+    ASSERT_EQ(ER_OK, reader.ReadSequence(seq, &raw));
+    EXPECT_EQ(asn.data(), (const char*) raw.data);
+    EXPECT_EQ(asn.size(), raw.len);
+    ASSERT_EQ(ER_OK, seq.ReadContext(0, version));
+    ASSERT_EQ(ER_OK, version.ReadInteger(v));
+    EXPECT_EQ(2U, v);
+    EXPECT_EQ(ER_OK, version.ExpectEnd());
+
+    /* The leading zero is suppressed, the same as the 'l' syntax character */
+    ASSERT_EQ(ER_OK, seq.ReadInteger(view));
+    EXPECT_EQ(String("\x81\x02", 2), view.ToString());
+
+    /* A failed read does not consume the element */
+    EXPECT_EQ(ER_FAIL, seq.ReadBoolean(v));
+    ASSERT_EQ(ER_OK, seq.ReadSequence(alg));
+    ASSERT_EQ(ER_OK, alg.ReadOID(decodedOid));
+    EXPECT_EQ(oid, decodedOid);
+    ASSERT_EQ(ER_OK, seq.ReadBoolean(v));
+    EXPECT_NE(0U, v);
+    ASSERT_EQ(ER_OK, seq.ReadContext(1, tagged));
+    ASSERT_EQ(ER_OK, tagged.ReadOctets(view));
+    EXPECT_EQ(octets, view.ToString());
+
+    EXPECT_TRUE(seq.AtEnd());
+    EXPECT_EQ(ER_FAIL, seq.Skip());
+    EXPECT_EQ(ER_OK, reader.ExpectEnd());
+
+    /* Unexpected elements fail the same way as Decode() */
+    String trailing = asn + inner;
+    Crypto_ASN1::Reader top((const uint8_t*) trailing.data(), trailing.size());
+    ASSERT_EQ(ER_OK, top.Skip());
+    EXPECT_EQ(Crypto_ASN1::Decode(trailing, "(.)", &inner), top.ExpectEnd());
+    ASSERT_EQ(ER_OK, Crypto_ASN1::Reader(Crypto_ASN1::View((const uint8_t*) trailing.data(), trailing.size())).ReadSequence(seq));
+    ASSERT_EQ(ER_OK, seq.Skip());
+    EXPECT_EQ(ER_FAIL, seq.ExpectEnd());
+}
@@ -0,0 +1,200 @@
+/******************************************************************************
+ *    Copyright (c) Open Connectivity Foundation (OCF), AllJoyn Open Source
+ *    Project (AJOSP) Contributors and others.
+ *
+ *    SPDX-License-Identifier: Apache-2.0
+ *
+ *    All rights reserved. This program and the accompanying materials are
+ *    made available under the terms of the Apache License, Version 2.0
+ *    which accompanies this distribution, and is available at
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Copyright (c) Open Connectivity Foundation and Contributors to AllSeen
+ *    Alliance. All rights reserved.
+ *
+ *    Permission to use, copy, modify, and/or distribute this software for
+ *    any purpose with or without fee is hereby granted, provided that the
+ *    above copyright notice and this permission notice appear in all
+ *    copies.
+ *
+ *    THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+ *    WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+ *    WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ *    AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ *    DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ *    PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+ *    TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ *    PERFORMANCE OF THIS SOFTWARE.
+ ******************************************************************************/
+
+/* These tests apply only to the OpenSSL crypto backend. */
+#ifdef CRYPTO_OPENSSL
+
+#include <gtest/gtest.h>
+#include <qcc/Crypto.h>
+#include <qcc/KeyBlob.h>
+#include <qcc/Thread.h>
+#include <qcc/Util.h>
+#include <qcc/time.h>
+
+#include <memory>
+#include <vector>
+
+using namespace qcc;
+
+/*
+ * These tests have multiple threads that all encrypt, decrypt and hash at the same time with no
+ * lock around the OpenSSL calls. Every thread must come away with exactly the same results as a
+ * single thread doing the same work.
+ */
+
+static const int numThreads = 8;
+static const int messagesPerThread = 2000;
+static const size_t messageLen = 256;
+static const size_t hdrLen = 16;
+static const uint8_t authLen = 8;
+
+typedef struct {
+    uint8_t id;
+    uint8_t digest[Crypto_SHA256::DIGEST_SIZE];
+} CcmThroughputTestResult;
+
+static QStatus EncryptDecryptMessages(CcmThroughputTestResult* result)
+{
+    QStatus status;
+    uint8_t keyData[Crypto_AES::AES128_SIZE];
+    memset(keyData, 0x5A, sizeof(keyData));
+    KeyBlob key(keyData, sizeof(keyData), KeyBlob::AES);
+    Crypto_AES aes(key, Crypto_AES::CCM);
+    Crypto_SHA256 hash;
+    status = hash.Init();
+    if (ER_OK != status) {
+        return status;
+    }
+
+    for (int i = 0; i < messagesPerThread; i++) {
+        uint8_t nonceData[13];
+        memset(nonceData, 0, sizeof(nonceData));
+        nonceData[0] = result->id;
+        nonceData[1] = static_cast<uint8_t>(i >> 8);
+        nonceData[2] = static_cast<uint8_t>(i);
+        KeyBlob nonce(nonceData, sizeof(nonceData), KeyBlob::GENERIC);
+
+        uint8_t plain[messageLen];
+        uint8_t msg[messageLen + authLen];
+        for (size_t j = 0; j < messageLen; j++) {
+            plain[j] = static_cast<uint8_t>(j + i + result->id);
+        }
+        memcpy(msg, plain, messageLen);
+        size_t len = messageLen;
+        status = aes.Encrypt_CCM(msg, len, hdrLen, nonce, authLen);
+        if (ER_OK != status) {
+            return status;
+        }
+        status = hash.Update(msg, len);
+        if (ER_OK != status) {
+            return status;
+        }
+        status = aes.Decrypt_CCM(msg, len, hdrLen, nonce, authLen);
+        if (ER_OK != status) {
+            return status;
+        }
+        if ((len != messageLen) || (memcmp(msg, plain, messageLen) != 0)) {
+            return ER_FAIL;
+        }
+    }
+    return hash.GetDigest(result->digest);
+}
+
+static ThreadReturn STDCALL CcmThroughputThreadRun(void* arg)
+{
+    return reinterpret_cast<ThreadReturn>(EncryptDecryptMessages(reinterpret_cast<CcmThroughputTestResult*>(arg)));
+}
+
+TEST(CryptoOpenSslMultithreadTest, ConcurrentAesCcmAndHash)
+{
+    CcmThroughputTestResult results[numThreads];
+    std::vector<std::unique_ptr<Thread> > threads(numThreads);
+
+    memset(results, 0, sizeof(results));
+    for (size_t i = 0; i < threads.size(); i++) {
+        results[i].id = static_cast<uint8_t>(i);
+        threads[i].reset(new Thread("", CcmThroughputThreadRun, false));
+    }
+
+    uint64_t start = GetTimestamp64();
+    for (size_t i = 0; i < threads.size(); i++) {
+        ASSERT_EQ(ER_OK, threads[i]->Start(&results[i]));
+    }
+    for (size_t i = 0; i < threads.size(); i++) {
+        ASSERT_EQ(ER_OK, threads[i]->Join());
+        ASSERT_FALSE(threads[i]->IsRunning());
+        ASSERT_EQ(reinterpret_cast<ThreadReturn>(ER_OK), threads[i]->GetExitValue());
+    }
+    uint64_t elapsed = GetTimestamp64() - start;
+    printf("%d threads encrypted, hashed and decrypted %d messages in %u ms\n",
+           numThreads, numThreads * messagesPerThread, static_cast<unsigned int>(elapsed));
+
+    /* Redo the work of every thread on this thread and compare */
+    for (size_t i = 0; i < ArraySize(results); i++) {
+        CcmThroughputTestResult expected;
+        expected.id = results[i].id;
+        ASSERT_EQ(ER_OK, EncryptDecryptMessages(&expected));
+        EXPECT_EQ(0, memcmp(expected.digest, results[i].digest, sizeof(expected.digest)));
+    }
+}
+
+static ThreadReturn STDCALL HashReuseThreadRun(void* arg)
+{
+    uint8_t* digest = reinterpret_cast<uint8_t*>(arg);
+    uint8_t data[64];
+    memset(data, 0xA5, sizeof(data));
+    Crypto_SHA256 hash;
+    Crypto_SHA256 hmac;
+    uint8_t hmacKey[] = { 1, 2, 3, 4, 5, 6, 7, 8 };
+
+    /* Reinitializing the same objects over and over must give the same digest every time */
+    for (int i = 0; i < messagesPerThread; i++) {
+        uint8_t md[Crypto_SHA256::DIGEST_SIZE];
+        uint8_t mac[Crypto_SHA256::DIGEST_SIZE];
+        if ((ER_OK != hash.Init()) || (ER_OK != hash.Update(data, sizeof(data))) || (ER_OK != hash.GetDigest(md, true))) {
+            return reinterpret_cast<ThreadReturn>(ER_CRYPTO_ERROR);
+        }
+        if ((ER_OK != hash.Update(data, sizeof(data))) || (ER_OK != hash.GetDigest(md))) {
+            return reinterpret_cast<ThreadReturn>(ER_CRYPTO_ERROR);
+        }
+        if ((ER_OK != hmac.Init(hmacKey, sizeof(hmacKey))) || (ER_OK != hmac.Update(md, sizeof(md))) || (ER_OK != hmac.GetDigest(mac))) {
+            return reinterpret_cast<ThreadReturn>(ER_CRYPTO_ERROR);
+        }
+        if (0 == i) {
+            memcpy(digest, mac, sizeof(mac));
+        } else if (memcmp(digest, mac, sizeof(mac)) != 0) {
+            return reinterpret_cast<ThreadReturn>(ER_FAIL);
+        }
+    }
+    return reinterpret_cast<ThreadReturn>(ER_OK);
+}
+
+TEST(CryptoOpenSslMultithreadTest, ReinitializedHashes)
+{
+    uint8_t digests[numThreads][Crypto_SHA256::DIGEST_SIZE];
+    std::vector<std::unique_ptr<Thread> > threads(numThreads);
+
+    memset(digests, 0, sizeof(digests));
+    for (size_t i = 0; i < threads.size(); i++) {
+        threads[i].reset(new Thread("", HashReuseThreadRun, false));
+    }
+    for (size_t i = 0; i < threads.size(); i++) {
+        ASSERT_EQ(ER_OK, threads[i]->Start(digests[i]));
+    }
+    for (size_t i = 0; i < threads.size(); i++) {
+        ASSERT_EQ(ER_OK, threads[i]->Join());
+        ASSERT_FALSE(threads[i]->IsRunning());
+        ASSERT_EQ(reinterpret_cast<ThreadReturn>(ER_OK), threads[i]->GetExitValue());
+    }
+    for (size_t i = 1; i < ArraySize(digests); i++) {
+        EXPECT_EQ(0, memcmp(digests[0], digests[i], sizeof(digests[0])));
+    }
+}
+
+#endif /* CRYPTO_OPENSSL */
@@ -41,6 +41,7 @@
 #include <qcc/Debug.h>
 #include <qcc/String.h>
 #include <qcc/StringUtil.h>
+#include <qcc/Thread.h>
 #include <qcc/Util.h>
 
 #include <Status.h>
@@ -118,3 +119,38 @@ TEST(DRBG_Test, DRBG_Test_Vector) {
     status = Crypto_GetRandomBytes(data, sizeof(data));
     EXPECT_EQ(ER_OK, status) << "  Generate error " << QCC_StatusText(status);
 }
+
+static const size_t RAND_THREAD_BYTES = 64 * 16;
+
+static ThreadReturn STDCALL RandThread(void* arg)
+{
+    uint8_t* data = reinterpret_cast<uint8_t*>(arg);
+    for (size_t i = 0; i < RAND_THREAD_BYTES; i += 16) {
+        if (Crypto_GetRandomBytes(data + i, 16) != ER_OK) {
+            return reinterpret_cast<ThreadReturn>(1);
+        }
+    }
+    return 0;
+}
+
+TEST(DRBG_Test, GetRandomBytesFromManyThreads) {
+    static const size_t NUM_THREADS = 8;
+    uint8_t data[NUM_THREADS][RAND_THREAD_BYTES];
+    Thread* threads[NUM_THREADS];
+
+    for (size_t i = 0; i < NUM_THREADS; i++) {
+        threads[i] = new Thread("RandThread", RandThread);
+        ASSERT_EQ(ER_OK, threads[i]->Start(data[i]));
+    }
+    for (size_t i = 0; i < NUM_THREADS; i++) {
+        threads[i]->Join();
+        EXPECT_EQ(0, reinterpret_cast<uintptr_t>(threads[i]->GetExitValue()));
+        delete threads[i];
+    }
+    /* Each thread has its own generator, no two threads may produce the same output */
+    for (size_t i = 0; i < NUM_THREADS; i++) {
+        for (size_t j = i + 1; j < NUM_THREADS; j++) {
+            EXPECT_NE(0, memcmp(data[i], data[j], 16));
+        }
+    }
+}
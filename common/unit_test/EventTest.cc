@@ -28,6 +28,13 @@
  ******************************************************************************/
 #include <gtest/gtest.h>
 
+#if defined(QCC_OS_LINUX)
+#include <fcntl.h>
+#include <sys/resource.h>
+#include <sys/select.h>
+#include <unistd.h>
+#endif
+
 #include <qcc/Event.h>
 #include <qcc/time.h>
 
@@ -176,3 +183,48 @@ TEST(EventTest, Above64HandlesTO)
     RunEventTest(1000, 1, T2, T1);
 #endif
 }
+
+#if defined(QCC_OS_LINUX)
+/*
+ * Descriptors numbered FD_SETSIZE or above cannot be waited on with select(), make sure
+ * Event::Wait handles them since a busy router easily has that many sockets open.
+ */
+TEST(EventTest, HighNumberedFd)
+{
+    struct rlimit rl;
+    ASSERT_EQ(0, getrlimit(RLIMIT_NOFILE, &rl));
+    if (rl.rlim_cur < (rlim_t)(FD_SETSIZE + 64)) {
+        rl.rlim_cur = (rl.rlim_max < (rlim_t)(FD_SETSIZE + 64)) ? rl.rlim_max : (rlim_t)(FD_SETSIZE + 64);
+        setrlimit(RLIMIT_NOFILE, &rl);
+    }
+
+    int fds[2];
+    ASSERT_EQ(0, pipe(fds));
+    int readFd = fcntl(fds[0], F_DUPFD, FD_SETSIZE + 16);
+    close(fds[0]);
+    if (readFd < 0) {
+        close(fds[1]);
+        return;
+    }
+    ASSERT_LE(FD_SETSIZE, readFd);
+
+    Event readEvent(readFd, Event::IO_READ);
+    EXPECT_EQ(ER_TIMEOUT, Event::Wait(readEvent, 10));
+
+    Event idleEvent;
+    std::vector<Event*> checkEvents;
+    checkEvents.push_back(&idleEvent);
+    checkEvents.push_back(&readEvent);
+    std::vector<Event*> signalEvents;
+    EXPECT_EQ(ER_TIMEOUT, Event::Wait(checkEvents, signalEvents, 10));
+
+    ASSERT_EQ(1, write(fds[1], "x", 1));
+    EXPECT_EQ(ER_OK, Event::Wait(readEvent, 1000));
+    EXPECT_EQ(ER_OK, Event::Wait(checkEvents, signalEvents, 1000));
+    ASSERT_EQ(1U, signalEvents.size());
+    EXPECT_EQ(&readEvent, signalEvents[0]);
+
+    close(readFd);
+    close(fds[1]);
+}
+#endif
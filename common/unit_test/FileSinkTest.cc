@@ -99,3 +99,32 @@ TEST(FileSinkTest, invalidFileSink) {
     //QStatus status = DeleteFile(foofile);
     //EXPECT_EQ(ER_OK, status) << "Status: " << QCC_StatusText(status) << " File: " << foofile.c_str();
 }
+
+#ifndef _WIN32
+TEST(FileSinkTest, replaceFileUnderWriteLock) {
+    const char* fileName = "alljoynTestReplaceFile";
+    FileLocker locker(fileName);
+    char buf[32];
+    size_t pulled = 0;
+
+    /* Replacing the file requires the write lock */
+    EXPECT_EQ(ER_BUS_NOT_ALLOWED, locker.ReplaceFile("old", 3));
+
+    ASSERT_EQ(ER_OK, locker.AcquireWriteLock());
+    EXPECT_EQ(ER_OK, locker.ReplaceFile("hello world", 11));
+    EXPECT_EQ(ER_OK, locker.ReplaceFile("new", 3));
+    EXPECT_TRUE(locker.HasWriteLock());
+    locker.ReleaseWriteLock();
+
+    /* A shared read lock sees the complete new contents, read from the mapped file */
+    FileLock readLock;
+    ASSERT_EQ(ER_OK, locker.GetFileLockForRead(&readLock));
+    EXPECT_EQ(ER_OK, readLock.GetSource()->PullBytes(buf, sizeof(buf), pulled));
+    EXPECT_EQ(3U, pulled);
+    EXPECT_EQ(0, memcmp(buf, "new", 3));
+    EXPECT_EQ(ER_EOF, readLock.GetSource()->PullBytes(buf, sizeof(buf), pulled));
+    readLock.Release();
+
+    EXPECT_EQ(ER_OK, DeleteFile(fileName));
+}
+#endif
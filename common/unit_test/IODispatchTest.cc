@@ -31,6 +31,7 @@
 
 #include <qcc/Condition.h>
 #include <qcc/IODispatch.h>
+#include <qcc/Thread.h>
 
 using namespace qcc;
 
@@ -127,3 +128,75 @@ TEST_F(IODispatchStopStreamTest, WhenStreamIsStarted_Stop)
     l.WaitForExitCallback();
     l.ReturnFromExitCallback();
 }
+
+
+class IODispatchTimeoutAlarmTest : public testing::Test {
+  public:
+    class Listener : public IOReadListener, public IOWriteListener, public IOExitListener {
+      public:
+        virtual ~Listener() { }
+        virtual QStatus ReadCallback(Source&, bool) { return ER_OK; }
+        virtual QStatus WriteCallback(Sink&, bool) { return ER_OK; }
+        virtual void ExitCallback() { }
+    };
+
+    /* A stream that never becomes readable or writable so only its timeout alarms are pending */
+    class IdleStream : public Stream {
+      public:
+        virtual Event& GetSinkEvent() { return Event::neverSet; }
+    };
+
+    /* Enables the timeout callbacks of all streams, this blocks if the timer runs out of alarms */
+    class EnableThread : public Thread {
+      public:
+        EnableThread(IODispatchTimeoutAlarmTest& test) : Thread("EnableThread"), test(test) { }
+
+        Event done;
+
+      protected:
+        ThreadReturn STDCALL Run(void*) {
+            for (size_t i = 0; i < NUM_STREAMS; ++i) {
+                EXPECT_EQ(ER_OK, test.io.EnableReadCallback(&test.streams[i], TIMEOUT));
+                EXPECT_EQ(ER_OK, test.io.EnableTimeoutCallback(&test.streams[i], TIMEOUT));
+                EXPECT_EQ(ER_OK, test.io.EnableWriteCallback(&test.streams[i], TIMEOUT));
+            }
+            done.SetEvent();
+            return 0;
+        }
+
+      private:
+        IODispatchTimeoutAlarmTest& test;
+    };
+
+    /* More streams than the 96 alarms the IODispatch timer allows */
+    static const size_t NUM_STREAMS = 128;
+    static const uint32_t TIMEOUT = 60;
+
+    IdleStream streams[NUM_STREAMS];
+    Listener l;
+    IODispatch io;
+
+    IODispatchTimeoutAlarmTest() : io("IODispatchTimeoutAlarmTest", 4) { }
+};
+
+/*
+ * Every connected stream keeps its read or write timeout alarm pending for as long as it is idle.
+ * These alarms must not count towards the timer's alarm limit, otherwise the limit caps the
+ * number of streams a router can serve.
+ */
+TEST_F(IODispatchTimeoutAlarmTest, TimeoutAlarmsDoNotLimitStreams)
+{
+    EXPECT_EQ(ER_OK, io.Start());
+    for (size_t i = 0; i < NUM_STREAMS; ++i) {
+        EXPECT_EQ(ER_OK, io.StartStream(&streams[i], &l, &l, &l, false, false));
+    }
+
+    EnableThread enableThread(*this);
+    EXPECT_EQ(ER_OK, enableThread.Start());
+    EXPECT_EQ(ER_OK, Event::Wait(enableThread.done, 10000));
+
+    /* Stopping the IODispatch also releases the thread if it is blocked on a full timer */
+    EXPECT_EQ(ER_OK, io.Stop());
+    EXPECT_EQ(ER_OK, enableThread.Join());
+    EXPECT_EQ(ER_OK, io.Join());
+}
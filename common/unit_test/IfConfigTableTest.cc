@@ -0,0 +1,94 @@
+/******************************************************************************
+ *    Copyright (c) Open Connectivity Foundation (OCF), AllJoyn Open Source
+ *    Project (AJOSP) Contributors and others.
+ *
+ *    SPDX-License-Identifier: Apache-2.0
+ *
+ *    All rights reserved. This program and the accompanying materials are
+ *    made available under the terms of the Apache License, Version 2.0
+ *    which accompanies this distribution, and is available at
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Copyright (c) Open Connectivity Foundation and Contributors to AllSeen
+ *    Alliance. All rights reserved.
+ *
+ *    Permission to use, copy, modify, and/or distribute this software for
+ *    any purpose with or without fee is hereby granted, provided that the
+ *    above copyright notice and this permission notice appear in all
+ *    copies.
+ *
+ *    THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+ *    WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+ *    WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ *    AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ *    DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ *    PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+ *    TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ *    PERFORMANCE OF THIS SOFTWARE.
+ ******************************************************************************/
+
+#include <gtest/gtest.h>
+#include <qcc/IfConfig.h>
+#include <qcc/Socket.h>
+
+using namespace qcc;
+
+#if defined(QCC_OS_LINUX) || defined(QCC_OS_ANDROID)
+
+static bool HasEntry(const std::vector<IfConfigEntry>& entries, const IfConfigEntry& entry)
+{
+    for (size_t i = 0; i < entries.size(); ++i) {
+        if (entries[i].m_index == entry.m_index && entries[i].m_family == entry.m_family &&
+            entries[i].m_addr == entry.m_addr && entries[i].m_name == entry.m_name &&
+            entries[i].m_flags == entry.m_flags) {
+            return true;
+        }
+    }
+    return false;
+}
+
+TEST(IfConfigTableTest, MatchesIfConfig) {
+    IfConfigTable table;
+    EXPECT_FALSE(table.IsOpen());
+    ASSERT_EQ(ER_OK, table.Open());
+    EXPECT_TRUE(table.IsOpen());
+    EXPECT_NE(INVALID_SOCKET_FD, table.GetSocketFd());
+
+    std::vector<IfConfigEntry> tracked;
+    table.GetEntries(tracked);
+    std::vector<IfConfigEntry> entries;
+    ASSERT_EQ(ER_OK, IfConfig(entries));
+
+    EXPECT_EQ(entries.size(), tracked.size());
+    for (size_t i = 0; i < entries.size(); ++i) {
+        EXPECT_TRUE(HasEntry(tracked, entries[i])) << entries[i].m_name.c_str() << " " << entries[i].m_addr.c_str();
+    }
+}
+
+TEST(IfConfigTableTest, UpdateWithoutNotifications) {
+    IfConfigTable table;
+    NetworkEventSet networkEvents;
+    std::vector<IfConfigEntry> added;
+    std::vector<IfConfigEntry> removed;
+
+    /* A table that is not open never changes */
+    EXPECT_EQ(QCC_RTM_IGNORED, table.Update(networkEvents, added, removed));
+
+    ASSERT_EQ(ER_OK, table.Open());
+    std::vector<IfConfigEntry> before;
+    table.GetEntries(before);
+    NetworkEventType eventType = table.Update(networkEvents, added, removed);
+    if (added.empty() && removed.empty()) {
+        EXPECT_EQ(QCC_RTM_IGNORED, eventType);
+        std::vector<IfConfigEntry> after;
+        table.GetEntries(after);
+        EXPECT_EQ(before.size(), after.size());
+    }
+
+    table.Close();
+    EXPECT_FALSE(table.IsOpen());
+    table.GetEntries(before);
+    EXPECT_TRUE(before.empty());
+}
+
+#endif
@@ -0,0 +1,119 @@
+/******************************************************************************
+ *    Copyright (c) Open Connectivity Foundation (OCF), AllJoyn Open Source
+ *    Project (AJOSP) Contributors and others.
+ *
+ *    SPDX-License-Identifier: Apache-2.0
+ *
+ *    All rights reserved. This program and the accompanying materials are
+ *    made available under the terms of the Apache License, Version 2.0
+ *    which accompanies this distribution, and is available at
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Copyright (c) Open Connectivity Foundation and Contributors to AllSeen
+ *    Alliance. All rights reserved.
+ *
+ *    Permission to use, copy, modify, and/or distribute this software for
+ *    any purpose with or without fee is hereby granted, provided that the
+ *    above copyright notice and this permission notice appear in all
+ *    copies.
+ *
+ *    THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+ *    WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+ *    WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ *    AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ *    DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ *    PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+ *    TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ *    PERFORMANCE OF THIS SOFTWARE.
+ ******************************************************************************/
+#include <gtest/gtest.h>
+
+#include <string.h>
+#include <vector>
+
+#include <qcc/LZ4.h>
+#include <qcc/Crypto.h>
+
+using namespace qcc;
+
+static void RoundTrip(const std::vector<uint8_t>& in, size_t& compressedLen)
+{
+    std::vector<uint8_t> compressed(LZ4CompressBound(in.size()));
+    compressedLen = LZ4Compress(in.data(), in.size(), compressed.data(), compressed.size());
+    ASSERT_NE(0U, compressedLen);
+
+    std::vector<uint8_t> out(in.size() + 1);
+    size_t outLen = 0;
+    ASSERT_EQ(ER_OK, LZ4Decompress(compressed.data(), compressedLen, out.data(), out.size(), outLen));
+    ASSERT_EQ(in.size(), outLen);
+    EXPECT_EQ(0, memcmp(in.data(), out.data(), outLen));
+}
+
+TEST(LZ4Test, round_trip_repetitive)
+{
+    static const char xml[] = "<interface name=\"org.alljoyn.About\"><method name=\"GetAboutData\"/></interface>";
+    std::vector<uint8_t> in;
+    for (size_t i = 0; i < 200; ++i) {
+        in.insert(in.end(), xml, xml + sizeof(xml) - 1);
+    }
+    size_t compressedLen;
+    RoundTrip(in, compressedLen);
+    EXPECT_LT(compressedLen, in.size() / 10);
+}
+
+TEST(LZ4Test, round_trip_random)
+{
+    std::vector<uint8_t> in(4096);
+    Crypto_GetRandomBytes(in.data(), in.size());
+    size_t compressedLen;
+    RoundTrip(in, compressedLen);
+    EXPECT_LE(compressedLen, LZ4CompressBound(in.size()));
+}
+
+TEST(LZ4Test, round_trip_short)
+{
+    for (size_t len = 0; len < 32; ++len) {
+        std::vector<uint8_t> in(len, 'a');
+        size_t compressedLen;
+        RoundTrip(in, compressedLen);
+    }
+}
+
+TEST(LZ4Test, output_too_small)
+{
+    std::vector<uint8_t> in(1000, 'a');
+    std::vector<uint8_t> compressed(LZ4CompressBound(in.size()));
+    EXPECT_EQ(0U, LZ4Compress(in.data(), in.size(), compressed.data(), in.size()));
+
+    size_t compressedLen = LZ4Compress(in.data(), in.size(), compressed.data(), compressed.size());
+    ASSERT_NE(0U, compressedLen);
+    std::vector<uint8_t> out(in.size() - 1);
+    size_t outLen;
+    EXPECT_EQ(ER_BUFFER_TOO_SMALL, LZ4Decompress(compressed.data(), compressedLen, out.data(), out.size(), outLen));
+}
+
+TEST(LZ4Test, malformed_input)
+{
+    const uint8_t empty[1] = { 0 };
+    uint8_t out[64] = { 0 };
+    size_t outLen;
+
+    /* Empty block */
+    EXPECT_EQ(ER_INVALID_DATA, LZ4Decompress(empty, 0, out, sizeof(out), outLen));
+
+    /* Literal run longer than the block */
+    const uint8_t longLiterals[] = { 0x50, 'a', 'b' };
+    EXPECT_EQ(ER_INVALID_DATA, LZ4Decompress(longLiterals, sizeof(longLiterals), out, sizeof(out), outLen));
+
+    /* Match offset reaching back before the start of the output */
+    const uint8_t badOffset[] = { 0x10, 'a', 0x02, 0x00 };
+    EXPECT_EQ(ER_INVALID_DATA, LZ4Decompress(badOffset, sizeof(badOffset), out, sizeof(out), outLen));
+
+    /* Zero offset */
+    const uint8_t zeroOffset[] = { 0x10, 'a', 0x00, 0x00 };
+    EXPECT_EQ(ER_INVALID_DATA, LZ4Decompress(zeroOffset, sizeof(zeroOffset), out, sizeof(out), outLen));
+
+    /* Truncated length extension */
+    const uint8_t truncated[] = { 0xF0, 0xFF };
+    EXPECT_EQ(ER_INVALID_DATA, LZ4Decompress(truncated, sizeof(truncated), out, sizeof(out), outLen));
+}
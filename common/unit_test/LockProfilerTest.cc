@@ -0,0 +1,189 @@
+/******************************************************************************
+ *    Copyright (c) Open Connectivity Foundation (OCF), AllJoyn Open Source
+ *    Project (AJOSP) Contributors and others.
+ *
+ *    SPDX-License-Identifier: Apache-2.0
+ *
+ *    All rights reserved. This program and the accompanying materials are
+ *    made available under the terms of the Apache License, Version 2.0
+ *    which accompanies this distribution, and is available at
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Copyright (c) Open Connectivity Foundation and Contributors to AllSeen
+ *    Alliance. All rights reserved.
+ *
+ *    Permission to use, copy, modify, and/or distribute this software for
+ *    any purpose with or without fee is hereby granted, provided that the
+ *    above copyright notice and this permission notice appear in all
+ *    copies.
+ *
+ *    THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+ *    WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+ *    WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ *    AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ *    DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ *    PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+ *    TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ *    PERFORMANCE OF THIS SOFTWARE.
+ ******************************************************************************/
+
+/* The profiler only receives samples from Mutex when built with LOCK_PROFILER=on */
+#ifdef QCC_LOCK_PROFILER
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include <qcc/Condition.h>
+#include <qcc/LockProfiler.h>
+#include <qcc/Mutex.h>
+#include <qcc/Thread.h>
+
+using namespace qcc;
+
+/* Arbitrary line numbers used to tell the lock sites of these tests apart */
+static const uint32_t HOLDER_SITE = 100001;
+static const uint32_t WAITER_SITE = 100002;
+static const uint32_t OUTER_SITE = 100003;
+static const uint32_t INNER_SITE = 100004;
+static const uint32_t CONDITION_SITE = 100005;
+static const uint32_t DISABLED_SITE = 100006;
+
+static const LockSiteStats* FindSite(const std::vector<LockSiteStats>& stats, uint32_t line)
+{
+    for (size_t i = 0; i < stats.size(); ++i) {
+        if ((stats[i].line == line) && stats[i].file && strstr(stats[i].file, "LockProfilerTest.cc")) {
+            return &stats[i];
+        }
+    }
+    return NULL;
+}
+
+class LockProfilerTest : public testing::Test {
+  public:
+    virtual void SetUp()
+    {
+        LockProfiler::Reset();
+        LockProfiler::SetEnabled(true, 1);
+    }
+
+    virtual void TearDown()
+    {
+        LockProfiler::SetEnabled(false);
+        LockProfiler::Reset();
+    }
+};
+
+static ThreadReturn STDCALL WaiterTask(void* arg)
+{
+    Mutex* lock = reinterpret_cast<Mutex*>(arg);
+    lock->Lock(__FILE__, WAITER_SITE);
+    lock->Unlock(__FILE__, WAITER_SITE);
+    return 0;
+}
+
+TEST_F(LockProfilerTest, ContendedWaitAndHold)
+{
+    Mutex lock;
+    Thread waiterThread("LockProfilerWaiter", WaiterTask);
+
+    ASSERT_EQ(ER_OK, lock.Lock(__FILE__, HOLDER_SITE));
+    ASSERT_EQ(ER_OK, waiterThread.Start(&lock));
+    qcc::Sleep(100);
+    ASSERT_EQ(ER_OK, lock.Unlock(__FILE__, HOLDER_SITE));
+    ASSERT_EQ(ER_OK, waiterThread.Join());
+
+    std::vector<LockSiteStats> stats;
+    LockProfiler::GetSiteStats(stats);
+
+    const LockSiteStats* holder = FindSite(stats, HOLDER_SITE);
+    ASSERT_TRUE(holder != NULL);
+    EXPECT_EQ(1U, holder->acquisitions);
+    EXPECT_EQ(0U, holder->contended);
+    EXPECT_GE(holder->maxHoldNs, 50000000U);
+
+    const LockSiteStats* waiter = FindSite(stats, WAITER_SITE);
+    ASSERT_TRUE(waiter != NULL);
+    EXPECT_EQ(1U, waiter->acquisitions);
+    EXPECT_EQ(1U, waiter->contended);
+    EXPECT_GE(waiter->waitNs, 20000000U);
+    EXPECT_GE(waiter->WaitPercentileNs(50), waiter->maxWaitNs / 2);
+
+    /* The contended site is ranked first */
+    EXPECT_EQ(WAITER_SITE, stats[0].line);
+}
+
+TEST_F(LockProfilerTest, RecursiveAcquireIsOneHold)
+{
+    Mutex lock;
+
+    ASSERT_EQ(ER_OK, lock.Lock(__FILE__, OUTER_SITE));
+    ASSERT_EQ(ER_OK, lock.Lock(__FILE__, INNER_SITE));
+    qcc::Sleep(20);
+    ASSERT_EQ(ER_OK, lock.Unlock(__FILE__, INNER_SITE));
+    ASSERT_TRUE(lock.TryLock());
+    ASSERT_EQ(ER_OK, lock.Unlock(__FILE__, INNER_SITE));
+    ASSERT_EQ(ER_OK, lock.Unlock(__FILE__, OUTER_SITE));
+
+    std::vector<LockSiteStats> stats;
+    LockProfiler::GetSiteStats(stats);
+
+    const LockSiteStats* outer = FindSite(stats, OUTER_SITE);
+    ASSERT_TRUE(outer != NULL);
+    EXPECT_EQ(1U, outer->acquisitions);
+    EXPECT_GE(outer->maxHoldNs, 10000000U);
+    EXPECT_TRUE(FindSite(stats, INNER_SITE) == NULL);
+
+    /* The lock must be free again */
+    ASSERT_TRUE(lock.TryLock());
+    lock.Unlock();
+}
+
+TEST_F(LockProfilerTest, ConditionWaitIsNotHeld)
+{
+    Mutex lock;
+    Condition condition;
+
+    ASSERT_EQ(ER_OK, lock.Lock(__FILE__, CONDITION_SITE));
+    EXPECT_EQ(ER_TIMEOUT, condition.TimedWait(lock, 100));
+    ASSERT_EQ(ER_OK, lock.Unlock(__FILE__, CONDITION_SITE));
+
+    std::vector<LockSiteStats> stats;
+    LockProfiler::GetSiteStats(stats);
+
+    const LockSiteStats* site = FindSite(stats, CONDITION_SITE);
+    ASSERT_TRUE(site != NULL);
+    EXPECT_LT(site->holdNs, 50000000U);
+
+    /* The hold is split in two around the wait */
+    uint32_t holds = 0;
+    for (size_t i = 0; i < LockSiteStats::HISTOGRAM_BUCKETS; ++i) {
+        holds += site->holdHistogram[i];
+    }
+    EXPECT_EQ(2U, holds);
+}
+
+TEST_F(LockProfilerTest, DisabledAndReset)
+{
+    Mutex lock;
+    std::vector<LockSiteStats> stats;
+
+    LockProfiler::SetEnabled(false);
+    ASSERT_EQ(ER_OK, lock.Lock(__FILE__, DISABLED_SITE));
+    ASSERT_EQ(ER_OK, lock.Unlock(__FILE__, DISABLED_SITE));
+    LockProfiler::GetSiteStats(stats);
+    EXPECT_TRUE(FindSite(stats, DISABLED_SITE) == NULL);
+
+    LockProfiler::SetEnabled(true);
+    ASSERT_EQ(ER_OK, lock.Lock(__FILE__, DISABLED_SITE));
+    ASSERT_EQ(ER_OK, lock.Unlock(__FILE__, DISABLED_SITE));
+    LockProfiler::GetSiteStats(stats);
+    EXPECT_TRUE(FindSite(stats, DISABLED_SITE) != NULL);
+    EXPECT_NE(qcc::String::npos, LockProfiler::Dump().find("LockProfilerTest.cc:100006"));
+
+    LockProfiler::Reset();
+    LockProfiler::GetSiteStats(stats);
+    EXPECT_TRUE(FindSite(stats, DISABLED_SITE) == NULL);
+}
+
+#endif /* QCC_LOCK_PROFILER */
@@ -30,6 +30,12 @@
 #include <gtest/gtest.h>
 #include <utility>
 
+#if defined(QCC_OS_LINUX)
+#include <fcntl.h>
+#include <sys/resource.h>
+#include <sys/select.h>
+#endif
+
 #include <qcc/Socket.h>
 #include <qcc/Thread.h>
 #include <qcc/Util.h>
@@ -530,3 +536,49 @@ TEST_F(SocketTestWithFdsErrors, SendWouldBlock)
 }
 
 #endif
+
+#if defined(QCC_OS_LINUX)
+/*
+ * Connect waits for the connection to complete, it must do so for descriptors numbered
+ * FD_SETSIZE or above since a busy router easily has that many sockets open.
+ */
+TEST(SocketTest, ConnectHighNumberedFd)
+{
+    struct rlimit rl;
+    ASSERT_EQ(0, getrlimit(RLIMIT_NOFILE, &rl));
+    if (rl.rlim_cur < (rlim_t)(FD_SETSIZE + 64)) {
+        rl.rlim_cur = (rl.rlim_max < (rlim_t)(FD_SETSIZE + 64)) ? rl.rlim_max : (rlim_t)(FD_SETSIZE + 64);
+        setrlimit(RLIMIT_NOFILE, &rl);
+    }
+
+    IPAddress hostAddr("127.0.0.1");
+    SocketFd serverFd = INVALID_SOCKET_FD;
+    uint16_t serverPort = 0;
+    ASSERT_EQ(ER_OK, Socket(QCC_AF_INET, QCC_SOCK_STREAM, serverFd));
+    EXPECT_EQ(ER_OK, Bind(serverFd, hostAddr, serverPort));
+    EXPECT_EQ(ER_OK, GetLocalAddress(serverFd, hostAddr, serverPort));
+    EXPECT_EQ(ER_OK, Listen(serverFd, 1));
+
+    SocketFd sockFd = INVALID_SOCKET_FD;
+    ASSERT_EQ(ER_OK, Socket(QCC_AF_INET, QCC_SOCK_STREAM, sockFd));
+    int clientFd = fcntl(sockFd, F_DUPFD, FD_SETSIZE + 16);
+    qcc::Close(sockFd);
+    if (clientFd < 0) {
+        qcc::Close(serverFd);
+        return;
+    }
+    ASSERT_LE(FD_SETSIZE, clientFd);
+
+    EXPECT_EQ(ER_OK, Connect(clientFd, hostAddr, serverPort));
+    IPAddress acceptedAddr;
+    uint16_t acceptedPort = 0;
+    SocketFd acceptedFd = INVALID_SOCKET_FD;
+    EXPECT_EQ(ER_OK, Accept(serverFd, acceptedAddr, acceptedPort, acceptedFd));
+
+    if (acceptedFd != INVALID_SOCKET_FD) {
+        qcc::Close(acceptedFd);
+    }
+    qcc::Close(clientFd);
+    qcc::Close(serverFd);
+}
+#endif
@@ -0,0 +1,92 @@
+/******************************************************************************
+ *    Copyright (c) Open Connectivity Foundation (OCF), AllJoyn Open Source
+ *    Project (AJOSP) Contributors and others.
+ *
+ *    SPDX-License-Identifier: Apache-2.0
+ *
+ *    All rights reserved. This program and the accompanying materials are
+ *    made available under the terms of the Apache License, Version 2.0
+ *    which accompanies this distribution, and is available at
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Copyright (c) Open Connectivity Foundation and Contributors to AllSeen
+ *    Alliance. All rights reserved.
+ *
+ *    Permission to use, copy, modify, and/or distribute this software for
+ *    any purpose with or without fee is hereby granted, provided that the
+ *    above copyright notice and this permission notice appear in all
+ *    copies.
+ *
+ *    THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL
+ *    WARRANTIES WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED
+ *    WARRANTIES OF MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE
+ *    AUTHOR BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL
+ *    DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR
+ *    PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER
+ *    TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ *    PERFORMANCE OF THIS SOFTWARE.
+ ******************************************************************************/
+#include <gtest/gtest.h>
+
+#include <map>
+#include <unordered_map>
+
+#include <qcc/String.h>
+#include <qcc/StringMapKey.h>
+#include <qcc/Util.h>
+
+using namespace qcc;
+
+TEST(StringMapKeyTest, borrowed_key_finds_owned_key)
+{
+    std::unordered_map<StringMapKey, int, StringMapKey::Hash> names;
+    names[String(":abc.2")] = 2;
+    names["org.alljoyn.Bus"] = 1;
+
+    const char* lookup = "org.alljoyn.Bus";
+    std::unordered_map<StringMapKey, int, StringMapKey::Hash>::const_iterator it = names.find(StringMapKey::Borrow(lookup));
+    ASSERT_TRUE(it != names.end());
+    EXPECT_EQ(1, it->second);
+    EXPECT_EQ(String("org.alljoyn.Bus"), it->first.ToString());
+
+    EXPECT_TRUE(names.find(StringMapKey::Borrow(String(":abc.2"))) != names.end());
+    EXPECT_TRUE(names.find(StringMapKey::Borrow("org.alljoyn")) == names.end());
+    EXPECT_TRUE(names.find(StringMapKey::Borrow(lookup, 11)) == names.end());
+}
+
+TEST(StringMapKeyTest, stored_keys_do_not_borrow)
+{
+    std::map<StringMapKey, int> names;
+    char buf[16];
+    strcpy(buf, "org.alljoyn");
+    StringMapKey borrowed = StringMapKey::Borrow(buf);
+    names[borrowed] = 1;
+
+    /* Overwriting the borrowed characters must not change the stored key */
+    strcpy(buf, "xxx.xxxxxxx");
+    EXPECT_TRUE(names.find(StringMapKey::Borrow("org.alljoyn")) != names.end());
+    EXPECT_TRUE(names.begin()->first.Equals("org.alljoyn"));
+}
+
+TEST(StringMapKeyTest, ordering_matches_std_string)
+{
+    const char* strs[] = { "", "a", "ab", "abc", "b", "ba", ":1.2", "org.alljoyn" };
+    for (size_t i = 0; i < ArraySize(strs); ++i) {
+        for (size_t j = 0; j < ArraySize(strs); ++j) {
+            std::string si(strs[i]);
+            std::string sj(strs[j]);
+            EXPECT_EQ(si < sj, StringMapKey::Borrow(strs[i]) < StringMapKey(strs[j])) << si << " < " << sj;
+            EXPECT_EQ(si == sj, StringMapKey(si) == StringMapKey::Borrow(sj)) << si << " == " << sj;
+        }
+    }
+}
+
+TEST(StringMapKeyTest, prefix_borrow)
+{
+    const char* path = "/org/alljoyn/Bus";
+    StringMapKey prefix = StringMapKey::Borrow(path, 4);
+    EXPECT_EQ(4U, prefix.size());
+    EXPECT_TRUE(prefix == StringMapKey("/org"));
+    EXPECT_EQ(String("/org"), prefix.ToString());
+    EXPECT_TRUE(StringMapKey::Borrow(static_cast<const char*>(NULL)).empty());
+}